@@ -0,0 +1,352 @@
+/**
+ * @file bench.cpp
+ * @brief Runner of the micro-benchmark harness (see @ref bench.h): calibration, console and JSON reports.
+ *
+ * @details
+ * Options (Google Benchmark spelling, so scripts work with either):
+ * - `--benchmark_filter=REGEX` runs only the runs whose name matches (ECMAScript, search);
+ * - `--benchmark_min_time=S` minimum duration of one measured run in seconds (default 0.5);
+ * - `--benchmark_repetitions=N` measured runs per argument set (default 1);
+ * - `--benchmark_format=console|json` report on stdout (default console);
+ * - `--benchmark_out=FILE` additionally writes the JSON report to @c FILE;
+ * - `--benchmark_list_tests` prints the run names and exits.
+ */
+
+#include "bench.h"
+
+#include "algo/preprocess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifndef IDET_BENCH_VERSION
+    #define IDET_BENCH_VERSION "unknown"
+#endif
+
+namespace idet::bench {
+
+namespace {
+
+double wall_now() noexcept {
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+/// @brief CPU time of the whole process (includes pool threads of parallel kernels).
+double cpu_now() noexcept {
+    return (double)std::clock() / (double)CLOCKS_PER_SEC;
+}
+
+std::vector<std::unique_ptr<Benchmark>>& registry() {
+    static std::vector<std::unique_ptr<Benchmark>> r;
+    return r;
+}
+
+/// @brief Result of one measured run.
+struct Run {
+    std::string name;
+    std::int64_t iterations = 0;
+    double real_ns = 0.0; ///< Per iteration
+    double cpu_ns = 0.0;  ///< Per iteration
+    double items_per_s = 0.0;
+    double bytes_per_s = 0.0;
+    std::string label;
+    std::string error;
+    int repetition = 0;
+};
+
+struct Options {
+    std::string filter;
+    double min_time = 0.5;
+    int repetitions = 1;
+    bool json = false;
+    std::string out;
+    bool list = false;
+};
+
+bool parse_options(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view a = argv[i];
+        auto value = [&](std::string_view key, std::string& dst) {
+            if (a.substr(0, key.size()) != key) return false;
+            dst.assign(a.substr(key.size()));
+            return true;
+        };
+        std::string v;
+        if (value("--benchmark_filter=", v)) {
+            o.filter = v;
+        } else if (value("--benchmark_min_time=", v)) {
+            // Google Benchmark also accepts a trailing 's'.
+            if (!v.empty() && v.back() == 's') v.pop_back();
+            o.min_time = std::max(0.0, std::atof(v.c_str()));
+        } else if (value("--benchmark_repetitions=", v)) {
+            o.repetitions = std::max(1, std::atoi(v.c_str()));
+        } else if (value("--benchmark_format=", v)) {
+            if (v != "json" && v != "console") {
+                std::cerr << "[ERROR] --benchmark_format: expected console|json, got '" << v << "'\n";
+                return false;
+            }
+            o.json = v == "json";
+        } else if (value("--benchmark_out=", v)) {
+            o.out = v;
+        } else if (a == "--benchmark_list_tests" || a == "--benchmark_list_tests=true") {
+            o.list = true;
+        } else if (value("--benchmark_out_format=", v) || value("--benchmark_color=", v)) {
+            // Accepted for compatibility; the file is always JSON and the console is plain.
+        } else {
+            std::cerr << "[ERROR] Unknown option: " << a << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+Run measure(const Benchmark& b, std::size_t set, const Options& o) {
+    const std::vector<std::int64_t>& args = b.arg_sets().empty() ? std::vector<std::int64_t>{} : b.arg_sets()[set];
+
+    // Grow the iteration count until one run lasts min_time (same policy as Google Benchmark).
+    std::int64_t iters = 1;
+    for (;;) {
+        State st(iters, args);
+        b.fn()(st);
+
+        const bool enough = st.real_seconds() >= o.min_time || iters >= 1'000'000'000;
+        if (!st.error().empty() || enough) {
+            Run r;
+            r.iterations = iters;
+            r.label = st.label();
+            r.error = st.error();
+            const double n = (double)iters;
+            r.real_ns = st.real_seconds() * 1e9 / n;
+            r.cpu_ns = st.cpu_seconds() * 1e9 / n;
+            if (st.real_seconds() > 0.0) {
+                r.items_per_s = (double)st.items() / st.real_seconds();
+                r.bytes_per_s = (double)st.bytes() / st.real_seconds();
+            }
+            return r;
+        }
+
+        double mult = 10.0;
+        if (st.real_seconds() > 0.0) mult = std::clamp(o.min_time * 1.4 / st.real_seconds(), 2.0, 10.0);
+        iters = (std::int64_t)((double)iters * mult + 0.5);
+    }
+}
+
+/// @brief JSON string literal of @p s.
+std::string quoted(std::string_view s) {
+    std::string r = "\"";
+    for (char c : s) {
+        switch (c) {
+        case '"':
+            r += "\\\"";
+            break;
+        case '\\':
+            r += "\\\\";
+            break;
+        case '\n':
+            r += "\\n";
+            break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)(unsigned char)c);
+                r += buf;
+            } else {
+                r += c;
+            }
+        }
+    }
+    return r + "\"";
+}
+
+std::string json_number(double v) {
+    std::ostringstream os;
+    os.precision(12);
+    os << v;
+    return os.str();
+}
+
+void write_json(std::ostream& os, const std::vector<Run>& runs, const char* exe, int repetitions) {
+    char date[64] = {0};
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    os << "{\n  \"context\": {\n";
+    os << "    \"date\": " << quoted(date) << ",\n";
+    os << "    \"executable\": " << quoted(exe) << ",\n";
+    os << "    \"num_cpus\": " << std::max(1u, std::thread::hardware_concurrency()) << ",\n";
+    os << "    \"idet_version\": " << quoted(IDET_BENCH_VERSION) << ",\n";
+    os << "    \"simd_level\": " << quoted(algo::simd_level_name(algo::best_simd_level())) << ",\n";
+#ifdef NDEBUG
+    os << "    \"library_build_type\": \"release\"\n";
+#else
+    os << "    \"library_build_type\": \"debug\"\n";
+#endif
+    os << "  },\n  \"benchmarks\": [";
+
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        const Run& r = runs[i];
+        os << (i ? ",\n" : "\n") << "    {\n";
+        os << "      \"name\": " << quoted(r.name) << ",\n";
+        os << "      \"run_name\": " << quoted(r.name) << ",\n";
+        os << "      \"run_type\": \"iteration\",\n";
+        os << "      \"repetitions\": " << repetitions << ",\n";
+        os << "      \"repetition_index\": " << r.repetition << ",\n";
+        if (!r.error.empty()) {
+            os << "      \"error_occurred\": true,\n";
+            os << "      \"error_message\": " << quoted(r.error) << "\n    }";
+            continue;
+        }
+        os << "      \"iterations\": " << r.iterations << ",\n";
+        os << "      \"real_time\": " << json_number(r.real_ns) << ",\n";
+        os << "      \"cpu_time\": " << json_number(r.cpu_ns) << ",\n";
+        os << "      \"time_unit\": \"ns\"";
+        if (r.items_per_s > 0.0) os << ",\n      \"items_per_second\": " << json_number(r.items_per_s);
+        if (r.bytes_per_s > 0.0) os << ",\n      \"bytes_per_second\": " << json_number(r.bytes_per_s);
+        if (!r.label.empty()) os << ",\n      \"label\": " << quoted(r.label);
+        os << "\n    }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+void print_console(const Run& r) {
+    char line[256];
+    if (!r.error.empty()) {
+        std::snprintf(line, sizeof(line), "%-56s ERROR: %s\n", r.name.c_str(), r.error.c_str());
+    } else {
+        std::snprintf(line, sizeof(line), "%-56s %14.1f ns %14.1f ns %12lld", r.name.c_str(), r.real_ns, r.cpu_ns,
+                      (long long)r.iterations);
+    }
+    std::cout << line;
+    if (r.error.empty()) {
+        if (r.items_per_s > 0.0) std::cout << "  items/s=" << json_number(r.items_per_s);
+        if (r.bytes_per_s > 0.0) std::cout << "  bytes/s=" << json_number(r.bytes_per_s);
+        if (!r.label.empty()) std::cout << "  " << r.label;
+        std::cout << "\n";
+    }
+    std::cout.flush();
+}
+
+} // namespace
+
+State::Iterator State::begin() noexcept {
+    running_ = true;
+    clobber_memory();
+    real_start_ = wall_now();
+    cpu_start_ = cpu_now();
+    return {this, max_iters_};
+}
+
+void State::stop_() noexcept {
+    if (!running_) return;
+    const double cpu = cpu_now();
+    const double real = wall_now();
+    clobber_memory();
+    real_s_ = real - real_start_;
+    cpu_s_ = cpu - cpu_start_;
+    running_ = false;
+}
+
+Benchmark* Benchmark::args_product(const std::vector<std::vector<std::int64_t>>& lists) {
+    std::vector<std::vector<std::int64_t>> acc{{}};
+    for (const auto& l : lists) {
+        std::vector<std::vector<std::int64_t>> next;
+        for (const auto& prefix : acc) {
+            for (std::int64_t v : l) {
+                next.push_back(prefix);
+                next.back().push_back(v);
+            }
+        }
+        acc.swap(next);
+    }
+    for (auto& a : acc)
+        args_.push_back(std::move(a));
+    return this;
+}
+
+std::string Benchmark::run_name(std::size_t i) const {
+    std::string n = name_;
+    if (i >= args_.size()) return n;
+    for (std::size_t k = 0; k < args_[i].size(); ++k) {
+        n += '/';
+        if (k < names_.size()) n += names_[k] + ":";
+        n += std::to_string(args_[i][k]);
+    }
+    return n;
+}
+
+Benchmark* register_benchmark(const char* name, BenchFn fn) {
+    registry().push_back(std::make_unique<Benchmark>(name, fn));
+    return registry().back().get();
+}
+
+int run(int argc, char** argv) {
+    Options o;
+    if (!parse_options(argc, argv, o)) return 2;
+
+    std::regex filter;
+    try {
+        if (!o.filter.empty()) filter = std::regex(o.filter);
+    } catch (const std::regex_error& e) {
+        std::cerr << "[ERROR] --benchmark_filter: " << e.what() << "\n";
+        return 2;
+    }
+
+    std::vector<Run> runs;
+    bool failed = false;
+    if (!o.json && !o.list) {
+        char head[160];
+        std::snprintf(head, sizeof(head), "%-56s %17s %17s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+        std::cout << head << std::string(104, '-') << "\n";
+    }
+
+    for (const auto& b : registry()) {
+        const std::size_t sets = std::max<std::size_t>(1, b->arg_sets().size());
+        for (std::size_t s = 0; s < sets; ++s) {
+            const std::string name = b->run_name(s);
+            if (!o.filter.empty() && !std::regex_search(name, filter)) continue;
+            if (o.list) {
+                std::cout << name << "\n";
+                continue;
+            }
+            for (int rep = 0; rep < o.repetitions; ++rep) {
+                Run r = measure(*b, s, o);
+                r.name = name;
+                r.repetition = rep;
+                failed = failed || !r.error.empty();
+                if (!o.json) print_console(r);
+                runs.push_back(std::move(r));
+            }
+        }
+    }
+    if (o.list) return 0;
+
+    if (o.json) write_json(std::cout, runs, argv[0], o.repetitions);
+    if (!o.out.empty()) {
+        std::ofstream f(o.out);
+        if (!f) {
+            std::cerr << "[ERROR] Cannot write " << o.out << "\n";
+            return 1;
+        }
+        write_json(f, runs, argv[0], o.repetitions);
+    }
+    return failed ? 1 : 0;
+}
+
+} // namespace idet::bench
+
+int main(int argc, char** argv) {
+    return idet::bench::run(argc, argv);
+}
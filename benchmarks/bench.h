@@ -0,0 +1,225 @@
+/**
+ * @file bench.h
+ * @brief Minimal micro-benchmark harness with Google Benchmark compatible JSON output.
+ *
+ * @details
+ * Benchmarks are plain functions taking a @ref idet::bench::State and registered with
+ * @ref IDET_BENCHMARK. The body times a range-for over the state:
+ *
+ * @code
+ * static void BM_Foo(idet::bench::State& st) {
+ *     Input in = make_input(st.range(0));  // setup, not timed
+ *     for (auto _ : st)
+ *         idet::bench::do_not_optimize(foo(in));
+ *     st.set_items_processed(st.iterations() * st.range(0));
+ * }
+ * IDET_BENCHMARK(BM_Foo)->arg_names({"n"})->args({100})->args({1000});
+ * @endcode
+ *
+ * The runner grows the iteration count until one run lasts at least the minimum time and reports
+ * wall and CPU time per iteration. With `--benchmark_format=json` (or `--benchmark_out=FILE`) the
+ * report uses the Google Benchmark JSON schema, so its `compare.py` and existing dashboards can
+ * diff two releases directly.
+ *
+ * A separate harness instead of Google Benchmark itself keeps the benchmark build free of another
+ * subproject; the subset used here (arguments, items/s, labels, filters, repetitions) is small.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define IDET_BENCH_UNUSED_ __attribute__((unused))
+#else
+    #define IDET_BENCH_UNUSED_
+#endif
+
+namespace idet::bench {
+
+/**
+ * @brief Keeps @p v (and the computation producing it) alive without an observable side effect.
+ */
+template <class T> inline void do_not_optimize(const T& v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(v) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &v;
+#endif
+}
+
+/** @brief Compiler barrier: memory written before it is considered read. */
+inline void clobber_memory() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/**
+ * @brief Per-run state handed to a benchmark function.
+ *
+ * @details
+ * The timer starts when the range-for begins and stops when it ends, so setup before the loop
+ * and reporting after it are not measured.
+ */
+class State final {
+  public:
+    State(std::int64_t iterations, const std::vector<std::int64_t>& args) noexcept
+        : max_iters_(iterations), args_(args) {}
+
+    /** @brief Argument @p i of the current argument set (0 if absent). */
+    std::int64_t range(std::size_t i = 0) const noexcept {
+        return i < args_.size() ? args_[i] : 0;
+    }
+
+    /** @brief Iterations of the timed loop. */
+    std::int64_t iterations() const noexcept {
+        return max_iters_;
+    }
+
+    /** @brief Reports @p n processed items; shown as `items_per_second`. */
+    void set_items_processed(std::int64_t n) noexcept {
+        items_ = n;
+    }
+
+    /** @brief Reports @p n processed bytes; shown as `bytes_per_second`. */
+    void set_bytes_processed(std::int64_t n) noexcept {
+        bytes_ = n;
+    }
+
+    /** @brief Free-form annotation of the run (e.g. a result size). */
+    void set_label(std::string label) {
+        label_ = std::move(label);
+    }
+
+    /** @brief Marks the run as failed; the runner reports @p msg instead of timings. */
+    void skip_with_error(std::string msg) {
+        error_ = std::move(msg);
+    }
+
+    class Iterator final {
+      public:
+        /// Loop variable type of `for (auto _ : st)`; marked unused so the loop compiles warning-free.
+        struct IDET_BENCH_UNUSED_ Value {};
+
+        Iterator(State* st, std::int64_t left) noexcept : st_(st), left_(left) {}
+        bool operator!=(const Iterator&) noexcept {
+            if (left_ > 0) return true;
+            st_->stop_();
+            return false;
+        }
+        void operator++() noexcept {
+            --left_;
+        }
+        Value operator*() const noexcept {
+            return {};
+        }
+
+      private:
+        State* st_;
+        std::int64_t left_;
+    };
+
+    Iterator begin() noexcept;
+    Iterator end() noexcept {
+        return {this, 0};
+    }
+
+    // Read by the runner.
+    double real_seconds() const noexcept {
+        return real_s_;
+    }
+    double cpu_seconds() const noexcept {
+        return cpu_s_;
+    }
+    std::int64_t items() const noexcept {
+        return items_;
+    }
+    std::int64_t bytes() const noexcept {
+        return bytes_;
+    }
+    const std::string& label() const noexcept {
+        return label_;
+    }
+    const std::string& error() const noexcept {
+        return error_;
+    }
+
+  private:
+    void stop_() noexcept;
+
+    std::int64_t max_iters_;
+    const std::vector<std::int64_t>& args_;
+    std::int64_t items_ = 0;
+    std::int64_t bytes_ = 0;
+    std::string label_;
+    std::string error_;
+    double real_start_ = 0.0, cpu_start_ = 0.0;
+    double real_s_ = 0.0, cpu_s_ = 0.0;
+    bool running_ = false;
+};
+
+using BenchFn = void (*)(State&);
+
+/**
+ * @brief Registered benchmark with its argument sets (one run per set).
+ */
+class Benchmark final {
+  public:
+    Benchmark(std::string name, BenchFn fn) : name_(std::move(name)), fn_(fn) {}
+
+    /** @brief Adds one argument set. */
+    Benchmark* args(std::initializer_list<std::int64_t> a) {
+        args_.emplace_back(a);
+        return this;
+    }
+
+    /** @brief Adds the cartesian product of @p lists as argument sets. */
+    Benchmark* args_product(const std::vector<std::vector<std::int64_t>>& lists);
+
+    /** @brief Names of the arguments, used in the run names (`name/n:1000/fast:1`). */
+    Benchmark* arg_names(std::initializer_list<const char*> names) {
+        names_.assign(names.begin(), names.end());
+        return this;
+    }
+
+    const std::string& name() const noexcept {
+        return name_;
+    }
+    BenchFn fn() const noexcept {
+        return fn_;
+    }
+    const std::vector<std::vector<std::int64_t>>& arg_sets() const noexcept {
+        return args_;
+    }
+    /** @brief Name of the run with argument set @p i. */
+    std::string run_name(std::size_t i) const;
+
+  private:
+    std::string name_;
+    BenchFn fn_;
+    std::vector<std::vector<std::int64_t>> args_;
+    std::vector<std::string> names_;
+};
+
+/** @brief Registers @p fn under @p name (called by @ref IDET_BENCHMARK at static initialization). */
+Benchmark* register_benchmark(const char* name, BenchFn fn);
+
+/** @brief Runs the registered benchmarks selected by @p argv; returns the process exit code. */
+int run(int argc, char** argv);
+
+} // namespace idet::bench
+
+#define IDET_BENCH_CONCAT2_(a, b) a##b
+#define IDET_BENCH_CONCAT_(a, b) IDET_BENCH_CONCAT2_(a, b)
+
+/** @brief Registers benchmark function @p fn; chain @c ->args(...) to add argument sets. */
+#define IDET_BENCHMARK(fn)                                                                                             \
+    [[maybe_unused]] static ::idet::bench::Benchmark* IDET_BENCH_CONCAT_(idet_bench_reg_, __LINE__) =                 \
+        ::idet::bench::register_benchmark(#fn, fn)
@@ -0,0 +1,232 @@
+/**
+ * @file bench_algo.cpp
+ * @brief Micro-benchmarks of the postprocessing algorithms: NMS, quad IoU, contour scoring, tiling.
+ *
+ * @details
+ * Inputs are generated from fixed seeds so two builds measure identical work. The tiled inference
+ * benchmark runs a mock engine that returns one detection per tile without touching pixels, so it
+ * measures the orchestration cost alone (tile views, scheduling, offsets, concatenation).
+ */
+
+#include "bench.h"
+
+#include "algo/geometry.h"
+#include "algo/nms.h"
+#include "algo/tiling.h"
+#include "engine/engine.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using idet::bench::State;
+
+/// @brief Axis-aligned quad detection.
+idet::algo::Detection rect(float x, float y, float w, float h, float score) {
+    idet::algo::Detection d;
+    d.score = score;
+    d.pts = {cv::Point2f(x, y), cv::Point2f(x + w, y), cv::Point2f(x + w, y + h), cv::Point2f(x, y + h)};
+    return d;
+}
+
+/// @brief Slightly rotated quad of size @p w x @p h around (@p cx, @p cy).
+std::array<cv::Point2f, 4> rotated(float cx, float cy, float w, float h, float angle) {
+    const float c = std::cos(angle), s = std::sin(angle);
+    std::array<cv::Point2f, 4> q;
+    const float hx[4] = {-0.5f, 0.5f, 0.5f, -0.5f}, hy[4] = {-0.5f, -0.5f, 0.5f, 0.5f};
+    for (int k = 0; k < 4; ++k) {
+        const float x = hx[k] * w, y = hy[k] * h;
+        q[(std::size_t)k] = cv::Point2f(cx + c * x - s * y, cy + s * x + c * y);
+    }
+    return q;
+}
+
+/**
+ * @brief @p n text-line-like candidates on a 1920x1080 page.
+ *
+ * @details
+ * Dense scenes put several raw candidates on every object (what a detector emits before NMS);
+ * sparse scenes have mostly isolated boxes.
+ */
+std::vector<idet::algo::Detection> nms_scene(std::size_t n, bool dense, unsigned seed = 7) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> px(0.f, 1800.f), py(0.f, 1040.f), pw(30.f, 120.f), ph(12.f, 40.f);
+    std::uniform_real_distribution<float> jitter(-3.f, 3.f), sc(0.3f, 1.f);
+
+    std::vector<idet::algo::Detection> dets;
+    dets.reserve(n);
+    const std::size_t per_object = dense ? 6 : 1;
+    while (dets.size() < n) {
+        const float x = px(rng), y = py(rng), w = pw(rng), h = ph(rng);
+        for (std::size_t k = 0; k < per_object && dets.size() < n; ++k)
+            dets.push_back(rect(x + jitter(rng), y + jitter(rng), w + jitter(rng), h + jitter(rng), sc(rng)));
+    }
+    return dets;
+}
+
+// --------------------------- NMS ---------------------------
+
+void BM_NmsPoly(State& st) {
+    const auto dets = nms_scene((std::size_t)st.range(0), st.range(1) != 0);
+    const bool fast = st.range(2) != 0;
+
+    idet::algo::FrameArena arena;
+    std::vector<idet::algo::Detection> out;
+    for (auto _ : st) {
+        arena.reset();
+        idet::algo::nms_poly(dets, 0.3f, fast, arena, out);
+        idet::bench::do_not_optimize(out.data());
+    }
+    st.set_items_processed(st.iterations() * st.range(0));
+    st.set_label("kept=" + std::to_string(out.size()));
+}
+IDET_BENCHMARK(BM_NmsPoly)->arg_names({"n", "dense", "fast"})->args_product({{256, 2048, 16384}, {0, 1}, {0, 1}});
+
+void BM_NmsWorkspace(State& st) {
+    const auto dets = nms_scene((std::size_t)st.range(0), /*dense=*/true);
+
+    idet::algo::NmsParams p;
+    p.method = (idet::algo::NmsMethod)st.range(1);
+    p.threads = (int)st.range(2);
+    idet::algo::NmsWorkspace ws;
+    for (auto _ : st)
+        idet::bench::do_not_optimize(ws.run(dets, p).data());
+    st.set_items_processed(st.iterations() * st.range(0));
+    st.set_label("kept=" + std::to_string(ws.kept().size()) + " clusters=" + std::to_string(ws.clusters()));
+}
+IDET_BENCHMARK(BM_NmsWorkspace)
+    ->arg_names({"n", "method", "threads"})
+    ->args_product({{2048, 16384}, {0, 1, 2, 3}, {1, 4}});
+
+// --------------------------- quad IoU ---------------------------
+
+void BM_QuadIou(State& st) {
+    constexpr std::size_t kPairs = 1024;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> off(-20.f, 20.f), ang(-0.3f, 0.3f);
+    std::vector<std::array<cv::Point2f, 4>> a(kPairs), b(kPairs);
+    for (std::size_t i = 0; i < kPairs; ++i) {
+        a[i] = rotated(100.f, 100.f, 80.f, 30.f, ang(rng));
+        b[i] = rotated(100.f + off(rng), 100.f + off(rng), 80.f, 30.f, ang(rng)); // mostly overlapping
+    }
+    const bool fast = st.range(0) != 0;
+
+    for (auto _ : st) {
+        float acc = 0.f;
+        for (std::size_t i = 0; i < kPairs; ++i)
+            acc += idet::algo::quad_iou(a[i], b[i], fast);
+        idet::bench::do_not_optimize(acc);
+    }
+    st.set_items_processed(st.iterations() * (std::int64_t)kPairs);
+}
+IDET_BENCHMARK(BM_QuadIou)->arg_names({"fast"})->args({0})->args({1});
+
+// --------------------------- contour scoring ---------------------------
+
+/**
+ * @brief Scores one rotated text-line contour of side @c range(0) on a 1024x1024 probability map.
+ *
+ * @details
+ * @c range(1) selects the scorer: 0 = @ref idet::algo::contour_score (polygon mask),
+ * 1 = @ref idet::algo::contour_score_scanline, 2 = @ref idet::algo::box_score.
+ */
+void BM_ContourScore(State& st) {
+    cv::Mat prob(1024, 1024, CV_32FC1);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> u(0.f, 1.f);
+    for (int y = 0; y < prob.rows; ++y) {
+        float* row = prob.ptr<float>(y);
+        for (int x = 0; x < prob.cols; ++x)
+            row[x] = u(rng);
+    }
+
+    const float side = (float)st.range(0);
+    const std::array<cv::Point2f, 4> q = rotated(512.f, 512.f, side, 0.4f * side, 0.2f);
+    std::vector<cv::Point> contour;
+    for (const cv::Point2f& p : q)
+        contour.emplace_back((int)p.x, (int)p.y);
+
+    const int mode = (int)st.range(1);
+    for (auto _ : st) {
+        float s = 0.f;
+        if (mode == 0)
+            s = idet::algo::contour_score(prob, contour);
+        else if (mode == 1)
+            s = idet::algo::contour_score_scanline(prob, contour);
+        else
+            s = idet::algo::box_score(prob, q);
+        idet::bench::do_not_optimize(s);
+    }
+    st.set_items_processed(st.iterations());
+}
+IDET_BENCHMARK(BM_ContourScore)->arg_names({"side", "mode"})->args_product({{16, 64, 256}, {0, 1, 2}});
+
+// --------------------------- tiling ---------------------------
+
+void BM_MakeTiles(State& st) {
+    const idet::GridSpec grid{(int)st.range(0), (int)st.range(0)};
+    for (auto _ : st)
+        idet::bench::do_not_optimize(idet::algo::make_tiles(3840, 2160, grid, 0.1f).data());
+    st.set_items_processed(st.iterations() * st.range(0) * st.range(0));
+}
+IDET_BENCHMARK(BM_MakeTiles)->arg_names({"rc"})->args({2})->args({4})->args({8});
+
+/// @brief Engine returning one tile-sized detection per call without running a model.
+class MockEngine final : public idet::engine::IEngine {
+  public:
+    explicit MockEngine(const idet::DetectorConfig& cfg) : IEngine(cfg, "mock") {}
+
+    idet::EngineKind kind() const noexcept override {
+        return cfg_.engine;
+    }
+    idet::Task task() const noexcept override {
+        return cfg_.task;
+    }
+    idet::Status update_hot(const idet::DetectorConfig&) noexcept override {
+        return idet::Status::Ok();
+    }
+    idet::Status setup_binding(int, int, int, int) noexcept override {
+        return idet::Status::Ok();
+    }
+    void unset_binding() noexcept override {}
+
+    idet::Result<std::vector<idet::algo::Detection>> infer_unbound(const cv::Mat& bgr) noexcept override {
+        return idet::Result<std::vector<idet::algo::Detection>>::Ok(tile_det(bgr));
+    }
+    idet::Result<std::vector<idet::algo::Detection>> infer_bound(const cv::Mat& bgr, int) noexcept override {
+        return idet::Result<std::vector<idet::algo::Detection>>::Ok(tile_det(bgr));
+    }
+
+  private:
+    static std::vector<idet::algo::Detection> tile_det(const cv::Mat& bgr) {
+        return {rect(1.f, 1.f, (float)bgr.cols - 2.f, (float)bgr.rows - 2.f, 0.9f)};
+    }
+};
+
+/// @brief Overhead of @ref idet::algo::infer_tiled on a 1080p frame (grid @c range(0), threads @c range(1)).
+void BM_InferTiled(State& st) {
+    idet::DetectorConfig cfg;
+    MockEngine eng(cfg);
+    const cv::Mat img(1080, 1920, CV_8UC3, cv::Scalar(0, 0, 0));
+    const idet::GridSpec grid{(int)st.range(0), (int)st.range(0)};
+    const int threads = (int)st.range(1);
+
+    for (auto _ : st) {
+        auto r = idet::algo::infer_tiled(eng, img, /*bound=*/false, -1, /*parallel_bound=*/false, grid, 0.1f, threads);
+        if (!r.ok()) {
+            st.skip_with_error(r.status().message);
+            return;
+        }
+        idet::bench::do_not_optimize(r.value().data());
+    }
+    st.set_items_processed(st.iterations() * st.range(0) * st.range(0));
+}
+IDET_BENCHMARK(BM_InferTiled)->arg_names({"rc", "threads"})->args_product({{1, 2, 4}, {1, 4}});
+
+} // namespace
@@ -0,0 +1,110 @@
+/**
+ * @file bench_preprocess.cpp
+ * @brief Micro-benchmarks of the input and output tensor kernels.
+ *
+ * @details
+ * The resize benchmark compares the OpenCV reference path (@c cv::resize + normalization, the
+ * @c bgr_u8_to_chw_f32_resize helper) with the fused resize kernels at every SIMD level the host
+ * supports. The plane benchmark covers the layouts an output map arrives in.
+ */
+
+#include "bench.h"
+
+#include "algo/preprocess.h"
+#include "internal/chw_preprocess.h"
+#include "internal/ort_tensor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using idet::bench::State;
+
+constexpr float kMean[3] = {123.675f, 116.28f, 103.53f};
+constexpr float kInvStd[3] = {1.f / 58.395f, 1.f / 57.12f, 1.f / 57.375f};
+
+/// @brief Path argument of @ref BM_ResizeToChw: -1 = OpenCV reference, else a supported SIMD level.
+std::vector<std::int64_t> resize_paths() {
+    std::vector<std::int64_t> v{-1};
+    for (auto l : {idet::algo::SimdLevel::Scalar, idet::algo::SimdLevel::NEON, idet::algo::SimdLevel::AVX2,
+                   idet::algo::SimdLevel::AVX512}) {
+        if (idet::algo::simd_level_supported(l)) v.push_back((std::int64_t)l);
+    }
+    return v;
+}
+
+/// @brief Random BGR frame of @p w x @p h.
+cv::Mat random_bgr(int w, int h) {
+    cv::Mat m(h, w, CV_8UC3);
+    std::mt19937 rng(1);
+    for (int y = 0; y < h; ++y) {
+        std::uint8_t* row = m.ptr<std::uint8_t>(y);
+        for (int x = 0; x < 3 * w; ++x)
+            row[x] = (std::uint8_t)(rng() & 0xFF);
+    }
+    return m;
+}
+
+// --------------------------- BGR -> CHW ---------------------------
+
+/**
+ * @brief Resize + normalize of a @c range(0) x @c range(1) frame into a @c range(2) square input.
+ */
+void BM_ResizeToChw(State& st) {
+    const cv::Mat src = random_bgr((int)st.range(0), (int)st.range(1));
+    const int dst = (int)st.range(2);
+    const std::int64_t path = st.range(3);
+    std::vector<float> chw((std::size_t)3 * (std::size_t)dst * (std::size_t)dst);
+
+    idet::algo::ResizeChwWorkspace ws;
+    for (auto _ : st) {
+        if (path < 0)
+            idet::internal::bgr_u8_to_chw_f32_resize(src, dst, dst, chw.data(), kMean, kInvStd);
+        else
+            idet::algo::resize_bgr_to_chw(src, dst, dst, chw.data(), kMean, kInvStd, ws,
+                                          (idet::algo::SimdLevel)path);
+        idet::bench::clobber_memory();
+    }
+    st.set_items_processed(st.iterations() * dst * dst);
+    st.set_bytes_processed(st.iterations() * (std::int64_t)(src.total() * src.elemSize()));
+    st.set_label(path < 0 ? "opencv" : idet::algo::simd_level_name((idet::algo::SimdLevel)path));
+}
+IDET_BENCHMARK(BM_ResizeToChw)
+    ->arg_names({"w", "h", "dst", "path"})
+    ->args_product({{1280}, {720}, {640, 1280}, resize_paths()})
+    ->args_product({{640}, {640}, {640}, resize_paths()});
+
+// --------------------------- output planes ---------------------------
+
+/**
+ * @brief Plane access of channel 0 of a 2-channel 640x640 map (@c range(0): 0 = NCHW, 1 = NHWC).
+ *
+ * @details
+ * NCHW returns a pointer into the tensor; NHWC gathers the channel into the scratch buffer.
+ */
+void BM_ExtractHwChannel(State& st) {
+    const bool nhwc = st.range(0) != 0;
+    const std::int64_t H = 640, W = 640, C = 2;
+    const idet::internal::TensorDesc desc =
+        idet::internal::make_desc_probmap(nhwc ? std::vector<int64_t>{1, H, W, C} : std::vector<int64_t>{1, C, H, W});
+    if (desc.layout == idet::internal::TensorLayout::Unknown) {
+        st.skip_with_error("unsupported layout");
+        return;
+    }
+
+    std::vector<float> data((std::size_t)(H * W * C), 0.5f);
+    std::vector<float> scratch;
+    for (auto _ : st) {
+        const float* plane = idet::internal::extract_hw_channel(data.data(), desc, 0, scratch);
+        idet::bench::do_not_optimize(plane);
+        idet::bench::clobber_memory();
+    }
+    st.set_items_processed(st.iterations() * H * W);
+    st.set_label(nhwc ? "nhwc" : "nchw");
+}
+IDET_BENCHMARK(BM_ExtractHwChannel)->arg_names({"nhwc"})->args({0})->args({1});
+
+} // namespace
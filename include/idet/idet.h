@@ -9,6 +9,7 @@
  *   @ref idet::DetectorConfig).
  * - The main detector facade class (@ref idet::Detector) with an ABI-friendly backend
  *   (opaque implementation pointer plus an internal vtable).
+ * - A NUMA-sharded replica set (@ref idet::DetectorGroup) built on top of it.
  *
  * Error handling:
  * - Most APIs return @ref idet::Status or @ref idet::Result<T>.
@@ -35,6 +36,7 @@
 #include "status.h"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
@@ -72,13 +74,19 @@ enum class EngineKind : std::uint8_t {
     DBNet = 1,
     /** SCRFD face detector engine. */
     SCRFD = 2,
+    /**
+     * Model-free replay of a capture file (@ref RuntimePolicy::capture_file) named by
+     * @ref DetectorConfig::model_path; serves the task of @ref DetectorConfig::task.
+     */
+    Replay = 3,
 };
 
 /**
  * @brief Maps an engine kind to its corresponding high-level task.
  *
  * @param kind Engine kind.
- * @return Task category implied by @p kind, or @ref Task::None for unknown kinds.
+ * @return Task category implied by @p kind, or @ref Task::None for unknown kinds and for
+ *         @ref EngineKind::Replay, which serves either task.
  */
 constexpr Task engine_task(EngineKind kind) noexcept {
     switch (kind) {
@@ -117,6 +125,255 @@ using Quad = std::array<Point2f, 4>;
 /** @brief A dynamic list of quadrilateral detections. */
 using VecQuad = std::vector<Quad>;
 
+/**
+ * @brief Maps @p quads found on @p loaded's image back to the pixels of the encoded source.
+ *
+ * Undoes the decode-time reduction of @ref load_image(const std::string&, const LoadOptions&);
+ * leaves full-size decodes unchanged.
+ */
+inline void map_to_source(VecQuad& quads, const LoadedImage& loaded) noexcept {
+    for (auto& q : quads) {
+        for (auto& pt : q) {
+            pt.x /= loaded.scale_x;
+            pt.y /= loaded.scale_y;
+        }
+    }
+}
+
+/**
+ * @brief Structured detection result with confidence and optional landmarks.
+ *
+ * Produced by @ref idet::Detector::detect_ex. Geometry uses the same coordinate system
+ * and corner ordering as @ref idet::Quad.
+ */
+struct DetectionResult {
+    /** @brief Detected quadrilateral. */
+    Quad quad{};
+
+    /** @brief Engine confidence score (box score for text, face score for faces). */
+    float score = 0.0f;
+
+    /** @brief Whether @ref landmarks holds valid points (SCRFD exports with landmark heads). */
+    bool has_landmarks = false;
+
+    /** @brief 5-point face landmarks: left eye, right eye, nose, left mouth, right mouth. */
+    std::array<Point2f, 5> landmarks{};
+
+    /**
+     * @brief Index of the tile (row-major) that produced this detection, or -1 without tiling.
+     *
+     * For @ref idet::Detector::detect_rois: index of the region that produced it.
+     */
+    int tile = -1;
+
+    /** @brief Track identifier assigned by @ref idet::Detector::detect_track, or -1 outside tracking. */
+    int track_id = -1;
+};
+
+/** @brief A dynamic list of structured detections. */
+using VecDetection = std::vector<DetectionResult>;
+
+/**
+ * @brief Axis-aligned image region in integer pixel coordinates.
+ *
+ * Passed to @ref idet::Detector::detect_rois; the origin is the top-left corner of the image.
+ */
+struct Rect {
+    /** @brief Left edge (pixels). */
+    int x = 0;
+    /** @brief Top edge (pixels). */
+    int y = 0;
+    /** @brief Width in pixels. */
+    int width = 0;
+    /** @brief Height in pixels. */
+    int height = 0;
+};
+
+/**
+ * @brief Non-owning single-channel 8-bit motion mask (non-zero = pixel changed).
+ *
+ * Passed to @ref idet::Detector::detect_stream; must have the size of the frame.
+ */
+struct MotionMask {
+    /** @brief First byte of the first row. */
+    const std::uint8_t* data = nullptr;
+    /** @brief Mask width in pixels. */
+    int width = 0;
+    /** @brief Mask height in pixels. */
+    int height = 0;
+    /** @brief Bytes between consecutive row starts (>= width). */
+    std::size_t stride_bytes = 0;
+};
+
+/**
+ * @brief Timing of one tile of a tiled detection.
+ *
+ * Reported by @ref idet::Detector::last_tile_timings to expose load imbalance between tiles
+ * (e.g. text-dense tiles spending much longer in postprocessing than empty ones).
+ */
+struct TileTiming {
+    /** @brief Tile index (row-major). */
+    int tile = -1;
+
+    /** @brief Bound context used for the tile, or -1 for unbound inference. */
+    int context = -1;
+
+    /** @brief Index of the worker thread that processed the tile. */
+    int worker = 0;
+
+    /** @brief Start of the tile relative to the start of its frame, in milliseconds. */
+    double start_ms = 0.0;
+
+    /** @brief Duration of inference + decoding for the tile, in milliseconds. */
+    double ms = 0.0;
+
+    /** @brief True if the tile was unchanged and its cached detections were reused (see detect_stream). */
+    bool reused = false;
+};
+
+/**
+ * @brief Pipeline stage timed by @ref idet::DetectorStats.
+ */
+enum class Stage : std::uint8_t {
+    /** Color conversion, resize and normalization into the input tensor. */
+    Preprocess = 0,
+    /** ONNX Runtime session run. */
+    Run = 1,
+    /** Decoding of the raw outputs (probability map contours / anchor heads) into detections. */
+    Decode = 2,
+    /** Detector-level suppression: NMS or tile merge. */
+    Nms = 3,
+};
+
+/** @brief Number of @ref idet::Stage values. */
+constexpr int kStageCount = 4;
+
+/** @brief Short lowercase name of a stage ("preprocess", "run", "decode", "nms"). */
+constexpr const char* stage_name(Stage s) noexcept {
+    switch (s) {
+    case Stage::Preprocess:
+        return "preprocess";
+    case Stage::Run:
+        return "run";
+    case Stage::Decode:
+        return "decode";
+    case Stage::Nms:
+        return "nms";
+    default:
+        return "unknown";
+    }
+}
+
+/**
+ * @brief Log-linear latency histogram of one pipeline stage.
+ *
+ * Durations are bucketed in microseconds with four buckets per power of two (relative bucket
+ * width <= 25%), from 1 us up to about 33 s; longer samples land in the last bucket.
+ */
+struct StageHistogram {
+    /** @brief Number of buckets. */
+    static constexpr int kBuckets = 96;
+
+    /** @brief Number of samples. */
+    std::uint64_t count = 0;
+
+    /** @brief Sum of all samples, in milliseconds. */
+    double total_ms = 0.0;
+
+    /** @brief Largest sample, in milliseconds. */
+    double max_ms = 0.0;
+
+    /** @brief Sample count per bucket (see @ref bucket_of). */
+    std::array<std::uint64_t, kBuckets> buckets{};
+
+    /** @brief Bucket index of a duration of @p us microseconds. */
+    static constexpr int bucket_of(std::uint64_t us) noexcept {
+        if (us < 4) return (int)us;
+        int oct = 0; // floor(log2(us)), >= 2
+        for (std::uint64_t v = us; v > 1; v >>= 1)
+            ++oct;
+        const int b = 4 * (oct - 1) + (int)((us >> (oct - 2)) & 3u);
+        return b < kBuckets ? b : kBuckets - 1;
+    }
+
+    /** @brief Smallest duration (microseconds) of bucket @p b. */
+    static constexpr std::uint64_t bucket_lower_us(int b) noexcept {
+        return b < 4 ? (std::uint64_t)b : (std::uint64_t)(4 + (b & 3)) << (b / 4 - 1);
+    }
+
+    /** @brief Mean sample, in milliseconds (0 without samples). */
+    double mean_ms() const noexcept {
+        return count ? total_ms / (double)count : 0.0;
+    }
+
+    /**
+     * @brief Approximate quantile, in milliseconds.
+     *
+     * @param q Quantile in [0,1].
+     * @return Midpoint of the bucket holding the quantile sample, clamped to @ref max_ms; 0 without samples.
+     */
+    double quantile_ms(double q) const noexcept {
+        if (count == 0) return 0.0;
+        q = q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q);
+        const double rank = q * (double)(count - 1);
+        std::uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += buckets[(std::size_t)b];
+            if ((double)seen > rank) {
+                const double lo = (double)bucket_lower_us(b);
+                const double hi = b + 1 < kBuckets ? (double)bucket_lower_us(b + 1) : lo;
+                const double mid_ms = 0.5 * (lo + hi) * 1e-3;
+                return mid_ms < max_ms ? mid_ms : max_ms;
+            }
+        }
+        return max_ms;
+    }
+};
+
+/**
+ * @brief Per-stage latency histograms and work counters of a detector.
+ *
+ * Returned by @ref idet::Detector::stats. Counters accumulate from detector creation or the last
+ * @ref idet::Detector::reset_stats; the engine stages record one sample per invocation, i.e. per
+ * tile for tiled frames and per session run for batched runs.
+ */
+struct DetectorStats {
+    /** @brief Histograms indexed by @ref idet::Stage. */
+    std::array<StageHistogram, kStageCount> stages{};
+
+    /** @brief Frames that went through detector-level postprocessing. */
+    std::uint64_t frames = 0;
+
+    /** @brief Tiles processed by tiled frames (unchanged tiles reused by detect_stream included). */
+    std::uint64_t tiles = 0;
+
+    /** @brief Detections entering NMS / tile merge (after the min-size filter). */
+    std::uint64_t candidates = 0;
+
+    /** @brief Detections left after NMS / tile merge. */
+    std::uint64_t kept = 0;
+
+    /** @brief Scratch bytes served by the postprocessing frame arenas. */
+    std::uint64_t bytes_allocated = 0;
+
+    /** @brief Frames answered by the cascade probe alone (see @ref idet::CascadeOptions). */
+    std::uint64_t cascade_skipped = 0;
+
+    /** @brief Frames whose full pass the cascade limited to the triggered region. */
+    std::uint64_t cascade_cropped = 0;
+
+    /** @brief Quality level in effect (0: configured resolution, see @ref idet::QualityOptions). */
+    int quality_level = 0;
+
+    /** @brief Quality level changes applied. */
+    std::uint64_t quality_changes = 0;
+
+    /** @brief Histogram of stage @p s. */
+    const StageHistogram& stage(Stage s) const noexcept {
+        return stages[(std::size_t)s];
+    }
+};
+
 /**
  * @brief Discrete grid specification (rows x cols).
  *
@@ -129,6 +386,274 @@ struct GridSpec {
     int cols = 1;
 };
 
+/**
+ * @brief Contour scoring strategy of text (DBNet) postprocessing.
+ *
+ * Every candidate contour of the binarized map is scored by the mean probability under it and
+ * compared against @ref idet::InferenceOptions::box_thresh. On dense pages this dominates
+ * postprocessing, so cheaper approximations can be selected.
+ */
+enum class ScoreMode : std::uint8_t {
+    /** Mean under the rasterized contour polygon (filled mask); reference behavior. */
+    Polygon = 0,
+    /** Mean under the contour polygon accumulated span by span, without building a mask. */
+    Scanline = 1,
+    /** Mean under the min-area rectangle of the contour (PaddleOCR "fast" score mode). */
+    Box = 2,
+};
+
+/**
+ * @brief Reduction applied by @ref idet::InferenceOptions::map_downsample to each 2x2 block of the map.
+ */
+enum class MapPooling : std::uint8_t {
+    /** Block maximum; keeps thin strokes and commutes with the sigmoid of logit outputs. */
+    Max = 0,
+    /** Block mean; smoother contours, slightly lower scores near edges. */
+    Average = 1,
+};
+
+/**
+ * @brief Suppression rule of the common NMS (see @ref idet::InferenceOptions::nms_iou).
+ */
+enum class NmsMode : std::uint8_t {
+    /** Greedy NMS: a detection overlapping a better one with IoU >= @c nms_iou is removed. */
+    Hard = 0,
+    /** Soft-NMS: instead of removal the score is multiplied by (1 - IoU) when IoU >= @c nms_iou. */
+    SoftLinear = 1,
+    /** Soft-NMS: every overlapping detection's score is multiplied by exp(-IoU^2 / @c nms_sigma). */
+    SoftGaussian = 2,
+    /** Greedy NMS; each kept quad is replaced by the score-weighted mean of the quads it removed. */
+    Weighted = 3,
+};
+
+/**
+ * @brief How frames are split into tiles.
+ */
+enum class TileMode : std::uint8_t {
+    /** Fixed @ref idet::InferenceOptions::tiles_dim grid; tiles are resized to the model input. */
+    Grid = 0,
+    /**
+     * Tiles of exactly the model input shape (the bound shape, else @c fixed_input_dim, else
+     * @c max_img_size squared), as many as needed to cover the frame. Tiles reach the network
+     * without resampling, so small objects keep their native resolution.
+     */
+    Adaptive = 1,
+};
+
+/**
+ * @brief How detections of different tiles are merged.
+ */
+enum class TileMerge : std::uint8_t {
+    /** Global polygon NMS over all detections of the frame. */
+    Nms = 0,
+    /**
+     * Suppression only among detections near a tile seam (see @ref idet::InferenceOptions::nms_iou);
+     * detections inside a single tile are kept as produced. Cost follows the seam density.
+     */
+    Seams = 1,
+    /** As @ref Seams, and text fragments cut by a seam are dropped when covered or joined when abutting. */
+    SeamsJoin = 2,
+};
+
+/**
+ * @brief What a detection call does when it needs a bound context and all of them are in use.
+ *
+ * Applies to @ref idet::Detector::detect, @ref idet::Detector::detect_ex and
+ * @ref idet::Detector::detect_batch with a prepared binding, which check a context out per call.
+ */
+enum class ContextOverflow : std::uint8_t {
+    /** Block until another call returns its context. */
+    Wait = 0,
+    /** After @ref idet::InferenceOptions::context_wait_ms, run unbound on the shared session instead. */
+    Unbound = 1,
+    /** After @ref idet::InferenceOptions::context_wait_ms, return @ref idet::Status::Code::Unavailable. */
+    Fail = 2,
+};
+
+/**
+ * @brief Change detection thresholds of @ref idet::Detector::detect_stream.
+ *
+ * A tile is re-inferred when more than @ref tile_change of its sampled pixels changed since the
+ * tile was last inferred; otherwise its cached detections are reused.
+ */
+struct StreamOptions {
+    /** @brief A sampled pixel counts as changed when any channel differs by more than this (0..255). */
+    int pixel_diff = 16;
+
+    /** @brief Fraction of changed samples in [0, 1] above which a tile is re-inferred. */
+    float tile_change = 0.005f;
+
+    /** @brief Sampling stride in both directions (1 compares every pixel). */
+    int sample_step = 2;
+
+    /** @brief Re-infer a tile after it has been reused for this many frames (0 = only on change). */
+    int refresh_frames = 0;
+};
+
+/**
+ * @brief Speculative low-resolution pre-pass that skips frames without objects.
+ *
+ * Applies to @ref idet::Detector::detect, @ref idet::Detector::detect_ex and their bound variants.
+ * When enabled, every frame first runs through a probe engine: the same model letterboxed into a
+ * @ref probe_size square, with the score thresholds lowered to @ref trigger. A frame where the
+ * probe finds nothing returns no detections without the full-resolution (or tiled) pass. Otherwise
+ * the full pass runs on the union of the probe detections grown by @ref roi_margin, or on the
+ * whole frame when that region covers more than @ref roi_max_area of it.
+ *
+ * The probe shares the session (weights) of the main engine. With a prepared binding it gets its
+ * own binding with one context per main context, so bound calls stay on pre-bound tensors.
+ */
+struct CascadeOptions {
+    /** @brief Whether frames go through the probe first. */
+    bool enabled = false;
+
+    /** @brief Side of the square probe input in pixels (multiple of 32, >= 32). */
+    int probe_size = 320;
+
+    /**
+     * @brief Probe score threshold in [0, 1].
+     *
+     * Replaces @ref InferenceOptions::box_thresh (the SCRFD score threshold) and caps
+     * @ref InferenceOptions::bin_thresh of the probe. Keep it below the regular thresholds, so
+     * that small objects blurred by the downscale still trigger.
+     */
+    float trigger = 0.3f;
+
+    /** @brief Growth of the triggered region on every side, as a fraction of its longer side (>= 0). */
+    float roi_margin = 0.25f;
+
+    /** @brief Largest region, as a fraction of the frame area in [0, 1], run alone (0: always the whole frame). */
+    float roi_max_area = 0.5f;
+};
+
+/**
+ * @brief Tracking-assisted streaming of @ref idet::Detector::detect_track.
+ *
+ * Only keyframes run the full detection (cascade and tiling included). On the frames in between
+ * every track is moved by its constant-velocity estimate, and only crops around the predicted
+ * boxes are inferred (on bound contexts when a binding is prepared) to verify and refine them;
+ * detections are associated with the tracks by IoU. A keyframe runs every
+ * @ref keyframe_interval frames, on a scene change, when the crops would cover more than
+ * @ref max_region_area of the frame, and after a frame size change.
+ *
+ * With a budget (@ref target_ms and/or @ref cpu_share) the interval is stretched, up to
+ * @ref max_interval, until the measured keyframe and tracked-frame costs amortize within it.
+ */
+struct TrackOptions {
+    /** @brief Full detection every this many frames (>= 1; 1 detects every frame). */
+    int keyframe_interval = 10;
+
+    /** @brief Largest interval the budget may stretch @ref keyframe_interval to (>= keyframe_interval). */
+    int max_interval = 30;
+
+    /**
+     * @brief Fraction of changed samples of a coarse frame thumbnail, in [0, 1], that forces a keyframe.
+     *
+     * Samples are compared against the last keyframe with @ref StreamOptions::pixel_diff; 1 disables
+     * scene change detection.
+     */
+    float scene_change = 0.3f;
+
+    /** @brief Minimum IoU in [0, 1] between a predicted track and a detection to associate them. */
+    float iou_match = 0.3f;
+
+    /** @brief Growth of each verification crop on every side, as a fraction of the box's longer side (>= 0). */
+    float verify_margin = 0.5f;
+
+    /** @brief Tracked frames a track survives without verification, reported at its predicted box (>= 0). */
+    int max_misses = 2;
+
+    /** @brief Crop area, as a fraction of the frame in [0, 1], above which a keyframe runs instead. */
+    float max_region_area = 0.5f;
+
+    /** @brief Target mean latency per frame in ms (0: no latency budget). */
+    float target_ms = 0.0f;
+
+    /** @brief Target share in [0, 1] of the time between calls spent detecting (0: no CPU budget). */
+    float cpu_share = 0.0f;
+};
+
+/**
+ * @brief One reduced-cost step of @ref QualityOptions.
+ *
+ * Zero fields keep the configured value of level 0.
+ */
+struct QualityLevel {
+    /** @brief @ref InferenceOptions::max_img_size at this level (0: configured value). */
+    int max_img_size = 0;
+
+    /** @brief @ref InferenceOptions::tiles_dim at this level ({0, 0}: configured grid; ignored by adaptive tiles). */
+    GridSpec tiles_dim{0, 0};
+};
+
+/**
+ * @brief Load-adaptive quality control: trades resolution for latency under load.
+ *
+ * The detector measures the wall time of every single-frame call (@ref idet::Detector::detect,
+ * @ref idet::Detector::detect_ex and their bound variants, the wait for a bound context
+ * included) and samples the queue depth: callers waiting for a bound context plus asynchronous
+ * frames in flight. When the latency average exceeds @ref target_ms or the queue is deeper than
+ * @ref max_queue, the next call applies the next entry of @ref levels through the same hot update
+ * as @ref idet::Detector::update_config; when the latency predicted for the level above fits
+ * @ref recover of the target again, it steps back up. The level in effect is reported by
+ * @ref DetectorStats::quality_level.
+ *
+ * Frames are never dropped; a level change waits for the calls in flight, like a configuration
+ * update. Unbound inference resizes to the level's @c max_img_size directly. A binding pool
+ * (@ref InferenceOptions::bind_buckets) also binds the shapes of every level up front, and bound
+ * frames move to the smallest bucket holding them at the level's size; a single bound shape only
+ * changes with the tile grid. @ref idet::Detector::update_config and @ref idet::Detector::reload
+ * return to level 0.
+ *
+ * Enabled by a positive @ref target_ms or @ref max_queue.
+ */
+struct QualityOptions {
+    /** @brief Latency target (SLO) of a call in ms (0: the queue depth alone decides). */
+    float target_ms = 0.0f;
+
+    /** @brief Queue depth above which the level steps down (0: the latency alone decides). */
+    int max_queue = 0;
+
+    /**
+     * @brief Reduced-cost levels after the configured one, in order.
+     *
+     * Empty: 3/4 and 1/2 of @ref InferenceOptions::max_img_size (aligned down to 32).
+     */
+    std::vector<QualityLevel> levels{};
+
+    /** @brief Fraction in (0, 1] of @ref target_ms the level above must be predicted to fit before stepping up. */
+    float recover = 0.8f;
+
+    /** @brief Calls measured at a level before it may change again (>= 1). */
+    int hold_frames = 8;
+};
+
+/**
+ * @brief Timing of @ref EngineKind::Replay.
+ *
+ * Every call replays the next frame of the capture (in call order, shared by all threads) after a
+ * synthetic model latency of @ref latency_ms; the jitter is derived from the frame index, so two
+ * runs see the same latency sequence.
+ */
+struct ReplayOptions {
+    /** @brief Synthetic latency of one model run in ms (>= 0). */
+    float latency_ms = 0.0f;
+
+    /** @brief Maximum deviation from @ref latency_ms in ms (>= 0), uniform per frame. */
+    float jitter_ms = 0.0f;
+
+    /**
+     * @brief Busy-waits the latency instead of sleeping.
+     *
+     * A spinning thread occupies its core like a CPU model run would; sleeping models an
+     * accelerator that leaves the CPU free.
+     */
+    bool spin = false;
+
+    /** @brief Starts over after the last frame; otherwise further calls fail with Unavailable. */
+    bool loop = true;
+};
+
 /**
  * @brief Inference and postprocessing options for the selected engine.
  *
@@ -167,6 +692,14 @@ struct InferenceOptions {
      */
     float box_thresh = 0.5f;
 
+    /**
+     * @brief Contour scoring strategy used by text detectors.
+     *
+     * @ref ScoreMode::Scanline and @ref ScoreMode::Box trade a small score deviation for
+     * substantially cheaper scoring when many regions are detected.
+     */
+    ScoreMode score_mode = ScoreMode::Polygon;
+
     /**
      * @brief Unclip ratio for expanding detected text boxes.
      *
@@ -174,6 +707,26 @@ struct InferenceOptions {
      */
     float unclip = 1.0f;
 
+    /**
+     * @brief Downsampling factor of the text probability map before postprocessing (1, 2 or 4).
+     *
+     * Binarization, contour extraction and scoring then run on a map with 1/f^2 of the pixels;
+     * the contours are mapped back to image coordinates at the full map resolution. Suited to
+     * large inputs with text much taller than f pixels.
+     */
+    int map_downsample = 1;
+
+    /** @brief Reduction used by @ref map_downsample. */
+    MapPooling map_pooling = MapPooling::Max;
+
+    /**
+     * @brief Score text contours on an 8-bit quantized probability map.
+     *
+     * The map (after @ref map_downsample) is converted once to `round(255 * p)` and contour
+     * scores are computed from bytes; scores deviate by at most 1/510 from the float map.
+     */
+    bool map_u8 = false;
+
     /**
      * @brief Maximum image size used for resizing before inference.
      *
@@ -198,6 +751,41 @@ struct InferenceOptions {
      */
     GridSpec fixed_input_dim{0, 0};
 
+    /**
+     * @brief Representative frame sizes (rows x cols) for a multi-resolution binding pool.
+     *
+     * When non-empty, @ref idet::Detector::prepare_binding_pool binds one input shape per entry
+     * instead of the single @ref fixed_input_dim, so mixed resolutions are letterboxed into the
+     * closest bound shape without rebinding. Either this or @ref fixed_input_dim is required by
+     * @ref bind_io.
+     */
+    std::vector<GridSpec> bind_buckets{};
+
+    /**
+     * @brief Aspect-preserving resize instead of stretching frames to the network input.
+     *
+     * The frame is scaled by one factor into the top-left corner of the input and the rest is
+     * constant padding, which is cropped from the output before postprocessing. Applies to
+     * unbound inference and to a single bound shape (written once by @ref idet::Detector::prepare_binding);
+     * a binding pool (@ref bind_buckets) always letterboxes.
+     */
+    bool letterbox = false;
+
+    /**
+     * @brief Policy for calls that find every bound context checked out by other threads.
+     *
+     * More concurrent callers than prepared contexts either queue for a context or, after
+     * @ref context_wait_ms, fall back to unbound inference or fail fast.
+     */
+    ContextOverflow context_overflow = ContextOverflow::Wait;
+
+    /**
+     * @brief How long (ms, >= 0) a call waits for a free context before @ref context_overflow applies.
+     *
+     * Ignored by @ref ContextOverflow::Wait; 0 falls back (or fails) immediately.
+     */
+    int context_wait_ms = 0;
+
     /**
      * @brief Tiling grid dimension (rows x cols).
      *
@@ -212,6 +800,39 @@ struct InferenceOptions {
      */
     float tile_overlap = 0.1f;
 
+    /**
+     * @brief Tiling strategy.
+     *
+     * With @ref TileMode::Adaptive, @ref tiles_dim is ignored and the grid follows from the frame
+     * size; neighbouring tiles overlap by @ref tile_overlap of the tile size, but by at least
+     * @ref tile_min_object pixels.
+     */
+    TileMode tile_mode = TileMode::Grid;
+
+    /**
+     * @brief Largest object size (pixels) that adaptive tiles must keep whole; 0 = no constraint.
+     *
+     * Every object up to this size lies entirely inside at least one tile.
+     */
+    int tile_min_object = 0;
+
+    /**
+     * @brief Merge strategy for tiled frames.
+     *
+     * Face detectors still run NMS inside every tile with the seam modes, since their raw output
+     * contains overlapping anchors; @ref TileMerge::SeamsJoin joins fragments for text only.
+     */
+    TileMerge tile_merge = TileMerge::Nms;
+
+    /**
+     * @brief Runs the equal-sized tiles of a bound tiled frame as batched session calls.
+     *
+     * Up to `max_batch` tiles (see @ref idet::Detector::prepare_binding) share one `[N,3,H,W]`
+     * input and one session run, and their outputs are decoded in parallel. Has no effect on
+     * unbound inference or with `max_batch == 1`.
+     */
+    bool tile_batch = false;
+
     /**
      * @brief IoU threshold for Non-Maximum Suppression (NMS).
      *
@@ -225,68 +846,299 @@ struct InferenceOptions {
      * true -> AABB IoU approximation (faster, less accurate for rotated quads).
      * false -> polygon IoU (exact for convex quads, slower).
      */
-    bool use_fast_iou = false;
-};
+    bool use_fast_iou = false;
+
+    /**
+     * @brief Suppression rule of the common NMS.
+     *
+     * Soft-NMS modes keep overlapping detections with decayed scores and drop those decayed
+     * below @ref box_thresh; results are reordered by the decayed score. Tiled frames merged with
+     * @ref TileMerge::Seams or @ref TileMerge::SeamsJoin always use hard suppression at the seams.
+     */
+    NmsMode nms_mode = NmsMode::Hard;
+
+    /** @brief Gaussian decay width of @ref NmsMode::SoftGaussian (> 0). */
+    float nms_sigma = 0.5f;
+
+    /** @brief Change detection used by @ref idet::Detector::detect_stream. */
+    StreamOptions stream{};
+
+    /** @brief Low-resolution pre-pass that skips empty frames (see @ref CascadeOptions). */
+    CascadeOptions cascade{};
+
+    /** @brief Keyframe interval, association and budget of @ref idet::Detector::detect_track. */
+    TrackOptions track{};
+
+    /** @brief Load-adaptive resolution / tiling (see @ref QualityOptions). */
+    QualityOptions quality{};
+
+    /** @brief Latency model of @ref EngineKind::Replay (ignored by the other engines). */
+    ReplayOptions replay{};
+};
+
+/**
+ * @brief NUMA-aware memory policy hint for runtime setup.
+ *
+ * This setting controls how the runtime prefers to place or bind memory on NUMA systems.
+ * Actual behavior is platform- and implementation-dependent. On non-NUMA platforms, this
+ * may have no effect.
+ */
+enum class NumaMemPolicy {
+    /** Prefer lowest latency (e.g., local allocations and locality-first behavior). */
+    Latency = 0,
+    /** Prefer throughput (may allow broader placement to reduce contention). */
+    Throughput = 1,
+    /** Prefer strict placement/binding where supported; may fail if constraints cannot be met. */
+    Strict = 2
+};
+
+/**
+ * @brief Spin-wait behavior of idle ONNX Runtime pool threads between parallel sections.
+ *
+ * Spinning keeps intra-/inter-op threads hot, which lowers latency on dedicated cores but burns
+ * CPU between frames; on shared hosts blocking is usually the better choice.
+ */
+enum class SpinPolicy {
+    /** ONNX Runtime default (spinning enabled). */
+    Default = 0,
+    /** Idle threads spin before sleeping. */
+    Spin = 1,
+    /** Idle threads block immediately. */
+    NoSpin = 2
+};
+
+/** @brief CPU memory allocation strategy of the ORT session. */
+enum class ArenaPolicy {
+    /** Arena allocator plus memory pattern planning (ORT default, fastest for stable shapes). */
+    Arena = 0,
+    /** Arena whose unused chunks are released after every run (lower idle RSS, extra allocations). */
+    ArenaShrink = 1,
+    /** No arena and no memory pattern: every intermediate tensor is a plain heap allocation. */
+    Off = 2
+};
+
+/**
+ * @brief Execution provider registered ahead of the default CPU provider.
+ *
+ * Nodes the provider does not take stay on the CPU provider. A provider that is not compiled into
+ * the linked ONNX Runtime makes detector creation fail with @ref Status::Code::Unsupported.
+ */
+enum class ExecutionProvider {
+    /** Default CPU provider (MLAS) only. */
+    CPU = 0,
+    /** XNNPACK (mobile / ARM oriented kernels); uses @ref RuntimePolicy::ort_intra_threads threads. */
+    XNNPACK = 1,
+    /** oneDNN (formerly DNNL), x86 oriented kernels. */
+    DNNL = 2,
+    /** Apple CoreML (macOS / iOS). */
+    CoreML = 3
+};
+
+/**
+ * @brief Allocation of the bound input/output buffers of the binding contexts.
+ *
+ * Every bound frame walks these buffers (several MB per context at typical input sizes): the
+ * preprocessing writes the input, the session reads it and writes the outputs, the decoder reads
+ * those. Pages are first touched by the thread setting up the binding, so on NUMA systems they
+ * land on its node (the replica node in @ref idet::DetectorGroup).
+ */
+enum class BufferPolicy {
+    /** Plain heap allocations. */
+    Heap = 0,
+    /** Cache-line (64-byte) aligned heap allocations. */
+    Aligned = 1,
+    /**
+     * Buffers of 1 MiB and more in 2 MiB pages: reserved huge pages (@c MAP_HUGETLB) when the
+     * system has them, else transparent huge pages. Smaller buffers and platforms other than Linux
+     * fall back to @ref Aligned.
+     */
+    HugePages = 2
+};
+
+/**
+ * @brief Runtime policy controlling threading, binding, and global runtime behavior.
+ *
+ * This structure configures execution characteristics, typically affecting ONNX Runtime and
+ * tile-parallel execution.
+ *
+ * @note
+ * Actual effect depends on the selected execution provider(s) and the internal runtime implementation.
+ */
+struct RuntimePolicy {
+    /** @brief ONNX Runtime intra-op thread count (operator-level parallelism). */
+    int ort_intra_threads = 1;
+
+    /** @brief ONNX Runtime inter-op thread count (graph-level parallelism). */
+    int ort_inter_threads = 1;
+
+    /**
+     * @brief Thread count used for tile-parallel execution.
+     *
+     * Relevant when tiling is enabled: tiles run on the library worker pool (the calling thread
+     * included; asynchronous tiled submission uses this many pool workers). The pool is independent
+     * of OpenMP, so the name is historical. Values <= 0 use one thread per CPU of the affinity mask.
+     */
+    int tile_omp_threads = 1;
+
+    /**
+     * @brief OpenMP thread count used for postprocessing of a single frame's outputs.
+     *
+     * Text: contour scoring, box fitting and unclipping are spread over this many threads when a
+     * map yields enough contours (large untiled images). Face: the stride heads are decoded in
+     * parallel (at most one thread per head) for large inputs. Inside tiled inference each tile
+     * decodes serially since the tiles already occupy the pool threads. Values <= 0 use one thread
+     * per CPU of the affinity mask.
+     */
+    int post_omp_threads = 1;
+
+    /**
+     * @brief Pins the library worker pool threads one per CPU.
+     *
+     * The pool (tiles, postprocessing, asynchronous tiled submission; shared by all detectors of
+     * the process) takes CPUs in the same topology order as the process placement, skipping the
+     * first one (left to the calling thread) and those of pinned global ORT pools
+     * (@ref ort_global_pools). Without it, pool threads inherit the affinity mask of the thread
+     * that starts them. Pinning is fixed by the first @ref idet::setup_runtime_policy or detector
+     * that starts pool threads. Ignored by @ref idet::DetectorGroup.
+     */
+    bool pin_worker_threads = false;
+
+    /**
+     * @brief Enables "soft" memory binding policies when applicable.
+     *
+     * This may affect NUMA locality and memory allocation strategies in runtime setup.
+     * Exact behavior is implementation-defined.
+     */
+    bool soft_mem_bind = true;
+
+    /** @brief Memory placement policy hint for NUMA-capable systems. */
+    NumaMemPolicy numa_mem_policy = NumaMemPolicy::Latency;
+
+    /**
+     * @brief Suppresses OpenCV internal threading globally.
+     *
+     * Often used to avoid thread oversubscription when the application already controls parallelism.
+     *
+     * @warning
+     * If this toggles a global OpenCV setting, it may affect other OpenCV users within the same process.
+     */
+    bool suppress_opencv = true; // globally
+
+    /**
+     * @brief Optional file path of a persistent output-shape cache.
+     *
+     * Bound setup needs the model's output shapes for the bound input size. When the model does
+     * not declare them statically they are probed with one dummy inference; probed shapes are
+     * always cached per process, and additionally appended to this file (keyed by model content
+     * hash and input shape) so later processes skip the probe. Empty disables the file.
+     */
+    std::string shape_cache_file{};
+
+    /**
+     * @brief Shares one ORT session between detectors of the same model and session options.
+     *
+     * Weights are then loaded and optimized once per process instead of once per detector;
+     * every detector keeps its own bindings and buffers. Concurrent runs of sharing detectors
+     * use the intra-op thread pool of the shared session.
+     */
+    bool share_session = false;
+
+    /**
+     * @brief Optional path of an ORT optimized-model file.
+     *
+     * On first use ORT saves the optimized graph there (plus a `.hash` stamp of the source
+     * model); later sessions of the same model load it directly and skip graph optimization.
+     * A stamp mismatch (edited model) regenerates the file. Empty disables it.
+     */
+    std::string optimized_model_file{};
+
+    /**
+     * @brief Creates the session from a read-only memory mapping of @ref idet::DetectorConfig::model_path.
+     *
+     * The model is read from the page cache instead of a private heap copy. For ORT-format models
+     * (@c .ort, see the @c embed_ort_format build option) the session also uses the mapped bytes
+     * in place, initializers included, so weight pages are shared by every process running the
+     * model and creation needs no parsing copy. Embedded ORT-format models are always used in place.
+     */
+    bool mmap_model = false;
+
+    /**
+     * @brief File prefix of an ORT profiling trace; empty disables profiling.
+     *
+     * ORT appends a timestamp and `.json`. The trace (Chrome trace format, one event per executed
+     * node) is written after @ref profile_runs session runs or by @ref idet::Detector::end_profiling,
+     * whichever comes first. Profiled sessions are never shared (see @ref share_session).
+     *
+     * @note Per-node timing adds overhead to every run while profiling is active.
+     */
+    std::string profile_prefix{};
+
+    /**
+     * @brief Session runs recorded in the profiling trace (<= 0: until @ref idet::Detector::end_profiling).
+     *
+     * Runs are counted per session: a tiled frame contributes one run per tile.
+     */
+    int profile_runs = 0;
+
+    /** @brief Spin-wait policy of the session's intra-op and inter-op thread pools. */
+    SpinPolicy ort_spin = SpinPolicy::Default;
+
+    /**
+     * @brief Runs independent graph branches concurrently (ORT_PARALLEL).
+     *
+     * Only pays off for models with parallel branches and @ref ort_inter_threads > 1; the default
+     * sequential mode is usually faster for the single-path DBNet / SCRFD graphs.
+     */
+    bool ort_parallel = false;
 
-/**
- * @brief NUMA-aware memory policy hint for runtime setup.
- *
- * This setting controls how the runtime prefers to place or bind memory on NUMA systems.
- * Actual behavior is platform- and implementation-dependent. On non-NUMA platforms, this
- * may have no effect.
- */
-enum class NumaMemPolicy {
-    /** Prefer lowest latency (e.g., local allocations and locality-first behavior). */
-    Latency = 0,
-    /** Prefer throughput (may allow broader placement to reduce contention). */
-    Throughput = 1,
-    /** Prefer strict placement/binding where supported; may fail if constraints cannot be met. */
-    Strict = 2
-};
+    /** @brief CPU memory allocation strategy of the session. */
+    ArenaPolicy ort_arena = ArenaPolicy::Arena;
 
-/**
- * @brief Runtime policy controlling threading, binding, and global runtime behavior.
- *
- * This structure configures execution characteristics, typically affecting ONNX Runtime and
- * tile-parallel execution.
- *
- * @note
- * Actual effect depends on the selected execution provider(s) and the internal runtime implementation.
- */
-struct RuntimePolicy {
-    /** @brief ONNX Runtime intra-op thread count (operator-level parallelism). */
-    int ort_intra_threads = 1;
+    /**
+     * @brief Flushes denormal floats to zero in the session threads (`session.set_denormal_as_zero`).
+     *
+     * Avoids slow denormal arithmetic in layers with tiny activations; may change outputs in the
+     * last bits.
+     */
+    bool ort_denormal_as_zero = false;
 
-    /** @brief ONNX Runtime inter-op thread count (graph-level parallelism). */
-    int ort_inter_threads = 1;
+    /** @brief Execution provider tried before the CPU provider. */
+    ExecutionProvider ort_provider = ExecutionProvider::CPU;
 
     /**
-     * @brief OpenMP thread count used for tile-parallel execution.
+     * @brief Allocation of the bound I/O buffers (see @ref BufferPolicy).
      *
-     * Relevant when tiling is enabled and the library uses OpenMP to process tiles concurrently.
+     * The memory ORT allocates itself (intermediate tensors, see @ref ort_arena) is not affected.
      */
-    int tile_omp_threads = 1;
+    BufferPolicy bound_buffers = BufferPolicy::Heap;
 
     /**
-     * @brief Enables "soft" memory binding policies when applicable.
+     * @brief Optional capture file of the raw model outputs; empty disables recording.
      *
-     * This may affect NUMA locality and memory allocation strategies in runtime setup.
-     * Exact behavior is implementation-defined.
+     * DBNet and SCRFD engines append every decoded frame (probability plane or head tensors plus
+     * the mapping to image coordinates) to this file, which is truncated when the first engine
+     * opens it; engines of one process recording the same task share it. Replay the file with
+     * @ref EngineKind::Replay to run the postprocessing and the detector pipeline without a model.
+     *
+     * @note Every frame is copied and written synchronously; meant for diagnostics, not production.
      */
-    bool soft_mem_bind = true;
-
-    /** @brief Memory placement policy hint for NUMA-capable systems. */
-    NumaMemPolicy numa_mem_policy = NumaMemPolicy::Latency;
+    std::string capture_file{};
 
     /**
-     * @brief Suppresses OpenCV internal threading globally.
+     * @brief Runs the sessions on process-global ORT intra-/inter-op thread pools.
      *
-     * Often used to avoid thread oversubscription when the application already controls parallelism.
+     * Without it each detector's session starts its own pools, so several detectors in one process
+     * oversubscribe the cores. With it the pools are created once with the process-wide ORT
+     * environment - sized by @ref ort_intra_threads / @ref ort_inter_threads (and @ref ort_spin,
+     * @ref ort_denormal_as_zero) of the policy that creates it: @ref idet::setup_runtime_policy or
+     * else the first detector - and every detector setting this flag shares them. Intra-op threads
+     * are pinned one per CPU in the same topology order as the process placement, so
+     * the thread budget of @ref idet::setup_runtime_policy holds for all detectors together.
      *
-     * @warning
-     * If this toggles a global OpenCV setting, it may affect other OpenCV users within the same process.
+     * Creating a detector with this flag fails with Invalid if the environment already exists
+     * without global pools. Ignored by @ref idet::DetectorGroup (replicas keep node-local pools).
      */
-    bool suppress_opencv = true; // globally
+    bool ort_global_pools = false;
 };
 
 /**
@@ -345,6 +1197,14 @@ struct DetectorConfig final {
     static DetectorConfig setup(Task task, std::string model_path);
 };
 
+/**
+ * @brief Identifier of a frame submitted via @ref idet::Detector::submit.
+ *
+ * Tickets are unique per detector and increase in submission order. A ticket is consumed by a
+ * successful @ref idet::Detector::wait.
+ */
+using Ticket = std::uint64_t;
+
 namespace detail {
 /** @brief Internal detector vtable type (not part of the public API). */
 struct DetectorVTable;
@@ -368,9 +1228,18 @@ struct DetectorVTable;
  * - Copy is disabled; move is supported.
  *
  * @thread_safety
- * Thread safety depends on the underlying engine implementation and runtime configuration.
- * Unless explicitly documented otherwise, assume that calling non-const operations concurrently
- * on the same instance is not safe.
+ * One detector may be shared by request threads: @ref detect, @ref detect_ex, @ref detect_batch, @ref detect_rois,
+ * @ref detect_stream and @ref detect_track may be called concurrently. With bind_io each call
+ * checks a free bound context out of a lock-free pool and returns it when done; callers beyond the
+ * prepared @c contexts follow @ref InferenceOptions::context_overflow. @ref detect_stream and
+ * @ref detect_track calls take turns (the tile cache and the tracks describe one stream each).
+ * @ref reload may run concurrently with detection.
+ *
+ * @ref detect_bound / @ref detect_bound_ex address contexts explicitly and bypass the pool, so the
+ * caller owns those contexts and must not mix them with concurrent pooled calls. Binding setup and
+ * @ref update_config wait for running calls to finish. The async API (@ref submit, @ref poll,
+ * @ref wait) may be called from several threads; it runs on the same contexts and must not be used
+ * concurrently with pooled detection on one instance.
  */
 class IDET_API Detector final {
   public:
@@ -461,15 +1330,59 @@ class IDET_API Detector final {
     /**
      * @brief Updates the configuration of an existing detector instance.
      *
-     * The implementation may reconfigure preprocessing/postprocessing thresholds, tiling, runtime
-     * options, or engine-specific parameters. Some changes may require rebinding I/O or
-     * reinitializing runtime resources.
+     * Applies @ref DetectorConfig::infer and @ref DetectorConfig::verbose in place (thresholds,
+     * tiling, engine-specific parameters) after in-flight async frames complete. Task, engine,
+     * model path and @ref RuntimePolicy cannot change here; use @ref reload for those.
      *
      * @param config New configuration to apply.
      * @return @ref Status::Ok() on success, otherwise an error status.
      */
     Status update_config(const DetectorConfig& config) noexcept;
 
+    /**
+     * @brief Replaces the model and/or runtime policy without stopping detection.
+     *
+     * A second engine is created from @p config (new @ref DetectorConfig::model_path, session
+     * options, threading) and, if binding was prepared, bound with the same
+     * @ref prepare_binding / @ref prepare_binding_pool request, including shape probing. Other
+     * threads keep detecting on the current engine meanwhile. The swap then waits for calls in
+     * progress and submitted frames to finish on the old engine and takes effect atomically for
+     * every later call; only calls issued during the swap itself wait for it.
+     *
+     * Task and engine kind must match. Completed frames of the old engine that were not collected
+     * yet stay available to @ref wait (tickets keep increasing across the swap). Statistics,
+     * the @ref detect_stream cache, the @ref detect_track tracks and tile timings restart with the
+     * new engine. Settings that are process-wide once set (ORT global pools, worker pinning) keep
+     * their first values.
+     *
+     * Peak memory holds both models (and both bindings) until the old engine is released.
+     *
+     * @param config Configuration of the new engine.
+     * @return @ref Status::Ok() once the new engine is in use; on failure the detector is unchanged.
+     *
+     * @note May be called while other threads call detection methods. Must not run concurrently
+     *       with @ref prepare_binding (a binding prepared meanwhile makes the reload fail).
+     */
+    Status reload(const DetectorConfig& config) noexcept;
+
+    /**
+     * @brief Runs @ref reload on a background thread and returns immediately.
+     *
+     * Detection on the calling thread continues on the current engine until the swap. The
+     * destructor waits for a running reload.
+     *
+     * @param config Configuration of the new engine (copied).
+     * @return @ref Status::Ok() once the thread runs; @ref Status::Code::Unavailable while another
+     *         background reload is still running (retry later).
+     */
+    Status reload_async(const DetectorConfig& config) noexcept;
+
+    /**
+     * @brief Blocks until the reload started by @ref reload_async finishes.
+     * @return Outcome of the last background reload; InvalidArgument if none was ever started.
+     */
+    Status wait_reload() noexcept;
+
     /**
      * @brief Prepares bound I/O (and optionally per-context resources) for a fixed input size.
      *
@@ -479,19 +1392,74 @@ class IDET_API Detector final {
      * @param width Input width in pixels.
      * @param height Input height in pixels.
      * @param contexts Number of independent contexts to prepare (e.g., per-thread contexts).
+     * @param max_batch Maximum number of images per bound run used by @ref detect_batch.
+     *        Values > 1 bind an `[N,3,H,W]` input per context and require a model exported
+     *        with a dynamic batch dimension.
      * @return @ref Status::Ok() on success, otherwise an error status.
      *
      * @note
      * The meaning of "contexts" is implementation-defined. Commonly it represents the number of
      * independent inference contexts/bindings that can be used via @ref detect_bound.
      */
-    Status prepare_binding(int width, int height, int contexts) noexcept;
+    Status prepare_binding(int width, int height, int contexts, int max_batch = 1) noexcept;
+
+    /**
+     * @brief Prepares bound I/O for several input shapes at once (multi-resolution binding pool).
+     *
+     * Each representative frame size is mapped to the input shape the engine would use for it
+     * (aspect kept, longest side capped by @ref InferenceOptions::max_img_size, aligned to 32);
+     * identical shapes are bound once. Afterwards every bound call routes the frame to the shape
+     * that preserves the most pixels and letterboxes it there, so no rebinding happens at runtime.
+     *
+     * @param sizes Representative frame sizes (rows x cols), e.g. @ref InferenceOptions::bind_buckets.
+     * @param count Number of entries in @p sizes (>= 1).
+     * @param contexts Number of independent contexts, valid for every shape of the pool.
+     * @param max_batch Maximum number of images per bound run (see @ref prepare_binding).
+     * @return @ref Status::Ok() on success, otherwise an error status.
+     *
+     * @note Memory grows with `shapes * contexts * max_batch`.
+     */
+    Status prepare_binding_pool(const GridSpec* sizes, std::size_t count, int contexts, int max_batch = 1) noexcept;
+
+    /**
+     * @brief Warms the detector up ahead of traffic so the first real frames run at steady-state speed.
+     *
+     * Runs black frames of every shape through every bound context (in parallel): each context's
+     * input and output buffers are touched, both its single-image and its batched binding run, and
+     * the ORT arena grows to what concurrent calls need. Without a binding the frames take the
+     * regular unbound path. Statistics (@ref stats) are reset afterwards.
+     *
+     * @param shapes Frame sizes (rows x cols) to warm up; may be null when @p count is 0, which
+     *        selects every shape of the prepared binding (see @ref prepare_binding_pool).
+     * @param count Number of entries in @p shapes.
+     * @param iterations Runs per shape and context (0 does nothing).
+     * @return @ref Status::Ok() on success, otherwise an error status (e.g.
+     *         @ref Status::Code::InvalidArgument when no shapes are given and no binding is prepared).
+     *
+     * @note Takes the detector exclusively (it uses every context; detection calls wait for it).
+     *       Call it after @ref prepare_binding and before serving.
+     */
+    Status warmup(const GridSpec* shapes, std::size_t count, int iterations = 1) noexcept;
+
+    /**
+     * @brief Convenience overload of @ref warmup for a vector of frame sizes.
+     * @param shapes Frame sizes (empty: the shapes of the prepared binding).
+     * @param iterations Runs per shape and context.
+     * @return @ref Status::Ok() on success, otherwise an error status.
+     */
+    Status warmup(const std::vector<GridSpec>& shapes, int iterations = 1) noexcept {
+        return warmup(shapes.data(), shapes.size(), iterations);
+    }
 
     /**
      * @brief Runs detection on the provided image using an unbound (or internally managed) context.
      *
+     * With a prepared binding the call checks out a free bound context for its duration, so
+     * concurrent callers never share one (see @ref InferenceOptions::context_overflow).
+     *
      * @param image Input image. Must be a valid @ref idet::Image view.
-     * @return Result containing detected quadrilaterals on success, or an error status on failure.
+     * @return Result containing detected quadrilaterals on success, or an error status on failure
+     *         (@ref Status::Code::Unavailable when no context became free under @ref ContextOverflow::Fail).
      *
      * @note
      * Depending on the runtime configuration, this call may allocate temporary buffers.
@@ -510,6 +1478,213 @@ class IDET_API Detector final {
      */
     Result<VecQuad> detect_bound(const Image& image, int ctx_idx) noexcept;
 
+    /**
+     * @brief Runs detection like @ref detect and writes structured results into @p out.
+     *
+     * @p out is cleared first and then filled; its capacity is reused, so calling this
+     * repeatedly with the same vector avoids per-call result allocations.
+     *
+     * @param image Input image. Must be a valid @ref idet::Image view.
+     * @param out Caller-owned result buffer (left empty on failure).
+     * @return Status::Ok() on success, otherwise an error status.
+     */
+    Status detect_ex(const Image& image, VecDetection& out) noexcept;
+
+    /**
+     * @brief Bound variant of @ref detect_ex using context @p ctx_idx.
+     *
+     * With tiling disabled, the whole frame path (color conversion, decoding, NMS, results)
+     * reuses per-context buffers: after the first frames of a given size, repeated calls with the
+     * same @p out perform no heap allocations in IDet code.
+     *
+     * @param image Input image. Must be compatible with the prepared binding dimensions.
+     * @param ctx_idx Context index in range `[0, contexts)` as configured by @ref prepare_binding.
+     * @param out Caller-owned result buffer (left empty on failure).
+     * @return Status::Ok() on success, otherwise an error status.
+     */
+    Status detect_bound_ex(const Image& image, int ctx_idx, VecDetection& out) noexcept;
+
+    /**
+     * @brief Streaming variant of @ref detect_ex that only re-infers tiles whose content changed.
+     *
+     * The frame is split into the @ref InferenceOptions::tiles_dim grid (a 1x1 grid treats the whole
+     * frame as one tile). A tile is inferred again when it changed beyond
+     * @ref InferenceOptions::stream since its last inference, measured against the pixels kept
+     * from that inference or, if @p motion_mask is given, read from the mask. Unchanged tiles reuse
+     * their cached detections; global NMS then runs over the union as in @ref detect_ex.
+     *
+     * The first frame, a change of frame size or tile layout, and @ref reset_stream re-infer every
+     * tile. @ref last_tile_timings marks reused tiles with @c TileTiming::reused.
+     *
+     * @param frame Next frame of the stream.
+     * @param out Caller-owned result buffer (left empty on failure).
+     * @param motion_mask Optional frame-sized 8-bit mask (non-zero = moving), e.g. from a hardware
+     *                    encoder or background subtractor; null compares pixels instead.
+     * @return Status::Ok() on success, otherwise an error status.
+     */
+    Status detect_stream(const Image& frame, VecDetection& out, const MotionMask* motion_mask = nullptr) noexcept;
+
+    /** @brief Drops the tile cache of @ref detect_stream; the next frame re-infers every tile. */
+    void reset_stream() noexcept;
+
+    /**
+     * @brief Tracking-assisted streaming variant of @ref detect_ex (see @ref TrackOptions).
+     *
+     * Keyframes run the regular detection; the frames in between only verify the tracked objects
+     * in crops around their constant-velocity predictions, so their cost follows the number of
+     * tracked objects instead of the frame size. New objects appearing away from the tracks are
+     * found at the next keyframe. Every result carries its @c DetectionResult::track_id, stable
+     * across frames while the object is tracked.
+     *
+     * The first frame and @ref reset_track start with a keyframe. Calls take turns like
+     * @ref detect_stream (the tracks describe one stream).
+     *
+     * @param frame Next frame of the stream.
+     * @param out Caller-owned result buffer (left empty on failure).
+     * @return Status::Ok() on success, otherwise an error status.
+     */
+    Status detect_track(const Image& frame, VecDetection& out) noexcept;
+
+    /** @brief Drops the tracks of @ref detect_track; the next frame is a keyframe. */
+    void reset_track() noexcept;
+
+    /**
+     * @brief Runs detection on several images, batching them into as few model runs as possible.
+     *
+     * With a prepared binding (see @ref prepare_binding, `max_batch > 1`) and tiling disabled,
+     * the call checks one free bound context out of the pool for the whole batch, like
+     * @ref detect_ex; images are resized into the bound shape and processed in chunks of
+     * `max_batch`, one model run per chunk. Otherwise each image is processed as by @ref detect.
+     *
+     * When every context is in use, @ref InferenceOptions::context_overflow applies: the call
+     * waits for one, or after @ref InferenceOptions::context_wait_ms processes each image as by
+     * @ref detect (@ref ContextOverflow::Unbound) or returns @ref Status::Code::Unavailable
+     * (@ref ContextOverflow::Fail).
+     *
+     * @param images Pointer to @p count input images (may be null when @p count is 0).
+     * @param count Number of images.
+     * @return Result containing per-image detections in input order, or an error status.
+     */
+    Result<std::vector<VecQuad>> detect_batch(const Image* images, std::size_t count) noexcept;
+
+    /**
+     * @brief Convenience overload of @ref detect_batch for a vector of images.
+     * @param images Input images.
+     * @return Result containing per-image detections in input order, or an error status.
+     */
+    Result<std::vector<VecQuad>> detect_batch(const std::vector<Image>& images) noexcept {
+        return detect_batch(images.data(), images.size());
+    }
+
+    /**
+     * @brief Runs detection on many regions of one image, batching the crops into few model runs.
+     *
+     * Each region is clipped to the image (4:2:0 views widen it to even coordinates) and read in
+     * place, without copying or converting the frame. With a prepared binding, one context is
+     * checked out for the whole call and the crops are resized straight into the slots of its
+     * batched input, `max_batch` crops per model run (see @ref prepare_binding); otherwise each
+     * crop runs unbound. Tiling and the cascade pre-pass do not apply to the crops.
+     *
+     * Every crop is postprocessed (min-size filter, NMS) on its own. Results are in full-image
+     * coordinates, with @c DetectionResult::tile set to the index of the region.
+     *
+     * @param image Input image. Must be a valid @ref idet::Image view.
+     * @param rois Pointer to @p count regions (may be null when @p count is 0).
+     * @param count Number of regions.
+     * @param out Receives one list per region in input order (empty for regions outside the
+     *            image); left empty on failure.
+     * @return Status::Ok() on success, otherwise an error status.
+     */
+    Status detect_rois(const Image& image, const Rect* rois, std::size_t count,
+                       std::vector<VecDetection>& out) noexcept;
+
+    /**
+     * @brief Convenience overload of @ref detect_rois for a vector of regions.
+     * @param image Input image.
+     * @param rois Regions of @p image.
+     * @param out Receives one list per region in input order.
+     * @return Status::Ok() on success, otherwise an error status.
+     */
+    Status detect_rois(const Image& image, const std::vector<Rect>& rois, std::vector<VecDetection>& out) noexcept {
+        return detect_rois(image, rois.data(), rois.size(), out);
+    }
+
+    /**
+     * @brief Submits an image for asynchronous detection and returns immediately.
+     *
+     * Frames flow through a three-stage pipeline (preprocess -> model run -> postprocess/NMS)
+     * running on internal worker threads. With a prepared binding (@ref prepare_binding) and
+     * tiling disabled, every in-flight frame uses its own binding context, so preprocessing of
+     * frame N+1 overlaps inference of frame N. With tiling enabled, the tiles of every submitted
+     * frame are queued to `tile_omp_threads` workers that pick them up dynamically, so tiles of
+     * consecutive frames interleave (bound contexts are checked out per tile). Otherwise frames
+     * are processed one at a time as by @ref detect, still off the caller's thread.
+     *
+     * The number of in-flight frames is bounded (by `contexts` in the bound case); this call
+     * blocks while the pipeline is full.
+     *
+     * @param image Input image. A non-owning @ref Image::view must stay valid until @ref poll
+     *        reports the ticket as complete; owning images are retained internally.
+     * @return Ticket to pass to @ref poll / @ref wait, or an error status.
+     *
+     * @warning
+     * While frames are in flight the pipeline owns all binding contexts: do not call
+     * @ref detect_bound / @ref detect_batch concurrently, and @ref prepare_binding fails.
+     */
+    Result<Ticket> submit(const Image& image) noexcept;
+
+    /**
+     * @brief Returns true if the frame identified by @p ticket has completed (wait won't block).
+     * @param ticket Ticket returned by @ref submit.
+     */
+    bool poll(Ticket ticket) const noexcept;
+
+    /**
+     * @brief Blocks until the frame identified by @p ticket completes and returns its result.
+     *
+     * @param ticket Ticket returned by @ref submit. It is consumed by this call.
+     * @return Detections of that frame, its error status, or InvalidArgument for unknown tickets.
+     */
+    Result<VecQuad> wait(Ticket ticket) noexcept;
+
+    /**
+     * @brief Returns per-tile timings of the most recent tiled frame.
+     *
+     * Updated by tiled @ref detect / @ref detect_ex calls and by @ref wait for tiled frames.
+     * Entries are indexed by tile; comparing their @c ms values shows how unevenly tiles load the
+     * workers. Empty until a tiled frame has been processed.
+     *
+     * @param out Receives the timings (cleared on failure).
+     * @return Status::Ok() on success, otherwise an error status.
+     */
+    Status last_tile_timings(std::vector<TileTiming>& out) const noexcept;
+
+    /**
+     * @brief Returns per-stage latency histograms and work counters (see @ref DetectorStats).
+     *
+     * Recording costs two clock reads and a few relaxed atomic increments per stage. It is
+     * compiled in by the @c idet_stats build option; without it this call returns Unsupported.
+     * May be called while other threads detect (the snapshot is then not a single point in time).
+     *
+     * @param out Receives the snapshot (reset to zeros on failure).
+     * @return Status::Ok() on success, Unsupported when statistics are compiled out.
+     */
+    Status stats(DetectorStats& out) const noexcept;
+
+    /**
+     * @brief Stops ORT profiling (if still active) and returns the path of the written trace.
+     *
+     * Requires @ref RuntimePolicy::profile_prefix. Once the trace has been written (by this call
+     * or after @ref RuntimePolicy::profile_runs runs) later calls return the same path. Must not
+     * run concurrently with detection.
+     *
+     * @return Trace file path, or Invalid when profiling was not enabled.
+     */
+    Result<std::string> end_profiling() noexcept;
+
+    /** @brief Zeroes all statistics (no-op when statistics are compiled out). */
+    void reset_stats() noexcept;
+
   private:
     /**
      * @brief Opaque pointer to the implementation object (engine backend).
@@ -539,12 +1714,216 @@ class IDET_API Detector final {
     return Detector::create(config);
 }
 
+namespace detail {
+/** @brief Internal detector group implementation (not part of the public API). */
+struct DetectorGroupImpl;
+} // namespace detail
+
+/**
+ * @brief NUMA-sharded set of independent detector replicas with least-loaded routing.
+ *
+ * On multi-socket machines a single detector keeps its weights, bound buffers and ORT thread
+ * pool on one node while requests arrive from all of them, so most runs pay remote-memory
+ * latency and cross-node bandwidth. A group instead owns one @ref Detector per NUMA node (or
+ * @p replicas spread round-robin over the nodes). Each replica lives on a worker thread pinned
+ * to its node's CPUs; the replica is created, bound and run only from that thread, so:
+ * - the ORT intra-op pool is spawned from a pinned thread and inherits the node's CPU mask,
+ * - model weights, bound I/O buffers and scratch are first-touched (hence allocated) locally,
+ * - with @ref RuntimePolicy::soft_mem_bind the node-local memory policy is applied as well.
+ *
+ * Every request goes to the replica with the fewest queued/running requests.
+ *
+ * Configuration notes:
+ * - @ref RuntimePolicy::share_session, @ref RuntimePolicy::ort_global_pools and
+ *   @ref RuntimePolicy::pin_worker_threads are ignored (replicas must not share a session or
+ *   thread pools; each replica runs tiles on its own worker pool started on the node).
+ * - @ref RuntimePolicy::ort_intra_threads <= 0 means "all CPUs of the replica's share of the node".
+ * - Do not combine with @ref setup_runtime_policy pinning the whole process to one socket.
+ *
+ * @thread_safety
+ * @ref detect and @ref detect_ex may be called concurrently from any number of threads.
+ * Other methods must not run concurrently with each other or with detection.
+ */
+class IDET_API DetectorGroup final {
+  public:
+    /** @brief Constructs an empty (invalid) group. */
+    DetectorGroup() noexcept = default;
+
+    /** @brief Stops the replica workers and destroys all replicas. */
+    ~DetectorGroup() noexcept;
+
+    /** @brief Move-constructs a group (moved-from becomes empty/invalid). */
+    DetectorGroup(DetectorGroup&& other) noexcept;
+
+    /** @brief Move-assigns a group, releasing current replicas first. */
+    DetectorGroup& operator=(DetectorGroup&& other) noexcept;
+
+    DetectorGroup(const DetectorGroup&) = delete;
+    DetectorGroup& operator=(const DetectorGroup&) = delete;
+
+    /** @brief Returns true if the group holds at least one replica. */
+    explicit operator bool() const noexcept;
+
+    /** @brief Releases all replicas; the group becomes empty/invalid. */
+    void reset() noexcept;
+
+    /**
+     * @brief Creates the replicas, each on a worker thread bound to its NUMA node.
+     *
+     * @param config Detector configuration shared by all replicas (see class notes).
+     * @param replicas Number of replicas; 0 creates one per NUMA node with available CPUs.
+     *        Larger values are assigned to nodes round-robin.
+     * @return Result containing the group, or the first replica creation/placement error.
+     */
+    static Result<DetectorGroup> create(const DetectorConfig& config, int replicas = 0) noexcept;
+
+    /** @brief Number of replicas (0 for an empty group). */
+    std::size_t size() const noexcept;
+
+    /**
+     * @brief NUMA node id a replica is bound to.
+     * @param index Replica index in `[0, size())`.
+     * @return Node id, or -1 for an out-of-range index or when NUMA information is unavailable.
+     */
+    int replica_node(std::size_t index) const noexcept;
+
+    /**
+     * @brief Prepares a single-context binding on every replica (see @ref Detector::prepare_binding).
+     *
+     * Buffers are allocated from the replica threads and therefore reside on the replicas' nodes.
+     * With @ref DetectorConfig::verbose the placement of a freshly first-touched buffer is checked
+     * against the node on every replica and reported.
+     *
+     * @param width Input width in pixels.
+     * @param height Input height in pixels.
+     * @return @ref Status::Ok() if every replica bound successfully, otherwise the first error.
+     */
+    Status prepare_binding(int width, int height) noexcept;
+
+    /**
+     * @brief Routes one detection to the least-loaded replica (see @ref Detector::detect).
+     * @param image Input image; must stay valid until the call returns.
+     */
+    Result<VecQuad> detect(const Image& image) noexcept;
+
+    /**
+     * @brief Routes one structured detection to the least-loaded replica (see @ref Detector::detect_ex).
+     * @param image Input image; must stay valid until the call returns.
+     * @param out Caller-owned result buffer (left empty on failure).
+     */
+    Status detect_ex(const Image& image, VecDetection& out) noexcept;
+
+  private:
+    /** @brief Owned implementation (replica workers and detectors). */
+    detail::DetectorGroupImpl* impl_ = nullptr;
+};
+
+namespace detail {
+/** @brief Internal multi-model detector implementation (not part of the public API). */
+struct MultiDetectorImpl;
+} // namespace detail
+
+/**
+ * @brief Several models (e.g. a text and a face detector) run concurrently on one frame.
+ *
+ * Each member is a plain @ref Detector owned by a worker thread restricted to its own partition
+ * of the available CPUs, so the ORT sessions of the members run side by side instead of
+ * competing for one set of cores. A frame is prepared once for all members:
+ * - members that read the frame directly (untiled) get the caller's pixels as they are, each
+ *   engine resizing and normalizing straight from the source with its own mean/std,
+ * - if any member tiles and the frame is not BGR, it is converted to BGR once and that copy is
+ *   shared by every member.
+ *
+ * Partitioning: members with @ref RuntimePolicy::ort_intra_threads > 0 get that many CPUs, the
+ * remaining CPUs are split evenly among the others (whose intra-op pools are sized to their share).
+ * If the requests do not fit, all members get an even split; with fewer CPUs than members no
+ * partitioning takes place.
+ *
+ * Configuration notes: @ref RuntimePolicy::ort_global_pools and @ref RuntimePolicy::pin_worker_threads
+ * are ignored (members keep their own pools inside their partitions).
+ *
+ * @thread_safety
+ * @ref detect and @ref detect_ex may be called concurrently; calls are queued per member.
+ * Other methods must not run concurrently with each other or with detection.
+ */
+class IDET_API MultiDetector final {
+  public:
+    /** @brief Constructs an empty (invalid) multi-detector. */
+    MultiDetector() noexcept = default;
+
+    /** @brief Stops the member workers and destroys all members. */
+    ~MultiDetector() noexcept;
+
+    /** @brief Move-constructs (moved-from becomes empty/invalid). */
+    MultiDetector(MultiDetector&& other) noexcept;
+
+    /** @brief Move-assigns, releasing current members first. */
+    MultiDetector& operator=(MultiDetector&& other) noexcept;
+
+    MultiDetector(const MultiDetector&) = delete;
+    MultiDetector& operator=(const MultiDetector&) = delete;
+
+    /** @brief Returns true if at least one member exists. */
+    explicit operator bool() const noexcept;
+
+    /** @brief Releases all members; the multi-detector becomes empty/invalid. */
+    void reset() noexcept;
+
+    /**
+     * @brief Creates one member per configuration, each on a worker bound to its CPU partition.
+     *
+     * @param configs Member configurations, in result order (at least one).
+     * @return Result containing the multi-detector, or the first member creation error.
+     */
+    static Result<MultiDetector> create(const std::vector<DetectorConfig>& configs) noexcept;
+
+    /** @brief Number of members (0 for an empty multi-detector). */
+    std::size_t size() const noexcept;
+
+    /**
+     * @brief CPUs of a member's partition.
+     * @param index Member index in `[0, size())`.
+     * @return CPU ids; empty for an out-of-range index or when the member is not partitioned.
+     */
+    const std::vector<int>& member_cpus(std::size_t index) const noexcept;
+
+    /**
+     * @brief Prepares the binding of one member from its worker (see @ref Detector::prepare_binding).
+     *
+     * @param index Member index in `[0, size())`.
+     * @param width Input width in pixels.
+     * @param height Input height in pixels.
+     * @param contexts Number of bound contexts.
+     * @param max_batch Maximum number of images per bound run.
+     */
+    Status prepare_binding(std::size_t index, int width, int height, int contexts = 1, int max_batch = 1) noexcept;
+
+    /**
+     * @brief Runs every member on @p image concurrently.
+     * @param image Input image; must stay valid until the call returns.
+     * @return One quad list per member, in member order, or the first member error.
+     */
+    Result<std::vector<VecQuad>> detect(const Image& image) noexcept;
+
+    /**
+     * @brief Structured variant of @ref detect.
+     * @param image Input image; must stay valid until the call returns.
+     * @param out One result buffer per member, in member order (all empty on failure).
+     */
+    Status detect_ex(const Image& image, std::vector<VecDetection>& out) noexcept;
+
+  private:
+    /** @brief Owned implementation (member workers and detectors). */
+    detail::MultiDetectorImpl* impl_ = nullptr;
+};
+
 /**
  * @brief Applies the runtime policy to the current process/runtime environment.
  *
  * This function configures runtime-related global and per-runtime settings such as:
  * - ONNX Runtime thread counts (intra-op/inter-op),
- * - OpenMP affinity and binding (places/proc_bind) when applicable,
+ * - OpenMP affinity and binding (places/proc_bind) for the application's own OpenMP code,
+ * - the library worker pool (started inside the selected mask, optionally pinned),
  * - optional memory binding policies,
  * - optional suppression of OpenCV internal threading (if enabled).
  *
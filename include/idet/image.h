@@ -45,10 +45,11 @@ namespace idet {
 
 /**
  * @ingroup idet_image
- * @brief Supported packed pixel formats (interleaved channels, 8-bit per channel).
+ * @brief Supported pixel formats (8-bit per sample).
  *
- * All formats are assumed to be tightly interleaved per pixel (e.g., RGBRGB...).
- * Planar layouts are not represented by this enum.
+ * RGB/BGR/RGBA/BGRA are packed formats, interleaved per pixel (e.g., RGBRGB...).
+ * NV12/NV21/I420 are 4:2:0 YUV formats (BT.601 limited range): a full-resolution luma plane
+ * plus chroma planes at half width and half height (see @ref ImageView::chroma).
  *
  * The underlying storage type is @c std::uint8_t for compactness and ABI stability.
  */
@@ -61,14 +62,29 @@ enum class PixelFormat : std::uint8_t {
     RGBA_U8 = 2,
     /** Packed BGRA, 8-bit per channel, 4 channels per pixel. */
     BGRA_U8 = 3,
+    /** Semi-planar YUV 4:2:0: Y plane, then one interleaved U/V plane (U first). */
+    NV12_U8 = 4,
+    /** Semi-planar YUV 4:2:0: Y plane, then one interleaved V/U plane (V first). */
+    NV21_U8 = 5,
+    /** Planar YUV 4:2:0: Y plane, then a U plane, then a V plane. */
+    I420_U8 = 6,
 };
 
+/**
+ * @ingroup idet_image
+ * @brief Returns true for the 4:2:0 YUV formats (@ref PixelFormat::NV12_U8, NV21_U8, I420_U8).
+ */
+[[nodiscard]] constexpr bool is_yuv420(PixelFormat f) noexcept {
+    return f == PixelFormat::NV12_U8 || f == PixelFormat::NV21_U8 || f == PixelFormat::I420_U8;
+}
+
 /**
  * @ingroup idet_image
  * @brief Returns the number of interleaved channels for a given @ref PixelFormat.
  *
  * @param f Pixel format.
- * @return Number of channels (3 or 4). Returns 0 for unknown values.
+ * @return Number of channels (3 or 4). Returns 0 for unknown values and for the (non-interleaved)
+ *         YUV formats.
  *
  * @note
  * This function is @c constexpr and can be used in compile-time contexts.
@@ -88,19 +104,21 @@ enum class PixelFormat : std::uint8_t {
 
 /**
  * @ingroup idet_image
- * @brief A non-owning view over packed 8-bit image memory.
+ * @brief A non-owning view over 8-bit image memory (packed, or 4:2:0 YUV planes).
  *
  * @details
  * @ref ImageView does not manage memory. It only describes how to interpret a memory region:
- * - @ref data points to the first byte of the first row.
+ * - @ref data points to the first byte of the first row (the luma plane for YUV formats).
  * - @ref width / @ref height define image dimensions in pixels.
  * - @ref stride_bytes is the number of bytes between consecutive row starts.
  * - @ref format defines channel order and channel count.
+ * - @ref chroma / @ref chroma_stride_bytes locate the chroma planes of YUV formats.
  *
  * Validity rules (see @ref is_valid()):
  * - @ref data is not null
  * - @ref width > 0 and @ref height > 0
  * - @ref stride_bytes >= @ref min_row_bytes() for U8 formats
+ * - YUV formats: even @ref width and @ref height, chroma strides large enough for a chroma row
  *
  * @note
  * This view is read-only because @ref data is a pointer to const bytes. If a mutable view is
@@ -136,6 +154,24 @@ struct ImageView final {
     /** @brief Pixel format describing channel order and channel count. */
     PixelFormat format = PixelFormat::RGB_U8;
 
+    /**
+     * @brief Chroma plane pointers of YUV formats (ignored for packed formats).
+     *
+     * - NV12 / NV21: @c chroma[0] is the interleaved UV / VU plane; @c chroma[1] is unused.
+     * - I420: @c chroma[0] is the U plane, @c chroma[1] the V plane.
+     *
+     * A null entry means "contiguous single-buffer layout": the plane directly follows the
+     * previous one (luma is @c stride_bytes * height bytes long, I420 U is half that stride times
+     * half the height). Camera/driver buffers with separately allocated planes set these explicitly.
+     */
+    const std::uint8_t* chroma[2] = {nullptr, nullptr};
+
+    /**
+     * @brief Row strides of @ref chroma planes in bytes; 0 derives them from @ref stride_bytes
+     *        (NV12/NV21: same stride, I420: half of it).
+     */
+    std::size_t chroma_stride_bytes[2] = {0, 0};
+
     /**
      * @brief Checks whether the view is empty (no data or non-positive dimensions).
      * @return True if @ref data is null or @ref width <= 0 or @ref height <= 0.
@@ -152,14 +188,43 @@ struct ImageView final {
         return get_channels(format);
     }
 
+    /** @brief True for the 4:2:0 YUV formats. */
+    [[nodiscard]] constexpr bool is_yuv() const noexcept {
+        return is_yuv420(format);
+    }
+
+    /**
+     * @brief Resolved row stride of chroma plane @p i (0 or 1) of a YUV view.
+     * @return Explicit @ref chroma_stride_bytes, else the value derived from @ref stride_bytes.
+     */
+    [[nodiscard]] constexpr std::size_t chroma_stride(int i) const noexcept {
+        if (chroma_stride_bytes[i] != 0) return chroma_stride_bytes[i];
+        return format == PixelFormat::I420_U8 ? stride_bytes / 2 : stride_bytes;
+    }
+
+    /**
+     * @brief Resolved start of chroma plane @p i (0 or 1) of a YUV view.
+     * @return Explicit @ref chroma pointer, else its position in the contiguous single-buffer layout.
+     *         Null for packed formats and for plane 1 of NV12/NV21.
+     */
+    [[nodiscard]] constexpr const std::uint8_t* chroma_plane(int i) const noexcept {
+        if (!is_yuv() || !data || (i == 1 && format != PixelFormat::I420_U8)) return nullptr;
+        if (chroma[i]) return chroma[i];
+        const std::uint8_t* first = chroma[0] ? chroma[0] : data + stride_bytes * static_cast<std::size_t>(height);
+        if (i == 0) return first;
+        return first + chroma_stride(0) * static_cast<std::size_t>(height / 2);
+    }
+
     /**
      * @brief Returns the minimum number of bytes required to store one row.
      *
-     * Computed as `width * channels` for currently supported 8-bit packed formats.
+     * Computed as `width * channels` for 8-bit packed formats and as `width` (one luma row) for
+     * YUV formats.
      *
      * @return Minimum bytes per row, or 0 if width/channels are invalid.
      */
     [[nodiscard]] constexpr std::size_t min_row_bytes() const noexcept {
+        if (is_yuv()) return width > 0 ? static_cast<std::size_t>(width) : 0;
         const int ch = channels();
         if (ch <= 0 || width <= 0) return 0;
         return static_cast<std::size_t>(width) * static_cast<std::size_t>(ch);
@@ -172,7 +237,12 @@ struct ImageView final {
     [[nodiscard]] constexpr bool is_valid() const noexcept {
         if (empty()) return false;
         const std::size_t min_row = min_row_bytes();
-        return (min_row > 0) && (stride_bytes >= min_row);
+        if (min_row == 0 || stride_bytes < min_row) return false;
+        if (!is_yuv()) return true;
+
+        if ((width & 1) != 0 || (height & 1) != 0) return false;
+        if (format == PixelFormat::I420_U8) return chroma_stride(0) >= min_row / 2 && chroma_stride(1) >= min_row / 2;
+        return chroma_stride(0) >= min_row;
     }
 
     /**
@@ -384,6 +454,60 @@ class Image final {
 [[nodiscard]] IDET_API idet::Result<Image> load_image(const std::string& path, PixelFormat output_format,
                                                       bool flip_y = false) noexcept;
 
+/**
+ * @ingroup idet_image
+ * @brief Options of the decode-time downscaling @ref load_image overload.
+ */
+struct LoadOptions final {
+    /** @brief Desired output pixel format (packed 3- or 4-channel). */
+    PixelFormat output_format = PixelFormat::BGR_U8;
+
+    /** @brief If true, the output image is flipped vertically (top-bottom). */
+    bool flip_y = false;
+
+    /**
+     * @brief Longest side the consumer needs, e.g. @ref idet::InferenceOptions::max_img_size (0: full size).
+     *
+     * The decoder picks the strongest reduction of 1/2, 1/4 or 1/8 that keeps the longest side at
+     * or above this value. JPEG files are then decoded directly at that scale (DCT scaling), so
+     * the full-resolution pixels are never materialized.
+     */
+    int target_max_side = 0;
+};
+
+/**
+ * @ingroup idet_image
+ * @brief Image decoded by @ref load_image(const std::string&, const LoadOptions&) and its source geometry.
+ */
+struct LoadedImage final {
+    Image image;           ///< Decoded (possibly reduced) image
+    int source_width = 0;  ///< Width of the encoded image in pixels
+    int source_height = 0; ///< Height of the encoded image in pixels
+    float scale_x = 1.f;   ///< `image.width / source_width`; divide x coordinates by it to map back
+    float scale_y = 1.f;   ///< `image.height / source_height`; divide y coordinates by it to map back
+};
+
+/**
+ * @ingroup idet_image
+ * @brief Loads an image from disk, decoding it at a reduced scale picked from @p options.
+ *
+ * Without a useful reduction (target 0, or the image is not larger than twice the target), this
+ * is @ref load_image(const std::string&, PixelFormat, bool). Otherwise the image is decoded
+ * straight into BGR at 1/2, 1/4 or 1/8 scale and converted to the requested format in one pass
+ * over the reduced pixels. Detections on the result map back to source coordinates with
+ * @ref LoadedImage::scale_x / @ref LoadedImage::scale_y.
+ *
+ * @param path Filesystem path to the image.
+ * @param options Output format, flip and target size.
+ * @return Result with the decoded image and its scale on success, or an error status on failure.
+ *
+ * @note
+ * Reduced decoding ignores EXIF orientation (like the full-size path) and drops an alpha
+ * channel: 4-channel outputs get an opaque alpha.
+ */
+[[nodiscard]] IDET_API idet::Result<LoadedImage> load_image(const std::string& path,
+                                                            const LoadOptions& options) noexcept;
+
 /**
  * @ingroup idet_image
  * @brief Loads an image from disk and throws on failure.
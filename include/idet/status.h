@@ -102,6 +102,8 @@ struct Status final {
         Internal = 5,
         /** Memory allocation failed or requested memory cannot be obtained. */
         OutOfMemory = 6,
+        /** A shared resource is temporarily exhausted (e.g., every bound context busy); retrying may succeed. */
+        Unavailable = 7,
     };
 
     /** @brief Machine-readable status code. */
@@ -177,6 +179,15 @@ struct Status final {
         return {Code::OutOfMemory, std::move(msg)};
     }
 
+    /**
+     * @brief Constructs a resource-unavailable status.
+     * @param msg Error details (will be moved).
+     * @return Status with @ref Code::Unavailable.
+     */
+    static Status Unavailable(std::string msg) {
+        return {Code::Unavailable, std::move(msg)};
+    }
+
     /**
      * @brief Checks whether the status represents success.
      * @return True if @ref code is @ref Code::Ok, otherwise false.
@@ -4,6 +4,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #if defined(YUVV_BUILD_STATIC)
     #define YUVV_API
@@ -46,6 +47,7 @@ struct ViewerConfig {
     int64_t max_frames = -1;
     std::string window_name = "YUV Viewer";
     bool overlay_info = true;
+    bool headless = false; // no window: decode frames once and feed the post-preview callback only
 };
 
 struct BgrFrameView {
@@ -58,6 +60,72 @@ struct BgrFrameView {
 
 using PostPreviewCallback = std::function<void(const BgrFrameView& frame, int64_t frame_idx)>;
 
+// One image plane inside a raw frame
+struct YuvPlaneView {
+    int w = 0; // width in samples (pairs of bytes for interleaved UV / packed 4:2:2)
+    int h = 0;
+    int stride_bytes = 0;
+    const uint8_t* data = nullptr;
+};
+
+// Zero-copy view of one raw frame:
+//  - I420:        planes = {Y, U, V}
+//  - NV12 / NV21: planes = {Y, interleaved UV / VU}
+//  - YUY2 / UYVY: planes = {packed 2 bytes per pixel}
+struct YuvFrameView {
+    int w = 0;
+    int h = 0;
+    YuvFormat fmt = YuvFormat::I420;
+    int64_t index = -1;
+    int plane_count = 0;
+    YuvPlaneView planes[3] = {};
+};
+
+struct ReaderConfig {
+    std::string file;
+    int w = 0;
+    int h = 0;
+    YuvFormat fmt = YuvFormat::I420;
+    int readahead_frames = 4; // frames after the current one hinted to the kernel (0 = only sequential hint)
+    bool use_mmap = true;     // false reads frames through an ifstream (the only path without mmap)
+};
+
+// Headless random-access frame source over a raw YUV file.
+//
+// On POSIX the file is memory-mapped read-only with sequential readahead, so frame() neither
+// copies nor issues a syscall per frame; returned views point into the mapping and stay valid
+// for the lifetime of the reader. Elsewhere (or with use_mmap off) frames are read into an
+// internal buffer and a view stays valid only until the next call.
+//
+// Typical use as a detector source: frame_bgr() into a reused buffer, then wrap the result
+// into an idet::ImageView with PixelFormat::BGR_U8 (see idet::Image::view).
+class YUVV_API YuvReader final {
+  public:
+    // Throws std::runtime_error if the file cannot be opened/mapped or holds no complete frame
+    explicit YuvReader(ReaderConfig cfg);
+    ~YuvReader();
+
+    YuvReader(YuvReader&&) noexcept;
+    YuvReader& operator=(YuvReader&&) noexcept;
+
+    YuvReader(const YuvReader&) = delete;
+    YuvReader& operator=(const YuvReader&) = delete;
+
+    int64_t total_frames() const;
+    size_t frame_bytes() const;
+    const ReaderConfig& config() const;
+
+    // Plane views of frame @p frame_idx; throws std::out_of_range for indices outside [0, total_frames)
+    YuvFrameView frame(int64_t frame_idx);
+
+    // Converts frame @p frame_idx to packed BGR in @p storage (resized as needed, reuse it across calls)
+    BgrFrameView frame_bgr(int64_t frame_idx, std::vector<uint8_t>& storage);
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 class YUVV_API YuvViewer final {
   public:
     explicit YuvViewer(ViewerConfig cfg);
@@ -10,6 +10,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <idet.h>
+#include <iomanip>
 #include <numeric>
 #include <ostream>
 #include <type_traits>
@@ -195,12 +197,77 @@ inline BenchStat compute_bench_stat(std::vector<double> vec_ms) {
     return s;
 }
 
-inline void print_bench_stat(std::ostream& os, const BenchStat& s, bool verbose, bool use_color = true) {
+// Per-stage breakdown of idet::Detector::stats (one sample per stage call, i.e. per tile when tiled)
+inline void print_stage_stats(std::ostream& os, const idet::DetectorStats& st, bool verbose, bool use_color = true) {
+    const double frames = st.frames ? (double)st.frames : 1.0;
+    if (!verbose) {
+        // "key=value" fields, so the "key: value" metrics above stay unambiguous for parsers
+        for (int i = 0; i < idet::kStageCount; ++i) {
+            const idet::StageHistogram& h = st.stages[(std::size_t)i];
+            os << "stage_" << idet::stage_name((idet::Stage)i) << ": calls=" << h.count << " avg_ms=" << h.mean_ms()
+               << " p50_ms=" << h.quantile_ms(0.50) << " p99_ms=" << h.quantile_ms(0.99) << "\n";
+        }
+        os << "stage_counts: frames=" << st.frames << " tiles=" << st.tiles << " candidates=" << st.candidates
+           << " kept=" << st.kept << " bytes=" << st.bytes_allocated << " cascade_skipped=" << st.cascade_skipped
+           << " cascade_cropped=" << st.cascade_cropped << " quality_level=" << st.quality_level
+           << " quality_changes=" << st.quality_changes << "\n";
+        return;
+    }
+
+    printer::Printer p{os};
+    p.a.enable = use_color;
+    p.key_w = 16;
+
+    double total = 0.0;
+    for (const auto& h : st.stages)
+        total += h.total_ms;
+
+    p.section("Stage Breakdown");
+    os << "\n";
+
+    auto oldf = os.flags();
+    const auto oldp = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "    " << p.a.bold() << std::left << std::setw(12) << "stage" << std::right << std::setw(8) << "calls"
+       << std::setw(10) << "avg_ms" << std::setw(10) << "p50_ms" << std::setw(10) << "p99_ms" << std::setw(10)
+       << "max_ms" << std::setw(9) << "share" << p.a.reset() << "\n";
+    for (int i = 0; i < idet::kStageCount; ++i) {
+        const idet::StageHistogram& h = st.stages[(std::size_t)i];
+        const double share = total > 0.0 ? 100.0 * h.total_ms / total : 0.0;
+        os << "    " << std::left << std::setw(12) << idet::stage_name((idet::Stage)i) << std::right << std::setw(8)
+           << h.count << p.a.cyan() << std::setw(10) << h.mean_ms() << std::setw(10) << h.quantile_ms(0.50)
+           << std::setw(10) << h.quantile_ms(0.99) << std::setw(10) << h.max_ms << p.a.reset() << p.a.yellow()
+           << std::setw(8) << std::setprecision(1) << share << "%" << std::setprecision(3) << p.a.reset() << "\n";
+    }
+    os.flags(oldf);
+    os.precision(oldp);
+
+    os << "\n";
+
+    p.kv("frames", st.frames, 4, p.a.bold());
+    p.kv("tiles/frame", (double)st.tiles / frames, 4, p.a.bold());
+    p.kv("cand/frame", (double)st.candidates / frames, 4, p.a.bold());
+    p.kv("kept/frame", (double)st.kept / frames, 4, p.a.bold());
+    p.kv("bytes/frame", (double)st.bytes_allocated / frames, 4, p.a.bold());
+    if (st.cascade_skipped || st.cascade_cropped) {
+        p.kv("cascade_skipped", st.cascade_skipped, 4, p.a.bold());
+        p.kv("cascade_cropped", st.cascade_cropped, 4, p.a.bold());
+    }
+    if (st.quality_level || st.quality_changes) {
+        p.kv("quality_level", st.quality_level, 4, p.a.bold());
+        p.kv("quality_changes", st.quality_changes, 4, p.a.bold());
+    }
+}
+
+// `stages` (optional) adds the per-stage breakdown of the benchmarked detector
+inline void print_bench_stat(std::ostream& os, const BenchStat& s, bool verbose, bool use_color = true,
+                             const idet::DetectorStats* stages = nullptr) {
     if (!verbose) {
         os << "p50_ms: " << s.p50_ms << "\n";
         os << "p90_ms: " << s.p90_ms << "\n";
         os << "p95_ms: " << s.p95_ms << "\n";
         os << "p99_ms: " << s.p99_ms << "\n";
+        if (stages) print_stage_stats(os, *stages, /*verbose=*/false, use_color);
         return;
     }
     printer::Printer p{os};
@@ -229,6 +296,11 @@ inline void print_bench_stat(std::ostream& os, const BenchStat& s, bool verbose,
     p.kv("iters", s.n, 4, p.a.bold());
     p.kv("fps@p50", s.fps_p50, 4, p.a.bold());
 
+    if (stages) {
+        os << "\n";
+        print_stage_stats(os, *stages, /*verbose=*/true, use_color);
+    }
+
     os << "\n========================================================\n\n";
 }
 
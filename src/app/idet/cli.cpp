@@ -130,6 +130,237 @@ inline idet::Task string_to_task(std::string_view task_s) {
     return idet::Task::None;
 }
 
+inline bool string_to_score_mode(std::string_view s, idet::ScoreMode& m) {
+    if (s == "polygon") {
+        m = idet::ScoreMode::Polygon;
+    } else if (s == "scanline") {
+        m = idet::ScoreMode::Scanline;
+    } else if (s == "box" || s == "fast") {
+        m = idet::ScoreMode::Box;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string score_mode_to_string(idet::ScoreMode m) {
+    switch (m) {
+    case idet::ScoreMode::Polygon:
+        return "polygon";
+    case idet::ScoreMode::Scanline:
+        return "scanline";
+    case idet::ScoreMode::Box:
+        return "box";
+    default:
+        return "unknown";
+    }
+}
+
+inline bool string_to_map_pooling(std::string_view s, idet::MapPooling& m) {
+    if (s == "max") {
+        m = idet::MapPooling::Max;
+    } else if (s == "avg" || s == "average") {
+        m = idet::MapPooling::Average;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string map_pooling_to_string(idet::MapPooling m) {
+    return m == idet::MapPooling::Average ? "avg" : "max";
+}
+
+inline bool string_to_tile_merge(std::string_view s, idet::TileMerge& m) {
+    if (s == "nms") {
+        m = idet::TileMerge::Nms;
+    } else if (s == "seams") {
+        m = idet::TileMerge::Seams;
+    } else if (s == "join") {
+        m = idet::TileMerge::SeamsJoin;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string tile_merge_to_string(idet::TileMerge m) {
+    switch (m) {
+    case idet::TileMerge::Nms:
+        return "nms";
+    case idet::TileMerge::Seams:
+        return "seams";
+    case idet::TileMerge::SeamsJoin:
+        return "join";
+    default:
+        return "unknown";
+    }
+}
+
+inline bool string_to_nms_mode(std::string_view s, idet::NmsMode& m) {
+    if (s == "hard") {
+        m = idet::NmsMode::Hard;
+    } else if (s == "linear") {
+        m = idet::NmsMode::SoftLinear;
+    } else if (s == "gaussian") {
+        m = idet::NmsMode::SoftGaussian;
+    } else if (s == "weighted") {
+        m = idet::NmsMode::Weighted;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string nms_mode_to_string(idet::NmsMode m) {
+    switch (m) {
+    case idet::NmsMode::Hard:
+        return "hard";
+    case idet::NmsMode::SoftLinear:
+        return "linear";
+    case idet::NmsMode::SoftGaussian:
+        return "gaussian";
+    case idet::NmsMode::Weighted:
+        return "weighted";
+    default:
+        return "unknown";
+    }
+}
+
+inline bool string_to_ctx_overflow(std::string_view s, idet::ContextOverflow& m) {
+    if (s == "wait") {
+        m = idet::ContextOverflow::Wait;
+    } else if (s == "unbound") {
+        m = idet::ContextOverflow::Unbound;
+    } else if (s == "fail") {
+        m = idet::ContextOverflow::Fail;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string ctx_overflow_to_string(idet::ContextOverflow m) {
+    switch (m) {
+    case idet::ContextOverflow::Wait:
+        return "wait";
+    case idet::ContextOverflow::Unbound:
+        return "unbound";
+    case idet::ContextOverflow::Fail:
+        return "fail";
+    default:
+        return "unknown";
+    }
+}
+
+inline bool string_to_spin(std::string_view s, idet::SpinPolicy& m) {
+    if (s == "default") {
+        m = idet::SpinPolicy::Default;
+    } else if (s == "on" || s == "1") {
+        m = idet::SpinPolicy::Spin;
+    } else if (s == "off" || s == "0") {
+        m = idet::SpinPolicy::NoSpin;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string spin_to_string(idet::SpinPolicy m) {
+    switch (m) {
+    case idet::SpinPolicy::Default:
+        return "default";
+    case idet::SpinPolicy::Spin:
+        return "on";
+    case idet::SpinPolicy::NoSpin:
+        return "off";
+    default:
+        return "unknown";
+    }
+}
+
+inline bool string_to_arena(std::string_view s, idet::ArenaPolicy& m) {
+    if (s == "arena" || s == "on") {
+        m = idet::ArenaPolicy::Arena;
+    } else if (s == "shrink") {
+        m = idet::ArenaPolicy::ArenaShrink;
+    } else if (s == "off") {
+        m = idet::ArenaPolicy::Off;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string arena_to_string(idet::ArenaPolicy m) {
+    switch (m) {
+    case idet::ArenaPolicy::Arena:
+        return "arena";
+    case idet::ArenaPolicy::ArenaShrink:
+        return "shrink";
+    case idet::ArenaPolicy::Off:
+        return "off";
+    default:
+        return "unknown";
+    }
+}
+
+inline bool string_to_buffers(std::string_view s, idet::BufferPolicy& m) {
+    if (s == "heap") {
+        m = idet::BufferPolicy::Heap;
+    } else if (s == "aligned") {
+        m = idet::BufferPolicy::Aligned;
+    } else if (s == "huge") {
+        m = idet::BufferPolicy::HugePages;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string buffers_to_string(idet::BufferPolicy m) {
+    switch (m) {
+    case idet::BufferPolicy::Heap:
+        return "heap";
+    case idet::BufferPolicy::Aligned:
+        return "aligned";
+    case idet::BufferPolicy::HugePages:
+        return "huge";
+    default:
+        return "unknown";
+    }
+}
+
+inline bool string_to_provider(std::string_view s, idet::ExecutionProvider& m) {
+    if (s == "cpu") {
+        m = idet::ExecutionProvider::CPU;
+    } else if (s == "xnnpack") {
+        m = idet::ExecutionProvider::XNNPACK;
+    } else if (s == "dnnl" || s == "onednn") {
+        m = idet::ExecutionProvider::DNNL;
+    } else if (s == "coreml") {
+        m = idet::ExecutionProvider::CoreML;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline std::string provider_to_string(idet::ExecutionProvider m) {
+    switch (m) {
+    case idet::ExecutionProvider::CPU:
+        return "cpu";
+    case idet::ExecutionProvider::XNNPACK:
+        return "xnnpack";
+    case idet::ExecutionProvider::DNNL:
+        return "dnnl";
+    case idet::ExecutionProvider::CoreML:
+        return "coreml";
+    default:
+        return "unknown";
+    }
+}
+
 inline std::string task_to_string(idet::Task t) {
     switch (t) {
     case idet::Task::None:
@@ -151,11 +382,29 @@ inline std::string engine_to_string(idet::EngineKind e) {
         return "dbnet";
     case idet::EngineKind::SCRFD:
         return "scrfd";
+    case idet::EngineKind::Replay:
+        return "replay";
     default:
         return "unknown";
     }
 }
 
+inline bool parse_grid_list(std::string_view s_in, std::vector<idet::GridSpec>& out) {
+    out.clear();
+    const std::string s = lower_copy(trim_view(s_in));
+    if (s.empty() || s == "off" || s == "no" || s == "false" || s == "0") return true;
+
+    std::size_t pos = 0;
+    while (pos <= s.size()) {
+        const std::size_t comma = std::min(s.find(',', pos), s.size());
+        idet::GridSpec g{0, 0};
+        if (!parse_grid_int(std::string_view{s}.substr(pos, comma - pos), g) || g.rows <= 0) return false;
+        out.push_back(g);
+        pos = comma + 1;
+    }
+    return true;
+}
+
 inline std::string grid_to_string(const idet::GridSpec& g, bool treat_zeros_as_auto = false) {
     if (treat_zeros_as_auto && (g.rows == 0 || g.cols == 0)) return "auto";
     std::ostringstream oss;
@@ -163,6 +412,38 @@ inline std::string grid_to_string(const idet::GridSpec& g, bool treat_zeros_as_a
     return oss.str();
 }
 
+// "SIDE[@RxC],...": max_img_size (0 keeps it) and optional tile grid of every reduced quality level
+inline bool parse_quality_levels(std::string_view s_in, std::vector<idet::QualityLevel>& out) {
+    out.clear();
+    const std::string s = lower_copy(trim_view(s_in));
+    if (s.empty() || s == "auto") return true;
+
+    std::size_t pos = 0;
+    while (pos <= s.size()) {
+        const std::size_t comma = std::min(s.find(',', pos), s.size());
+        const std::string_view item = std::string_view{s}.substr(pos, comma - pos);
+        const std::size_t at = item.find('@');
+        idet::QualityLevel l;
+        if (!parse_int(trim_view(item.substr(0, at)), l.max_img_size) || l.max_img_size < 0) return false;
+        if (at != std::string_view::npos &&
+            (!parse_grid_int(item.substr(at + 1), l.tiles_dim) || l.tiles_dim.rows <= 0))
+            return false;
+        out.push_back(l);
+        pos = comma + 1;
+    }
+    return true;
+}
+
+inline std::string quality_levels_to_string(const std::vector<idet::QualityLevel>& levels) {
+    if (levels.empty()) return "auto";
+    std::string s;
+    for (const auto& l : levels) {
+        s += (s.empty() ? "" : ",") + std::to_string(l.max_img_size);
+        if (l.tiles_dim.rows > 0 && l.tiles_dim.cols > 0) s += "@" + grid_to_string(l.tiles_dim);
+    }
+    return s;
+}
+
 static void print_usage(const char* app) {
     std::cerr << "Usage:\n"
               << "  " << app << " --model <path.onnx> --mode [text|face] --image <path> [options]\n\n"
@@ -172,40 +453,104 @@ static void print_usage(const char* app) {
               << "  --image             STR      Input image path\n\n"
               << "Generic:\n"
               << "  --is_draw           0|1      Draw image detections. Default: 1\n"
+              << "  --fast_decode       0|1      Decode at 1/2, 1/4 or 1/8 scale when the engine downsizes anyway. "
+                 "Default: 0\n"
               << "  --is_dump           0|1      Write output image detections. Default: 1\n"
               << "  --output            STR      Output image path (when --is_draw=1). Default: result.png\n"
               << "  --verbose           0|1      Verbose logging. Default: 0\n\n"
               << "Inference:\n"
               << "  --bin_thresh         F       Binarization threshold. Default: 0.3\n"
               << "  --box_thresh         F       Box score threshold. Default: 0.5\n"
+              << "  --score_mode        STR      Contour scoring: polygon | scanline | box (fast). Default: polygon\n"
               << "  --unclip             F       Unclip ratio. Default: 1.0\n"
+              << "  --map_downsample     N       Pool the text map before postprocessing: 1 | 2 | 4. Default: 1\n"
+              << "  --map_pool          STR      Map pooling: max | avg. Default: max\n"
+              << "  --map_u8            0|1      Score contours on an 8-bit map. Default: 0\n"
               << "  --max_img_size       N       Max side length (no-tiling). Default: 960\n"
               << "  --min_roi_size_w     N       Minimal ROI width. Default: 5\n"
               << "  --min_roi_size_h     N       Minimal ROI height. Default: 5\n"
-              << "  --tiles_rc          RxC      Enable tiling grid, e.g. 2x2 / 3x4. Disable: off|no|0\n"
+              << "  --tiles_rc          RxC      Tiling grid, e.g. 2x2 / 3x4, or auto (input-sized tiles). Disable: off|no|0\n"
               << "  --tile_overlap       F       Tile overlap fraction. Default: 0.1\n"
+              << "  --tile_min_obj       N       Largest object (px) kept whole by auto tiles. Default: 0\n"
+              << "  --tile_merge        STR      Tile merge: nms | seams | join (seams + cut text). Default: nms\n"
+              << "  --tile_batch        0|1      Run the tiles of a bound frame as one batched call. Default: 0\n"
               << "  --nms_iou            F       NMS IoU threshold. Default: 0.3\n"
               << "  --use_fast_iou      0|1      Fast IoU option for NMS / overlap checks. Default: 0\n"
+              << "  --nms_mode          STR      NMS rule: hard | linear | gaussian | weighted. Default: hard\n"
+              << "  --nms_sigma          F       Gaussian Soft-NMS decay width. Default: 0.5\n"
               << "  --sigmoid           0|1      Apply sigmoid on output map. Default: 0\n"
               << "  --bind_io           0|1      Use ORT I/O binding. Default: 0\n"
-              << "  --fixed_hw          HxW      Fixed input size, e.g. 480x480. Disable: off|no|0\n\n"
+              << "  --fixed_hw          HxW      Fixed input size, e.g. 480x480. Disable: off|no|0\n"
+              << "  --bind_pool    HxW[,HxW..]   Frame sizes for a multi-shape binding pool, e.g. 720x1280,1280x720\n"
+              << "  --letterbox         0|1      Keep the aspect ratio and pad instead of stretching. Default: 0\n"
+              << "  --ctx_overflow      STR      All bound contexts busy: wait | unbound | fail. Default: wait\n"
+              << "  --ctx_wait_ms        N       Wait for a free context before unbound/fail apply. Default: 0\n"
+              << "  --cascade            N       Probe side (px) of a pre-pass that skips empty frames. Disable: 0\n"
+              << "  --cascade_trigger    F       Probe score that triggers the full pass. Default: 0.3\n"
+              << "  --cascade_roi        F       Largest triggered region (frame fraction) run alone. Default: 0.5\n"
+              << "  --quality_ms         F       Latency target (ms) of the adaptive quality control. Disable: 0\n"
+              << "  --quality_queue      N       Queue depth that also steps the quality down. Disable: 0\n"
+              << "  --quality_levels SIDE[@RxC]  Reduced levels, comma-separated, e.g. 720,480@1x1. Default: auto\n\n"
               << "Runtime:\n"
               << "  --threads_intra      N       Internal pull of ORT for graph operations (inside node). Default: 1\n"
               << "  --threads_inter      N       Prallelism between nodes of graph. Default: 1\n"
-              << "  --tile_omp           N       OpenMP threads for tiling. Default: 1\n"
+              << "  --tile_omp           N       Worker pool threads for tiling. Default: 1\n"
+              << "  --post_omp           N       Worker pool threads for postprocessing of one frame. Default: 1\n"
+              << "  --pin_workers       0|1      Pin the library worker pool threads one per CPU. Default: 0\n"
               << "  --runtime_policy    0|1      Setup runtime policy for session (mem/cpus binding + opencv "
                  "suppression). Default: 1\n"
               << "  --soft_mem_bind     0|1      Apply best-effort memory locality (when supported). Default: 1\n"
-              << "  --suppress_opencv   0|1      Globally limit the OpenCV number of threads to single. Default: 1\n\n"
+              << "  --suppress_opencv   0|1      Globally limit the OpenCV number of threads to single. Default: 1\n"
+              << "  --shape_cache       FILE     Persist probed model output shapes across runs. Default: off\n"
+              << "  --optimized_model   FILE     Save/reuse the ORT-optimized model (skips graph optimization). "
+                 "Default: off\n"
+              << "  --share_session     0|1      Share one ORT session between detectors of a model. Default: 0\n"
+              << "  --mmap_model        0|1      Load the model from a read-only mapping (.ort: used in place). "
+                 "Default: 0\n"
+              << "  --ort_spin          STR      Idle ORT threads: default | on (spin) | off (block). Default: "
+                 "default\n"
+              << "  --ort_parallel      0|1      Run independent graph branches concurrently. Default: 0\n"
+              << "  --ort_arena         STR      CPU allocations: arena | shrink (after each run) | off. Default: "
+                 "arena\n"
+              << "  --bound_alloc       STR      Bound I/O buffers: heap | aligned (64 B) | huge (2 MiB pages). "
+                 "Default: heap\n"
+              << "  --ort_denormal_zero 0|1      Flush denormals to zero in ORT threads. Default: 0\n"
+              << "  --ort_ep            STR      Execution provider: cpu | xnnpack | dnnl | coreml. Default: cpu\n"
+              << "  --ort_global_pools  0|1      One process-wide pinned ORT thread pool for all detectors. "
+                 "Default: 0\n"
+              << "  --capture           FILE     Record the decoder inputs of every frame for --replay. Default: off\n"
+              << "  --replay            FILE     Decode a capture instead of running the model (--model ignored). "
+                 "Default: off\n"
+              << "  --replay_latency_ms  F       Replay: synthetic model latency per frame. Default: 0\n"
+              << "  --replay_jitter_ms   F       Replay: uniform latency deviation per frame. Default: 0\n"
+              << "  --replay_spin       0|1      Replay: busy-wait the latency instead of sleeping. Default: 0\n\n"
               << "Benchmark:\n"
-              << "  --bench_iters        N       Benchmark iterations. Default: 100\n"
-              << "  --warmup_iters       N       Warmup iterations. Default: 20\n\n"
+              << "  --bench_iters        N       Benchmark iterations (per stream in throughput mode). Default: 100\n"
+              << "  --warmup_iters       N       Warmup iterations (per stream in throughput mode). Default: 20\n"
+              << "  --streams            N       Throughput mode: N concurrent callers (own bound context or own "
+                 "detector each). Default: off\n"
+              << "  --images            DIR      Throughput mode: directory of input images. Default: --image\n"
+              << "  --report            FILE     Throughput mode: write results as CSV, or JSON for *.json. "
+                 "Default: off\n"
+              << "  --ort_profile        N       Profile the first N ORT session runs and print the top operators. "
+                 "Default: off\n"
+              << "  --ort_profile_prefix PFX     File prefix of the ORT profiling trace. Default: idet_ort_profile\n"
+              << "  --ort_profile_top    K       Operators listed in the profile report. Default: 15\n\n"
+              << "Batch:\n"
+              << "  --input         DIR|FILE     Batch mode: directory of images or list file (one path per line)\n"
+              << "  --jsonl          FILE        Batch mode: JSON lines output, - for stdout. Default: -\n"
+              << "  --decoders           N       Batch mode: decoder threads. Default: 2\n"
+              << "  --prefetch           N       Batch mode: decoded images kept ahead of inference. "
+                 "Default: 2 * decoders\n\n"
               << "Examples:\n"
               << "  " << app << " --mode text --model det.onnx --image img.png --output out.png --is_draw 1\n"
               << "  " << app
               << " --mode text --model det.onnx --image img.png --tiles_rc 2x2 --tile_overlap 0.1 --tile_omp 4\n"
               << "  " << app
-              << " --mode face --model scrfd.onnx --image img.jpg --threads_intra 2 --threads_inter 1\n\n";
+              << " --mode face --model scrfd.onnx --image img.jpg --threads_intra 2 --threads_inter 1\n"
+              << "  " << app
+              << " --mode face --model scrfd.onnx --images frames/ --bind_io 1 --fixed_hw 640x640 --streams 4 "
+                 "--report tp.csv\n\n";
 }
 
 inline bool missing_value(const char* flag) {
@@ -243,34 +588,89 @@ void print_config(std::ostream& os, const AppConfig& ac, const idet::DetectorCon
     p.kv_bool("verbose", dc.verbose, 4);
     p.kv_bool("is_draw", ac.is_draw, 4);
     p.kv_bool("is_dump", ac.is_dump, 4);
+    p.kv_bool("fast_decode", ac.fast_decode, 4);
 
     os << "\n";
 
     p.section("Bench", 2);
     p.kv("warmup_iters", ac.warmup_iters, 4, p.a.cyan());
     p.kv("bench_iters", ac.bench_iters, 4, p.a.cyan());
+    if (ac.streams > 0) {
+        p.kv("streams", ac.streams, 4, p.a.cyan());
+        if (!ac.images_dir.empty()) p.kv_path("images_dir", ac.images_dir, 4);
+        if (!ac.report_path.empty()) p.kv_path("report", ac.report_path, 4);
+    }
+    if (!ac.input_list.empty()) {
+        p.kv_path("input", ac.input_list, 4);
+        p.kv_path("jsonl", ac.jsonl_path, 4);
+        p.kv("decoders", ac.decoders, 4, p.a.cyan());
+        p.kv("prefetch", ac.prefetch > 0 ? ac.prefetch : 2 * ac.decoders, 4, p.a.cyan());
+    }
+    if (!dc.runtime.profile_prefix.empty()) {
+        p.kv_path("ort_profile", dc.runtime.profile_prefix, 4);
+        p.kv(" - runs", dc.runtime.profile_runs, 4, p.a.cyan());
+        p.kv(" - top", ac.profile_top, 4, p.a.cyan());
+    }
 
     os << "\n";
 
     p.section("Inference", 2);
     p.kv("bin_thresh", dc.infer.bin_thresh, 4, p.a.cyan());
     p.kv("box_thresh", dc.infer.box_thresh, 4, p.a.cyan());
+    p.kv("score_mode", score_mode_to_string(dc.infer.score_mode), 4, p.a.yellow());
     p.kv("unclip", dc.infer.unclip, 4, p.a.cyan());
+    p.kv("map_downsample", dc.infer.map_downsample, 4, p.a.cyan());
+    p.kv("map_pool", map_pooling_to_string(dc.infer.map_pooling), 4, p.a.yellow());
+    p.kv_bool("map_u8", dc.infer.map_u8, 4);
 
     p.kv("max_img_size", dc.infer.max_img_size, 4, p.a.cyan());
     p.kv("min_roi_size_w", dc.infer.min_roi_size_w, 4, p.a.cyan());
     p.kv("min_roi_size_h", dc.infer.min_roi_size_h, 4, p.a.cyan());
 
     p.kv("fixed_input_dim", grid_to_string(dc.infer.fixed_input_dim, /*treat_zeros_as_auto=*/true), 4, p.a.cyan());
+    if (!dc.infer.bind_buckets.empty()) {
+        std::string buckets;
+        for (const auto& g : dc.infer.bind_buckets)
+            buckets += (buckets.empty() ? "" : ",") + grid_to_string(g);
+        p.kv("bind_buckets", buckets, 4, p.a.cyan());
+    }
+    p.kv_bool("letterbox", dc.infer.letterbox, 4);
 
     const bool tiling_off = (dc.infer.tiles_dim.rows <= 1 && dc.infer.tiles_dim.cols <= 1);
-    p.kv("tiles_dim", tiling_off ? std::string("off") : grid_to_string(dc.infer.tiles_dim), 4, p.a.cyan());
+    if (dc.infer.tile_mode == idet::TileMode::Adaptive)
+        p.kv("tiles_dim", std::string("auto"), 4, p.a.cyan());
+    else
+        p.kv("tiles_dim", tiling_off ? std::string("off") : grid_to_string(dc.infer.tiles_dim), 4, p.a.cyan());
     p.kv("tile_overlap", dc.infer.tile_overlap, 4, p.a.cyan());
+    if (dc.infer.tile_mode == idet::TileMode::Adaptive)
+        p.kv("tile_min_object", dc.infer.tile_min_object, 4, p.a.cyan());
+    if (!tiling_off || dc.infer.tile_mode == idet::TileMode::Adaptive)
+        p.kv("tile_merge", tile_merge_to_string(dc.infer.tile_merge), 4, p.a.yellow());
+    if (!tiling_off && dc.infer.bind_io) p.kv_bool("tile_batch", dc.infer.tile_batch, 4);
     p.kv("nms_iou", dc.infer.nms_iou, 4, p.a.cyan());
+    p.kv("nms_mode", nms_mode_to_string(dc.infer.nms_mode), 4, p.a.yellow());
+    if (dc.infer.nms_mode == idet::NmsMode::SoftGaussian) p.kv("nms_sigma", dc.infer.nms_sigma, 4, p.a.cyan());
 
     p.kv_bool("use_fast_iou", dc.infer.use_fast_iou, 4);
     p.kv_bool("apply_sigmoid", dc.infer.apply_sigmoid, 4);
     p.kv_bool("bind_io", dc.infer.bind_io, 4);
+    if (dc.infer.bind_io) {
+        p.kv("ctx_overflow", ctx_overflow_to_string(dc.infer.context_overflow), 4, p.a.yellow());
+        if (dc.infer.context_overflow != idet::ContextOverflow::Wait)
+            p.kv("ctx_wait_ms", dc.infer.context_wait_ms, 4, p.a.cyan());
+    }
+    p.kv_bool("cascade", dc.infer.cascade.enabled, 4);
+    if (dc.infer.cascade.enabled) {
+        p.kv("cascade_probe", dc.infer.cascade.probe_size, 4, p.a.cyan());
+        p.kv("cascade_trigger", dc.infer.cascade.trigger, 4, p.a.cyan());
+        p.kv("cascade_roi", dc.infer.cascade.roi_max_area, 4, p.a.cyan());
+    }
+    const idet::QualityOptions& qo = dc.infer.quality;
+    if (qo.target_ms > 0.0f || qo.max_queue > 0) {
+        p.kv("quality_ms", qo.target_ms, 4, p.a.cyan());
+        p.kv("quality_queue", qo.max_queue, 4, p.a.cyan());
+        p.kv("quality_levels", quality_levels_to_string(qo.levels), 4, p.a.cyan());
+    }
 
     os << "\n";
 
@@ -278,12 +678,31 @@ void print_config(std::ostream& os, const AppConfig& ac, const idet::DetectorCon
     p.kv("ort_intra_threads", dc.runtime.ort_intra_threads, 4, p.a.cyan());
     p.kv("ort_inter_threads", dc.runtime.ort_inter_threads, 4, p.a.cyan());
     p.kv("tile_omp_threads", dc.runtime.tile_omp_threads, 4, p.a.cyan());
+    p.kv("post_omp_threads", dc.runtime.post_omp_threads, 4, p.a.cyan());
+    p.kv_bool("pin_workers", dc.runtime.pin_worker_threads, 4);
 
     p.kv_bool("runtime_policy", ac.setup_runtime_policy, 4);
     if (ac.setup_runtime_policy) {
         p.kv_bool(" - soft_mem_bind", dc.runtime.soft_mem_bind, 4);
         p.kv_bool(" - suppress_opencv", dc.runtime.suppress_opencv, 4);
     }
+    if (!dc.runtime.shape_cache_file.empty()) p.kv_path("shape_cache", dc.runtime.shape_cache_file, 4);
+    if (!dc.runtime.optimized_model_file.empty()) p.kv_path("optimized_model", dc.runtime.optimized_model_file, 4);
+    p.kv_bool("share_session", dc.runtime.share_session, 4);
+    p.kv_bool("mmap_model", dc.runtime.mmap_model, 4);
+    p.kv("ort_spin", spin_to_string(dc.runtime.ort_spin), 4, p.a.yellow());
+    p.kv_bool("ort_parallel", dc.runtime.ort_parallel, 4);
+    p.kv("ort_arena", arena_to_string(dc.runtime.ort_arena), 4, p.a.yellow());
+    p.kv("bound_alloc", buffers_to_string(dc.runtime.bound_buffers), 4, p.a.yellow());
+    p.kv_bool("ort_denormal_zero", dc.runtime.ort_denormal_as_zero, 4);
+    p.kv("ort_ep", provider_to_string(dc.runtime.ort_provider), 4, p.a.yellow());
+    p.kv_bool("ort_global_pools", dc.runtime.ort_global_pools, 4);
+    if (!dc.runtime.capture_file.empty()) p.kv_path("capture", dc.runtime.capture_file, 4);
+    if (dc.engine == idet::EngineKind::Replay) {
+        p.kv("replay_latency_ms", dc.infer.replay.latency_ms, 4, p.a.cyan());
+        p.kv("replay_jitter_ms", dc.infer.replay.jitter_ms, 4, p.a.cyan());
+        p.kv_bool("replay_spin", dc.infer.replay.spin, 4);
+    }
 
     os << "\n========================================================\n\n";
 }
@@ -391,8 +810,31 @@ bool parse_arguments(int argc, char** argv, AppConfig& ac, idet::DetectorConfig&
         } else if (a == "--tiles_rc") {
             std::string v;
             if (!next(v)) return missing_value("--tiles_rc");
-            if (!parse_grid_int(v, dc.infer.tiles_dim))
-                return invalid_value("--tiles_rc", v, "expected RxC or off|no|0");
+            if (v == "auto") {
+                dc.infer.tile_mode = idet::TileMode::Adaptive;
+            } else {
+                dc.infer.tile_mode = idet::TileMode::Grid;
+                if (!parse_grid_int(v, dc.infer.tiles_dim))
+                    return invalid_value("--tiles_rc", v, "expected RxC, auto or off|no|0");
+            }
+
+        } else if (a == "--tile_merge") {
+            std::string v;
+            if (!next(v)) return missing_value("--tile_merge");
+            if (!string_to_tile_merge(v, dc.infer.tile_merge))
+                return invalid_value("--tile_merge", v, "expected nms|seams|join");
+
+        } else if (a == "--tile_batch") {
+            std::string v;
+            if (!next(v)) return missing_value("--tile_batch");
+            if (!parse_bool(v, dc.infer.tile_batch))
+                return invalid_value("--tile_batch", v, "expected 0|1|true|false");
+
+        } else if (a == "--tile_min_obj") {
+            std::string v;
+            if (!next(v)) return missing_value("--tile_min_obj");
+            if (!parse_int(v, dc.infer.tile_min_object) || dc.infer.tile_min_object < 0)
+                return invalid_value("--tile_min_obj", v, "expected non-negative integer");
 
         } else if (a == "--tile_overlap") {
             std::string v;
@@ -406,12 +848,61 @@ bool parse_arguments(int argc, char** argv, AppConfig& ac, idet::DetectorConfig&
             if (!parse_int(v, dc.runtime.tile_omp_threads) || dc.runtime.tile_omp_threads <= 0)
                 return invalid_value("--tile_omp", v, "expected positive integer");
 
+        } else if (a == "--post_omp") {
+            std::string v;
+            if (!next(v)) return missing_value("--post_omp");
+            if (!parse_int(v, dc.runtime.post_omp_threads) || dc.runtime.post_omp_threads <= 0)
+                return invalid_value("--post_omp", v, "expected positive integer");
+
+        } else if (a == "--pin_workers") {
+            std::string v;
+            if (!next(v)) return missing_value("--pin_workers");
+            if (!parse_bool(v, dc.runtime.pin_worker_threads))
+                return invalid_value("--pin_workers", v, "expected 0|1|true|false");
+
         } else if (a == "--nms_iou") {
             std::string v;
             if (!next(v)) return missing_value("--nms_iou");
             if (!parse_float(v, dc.infer.nms_iou) || dc.infer.nms_iou < 0.0f || dc.infer.nms_iou > 1.0f)
                 return invalid_value("--nms_iou", v, "expected 0 <= x <= 1");
 
+        } else if (a == "--nms_mode") {
+            std::string v;
+            if (!next(v)) return missing_value("--nms_mode");
+            if (!string_to_nms_mode(v, dc.infer.nms_mode))
+                return invalid_value("--nms_mode", v, "expected hard|linear|gaussian|weighted");
+
+        } else if (a == "--nms_sigma") {
+            std::string v;
+            if (!next(v)) return missing_value("--nms_sigma");
+            if (!parse_float(v, dc.infer.nms_sigma) || !(dc.infer.nms_sigma > 0.0f))
+                return invalid_value("--nms_sigma", v, "expected x > 0");
+
+        } else if (a == "--map_downsample") {
+            std::string v;
+            if (!next(v)) return missing_value("--map_downsample");
+            int f = 0;
+            if (!parse_int(v, f) || (f != 1 && f != 2 && f != 4))
+                return invalid_value("--map_downsample", v, "expected 1|2|4");
+            dc.infer.map_downsample = f;
+
+        } else if (a == "--map_pool") {
+            std::string v;
+            if (!next(v)) return missing_value("--map_pool");
+            if (!string_to_map_pooling(v, dc.infer.map_pooling))
+                return invalid_value("--map_pool", v, "expected max|avg");
+
+        } else if (a == "--map_u8") {
+            std::string v;
+            if (!next(v)) return missing_value("--map_u8");
+            if (!parse_bool(v, dc.infer.map_u8)) return invalid_value("--map_u8", v, "expected 0|1|true|false");
+
+        } else if (a == "--score_mode") {
+            std::string v;
+            if (!next(v)) return missing_value("--score_mode");
+            if (!string_to_score_mode(v, dc.infer.score_mode))
+                return invalid_value("--score_mode", v, "expected polygon|scanline|box");
+
         } else if (a == "--use_fast_iou") {
             std::string v;
             if (!next(v)) return missing_value("--use_fast_iou");
@@ -435,6 +926,98 @@ bool parse_arguments(int argc, char** argv, AppConfig& ac, idet::DetectorConfig&
             if (!parse_bool(v, dc.runtime.suppress_opencv))
                 return invalid_value("--suppress_opencv", v, "expected 0|1|true|false");
 
+        } else if (a == "--shape_cache") {
+            std::string v;
+            if (!next(v)) return missing_value("--shape_cache");
+            dc.runtime.shape_cache_file = v;
+
+        } else if (a == "--optimized_model") {
+            std::string v;
+            if (!next(v)) return missing_value("--optimized_model");
+            dc.runtime.optimized_model_file = v;
+
+        } else if (a == "--share_session") {
+            std::string v;
+            if (!next(v)) return missing_value("--share_session");
+            if (!parse_bool(v, dc.runtime.share_session))
+                return invalid_value("--share_session", v, "expected 0|1|true|false");
+
+        } else if (a == "--mmap_model") {
+            std::string v;
+            if (!next(v)) return missing_value("--mmap_model");
+            if (!parse_bool(v, dc.runtime.mmap_model))
+                return invalid_value("--mmap_model", v, "expected 0|1|true|false");
+
+        } else if (a == "--ort_spin") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_spin");
+            if (!string_to_spin(v, dc.runtime.ort_spin))
+                return invalid_value("--ort_spin", v, "expected default|on|off");
+
+        } else if (a == "--ort_parallel") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_parallel");
+            if (!parse_bool(v, dc.runtime.ort_parallel))
+                return invalid_value("--ort_parallel", v, "expected 0|1|true|false");
+
+        } else if (a == "--ort_arena") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_arena");
+            if (!string_to_arena(v, dc.runtime.ort_arena))
+                return invalid_value("--ort_arena", v, "expected arena|shrink|off");
+
+        } else if (a == "--bound_alloc") {
+            std::string v;
+            if (!next(v)) return missing_value("--bound_alloc");
+            if (!string_to_buffers(v, dc.runtime.bound_buffers))
+                return invalid_value("--bound_alloc", v, "expected heap|aligned|huge");
+
+        } else if (a == "--ort_denormal_zero") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_denormal_zero");
+            if (!parse_bool(v, dc.runtime.ort_denormal_as_zero))
+                return invalid_value("--ort_denormal_zero", v, "expected 0|1|true|false");
+
+        } else if (a == "--ort_ep") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_ep");
+            if (!string_to_provider(v, dc.runtime.ort_provider))
+                return invalid_value("--ort_ep", v, "expected cpu|xnnpack|dnnl|coreml");
+
+        } else if (a == "--ort_global_pools") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_global_pools");
+            if (!parse_bool(v, dc.runtime.ort_global_pools))
+                return invalid_value("--ort_global_pools", v, "expected 0|1|true|false");
+
+        } else if (a == "--capture") {
+            std::string v;
+            if (!next(v)) return missing_value("--capture");
+            dc.runtime.capture_file = v;
+
+        } else if (a == "--replay") {
+            std::string v;
+            if (!next(v)) return missing_value("--replay");
+            ac.replay_path = v;
+
+        } else if (a == "--replay_latency_ms") {
+            std::string v;
+            if (!next(v)) return missing_value("--replay_latency_ms");
+            if (!parse_float(v, dc.infer.replay.latency_ms) || dc.infer.replay.latency_ms < 0.0f)
+                return invalid_value("--replay_latency_ms", v, "expected x >= 0");
+
+        } else if (a == "--replay_jitter_ms") {
+            std::string v;
+            if (!next(v)) return missing_value("--replay_jitter_ms");
+            if (!parse_float(v, dc.infer.replay.jitter_ms) || dc.infer.replay.jitter_ms < 0.0f)
+                return invalid_value("--replay_jitter_ms", v, "expected x >= 0");
+
+        } else if (a == "--replay_spin") {
+            std::string v;
+            if (!next(v)) return missing_value("--replay_spin");
+            if (!parse_bool(v, dc.infer.replay.spin))
+                return invalid_value("--replay_spin", v, "expected 0|1|true|false");
+
         } else if (a == "--bind_io") {
             std::string v;
             if (!next(v)) return missing_value("--bind_io");
@@ -451,6 +1034,70 @@ bool parse_arguments(int argc, char** argv, AppConfig& ac, idet::DetectorConfig&
             if (!parse_grid_int(v, dc.infer.fixed_input_dim))
                 return invalid_value("--fixed_hw", v, "expected HxW or off|no|0");
 
+        } else if (a == "--bind_pool") {
+            std::string v;
+            if (!next(v)) return missing_value("--bind_pool");
+            if (!parse_grid_list(v, dc.infer.bind_buckets))
+                return invalid_value("--bind_pool", v, "expected HxW[,HxW...] or off|no|0");
+
+        } else if (a == "--letterbox") {
+            std::string v;
+            if (!next(v)) return missing_value("--letterbox");
+            if (!parse_bool(v, dc.infer.letterbox)) return invalid_value("--letterbox", v, "expected 0|1|true|false");
+
+        } else if (a == "--ctx_overflow") {
+            std::string v;
+            if (!next(v)) return missing_value("--ctx_overflow");
+            if (!string_to_ctx_overflow(v, dc.infer.context_overflow))
+                return invalid_value("--ctx_overflow", v, "expected wait|unbound|fail");
+
+        } else if (a == "--ctx_wait_ms") {
+            std::string v;
+            if (!next(v)) return missing_value("--ctx_wait_ms");
+            if (!parse_int(v, dc.infer.context_wait_ms) || dc.infer.context_wait_ms < 0)
+                return invalid_value("--ctx_wait_ms", v, "expected integer >= 0");
+
+        } else if (a == "--cascade") {
+            std::string v;
+            if (!next(v)) return missing_value("--cascade");
+            int side = 0;
+            if (!parse_int(v, side) || side < 0 || side % 32 != 0)
+                return invalid_value("--cascade", v, "expected 0 or a positive multiple of 32");
+            dc.infer.cascade.enabled = side > 0;
+            if (side > 0) dc.infer.cascade.probe_size = side;
+
+        } else if (a == "--cascade_trigger") {
+            std::string v;
+            if (!next(v)) return missing_value("--cascade_trigger");
+            if (!parse_float(v, dc.infer.cascade.trigger) || dc.infer.cascade.trigger < 0.0f ||
+                dc.infer.cascade.trigger > 1.0f)
+                return invalid_value("--cascade_trigger", v, "expected float in [0,1]");
+
+        } else if (a == "--cascade_roi") {
+            std::string v;
+            if (!next(v)) return missing_value("--cascade_roi");
+            if (!parse_float(v, dc.infer.cascade.roi_max_area) || dc.infer.cascade.roi_max_area < 0.0f ||
+                dc.infer.cascade.roi_max_area > 1.0f)
+                return invalid_value("--cascade_roi", v, "expected float in [0,1]");
+
+        } else if (a == "--quality_ms") {
+            std::string v;
+            if (!next(v)) return missing_value("--quality_ms");
+            if (!parse_float(v, dc.infer.quality.target_ms) || dc.infer.quality.target_ms < 0.0f)
+                return invalid_value("--quality_ms", v, "expected float >= 0");
+
+        } else if (a == "--quality_queue") {
+            std::string v;
+            if (!next(v)) return missing_value("--quality_queue");
+            if (!parse_int(v, dc.infer.quality.max_queue) || dc.infer.quality.max_queue < 0)
+                return invalid_value("--quality_queue", v, "expected integer >= 0");
+
+        } else if (a == "--quality_levels") {
+            std::string v;
+            if (!next(v)) return missing_value("--quality_levels");
+            if (!parse_quality_levels(v, dc.infer.quality.levels))
+                return invalid_value("--quality_levels", v, "expected SIDE[@RxC][,SIDE[@RxC]...] or auto");
+
         } else if (a == "--bench_iters") {
             std::string v;
             if (!next(v)) return missing_value("--bench_iters");
@@ -463,6 +1110,61 @@ bool parse_arguments(int argc, char** argv, AppConfig& ac, idet::DetectorConfig&
             if (!parse_int(v, ac.warmup_iters) || ac.warmup_iters < 0)
                 return invalid_value("--warmup_iters", v, "expected integer >= 0");
 
+        } else if (a == "--streams") {
+            std::string v;
+            if (!next(v)) return missing_value("--streams");
+            if (!parse_int(v, ac.streams) || ac.streams <= 0)
+                return invalid_value("--streams", v, "expected positive integer");
+
+        } else if (a == "--images") {
+            std::string v;
+            if (!next(v)) return missing_value("--images");
+            ac.images_dir = v;
+
+        } else if (a == "--input") {
+            std::string v;
+            if (!next(v)) return missing_value("--input");
+            ac.input_list = v;
+
+        } else if (a == "--jsonl") {
+            std::string v;
+            if (!next(v)) return missing_value("--jsonl");
+            ac.jsonl_path = v;
+
+        } else if (a == "--decoders") {
+            std::string v;
+            if (!next(v)) return missing_value("--decoders");
+            if (!parse_int(v, ac.decoders) || ac.decoders <= 0)
+                return invalid_value("--decoders", v, "expected positive integer");
+
+        } else if (a == "--prefetch") {
+            std::string v;
+            if (!next(v)) return missing_value("--prefetch");
+            if (!parse_int(v, ac.prefetch) || ac.prefetch <= 0)
+                return invalid_value("--prefetch", v, "expected positive integer");
+
+        } else if (a == "--report") {
+            std::string v;
+            if (!next(v)) return missing_value("--report");
+            ac.report_path = v;
+
+        } else if (a == "--ort_profile") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_profile");
+            if (!parse_int(v, dc.runtime.profile_runs) || dc.runtime.profile_runs <= 0)
+                return invalid_value("--ort_profile", v, "expected positive integer");
+
+        } else if (a == "--ort_profile_prefix") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_profile_prefix");
+            dc.runtime.profile_prefix = v;
+
+        } else if (a == "--ort_profile_top") {
+            std::string v;
+            if (!next(v)) return missing_value("--ort_profile_top");
+            if (!parse_int(v, ac.profile_top) || ac.profile_top <= 0)
+                return invalid_value("--ort_profile_top", v, "expected positive integer");
+
         } else if (a == "--is_draw") {
             std::string v;
             if (!next(v)) return missing_value("--is_draw");
@@ -473,6 +1175,11 @@ bool parse_arguments(int argc, char** argv, AppConfig& ac, idet::DetectorConfig&
             if (!next(v)) return missing_value("--is_dump");
             if (!parse_bool(v, ac.is_dump)) return invalid_value("--is_dump", v, "expected 0|1|true|false");
 
+        } else if (a == "--fast_decode") {
+            std::string v;
+            if (!next(v)) return missing_value("--fast_decode");
+            if (!parse_bool(v, ac.fast_decode)) return invalid_value("--fast_decode", v, "expected 0|1|true|false");
+
         } else if (a == "--runtime_policy") {
             std::string v;
             if (!next(v)) return missing_value("--runtime_policy");
@@ -486,12 +1193,17 @@ bool parse_arguments(int argc, char** argv, AppConfig& ac, idet::DetectorConfig&
         }
     }
 
-    if (ac.image_path.empty()) {
-        std::cerr << "[ERROR] Missing required argument: --image\n";
+    if (ac.image_path.empty() && ac.input_list.empty() && (ac.streams <= 0 || ac.images_dir.empty())) {
+        std::cerr << "[ERROR] Missing required argument: --image (or --input, or --images with --streams)\n";
         print_usage(argv[0]);
         return false;
     }
 
+    if (!ac.input_list.empty() && ac.streams > 0) {
+        std::cerr << "[ERROR] --input (batch mode) and --streams (throughput mode) are exclusive\n";
+        return false;
+    }
+
     if (dc.task == idet::Task::None) {
         std::cerr << "[ERROR] Missing required argument: --mode\n";
         print_usage(argv[0]);
@@ -502,6 +1214,19 @@ bool parse_arguments(int argc, char** argv, AppConfig& ac, idet::DetectorConfig&
         dc.engine = get_default_engine(dc.task);
     }
 
+    if (!ac.replay_path.empty()) {
+        if (!dc.runtime.capture_file.empty()) {
+            std::cerr << "[ERROR] --capture and --replay are exclusive\n";
+            return false;
+        }
+        dc.engine = idet::EngineKind::Replay;
+        dc.model_path = ac.replay_path;
+    }
+
+    if (dc.runtime.profile_runs > 0 && dc.runtime.profile_prefix.empty()) {
+        dc.runtime.profile_prefix = "idet_ort_profile";
+    }
+
     if (dc.model_path.empty()) {
         std::cerr << "[WARN] Missing required argument: --model (will fallback to blob model if available)\n";
     }
@@ -8,11 +8,21 @@ namespace cli {
 
 struct AppConfig {
     std::string image_path;
+    std::string images_dir;  // throughput mode: directory of input images (default: image_path)
     std::string out_path = "result.png";
+    std::string report_path; // throughput mode: CSV / JSON report (by extension), empty = none
+    std::string input_list;  // batch mode: directory or list file of images, one JSON line per image
+    std::string jsonl_path = "-"; // batch mode output, "-" = stdout
+    std::string replay_path;      // replay this capture file instead of running --model
+    int decoders = 2;             // batch mode: decoder threads
+    int prefetch = 0;             // batch mode: decoded images kept ahead of inference (0 = 2 * decoders)
     int bench_iters = 100;
     int warmup_iters = 20;
+    int streams = 0; // > 0: throughput mode with this many concurrent callers
+    int profile_top = 15; // operators listed in the ORT profile report (--ort_profile)
     bool is_draw = true;
     bool is_dump = true;
+    bool fast_decode = false; // decode images reduced towards the engine input size (untiled runs)
     bool setup_runtime_policy = true;
 };
 
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <ostream>
 #include <stdexcept>
 #include <string>
 
@@ -19,6 +20,21 @@ namespace io {
 
 namespace {
 
+void write_json_string(std::ostream& os, const std::string& s) {
+    static const char* const kHex = "0123456789abcdef";
+    os << '"';
+    for (const unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << (char)c;
+        } else if (c < 0x20) {
+            os << "\\u00" << kHex[c >> 4] << kHex[c & 15];
+        } else {
+            os << (char)c;
+        }
+    }
+    os << '"';
+}
+
 static cv::Mat to_cv_mat_bgr_copy(const idet::Image& image) {
     const auto& v = image.view();
     if (!v.is_valid()) {
@@ -57,6 +73,30 @@ void dump_detections(const idet::VecQuad& quads) {
     std::cout << "\n";
 }
 
+void write_jsonl(std::ostream& os, const std::string& path, const idet::LoadedImage& image,
+                 const idet::VecDetection& dets, double decode_ms, double detect_ms, const std::string& error) {
+    os << "{\"path\": ";
+    write_json_string(os, path);
+    if (!error.empty()) {
+        os << ", \"error\": ";
+        write_json_string(os, error);
+        os << "}\n";
+        return;
+    }
+
+    os << ", \"width\": " << image.source_width << ", \"height\": " << image.source_height
+       << ", \"decode_ms\": " << decode_ms << ", \"detect_ms\": " << detect_ms << ", \"dets\": [";
+    for (std::size_t i = 0; i < dets.size(); ++i) {
+        os << (i ? ", " : "") << "{\"score\": " << dets[i].score << ", \"quad\": [";
+        for (int k = 0; k < 4; ++k) {
+            const idet::Point2f& pt = dets[i].quad[(std::size_t)k];
+            os << (k ? ", " : "") << "[" << pt.x / image.scale_x << ", " << pt.y / image.scale_y << "]";
+        }
+        os << "]}";
+    }
+    os << "]}\n";
+}
+
 void draw_detections(const idet::Image& image, const idet::VecQuad& quads, const idet::GridSpec& tiles_rc,
                      const std::string& out_path) {
 
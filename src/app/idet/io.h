@@ -1,6 +1,7 @@
 #pragma once
 
 #include <idet.h>
+#include <iosfwd>
 #include <string>
 
 namespace io {
@@ -10,4 +11,9 @@ void draw_detections(const idet::Image& image, const idet::VecQuad& quads, const
 
 void dump_detections(const idet::VecQuad& quads);
 
+// One JSON object per line: {"path", "width", "height", "decode_ms", "detect_ms", "dets": [{"score", "quad"}]}
+// with quads in source pixels (divided by the decode scale of `image`), or {"path", "error"} if `error` is set.
+void write_jsonl(std::ostream& os, const std::string& path, const idet::LoadedImage& image,
+                 const idet::VecDetection& dets, double decode_ms, double detect_ms, const std::string& error = {});
+
 } // namespace io
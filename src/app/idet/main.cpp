@@ -1,9 +1,148 @@
 #include "bench.h"
 #include "cli.h"
 #include "io.h"
+#include "ort_profile.h"
+#include "prefetch.h"
+#include "throughput.h"
 
+#include <algorithm>
+#include <fstream>
 #include <idet.h>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool is_tiled(const idet::DetectorConfig& dc) {
+    return dc.infer.tile_mode == idet::TileMode::Adaptive || dc.infer.tiles_dim.rows * dc.infer.tiles_dim.cols > 1;
+}
+
+// Longest side the engine resizes frames to, or 0 (decode at full size) without --fast_decode or when tiling
+// needs the source resolution.
+int decode_target(const cli::AppConfig& ac, const idet::DetectorConfig& dc) {
+    if (!ac.fast_decode || is_tiled(dc)) return 0;
+    const idet::GridSpec& fixed = dc.infer.fixed_input_dim;
+    if (fixed.rows > 0 && fixed.cols > 0) return std::max(fixed.rows, fixed.cols);
+    return dc.infer.max_img_size;
+}
+
+idet::LoadedImage load_input(const std::string& path, int target) {
+    idet::LoadOptions lo;
+    lo.output_format = idet::PixelFormat::BGR_U8;
+    lo.target_max_side = target;
+    auto img_res = idet::load_image(path, lo);
+    if (!img_res.ok()) throw std::runtime_error("[ERROR] Failed to load image: " + img_res.status().message);
+    return std::move(img_res.value());
+}
+
+// Images of the throughput run: every image file of --images (sorted by name), else --image.
+std::vector<idet::Image> load_stream_images(const cli::AppConfig& ac, const idet::DetectorConfig& dc) {
+    std::vector<std::string> paths;
+    if (!ac.images_dir.empty()) {
+        paths = io::list_image_files(ac.images_dir);
+        if (paths.empty()) throw std::runtime_error("[ERROR] No images found in: " + ac.images_dir);
+    } else {
+        paths.push_back(ac.image_path);
+    }
+
+    const int target = decode_target(ac, dc);
+    std::vector<idet::Image> images;
+    images.reserve(paths.size());
+    for (const auto& p : paths)
+        images.push_back(load_input(p, target).image);
+    return images;
+}
+
+// Bound contexts are per-caller only for untiled frames (tiled calls share per-detector tile state),
+// so tiled or unbound runs give every stream its own detector instead.
+bool streams_share_detector(const cli::AppConfig& ac, const idet::DetectorConfig& dc) {
+    return ac.streams > 0 && dc.infer.bind_io && !is_tiled(dc);
+}
+
+// Batch mode: --decoders threads decode ahead while the detector works through the images in input
+// order; one JSON line per image. Returns the process exit code (1 if any image failed).
+int run_batch(idet::Detector& d, const cli::AppConfig& ac, const idet::DetectorConfig& dc) {
+    std::vector<std::string> paths = io::list_inputs(ac.input_list);
+    const int capacity = ac.prefetch > 0 ? ac.prefetch : 2 * ac.decoders;
+
+    std::ofstream file;
+    std::ostream* os = &std::cout;
+    if (ac.jsonl_path != "-") {
+        file.open(ac.jsonl_path);
+        if (!file) throw std::runtime_error("[ERROR] Cannot open output: " + ac.jsonl_path);
+        os = &file;
+    }
+
+    bench::Timer wall{};
+    wall.tic();
+    io::PrefetchSource source(std::move(paths), ac.decoders, capacity, decode_target(ac, dc));
+
+    bench::Timer timer{};
+    io::PrefetchSource::Item item;
+    idet::VecDetection dets;
+    std::size_t failed = 0;
+    while (source.next(item)) {
+        std::string error = std::move(item.error);
+        double detect_ms = 0;
+        dets.clear();
+        if (error.empty()) {
+            timer.tic();
+            const idet::Status st = d.detect_ex(item.image.image, dets);
+            detect_ms = timer.toc_ms();
+            if (!st.ok()) error = st.message;
+        }
+        if (!error.empty()) ++failed;
+        io::write_jsonl(*os, item.path, item.image, dets, item.decode_ms, detect_ms, error);
+    }
+    os->flush();
+    if (!*os) throw std::runtime_error("[ERROR] Failed to write output: " + ac.jsonl_path);
+
+    // stdout may carry the JSON lines, so the summary goes to stderr
+    if (dc.verbose) {
+        std::cerr << "[app_info] batch images / failed : " << source.size() << " / " << failed << "\n";
+        std::cerr << "[app_info] batch wall time, ms   : " << wall.toc_ms() << "\n";
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+// Wall time of each startup step (printed in verbose mode).
+struct StartupTimes {
+    double policy_ms = 0.0;
+    double create_ms = 0.0;
+    double bind_ms = 0.0;
+    double warmup_ms = 0.0;
+    double replicas_ms = 0.0; // throughput mode: the other streams' detectors, built concurrently
+};
+
+void print_startup(std::ostream& os, const StartupTimes& st) {
+    os << "[app_info] startup policy, ms  : " << st.policy_ms << "\n";
+    os << "[app_info] startup create, ms  : " << st.create_ms << "\n";
+    os << "[app_info] startup bind, ms    : " << st.bind_ms << "\n";
+    os << "[app_info] startup warmup, ms  : " << st.warmup_ms << "\n";
+    if (st.replicas_ms > 0.0) os << "[app_info] startup replicas, ms: " << st.replicas_ms << "\n";
+}
+
+// Writes the ORT trace (if not written yet) and prints its top operators; no-op without --ort_profile*.
+void report_ort_profile(idet::Detector& d, const cli::AppConfig& ac, const idet::DetectorConfig& dc) {
+    if (dc.runtime.profile_prefix.empty()) return;
+    auto path_res = d.end_profiling();
+    if (!path_res.ok()) {
+        std::cerr << "[WARN] ORT profiling: " << path_res.status().message << "\n";
+        return;
+    }
+    prof::OpReport report;
+    std::string err;
+    if (!prof::load_op_report(path_res.value(), report, err)) {
+        std::cerr << "[WARN] ORT profiling: " << err << "\n";
+        return;
+    }
+    prof::print_op_report(std::cout, report, (std::size_t)ac.profile_top, /*verbose=*/dc.verbose, /*use_color=*/true);
+}
+
+} // namespace
 
 int main(int argc, char** argv) {
     // Create timer
@@ -18,7 +157,10 @@ int main(int argc, char** argv) {
         throw std::runtime_error("[ERROR] Failed to parse arguments!");
     }
 
+    StartupTimes startup{};
+
     // Setup runtime policy BEFORE hard calculations
+    timer.tic();
     if (app_config.setup_runtime_policy) {
         auto rp_res = idet::setup_runtime_policy(det_config.runtime, /*verbose=*/det_config.verbose);
         if (!rp_res.ok()) {
@@ -26,32 +168,130 @@ int main(int argc, char** argv) {
         }
     }
 
+    startup.policy_ms = timer.toc_ms();
+
     // Create detector
+    timer.tic();
     auto det_res = idet::create_detector(det_config);
     if (!det_res.ok()) {
         throw std::runtime_error("[ERROR] Failed to create detector: " + det_res.status().message);
     }
     idet::Detector detector = std::move(det_res.value());
+    startup.create_ms = timer.toc_ms();
 
-    // Bind io
-    if (det_config.infer.bind_io) {
+    // Bind io (one context per stream when the streams share this detector)
+    const bool shared = streams_share_detector(app_config, det_config);
+    auto bind = [&](idet::Detector& d) {
+        if (!det_config.infer.bind_io) return;
         const int fixed_w = det_config.infer.fixed_input_dim.cols;
         const int fixed_h = det_config.infer.fixed_input_dim.rows;
         const int tile_threads = det_config.runtime.tile_omp_threads;
+        const int contexts = shared ? std::max(tile_threads, app_config.streams) : tile_threads;
+        const auto& buckets = det_config.infer.bind_buckets;
+        // Tile batching packs every grid tile of a frame into one bound run
+        const idet::GridSpec& g = det_config.infer.tiles_dim;
+        const int max_batch = det_config.infer.tile_batch ? std::max(1, g.rows * g.cols) : 1;
 
-        auto bind_res = detector.prepare_binding(fixed_w, fixed_h, tile_threads);
+        auto bind_res = buckets.empty() ? d.prepare_binding(fixed_w, fixed_h, contexts, max_batch)
+                                        : d.prepare_binding_pool(buckets.data(), buckets.size(), contexts, max_batch);
         if (!bind_res.ok()) {
             throw std::runtime_error("[ERROR] Failed to bind input/output buffers: " + bind_res.message);
         }
+    };
+    // Touches every bound context (buffers, bindings, ORT arena) before the first timed frame
+    auto warm = [&](idet::Detector& d) {
+        if (!det_config.infer.bind_io) return;
+        const idet::Status st = d.warmup(nullptr, 0, /*iterations=*/1);
+        if (!st.ok()) throw std::runtime_error("[ERROR] Failed to warm up detector: " + st.message);
+    };
+    timer.tic();
+    bind(detector);
+    startup.bind_ms = timer.toc_ms();
+    timer.tic();
+    warm(detector);
+    startup.warmup_ms = timer.toc_ms();
+
+    // Batch mode: a directory or list of images, decoded ahead of inference
+    if (!app_config.input_list.empty()) {
+        if (det_config.verbose) {
+            cli::print_config(std::cerr, app_config, det_config);
+            print_startup(std::cerr, startup);
+        }
+        return run_batch(detector, app_config, det_config);
+    }
+
+    // Throughput mode: K concurrent callers over a set of images
+    if (app_config.streams > 0) {
+        const std::vector<idet::Image> images = load_stream_images(app_config, det_config);
+
+        // The other streams' detectors are built (created, bound, warmed up) concurrently
+        std::vector<idet::Detector> replicas;
+        if (!shared && app_config.streams > 1) {
+            timer.tic();
+            replicas.resize((std::size_t)app_config.streams - 1);
+            std::vector<std::string> errors(replicas.size());
+            std::vector<std::thread> builders;
+            builders.reserve(replicas.size());
+            for (std::size_t r = 0; r < replicas.size(); ++r) {
+                builders.emplace_back([&, r] {
+                    try {
+                        auto rep_res = idet::create_detector(det_config);
+                        if (!rep_res.ok()) {
+                            throw std::runtime_error("[ERROR] Failed to create detector: " + rep_res.status().message);
+                        }
+                        replicas[r] = std::move(rep_res.value());
+                        bind(replicas[r]);
+                        warm(replicas[r]);
+                    } catch (const std::exception& e) {
+                        errors[r] = e.what();
+                    }
+                });
+            }
+            for (auto& t : builders)
+                t.join();
+            for (const auto& e : errors) {
+                if (!e.empty()) throw std::runtime_error(e);
+            }
+            startup.replicas_ms = timer.toc_ms();
+        }
+
+        std::vector<idet::VecDetection> outs((std::size_t)app_config.streams);
+        auto frame = [&](int s, const idet::Image& img) -> std::size_t {
+            idet::VecDetection& out = outs[(std::size_t)s];
+            idet::Detector& d = (shared || s == 0) ? detector : replicas[(std::size_t)s - 1];
+            const idet::Status st = shared ? d.detect_bound_ex(img, s, out) : d.detect_ex(img, out);
+            if (!st.ok()) throw std::runtime_error("[ERROR] Failed to detect: " + st.message);
+            return out.size();
+        };
+
+        // Cold start (catching early errors) and the detection count of the first image
+        const std::size_t dets_n = frame(0, images.front());
+
+        if (det_config.verbose) {
+            cli::print_config(std::cout, app_config, det_config);
+            print_startup(std::cout, startup);
+        }
+
+        bench::ThroughputConfig tc{};
+        tc.streams = app_config.streams;
+        tc.warmup = static_cast<std::size_t>(app_config.warmup_iters);
+        tc.frames = static_cast<std::size_t>(app_config.bench_iters);
+        const bench::ThroughputStat ts = bench::run_throughput(tc, images, frame);
+
+        bench::print_throughput_stat(std::cout, ts, /*verbose=*/det_config.verbose, /*use_color=*/true);
+        std::cout << "dets_n: " << dets_n << "\n";
+        report_ort_profile(detector, app_config, det_config);
+
+        if (!app_config.report_path.empty() && !bench::write_throughput_report(app_config.report_path, ts)) {
+            throw std::runtime_error("[ERROR] Failed to write report: " + app_config.report_path);
+        }
+        return 0;
     }
 
     // Load image
     timer.tic();
-    auto img_res = idet::load_image(app_config.image_path, idet::PixelFormat::BGR_U8);
-    if (!img_res.ok()) {
-        throw std::runtime_error("[ERROR] Failed to load image: " + img_res.status().message);
-    }
-    idet::Image img = std::move(img_res.value());
+    idet::LoadedImage loaded = load_input(app_config.image_path, decode_target(app_config, det_config));
+    const idet::Image& img = loaded.image;
     const double img_load_ms = timer.toc_ms();
 
     // Pre-warmup (catching early errors)
@@ -65,6 +305,7 @@ int main(int argc, char** argv) {
     // Display config
     if (det_config.verbose) {
         cli::print_config(std::cout, app_config, det_config);
+        print_startup(std::cout, startup);
     }
 
     // Bench
@@ -72,7 +313,10 @@ int main(int argc, char** argv) {
         std::size_t warm_it = static_cast<std::size_t>(app_config.warmup_iters);
         std::size_t bench_it = static_cast<std::size_t>(app_config.bench_iters);
 
+        // Stage statistics cover the timed iterations only
+        std::size_t calls = 0;
         auto det_func = [&]() {
+            if (calls++ == warm_it) detector.reset_stats();
             auto det_res = detector.detect(img);
             if (!det_res.ok()) {
                 throw std::runtime_error("[ERROR] Failed to detect: " + det_res.status().message);
@@ -85,9 +329,16 @@ int main(int argc, char** argv) {
 
         auto benc_stat = bench::compute_bench_stat(std::move(samples));
 
-        bench::print_bench_stat(std::cout, benc_stat, /*verbose=*/det_config.verbose, /*use_color=*/true);
+        idet::DetectorStats stages{};
+        const bool has_stages = detector.stats(stages).ok();
+
+        bench::print_bench_stat(std::cout, benc_stat, /*verbose=*/det_config.verbose, /*use_color=*/true,
+                                has_stages ? &stages : nullptr);
     }
 
+    // Operator breakdown of the profiled session runs
+    report_ort_profile(detector, app_config, det_config);
+
     // Combat launch for results
     auto r = detector.detect(img);
     if (!r.ok()) {
@@ -98,14 +349,35 @@ int main(int argc, char** argv) {
     // Show useful app info
     if (det_config.verbose) {
         std::cout << "[app_info] load image time, ms : " << img_load_ms << "\n";
+        if (loaded.scale_x != 1.f || loaded.scale_y != 1.f) {
+            std::cout << "[app_info] decoded size          : " << img.view().width << "x" << img.view().height << " of "
+                      << loaded.source_width << "x" << loaded.source_height << "\n";
+        }
         std::cout << "[app_info] num detection quads : " << quads.size() << "\n";
+
+        // Tile load balance of the last frame (tiled runs only)
+        std::vector<idet::TileTiming> tiles;
+        if (detector.last_tile_timings(tiles).ok() && !tiles.empty()) {
+            double t_min = tiles.front().ms, t_max = tiles.front().ms, t_sum = 0.0;
+            for (const auto& t : tiles) {
+                t_min = std::min(t_min, t.ms);
+                t_max = std::max(t_max, t.ms);
+                t_sum += t.ms;
+            }
+            std::cout << "[app_info] tile time min/avg/max, ms : " << t_min << " / " << t_sum / (double)tiles.size()
+                      << " / " << t_max << "\n";
+        }
         std::cout << "\n";
     } else {
         std::cout << "dets_n: " << quads.size() << "\n";
     }
 
-    // Dump quads points
-    if (app_config.is_dump) io::dump_detections(quads);
+    // Dump quads points (in source pixels)
+    if (app_config.is_dump) {
+        idet::VecQuad source = quads;
+        idet::map_to_source(source, loaded);
+        io::dump_detections(source);
+    }
 
     // Draw results
     if (app_config.is_draw) io::draw_detections(img, quads, det_config.infer.tiles_dim, app_config.out_path);
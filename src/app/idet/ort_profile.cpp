@@ -0,0 +1,301 @@
+#include "ort_profile.h"
+
+#include "printer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace prof {
+
+namespace {
+
+// Fields of one trace event. Nested objects other than "args" are skipped.
+struct Event {
+    std::string cat, name, op;
+    double ts = 0.0, dur = 0.0;
+};
+
+// Minimal JSON reader for the ORT trace: a top-level array of flat event objects.
+class TraceReader {
+  public:
+    explicit TraceReader(const std::string& s) : s_(s) {}
+
+    bool read(std::vector<Event>& out, std::string& err) {
+        ws_();
+        if (!eat_('[')) return fail_(err, "expected '['");
+        ws_();
+        if (eat_(']')) return true;
+        for (;;) {
+            Event e;
+            if (!event_(e)) return fail_(err, "malformed event");
+            out.push_back(std::move(e));
+            ws_();
+            if (eat_(',')) continue;
+            if (eat_(']')) return true;
+            return fail_(err, "expected ',' or ']'");
+        }
+    }
+
+  private:
+    bool fail_(std::string& err, const char* what) const {
+        err = std::string(what) + " at byte " + std::to_string(i_);
+        return false;
+    }
+
+    void ws_() noexcept {
+        while (i_ < s_.size() && (s_[i_] == ' ' || s_[i_] == '\n' || s_[i_] == '\r' || s_[i_] == '\t'))
+            ++i_;
+    }
+
+    bool eat_(char c) noexcept {
+        if (i_ < s_.size() && s_[i_] == c) {
+            ++i_;
+            return true;
+        }
+        return false;
+    }
+
+    bool string_(std::string& out) {
+        ws_();
+        if (!eat_('"')) return false;
+        out.clear();
+        while (i_ < s_.size()) {
+            const char c = s_[i_++];
+            if (c == '"') return true;
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (i_ >= s_.size()) return false;
+            const char e = s_[i_++];
+            switch (e) {
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'u': // operator names are ASCII; keep a placeholder for anything else
+                if (i_ + 4 > s_.size()) return false;
+                i_ += 4;
+                out.push_back('?');
+                break;
+            default:
+                out.push_back(e);
+                break;
+            }
+        }
+        return false;
+    }
+
+    bool number_(double& out) {
+        ws_();
+        const char* b = s_.c_str() + i_;
+        char* e = nullptr;
+        out = std::strtod(b, &e);
+        if (e == b) return false;
+        i_ += (std::size_t)(e - b);
+        return true;
+    }
+
+    // Skips any value (objects and arrays recursively).
+    bool skip_() {
+        ws_();
+        if (i_ >= s_.size()) return false;
+        const char c = s_[i_];
+        if (c == '"') {
+            std::string tmp;
+            return string_(tmp);
+        }
+        if (c == '{' || c == '[') {
+            const char close = (c == '{') ? '}' : ']';
+            ++i_;
+            ws_();
+            if (eat_(close)) return true;
+            for (;;) {
+                if (c == '{') {
+                    std::string key;
+                    if (!string_(key)) return false;
+                    ws_();
+                    if (!eat_(':')) return false;
+                }
+                if (!skip_()) return false;
+                ws_();
+                if (eat_(',')) continue;
+                return eat_(close);
+            }
+        }
+        for (const char* lit : {"true", "false", "null"}) {
+            const std::size_t n = std::char_traits<char>::length(lit);
+            if (s_.compare(i_, n, lit) == 0) {
+                i_ += n;
+                return true;
+            }
+        }
+        double d = 0.0;
+        return number_(d);
+    }
+
+    // Reads an object, calling `field(key)` with the cursor at each value; `field` consumes it.
+    template <class F> bool object_(F&& field) {
+        ws_();
+        if (!eat_('{')) return false;
+        ws_();
+        if (eat_('}')) return true;
+        std::string key;
+        for (;;) {
+            if (!string_(key)) return false;
+            ws_();
+            if (!eat_(':')) return false;
+            if (!field(key)) return false;
+            ws_();
+            if (eat_(',')) continue;
+            return eat_('}');
+        }
+    }
+
+    bool event_(Event& e) {
+        return object_([&](const std::string& key) {
+            if (key == "cat") return string_(e.cat);
+            if (key == "name") return string_(e.name);
+            if (key == "ts") return number_(e.ts);
+            if (key == "dur") return number_(e.dur);
+            if (key == "args") {
+                ws_();
+                if (i_ < s_.size() && s_[i_] != '{') return skip_();
+                return object_([&](const std::string& k) { return k == "op_name" ? string_(e.op) : skip_(); });
+            }
+            return skip_();
+        });
+    }
+
+    const std::string& s_;
+    std::size_t i_ = 0;
+};
+
+bool ends_with(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+bool load_op_report(const std::string& path, OpReport& out, std::string& err) {
+    out = OpReport{};
+    out.path = path;
+
+    std::ifstream f(path, std::ios::binary);
+    if (!f) {
+        err = "cannot open " + path;
+        return false;
+    }
+    const std::string text((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+    std::vector<Event> events;
+    TraceReader rd(text);
+    if (!rd.read(events, err)) {
+        err = path + ": " + err;
+        return false;
+    }
+
+    // The first run pays for allocations and kernel selection; ORT emits "model_run" after its nodes,
+    // so the window is known only once all events are read.
+    double cold_begin = 0.0, cold_end = -1.0;
+    std::size_t runs = 0;
+    for (const Event& e : events) {
+        if (e.cat != "Session" || e.name != "model_run") continue;
+        if (runs == 0 || e.ts < cold_begin) {
+            cold_begin = e.ts;
+            cold_end = e.ts + e.dur;
+        }
+        ++runs;
+    }
+    out.skipped_cold = runs > 1;
+    out.runs = out.skipped_cold ? runs - 1 : runs;
+
+    static const std::string kKernel = "_kernel_time";
+    std::unordered_map<std::string, std::size_t> index;
+    for (const Event& e : events) {
+        if (e.cat != "Node" || !ends_with(e.name, kKernel)) continue;
+        if (out.skipped_cold && e.ts >= cold_begin && e.ts <= cold_end) continue;
+
+        const std::string& op = e.op.empty() ? e.name : e.op;
+        auto it = index.find(op);
+        if (it == index.end()) {
+            it = index.emplace(op, out.ops.size()).first;
+            out.ops.push_back(OpStat{op, 0, 0.0});
+        }
+        OpStat& s = out.ops[it->second];
+        ++s.calls;
+        s.total_us += e.dur;
+        out.total_us += e.dur;
+    }
+
+    std::sort(out.ops.begin(), out.ops.end(), [](const OpStat& a, const OpStat& b) {
+        return a.total_us != b.total_us ? a.total_us > b.total_us : a.op < b.op;
+    });
+    return true;
+}
+
+void print_op_report(std::ostream& os, const OpReport& r, std::size_t top, bool verbose, bool use_color) {
+    const std::size_t n = std::min(top, r.ops.size());
+    auto share = [&](const OpStat& s) { return r.total_us > 0.0 ? 100.0 * s.total_us / r.total_us : 0.0; };
+    auto avg_us = [](const OpStat& s) { return s.calls ? s.total_us / (double)s.calls : 0.0; };
+
+    if (!verbose) {
+        os << "ort_profile: " << r.path << "\n";
+        os << "ort_runs: " << r.runs << "\n";
+        for (std::size_t i = 0; i < n; ++i) {
+            const OpStat& s = r.ops[i];
+            os << "ort_op_" << i + 1 << ": op=" << s.op << " calls=" << s.calls << " total_ms=" << s.total_us * 1e-3
+               << " avg_us=" << avg_us(s) << " share=" << share(s) << "\n";
+        }
+        return;
+    }
+
+    printer::Printer p{os};
+    p.a.enable = use_color;
+    p.key_w = 10;
+
+    p.section("ORT Operator Profile");
+    os << "\n";
+    p.kv_path("trace", r.path, 4);
+    p.kv("runs", r.runs, 4, p.a.bold());
+    if (r.skipped_cold) p.hint("first run excluded (cold start)", 4);
+    os << "\n";
+
+    auto oldf = os.flags();
+    const auto oldp = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "    " << p.a.bold() << std::left << std::setw(4) << "#" << std::setw(28) << "op" << std::right
+       << std::setw(8) << "calls" << std::setw(12) << "total_ms" << std::setw(11) << "avg_us" << std::setw(9)
+       << "share" << p.a.reset() << "\n";
+    for (std::size_t i = 0; i < n; ++i) {
+        const OpStat& s = r.ops[i];
+        os << "    " << std::left << std::setw(4) << i + 1 << std::setw(28) << s.op << std::right << std::setw(8)
+           << s.calls << p.a.cyan() << std::setw(12) << s.total_us * 1e-3 << std::setw(11) << avg_us(s)
+           << p.a.reset() << p.a.yellow() << std::setw(8) << std::setprecision(1) << share(s) << "%"
+           << std::setprecision(3) << p.a.reset() << "\n";
+    }
+    os.flags(oldf);
+    os.precision(oldp);
+
+    os << "\n========================================================\n\n";
+}
+
+} // namespace prof
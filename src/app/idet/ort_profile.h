@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace prof {
+
+// Per-operator summary of an ONNX Runtime profiling trace (RuntimePolicy::profile_prefix).
+
+struct OpStat {
+    std::string op;        // operator type (args.op_name), e.g. "Conv"
+    std::size_t calls = 0; // executed nodes of this type over all profiled runs
+    double total_us = 0.0; // cumulative kernel time
+};
+
+struct OpReport {
+    std::string path;
+    std::size_t runs = 0;      // profiled session runs ("model_run" events) after the skipped one
+    bool skipped_cold = false; // the first run (allocations, kernel selection) was excluded
+    double total_us = 0.0;     // kernel time of all operators
+    std::vector<OpStat> ops;   // sorted by total_us, descending
+};
+
+// Parses the Chrome-trace JSON written by ORT and sums "<node>_kernel_time" events per operator
+// type. Nodes of the first run are dropped when the trace holds more than one run. Returns false
+// and sets `err` if the file cannot be read or is not a trace.
+[[nodiscard]] bool load_op_report(const std::string& path, OpReport& out, std::string& err);
+
+// Prints the `top` most expensive operators. Non-verbose output is one "ort_op_<rank>:" line of
+// key=value fields per operator after "ort_profile:" / "ort_runs:" lines.
+void print_op_report(std::ostream& os, const OpReport& r, std::size_t top, bool verbose, bool use_color = true);
+
+} // namespace prof
@@ -0,0 +1,135 @@
+#include "prefetch.h"
+
+#include "bench.h"
+
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace io {
+
+std::vector<std::string> list_image_files(const std::string& dir) {
+    namespace fs = std::filesystem;
+    static const char* const kExts[] = {".jpg", ".jpeg", ".png", ".bmp", ".tif", ".tiff", ".webp"};
+
+    std::vector<std::string> paths;
+    for (const auto& e : fs::directory_iterator(dir)) {
+        if (!e.is_regular_file()) continue;
+        std::string ext = e.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        if (std::find(std::begin(kExts), std::end(kExts), ext) != std::end(kExts)) paths.push_back(e.path().string());
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+std::vector<std::string> list_inputs(const std::string& dir_or_list) {
+    std::vector<std::string> paths;
+    if (std::filesystem::is_directory(dir_or_list)) {
+        paths = list_image_files(dir_or_list);
+    } else {
+        std::ifstream f(dir_or_list);
+        if (!f) throw std::runtime_error("[ERROR] Cannot open input list: " + dir_or_list);
+        std::string line;
+        while (std::getline(f, line)) {
+            while (!line.empty() && std::isspace((unsigned char)line.back()))
+                line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            paths.push_back(line);
+        }
+    }
+    if (paths.empty()) throw std::runtime_error("[ERROR] No input images in: " + dir_or_list);
+    return paths;
+}
+
+PrefetchSource::PrefetchSource(std::vector<std::string> paths, int decoders, int capacity, int target_max_side)
+    : paths_(std::move(paths)), target_(target_max_side) {
+    decoders = std::max(1, std::min(decoders, (int)std::max<std::size_t>(1, paths_.size())));
+    ring_.resize((std::size_t)std::max(capacity, decoders));
+
+    try {
+        for (int i = 0; i < decoders; ++i)
+            threads_.emplace_back([this] { decode_loop_(); });
+    } catch (...) {
+        // Threads already started must be joined before the members they use go away.
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        room_cv_.notify_all();
+        for (auto& t : threads_)
+            t.join();
+        throw;
+    }
+}
+
+PrefetchSource::~PrefetchSource() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+    }
+    room_cv_.notify_all();
+    for (auto& t : threads_)
+        if (t.joinable()) t.join();
+}
+
+bool PrefetchSource::next(Item& out) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (next_out_ >= paths_.size()) return false;
+
+    auto& slot = ring_[next_out_ % ring_.size()];
+    ready_cv_.wait(lk, [&] { return slot.has_value(); });
+    out = std::move(*slot);
+    slot.reset();
+    ++next_out_;
+    lk.unlock();
+    room_cv_.notify_all();
+    return true;
+}
+
+void PrefetchSource::decode_loop_() {
+    for (;;) {
+        std::size_t i = 0;
+        {
+            std::unique_lock<std::mutex> lk(mu_);
+            // Index i only reuses the slot of i - ring_.size(), which the consumer has taken by then.
+            room_cv_.wait(lk, [&] {
+                return stop_ || next_claim_ >= paths_.size() || next_claim_ < next_out_ + ring_.size();
+            });
+            if (stop_ || next_claim_ >= paths_.size()) return;
+            i = next_claim_++;
+        }
+
+        Item item;
+        item.index = i;
+        item.path = paths_[i];
+        bench::Timer timer{};
+        timer.tic();
+        try {
+            idet::LoadOptions lo;
+            lo.output_format = idet::PixelFormat::BGR_U8;
+            lo.target_max_side = target_;
+            auto r = idet::load_image(item.path, lo);
+            if (r.ok())
+                item.image = std::move(r.value());
+            else
+                item.error = r.status().message;
+        } catch (const std::exception& e) {
+            item.error = e.what();
+        }
+        item.decode_ms = timer.toc_ms();
+
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            ring_[i % ring_.size()] = std::move(item);
+        }
+        ready_cv_.notify_all();
+    }
+}
+
+} // namespace io
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <idet.h>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace io {
+
+// Input paths of a batch job: every image file of a directory (sorted by name), or the lines of a
+// list file (one path per line; empty lines and lines starting with '#' are skipped). Throws
+// std::runtime_error if nothing can be listed.
+std::vector<std::string> list_inputs(const std::string& dir_or_list);
+
+// Image files of a directory, sorted by name (empty if there are none).
+std::vector<std::string> list_image_files(const std::string& dir);
+
+// Decodes a list of images ahead of the consumer: `decoders` threads claim paths in order and park
+// the results in a bounded ring of `capacity` slots, so at most `capacity` decoded images exist at
+// once and decoding overlaps with inference. next() hands the images out in input order.
+class PrefetchSource {
+  public:
+    struct Item {
+        std::size_t index = 0;
+        std::string path;
+        idet::LoadedImage image; // empty on failure
+        std::string error;       // decode failure, empty on success
+        double decode_ms = 0;
+    };
+
+    // target_max_side: see idet::LoadOptions::target_max_side (0: full-size decode).
+    PrefetchSource(std::vector<std::string> paths, int decoders, int capacity, int target_max_side);
+
+    // Stops the decoders (pending decodes finish) and joins them.
+    ~PrefetchSource();
+
+    PrefetchSource(const PrefetchSource&) = delete;
+    PrefetchSource& operator=(const PrefetchSource&) = delete;
+
+    // Blocks until the next image in input order is decoded; false once all were handed out.
+    bool next(Item& out);
+
+    std::size_t size() const noexcept {
+        return paths_.size();
+    }
+
+  private:
+    void decode_loop_();
+
+    std::vector<std::string> paths_;
+    int target_ = 0;
+
+    std::mutex mu_;
+    std::condition_variable room_cv_;  // signals a consumed slot (or stop)
+    std::condition_variable ready_cv_; // signals a decoded slot
+    std::vector<std::optional<Item>> ring_; // slot of index i: i % ring_.size()
+    std::size_t next_claim_ = 0;            // next index a decoder takes
+    std::size_t next_out_ = 0;              // next index handed to the consumer
+    bool stop_ = false;
+
+    std::vector<std::thread> threads_; // declared last: started after the state above exists
+};
+
+} // namespace io
@@ -0,0 +1,235 @@
+#include "throughput.h"
+
+#include "printer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/resource.h>
+    #define IDET_APP_HAVE_RUSAGE 1
+#else
+    #define IDET_APP_HAVE_RUSAGE 0
+#endif
+
+namespace bench {
+
+namespace {
+
+// User + system CPU time of the whole process, in seconds.
+double process_cpu_s() noexcept {
+#if IDET_APP_HAVE_RUSAGE
+    struct rusage ru{};
+    if (::getrusage(RUSAGE_SELF, &ru) != 0) return 0.0;
+    auto tv_s = [](const timeval& tv) { return (double)tv.tv_sec + (double)tv.tv_usec * 1e-6; };
+    return tv_s(ru.ru_utime) + tv_s(ru.ru_stime);
+#else
+    return (double)std::clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+bool ends_with_ci(const std::string& s, const std::string& suffix) {
+    if (s.size() < suffix.size()) return false;
+    return std::equal(suffix.begin(), suffix.end(), s.end() - (std::ptrdiff_t)suffix.size(),
+                      [](char a, char b) { return std::tolower((unsigned char)a) == std::tolower((unsigned char)b); });
+}
+
+} // namespace
+
+ThroughputStat run_throughput(const ThroughputConfig& cfg, const std::vector<idet::Image>& images,
+                              const StreamFrameFn& frame) {
+    ThroughputStat out{};
+    const int k = std::max(1, cfg.streams);
+    out.streams = k;
+    out.images = images.size();
+    if (images.empty() || cfg.frames == 0) return out;
+
+    std::vector<std::vector<double>> samples((std::size_t)k);
+    std::vector<ClockType::time_point> ends((std::size_t)k);
+
+    std::mutex mu;
+    std::condition_variable cv;
+    int ready = 0;
+    bool go = false;
+    ClockType::time_point t0{};
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr err;
+
+    auto fail = [&](std::exception_ptr e) {
+        std::lock_guard<std::mutex> lk(mu);
+        if (!err) err = std::move(e);
+        failed.store(true, std::memory_order_relaxed);
+        go = true; // release the start gate if the failure happened during warmup
+        cv.notify_all();
+    };
+
+    auto body = [&](int s) {
+        const std::size_t n_img = images.size();
+        auto& ms = samples[(std::size_t)s];
+        ms.reserve(cfg.frames);
+        try {
+            for (std::size_t i = 0; i < cfg.warmup && !failed.load(std::memory_order_relaxed); ++i)
+                detail::do_not_optimize(frame(s, images[((std::size_t)s + i) % n_img]));
+
+            {
+                std::unique_lock<std::mutex> lk(mu);
+                ++ready;
+                cv.notify_all();
+                cv.wait(lk, [&] { return go; });
+            }
+
+            Timer timer{};
+            for (std::size_t i = 0; i < cfg.frames && !failed.load(std::memory_order_relaxed); ++i) {
+                const idet::Image& img = images[((std::size_t)s + i) % n_img];
+                timer.tic();
+                detail::do_not_optimize(frame(s, img));
+                ms.push_back(timer.toc_ms());
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+        ends[(std::size_t)s] = ClockType::now();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve((std::size_t)k);
+    for (int s = 0; s < k; ++s)
+        threads.emplace_back(body, s);
+
+    double cpu0 = 0.0;
+    {
+        std::unique_lock<std::mutex> lk(mu);
+        cv.wait(lk, [&] { return ready == k || go; });
+        cpu0 = process_cpu_s();
+        t0 = ClockType::now();
+        go = true;
+    }
+    cv.notify_all();
+
+    for (auto& t : threads)
+        t.join();
+    const double cpu1 = process_cpu_s();
+    if (err) std::rethrow_exception(err);
+
+    ClockType::time_point t1 = t0;
+    std::vector<double> all;
+    all.reserve((std::size_t)k * cfg.frames);
+    for (int s = 0; s < k; ++s) {
+        StreamStat st{};
+        st.stream = s;
+        st.wall_s = std::chrono::duration<double>(ends[(std::size_t)s] - t0).count();
+        st.fps = (st.wall_s > 0.0) ? (double)samples[(std::size_t)s].size() / st.wall_s : 0.0;
+        all.insert(all.end(), samples[(std::size_t)s].begin(), samples[(std::size_t)s].end());
+        st.lat = compute_bench_stat(std::move(samples[(std::size_t)s]));
+        out.per_stream.push_back(std::move(st));
+        t1 = std::max(t1, ends[(std::size_t)s]);
+    }
+
+    out.frames = all.size();
+    out.wall_s = std::chrono::duration<double>(t1 - t0).count();
+    out.fps = (out.wall_s > 0.0) ? (double)out.frames / out.wall_s : 0.0;
+    out.cpu_s = std::max(0.0, cpu1 - cpu0);
+    out.cpu_util = (out.wall_s > 0.0) ? out.cpu_s / out.wall_s : 0.0;
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    out.cpu_util_pct = 100.0 * out.cpu_util / (double)hw;
+    out.lat = compute_bench_stat(std::move(all));
+    return out;
+}
+
+void print_throughput_stat(std::ostream& os, const ThroughputStat& s, bool verbose, bool use_color) {
+    if (!verbose) {
+        os << "streams: " << s.streams << "\n";
+        os << "fps: " << s.fps << "\n";
+        os << "cpu_util: " << s.cpu_util << "\n";
+        os << "p50_ms: " << s.lat.p50_ms << "\n";
+        os << "p90_ms: " << s.lat.p90_ms << "\n";
+        os << "p95_ms: " << s.lat.p95_ms << "\n";
+        os << "p99_ms: " << s.lat.p99_ms << "\n";
+        for (const auto& st : s.per_stream)
+            os << "stream_" << st.stream << ": frames=" << st.lat.n << " fps=" << st.fps << " p50_ms=" << st.lat.p50_ms
+               << " p99_ms=" << st.lat.p99_ms << "\n";
+        return;
+    }
+    printer::Printer p{os};
+    p.a.enable = use_color;
+    p.key_w = 14;
+
+    os << "\n========================================================\n\n";
+    p.section("Throughput Results");
+    os << "\n";
+
+    p.kv("streams", s.streams, 4, p.a.bold());
+    p.kv("images", s.images, 4, p.a.bold());
+    p.kv("frames", s.frames, 4, p.a.bold());
+    p.kv("wall_s", s.wall_s, 4, p.a.cyan());
+    p.kv("fps", s.fps, 4, p.a.green());
+    p.kv("cpu_util", s.cpu_util, 4, p.a.yellow());
+    p.kv("cpu_util_pct", s.cpu_util_pct, 4, p.a.yellow());
+
+    os << "\n";
+
+    p.kv("p50_ms", s.lat.p50_ms, 4, p.a.cyan());
+    p.kv("p90_ms", s.lat.p90_ms, 4, p.a.cyan());
+    p.kv("p95_ms", s.lat.p95_ms, 4, p.a.cyan());
+    p.kv("p99_ms", s.lat.p99_ms, 4, p.a.cyan());
+
+    os << "\n";
+
+    for (const auto& st : s.per_stream) {
+        p.section("stream " + std::to_string(st.stream), 4);
+        p.kv("fps", st.fps, 6, p.a.green());
+        p.kv("p50_ms", st.lat.p50_ms, 6, p.a.cyan());
+        p.kv("p99_ms", st.lat.p99_ms, 6, p.a.cyan());
+    }
+
+    os << "\n========================================================\n\n";
+}
+
+bool write_throughput_report(const std::string& path, const ThroughputStat& s) {
+    std::ofstream f(path);
+    if (!f) return false;
+
+    if (ends_with_ci(path, ".json")) {
+        auto lat = [&](const BenchStat& b) {
+            f << "\"frames\": " << b.n << ", \"avg_ms\": " << b.avg_ms << ", \"p50_ms\": " << b.p50_ms
+              << ", \"p90_ms\": " << b.p90_ms << ", \"p95_ms\": " << b.p95_ms << ", \"p99_ms\": " << b.p99_ms;
+        };
+        f << "{\n  \"streams\": " << s.streams << ",\n  \"images\": " << s.images << ",\n  \"wall_s\": " << s.wall_s
+          << ",\n  \"fps\": " << s.fps << ",\n  \"cpu_s\": " << s.cpu_s << ",\n  \"cpu_util\": " << s.cpu_util
+          << ",\n  \"cpu_util_pct\": " << s.cpu_util_pct << ",\n  ";
+        lat(s.lat);
+        f << ",\n  \"per_stream\": [";
+        for (std::size_t i = 0; i < s.per_stream.size(); ++i) {
+            const auto& st = s.per_stream[i];
+            f << (i ? ",\n" : "\n") << "    {\"stream\": " << st.stream << ", \"wall_s\": " << st.wall_s
+              << ", \"fps\": " << st.fps << ", ";
+            lat(st.lat);
+            f << "}";
+        }
+        f << "\n  ]\n}\n";
+        return (bool)f;
+    }
+
+    f << "stream,frames,wall_s,fps,avg_ms,p50_ms,p90_ms,p95_ms,p99_ms,cpu_util\n";
+    for (const auto& st : s.per_stream)
+        f << st.stream << "," << st.lat.n << "," << st.wall_s << "," << st.fps << "," << st.lat.avg_ms << ","
+          << st.lat.p50_ms << "," << st.lat.p90_ms << "," << st.lat.p95_ms << "," << st.lat.p99_ms << ",\n";
+    f << "all," << s.frames << "," << s.wall_s << "," << s.fps << "," << s.lat.avg_ms << "," << s.lat.p50_ms << ","
+      << s.lat.p90_ms << "," << s.lat.p95_ms << "," << s.lat.p99_ms << "," << s.cpu_util << "\n";
+    return (bool)f;
+}
+
+} // namespace bench
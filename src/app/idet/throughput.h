@@ -0,0 +1,62 @@
+#pragma once
+
+#include "bench.h"
+
+#include <cstddef>
+#include <functional>
+#include <idet.h>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Throughput mode: K caller threads push frames through the detector concurrently (each on its own
+// bound context or its own detector) and the aggregate frame rate of the process is measured.
+
+struct ThroughputConfig {
+    int streams = 1;          // concurrent caller threads
+    std::size_t warmup = 20;  // untimed frames per stream
+    std::size_t frames = 100; // timed frames per stream
+};
+
+struct StreamStat {
+    int stream = 0;
+    double wall_s = 0; // from the common start to the last frame of this stream
+    double fps = 0;
+    BenchStat lat{};   // per-frame latency of this stream
+};
+
+struct ThroughputStat {
+    int streams = 0;
+    std::size_t images = 0;
+    std::size_t frames = 0; // timed frames over all streams
+
+    double wall_s = 0;       // from the common start to the last frame of any stream
+    double fps = 0;          // frames / wall_s
+    double cpu_s = 0;        // process user + system CPU time during the timed window
+    double cpu_util = 0;     // cpu_s / wall_s, i.e. busy cores
+    double cpu_util_pct = 0; // cpu_util relative to the hardware concurrency
+
+    BenchStat lat{}; // per-frame latency over all streams
+    std::vector<StreamStat> per_stream;
+};
+
+// Runs one frame for stream `stream` and returns its detection count; throws on failure.
+using StreamFrameFn = std::function<std::size_t(int stream, const idet::Image& img)>;
+
+// Stream s feeds images[(s + i) % images.size()] for its i-th frame. All streams finish their
+// warmup before the timed window opens. The first exception of any stream stops the others and is
+// rethrown after all threads joined.
+ThroughputStat run_throughput(const ThroughputConfig& cfg, const std::vector<idet::Image>& images,
+                              const StreamFrameFn& frame);
+
+// Non-verbose output is "key: value" lines (fps, cpu_util, p50_ms..., one summary line per stream),
+// the format tools/grid_search.py parses.
+void print_throughput_stat(std::ostream& os, const ThroughputStat& s, bool verbose, bool use_color = true);
+
+// Writes one row per stream plus an "all" row (CSV) or one object (JSON), chosen by the extension
+// of `path` (.json, anything else is CSV). Returns false if the file cannot be written.
+bool write_throughput_report(const std::string& path, const ThroughputStat& s);
+
+} // namespace bench
@@ -51,7 +51,8 @@ void print_usage(const char* argv0) {
               << "  --loop             Loop playback\n"
               << "  --start <N>        Start from frame N (default 0)\n"
               << "  --count <N>        Show only N frames (default all)\n"
-              << "  --no-overlay       Disable overlay text\n\n"
+              << "  --no-overlay       Disable overlay text\n"
+              << "  --headless         Decode frames without a window (post-preview callback only)\n\n"
               << "Controls:\n"
               << "  SPACE  pause/resume\n"
               << "  n      next frame (when paused)\n"
@@ -108,6 +109,8 @@ bool parse_args(int argc, char** argv, yuvv::ViewerConfig& cfg) {
             cfg.max_frames = std::stoll(v);
         } else if (k == "--no-overlay") {
             cfg.overlay_info = false;
+        } else if (k == "--headless") {
+            cfg.headless = true;
         } else if (k == "--help" || k == "-h") {
             return false;
         } else {
@@ -0,0 +1,76 @@
+/**
+ * @file arena.cpp
+ * @ingroup idet_algo
+ * @brief Implementation of the monotonic per-frame scratch arena.
+ */
+
+#include "algo/arena.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace idet::algo {
+
+static constexpr std::size_t kMinBlockBytes = 16 * 1024;
+
+FrameArena::FrameArena(std::size_t initial_bytes) {
+    add_block_(initial_bytes);
+}
+
+void FrameArena::add_block_(std::size_t min_bytes) {
+    std::size_t sz = std::max(min_bytes, kMinBlockBytes);
+    if (!blocks_.empty()) sz = std::max(sz, blocks_.back().size * 2);
+
+    Block b;
+    b.data.reset(new unsigned char[sz]);
+    b.size = sz;
+    blocks_.push_back(std::move(b));
+    ++upstream_allocs_;
+}
+
+void* FrameArena::alloc_bytes_(std::size_t bytes, std::size_t align) {
+    if (bytes == 0) bytes = 1;
+
+    for (;;) {
+        if (cur_ == blocks_.size()) add_block_(bytes + align); // becomes blocks_[cur_]
+
+        Block& b = blocks_[cur_];
+        const auto base = reinterpret_cast<std::uintptr_t>(b.data.get());
+        const std::uintptr_t p = (base + off_ + (align - 1)) & ~(std::uintptr_t)(align - 1);
+        const std::size_t end = (std::size_t)(p - base) + bytes;
+        if (end <= b.size) {
+            off_ = end;
+            return reinterpret_cast<void*>(p);
+        }
+
+        // Does not fit: move on to the next (possibly new) block.
+        used_prev_ += off_;
+        off_ = 0;
+        ++cur_;
+    }
+}
+
+void FrameArena::reset() {
+    if (blocks_.size() > 1) {
+        // Frame spilled over several blocks: replace them with one block that fits the whole frame.
+        const std::size_t total = capacity();
+        blocks_.clear();
+        add_block_(total);
+    }
+    cur_ = 0;
+    off_ = 0;
+    used_prev_ = 0;
+}
+
+std::size_t FrameArena::used() const noexcept {
+    return used_prev_ + off_;
+}
+
+std::size_t FrameArena::capacity() const noexcept {
+    std::size_t total = 0;
+    for (const auto& b : blocks_)
+        total += b.size;
+    return total;
+}
+
+} // namespace idet::algo
@@ -0,0 +1,96 @@
+/**
+ * @file arena.h
+ * @ingroup idet_algo
+ * @brief Monotonic per-frame scratch arena for postprocessing temporaries.
+ *
+ * @details
+ * @ref idet::algo::FrameArena hands out uninitialized arrays of trivially destructible types and
+ * releases them all at once on @ref idet::algo::FrameArena::reset. It is meant to be owned by one
+ * inference context and reset at the start of every frame:
+ * - allocations are pointer bumps inside a block,
+ * - when a frame overflows the current block, a new block is requested from the heap,
+ * - on reset, multiple blocks are coalesced into one block of their total size, so after a warmup
+ *   frame the same workload is served without touching the heap.
+ *
+ * @ref idet::algo::FrameArena::upstream_allocations counts heap requests and is the hook used to
+ * verify that a steady-state path is allocation-free.
+ *
+ * @note An arena must not be shared between threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace idet::algo {
+
+/**
+ * @brief Bump allocator reset once per frame.
+ */
+class FrameArena final {
+  public:
+    /** @brief Creates an empty arena; the first block is allocated on first use. */
+    FrameArena() = default;
+
+    /** @brief Creates an arena with a preallocated first block of at least @p initial_bytes. */
+    explicit FrameArena(std::size_t initial_bytes);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) noexcept = default;
+    FrameArena& operator=(FrameArena&&) noexcept = default;
+    ~FrameArena() = default;
+
+    /**
+     * @brief Returns storage for @p n objects of type @p T (uninitialized, valid until reset).
+     *
+     * @throws std::bad_alloc If a new block cannot be allocated.
+     */
+    template <class T> T* alloc(std::size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena: T must be trivially destructible");
+        return static_cast<T*>(alloc_bytes_(n * sizeof(T), alignof(T)));
+    }
+
+    /** @brief Same as @ref alloc, with every element value-initialized to @p v. */
+    template <class T> T* alloc_fill(std::size_t n, const T& v) {
+        T* p = alloc<T>(n);
+        for (std::size_t i = 0; i < n; ++i)
+            p[i] = v;
+        return p;
+    }
+
+    /** @brief Releases all allocations; coalesces blocks so the next frame fits in one. */
+    void reset();
+
+    /** @brief Bytes handed out since the last reset (including alignment padding). */
+    std::size_t used() const noexcept;
+
+    /** @brief Total bytes owned by the arena. */
+    std::size_t capacity() const noexcept;
+
+    /** @brief Number of heap block allocations performed over the arena lifetime. */
+    std::uint64_t upstream_allocations() const noexcept {
+        return upstream_allocs_;
+    }
+
+  private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size = 0;
+    };
+
+    void* alloc_bytes_(std::size_t bytes, std::size_t align);
+    void add_block_(std::size_t min_bytes);
+
+    std::vector<Block> blocks_;
+    std::size_t cur_ = 0;        ///< Index of the block being filled
+    std::size_t off_ = 0;        ///< Fill offset inside blocks_[cur_]
+    std::size_t used_prev_ = 0;  ///< Bytes used in blocks before cur_
+    std::uint64_t upstream_allocs_ = 0;
+};
+
+} // namespace idet::algo
@@ -0,0 +1,227 @@
+/**
+ * @file detection_buffer.cpp
+ * @ingroup idet_algo
+ * @brief Implementation of the structure-of-arrays detection buffer.
+ */
+
+#include "algo/detection_buffer.h"
+
+#include <algorithm>
+
+namespace idet::algo {
+
+namespace {
+
+/// @brief Keeps the entries of @p col flagged in @p keep, in order; returns the new size.
+template <class T> std::size_t compact(std::vector<T>& col, const std::uint8_t* keep) noexcept {
+    std::size_t o = 0;
+    for (std::size_t i = 0; i < col.size(); ++i) {
+        col[o] = col[i];
+        o += keep[i];
+    }
+    col.resize(o);
+    return o;
+}
+
+/// @brief Min/max of four values, reduced left to right like the quad loops elsewhere.
+inline void range4(float a, float b, float c, float d, float& lo, float& hi) noexcept {
+    lo = std::min(std::min(std::min(a, b), c), d);
+    hi = std::max(std::max(std::max(a, b), c), d);
+}
+
+} // namespace
+
+void DetectionBuffer::clear() noexcept {
+    for (int k = 0; k < 4; ++k) {
+        x_[k].clear();
+        y_[k].clear();
+    }
+    for (int k = 0; k < 5; ++k) {
+        kx_[k].clear();
+        ky_[k].clear();
+    }
+    score_.clear();
+    tile_.clear();
+    has_kps_.clear();
+    minx_.clear();
+    miny_.clear();
+    maxx_.clear();
+    maxy_.clear();
+}
+
+void DetectionBuffer::reserve(std::size_t n) {
+    for (int k = 0; k < 4; ++k) {
+        x_[k].reserve(n);
+        y_[k].reserve(n);
+    }
+    for (int k = 0; k < 5; ++k) {
+        kx_[k].reserve(n);
+        ky_[k].reserve(n);
+    }
+    score_.reserve(n);
+    tile_.reserve(n);
+    has_kps_.reserve(n);
+    minx_.reserve(n);
+    miny_.reserve(n);
+    maxx_.reserve(n);
+    maxy_.reserve(n);
+}
+
+void DetectionBuffer::push_back(const Detection& d) {
+    for (int k = 0; k < 4; ++k) {
+        x_[k].push_back(d.pts[k].x);
+        y_[k].push_back(d.pts[k].y);
+    }
+    for (int k = 0; k < 5; ++k) {
+        kx_[k].push_back(d.kps[k].x);
+        ky_[k].push_back(d.kps[k].y);
+    }
+    score_.push_back(d.score);
+    tile_.push_back(d.tile);
+    has_kps_.push_back(d.has_kps ? 1 : 0);
+    float x0, x1, y0, y1;
+    range4(d.pts[0].x, d.pts[1].x, d.pts[2].x, d.pts[3].x, x0, x1);
+    range4(d.pts[0].y, d.pts[1].y, d.pts[2].y, d.pts[3].y, y0, y1);
+    minx_.push_back(x0);
+    miny_.push_back(y0);
+    maxx_.push_back(x1);
+    maxy_.push_back(y1);
+}
+
+void DetectionBuffer::append(const std::vector<Detection>& dets) {
+    const std::size_t base = size();
+    const std::size_t n = dets.size();
+    if (n == 0) return;
+    const std::size_t total = base + n;
+
+    // Grow every column first so a failed allocation leaves the sizes consistent.
+    reserve(total);
+    for (int k = 0; k < 4; ++k) {
+        x_[k].resize(total);
+        y_[k].resize(total);
+    }
+    for (int k = 0; k < 5; ++k) {
+        kx_[k].resize(total);
+        ky_[k].resize(total);
+    }
+    score_.resize(total);
+    tile_.resize(total);
+    has_kps_.resize(total);
+    minx_.resize(total);
+    miny_.resize(total);
+    maxx_.resize(total);
+    maxy_.resize(total);
+
+    // Transpose, then derive the boxes from the new x/y columns.
+    for (std::size_t i = 0; i < n; ++i) {
+        const Detection& d = dets[i];
+        for (int k = 0; k < 4; ++k) {
+            x_[k][base + i] = d.pts[k].x;
+            y_[k][base + i] = d.pts[k].y;
+        }
+        for (int k = 0; k < 5; ++k) {
+            kx_[k][base + i] = d.kps[k].x;
+            ky_[k][base + i] = d.kps[k].y;
+        }
+        score_[base + i] = d.score;
+        tile_[base + i] = d.tile;
+        has_kps_[base + i] = d.has_kps ? 1 : 0;
+    }
+    const float *x0 = x_[0].data(), *x1 = x_[1].data(), *x2 = x_[2].data(), *x3 = x_[3].data();
+    const float *y0 = y_[0].data(), *y1 = y_[1].data(), *y2 = y_[2].data(), *y3 = y_[3].data();
+    float *bx0 = minx_.data(), *by0 = miny_.data(), *bx1 = maxx_.data(), *by1 = maxy_.data();
+    for (std::size_t i = base; i < total; ++i) {
+        range4(x0[i], x1[i], x2[i], x3[i], bx0[i], bx1[i]);
+        range4(y0[i], y1[i], y2[i], y3[i], by0[i], by1[i]);
+    }
+}
+
+void DetectionBuffer::offset(std::size_t first, float dx, float dy, int tile) noexcept {
+    const std::size_t n = size();
+    if (first >= n) return;
+
+    auto shift = [&](std::vector<float>& col, float d) {
+        float* c = col.data();
+        for (std::size_t i = first; i < n; ++i)
+            c[i] += d;
+    };
+    for (int k = 0; k < 4; ++k) {
+        shift(x_[k], dx);
+        shift(y_[k], dy);
+    }
+    shift(minx_, dx);
+    shift(maxx_, dx);
+    shift(miny_, dy);
+    shift(maxy_, dy);
+
+    // Landmarks: a masked add keeps the loop branch-free.
+    const std::uint8_t* has = has_kps_.data();
+    for (int k = 0; k < 5; ++k) {
+        float* kx = kx_[k].data();
+        float* ky = ky_[k].data();
+        for (std::size_t i = first; i < n; ++i) {
+            const float m = (float)has[i];
+            kx[i] += m * dx;
+            ky[i] += m * dy;
+        }
+    }
+    std::fill(tile_.begin() + (std::ptrdiff_t)first, tile_.end(), tile);
+}
+
+std::size_t DetectionBuffer::filter_min_size(int min_w, int min_h) {
+    const std::size_t n = size();
+    if ((min_w <= 0 && min_h <= 0) || n == 0) return n;
+
+    // Same test as on the quads: negative (or NaN) extents count as 0.
+    const float mw = min_w > 0 ? (float)min_w : 0.f;
+    const float mh = min_h > 0 ? (float)min_h : 0.f;
+    mask_.resize(n);
+    std::uint8_t* keep = mask_.data();
+    const float *bx0 = minx_.data(), *by0 = miny_.data(), *bx1 = maxx_.data(), *by1 = maxy_.data();
+    std::size_t left = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const float w = std::max(0.0f, bx1[i] - bx0[i]);
+        const float h = std::max(0.0f, by1[i] - by0[i]);
+        keep[i] = (std::uint8_t)((min_w <= 0 || !(w < mw)) & (min_h <= 0 || !(h < mh)));
+        left += keep[i];
+    }
+    if (left == n) return n;
+
+    for (int k = 0; k < 4; ++k) {
+        compact(x_[k], keep);
+        compact(y_[k], keep);
+    }
+    for (int k = 0; k < 5; ++k) {
+        compact(kx_[k], keep);
+        compact(ky_[k], keep);
+    }
+    compact(score_, keep);
+    compact(tile_, keep);
+    compact(has_kps_, keep);
+    compact(minx_, keep);
+    compact(miny_, keep);
+    compact(maxx_, keep);
+    compact(maxy_, keep);
+    return left;
+}
+
+Detection DetectionBuffer::get(std::size_t i) const noexcept {
+    Detection d;
+    d.pts = quad(i);
+    for (std::size_t k = 0; k < 5; ++k)
+        d.kps[k] = cv::Point2f(kx_[k][i], ky_[k][i]);
+    d.score = score_[i];
+    d.has_kps = has_kps_[i] != 0;
+    d.tile = tile_[i];
+    return d;
+}
+
+void DetectionBuffer::export_to(std::vector<Detection>& out) const {
+    const std::size_t n = size();
+    out.clear();
+    out.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        out.push_back(get(i));
+}
+
+} // namespace idet::algo
@@ -0,0 +1,141 @@
+/**
+ * @file detection_buffer.h
+ * @ingroup idet_algo
+ * @brief Structure-of-arrays detection storage for the post-decode pipeline.
+ *
+ * @details
+ * @ref idet::algo::DetectionBuffer holds the same data as a @c std::vector<Detection>, one column
+ * per field: the x and y of every quad corner and landmark, the score, the tile index, and the
+ * axis-aligned bounding box of each quad, computed once on insertion and kept up to date.
+ *
+ * The columns let the steps after decoding run as plain loops over contiguous floats, which the
+ * compiler vectorizes:
+ * - @ref idet::algo::DetectionBuffer::offset moves a range to another origin (tile to frame),
+ * - @ref idet::algo::DetectionBuffer::filter_min_size drops small boxes in place from the cached
+ *   boxes instead of reducing every quad again,
+ * - @ref idet::algo::NmsWorkspace::run reads the cached boxes for its grid,
+ *
+ * and the kept entries are exported once at the end. A buffer reused across frames keeps its
+ * capacity, so none of these steps allocates in steady state.
+ *
+ * @note Not thread-safe; one buffer per frame or per bound context.
+ */
+
+#pragma once
+
+#include "algo/geometry.h"
+#include "algo/nms.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace idet::algo {
+
+/**
+ * @brief Columnar list of detections with cached AABBs.
+ */
+class DetectionBuffer final {
+  public:
+    /** @brief Number of detections. */
+    std::size_t size() const noexcept {
+        return score_.size();
+    }
+
+    bool empty() const noexcept {
+        return score_.empty();
+    }
+
+    /** @brief Removes all detections; capacity is kept. */
+    void clear() noexcept;
+
+    /** @throws std::bad_alloc On allocation failure. */
+    void reserve(std::size_t n);
+
+    /**
+     * @brief Appends @p d and its AABB.
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void push_back(const Detection& d);
+
+    /**
+     * @brief Appends all of @p dets (one pass per column block).
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void append(const std::vector<Detection>& dets);
+
+    /** @brief Replaces the contents with @p dets. */
+    void assign(const std::vector<Detection>& dets) {
+        clear();
+        append(dets);
+    }
+
+    /**
+     * @brief Shifts detections [@p first, size()) by (@p dx, @p dy) and sets their tile index.
+     *
+     * @details
+     * Same result as @ref offset_detection on every entry: landmarks move only where present.
+     * The cached boxes move with the quads.
+     */
+    void offset(std::size_t first, float dx, float dy, int tile) noexcept;
+
+    /**
+     * @brief Removes detections whose AABB is narrower than @p min_w or lower than @p min_h.
+     *
+     * @details
+     * Stable, in place. A threshold <= 0 disables that dimension; negative extents count as 0.
+     *
+     * @return Number of detections left.
+     * @throws std::bad_alloc When growing the internal keep mask fails.
+     */
+    std::size_t filter_min_size(int min_w, int min_h);
+
+    float score(std::size_t i) const noexcept {
+        return score_[i];
+    }
+
+    int tile(std::size_t i) const noexcept {
+        return tile_[i];
+    }
+
+    bool has_kps(std::size_t i) const noexcept {
+        return has_kps_[i] != 0;
+    }
+
+    /** @brief Quad corners of detection @p i. */
+    std::array<cv::Point2f, 4> quad(std::size_t i) const noexcept {
+        return {cv::Point2f(x_[0][i], y_[0][i]), cv::Point2f(x_[1][i], y_[1][i]), cv::Point2f(x_[2][i], y_[2][i]),
+                cv::Point2f(x_[3][i], y_[3][i])};
+    }
+
+    /** @brief Cached AABB of detection @p i (may be non-finite for non-finite quads). */
+    AABB aabb(std::size_t i) const noexcept {
+        return {minx_[i], miny_[i], maxx_[i], maxy_[i]};
+    }
+
+    /** @brief Cached AABBs of all detections (valid until the next modification). */
+    AabbSoA aabbs() const noexcept {
+        return {minx_.data(), miny_.data(), maxx_.data(), maxy_.data()};
+    }
+
+    /** @brief Detection @p i in array-of-structures form. */
+    Detection get(std::size_t i) const noexcept;
+
+    /**
+     * @brief Writes all detections to @p out (cleared first, capacity reused).
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void export_to(std::vector<Detection>& out) const;
+
+  private:
+    std::array<std::vector<float>, 4> x_, y_;   ///< Quad corners by corner index
+    std::array<std::vector<float>, 5> kx_, ky_; ///< Landmarks by landmark index (moved only if @ref has_kps_)
+    std::vector<float> score_;
+    std::vector<int> tile_;
+    std::vector<std::uint8_t> has_kps_;
+    std::vector<float> minx_, miny_, maxx_, maxy_; ///< Cached AABB per detection
+    std::vector<std::uint8_t> mask_;               ///< Keep flags of @ref filter_min_size
+};
+
+} // namespace idet::algo
@@ -7,12 +7,18 @@
  * Implements:
  *  - order_quad(): robust canonical ordering TL,TR,BR,BL with fallbacks for degenerate input,
  *  - contour_score(): mean probability inside a contour using a masked ROI (thread_local buffers),
+ *  - contour_score_sigmoid(): same for logit maps, activating only the pixels under the mask,
+ *  - contour_score_scanline() / box_score(): mask-free scanline polygon fill summing the map directly
+ *    (CV_32F, or CV_8U probabilities quantized by algo::quantize_u8),
  *  - aabb_iou(): fast axis-aligned IoU approximation from quad extents,
- *  - quad_iou(): exact convex IoU via OpenCV (or AABB approximation when USE_FAST_IOU=1),
- *  - aspect_fit32(): aspect-ratio fit to a square side + 32-alignment.
+ *  - quad_iou(): exact convex IoU on stack arrays (hull + Sutherland-Hodgman clipping), or the
+ *    AABB approximation in fast mode,
+ *  - aspect_fit32(): aspect-ratio fit to a square side + 32-alignment,
+ *  - letterbox_fit() / letterbox_view() / pick_bucket(): aspect-preserving placement, its inverse on
+ *    output maps, and shape-bucket routing.
  *
  * Notes:
- *  - Exact quad_iou() relies on convex hulls; for invalid/degenerate inputs returns 0.
+ *  - Exact quad_iou() works on the convex hulls of the quads; for invalid/degenerate inputs returns 0.
  *  - Many routines include NaN/Inf guards to keep behavior deterministic in production.
  */
 
@@ -21,7 +27,11 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <utility>
+#include <vector>
 
 namespace idet::algo {
 
@@ -194,11 +204,19 @@ void order_quad(cv::Point2f quad[4]) noexcept {
     quad[3] = t[3];
 }
 
-float contour_score(const cv::Mat& prob, const std::vector<cv::Point>& contour) {
-    if (contour.empty()) return 0.f;
+namespace {
+
+/**
+ * @brief Rasterizes @p contour into a bbox-local mask (thread_local storage).
+ *
+ * @return Pointer to the filled mask, or null if the contour/bbox is empty. @p bbox receives the
+ *         contour bounding box clipped to @p cols x @p rows.
+ */
+const cv::Mat* contour_mask(int cols, int rows, const std::vector<cv::Point>& contour, cv::Rect& bbox) {
+    if (contour.empty()) return nullptr;
 
-    cv::Rect bbox = cv::boundingRect(contour) & cv::Rect(0, 0, prob.cols, prob.rows);
-    if (bbox.empty()) return 0.f;
+    bbox = cv::boundingRect(contour) & cv::Rect(0, 0, cols, rows);
+    if (bbox.empty()) return nullptr;
 
     thread_local cv::Mat mask;
     mask.create(bbox.size(), CV_8U);
@@ -225,9 +243,205 @@ float contour_score(const cv::Mat& prob, const std::vector<cv::Point>& contour)
     }
 
     cv::drawContours(mask, cnt, 0, cv::Scalar(255), cv::FILLED);
+    return &mask;
+}
+
+} // namespace
+
+float contour_score(const cv::Mat& prob, const std::vector<cv::Point>& contour) {
+    cv::Rect bbox;
+    const cv::Mat* mask = contour_mask(prob.cols, prob.rows, contour, bbox);
+    if (!mask) return 0.f;
+
     cv::Mat roi = prob(bbox);
-    cv::Scalar m = cv::mean(roi, mask);
-    return static_cast<float>(m[0]);
+    cv::Scalar m = cv::mean(roi, *mask);
+    const double scale = prob.depth() == CV_8U ? 1.0 / 255.0 : 1.0;
+    return static_cast<float>(m[0] * scale);
+}
+
+float contour_score_sigmoid(const cv::Mat& logits, const std::vector<cv::Point>& contour) {
+    cv::Rect bbox;
+    const cv::Mat* mask = contour_mask(logits.cols, logits.rows, contour, bbox);
+    if (!mask) return 0.f;
+
+    // Only masked pixels are activated; the rest of the map never goes through exp().
+    double sum = 0.0;
+    std::size_t cnt = 0;
+    for (int y = 0; y < bbox.height; ++y) {
+        const float* lr = logits.ptr<float>(bbox.y + y) + bbox.x;
+        const std::uint8_t* mr = mask->ptr<std::uint8_t>(y);
+        for (int x = 0; x < bbox.width; ++x) {
+            if (!mr[x]) continue;
+            sum += 1.0 / (1.0 + std::exp(-(double)lr[x]));
+            ++cnt;
+        }
+    }
+    return cnt ? static_cast<float>(sum / (double)cnt) : 0.f;
+}
+
+namespace {
+
+/// @brief Non-horizontal polygon edge, active for scanlines y in [y0, y1).
+struct ScanEdge {
+    float y0, y1, x0, dxdy;
+};
+
+/// @brief Horizontal edge or vertex lying on scanline y, covering [xa, xb].
+struct ScanFlat {
+    float y, xa, xb;
+};
+
+/// @brief Inclusive pixel span [x0, x1] on one row.
+struct ScanSpan {
+    int x0, x1;
+};
+
+inline float pt_x(const cv::Point& p) noexcept {
+    return (float)p.x;
+}
+inline float pt_y(const cv::Point& p) noexcept {
+    return (float)p.y;
+}
+inline float pt_x(const cv::Point2f& p) noexcept {
+    return p.x;
+}
+inline float pt_y(const cv::Point2f& p) noexcept {
+    return p.y;
+}
+
+/**
+ * @brief Mean of @p map over the polygon @p pts using an active-edge scanline fill.
+ *
+ * @details
+ * Rows are sampled at integer y (pixel centres). Crossings use the half-open rule [y0, y1), so
+ * every vertex is counted once and even-odd pairs are well-formed for concave polygons; rows
+ * that only touch the polygon (bottom row, horizontal edges, pointed vertices) are covered by
+ * @ref ScanFlat entries. Spans of one row are merged before summation, so no pixel counts twice.
+ */
+template <class Pt> float scanline_mean(const cv::Mat& map, const Pt* pts, std::size_t n, bool logits) {
+    if (!pts || n == 0 || map.empty()) return 0.f;
+    const bool u8 = map.depth() == CV_8U; // quantized probabilities (logits ignored)
+
+    constexpr float kEps = 1e-4f;
+    constexpr float kHalf = 0.5f; // pixels within half a pixel of an edge are inside (outline)
+
+    thread_local std::vector<ScanEdge> edges;
+    thread_local std::vector<ScanFlat> flats;
+    thread_local std::vector<const ScanEdge*> active;
+    thread_local std::vector<float> xs;
+    thread_local std::vector<ScanSpan> spans;
+    edges.clear();
+    flats.clear();
+    active.clear();
+
+    float miny = std::numeric_limits<float>::infinity();
+    float maxy = -std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < n; ++i) {
+        float ax = pt_x(pts[i]), ay = pt_y(pts[i]);
+        float bx = pt_x(pts[(i + 1) % n]), by = pt_y(pts[(i + 1) % n]);
+        if (!std::isfinite(ax) || !std::isfinite(ay) || !std::isfinite(bx) || !std::isfinite(by)) return 0.f;
+
+        miny = std::min(miny, ay);
+        maxy = std::max(maxy, ay);
+        flats.push_back({ay, ax, ax});
+
+        if (ay == by) {
+            flats.push_back({ay, std::min(ax, bx), std::max(ax, bx)});
+            continue;
+        }
+        if (ay > by) {
+            std::swap(ax, bx);
+            std::swap(ay, by);
+        }
+        edges.push_back({ay, by, ax, (bx - ax) / (by - ay)});
+    }
+
+    const int y_beg = std::max(0, (int)std::ceil(miny - kEps));
+    const int y_end = std::min(map.rows - 1, (int)std::floor(maxy + kEps));
+    if (y_beg > y_end) return 0.f;
+
+    std::sort(edges.begin(), edges.end(), [](const ScanEdge& a, const ScanEdge& b) { return a.y0 < b.y0; });
+    std::sort(flats.begin(), flats.end(), [](const ScanFlat& a, const ScanFlat& b) { return a.y < b.y; });
+
+    const int max_x = map.cols - 1;
+    auto push_span = [&](float xl, float xr) {
+        const int x0 = std::max(0, (int)std::ceil(xl - kHalf));
+        const int x1 = std::min(max_x, (int)std::floor(xr + kHalf));
+        if (x0 <= x1) spans.push_back({x0, x1});
+    };
+
+    double sum = 0.0;
+    std::size_t cnt = 0;
+    std::size_t next_edge = 0, next_flat = 0;
+
+    for (int y = y_beg; y <= y_end; ++y) {
+        const float fy = (float)y;
+
+        while (next_edge < edges.size() && edges[next_edge].y0 <= fy)
+            active.push_back(&edges[next_edge++]);
+        active.erase(std::remove_if(active.begin(), active.end(), [fy](const ScanEdge* e) { return e->y1 <= fy; }),
+                     active.end());
+
+        spans.clear();
+        xs.clear();
+        for (const ScanEdge* e : active)
+            xs.push_back(e->x0 + (fy - e->y0) * e->dxdy);
+        std::sort(xs.begin(), xs.end());
+        for (std::size_t k = 0; k + 1 < xs.size(); k += 2)
+            push_span(xs[k], xs[k + 1]);
+
+        while (next_flat < flats.size() && flats[next_flat].y < fy - kEps)
+            ++next_flat;
+        for (std::size_t k = next_flat; k < flats.size() && flats[k].y <= fy + kEps; ++k)
+            push_span(flats[k].xa, flats[k].xb);
+
+        if (spans.empty()) continue;
+        std::sort(spans.begin(), spans.end(), [](const ScanSpan& a, const ScanSpan& b) { return a.x0 < b.x0; });
+
+        const float* row = u8 ? nullptr : map.ptr<float>(y);
+        const std::uint8_t* qrow = u8 ? map.ptr<std::uint8_t>(y) : nullptr;
+        int run0 = spans[0].x0, run1 = spans[0].x1;
+        auto flush = [&]() {
+            if (u8) {
+                std::uint32_t acc = 0; // 255 * cols fits easily
+                for (int x = run0; x <= run1; ++x)
+                    acc += qrow[x];
+                sum += (double)acc;
+            } else if (logits) {
+                for (int x = run0; x <= run1; ++x)
+                    sum += 1.0 / (1.0 + std::exp(-(double)row[x]));
+            } else {
+                float acc = 0.f;
+                for (int x = run0; x <= run1; ++x)
+                    acc += row[x];
+                sum += (double)acc;
+            }
+            cnt += (std::size_t)(run1 - run0 + 1);
+        };
+        for (std::size_t k = 1; k < spans.size(); ++k) {
+            if (spans[k].x0 <= run1 + 1) {
+                run1 = std::max(run1, spans[k].x1);
+                continue;
+            }
+            flush();
+            run0 = spans[k].x0;
+            run1 = spans[k].x1;
+        }
+        flush();
+    }
+
+    if (u8) sum *= 1.0 / 255.0;
+    return cnt ? static_cast<float>(sum / (double)cnt) : 0.f;
+}
+
+} // namespace
+
+float contour_score_scanline(const cv::Mat& map, const std::vector<cv::Point>& contour, bool logits) {
+    return scanline_mean(map, contour.data(), contour.size(), logits);
+}
+
+float box_score(const cv::Mat& map, const std::array<cv::Point2f, 4>& quad, bool logits) {
+    return scanline_mean(map, quad.data(), quad.size(), logits);
 }
 
 float aabb_iou(const std::array<cv::Point2f, 4>& A, const std::array<cv::Point2f, 4>& B) {
@@ -272,50 +486,121 @@ float aabb_iou(const std::array<cv::Point2f, 4>& A, const std::array<cv::Point2f
     return iou;
 }
 
-float quad_iou(const std::array<cv::Point2f, 4>& A, const std::array<cv::Point2f, 4>& B, bool use_fast_iou) {
-    if (use_fast_iou) return aabb_iou(A, B);
+namespace {
 
-    auto is_finite = [](const cv::Point2f& p) noexcept { return std::isfinite(p.x) && std::isfinite(p.y); };
+/** @brief Cross product of (a - o) and (b - o), in double for robustness on large coordinates. */
+inline double cross3(const cv::Point2f& o, const cv::Point2f& a, const cv::Point2f& b) noexcept {
+    return ((double)a.x - o.x) * ((double)b.y - o.y) - ((double)a.y - o.y) * ((double)b.x - o.x);
+}
 
-    for (int i = 0; i < 4; ++i) {
-        if (!is_finite(A[i]) || !is_finite(B[i])) return 0.f;
+/** @brief Absolute shoelace area of a polygon with @p n vertices. */
+inline double poly_area(const cv::Point2f* p, int n) noexcept {
+    double s = 0.0;
+    for (int i = 0, j = n - 1; i < n; j = i++)
+        s += (double)p[j].x * p[i].y - (double)p[i].x * p[j].y;
+    return std::fabs(0.5 * s);
+}
+
+/**
+ * @brief Convex hull of 4 points (Andrew's monotone chain), counter-clockwise in math orientation.
+ *
+ * @param q Input points in any order.
+ * @param hull Output vertices (at most 4).
+ * @return Number of hull vertices (< 3 for degenerate input).
+ */
+int convex_hull4(const std::array<cv::Point2f, 4>& q, cv::Point2f hull[4]) noexcept {
+    cv::Point2f p[4] = {q[0], q[1], q[2], q[3]};
+    std::sort(p, p + 4,
+              [](const cv::Point2f& a, const cv::Point2f& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+
+    cv::Point2f h[8];
+    int k = 0;
+    for (int i = 0; i < 4; ++i) { // lower chain
+        while (k >= 2 && cross3(h[k - 2], h[k - 1], p[i]) <= 0.0)
+            --k;
+        h[k++] = p[i];
+    }
+    for (int i = 2, t = k + 1; i >= 0; --i) { // upper chain
+        while (k >= t && cross3(h[k - 2], h[k - 1], p[i]) <= 0.0)
+            --k;
+        h[k++] = p[i];
     }
 
-    // Reuse buffers to avoid allocations in NMS loops
-    thread_local std::vector<cv::Point2f> pts;
-    thread_local std::vector<cv::Point2f> a, b, inter;
+    const int n = std::min(4, k - 1); // last point repeats the first
+    for (int i = 0; i < n; ++i)
+        hull[i] = h[i];
+    return n;
+}
+
+/**
+ * @brief Area of the intersection of two convex counter-clockwise polygons (Sutherland-Hodgman).
+ *
+ * @details
+ * Clips @p a by every edge of @p b. Each clip adds at most one vertex, so 4-gons never exceed
+ * 8 vertices and fixed stack buffers suffice. Nested polygons need no special case.
+ */
+double convex_intersection_area(const cv::Point2f* a, int na, const cv::Point2f* b, int nb) noexcept {
+    constexpr int kMax = 12;
+    cv::Point2f buf0[kMax], buf1[kMax];
+    cv::Point2f* cur = buf0;
+    cv::Point2f* nxt = buf1;
+
+    int n = na;
+    for (int i = 0; i < na; ++i)
+        cur[i] = a[i];
+
+    for (int e = 0; e < nb && n > 0; ++e) {
+        const cv::Point2f& c0 = b[e];
+        const cv::Point2f& c1 = b[(e + 1) % nb];
+
+        int m = 0;
+        for (int i = 0; i < n; ++i) {
+            const cv::Point2f& s = cur[i];
+            const cv::Point2f& t = cur[(i + 1) % n];
+            const double ds = cross3(c0, c1, s);
+            const double dt = cross3(c0, c1, t);
+
+            if (ds >= 0.0 && m < kMax) nxt[m++] = s;
+            if ((ds >= 0.0) != (dt >= 0.0) && m < kMax) {
+                const double r = ds / (ds - dt);
+                nxt[m++] = cv::Point2f((float)(s.x + r * ((double)t.x - s.x)), (float)(s.y + r * ((double)t.y - s.y)));
+            }
+        }
+        std::swap(cur, nxt);
+        n = m;
+    }
 
-    auto make_hull = [&](const std::array<cv::Point2f, 4>& q, std::vector<cv::Point2f>& hull) -> bool {
-        pts.assign(q.begin(), q.end());
-        hull.clear();
-        hull.reserve(4);
+    return n >= 3 ? poly_area(cur, n) : 0.0;
+}
 
-        cv::convexHull(pts, hull, /*clockwise=*/true, /*returnPoints=*/true);
+} // namespace
 
-        if (hull.size() < 3) return false;
-        const double area = std::abs(cv::contourArea(hull));
-        return area > 1e-9;
-    };
+float quad_iou(const std::array<cv::Point2f, 4>& A, const std::array<cv::Point2f, 4>& B, bool use_fast_iou) {
+    if (use_fast_iou) return aabb_iou(A, B);
 
-    if (!make_hull(A, a) || !make_hull(B, b)) return 0.f;
+    auto is_finite = [](const cv::Point2f& p) noexcept { return std::isfinite(p.x) && std::isfinite(p.y); };
 
-    inter.clear();
-    inter.reserve(8);
+    for (int i = 0; i < 4; ++i) {
+        if (!is_finite(A[i]) || !is_finite(B[i])) return 0.f;
+    }
 
-    float inter_area = (float)cv::intersectConvexConvex(a, b, inter, /*handleNested=*/true);
-    if (!(inter_area > 0.f) || !std::isfinite(inter_area)) return 0.f;
+    cv::Point2f a[4], b[4];
+    const int na = convex_hull4(A, a);
+    const int nb = convex_hull4(B, b);
+    if (na < 3 || nb < 3) return 0.f;
 
-    const float areaA = (float)std::abs(cv::contourArea(a));
-    const float areaB = (float)std::abs(cv::contourArea(b));
-    if (!(areaA > 0.f) || !(areaB > 0.f)) return 0.f;
+    const double areaA = poly_area(a, na);
+    const double areaB = poly_area(b, nb);
+    if (!(areaA > 1e-9) || !(areaB > 1e-9)) return 0.f;
 
-    const float cap = std::min(areaA, areaB);
-    if (inter_area > cap) inter_area = cap;
+    double inter_area = convex_intersection_area(a, na, b, nb);
+    if (!(inter_area > 0.0) || !std::isfinite(inter_area)) return 0.f;
+    inter_area = std::min(inter_area, std::min(areaA, areaB));
 
-    const float uni = areaA + areaB - inter_area;
-    if (!(uni > 1e-12f) || !std::isfinite(uni)) return 0.f;
+    const double uni = areaA + areaB - inter_area;
+    if (!(uni > 1e-12) || !std::isfinite(uni)) return 0.f;
 
-    float iou = inter_area / uni;
+    float iou = (float)(inter_area / uni);
     if (!std::isfinite(iou)) return 0.f;
 
     if (iou < 0.f) iou = 0.f;
@@ -347,4 +632,50 @@ std::pair<int, int> aspect_fit32(const int iw, const int ih, const int side) {
     return {nw, nh};
 }
 
+LetterboxFit letterbox_fit(int iw, int ih, int canvas_w, int canvas_h, int max_side) noexcept {
+    if (iw <= 0 || ih <= 0 || canvas_w <= 0 || canvas_h <= 0) return {};
+
+    double s = 1.0;
+    const int m = std::max(iw, ih);
+    if (max_side > 0 && m > max_side) s = (double)max_side / (double)m;
+    s = std::min(s, std::min((double)canvas_w / (double)iw, (double)canvas_h / (double)ih));
+
+    LetterboxFit f;
+    f.w = std::min(canvas_w, std::max(1, (int)std::lround((double)iw * s)));
+    f.h = std::min(canvas_h, std::max(1, (int)std::lround((double)ih * s)));
+    return f;
+}
+
+LetterboxView letterbox_view(int map_w, int map_h, int in_w, int in_h, int content_w, int content_h, int orig_w,
+                             int orig_h) noexcept {
+    const float fx = (float)map_w / (float)in_w;
+    const float fy = (float)map_h / (float)in_h;
+
+    LetterboxView v;
+    v.w = std::min(map_w, std::max(1, (int)std::ceil(content_w * fx)));
+    v.h = std::min(map_h, std::max(1, (int)std::ceil(content_h * fy)));
+    v.sx = (float)orig_w / ((float)content_w * fx);
+    v.sy = (float)orig_h / ((float)content_h * fy);
+    return v;
+}
+
+int pick_bucket(const std::vector<std::pair<int, int>>& buckets, int iw, int ih, int max_side) noexcept {
+    int best = -1;
+    long long best_content = -1;
+    long long best_canvas = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        const auto& b = buckets[i];
+        const LetterboxFit f = letterbox_fit(iw, ih, b.first, b.second, max_side);
+        const long long content = (long long)f.w * (long long)f.h;
+        const long long canvas = (long long)b.first * (long long)b.second;
+        if (content <= 0) continue;
+        if (content > best_content || (content == best_content && canvas < best_canvas)) {
+            best = (int)i;
+            best_content = content;
+            best_canvas = canvas;
+        }
+    }
+    return best;
+}
+
 } // namespace idet::algo
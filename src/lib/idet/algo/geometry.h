@@ -6,9 +6,10 @@
  * @details
  * This header defines the common geometric primitives used across detectors and post-processing:
  * - canonical quadrilateral ordering (TL,TR,BR,BL),
- * - contour scoring over a probability map (DBNet-style),
+ * - contour scoring over a probability map (DBNet-style): masked, scanline and box modes,
  * - quad IoU (exact convex polygon IoU or a fast AABB approximation),
- * - aspect-ratio preserving fit-to-square with stride alignment (e.g. 32).
+ * - aspect-ratio preserving fit-to-square with stride alignment (e.g. 32),
+ * - letterbox placement into fixed input shapes and routing of frames to the best shape bucket.
  */
 
 #pragma once
@@ -51,6 +52,20 @@ struct Detection {
      * - SCRFD: usually a face classification score.
      */
     float score = 0.0f;
+
+    /**
+     * @brief Optional 5-point landmarks in image coordinates (valid if @ref has_kps).
+     *
+     * @details
+     * SCRFD `*_kps` exports: left eye, right eye, nose, left mouth corner, right mouth corner.
+     */
+    std::array<cv::Point2f, 5> kps{};
+
+    /** @brief Whether @ref kps holds decoded landmarks. */
+    bool has_kps = false;
+
+    /** @brief Index of the source tile in tiled inference; -1 for single-pass inference. */
+    int tile = -1;
 };
 
 /**
@@ -71,7 +86,7 @@ void order_quad(cv::Point2f quad[4]) noexcept;
  * Computes an average value of @p prob inside the polygon represented by @p contour.
  * This is typically used for DBNet-style scoring of connected components on a probmap.
  *
- * @param prob Single-channel probability map (CV_32F).
+ * @param prob Single-channel probability map (CV_32F, or CV_8U holding `255 * p`).
  * @param contour Contour points in prob coordinates.
  * @return Mean value of prob inside contour; returns 0 if contour/bbox invalid.
  *
@@ -79,13 +94,59 @@ void order_quad(cv::Point2f quad[4]) noexcept;
  */
 float contour_score(const cv::Mat& prob, const std::vector<cv::Point>& contour);
 
+/**
+ * @brief Compute mean sigmoid-activated probability inside a contour of a logit map.
+ *
+ * @details
+ * Equivalent to @ref contour_score on @c sigmoid(logits), but the sigmoid is evaluated only for
+ * pixels inside the contour, so a full activated copy of the map is never needed.
+ *
+ * @param logits Single-channel logit map (CV_32F).
+ * @param contour Contour points in map coordinates.
+ * @return Mean of sigmoid(logits) inside contour; returns 0 if contour/bbox invalid.
+ */
+float contour_score_sigmoid(const cv::Mat& logits, const std::vector<cv::Point>& contour);
+
+/**
+ * @brief Compute mean probability inside a contour without rasterizing a mask.
+ *
+ * @details
+ * Scanline polygon fill: for every row of the contour bbox the even-odd spans are derived from
+ * the contour edges (active edge list) and the map is summed directly over those spans.
+ * Pixels whose centre lies within half a pixel of an edge are included, which approximates the
+ * outline that @c cv::drawContours adds to the filled polygon; the result therefore deviates
+ * slightly from @ref contour_score on slanted edges.
+ *
+ * @param map Single-channel probability or logit map (CV_32F), or CV_8U probabilities holding `255 * p`.
+ * @param contour Contour points in map coordinates.
+ * @param logits If true, @p map holds logits and the sigmoid is applied to summed pixels only (CV_32F only).
+ * @return Mean value inside contour; returns 0 if contour/bbox invalid.
+ *
+ * @note Uses thread_local buffers for edge/span storage.
+ */
+float contour_score_scanline(const cv::Mat& map, const std::vector<cv::Point>& contour, bool logits = false);
+
+/**
+ * @brief Compute mean probability inside a (rotated) quadrilateral, e.g. a contour's min-area rect.
+ *
+ * @details
+ * Equivalent to PaddleOCR's "fast" box score: the contour is replaced by its 4-point box, which
+ * is scanline-filled like @ref contour_score_scanline.
+ *
+ * @param map Single-channel probability or logit map (CV_32F), or CV_8U probabilities holding `255 * p`.
+ * @param quad Box corners in map coordinates (boundary order, CW or CCW).
+ * @param logits If true, @p map holds logits and the sigmoid is applied to summed pixels only (CV_32F only).
+ * @return Mean value inside @p quad; returns 0 if the box does not intersect the map.
+ */
+float box_score(const cv::Mat& map, const std::array<cv::Point2f, 4>& quad, bool logits = false);
+
 /**
  * @brief IoU of two quadrilaterals.
  *
  * @details
- * Exact mode uses @c cv::intersectConvexConvex and requires:
- *  - both quads are convex,
- *  - point order describes the polygon boundary (CW/CCW).
+ * Exact mode intersects the convex hulls of both quads analytically (Sutherland-Hodgman on
+ * fixed-size stack arrays, no OpenCV calls or allocations), so point order does not matter;
+ * non-convex quads are treated as their hulls.
  *
  * If @p use_fast_iou is true, falls back to AABB IoU approximation via @ref aabb_iou.
  *
@@ -135,4 +196,79 @@ float aabb_iou(const std::array<cv::Point2f, 4>& A, const std::array<cv::Point2f
  */
 std::pair<int, int> aspect_fit32(const int iw, const int ih, const int side);
 
+/**
+ * @brief Aspect-preserving placement of an image in the top-left corner of a fixed input canvas.
+ *
+ * @details
+ * The image is scaled by one factor on both axes; the rest of the canvas is padding. Mapping a
+ * canvas coordinate back to the image divides by @c w/iw (resp. @c h/ih).
+ */
+struct LetterboxFit {
+    int w = 0; ///< Content width in canvas pixels (<= canvas width)
+    int h = 0; ///< Content height in canvas pixels (<= canvas height)
+};
+
+/**
+ * @brief Letterbox an @p iw x @p ih image into a @p canvas_w x @p canvas_h canvas.
+ *
+ * @details
+ * The scale is the largest one that fits the canvas, but never larger than the scale an unbound
+ * run would use (longest side clamped to @p max_side, no upscaling), so a large canvas does not
+ * blow small images up.
+ *
+ * @param iw Image width (> 0).
+ * @param ih Image height (> 0).
+ * @param canvas_w Canvas width (> 0).
+ * @param canvas_h Canvas height (> 0).
+ * @param max_side Longest-side limit of the image after scaling; <= 0 disables the limit.
+ * @return Content size, or {0,0} on invalid input.
+ */
+LetterboxFit letterbox_fit(int iw, int ih, int canvas_w, int canvas_h, int max_side) noexcept;
+
+/**
+ * @brief Part of a network output map that covers the letterboxed content, and its scale to the image.
+ */
+struct LetterboxView {
+    int w = 0;      ///< Map columns covering the content (top-left aligned, <= map width)
+    int h = 0;      ///< Map rows covering the content (top-left aligned, <= map height)
+    float sx = 1.f; ///< Map x to image x (multiply)
+    float sy = 1.f; ///< Map y to image y (multiply)
+};
+
+/**
+ * @brief Un-letterbox a @p map_w x @p map_h output map of an @p in_w x @p in_h input.
+ *
+ * @details
+ * The content occupies the top-left @p content_w x @p content_h input pixels, so the map is
+ * cropped to the rows/columns touching it (rounded up) and its coordinates are scaled by
+ * @c orig/content on each axis. Without letterboxing (content == input) the whole map is kept.
+ *
+ * @param map_w Output map width (> 0).
+ * @param map_h Output map height (> 0).
+ * @param in_w Network input width (> 0).
+ * @param in_h Network input height (> 0).
+ * @param content_w Image width inside the input (> 0).
+ * @param content_h Image height inside the input (> 0).
+ * @param orig_w Original image width.
+ * @param orig_h Original image height.
+ */
+LetterboxView letterbox_view(int map_w, int map_h, int in_w, int in_h, int content_w, int content_h, int orig_w,
+                             int orig_h) noexcept;
+
+/**
+ * @brief Select the canvas (bucket) that keeps the most image pixels for an @p iw x @p ih frame.
+ *
+ * @details
+ * Every bucket is scored by the content area of @ref letterbox_fit; ties (typically several
+ * buckets holding the frame at full resolution) go to the smallest canvas, i.e. the least
+ * padding and compute.
+ *
+ * @param buckets Candidate canvases as {width, height}.
+ * @param iw Frame width.
+ * @param ih Frame height.
+ * @param max_side Same limit as in @ref letterbox_fit.
+ * @return Index into @p buckets, or -1 if @p buckets is empty or the frame is empty.
+ */
+int pick_bucket(const std::vector<std::pair<int, int>>& buckets, int iw, int ih, int max_side) noexcept;
+
 } // namespace idet::algo
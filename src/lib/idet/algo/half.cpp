@@ -0,0 +1,195 @@
+/**
+ * @file half.cpp
+ * @ingroup idet_algo
+ * @brief Implementation of the float32 <-> binary16 conversion kernels.
+ *
+ * @details
+ * The scalar conversion works on the bit patterns (no reliance on a compiler @c _Float16).
+ * x86-64 kernels use the 8-wide F16C VCVTPS2PH / VCVTPH2PS via function-level target attributes
+ * for both the AVX2 and AVX-512 levels (the conversion is bound by memory bandwidth, not width);
+ * F16C itself is checked once at runtime.
+ */
+
+#include "algo/half.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define IDET_HALF_X86 1
+    #include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    #define IDET_HALF_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace idet::algo {
+
+std::uint16_t f32_to_f16_bits(float f) noexcept {
+    std::uint32_t x = 0;
+    std::memcpy(&x, &f, sizeof(x));
+    const std::uint16_t sign = (std::uint16_t)((x >> 16) & 0x8000u);
+    x &= 0x7fffffffu;
+
+    if (x > 0x7f800000u) return (std::uint16_t)(sign | 0x7e00u | ((x & 0x007fffffu) >> 13)); // quiet NaN
+    if (x == 0x7f800000u) return (std::uint16_t)(sign | 0x7c00u);
+    if (x >= 0x477ff000u) return (std::uint16_t)(sign | 0x7c00u); // rounds above 65504
+
+    if (x < 0x38800000u) { // below 2^-14: subnormal half or zero
+        if (x <= 0x33000000u) return sign;
+        const std::uint32_t m = (x & 0x007fffffu) | 0x00800000u;
+        const int shift = 126 - (int)(x >> 23);
+        std::uint32_t h = m >> shift;
+        const std::uint32_t rem = m & ((1u << shift) - 1u);
+        const std::uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (h & 1u))) ++h;
+        return (std::uint16_t)(sign | h);
+    }
+
+    std::uint32_t h = (x - 0x38000000u) >> 13;
+    const std::uint32_t rem = x & 0x1fffu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) ++h; // a carry into the exponent is correct
+    return (std::uint16_t)(sign | h);
+}
+
+float f16_bits_to_f32(std::uint16_t h) noexcept {
+    const std::uint32_t sign = (std::uint32_t)(h & 0x8000u) << 16;
+    std::uint32_t exp = (h >> 10) & 0x1fu;
+    std::uint32_t mant = h & 0x3ffu;
+
+    std::uint32_t x = 0;
+    if (exp == 0x1fu) {
+        x = sign | 0x7f800000u | (mant << 13) | (mant ? 0x00400000u : 0u); // NaN comes out quiet
+    } else if (exp != 0) {
+        x = sign | ((exp + 112u) << 23) | (mant << 13);
+    } else if (mant == 0) {
+        x = sign;
+    } else {
+        exp = 113;
+        while (!(mant & 0x400u)) {
+            mant <<= 1;
+            --exp;
+        }
+        x = sign | (exp << 23) | ((mant & 0x3ffu) << 13);
+    }
+
+    float f = 0.0f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+namespace {
+
+using ToHalfFn = void (*)(const float*, std::uint16_t*, std::size_t);
+using FromHalfFn = void (*)(const std::uint16_t*, float*, std::size_t);
+
+void to_half_scalar(const float* src, std::uint16_t* dst, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] = f32_to_f16_bits(src[i]);
+}
+
+void from_half_scalar(const std::uint16_t* src, float* dst, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] = f16_bits_to_f32(src[i]);
+}
+
+#if defined(IDET_HALF_X86)
+
+bool has_f16c() noexcept {
+    static const bool f16c = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("f16c") != 0;
+    }();
+    return f16c;
+}
+
+__attribute__((target("avx2,f16c"))) void to_half_f16c(const float* src, std::uint16_t* dst, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+    to_half_scalar(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx2,f16c"))) void from_half_f16c(const std::uint16_t* src, float* dst, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    from_half_scalar(src + i, dst + i, n - i);
+}
+
+#endif // IDET_HALF_X86
+
+#if defined(IDET_HALF_NEON)
+
+void to_half_neon(const float* src, std::uint16_t* dst, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    to_half_scalar(src + i, dst + i, n - i);
+}
+
+void from_half_neon(const std::uint16_t* src, float* dst, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+    from_half_scalar(src + i, dst + i, n - i);
+}
+
+#endif // IDET_HALF_NEON
+
+SimdLevel effective_level(SimdLevel level) noexcept {
+    if (!simd_level_supported(level)) level = best_simd_level();
+#if defined(IDET_HALF_X86)
+    if ((level == SimdLevel::AVX2 || level == SimdLevel::AVX512) && !has_f16c()) level = SimdLevel::Scalar;
+#endif
+    return level;
+}
+
+ToHalfFn to_half_fn_for(SimdLevel level) noexcept {
+    switch (effective_level(level)) {
+#if defined(IDET_HALF_X86)
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:
+        return &to_half_f16c;
+#endif
+#if defined(IDET_HALF_NEON)
+    case SimdLevel::NEON:
+        return &to_half_neon;
+#endif
+    default:
+        return &to_half_scalar;
+    }
+}
+
+FromHalfFn from_half_fn_for(SimdLevel level) noexcept {
+    switch (effective_level(level)) {
+#if defined(IDET_HALF_X86)
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:
+        return &from_half_f16c;
+#endif
+#if defined(IDET_HALF_NEON)
+    case SimdLevel::NEON:
+        return &from_half_neon;
+#endif
+    default:
+        return &from_half_scalar;
+    }
+}
+
+} // namespace
+
+void f32_to_f16(const float* src, std::uint16_t* dst, std::size_t n, SimdLevel level) noexcept {
+    if (!src || !dst || n == 0) return;
+    to_half_fn_for(level)(src, dst, n);
+}
+
+void f16_to_f32(const std::uint16_t* src, float* dst, std::size_t n, SimdLevel level) noexcept {
+    if (!src || !dst || n == 0) return;
+    from_half_fn_for(level)(src, dst, n);
+}
+
+} // namespace idet::algo
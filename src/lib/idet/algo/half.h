@@ -0,0 +1,46 @@
+/**
+ * @file half.h
+ * @ingroup idet_algo
+ * @brief float32 <-> IEEE 754 binary16 (FP16) buffer conversion.
+ *
+ * @details
+ * Engines keep their preprocessing and decoding buffers in float32. For models whose inputs or
+ * outputs are float16 (FP16 exports, typical on ARM) the bound and unbound paths convert the
+ * tensor once per run with these kernels instead of templating the whole pipeline on the
+ * element type.
+ *
+ * Rounding is round-to-nearest-even; overflow saturates to infinity, NaN stays NaN. The SIMD
+ * paths (F16C on x86-64, NEON on AArch64) are selected with the same @ref SimdLevel dispatch as
+ * @ref preprocess.h and are bit-exact with the scalar path.
+ */
+
+#pragma once
+
+#include "algo/preprocess.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace idet::algo {
+
+/** @brief Bits of the binary16 value nearest to @p f (round-to-nearest-even). */
+std::uint16_t f32_to_f16_bits(float f) noexcept;
+
+/** @brief float32 value of the binary16 bit pattern @p h (exact). */
+float f16_bits_to_f32(std::uint16_t h) noexcept;
+
+/**
+ * @brief Converts @p n float32 values into binary16 bit patterns.
+ *
+ * @param level Requested SIMD level; falls back to the best supported one.
+ */
+void f32_to_f16(const float* src, std::uint16_t* dst, std::size_t n, SimdLevel level = best_simd_level()) noexcept;
+
+/**
+ * @brief Converts @p n binary16 bit patterns into float32 values.
+ *
+ * @param level Requested SIMD level; falls back to the best supported one.
+ */
+void f16_to_f32(const std::uint16_t* src, float* dst, std::size_t n, SimdLevel level = best_simd_level()) noexcept;
+
+} // namespace idet::algo
@@ -7,17 +7,30 @@
  * Implements score-sorted greedy NMS for @ref idet::algo::Detection using @ref idet::algo::quad_iou.
  *
  * Performance notes:
- *  - Uses AABB overlap as a cheap reject test before computing polygon IoU.
+ *  - Uses AABB IoU as a cheap reject test before computing polygon IoU; in fast mode it is the IoU.
+ *  - Grid cells store their boxes in SoA layout, so the AABB IoU of one kept box against a cell is
+ *    a single @ref idet::algo::aabb_iou_batch call (AVX2 / AVX-512 / NEON, runtime-dispatched).
  *  - Optionally enables a uniform grid acceleration structure to reduce candidate comparisons.
  *    The grid is disabled automatically if the number of grid cells exceeds a safety limit.
+ *  - Sorting, ranking and the grid are shared by @ref idet::algo::nms_poly and
+ *    @ref idet::algo::NmsWorkspace; the workspace additionally splits the boxes into overlap
+ *    clusters that are independent of each other (parallel runs, Soft-NMS).
  *
  * Output:
  *  - Returns detections in descending score order (processing order after sorting).
+ *
+ * Memory:
+ *  - All temporaries come from a @ref idet::algo::FrameArena; the vector-returning overload uses
+ *    a local arena, the arena overload is allocation-free once the arena and output are warm.
  */
 
 #include "algo/nms.h"
+#include "algo/detection_buffer.h"
+#include "platform/thread_pool.h"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cmath>
 #include <cstdint>
 #include <limits>
@@ -25,8 +38,145 @@
 #include <utility>
 #include <vector>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define IDET_NMS_X86 1
+    #include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    #define IDET_NMS_NEON 1
+    #include <arm_neon.h>
+#endif
+
 namespace idet::algo {
 
+namespace {
+
+using AabbIouBatchFn = void (*)(const AABB& a, const AabbSoA& c, std::size_t n, float* iou);
+
+inline float aabb_iou_one(const AABB& a, float area_a, float x0, float y0, float x1, float y1) noexcept {
+    const float area_b = std::max(0.f, x1 - x0) * std::max(0.f, y1 - y0);
+    const float iw = std::max(0.f, std::min(a.maxx, x1) - std::max(a.minx, x0));
+    const float ih = std::max(0.f, std::min(a.maxy, y1) - std::max(a.miny, y0));
+    const float inter = iw * ih;
+    const float denom = (area_a + area_b) - inter;
+    if (!(denom > 1e-6f)) return 0.f;
+    return std::min(1.f, std::max(0.f, inter / denom));
+}
+
+inline float area_of(const AABB& a) noexcept {
+    return std::max(0.f, a.maxx - a.minx) * std::max(0.f, a.maxy - a.miny);
+}
+
+void aabb_iou_batch_scalar(const AABB& a, const AabbSoA& c, std::size_t n, float* iou) {
+    const float area_a = area_of(a);
+    for (std::size_t k = 0; k < n; ++k)
+        iou[k] = aabb_iou_one(a, area_a, c.minx[k], c.miny[k], c.maxx[k], c.maxy[k]);
+}
+
+#if defined(IDET_NMS_X86)
+
+__attribute__((target("avx2"))) void aabb_iou_batch_avx2(const AABB& a, const AabbSoA& c, std::size_t n,
+                                                         float* iou) {
+    const float area_a = area_of(a);
+    const __m256 ax0 = _mm256_set1_ps(a.minx), ay0 = _mm256_set1_ps(a.miny);
+    const __m256 ax1 = _mm256_set1_ps(a.maxx), ay1 = _mm256_set1_ps(a.maxy);
+    const __m256 va = _mm256_set1_ps(area_a);
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.f), eps = _mm256_set1_ps(1e-6f);
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        const __m256 x0 = _mm256_loadu_ps(c.minx + k), y0 = _mm256_loadu_ps(c.miny + k);
+        const __m256 x1 = _mm256_loadu_ps(c.maxx + k), y1 = _mm256_loadu_ps(c.maxy + k);
+        const __m256 vb = _mm256_mul_ps(_mm256_max_ps(zero, _mm256_sub_ps(x1, x0)),
+                                        _mm256_max_ps(zero, _mm256_sub_ps(y1, y0)));
+        const __m256 iw = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(ax1, x1), _mm256_max_ps(ax0, x0)));
+        const __m256 ih = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(ay1, y1), _mm256_max_ps(ay0, y0)));
+        const __m256 inter = _mm256_mul_ps(iw, ih);
+        const __m256 denom = _mm256_sub_ps(_mm256_add_ps(va, vb), inter);
+        const __m256 ok = _mm256_cmp_ps(denom, eps, _CMP_GT_OQ);
+        const __m256 r = _mm256_min_ps(one, _mm256_max_ps(zero, _mm256_div_ps(inter, denom)));
+        _mm256_storeu_ps(iou + k, _mm256_and_ps(ok, r));
+    }
+    for (; k < n; ++k)
+        iou[k] = aabb_iou_one(a, area_a, c.minx[k], c.miny[k], c.maxx[k], c.maxy[k]);
+}
+
+__attribute__((target("avx512f"))) void aabb_iou_batch_avx512(const AABB& a, const AabbSoA& c, std::size_t n,
+                                                              float* iou) {
+    const float area_a = area_of(a);
+    const __m512 ax0 = _mm512_set1_ps(a.minx), ay0 = _mm512_set1_ps(a.miny);
+    const __m512 ax1 = _mm512_set1_ps(a.maxx), ay1 = _mm512_set1_ps(a.maxy);
+    const __m512 va = _mm512_set1_ps(area_a);
+    const __m512 zero = _mm512_setzero_ps(), one = _mm512_set1_ps(1.f), eps = _mm512_set1_ps(1e-6f);
+    for (std::size_t k = 0; k < n; k += 16) {
+        const std::size_t left = n - k;
+        const __mmask16 m = left >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (unsigned)left) - 1u);
+        const __m512 x0 = _mm512_maskz_loadu_ps(m, c.minx + k), y0 = _mm512_maskz_loadu_ps(m, c.miny + k);
+        const __m512 x1 = _mm512_maskz_loadu_ps(m, c.maxx + k), y1 = _mm512_maskz_loadu_ps(m, c.maxy + k);
+        const __m512 vb = _mm512_mul_ps(_mm512_max_ps(zero, _mm512_sub_ps(x1, x0)),
+                                        _mm512_max_ps(zero, _mm512_sub_ps(y1, y0)));
+        const __m512 iw = _mm512_max_ps(zero, _mm512_sub_ps(_mm512_min_ps(ax1, x1), _mm512_max_ps(ax0, x0)));
+        const __m512 ih = _mm512_max_ps(zero, _mm512_sub_ps(_mm512_min_ps(ay1, y1), _mm512_max_ps(ay0, y0)));
+        const __m512 inter = _mm512_mul_ps(iw, ih);
+        const __m512 denom = _mm512_sub_ps(_mm512_add_ps(va, vb), inter);
+        const __mmask16 ok = _mm512_mask_cmp_ps_mask(m, denom, eps, _CMP_GT_OQ);
+        const __m512 r = _mm512_min_ps(one, _mm512_max_ps(zero, _mm512_div_ps(inter, denom)));
+        _mm512_mask_storeu_ps(iou + k, m, _mm512_maskz_mov_ps(ok, r));
+    }
+}
+
+#endif // IDET_NMS_X86
+
+#if defined(IDET_NMS_NEON)
+
+void aabb_iou_batch_neon(const AABB& a, const AabbSoA& c, std::size_t n, float* iou) {
+    const float area_a = area_of(a);
+    const float32x4_t ax0 = vdupq_n_f32(a.minx), ay0 = vdupq_n_f32(a.miny);
+    const float32x4_t ax1 = vdupq_n_f32(a.maxx), ay1 = vdupq_n_f32(a.maxy);
+    const float32x4_t va = vdupq_n_f32(area_a);
+    const float32x4_t zero = vdupq_n_f32(0.f), one = vdupq_n_f32(1.f), eps = vdupq_n_f32(1e-6f);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        const float32x4_t x0 = vld1q_f32(c.minx + k), y0 = vld1q_f32(c.miny + k);
+        const float32x4_t x1 = vld1q_f32(c.maxx + k), y1 = vld1q_f32(c.maxy + k);
+        const float32x4_t vb = vmulq_f32(vmaxq_f32(zero, vsubq_f32(x1, x0)), vmaxq_f32(zero, vsubq_f32(y1, y0)));
+        const float32x4_t iw = vmaxq_f32(zero, vsubq_f32(vminq_f32(ax1, x1), vmaxq_f32(ax0, x0)));
+        const float32x4_t ih = vmaxq_f32(zero, vsubq_f32(vminq_f32(ay1, y1), vmaxq_f32(ay0, y0)));
+        const float32x4_t inter = vmulq_f32(iw, ih);
+        const float32x4_t denom = vsubq_f32(vaddq_f32(va, vb), inter);
+        const uint32x4_t ok = vcgtq_f32(denom, eps);
+        const float32x4_t r = vminq_f32(one, vmaxq_f32(zero, vdivq_f32(inter, denom)));
+        vst1q_f32(iou + k, vreinterpretq_f32_u32(vandq_u32(ok, vreinterpretq_u32_f32(r))));
+    }
+    for (; k < n; ++k)
+        iou[k] = aabb_iou_one(a, area_a, c.minx[k], c.miny[k], c.maxx[k], c.maxy[k]);
+}
+
+#endif // IDET_NMS_NEON
+
+AabbIouBatchFn aabb_iou_batch_fn_for(SimdLevel level) noexcept {
+    switch (simd_level_supported(level) ? level : best_simd_level()) {
+#if defined(IDET_NMS_X86)
+    case SimdLevel::AVX512:
+        return &aabb_iou_batch_avx512;
+    case SimdLevel::AVX2:
+        return &aabb_iou_batch_avx2;
+#endif
+#if defined(IDET_NMS_NEON)
+    case SimdLevel::NEON:
+        return &aabb_iou_batch_neon;
+#endif
+    default:
+        return &aabb_iou_batch_scalar;
+    }
+}
+
+} // namespace
+
+void aabb_iou_batch(const AABB& a, const AabbSoA& c, std::size_t n, float* iou, SimdLevel level) noexcept {
+    aabb_iou_batch_fn_for(level)(a, c, n, iou);
+}
+
 /**
  * @brief Computes an axis-aligned bounding box (AABB) of a quadrilateral detection.
  *
@@ -48,6 +198,13 @@ static inline algo::AABB aabb_of(const algo::Detection& d) noexcept {
     return {minx, miny, maxx, maxy};
 }
 
+/** @brief @p b with non-finite boxes mapped to an empty box (their IoU is 0, as in @ref aabb_iou). */
+static inline algo::AABB finite_aabb(const algo::AABB& b) noexcept {
+    if (!std::isfinite(b.minx) || !std::isfinite(b.miny) || !std::isfinite(b.maxx) || !std::isfinite(b.maxy))
+        return {0.f, 0.f, 0.f, 0.f};
+    return b;
+}
+
 /**
  * @brief Checks whether two AABBs overlap (non-empty intersection test).
  *
@@ -72,7 +229,7 @@ static inline bool aabb_overlap(const algo::AABB& a, const algo::AABB& b) noexce
  * - Suppress any lower-ranked detections whose IoU with the kept detection is >= @p iou_thr_in.
  *
  * Performance optimizations:
- * - Uses AABB overlap as a cheap pre-filter before calling @ref quad_iou.
+ * - Uses AABB IoU (batched per grid cell, SIMD) as a cheap pre-filter before calling @ref quad_iou.
  * - Uses a uniform grid acceleration for candidate enumeration (CSR layout).
  *   This avoids allocating millions of small vectors.
  * - Uses a stamp + @c seen array to avoid processing the same candidate multiple times
@@ -88,44 +245,118 @@ static inline bool aabb_overlap(const algo::AABB& a, const algo::AABB& b) noexce
  * @return A filtered subset of @p dets after NMS, in descending score order.
  */
 std::vector<algo::Detection> nms_poly(const std::vector<algo::Detection>& dets, float iou_thr_in, bool use_fast_iou) {
-    const int N = (int)dets.size();
-    if (N == 0) return {};
+    std::vector<algo::Detection> out;
+    if (dets.empty()) return out;
 
-    float iou_thr = iou_thr_in;
+    FrameArena arena;
+    nms_poly(dets, iou_thr_in, use_fast_iou, arena, out);
+    return out;
+}
 
-    // Threshold <= 0: disable suppression, just return detections sorted by score.
-    if (iou_thr <= 0.0f) {
-        std::vector<int> order(N);
-        std::iota(order.begin(), order.end(), 0);
-        std::sort(order.begin(), order.end(), [&](int a, int b) { return dets[a].score > dets[b].score; });
+namespace {
 
-        std::vector<Detection> out;
-        out.reserve((std::size_t)N);
-        for (int i : order)
-            out.push_back(dets[i]);
-        return out;
+/**
+ * @brief Detection access of the NMS passes over a @c std::vector<Detection>.
+ *
+ * @details
+ * The passes are templates over this interface (@c size, @c score, @c quad, @c box) so they run
+ * unchanged on @ref DetectionBuffer, whose boxes are cached instead of recomputed.
+ */
+struct VecSource {
+    const std::vector<algo::Detection>& d;
+
+    std::size_t size() const noexcept {
+        return d.size();
+    }
+    float score(int i) const noexcept {
+        return d[(std::size_t)i].score;
+    }
+    const std::array<cv::Point2f, 4>& quad(int i) const noexcept {
+        return d[(std::size_t)i].pts;
     }
+    algo::AABB box(int i) const noexcept {
+        return finite_aabb(aabb_of(d[(std::size_t)i]));
+    }
+};
 
-    // Threshold >= 1: only keep the best element (since IoU is in [0,1]).
-    if (iou_thr >= 1.0f) {
-        int best = 0;
-        for (int i = 1; i < N; ++i)
-            if (dets[i].score > dets[best].score) best = i;
-        return {dets[best]};
+/** @brief @ref VecSource over the columns of a @ref DetectionBuffer. */
+struct BufferSource {
+    const DetectionBuffer& b;
+
+    std::size_t size() const noexcept {
+        return b.size();
+    }
+    float score(int i) const noexcept {
+        return b.score((std::size_t)i);
+    }
+    std::array<cv::Point2f, 4> quad(int i) const noexcept {
+        return b.quad((std::size_t)i);
     }
+    algo::AABB box(int i) const noexcept {
+        return finite_aabb(b.aabb((std::size_t)i));
+    }
+};
+
+/**
+ * @brief Score order, AABBs and the CSR grid of one NMS call (all storage from the arena).
+ *
+ * @details
+ * Cells store the indices of the boxes overlapping them with a copy of the boxes next to them
+ * (SoA), so one box is tested against a whole cell with a single batched IoU call. The grid is
+ * skipped when its cell count would exceed a safety limit (extreme coordinate spans).
+ */
+struct Prepared {
+    int N = 0;
+    int* order = nullptr; ///< Processing permutation (descending score)
+    int* rank = nullptr;  ///< Position of each detection in @ref order
+    float *bx0 = nullptr, *by0 = nullptr, *bx1 = nullptr, *by1 = nullptr;
+
+    bool use_grid = false;
+    int cell = 64, nx = 1, ny = 1;
+    float ox = 0.f, oy = 0.f;
+    std::uint32_t* offsets = nullptr; ///< offsets[c]..offsets[c+1]: items of cell c
+    int* items = nullptr;
+    float *ix0 = nullptr, *iy0 = nullptr, *ix1 = nullptr, *iy1 = nullptr;
+    std::uint32_t max_cell = 1; ///< Largest cell (size of a per-thread IoU buffer)
+
+    algo::AABB box(int i) const noexcept {
+        return {bx0[i], by0[i], bx1[i], by1[i]};
+    }
+
+    std::size_t cell_id(int x, int y) const noexcept {
+        return (std::size_t)y * (std::size_t)nx + (std::size_t)x;
+    }
+
+    /// @brief Inclusive cell range covered by @p b.
+    void cells_of(const algo::AABB& b, int& x0, int& x1, int& y0, int& y1) const noexcept {
+        x0 = std::clamp((int)std::floor((b.minx - ox) / (float)cell), 0, nx - 1);
+        x1 = std::clamp((int)std::floor((b.maxx - ox) / (float)cell), 0, nx - 1);
+        y0 = std::clamp((int)std::floor((b.miny - oy) / (float)cell), 0, ny - 1);
+        y1 = std::clamp((int)std::floor((b.maxy - oy) / (float)cell), 0, ny - 1);
+    }
+};
+
+/// @brief Sorts, ranks and boxes @p dets; builds the grid when @p grid is set.
+template <class Src> Prepared prepare(const Src& dets, FrameArena& arena, bool grid) {
+    Prepared g;
+    const int N = (int)dets.size();
+    g.N = N;
 
-    // Sort detections by descending score; order[] is the processing permutation.
-    std::vector<int> order(N);
-    std::iota(order.begin(), order.end(), 0);
-    std::sort(order.begin(), order.end(), [&](int a, int b) { return dets[a].score > dets[b].score; });
+    g.order = arena.alloc<int>((std::size_t)N);
+    std::iota(g.order, g.order + N, 0);
+    std::sort(g.order, g.order + N, [&](int a, int b) { return dets.score(a) > dets.score(b); });
 
     // rank[idx] gives the position in the sorted order, used to enforce "only suppress lower-ranked".
-    std::vector<int> rank(N, 0);
+    g.rank = arena.alloc<int>((std::size_t)N);
     for (int p = 0; p < N; ++p)
-        rank[order[p]] = p;
+        g.rank[g.order[p]] = p;
+    if (!grid) return g;
 
-    // Precompute AABBs and stats for grid sizing.
-    std::vector<algo::AABB> boxes((std::size_t)N);
+    // Precompute AABBs (SoA, so candidate blocks can be tested with SIMD) and stats for grid sizing.
+    g.bx0 = arena.alloc<float>((std::size_t)N);
+    g.by0 = arena.alloc<float>((std::size_t)N);
+    g.bx1 = arena.alloc<float>((std::size_t)N);
+    g.by1 = arena.alloc<float>((std::size_t)N);
 
     float minx = std::numeric_limits<float>::infinity();
     float miny = std::numeric_limits<float>::infinity();
@@ -136,25 +367,29 @@ std::vector<algo::Detection> nms_poly(const std::vector<algo::Detection>& dets,
     float mean_h = 0.f;
 
     for (int i = 0; i < N; ++i) {
-        boxes[(std::size_t)i] = aabb_of(dets[(std::size_t)i]);
-
-        minx = std::min(minx, boxes[(std::size_t)i].minx);
-        miny = std::min(miny, boxes[(std::size_t)i].miny);
-        maxx = std::max(maxx, boxes[(std::size_t)i].maxx);
-        maxy = std::max(maxy, boxes[(std::size_t)i].maxy);
-
-        mean_w += std::max(1.f, boxes[(std::size_t)i].maxx - boxes[(std::size_t)i].minx);
-        mean_h += std::max(1.f, boxes[(std::size_t)i].maxy - boxes[(std::size_t)i].miny);
+        const algo::AABB b = dets.box(i);
+        g.bx0[i] = b.minx;
+        g.by0[i] = b.miny;
+        g.bx1[i] = b.maxx;
+        g.by1[i] = b.maxy;
+
+        minx = std::min(minx, b.minx);
+        miny = std::min(miny, b.miny);
+        maxx = std::max(maxx, b.maxx);
+        maxy = std::max(maxy, b.maxy);
+
+        mean_w += std::max(1.f, b.maxx - b.minx);
+        mean_h += std::max(1.f, b.maxy - b.miny);
     }
     mean_w /= (float)N;
     mean_h /= (float)N;
 
     // Shift grid origin to (minx, miny) to handle potential negative coords safely.
-    const float ox = std::isfinite(minx) ? minx : 0.f;
-    const float oy = std::isfinite(miny) ? miny : 0.f;
+    g.ox = std::isfinite(minx) ? minx : 0.f;
+    g.oy = std::isfinite(miny) ? miny : 0.f;
 
-    const float span_x = std::max(1.f, maxx - ox);
-    const float span_y = std::max(1.f, maxy - oy);
+    const float span_x = std::max(1.f, maxx - g.ox);
+    const float span_y = std::max(1.f, maxy - g.oy);
 
     /**
      * Choose a uniform grid cell size based on average box size.
@@ -172,141 +407,517 @@ std::vector<algo::Detection> nms_poly(const std::vector<algo::Detection>& dets,
         cell = 128;
     else
         cell = 256;
+    g.cell = cell;
 
-    const int nx = std::max(1, (int)std::floor(span_x / (float)cell) + 1);
-    const int ny = std::max(1, (int)std::floor(span_y / (float)cell) + 1);
+    g.nx = std::max(1, (int)std::floor(span_x / (float)cell) + 1);
+    g.ny = std::max(1, (int)std::floor(span_y / (float)cell) + 1);
 
-    const std::size_t grid_cells = (std::size_t)nx * (std::size_t)ny;
+    const std::size_t grid_cells = (std::size_t)g.nx * (std::size_t)g.ny;
 
     // Safety: CSR arrays are cheap-ish, but still cap in extreme cases.
-    // (You can tune this threshold; CSR is far lighter than vector-of-vectors.)
-    const bool use_grid = (grid_cells <= 2'000'000ULL);
+    g.use_grid = (grid_cells <= 2'000'000ULL);
+    if (!g.use_grid) return g;
 
-    // CSR grid storage:
-    // offsets[c]..offsets[c+1] is a list of detection indices whose AABB overlaps cell c.
-    std::vector<std::uint32_t> offsets;
-    std::vector<std::uint32_t> cursor;
-    std::vector<int> items;
+    std::uint32_t* counts = arena.alloc_fill<std::uint32_t>(grid_cells, 0u);
 
-    auto cell_id = [&](int x, int y) noexcept -> std::size_t {
-        return (std::size_t)y * (std::size_t)nx + (std::size_t)x;
-    };
+    // Pass 1: count insertions per cell.
+    for (int i = 0; i < N; ++i) {
+        int x0, x1, y0, y1;
+        g.cells_of(g.box(i), x0, x1, y0, y1);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                counts[g.cell_id(x, y)] += 1;
+    }
 
-    if (use_grid) {
-        std::vector<std::uint32_t> counts(grid_cells, 0);
+    // Prefix sum -> offsets
+    g.offsets = arena.alloc<std::uint32_t>(grid_cells + 1);
+    g.offsets[0] = 0;
+    for (std::size_t c = 0; c < grid_cells; ++c) {
+        g.offsets[c + 1] = g.offsets[c] + counts[c];
+        g.max_cell = std::max(g.max_cell, counts[c]);
+    }
 
-        // Pass 1: count insertions per cell.
-        for (int i = 0; i < N; ++i) {
-            const algo::AABB& a = boxes[(std::size_t)i];
+    // Allocate flat items; counts are no longer needed and serve as the fill cursor.
+    const std::size_t n_items = (std::size_t)g.offsets[grid_cells];
+    g.items = arena.alloc<int>(n_items);
+    g.ix0 = arena.alloc<float>(n_items);
+    g.iy0 = arena.alloc<float>(n_items);
+    g.ix1 = arena.alloc<float>(n_items);
+    g.iy1 = arena.alloc<float>(n_items);
+    std::uint32_t* cursor = counts;
+    std::copy(g.offsets, g.offsets + grid_cells, cursor);
+
+    // Pass 2: fill items.
+    for (int i = 0; i < N; ++i) {
+        int x0, x1, y0, y1;
+        g.cells_of(g.box(i), x0, x1, y0, y1);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                const std::uint32_t pos = cursor[g.cell_id(x, y)]++;
+                g.items[(std::size_t)pos] = i;
+                g.ix0[pos] = g.bx0[i];
+                g.iy0[pos] = g.by0[i];
+                g.ix1[pos] = g.bx1[i];
+                g.iy1[pos] = g.by1[i];
+            }
+        }
+    }
+    return g;
+}
 
-            const int x0 = std::clamp((int)std::floor((a.minx - ox) / (float)cell), 0, nx - 1);
-            const int x1 = std::clamp((int)std::floor((a.maxx - ox) / (float)cell), 0, nx - 1);
-            const int y0 = std::clamp((int)std::floor((a.miny - oy) / (float)cell), 0, ny - 1);
-            const int y1 = std::clamp((int)std::floor((a.maxy - oy) / (float)cell), 0, ny - 1);
+/**
+ * @brief Calls @p f(j, box_iou) once for every box j != @p i whose AABB IoU with box @p i is positive.
+ *
+ * @details
+ * @p seen must hold no entry equal to @p stamp; it receives @p stamp for every visited j.
+ * @p ious needs @c g.max_cell entries. Without a grid all boxes are scanned.
+ */
+template <class F>
+void for_each_overlap(const Prepared& g, int i, AabbIouBatchFn batch_iou, float* ious, int* seen, int stamp, F&& f) {
+    const algo::AABB ai = g.box(i);
+    if (!g.use_grid) {
+        for (int j = 0; j < g.N; ++j) {
+            if (j == i) continue;
+            const algo::AABB bj = g.box(j);
+            if (!aabb_overlap(ai, bj)) continue;
+            float box_iou = 0.f;
+            batch_iou(ai, AabbSoA{&bj.minx, &bj.miny, &bj.maxx, &bj.maxy}, 1, &box_iou);
+            if (box_iou > 0.f) f(j, box_iou);
+        }
+        return;
+    }
 
-            for (int y = y0; y <= y1; ++y) {
-                for (int x = x0; x <= x1; ++x) {
-                    const std::size_t id = cell_id(x, y);
-                    counts[id] += 1;
-                }
+    // Grid-based candidate enumeration: only scan cells overlapped by the box.
+    int x0, x1, y0, y1;
+    g.cells_of(ai, x0, x1, y0, y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            const std::size_t id = g.cell_id(x, y);
+            const std::uint32_t beg = g.offsets[id];
+            const std::uint32_t end = g.offsets[id + 1];
+            if (beg == end) continue;
+
+            // One box against the whole cell block.
+            batch_iou(ai, AabbSoA{g.ix0 + beg, g.iy0 + beg, g.ix1 + beg, g.iy1 + beg}, (std::size_t)(end - beg),
+                      ious);
+
+            for (std::uint32_t k = beg; k < end; ++k) {
+                const float box_iou = ious[k - beg];
+                if (!(box_iou > 0.f)) continue;
+                const int j = g.items[(std::size_t)k];
+                if (j == i || seen[j] == stamp) continue;
+                seen[j] = stamp;
+                f(j, box_iou);
             }
         }
+    }
+}
 
-        // Prefix sum -> offsets
-        offsets.resize(grid_cells + 1);
-        offsets[0] = 0;
-        for (std::size_t c = 0; c < grid_cells; ++c) {
-            offsets[c + 1] = offsets[c] + counts[c];
-        }
+/// @brief Score-weighted corner sums of the boxes suppressed by a kept box (@ref NmsMethod::Weighted).
+struct MergeAcc {
+    float w;
+    float x[4], y[4];
+};
 
-        // Allocate flat items and make a cursor copy.
-        items.resize((std::size_t)offsets.back());
-        cursor = offsets; // cursor will be incremented while filling
+/**
+ * @brief Greedy suppression over @p members (indices in descending score order).
+ *
+ * @details
+ * Marks kept boxes in @p kept and suppressed ones in @p suppressed. Only strictly lower-ranked
+ * boxes are suppressed, so running this per cluster gives the same result as one run over all
+ * boxes. Stamps are the ranks, hence unique per call and per cluster.
+ *
+ * @tparam kFast AABB IoU (final) instead of polygon IoU (AABB pre-check only).
+ * @tparam kMerge Accumulate suppressed boxes into @p acc (indexed by the keeping box).
+ */
+template <bool kFast, bool kMerge, class Src>
+void greedy(const Src& dets, const Prepared& g, const int* members, int m, float iou_thr, AabbIouBatchFn batch_iou,
+            float* ious, int* seen, std::uint8_t* suppressed, std::uint8_t* kept, MergeAcc* acc) {
+    for (int q = 0; q < m; ++q) {
+        const int i = members[q];
+        if (suppressed[(std::size_t)i]) continue;
+        kept[(std::size_t)i] = 1;
 
-        // Pass 2: fill items.
-        for (int i = 0; i < N; ++i) {
-            const algo::AABB& a = boxes[(std::size_t)i];
-
-            const int x0 = std::clamp((int)std::floor((a.minx - ox) / (float)cell), 0, nx - 1);
-            const int x1 = std::clamp((int)std::floor((a.maxx - ox) / (float)cell), 0, nx - 1);
-            const int y0 = std::clamp((int)std::floor((a.miny - oy) / (float)cell), 0, ny - 1);
-            const int y1 = std::clamp((int)std::floor((a.maxy - oy) / (float)cell), 0, ny - 1);
-
-            for (int y = y0; y <= y1; ++y) {
-                for (int x = x0; x <= x1; ++x) {
-                    const std::size_t id = cell_id(x, y);
-                    const std::uint32_t pos = cursor[id]++;
-                    items[(std::size_t)pos] = i;
+        MergeAcc* a = nullptr;
+        if constexpr (kMerge) {
+            a = &acc[i];
+            *a = MergeAcc{};
+        }
+
+        for_each_overlap(g, i, batch_iou, ious, seen, g.rank[i] + 1, [&](int j, float box_iou) {
+            if (suppressed[(std::size_t)j]) return;
+            // Only suppress strictly lower-ranked detections.
+            if (g.rank[j] <= g.rank[i]) return;
+
+            // box_iou is the AABB IoU of (i, j): final in fast mode, an overlap pre-check otherwise.
+            float iou = box_iou;
+            if constexpr (!kFast) iou = quad_iou(dets.quad(i), dets.quad(j));
+            if (iou < iou_thr) return;
+            suppressed[(std::size_t)j] = 1;
+
+            if constexpr (kMerge) {
+                const float w = std::max(0.f, dets.score(j));
+                const auto& qj = dets.quad(j);
+                a->w += w;
+                for (int k = 0; k < 4; ++k) {
+                    a->x[k] += w * qj[(std::size_t)k].x;
+                    a->y[k] += w * qj[(std::size_t)k].y;
                 }
             }
+        });
+    }
+}
+
+/**
+ * @brief Indexed max-heap of detections by current score (ties: lower rank first).
+ *
+ * @details
+ * Soft-NMS only ever lowers scores, so a decayed entry is restored by sifting it down. Storage
+ * is caller-provided (@c heap: one slot per cluster member, @c pos: one per detection).
+ */
+struct ScoreHeap {
+    int* heap;
+    int* pos;
+    const float* cur;
+    const int* rank;
+    int size;
+
+    bool better(int a, int b) const noexcept {
+        return cur[a] > cur[b] || (cur[a] == cur[b] && rank[a] < rank[b]);
+    }
+
+    void sift_down(int k) noexcept {
+        const int x = heap[k];
+        for (;;) {
+            int c = 2 * k + 1;
+            if (c >= size) break;
+            if (c + 1 < size && better(heap[c + 1], heap[c])) ++c;
+            if (!better(heap[c], x)) break;
+            heap[k] = heap[c];
+            pos[heap[k]] = k;
+            k = c;
         }
+        heap[k] = x;
+        pos[x] = k;
+    }
+
+    void build() noexcept {
+        for (int k = 0; k < size; ++k)
+            pos[heap[k]] = k;
+        for (int k = size / 2 - 1; k >= 0; --k)
+            sift_down(k);
+    }
+
+    int pop() noexcept {
+        const int top = heap[0];
+        heap[0] = heap[--size];
+        if (size > 0) sift_down(0);
+        return top;
+    }
+};
+
+/**
+ * @brief Soft-NMS over one cluster (@p members: its detections, @p heap: @p m free slots).
+ *
+ * @details
+ * Repeatedly keeps the best remaining box and decays the scores of the remaining boxes that
+ * overlap it; boxes decayed below @c p.min_score are dropped. Overlaps come from the grid, so a
+ * step costs its neighbours plus a heap update each instead of a pass over the cluster.
+ */
+template <class Src>
+void soft_cluster(const Src& dets, const Prepared& g, const int* members, int m, const NmsParams& p,
+                  AabbIouBatchFn batch_iou, float* ious, int* seen, float* cur, int* heap, int* pos, std::uint8_t* done,
+                  std::uint8_t* kept) {
+    const bool linear = p.method == NmsMethod::Linear;
+    const float inv_sigma = 1.0f / std::max(1e-6f, p.sigma);
+    for (int q = 0; q < m; ++q) {
+        cur[members[q]] = dets.score(members[q]);
+        heap[q] = members[q];
+    }
+    ScoreHeap h{heap, pos, cur, g.rank, m};
+    h.build();
+
+    while (h.size > 0) {
+        const int i = h.pop();
+        if (!(cur[i] >= p.min_score)) break; // every remaining score is lower
+        done[(std::size_t)i] = 1;
+        kept[(std::size_t)i] = 1;
+
+        for_each_overlap(g, i, batch_iou, ious, seen, g.rank[i] + 1, [&](int j, float box_iou) {
+            if (done[(std::size_t)j]) return;
+            const float iou = p.use_fast_iou ? box_iou : quad_iou(dets.quad(i), dets.quad(j));
+            float s = cur[j];
+            if (linear) {
+                if (iou >= p.iou_thr) s *= 1.0f - iou;
+            } else {
+                s *= std::exp(-iou * iou * inv_sigma);
+            }
+            if (s == cur[j]) return;
+            cur[j] = s;
+            h.sift_down(pos[j]);
+        });
+    }
+}
+
+int find_root(int* parent, int x) noexcept {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * @brief Body of @ref nms_poly, instantiated per IoU mode so the candidate loop does not branch on it.
+ *
+ * @tparam kFast AABB IoU (final) instead of polygon IoU (AABB pre-check only).
+ */
+template <bool kFast>
+void nms_poly_impl(const std::vector<algo::Detection>& dets, float iou_thr, FrameArena& arena,
+                   std::vector<algo::Detection>& out) {
+    const int N = (int)dets.size();
+    const Prepared g = prepare(VecSource{dets}, arena, /*grid=*/iou_thr > 0.0f);
+
+    // Threshold <= 0: disable suppression, just return detections sorted by score.
+    if (iou_thr <= 0.0f) {
+        out.reserve((std::size_t)N);
+        for (int p = 0; p < N; ++p)
+            out.push_back(dets[(std::size_t)g.order[p]]);
+        return;
     }
 
-    std::vector<std::uint8_t> suppressed((std::size_t)N, 0);
-    std::vector<algo::Detection> keep;
-    keep.reserve((std::size_t)N);
+    std::uint8_t* suppressed = arena.alloc_fill<std::uint8_t>((std::size_t)N, 0);
+    std::uint8_t* kept = arena.alloc_fill<std::uint8_t>((std::size_t)N, 0);
+    int* seen = arena.alloc_fill<int>((std::size_t)N, 0);
+    float* ious = arena.alloc<float>((std::size_t)g.max_cell);
 
-    // "Seen" marker array to avoid duplicates when scanning multiple cells.
-    std::vector<int> seen(N, -1);
-    int stamp = 0;
+    greedy<kFast, false>(VecSource{dets}, g, g.order, N, iou_thr, aabb_iou_batch_fn_for(best_simd_level()), ious, seen,
+                         suppressed, kept, nullptr);
 
+    out.reserve((std::size_t)N);
     for (int p = 0; p < N; ++p) {
-        const int i = order[p];
-        if (suppressed[(std::size_t)i]) continue;
+        const int i = g.order[p];
+        if (kept[(std::size_t)i]) out.push_back(dets[(std::size_t)i]);
+    }
+}
 
-        keep.push_back(dets[(std::size_t)i]);
-        const algo::AABB& ai = boxes[(std::size_t)i];
+/// @brief Index of the best-scoring detection (first on ties).
+template <class Src> int best_index(const Src& dets) noexcept {
+    int best = 0;
+    for (int i = 1; i < (int)dets.size(); ++i)
+        if (dets.score(i) > dets.score(best)) best = i;
+    return best;
+}
 
-        ++stamp;
+} // namespace
 
-        auto process_j = [&](int j) {
-            if (j == i) return;
-            if (suppressed[(std::size_t)j]) return;
+void nms_poly(const std::vector<algo::Detection>& dets, float iou_thr_in, bool use_fast_iou, FrameArena& arena,
+              std::vector<algo::Detection>& out) {
+    out.clear();
+    if (dets.empty()) return;
 
-            // Only suppress strictly lower-ranked detections.
-            if (rank[j] <= rank[i]) return;
+    // Threshold >= 1: only keep the best element (since IoU is in [0,1]).
+    if (iou_thr_in >= 1.0f) {
+        out.push_back(dets[(std::size_t)best_index(VecSource{dets})]);
+        return;
+    }
 
-            // Cheap reject via AABB overlap.
-            if (!aabb_overlap(ai, boxes[(std::size_t)j])) return;
+    if (use_fast_iou)
+        nms_poly_impl<true>(dets, iou_thr_in, arena, out);
+    else
+        nms_poly_impl<false>(dets, iou_thr_in, arena, out);
+}
 
-            // Accurate overlap test via quad IoU (or fast AABB IoU).
-            const float iou = quad_iou(dets[(std::size_t)i].pts, dets[(std::size_t)j].pts, use_fast_iou);
-            if (iou >= iou_thr) suppressed[(std::size_t)j] = 1;
-        };
+/**
+ * @brief Runs the selected method, clustering first when it runs in parallel or is a Soft-NMS.
+ *
+ * @details
+ * Clusters are the connected components of the positive-AABB-overlap graph (union-find over one
+ * overlap scan), with members listed in global score order. Blocks of clusters go to pool
+ * threads; every array written inside the region is indexed by detection or by worker, so the
+ * threads never share a slot.
+ */
+template <class Src> const std::vector<int>& NmsWorkspace::run_(const Src& dets, const NmsParams& p) {
+    arena_.reset();
+    keep_.clear();
+    score_.clear();
+    merged_.clear();
+    clusters_ = 0;
+    weighted_ = p.method == NmsMethod::Weighted;
 
-        if (!use_grid) {
-            // Fallback: scan remaining detections in score order.
-            for (int q = p + 1; q < N; ++q) {
-                const int j = order[q];
-                if (suppressed[(std::size_t)j]) continue;
-                if (!aabb_overlap(ai, boxes[(std::size_t)j])) continue;
-                process_j(j);
-            }
-            continue;
+    const int N = (int)dets.size();
+    if (N == 0) return keep_;
+
+    const bool soft = p.method == NmsMethod::Linear || p.method == NmsMethod::Gaussian;
+    if (!soft && p.iou_thr >= 1.0f) {
+        keep_.push_back(best_index(dets));
+        score_.push_back(dets.score(keep_[0]));
+        if (weighted_) merged_.push_back(dets.quad(keep_[0]));
+        return keep_;
+    }
+
+    const bool suppress = soft || p.iou_thr > 0.0f;
+    const Prepared g = prepare(dets, arena_, suppress);
+    keep_.reserve((std::size_t)N);
+    score_.reserve((std::size_t)N);
+
+    if (!suppress) {
+        for (int q = 0; q < N; ++q) {
+            keep_.push_back(g.order[q]);
+            score_.push_back(dets.score(g.order[q]));
         }
+        if (weighted_)
+            for (int i : keep_)
+                merged_.push_back(dets.quad(i));
+        return keep_;
+    }
 
-        // Grid-based candidate enumeration: only scan cells overlapped by current AABB.
-        const int x0 = std::clamp((int)std::floor((ai.minx - ox) / (float)cell), 0, nx - 1);
-        const int x1 = std::clamp((int)std::floor((ai.maxx - ox) / (float)cell), 0, nx - 1);
-        const int y0 = std::clamp((int)std::floor((ai.miny - oy) / (float)cell), 0, ny - 1);
-        const int y1 = std::clamp((int)std::floor((ai.maxy - oy) / (float)cell), 0, ny - 1);
+    std::uint8_t* kept = arena_.alloc_fill<std::uint8_t>((std::size_t)N, 0);
+    std::uint8_t* suppressed = arena_.alloc_fill<std::uint8_t>((std::size_t)N, 0);
+    int* seen = arena_.alloc_fill<int>((std::size_t)N, 0);
+    MergeAcc* acc = weighted_ ? arena_.alloc<MergeAcc>((std::size_t)N) : nullptr;
+    float* cur = soft ? arena_.alloc<float>((std::size_t)N) : nullptr;
+    const AabbIouBatchFn batch_iou = aabb_iou_batch_fn_for(best_simd_level());
+
+    auto run_greedy = [&](const int* members, int m, float* ious) {
+        if (p.use_fast_iou) {
+            if (weighted_)
+                greedy<true, true>(dets, g, members, m, p.iou_thr, batch_iou, ious, seen, suppressed, kept, acc);
+            else
+                greedy<true, false>(dets, g, members, m, p.iou_thr, batch_iou, ious, seen, suppressed, kept, acc);
+        } else {
+            if (weighted_)
+                greedy<false, true>(dets, g, members, m, p.iou_thr, batch_iou, ious, seen, suppressed, kept, acc);
+            else
+                greedy<false, false>(dets, g, members, m, p.iou_thr, batch_iou, ious, seen, suppressed, kept, acc);
+        }
+    };
 
-        for (int y = y0; y <= y1; ++y) {
-            for (int x = x0; x <= x1; ++x) {
-                const std::size_t id = cell_id(x, y);
-                const std::uint32_t beg = offsets[id];
-                const std::uint32_t end = offsets[id + 1];
-                for (std::uint32_t k = beg; k < end; ++k) {
-                    const int j = items[(std::size_t)k];
-                    if (seen[j] == stamp) continue;
-                    seen[j] = stamp;
-                    process_j(j);
-                }
+    const int threads = std::max(1, p.threads);
+    if (!soft && threads == 1) {
+        float* ious = arena_.alloc<float>((std::size_t)g.max_cell);
+        run_greedy(g.order, N, ious);
+    } else {
+        // Union-find over positive AABB overlaps; `seen` is reset afterwards for the greedy stamps.
+        int* parent = arena_.alloc<int>((std::size_t)N);
+        std::iota(parent, parent + N, 0);
+        float* ious = arena_.alloc<float>((std::size_t)g.max_cell * (std::size_t)threads);
+        for (int i = 0; i < N; ++i) {
+            for_each_overlap(g, i, batch_iou, ious, seen, i + 1, [&](int j, float) {
+                const int a = find_root(parent, i), b = find_root(parent, j);
+                if (a != b) parent[std::max(a, b)] = std::min(a, b);
+            });
+        }
+        std::fill(seen, seen + N, 0);
+
+        // Cluster ids in order of first appearance by score; members CSR in score order.
+        int* cid = arena_.alloc_fill<int>((std::size_t)N, -1);
+        int* start = arena_.alloc_fill<int>((std::size_t)N + 1, 0);
+        int nc = 0;
+        for (int q = 0; q < N; ++q) {
+            const int r = find_root(parent, g.order[q]);
+            if (cid[r] < 0) cid[r] = nc++;
+            ++start[cid[r] + 1];
+        }
+        for (int c = 0; c < nc; ++c)
+            start[c + 1] += start[c];
+        int* members = arena_.alloc<int>((std::size_t)N);
+        int* fill = arena_.alloc<int>((std::size_t)nc);
+        std::copy(start, start + nc, fill);
+        for (int q = 0; q < N; ++q) {
+            const int i = g.order[q];
+            members[fill[cid[find_root(parent, i)]]++] = i;
+        }
+        clusters_ = (std::size_t)nc;
+        int* heap = soft ? arena_.alloc<int>((std::size_t)N) : nullptr; // per-cluster slices, like members
+        int* pos = soft ? arena_.alloc<int>((std::size_t)N) : nullptr;
+
+        auto run_cluster = [&](int c, int worker) {
+            int* mem = members + start[c];
+            const int m = start[c + 1] - start[c];
+            if (m == 1) {
+                const int i = mem[0];
+                if (soft) cur[i] = dets.score(i);
+                if (!soft || cur[i] >= p.min_score) kept[(std::size_t)i] = 1;
+                if (weighted_) acc[i] = MergeAcc{};
+                return;
+            }
+            float* wious = ious + (std::size_t)worker * g.max_cell;
+            if (soft)
+                soft_cluster(dets, g, mem, m, p, batch_iou, wious, seen, cur, heap + start[c], pos, suppressed, kept);
+            else
+                run_greedy(mem, m, wious);
+        };
+
+        constexpr int kBlock = 64; // clusters per index: most clusters are single boxes
+        const int blocks = (nc + kBlock - 1) / kBlock;
+        auto body = [&](int b, int worker) {
+            const int end = std::min(nc, (b + 1) * kBlock);
+            for (int c = b * kBlock; c < end; ++c)
+                run_cluster(c, worker);
+        };
+        if (threads > 1 && blocks > 1)
+            platform::ThreadPool::current().parallel_for(blocks, threads, body);
+        else
+            for (int b = 0; b < blocks; ++b)
+                body(b, 0);
+    }
+
+    for (int q = 0; q < N; ++q) {
+        const int i = g.order[q];
+        if (kept[(std::size_t)i]) keep_.push_back(i);
+    }
+    if (soft) {
+        // Decayed scores reorder the kept boxes; ties keep the initial order.
+        std::sort(keep_.begin(), keep_.end(),
+                  [&](int a, int b) { return cur[a] > cur[b] || (cur[a] == cur[b] && g.rank[a] < g.rank[b]); });
+    }
+    for (int i : keep_)
+        score_.push_back(soft ? cur[i] : dets.score(i));
+
+    if (weighted_) {
+        merged_.reserve(keep_.size());
+        for (int i : keep_) {
+            std::array<cv::Point2f, 4> q = dets.quad(i);
+            const MergeAcc& a = acc[i];
+            const float w = std::max(0.f, dets.score(i));
+            if (a.w > 0.f && w + a.w > 0.f) { // boxes that suppressed nothing keep their quad exactly
+                const float inv = 1.0f / (w + a.w);
+                for (std::size_t k = 0; k < 4; ++k)
+                    q[k] = cv::Point2f((w * q[k].x + a.x[k]) * inv, (w * q[k].y + a.y[k]) * inv);
             }
+            merged_.push_back(q);
         }
     }
+    return keep_;
+}
 
-    return keep;
+const std::vector<int>& NmsWorkspace::run(const std::vector<Detection>& dets, const NmsParams& p) {
+    return run_(VecSource{dets}, p);
+}
+
+const std::vector<int>& NmsWorkspace::run(const DetectionBuffer& dets, const NmsParams& p) {
+    return run_(BufferSource{dets}, p);
+}
+
+void NmsWorkspace::gather(const std::vector<Detection>& dets, std::vector<Detection>& out) const {
+    out.clear();
+    out.reserve(keep_.size());
+    for (std::size_t k = 0; k < keep_.size(); ++k) {
+        out.push_back(dets[(std::size_t)keep_[k]]);
+        out.back().score = score_[k];
+        if (weighted_) out.back().pts = merged_[k];
+    }
+}
+
+void NmsWorkspace::gather(const DetectionBuffer& dets, std::vector<Detection>& out) const {
+    out.clear();
+    out.reserve(keep_.size());
+    for (std::size_t k = 0; k < keep_.size(); ++k) {
+        out.push_back(dets.get((std::size_t)keep_[k]));
+        out.back().score = score_[k];
+        if (weighted_) out.back().pts = merged_[k];
+    }
 }
 
 } // namespace idet::algo
@@ -10,16 +10,30 @@
  * The IoU backend can be chosen at runtime:
  * - exact polygon IoU (default),
  * - fast AABB IoU approximation (set @p use_fast_iou = true).
+ *
+ * Candidate boxes are kept in SoA layout inside the grid, so one kept box is tested against a
+ * whole grid cell with @ref aabb_iou_batch (SIMD, same dispatch as the preprocessing kernels).
+ *
+ * @ref idet::algo::NmsWorkspace is the stateful variant for per-context loops: it keeps its
+ * buffers across frames, reports kept indices instead of copies, and adds Soft-NMS, weighted box
+ * merging and a parallel mode over independent clusters of overlapping boxes.
  */
 
 #pragma once
 
+#include "algo/arena.h"
 #include "algo/geometry.h"
+#include "algo/preprocess.h"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace idet::algo {
 
+class DetectionBuffer;
+
 /**
  * @brief Axis-aligned bounding box (AABB) in float image coordinates.
  *
@@ -34,6 +48,33 @@ struct AABB {
     float minx, miny, maxx, maxy;
 };
 
+/**
+ * @brief Structure-of-arrays view over a contiguous block of AABBs.
+ */
+struct AabbSoA {
+    const float* minx;
+    const float* miny;
+    const float* maxx;
+    const float* maxy;
+};
+
+/**
+ * @brief IoU of one box against @p n candidate boxes.
+ *
+ * @details
+ * Same semantics as @ref aabb_iou: negative extents count as empty, a union <= 1e-6 gives 0 and
+ * the result is clamped to [0, 1]. Inputs must be finite. All SIMD levels give bit-identical
+ * results (no FMA contraction).
+ *
+ * @param a Reference box.
+ * @param c Candidate boxes (@p n entries per array).
+ * @param n Number of candidates.
+ * @param iou Output, @p n values.
+ * @param level SIMD backend; unsupported levels fall back to @ref best_simd_level().
+ */
+void aabb_iou_batch(const AABB& a, const AabbSoA& c, std::size_t n, float* iou,
+                    SimdLevel level = best_simd_level()) noexcept;
+
 /**
  * @brief Greedy NMS for quad detections.
  *
@@ -52,4 +93,125 @@ struct AABB {
 std::vector<algo::Detection> nms_poly(const std::vector<algo::Detection>& dets, float iou_thr,
                                       bool use_fast_iou = false);
 
+/**
+ * @brief Allocation-free variant of @ref nms_poly for steady-state loops.
+ *
+ * @details
+ * All temporaries (sort permutation, ranks, AABBs, CSR grid, suppression flags) are taken from
+ * @p arena; the caller resets it between frames. @p out is cleared and refilled, so its capacity
+ * is reused across calls. Results are identical to @ref nms_poly.
+ *
+ * @param dets Input detections (must not alias @p out).
+ * @param iou_thr IoU threshold.
+ * @param use_fast_iou If true, uses AABB IoU approximation inside @ref quad_iou.
+ * @param arena Scratch arena (not reset by this function).
+ * @param out Destination for the kept detections in descending score order.
+ */
+void nms_poly(const std::vector<algo::Detection>& dets, float iou_thr, bool use_fast_iou, FrameArena& arena,
+              std::vector<algo::Detection>& out);
+
+/**
+ * @brief Suppression rule of @ref NmsWorkspace.
+ */
+enum class NmsMethod : std::uint8_t {
+    Hard = 0,     ///< Greedy NMS, identical to @ref nms_poly
+    Linear = 1,   ///< Soft-NMS: scores of boxes with IoU >= threshold decay by (1 - IoU)
+    Gaussian = 2, ///< Soft-NMS: scores of overlapping boxes decay by exp(-IoU^2 / sigma)
+    Weighted = 3, ///< Greedy NMS; each kept quad becomes the score-weighted mean of the quads it suppressed
+};
+
+/**
+ * @brief Parameters of @ref NmsWorkspace::run.
+ */
+struct NmsParams {
+    float iou_thr = 0.3f;               ///< IoU threshold (see @ref nms_poly for <= 0 and >= 1)
+    bool use_fast_iou = false;          ///< AABB IoU approximation (see @ref quad_iou)
+    NmsMethod method = NmsMethod::Hard; ///< Suppression rule
+    float sigma = 0.5f;                 ///< Gaussian decay width (@ref NmsMethod::Gaussian, > 0)
+    float min_score = 0.001f;           ///< Soft-NMS: boxes decayed below this are dropped
+    int threads = 1;                    ///< Pool threads over independent clusters (<= 1: serial)
+};
+
+/**
+ * @brief Reusable NMS state: grid, ranks, flags and results keep their capacity across calls.
+ *
+ * @details
+ * Temporaries live in an owned @ref FrameArena that is reset by every @ref run, so a workspace
+ * owned by one context stops allocating after the first frames of a workload.
+ *
+ * With @c threads > 1 the boxes are first split into clusters: connected components of the
+ * graph whose edges are pairs with a positive AABB intersection. A box can only be suppressed or
+ * decayed by boxes of its own cluster, so clusters are processed concurrently on the current
+ * @ref platform::ThreadPool and the result is identical to the serial run. Soft-NMS always works
+ * cluster by cluster (its selection order changes with every decay).
+ *
+ * @note Not thread-safe; one workspace per concurrent caller.
+ */
+class NmsWorkspace final {
+  public:
+    /**
+     * @brief Runs NMS over @p dets.
+     *
+     * @param dets Input detections.
+     * @param p Method and parameters.
+     * @return Indices into @p dets of the kept detections in descending final score order
+     *         (valid until the next @ref run).
+     *
+     * @throws std::bad_alloc On allocation failure; exceptions of pool helpers are rethrown.
+     */
+    const std::vector<int>& run(const std::vector<Detection>& dets, const NmsParams& p);
+
+    /**
+     * @brief Same as @ref run over a @ref DetectionBuffer; its cached boxes feed the grid directly.
+     *
+     * @return Indices into @p dets, as for the vector overload.
+     */
+    const std::vector<int>& run(const DetectionBuffer& dets, const NmsParams& p);
+
+    /** @brief Kept indices of the last @ref run. */
+    const std::vector<int>& kept() const noexcept {
+        return keep_;
+    }
+
+    /** @brief Final score per @ref kept entry (decayed for Soft-NMS, unchanged otherwise). */
+    const std::vector<float>& scores() const noexcept {
+        return score_;
+    }
+
+    /**
+     * @brief Writes the kept detections of the last @ref run to @p out (cleared first).
+     *
+     * @details
+     * Applies the final scores and, for @ref NmsMethod::Weighted, the merged quads.
+     *
+     * @param dets The detections passed to @ref run (must not alias @p out).
+     * @param out Destination; its capacity is reused.
+     */
+    void gather(const std::vector<Detection>& dets, std::vector<Detection>& out) const;
+
+    /** @brief @ref gather for a @ref run over a @ref DetectionBuffer. */
+    void gather(const DetectionBuffer& dets, std::vector<Detection>& out) const;
+
+    /** @brief Clusters processed by the last @ref run (0 if it did not cluster). */
+    std::size_t clusters() const noexcept {
+        return clusters_;
+    }
+
+    /** @brief Scratch arena of the last @ref run (for memory statistics). */
+    const FrameArena& arena() const noexcept {
+        return arena_;
+    }
+
+  private:
+    /** @brief Body of both @ref run overloads (@p Src: detection access, see nms.cpp). */
+    template <class Src> const std::vector<int>& run_(const Src& dets, const NmsParams& p);
+
+    FrameArena arena_;
+    std::vector<int> keep_;
+    std::vector<float> score_;
+    std::vector<std::array<cv::Point2f, 4>> merged_; ///< Weighted quads per @ref keep_ entry
+    bool weighted_ = false;
+    std::size_t clusters_ = 0;
+};
+
 } // namespace idet::algo
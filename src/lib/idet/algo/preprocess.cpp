@@ -0,0 +1,496 @@
+/**
+ * @file preprocess.cpp
+ * @ingroup idet_algo
+ * @brief Implementation of the fused resize + normalize + HWC->CHW kernel.
+ *
+ * @details
+ * The resize is separable:
+ *  - Horizontal: each source row that a destination row needs is resampled once into three
+ *    float planes (B, G, R) of @c dst_w elements using precomputed offsets/weights.
+ *    Two such rows are cached, and consecutive destination rows usually reuse one or both.
+ *  - Vertical: the two cached rows are blended with the row weight, normalized and stored
+ *    straight into the destination CHW planes. This inner loop is the SIMD kernel.
+ *
+ * Normalization is folded into the vertical blend: out = a * wa + b * wb + bias, where
+ * wa = (1 - fy) * inv_std, wb = fy * inv_std, bias = -mean * inv_std.
+ *
+ * A packed source that already has the destination size skips both passes and is only
+ * normalized and deinterleaved.
+ *
+ * 4:2:0 YUV sources share the vertical pass; their horizontal pass converts the two taps of
+ * every destination column to BGR with OpenCV's BT.601 fixed-point formula before blending,
+ * so the output equals the BGR path on the @c cv::cvtColor result.
+ *
+ * x86-64 kernels are compiled with function-level target attributes and chosen once at
+ * runtime via @c __builtin_cpu_supports, so no per-file ISA flags are required in meson.
+ */
+
+#include "algo/preprocess.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define IDET_PREPROCESS_X86 1
+    #include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    #define IDET_PREPROCESS_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace idet::algo {
+
+namespace {
+
+/** @brief Vertical blend + normalize kernel over one plane row: dst = a*wa + b*wb + bias. */
+using BlendRowFn = void (*)(const float* a, const float* b, float* dst, int n, float wa, float wb, float bias);
+
+void blend_row_scalar(const float* a, const float* b, float* dst, int n, float wa, float wb, float bias) {
+    for (int x = 0; x < n; ++x)
+        dst[x] = a[x] * wa + b[x] * wb + bias;
+}
+
+#if defined(IDET_PREPROCESS_X86)
+
+__attribute__((target("avx2,fma"))) void blend_row_avx2(const float* a, const float* b, float* dst, int n, float wa,
+                                                        float wb, float bias) {
+    const __m256 va = _mm256_set1_ps(wa);
+    const __m256 vb = _mm256_set1_ps(wb);
+    const __m256 vc = _mm256_set1_ps(bias);
+    int x = 0;
+    for (; x + 8 <= n; x += 8) {
+        const __m256 r = _mm256_fmadd_ps(_mm256_loadu_ps(a + x), va, vc);
+        _mm256_storeu_ps(dst + x, _mm256_fmadd_ps(_mm256_loadu_ps(b + x), vb, r));
+    }
+    for (; x < n; ++x)
+        dst[x] = a[x] * wa + b[x] * wb + bias;
+}
+
+__attribute__((target("avx512f"))) void blend_row_avx512(const float* a, const float* b, float* dst, int n, float wa,
+                                                         float wb, float bias) {
+    const __m512 va = _mm512_set1_ps(wa);
+    const __m512 vb = _mm512_set1_ps(wb);
+    const __m512 vc = _mm512_set1_ps(bias);
+    int x = 0;
+    for (; x + 16 <= n; x += 16) {
+        const __m512 r = _mm512_fmadd_ps(_mm512_loadu_ps(a + x), va, vc);
+        _mm512_storeu_ps(dst + x, _mm512_fmadd_ps(_mm512_loadu_ps(b + x), vb, r));
+    }
+    if (x < n) {
+        const __mmask16 m = (__mmask16)((1u << (unsigned)(n - x)) - 1u);
+        const __m512 r = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + x), va, vc);
+        _mm512_mask_storeu_ps(dst + x, m, _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, b + x), vb, r));
+    }
+}
+
+#endif // IDET_PREPROCESS_X86
+
+#if defined(IDET_PREPROCESS_NEON)
+
+void blend_row_neon(const float* a, const float* b, float* dst, int n, float wa, float wb, float bias) {
+    const float32x4_t va = vdupq_n_f32(wa);
+    const float32x4_t vb = vdupq_n_f32(wb);
+    const float32x4_t vc = vdupq_n_f32(bias);
+    int x = 0;
+    for (; x + 4 <= n; x += 4) {
+        const float32x4_t r = vfmaq_f32(vc, vld1q_f32(a + x), va);
+        vst1q_f32(dst + x, vfmaq_f32(r, vld1q_f32(b + x), vb));
+    }
+    for (; x < n; ++x)
+        dst[x] = a[x] * wa + b[x] * wb + bias;
+}
+
+#endif // IDET_PREPROCESS_NEON
+
+BlendRowFn blend_fn_for(SimdLevel level) noexcept {
+    switch (level) {
+#if defined(IDET_PREPROCESS_X86)
+    case SimdLevel::AVX512:
+        return &blend_row_avx512;
+    case SimdLevel::AVX2:
+        return &blend_row_avx2;
+#endif
+#if defined(IDET_PREPROCESS_NEON)
+    case SimdLevel::NEON:
+        return &blend_row_neon;
+#endif
+    default:
+        return &blend_row_scalar;
+    }
+}
+
+SimdLevel detect_simd_level() noexcept {
+#if defined(IDET_PREPROCESS_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+    return SimdLevel::Scalar;
+#elif defined(IDET_PREPROCESS_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+/**
+ * @brief Bilinear source coordinate in @c cv::resize(INTER_LINEAR) convention.
+ *
+ * @details
+ * s = (d + 0.5) * scale - 0.5; clamped so that i0 is in [0, n-1] and the weight is 0 at borders.
+ */
+inline void src_coord(int d, double scale, int n, int& i0, int& i1, float& w) noexcept {
+    const double s = ((double)d + 0.5) * scale - 0.5;
+    int i = (int)std::floor(s);
+    double f = s - (double)i;
+    if (i < 0) {
+        i = 0;
+        f = 0.0;
+    }
+    if (i >= n - 1) {
+        i = n - 1;
+        f = 0.0;
+    }
+    i0 = i;
+    i1 = std::min(i + 1, n - 1);
+    w = (float)f;
+}
+
+/**
+ * @brief (Re)build horizontal tables and row cache when the geometry changes.
+ *
+ * @param bpp Bytes per source pixel the column offsets are scaled by (3 or 4 packed, 1 for luma).
+ */
+void prepare_workspace(ResizeChwWorkspace& ws, int src_w, int src_h, int dst_w, int dst_h, int bpp) {
+    if (ws.src_w == src_w && ws.src_h == src_h && ws.dst_w == dst_w && ws.dst_h == dst_h && ws.src_bpp == bpp) {
+        ws.row_tag[0] = ws.row_tag[1] = -1;
+        return;
+    }
+
+    const std::size_t n = (std::size_t)dst_w;
+    ws.xofs0.resize(n);
+    ws.xofs1.resize(n);
+    ws.xalpha.resize(n);
+    ws.rows.resize(2 * 3 * n);
+
+    const double scale_x = (double)src_w / (double)dst_w;
+    for (int x = 0; x < dst_w; ++x) {
+        int x0 = 0, x1 = 0;
+        float a = 0.f;
+        src_coord(x, scale_x, src_w, x0, x1, a);
+        ws.xofs0[(std::size_t)x] = x0 * bpp;
+        ws.xofs1[(std::size_t)x] = x1 * bpp;
+        ws.xalpha[(std::size_t)x] = a;
+    }
+
+    ws.src_w = src_w;
+    ws.src_h = src_h;
+    ws.dst_w = dst_w;
+    ws.dst_h = dst_h;
+    ws.src_bpp = bpp;
+    ws.row_tag[0] = ws.row_tag[1] = -1;
+}
+
+/**
+ * @brief Horizontal pass of one packed source row into 3 planar float rows (B, G, R).
+ *
+ * @tparam Bi/Gi/Ri Byte index of blue/green/red inside a source pixel; fixing them at compile
+ *         time keeps the channel permutation out of the inner loop.
+ */
+template <int Bi, int Gi, int Ri>
+void hresize_row(const std::uint8_t* src, const ResizeChwWorkspace& ws, float* out) noexcept {
+    const int n = ws.dst_w;
+    float* B = out;
+    float* G = out + n;
+    float* R = out + 2 * n;
+    const std::int32_t* o0 = ws.xofs0.data();
+    const std::int32_t* o1 = ws.xofs1.data();
+    const float* al = ws.xalpha.data();
+
+    for (int x = 0; x < n; ++x) {
+        const std::uint8_t* p0 = src + o0[x];
+        const std::uint8_t* p1 = src + o1[x];
+        const float a = al[x];
+        const float b0 = (float)p0[Bi], g0 = (float)p0[Gi], r0 = (float)p0[Ri];
+        B[x] = b0 + a * ((float)p1[Bi] - b0);
+        G[x] = g0 + a * ((float)p1[Gi] - g0);
+        R[x] = r0 + a * ((float)p1[Ri] - r0);
+    }
+}
+
+// BT.601 limited-range YUV -> RGB in 20-bit fixed point (same constants and rounding as cv::cvtColor).
+constexpr int kYuvShift = 20;
+constexpr int kYuvCY = 1220542;
+constexpr int kYuvCUB = 2116026;
+constexpr int kYuvCUG = -409993;
+constexpr int kYuvCVG = -852492;
+constexpr int kYuvCVR = 1673527;
+
+inline float sat_u8(int v) noexcept {
+    return (float)std::min(255, std::max(0, v >> kYuvShift));
+}
+
+/** @brief Converts one YUV sample to B, G, R (0..255). */
+inline void yuv_to_bgr(int y, int u, int v, float& b, float& g, float& r) noexcept {
+    const int yy = std::max(0, y - 16) * kYuvCY;
+    const int uu = u - 128;
+    const int vv = v - 128;
+    constexpr int kHalf = 1 << (kYuvShift - 1);
+    r = sat_u8(yy + kHalf + kYuvCVR * vv);
+    g = sat_u8(yy + kHalf + kYuvCVG * vv + kYuvCUG * uu);
+    b = sat_u8(yy + kHalf + kYuvCUB * uu);
+}
+
+/** @brief Horizontal pass of luma row @p sy (with its chroma row) into 3 planar float rows (B, G, R). */
+void hresize_row_yuv420(const Yuv420Planes& f, int sy, const ResizeChwWorkspace& ws, float* out) noexcept {
+    const int n = ws.dst_w;
+    float* B = out;
+    float* G = out + n;
+    float* R = out + 2 * n;
+    const std::int32_t* o0 = ws.xofs0.data();
+    const std::int32_t* o1 = ws.xofs1.data();
+    const float* al = ws.xalpha.data();
+
+    const std::uint8_t* yr = f.y + (std::size_t)sy * f.y_stride;
+    const std::uint8_t* ur = f.u + (std::size_t)(sy >> 1) * f.u_stride;
+    const std::uint8_t* vr = f.v + (std::size_t)(sy >> 1) * f.v_stride;
+    const int cs = f.chroma_step;
+
+    for (int x = 0; x < n; ++x) {
+        const int x0 = o0[x];
+        const int x1 = o1[x];
+        float b0, g0, r0, b1, g1, r1;
+        yuv_to_bgr(yr[x0], ur[(x0 >> 1) * cs], vr[(x0 >> 1) * cs], b0, g0, r0);
+        yuv_to_bgr(yr[x1], ur[(x1 >> 1) * cs], vr[(x1 >> 1) * cs], b1, g1, r1);
+        const float a = al[x];
+        B[x] = b0 + a * (b1 - b0);
+        G[x] = g0 + a * (g1 - g0);
+        R[x] = r0 + a * (r1 - r0);
+    }
+}
+
+/**
+ * @brief Returns the cached horizontal row for source row @p sy, computing it if needed.
+ *
+ * @param hrow Callable `(int sy, float* out)` running the horizontal pass of one source row.
+ */
+template <class HRow> const float* cached_row(HRow& hrow, ResizeChwWorkspace& ws, int sy, int keep_slot) noexcept {
+    const std::size_t row_len = 3 * (std::size_t)ws.dst_w;
+    for (int s = 0; s < 2; ++s) {
+        if (ws.row_tag[s] == sy) return ws.rows.data() + (std::size_t)s * row_len;
+    }
+    // Evict the slot that does not hold the other row of the current pair.
+    const int slot = (keep_slot == 0) ? 1 : 0;
+    float* dst = ws.rows.data() + (std::size_t)slot * row_len;
+    hrow(sy, dst);
+    ws.row_tag[slot] = sy;
+    return dst;
+}
+
+inline int slot_of(const ResizeChwWorkspace& ws, int sy) noexcept {
+    return (ws.row_tag[0] == sy) ? 0 : ((ws.row_tag[1] == sy) ? 1 : -1);
+}
+
+/**
+ * @brief Shared vertical pass: blends cached rows and stores normalized CHW rows into the canvas.
+ *
+ * @details
+ * @p ws must already be prepared for (@p src_w, @p src_h) -> (@p dst_w, @p dst_h).
+ */
+template <class HRow>
+void resize_canvas(HRow hrow, int src_h, int dst_w, int dst_h, float* dst_chw, int canvas_w, int canvas_h,
+                   const float mean[3], const float inv_std[3], ResizeChwWorkspace& ws, BlendRowFn blend) {
+    const float bias[3] = {-mean[0] * inv_std[0], -mean[1] * inv_std[1], -mean[2] * inv_std[2]};
+    const std::size_t plane = (std::size_t)canvas_w * (std::size_t)canvas_h;
+    const double scale_y = (double)src_h / (double)dst_h;
+
+    for (int y = 0; y < dst_h; ++y) {
+        int y0 = 0, y1 = 0;
+        float fy = 0.f;
+        src_coord(y, scale_y, src_h, y0, y1, fy);
+
+        const float* r0 = cached_row(hrow, ws, y0, slot_of(ws, y1));
+        const float* r1 = (y1 == y0) ? r0 : cached_row(hrow, ws, y1, slot_of(ws, y0));
+
+        float* out = dst_chw + (std::size_t)y * (std::size_t)canvas_w;
+        for (int c = 0; c < 3; ++c) {
+            const float wa = (1.f - fy) * inv_std[c];
+            const float wb = fy * inv_std[c];
+            const std::size_t off = (std::size_t)c * (std::size_t)dst_w;
+            blend(r0 + off, r1 + off, out + (std::size_t)c * plane, dst_w, wa, wb, bias[c]);
+        }
+    }
+}
+
+/**
+ * @brief Same-size packed source: normalize and deinterleave without resampling.
+ *
+ * @details
+ * Used when the source already has the destination size (e.g. adaptive tiles cut to the bound
+ * input shape); the bilinear weights would all be 0, so both passes reduce to this loop.
+ */
+template <int Bpp, int Bi, int Gi, int Ri>
+void copy_packed_canvas(const cv::Mat& src, float* dst_chw, int canvas_w, int canvas_h, const float mean[3],
+                        const float inv_std[3]) noexcept {
+    const float bias[3] = {-mean[0] * inv_std[0], -mean[1] * inv_std[1], -mean[2] * inv_std[2]};
+    const std::size_t plane = (std::size_t)canvas_w * (std::size_t)canvas_h;
+
+    for (int y = 0; y < src.rows; ++y) {
+        const std::uint8_t* p = src.ptr<std::uint8_t>(y);
+        float* B = dst_chw + (std::size_t)y * (std::size_t)canvas_w;
+        float* G = B + plane;
+        float* R = G + plane;
+        for (int x = 0; x < src.cols; ++x, p += Bpp) {
+            B[x] = (float)p[Bi] * inv_std[0] + bias[0];
+            G[x] = (float)p[Gi] * inv_std[1] + bias[1];
+            R[x] = (float)p[Ri] * inv_std[2] + bias[2];
+        }
+    }
+}
+
+/** @brief Packed-source kernel for one compile-time pixel layout. */
+template <int Bpp, int Bi, int Gi, int Ri>
+void resize_packed_canvas(const cv::Mat& src, int dst_w, int dst_h, float* dst_chw, int canvas_w, int canvas_h,
+                          const float mean[3], const float inv_std[3], ResizeChwWorkspace& ws, BlendRowFn blend) {
+    if (src.cols == dst_w && src.rows == dst_h) {
+        copy_packed_canvas<Bpp, Bi, Gi, Ri>(src, dst_chw, canvas_w, canvas_h, mean, inv_std);
+        return;
+    }
+    prepare_workspace(ws, src.cols, src.rows, dst_w, dst_h, Bpp);
+
+    auto hrow = [&](int sy, float* out) { hresize_row<Bi, Gi, Ri>(src.ptr<std::uint8_t>(sy), ws, out); };
+    resize_canvas(hrow, src.rows, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std, ws, blend);
+}
+
+} // namespace
+
+SimdLevel best_simd_level() noexcept {
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+bool simd_level_supported(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+    case SimdLevel::NEON:
+        return best_simd_level() == SimdLevel::NEON;
+    case SimdLevel::AVX2:
+        return best_simd_level() == SimdLevel::AVX2 || best_simd_level() == SimdLevel::AVX512;
+    case SimdLevel::AVX512:
+        return best_simd_level() == SimdLevel::AVX512;
+    }
+    return false;
+}
+
+const char* simd_level_name(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return "scalar";
+    case SimdLevel::NEON:
+        return "neon";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+void resize_bgr_to_chw(const cv::Mat& bgr, int dst_w, int dst_h, float* dst_chw, const float mean[3],
+                       const float inv_std[3], ResizeChwWorkspace& ws, SimdLevel level) {
+    resize_bgr_to_chw_canvas(bgr, dst_w, dst_h, dst_chw, dst_w, dst_h, mean, inv_std, ws, level);
+}
+
+void resize_bgr_to_chw_canvas(const cv::Mat& bgr, int dst_w, int dst_h, float* dst_chw, int canvas_w, int canvas_h,
+                              const float mean[3], const float inv_std[3], ResizeChwWorkspace& ws, SimdLevel level) {
+    resize_packed_to_chw_canvas(bgr, ChannelOrder::BGR, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std, ws,
+                                level);
+}
+
+void resize_packed_to_chw_canvas(const cv::Mat& src, ChannelOrder order, int dst_w, int dst_h, float* dst_chw,
+                                 int canvas_w, int canvas_h, const float mean[3], const float inv_std[3],
+                                 ResizeChwWorkspace& ws, SimdLevel level) {
+    if (src.empty() || dst_w <= 0 || dst_h <= 0 || !dst_chw) return;
+    if (canvas_w < dst_w || canvas_h < dst_h) return;
+    if (src.type() != (channel_count(order) == 4 ? CV_8UC4 : CV_8UC3)) return;
+
+    const BlendRowFn blend = blend_fn_for(simd_level_supported(level) ? level : best_simd_level());
+    switch (order) {
+    case ChannelOrder::BGR:
+        resize_packed_canvas<3, 0, 1, 2>(src, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std, ws, blend);
+        break;
+    case ChannelOrder::RGB:
+        resize_packed_canvas<3, 2, 1, 0>(src, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std, ws, blend);
+        break;
+    case ChannelOrder::BGRA:
+        resize_packed_canvas<4, 0, 1, 2>(src, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std, ws, blend);
+        break;
+    case ChannelOrder::RGBA:
+        resize_packed_canvas<4, 2, 1, 0>(src, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std, ws, blend);
+        break;
+    }
+}
+
+void resize_yuv420_to_chw(const Yuv420Planes& yuv, int dst_w, int dst_h, float* dst_chw, const float mean[3],
+                          const float inv_std[3], ResizeChwWorkspace& ws, SimdLevel level) {
+    resize_yuv420_to_chw_canvas(yuv, dst_w, dst_h, dst_chw, dst_w, dst_h, mean, inv_std, ws, level);
+}
+
+void resize_yuv420_to_chw_canvas(const Yuv420Planes& yuv, int dst_w, int dst_h, float* dst_chw, int canvas_w,
+                                 int canvas_h, const float mean[3], const float inv_std[3], ResizeChwWorkspace& ws,
+                                 SimdLevel level) {
+    if (yuv.empty() || dst_w <= 0 || dst_h <= 0 || !dst_chw) return;
+    if (canvas_w < dst_w || canvas_h < dst_h) return;
+
+    const BlendRowFn blend = blend_fn_for(simd_level_supported(level) ? level : best_simd_level());
+    prepare_workspace(ws, yuv.width, yuv.height, dst_w, dst_h, 1);
+
+    auto hrow = [&](int sy, float* out) { hresize_row_yuv420(yuv, sy, ws, out); };
+    resize_canvas(hrow, yuv.height, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std, ws, blend);
+}
+
+void resize_to_chw_canvas(const ChwSource& src, int dst_w, int dst_h, float* dst_chw, int canvas_w, int canvas_h,
+                          const float mean[3], const float inv_std[3], ResizeChwWorkspace& ws, SimdLevel level) {
+    if (src.yuv)
+        resize_yuv420_to_chw_canvas(*src.yuv, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std, ws, level);
+    else if (src.packed)
+        resize_packed_to_chw_canvas(*src.packed, src.order, dst_w, dst_h, dst_chw, canvas_w, canvas_h, mean, inv_std,
+                                    ws, level);
+}
+
+void resize_to_chw(const ChwSource& src, int dst_w, int dst_h, float* dst_chw, const float mean[3],
+                   const float inv_std[3], ResizeChwWorkspace* ws) {
+    thread_local ResizeChwWorkspace local;
+    resize_to_chw_canvas(src, dst_w, dst_h, dst_chw, dst_w, dst_h, mean, inv_std, ws ? *ws : local);
+}
+
+void resize_bgr_to_chw(const cv::Mat& bgr, int dst_w, int dst_h, float* dst_chw, const float mean[3],
+                       const float inv_std[3]) {
+    thread_local ResizeChwWorkspace ws;
+    resize_bgr_to_chw(bgr, dst_w, dst_h, dst_chw, mean, inv_std, ws, best_simd_level());
+}
+
+void fill_chw_padding(float* dst_chw, int canvas_w, int canvas_h, int content_w, int content_h,
+                      const float value[3]) noexcept {
+    if (!dst_chw || canvas_w <= 0 || canvas_h <= 0) return;
+    content_w = std::max(0, std::min(content_w, canvas_w));
+    content_h = std::max(0, std::min(content_h, canvas_h));
+
+    const std::size_t plane = (std::size_t)canvas_w * (std::size_t)canvas_h;
+    for (int c = 0; c < 3; ++c) {
+        float* p = dst_chw + (std::size_t)c * plane;
+        if (content_w < canvas_w) {
+            for (int y = 0; y < content_h; ++y) {
+                float* row = p + (std::size_t)y * (std::size_t)canvas_w;
+                std::fill(row + content_w, row + canvas_w, value[c]);
+            }
+        }
+        std::fill(p + (std::size_t)content_h * (std::size_t)canvas_w, p + plane, value[c]);
+    }
+}
+
+} // namespace idet::algo
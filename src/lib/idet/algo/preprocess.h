@@ -0,0 +1,266 @@
+/**
+ * @file preprocess.h
+ * @ingroup idet_algo
+ * @brief Fused resize + normalize + HWC->CHW preprocessing kernel.
+ *
+ * @details
+ * Converts a BGR @c CV_8UC3 image of any size into a normalized CHW float32 tensor of the
+ * requested network input size in a single pass over the output, without an intermediate
+ * resized @c cv::Mat:
+ * - bilinear sampling follows @c cv::resize(INTER_LINEAR) pixel-center conventions,
+ * - the horizontal pass is done once per used source row and cached (two rows),
+ * - the vertical blend, mean/std normalization and planar store run in a SIMD kernel.
+ *
+ * The SIMD path (AVX2/FMA, AVX-512F on x86-64; NEON on AArch64) is selected once at runtime
+ * from CPU features, so a generic build still uses the widest available unit.
+ *
+ * Normalization constants follow @ref chw_preprocess.h: @p mean and @p inv_std are in B,G,R order.
+ *
+ * Packed RGB / RGBA / BGRA images are read directly as well: the source channel order is a
+ * template parameter of the horizontal pass, so the B,G,R output planes (and with them the
+ * B,G,R-ordered constants) line up without a @c cv::cvtColor copy.
+ *
+ * 4:2:0 YUV frames (NV12 / NV21 / I420) go through the same kernel: every source pixel the
+ * horizontal pass samples is converted to BGR on the fly (BT.601 limited range, bit-exact with
+ * @c cv::cvtColor), so a full-resolution BGR image is never materialized.
+ */
+
+#pragma once
+
+#include "internal/opencv_headers.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace idet::algo {
+
+/**
+ * @brief SIMD backend used by @ref resize_bgr_to_chw.
+ */
+enum class SimdLevel : int {
+    Scalar = 0, ///< Portable C++ loop (compiler auto-vectorization only)
+    NEON,       ///< AArch64 Advanced SIMD (4 x f32)
+    AVX2,       ///< x86-64 AVX2 + FMA (8 x f32)
+    AVX512,     ///< x86-64 AVX-512F (16 x f32)
+};
+
+/**
+ * @brief Byte order of a packed 8-bit source image read by the resize kernels.
+ */
+enum class ChannelOrder : int {
+    BGR = 0, ///< 3 bytes per pixel, B first (OpenCV default)
+    RGB,     ///< 3 bytes per pixel, R first
+    BGRA,    ///< 4 bytes per pixel, B first, alpha ignored
+    RGBA,    ///< 4 bytes per pixel, R first, alpha ignored
+};
+
+/** @brief Bytes per pixel of @p order (3 or 4). */
+constexpr int channel_count(ChannelOrder order) noexcept {
+    return (order == ChannelOrder::BGRA || order == ChannelOrder::RGBA) ? 4 : 3;
+}
+
+/** @brief Best SIMD level supported by the running CPU (detected once, cached). */
+SimdLevel best_simd_level() noexcept;
+
+/** @brief Returns true if @p level can run on this CPU/build. */
+bool simd_level_supported(SimdLevel level) noexcept;
+
+/** @brief Human-readable name of a SIMD level (e.g. "avx2"). */
+const char* simd_level_name(SimdLevel level) noexcept;
+
+/**
+ * @brief Reusable scratch for @ref resize_bgr_to_chw.
+ *
+ * @details
+ * Holds horizontal sampling tables and the two cached horizontally-resampled rows.
+ * Tables are rebuilt only when the (src, dst) geometry changes, so repeated calls with the
+ * same geometry perform no allocations. A workspace must not be shared between threads.
+ */
+struct ResizeChwWorkspace {
+    int src_w = 0, src_h = 0; ///< Geometry the tables were built for
+    int dst_w = 0, dst_h = 0;
+
+    std::vector<std::int32_t> xofs0; ///< Byte offset of the left sample per dst column
+    std::vector<std::int32_t> xofs1; ///< Byte offset of the right sample per dst column
+    std::vector<float> xalpha;       ///< Right-sample weight per dst column
+
+    int src_bpp = 0;                 ///< Bytes per source pixel the offsets were scaled by (3/4 packed, 1 YUV)
+
+    std::vector<float> rows; ///< 2 cached rows, each 3 planes of dst_w floats
+    int row_tag[2] = {-1, -1};
+};
+
+/**
+ * @brief Non-owning 4:2:0 frame: full-resolution luma plus half-resolution chroma planes.
+ *
+ * @details
+ * Chroma sample (cx, cy) covers luma pixels (2cx..2cx+1, 2cy..2cy+1). Planar (I420) and
+ * semi-planar (NV12 / NV21) layouts differ only in @ref chroma_step and the U/V start pointers:
+ * for NV12 @c v == @c u + 1, for NV21 @c u == @c v + 1, both with @c chroma_step == 2.
+ */
+struct Yuv420Planes {
+    int width = 0;  ///< Luma width (even)
+    int height = 0; ///< Luma height (even)
+
+    const std::uint8_t* y = nullptr; ///< First luma sample
+    std::size_t y_stride = 0;        ///< Luma row stride in bytes
+    const std::uint8_t* u = nullptr; ///< First U (Cb) sample
+    std::size_t u_stride = 0;        ///< U row stride in bytes
+    const std::uint8_t* v = nullptr; ///< First V (Cr) sample
+    std::size_t v_stride = 0;        ///< V row stride in bytes
+    int chroma_step = 1;             ///< Bytes between horizontally adjacent chroma samples
+
+    /** @brief True if any plane is missing or the size is not positive. */
+    bool empty() const noexcept {
+        return !y || !u || !v || width <= 0 || height <= 0;
+    }
+};
+
+/**
+ * @brief Input of the resize kernels: a packed image or a 4:2:0 frame (exactly one is set).
+ *
+ * Lets engines run the same preprocessing code for every input kind.
+ */
+struct ChwSource {
+    const cv::Mat* packed = nullptr;           ///< Packed U8 image (@c CV_8UC3 or @c CV_8UC4)
+    ChannelOrder order = ChannelOrder::BGR;    ///< Byte order of @ref packed
+    const Yuv420Planes* yuv = nullptr;
+
+    /** @brief Source for a packed image with the given channel order (BGR @c CV_8UC3 by default). */
+    static ChwSource of(const cv::Mat& m, ChannelOrder order = ChannelOrder::BGR) noexcept {
+        ChwSource s;
+        s.packed = &m;
+        s.order = order;
+        return s;
+    }
+
+    /** @brief Source for a 4:2:0 frame. */
+    static ChwSource of(const Yuv420Planes& f) noexcept {
+        ChwSource s;
+        s.yuv = &f;
+        return s;
+    }
+
+    int width() const noexcept {
+        return packed ? packed->cols : (yuv ? yuv->width : 0);
+    }
+
+    int height() const noexcept {
+        return packed ? packed->rows : (yuv ? yuv->height : 0);
+    }
+
+    bool empty() const noexcept {
+        return packed ? packed->empty() : (!yuv || yuv->empty());
+    }
+
+    /** @brief Non-empty, Mat type matching @ref order, and even 4:2:0 dimensions. */
+    bool valid() const noexcept {
+        if (empty()) return false;
+        if (packed) return packed->type() == (channel_count(order) == 4 ? CV_8UC4 : CV_8UC3);
+        return ((yuv->width | yuv->height) & 1) == 0;
+    }
+};
+
+/**
+ * @brief Resize (bilinear) + normalize a BGR U8 image directly into a CHW float32 buffer.
+ *
+ * @param bgr Input image (must be non-empty @c CV_8UC3; non-continuous rows are fine).
+ * @param dst_w Destination width (> 0).
+ * @param dst_h Destination height (> 0).
+ * @param dst_chw Output buffer of at least @c 3 * dst_h * dst_w floats.
+ * @param mean Per-channel mean in B,G,R order.
+ * @param inv_std Per-channel inverse standard deviation in B,G,R order.
+ * @param ws Reusable scratch (per thread / per binding context).
+ * @param level SIMD backend; unsupported levels fall back to @ref best_simd_level().
+ *
+ * @throws std::bad_alloc If the workspace needs to grow and allocation fails.
+ *
+ * @note Results match @c cv::resize(INTER_LINEAR) followed by per-channel normalization up to
+ *       OpenCV's 8-bit fixed-point rounding (below one input intensity level).
+ */
+void resize_bgr_to_chw(const cv::Mat& bgr, int dst_w, int dst_h, float* dst_chw, const float mean[3],
+                       const float inv_std[3], ResizeChwWorkspace& ws, SimdLevel level = best_simd_level());
+
+/**
+ * @brief Same as above, using a thread-local workspace.
+ */
+void resize_bgr_to_chw(const cv::Mat& bgr, int dst_w, int dst_h, float* dst_chw, const float mean[3],
+                       const float inv_std[3]);
+
+/**
+ * @brief Same as @ref resize_bgr_to_chw, writing into the top-left corner of a larger CHW canvas.
+ *
+ * @details
+ * Used for letterboxed binding: only the @p dst_w x @p dst_h content region of each plane is
+ * written; the padding around it is left untouched (see @ref fill_chw_padding).
+ *
+ * @param canvas_w Canvas width (>= @p dst_w); also the row stride of every plane.
+ * @param canvas_h Canvas height (>= @p dst_h); planes are @c canvas_w * canvas_h floats apart.
+ */
+void resize_bgr_to_chw_canvas(const cv::Mat& bgr, int dst_w, int dst_h, float* dst_chw, int canvas_w, int canvas_h,
+                              const float mean[3], const float inv_std[3], ResizeChwWorkspace& ws,
+                              SimdLevel level = best_simd_level());
+
+/**
+ * @brief Canvas variant of @ref resize_bgr_to_chw for any packed @p order.
+ *
+ * @details
+ * Output planes are always B, G, R, so @p mean / @p inv_std keep their B,G,R order. The result
+ * equals converting @p src to BGR with @c cv::cvtColor first; alpha is ignored.
+ *
+ * @param src Input image: @c CV_8UC3 for BGR/RGB, @c CV_8UC4 for BGRA/RGBA (others are ignored).
+ * @param order Byte order of @p src.
+ */
+void resize_packed_to_chw_canvas(const cv::Mat& src, ChannelOrder order, int dst_w, int dst_h, float* dst_chw,
+                                 int canvas_w, int canvas_h, const float mean[3], const float inv_std[3],
+                                 ResizeChwWorkspace& ws, SimdLevel level = best_simd_level());
+
+/**
+ * @brief Resize (bilinear) + normalize a 4:2:0 YUV frame directly into a CHW float32 buffer.
+ *
+ * @details
+ * Same geometry, workspace and output as @ref resize_bgr_to_chw; the result equals
+ * @c cv::cvtColor(YUV2BGR) followed by @ref resize_bgr_to_chw, but only the source pixels the
+ * bilinear taps touch are converted.
+ *
+ * @param yuv Input frame (non-empty).
+ * @throws std::bad_alloc If the workspace needs to grow and allocation fails.
+ */
+void resize_yuv420_to_chw(const Yuv420Planes& yuv, int dst_w, int dst_h, float* dst_chw, const float mean[3],
+                          const float inv_std[3], ResizeChwWorkspace& ws, SimdLevel level = best_simd_level());
+
+/**
+ * @brief Canvas variant of @ref resize_yuv420_to_chw (see @ref resize_bgr_to_chw_canvas).
+ */
+void resize_yuv420_to_chw_canvas(const Yuv420Planes& yuv, int dst_w, int dst_h, float* dst_chw, int canvas_w,
+                                 int canvas_h, const float mean[3], const float inv_std[3], ResizeChwWorkspace& ws,
+                                 SimdLevel level = best_simd_level());
+
+/**
+ * @brief Dispatches to the packed or YUV kernel for @p src (canvas variant).
+ */
+void resize_to_chw_canvas(const ChwSource& src, int dst_w, int dst_h, float* dst_chw, int canvas_w, int canvas_h,
+                          const float mean[3], const float inv_std[3], ResizeChwWorkspace& ws,
+                          SimdLevel level = best_simd_level());
+
+/**
+ * @brief Dispatches to the packed or YUV kernel for @p src; a null @p ws uses a thread-local workspace.
+ */
+void resize_to_chw(const ChwSource& src, int dst_w, int dst_h, float* dst_chw, const float mean[3],
+                   const float inv_std[3], ResizeChwWorkspace* ws = nullptr);
+
+/**
+ * @brief Fill everything right of and below a @p content_w x @p content_h region with a constant.
+ *
+ * @param dst_chw CHW canvas of @c 3 * canvas_w * canvas_h floats.
+ * @param canvas_w Canvas width.
+ * @param canvas_h Canvas height.
+ * @param content_w Width of the top-left region to keep (clamped to the canvas).
+ * @param content_h Height of the top-left region to keep (clamped to the canvas).
+ * @param value Per-plane padding value.
+ */
+void fill_chw_padding(float* dst_chw, int canvas_w, int canvas_h, int content_w, int content_h,
+                      const float value[3]) noexcept;
+
+} // namespace idet::algo
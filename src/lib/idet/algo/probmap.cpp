@@ -0,0 +1,532 @@
+/**
+ * @file probmap.cpp
+ * @ingroup idet_algo
+ * @brief Implementation of probability-map binarization kernels.
+ *
+ * @details
+ * Every kernel compares a block of floats against the threshold and narrows the all-ones
+ * comparison lanes to bytes (0xFF), which is exactly the 255/0 mask OpenCV's contour tracer
+ * expects. Ordered comparisons keep NaN inputs at 0, like the scalar loop.
+ *
+ * The gather kernels (@ref idet::algo::select_ge) turn the comparison mask into a bit mask and
+ * emit the indices of its set bits; blocks without a passing lane cost one compare.
+ *
+ * The pooling kernels combine the two source rows vertically first and then pairs of lanes
+ * (even/odd shuffles on x86, de-interleaving loads on NEON). Quantization scales by 255 and
+ * rounds with the saturating float-to-int conversions, so out-of-range values clamp.
+ */
+
+#include "algo/probmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define IDET_PROBMAP_X86 1
+    #include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    #define IDET_PROBMAP_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace idet::algo {
+
+namespace {
+
+using BinarizeRowFn = bool (*)(const float* src, std::uint8_t* dst, int n, float thr);
+using SelectGeFn = int (*)(const float* src, int n, float thr, int* idx);
+using PoolRowFn = void (*)(const float* r0, const float* r1, float* dst, int n, bool average);
+using QuantizeRowFn = void (*)(const float* src, std::uint8_t* dst, int n);
+
+bool binarize_row_scalar(const float* src, std::uint8_t* dst, int n, float thr) {
+    std::uint8_t any = 0;
+    for (int x = 0; x < n; ++x) {
+        dst[x] = (src[x] > thr) ? 255 : 0;
+        any |= dst[x];
+    }
+    return any != 0;
+}
+
+int select_ge_scalar(const float* src, int n, float thr, int* idx) {
+    int k = 0;
+    for (int x = 0; x < n; ++x)
+        if (src[x] >= thr) idx[k++] = x;
+    return k;
+}
+
+/// @brief Writes @p n pooled values from source rows @p r0 / @p r1 (2n floats each).
+void pool_row_scalar(const float* r0, const float* r1, float* dst, int n, bool average) {
+    for (int x = 0; x < n; ++x) {
+        const float a = r0[2 * x], b = r0[2 * x + 1], c = r1[2 * x], d = r1[2 * x + 1];
+        dst[x] = average ? 0.25f * ((a + b) + (c + d)) : std::max(std::max(a, b), std::max(c, d));
+    }
+}
+
+inline std::uint8_t quantize_one(float p) noexcept {
+    const float q = p * 255.0f + 0.5f;
+    if (!(q > 0.0f)) return 0; // NaN too
+    return q >= 255.0f ? 255 : (std::uint8_t)q;
+}
+
+void quantize_row_scalar(const float* src, std::uint8_t* dst, int n) {
+    for (int x = 0; x < n; ++x)
+        dst[x] = quantize_one(src[x]);
+}
+
+#if defined(IDET_PROBMAP_X86)
+
+__attribute__((target("avx2"))) int select_ge_avx2(const float* src, int n, float thr, int* idx) {
+    const __m256 vt = _mm256_set1_ps(thr);
+    int k = 0, x = 0;
+    for (; x + 8 <= n; x += 8) {
+        unsigned m = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(src + x), vt, _CMP_GE_OQ));
+        while (m) {
+            idx[k++] = x + __builtin_ctz(m);
+            m &= m - 1u;
+        }
+    }
+    for (; x < n; ++x)
+        if (src[x] >= thr) idx[k++] = x;
+    return k;
+}
+
+__attribute__((target("avx512f"))) int select_ge_avx512(const float* src, int n, float thr, int* idx) {
+    const __m512 vt = _mm512_set1_ps(thr);
+    const __m512i step = _mm512_set1_epi32(16);
+    __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    int k = 0, x = 0;
+    for (; x + 16 <= n; x += 16) {
+        const __mmask16 m = _mm512_cmp_ps_mask(_mm512_loadu_ps(src + x), vt, _CMP_GE_OQ);
+        if (m) {
+            _mm512_mask_compressstoreu_epi32(idx + k, m, lanes);
+            k += __builtin_popcount((unsigned)m);
+        }
+        lanes = _mm512_add_epi32(lanes, step);
+    }
+    if (x < n) {
+        const __mmask16 tail = (__mmask16)((1u << (unsigned)(n - x)) - 1u);
+        const __mmask16 m = _mm512_mask_cmp_ps_mask(tail, _mm512_maskz_loadu_ps(tail, src + x), vt, _CMP_GE_OQ);
+        _mm512_mask_compressstoreu_epi32(idx + k, m, lanes);
+        k += __builtin_popcount((unsigned)m);
+    }
+    return k;
+}
+
+__attribute__((target("avx2"))) bool binarize_row_avx2(const float* src, std::uint8_t* dst, int n, float thr) {
+    const __m256 vt = _mm256_set1_ps(thr);
+    // packs_epi32/packs_epi16 interleave 128-bit lanes; this restores element order.
+    const __m256i fix = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    __m256i seen = _mm256_setzero_si256();
+    std::uint8_t any = 0;
+    int x = 0;
+    for (; x + 32 <= n; x += 32) {
+        const __m256i a = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(src + x), vt, _CMP_GT_OQ));
+        const __m256i b = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(src + x + 8), vt, _CMP_GT_OQ));
+        const __m256i c = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(src + x + 16), vt, _CMP_GT_OQ));
+        const __m256i d = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(src + x + 24), vt, _CMP_GT_OQ));
+        const __m256i ab = _mm256_packs_epi32(a, b);
+        const __m256i cd = _mm256_packs_epi32(c, d);
+        const __m256i abcd = _mm256_permutevar8x32_epi32(_mm256_packs_epi16(ab, cd), fix);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), abcd);
+        seen = _mm256_or_si256(seen, abcd);
+    }
+    for (; x < n; ++x) {
+        dst[x] = (src[x] > thr) ? 255 : 0;
+        any |= dst[x];
+    }
+    return any != 0 || !_mm256_testz_si256(seen, seen);
+}
+
+__attribute__((target("avx512f"))) bool binarize_row_avx512(const float* src, std::uint8_t* dst, int n, float thr) {
+    const __m512 vt = _mm512_set1_ps(thr);
+    const __m512i ones = _mm512_set1_epi32(-1);
+    unsigned seen = 0;
+    int x = 0;
+    for (; x + 16 <= n; x += 16) {
+        const __mmask16 m = _mm512_cmp_ps_mask(_mm512_loadu_ps(src + x), vt, _CMP_GT_OQ);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm512_cvtepi32_epi8(_mm512_maskz_mov_epi32(m, ones)));
+        seen |= (unsigned)m;
+    }
+    if (x < n) {
+        const __mmask16 tail = (__mmask16)((1u << (unsigned)(n - x)) - 1u);
+        const __mmask16 m = _mm512_mask_cmp_ps_mask(tail, _mm512_maskz_loadu_ps(tail, src + x), vt, _CMP_GT_OQ);
+        _mm512_mask_cvtepi32_storeu_epi8(dst + x, tail, _mm512_maskz_mov_epi32(m, ones));
+        seen |= (unsigned)m;
+    }
+    return seen != 0;
+}
+
+__attribute__((target("avx2"))) void pool_row_avx2(const float* r0, const float* r1, float* dst, int n,
+                                                   bool average) {
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+    int x = 0;
+    for (; x + 8 <= n; x += 8) {
+        const float* a = r0 + 2 * x;
+        const float* b = r1 + 2 * x;
+        __m256 lo, hi;
+        if (average) {
+            lo = _mm256_add_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b));
+            hi = _mm256_add_ps(_mm256_loadu_ps(a + 8), _mm256_loadu_ps(b + 8));
+        } else {
+            lo = _mm256_max_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b));
+            hi = _mm256_max_ps(_mm256_loadu_ps(a + 8), _mm256_loadu_ps(b + 8));
+        }
+        // Even / odd columns per 128-bit lane: outputs {0,1,4,5 | 2,3,6,7}, fixed by the permute.
+        const __m256 ev = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 od = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 r = average ? _mm256_mul_ps(_mm256_add_ps(ev, od), quarter) : _mm256_max_ps(ev, od);
+        r = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r), _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm256_storeu_ps(dst + x, r);
+    }
+    pool_row_scalar(r0 + 2 * x, r1 + 2 * x, dst + x, n - x, average);
+}
+
+__attribute__((target("avx2"))) void quantize_row_avx2(const float* src, std::uint8_t* dst, int n) {
+    const __m256 scale = _mm256_set1_ps(255.0f);
+    const __m256i fix = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    int x = 0;
+    for (; x + 32 <= n; x += 32) {
+        // cvtps rounds to nearest; NaN becomes INT_MIN and saturates to 0 like negatives.
+        const __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + x), scale));
+        const __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + x + 8), scale));
+        const __m256i c = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + x + 16), scale));
+        const __m256i d = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + x + 24), scale));
+        const __m256i ab = _mm256_packs_epi32(a, b);
+        const __m256i cd = _mm256_packs_epi32(c, d);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x),
+                            _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), fix));
+    }
+    quantize_row_scalar(src + x, dst + x, n - x);
+}
+
+#endif // IDET_PROBMAP_X86
+
+#if defined(IDET_PROBMAP_NEON)
+
+int select_ge_neon(const float* src, int n, float thr, int* idx) {
+    const float32x4_t vt = vdupq_n_f32(thr);
+    int k = 0, x = 0;
+    for (; x + 8 <= n; x += 8) {
+        const uint32x4_t a = vcgeq_f32(vld1q_f32(src + x), vt);
+        const uint32x4_t b = vcgeq_f32(vld1q_f32(src + x + 4), vt);
+        if (vmaxvq_u32(vorrq_u32(a, b)) == 0) continue;
+        for (int i = 0; i < 8; ++i)
+            if (src[x + i] >= thr) idx[k++] = x + i;
+    }
+    for (; x < n; ++x)
+        if (src[x] >= thr) idx[k++] = x;
+    return k;
+}
+
+bool binarize_row_neon(const float* src, std::uint8_t* dst, int n, float thr) {
+    const float32x4_t vt = vdupq_n_f32(thr);
+    uint8x16_t seen = vdupq_n_u8(0);
+    std::uint8_t any = 0;
+    int x = 0;
+    for (; x + 16 <= n; x += 16) {
+        const uint16x8_t lo = vcombine_u16(vmovn_u32(vcgtq_f32(vld1q_f32(src + x), vt)),
+                                           vmovn_u32(vcgtq_f32(vld1q_f32(src + x + 4), vt)));
+        const uint16x8_t hi = vcombine_u16(vmovn_u32(vcgtq_f32(vld1q_f32(src + x + 8), vt)),
+                                           vmovn_u32(vcgtq_f32(vld1q_f32(src + x + 12), vt)));
+        const uint8x16_t m = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+        vst1q_u8(dst + x, m);
+        seen = vorrq_u8(seen, m);
+    }
+    for (; x < n; ++x) {
+        dst[x] = (src[x] > thr) ? 255 : 0;
+        any |= dst[x];
+    }
+    return any != 0 || vmaxvq_u8(seen) != 0;
+}
+
+void pool_row_neon(const float* r0, const float* r1, float* dst, int n, bool average) {
+    const float32x4_t quarter = vdupq_n_f32(0.25f);
+    int x = 0;
+    for (; x + 4 <= n; x += 4) {
+        const float32x4x2_t a = vld2q_f32(r0 + 2 * x); // val[0]: even columns, val[1]: odd columns
+        const float32x4x2_t b = vld2q_f32(r1 + 2 * x);
+        float32x4_t r;
+        if (average)
+            r = vmulq_f32(vaddq_f32(vaddq_f32(a.val[0], a.val[1]), vaddq_f32(b.val[0], b.val[1])), quarter);
+        else
+            r = vmaxq_f32(vmaxq_f32(a.val[0], a.val[1]), vmaxq_f32(b.val[0], b.val[1]));
+        vst1q_f32(dst + x, r);
+    }
+    pool_row_scalar(r0 + 2 * x, r1 + 2 * x, dst + x, n - x, average);
+}
+
+void quantize_row_neon(const float* src, std::uint8_t* dst, int n) {
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+    int x = 0;
+    for (; x + 8 <= n; x += 8) {
+        // vcvtnq rounds to nearest and maps NaN to 0; the narrowing steps saturate.
+        const int32x4_t a = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(src + x), scale));
+        const int32x4_t b = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(src + x + 4), scale));
+        vst1_u8(dst + x, vqmovun_s16(vcombine_s16(vqmovn_s32(a), vqmovn_s32(b))));
+    }
+    quantize_row_scalar(src + x, dst + x, n - x);
+}
+
+#endif // IDET_PROBMAP_NEON
+
+BinarizeRowFn binarize_fn_for(SimdLevel level) noexcept {
+    if (!simd_level_supported(level)) level = best_simd_level();
+    switch (level) {
+#if defined(IDET_PROBMAP_X86)
+    case SimdLevel::AVX512:
+        return &binarize_row_avx512;
+    case SimdLevel::AVX2:
+        return &binarize_row_avx2;
+#endif
+#if defined(IDET_PROBMAP_NEON)
+    case SimdLevel::NEON:
+        return &binarize_row_neon;
+#endif
+    default:
+        return &binarize_row_scalar;
+    }
+}
+
+SelectGeFn select_fn_for(SimdLevel level) noexcept {
+    if (!simd_level_supported(level)) level = best_simd_level();
+    switch (level) {
+#if defined(IDET_PROBMAP_X86)
+    case SimdLevel::AVX512:
+        return &select_ge_avx512;
+    case SimdLevel::AVX2:
+        return &select_ge_avx2;
+#endif
+#if defined(IDET_PROBMAP_NEON)
+    case SimdLevel::NEON:
+        return &select_ge_neon;
+#endif
+    default:
+        return &select_ge_scalar;
+    }
+}
+
+PoolRowFn pool_fn_for(SimdLevel level) noexcept {
+    if (!simd_level_supported(level)) level = best_simd_level();
+    switch (level) {
+#if defined(IDET_PROBMAP_X86)
+    case SimdLevel::AVX512: // shuffle-bound: AVX-512 gains nothing over AVX2 here
+    case SimdLevel::AVX2:
+        return &pool_row_avx2;
+#endif
+#if defined(IDET_PROBMAP_NEON)
+    case SimdLevel::NEON:
+        return &pool_row_neon;
+#endif
+    default:
+        return &pool_row_scalar;
+    }
+}
+
+QuantizeRowFn quantize_fn_for(SimdLevel level) noexcept {
+    if (!simd_level_supported(level)) level = best_simd_level();
+    switch (level) {
+#if defined(IDET_PROBMAP_X86)
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:
+        return &quantize_row_avx2;
+#endif
+#if defined(IDET_PROBMAP_NEON)
+    case SimdLevel::NEON:
+        return &quantize_row_neon;
+#endif
+    default:
+        return &quantize_row_scalar;
+    }
+}
+
+} // namespace
+
+float logit_threshold(float p) noexcept {
+    if (!(p > 0.0f)) return -std::numeric_limits<float>::infinity();
+    if (p >= 1.0f) return std::numeric_limits<float>::infinity();
+    return (float)std::log((double)p / (1.0 - (double)p));
+}
+
+int select_ge(const float* src, int n, float thr, int* idx, SimdLevel level) noexcept {
+    if (!src || !idx || n <= 0) return 0;
+    return select_fn_for(level)(src, n, thr, idx);
+}
+
+bool binarize_row(const float* src, std::uint8_t* dst, int n, float thr, SimdLevel level) noexcept {
+    if (!src || !dst || n <= 0) return false;
+    return binarize_fn_for(level)(src, dst, n, thr);
+}
+
+void binarize(const float* map, int w, int h, float thr, cv::Mat& mask, SimdLevel level) {
+    mask.create(h, w, CV_8U);
+    if (!map || w <= 0 || h <= 0) return;
+
+    const BinarizeRowFn fn = binarize_fn_for(level);
+    if (mask.isContinuous()) {
+        fn(map, mask.ptr<std::uint8_t>(0), w * h, thr);
+        return;
+    }
+    for (int y = 0; y < h; ++y)
+        fn(map + (std::size_t)y * (std::size_t)w, mask.ptr<std::uint8_t>(y), w, thr);
+}
+
+void binarize(const cv::Mat& map, float thr, cv::Mat& mask, SimdLevel level) {
+    if (map.empty() || map.type() != CV_32F) {
+        mask.release();
+        return;
+    }
+    if (map.isContinuous()) {
+        binarize(map.ptr<float>(0), map.cols, map.rows, thr, mask, level);
+        return;
+    }
+
+    mask.create(map.rows, map.cols, CV_8U);
+    const BinarizeRowFn fn = binarize_fn_for(level);
+    for (int y = 0; y < map.rows; ++y)
+        fn(map.ptr<float>(y), mask.ptr<std::uint8_t>(y), map.cols, thr);
+}
+
+void binarize(const cv::Mat& map, float thr, cv::Mat& mask, std::vector<std::uint8_t>& row_active, SimdLevel level) {
+    if (map.empty() || map.type() != CV_32F) {
+        mask.release();
+        row_active.clear();
+        return;
+    }
+
+    mask.create(map.rows, map.cols, CV_8U);
+    row_active.resize((std::size_t)map.rows);
+    const BinarizeRowFn fn = binarize_fn_for(level);
+    for (int y = 0; y < map.rows; ++y)
+        row_active[(std::size_t)y] = fn(map.ptr<float>(y), mask.ptr<std::uint8_t>(y), map.cols, thr) ? 1 : 0;
+}
+
+void pool_map(const cv::Mat& src, cv::Mat& dst, bool average, SimdLevel level) {
+    if (src.empty() || src.type() != CV_32F || src.rows < 2 || src.cols < 2) {
+        dst.release();
+        return;
+    }
+
+    dst.create(src.rows / 2, src.cols / 2, CV_32F);
+    const PoolRowFn fn = pool_fn_for(level);
+    for (int y = 0; y < dst.rows; ++y)
+        fn(src.ptr<float>(2 * y), src.ptr<float>(2 * y + 1), dst.ptr<float>(y), dst.cols, average);
+}
+
+void quantize_u8(const cv::Mat& map, bool logits, const std::vector<std::uint8_t>& row_active, cv::Mat& dst,
+                 SimdLevel level) {
+    if (map.empty() || map.type() != CV_32F) {
+        dst.release();
+        return;
+    }
+
+    dst.create(map.rows, map.cols, CV_8U);
+    const bool all_rows = row_active.size() != (std::size_t)map.rows;
+    if (!logits) {
+        const QuantizeRowFn fn = quantize_fn_for(level);
+        for (int y = 0; y < map.rows; ++y)
+            fn(map.ptr<float>(y), dst.ptr<std::uint8_t>(y), map.cols);
+        return;
+    }
+
+    for (int y = 0; y < map.rows; ++y) {
+        std::uint8_t* out = dst.ptr<std::uint8_t>(y);
+        if (!all_rows && !row_active[(std::size_t)y]) {
+            std::fill(out, out + map.cols, (std::uint8_t)0);
+            continue;
+        }
+        const float* in = map.ptr<float>(y);
+        for (int x = 0; x < map.cols; ++x)
+            out[x] = quantize_one(1.0f / (1.0f + std::exp(-in[x])));
+    }
+}
+
+void active_regions(const cv::Mat& mask, const std::vector<std::uint8_t>& row_active, int min_gap,
+                    std::vector<cv::Rect>& regions, std::vector<std::uint8_t>& cols) {
+    regions.clear();
+    if (mask.empty() || mask.type() != CV_8U || row_active.size() != (std::size_t)mask.rows) return;
+    min_gap = std::max(1, min_gap);
+
+    const int w = mask.cols;
+    const int h = mask.rows;
+    int y = 0;
+    while (y < h) {
+        if (!row_active[(std::size_t)y]) {
+            ++y;
+            continue;
+        }
+
+        // Band of active rows; gaps shorter than min_gap stay inside it.
+        const int y0 = y;
+        int y1 = y + 1; // one past the last active row
+        for (int gap = 0, r = y1; r < h && gap < min_gap; ++r) {
+            if (row_active[(std::size_t)r]) {
+                y1 = r + 1;
+                gap = 0;
+            } else {
+                ++gap;
+            }
+        }
+        y = y1;
+
+        // Column occupancy of the band (the compiler vectorizes the byte OR).
+        cols.assign((std::size_t)w, 0);
+        std::uint8_t* c = cols.data();
+        for (int r = y0; r < y1; ++r) {
+            const std::uint8_t* row = mask.ptr<std::uint8_t>(r);
+            for (int x = 0; x < w; ++x)
+                c[x] |= row[x];
+        }
+
+        int x = 0;
+        while (x < w) {
+            if (!c[x]) {
+                ++x;
+                continue;
+            }
+            const int x0 = x;
+            int x1 = x + 1;
+            for (int gap = 0, i = x1; i < w && gap < min_gap; ++i) {
+                if (c[i]) {
+                    x1 = i + 1;
+                    gap = 0;
+                } else {
+                    ++gap;
+                }
+            }
+            regions.emplace_back(x0, y0, x1 - x0, y1 - y0);
+            x = x1;
+        }
+    }
+}
+
+void find_contours_sparse(const cv::Mat& mask, const std::vector<std::uint8_t>& row_active,
+                          std::vector<std::vector<cv::Point>>& contours, ContourScratch& scratch) {
+    contours.clear();
+    if (mask.empty()) return;
+
+    active_regions(mask, row_active, kRegionGap, scratch.regions, scratch.cols);
+    if (scratch.regions.empty()) return;
+
+    double covered = 0.0;
+    for (const cv::Rect& r : scratch.regions)
+        covered += (double)r.area();
+    if (covered > kDenseCoverage * (double)mask.total()) {
+        cv::findContours(mask, contours, cv::RETR_LIST, cv::CHAIN_APPROX_SIMPLE);
+        return;
+    }
+
+    // Regions are separated by empty rows or columns, so no component or hole spans two of
+    // them; findContours pads every ROI with zeros, exactly like the neighbouring empty pixels.
+    for (const cv::Rect& r : scratch.regions) {
+        cv::findContours(mask(r), scratch.block, cv::RETR_LIST, cv::CHAIN_APPROX_SIMPLE, r.tl());
+        for (auto& c : scratch.block)
+            contours.push_back(std::move(c));
+    }
+}
+
+} // namespace idet::algo
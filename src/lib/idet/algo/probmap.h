@@ -0,0 +1,201 @@
+/**
+ * @file probmap.h
+ * @ingroup idet_algo
+ * @brief Probability-map kernels for DBNet-style postprocessing (binarization, logit thresholds, gating).
+ *
+ * @details
+ * DBNet exports either probabilities or logits. Binarizing a logit map does not require the
+ * sigmoid: since it is monotonic, @c sigmoid(x) > t is equivalent to @c x > logit(t).
+ * The postprocess therefore makes a single SIMD sweep over the raw model output to build the
+ * binary mask and evaluates the sigmoid only for pixels inside contours that get scored
+ * (see @ref idet::algo::contour_score_sigmoid).
+ *
+ * The same sweep records which rows have foreground, so that contour extraction
+ * (@ref idet::algo::find_contours_sparse) only visits the regions that have any.
+ *
+ * Anchor decoders use the same idea through @ref idet::algo::select_ge: one compare pass over a
+ * raw score row yields the indices of the few locations worth decoding.
+ *
+ * Two optional reductions make the rest of the postprocess cheaper: @ref idet::algo::pool_map
+ * halves the map (2x2 max or average) before binarization, and @ref idet::algo::quantize_u8 turns
+ * it into 8-bit probabilities that the scoring functions read at a quarter of the bandwidth.
+ *
+ * The SIMD backend follows @ref preprocess.h: AVX2 / AVX-512F on x86-64 and NEON on AArch64,
+ * selected once at runtime.
+ */
+
+#pragma once
+
+#include "algo/preprocess.h"
+#include "internal/opencv_headers.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <vector>
+
+namespace idet::algo {
+
+/**
+ * @brief Logit-space equivalent of probability threshold @p p.
+ *
+ * @details
+ * Returns @c log(p / (1 - p)); @p p <= 0 maps to -inf and @p p >= 1 to +inf, so that
+ * `x > logit_threshold(p)` matches `sigmoid(x) > p` for every finite logit @c x up to float
+ * rounding of the sigmoid right at the threshold.
+ */
+float logit_threshold(float p) noexcept;
+
+/**
+ * @brief Writes `dst[i] = (src[i] > thr) ? 255 : 0` for @p n elements (NaN maps to 0).
+ *
+ * @param src Input values.
+ * @param dst Output mask bytes.
+ * @param n Number of elements.
+ * @param thr Threshold (probability or logit space, matching @p src).
+ * @param level SIMD backend; unsupported levels fall back to @ref best_simd_level().
+ * @return True if at least one element passed.
+ */
+bool binarize_row(const float* src, std::uint8_t* dst, int n, float thr,
+                  SimdLevel level = best_simd_level()) noexcept;
+
+/**
+ * @brief Gathers the indices of elements with `src[i] >= thr`, in increasing order.
+ *
+ * @details
+ * NaN never passes. @p idx must hold @p n entries.
+ *
+ * @param src Input values.
+ * @param n Number of elements.
+ * @param thr Threshold (probability or logit space, matching @p src).
+ * @param idx Output indices into @p src.
+ * @param level SIMD backend; unsupported levels fall back to @ref best_simd_level().
+ * @return Number of indices written.
+ */
+int select_ge(const float* src, int n, float thr, int* idx, SimdLevel level = best_simd_level()) noexcept;
+
+/**
+ * @brief Binarizes a dense HxW float map into @p mask (@c CV_8U, 0/255).
+ *
+ * @details
+ * @p mask is (re)created only when its size or type differs, so a reused mask does not allocate.
+ *
+ * @param map Row-major HxW floats (no padding).
+ * @param w Map width (> 0).
+ * @param h Map height (> 0).
+ * @param thr Threshold in the same space as @p map.
+ * @param mask Output mask.
+ * @param level SIMD backend.
+ *
+ * @throws cv::Exception / std::bad_alloc If @p mask cannot be allocated.
+ */
+void binarize(const float* map, int w, int h, float thr, cv::Mat& mask, SimdLevel level = best_simd_level());
+
+/**
+ * @brief Same as above for a @c CV_32F matrix that may be a strided view (e.g. a cropped ROI).
+ *
+ * @param map Single-channel float map; rows need not be contiguous.
+ * @param thr Threshold in the same space as @p map.
+ * @param mask Output mask of the same size.
+ * @param level SIMD backend.
+ */
+void binarize(const cv::Mat& map, float thr, cv::Mat& mask, SimdLevel level = best_simd_level());
+
+/**
+ * @brief Same as above, and records per row whether it has foreground.
+ *
+ * @param map Single-channel float map; rows need not be contiguous.
+ * @param thr Threshold in the same space as @p map.
+ * @param mask Output mask of the same size.
+ * @param row_active Output with one entry per row: 1 if any pixel of the row passed, else 0.
+ * @param level SIMD backend.
+ */
+void binarize(const cv::Mat& map, float thr, cv::Mat& mask, std::vector<std::uint8_t>& row_active,
+              SimdLevel level = best_simd_level());
+
+/**
+ * @brief Splits the foreground of @p mask into rectangles that contour extraction can process independently.
+ *
+ * @details
+ * Rows are grouped into bands of active rows, then every band into runs of columns with
+ * foreground. Neighbouring rectangles are separated by at least @p min_gap empty rows or columns
+ * (shorter gaps are merged), so every 8-connected component, holes included, lies inside exactly
+ * one rectangle. Rectangles come in raster order of their top-left corner.
+ *
+ * @param mask Binary @c CV_8U mask.
+ * @param row_active Row occupancy of @p mask (see @ref binarize).
+ * @param min_gap Smallest gap (>= 1) that separates two rectangles.
+ * @param regions Output rectangles.
+ * @param cols Scratch for the column occupancy of a band.
+ */
+void active_regions(const cv::Mat& mask, const std::vector<std::uint8_t>& row_active, int min_gap,
+                    std::vector<cv::Rect>& regions, std::vector<std::uint8_t>& cols);
+
+/**
+ * @brief Halves a map with 2x2 pooling: `dst(y, x)` reduces `src(2y..2y+1, 2x..2x+1)`.
+ *
+ * @details
+ * The output is `floor(h / 2) x floor(w / 2)`; an odd last row or column is dropped (model maps
+ * of 32-aligned inputs are even). Max pooling commutes with the sigmoid, so it applies to logit
+ * maps unchanged; averaging logits approximates averaging probabilities. @p dst is (re)created
+ * only when its size or type differs.
+ *
+ * @param src Single-channel @c CV_32F map; rows need not be contiguous.
+ * @param dst Output map (must not alias @p src).
+ * @param average Average instead of maximum.
+ * @param level SIMD backend; unsupported levels fall back to @ref best_simd_level().
+ *
+ * @throws cv::Exception / std::bad_alloc If @p dst cannot be allocated.
+ */
+void pool_map(const cv::Mat& src, cv::Mat& dst, bool average, SimdLevel level = best_simd_level());
+
+/**
+ * @brief Quantizes a map to 8-bit probabilities: `dst = round(255 * p)`, clamped (NaN maps to 0).
+ *
+ * @details
+ * Probability maps are converted in one SIMD sweep. Logit maps are activated first; to keep the
+ * sigmoid off the background, only rows marked in @p row_active are converted and the others are
+ * written as 0 (they lie below the binarization threshold anyway). @p dst is (re)created only
+ * when its size or type differs.
+ *
+ * @param map Single-channel @c CV_32F map; rows need not be contiguous.
+ * @param logits Whether @p map holds logits.
+ * @param row_active Rows to convert for logit maps (see @ref binarize); empty converts every row.
+ * @param dst Output @c CV_8U map of the same size.
+ * @param level SIMD backend; unsupported levels fall back to @ref best_simd_level().
+ *
+ * @throws cv::Exception / std::bad_alloc If @p dst cannot be allocated.
+ */
+void quantize_u8(const cv::Mat& map, bool logits, const std::vector<std::uint8_t>& row_active, cv::Mat& dst,
+                 SimdLevel level = best_simd_level());
+
+/** @brief Reusable buffers of @ref find_contours_sparse. */
+struct ContourScratch {
+    std::vector<cv::Rect> regions;             ///< Active regions of the current mask
+    std::vector<std::uint8_t> cols;            ///< Column occupancy of one band
+    std::vector<std::vector<cv::Point>> block; ///< Contours of one region
+};
+
+/** @brief Empty rows/columns that separate two regions of @ref find_contours_sparse. */
+constexpr int kRegionGap = 4;
+
+/** @brief Region coverage of the mask above which @ref find_contours_sparse scans the whole mask at once. */
+constexpr double kDenseCoverage = 0.5;
+
+/**
+ * @brief @c cv::findContours (@c RETR_LIST, @c CHAIN_APPROX_SIMPLE) restricted to the active regions of @p mask.
+ *
+ * @details
+ * Yields the same contours with the same points as one call over the whole mask, possibly in a
+ * different order, while the tracer only scans @ref active_regions. When the regions cover more
+ * than @ref kDenseCoverage of the mask, the whole mask is scanned at once instead.
+ *
+ * @param mask Binary @c CV_8U mask.
+ * @param row_active Row occupancy of @p mask (see @ref binarize).
+ * @param contours Output contours in mask coordinates.
+ * @param scratch Reused buffers.
+ *
+ * @throws cv::Exception / std::bad_alloc On OpenCV or allocation failure.
+ */
+void find_contours_sparse(const cv::Mat& mask, const std::vector<std::uint8_t>& row_active,
+                          std::vector<std::vector<cv::Point>>& contours, ContourScratch& scratch);
+
+} // namespace idet::algo
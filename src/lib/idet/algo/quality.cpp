@@ -0,0 +1,48 @@
+/**
+ * @file quality.cpp
+ * @ingroup idet_algo
+ * @brief Implementation of the quality level controller.
+ */
+
+#include "algo/quality.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace idet::algo {
+
+void QualityController::reset(std::vector<double> costs) noexcept {
+    costs_ = std::move(costs);
+    step_(0);
+}
+
+void QualityController::step_(int level) noexcept {
+    level_ = level;
+    since_ = 0;
+    ema_ms_ = 0.0;
+}
+
+int QualityController::observe(double ms, int queue, const QualityParams& p) noexcept {
+    if (ms >= 0.0) ema_ms_ = ema_ms_ > 0.0 ? ema_ms_ + 0.2 * (ms - ema_ms_) : ms;
+    if (++since_ < std::max(1, p.hold)) return level_;
+
+    const bool slow = p.target_ms > 0.0 && ema_ms_ > p.target_ms;
+    const bool queued = p.max_queue > 0 && queue > p.max_queue;
+    if (slow || queued) {
+        if (level_ + 1 < levels()) step_(level_ + 1);
+        return level_;
+    }
+    if (level_ == 0) return level_;
+
+    // Stepping up needs room for the costlier level on both signals.
+    if (p.max_queue > 0 && queue > p.max_queue / 2) return level_;
+    if (p.target_ms > 0.0) {
+        const std::size_t l = (std::size_t)level_;
+        const double up_ms = ema_ms_ * costs_[l - 1] / std::max(costs_[l], 1e-9);
+        if (!(ema_ms_ > 0.0) || up_ms > p.recover * p.target_ms) return level_;
+    }
+    step_(level_ - 1);
+    return level_;
+}
+
+} // namespace idet::algo
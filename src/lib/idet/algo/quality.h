@@ -0,0 +1,86 @@
+/**
+ * @file quality.h
+ * @ingroup idet_algo
+ * @brief Level controller of the load-adaptive quality control (see @ref idet::QualityOptions).
+ *
+ * @details
+ * @ref idet::algo::QualityController turns a stream of measured call latencies and queue depths
+ * into a quality level: 0 is the configured resolution, higher levels are cheaper. It keeps an
+ * exponential moving average of the latency at the current level and
+ * - steps down (to a higher level) when the average exceeds the latency target or the queue is
+ *   deeper than its limit,
+ * - steps back up when the latency predicted for the level above (the current average scaled by
+ *   the relative costs of the two levels) fits the target with some headroom and the queue is
+ *   short.
+ *
+ * Every change restarts the average and holds the level for a number of calls, so the decision
+ * is always based on latencies measured at the level in effect. Applying a level is up to the
+ * caller.
+ *
+ * @note Not thread-safe; the detector serializes @ref idet::algo::QualityController::observe.
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace idet::algo {
+
+/**
+ * @brief Parameters of @ref QualityController::observe.
+ */
+struct QualityParams {
+    double target_ms = 0.0; ///< Latency target (<= 0: the queue alone decides)
+    int max_queue = 0;      ///< Queue depth above which the level steps down (<= 0: latency alone decides)
+    double recover = 0.8;   ///< Headroom factor in (0, 1] the predicted latency must fit before stepping up
+    int hold = 8;           ///< Calls measured at a level before it may change (>= 1)
+};
+
+/**
+ * @brief Hysteresis controller selecting a quality level from latency and queue depth.
+ */
+class QualityController {
+  public:
+    /**
+     * @brief Starts over at level 0 with one entry of @p costs per level.
+     *
+     * @param costs Relative cost of each level (level 0 first, all > 0; typically non-increasing).
+     *              Empty: a single level, the controller never moves.
+     */
+    void reset(std::vector<double> costs) noexcept;
+
+    /**
+     * @brief Records one call and returns the level for the next ones.
+     *
+     * @param ms Latency of the call (< 0: no latency sample, e.g. an asynchronous submission).
+     * @param queue Calls or frames waiting at the time of the call.
+     * @param p Targets and hysteresis.
+     */
+    int observe(double ms, int queue, const QualityParams& p) noexcept;
+
+    /** @brief Current level in [0, @ref levels). */
+    int level() const noexcept {
+        return level_;
+    }
+
+    /** @brief Number of levels (at least 1). */
+    int levels() const noexcept {
+        return costs_.empty() ? 1 : (int)costs_.size();
+    }
+
+    /** @brief Average latency measured at the current level (0 before the first sample). */
+    double latency_ms() const noexcept {
+        return ema_ms_;
+    }
+
+  private:
+    /** @brief Moves to @p level and restarts the measurement. */
+    void step_(int level) noexcept;
+
+    std::vector<double> costs_;
+    int level_ = 0;
+    int since_ = 0;       ///< Calls observed since the last change
+    double ema_ms_ = 0.0; ///< Latency average at @ref level_ (0: no sample yet)
+};
+
+} // namespace idet::algo
@@ -0,0 +1,119 @@
+/**
+ * @file tile_cache.h
+ * @ingroup idet_algo
+ * @brief Per-tile change detection and detection cache for streaming tiled inference.
+ *
+ * @details
+ * For fixed cameras most tiles of a frame do not change between frames. @ref idet::algo::TileCache
+ * remembers, for every tile of the grid built by @ref idet::algo::make_tiles:
+ * - the tile pixels at the time the tile was last inferred (the reference),
+ * - the detections produced by that inference (full-image coordinates).
+ *
+ * Each frame, @ref idet::algo::TileCache::plan compares the tiles against their references (or
+ * reads an external motion mask) and marks only tiles whose content changed as dirty.
+ * @ref idet::algo::infer_tiled then runs the engine on dirty tiles and reuses the cached
+ * detections of clean ones, and the caller applies global NMS over the union as usual.
+ *
+ * Comparing against the reference of the last inference rather than the previous frame means a
+ * slow drift (lighting, a slowly moving object) still triggers a rerun once it accumulates.
+ *
+ * @note A cache belongs to one stream; it is not thread-safe except that @ref store may be called
+ *       concurrently for distinct tiles.
+ */
+
+#pragma once
+
+#include "algo/geometry.h"
+#include "internal/opencv_headers.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <vector>
+
+namespace idet::algo {
+
+/**
+ * @brief Thresholds deciding when a tile counts as changed.
+ */
+struct TileChangeParams {
+    int pixel_diff = 16;        ///< A sample changed if any channel differs by more than this
+    float min_changed = 0.005f; ///< Tile is dirty when more than this fraction of samples changed
+    int sample_step = 2;        ///< Sampling stride in x and y (1 = every pixel)
+    int refresh_frames = 0;     ///< Rerun a tile after this many reused frames (0 = never)
+};
+
+/**
+ * @brief Fraction of sampled pixels where @p a and @p b differ by more than @p pixel_diff.
+ *
+ * @param a First image (@c CV_8UC3).
+ * @param b Second image, same size and type as @p a.
+ * @param pixel_diff Per-channel absolute difference threshold.
+ * @param step Sampling stride in both directions (clamped to >= 1).
+ * @return Fraction in [0, 1]; 1 if the images are not comparable.
+ */
+float changed_fraction(const cv::Mat& a, const cv::Mat& b, int pixel_diff, int step) noexcept;
+
+/**
+ * @brief Fraction of sampled non-zero pixels of a motion mask.
+ *
+ * @param mask Motion mask region (@c CV_8UC1, non-zero = moving).
+ * @param step Sampling stride in both directions (clamped to >= 1).
+ * @return Fraction in [0, 1]; 1 for an empty or non-@c CV_8UC1 mask.
+ */
+float mask_fraction(const cv::Mat& mask, int step) noexcept;
+
+/**
+ * @brief Tile references and cached detections of one video stream.
+ */
+class TileCache final {
+  public:
+    /** @brief Drops all references and detections; the next @ref plan marks every tile dirty. */
+    void reset() noexcept;
+
+    /**
+     * @brief Decides which tiles of @p bgr must be inferred and refreshes their references.
+     *
+     * @details
+     * Every tile is dirty when the cache is empty, when the frame size or the tile layout changed,
+     * or when @p force_all is set. Otherwise a tile is dirty when its changed fraction exceeds
+     * @c p.min_changed or it has been reused for @c p.refresh_frames frames. With @p motion_mask
+     * the fraction is read from the mask instead of being computed against the reference, and no
+     * reference pixels are kept.
+     *
+     * @param bgr Current frame (@c CV_8UC3).
+     * @param rects Tiles of the frame (see @ref make_tiles).
+     * @param motion_mask Optional full-frame @c CV_8UC1 mask (non-zero = changed); null to diff.
+     * @param p Change thresholds.
+     * @param force_all Mark every tile dirty.
+     * @return Number of dirty tiles.
+     *
+     * @throws std::bad_alloc On allocation failure.
+     */
+    int plan(const cv::Mat& bgr, const std::vector<cv::Rect>& rects, const cv::Mat* motion_mask,
+             const TileChangeParams& p, bool force_all = false);
+
+    /** @brief Number of tiles of the current plan. */
+    int size() const noexcept {
+        return (int)rects_.size();
+    }
+
+    /** @brief True if tile @p i must be inferred this frame. */
+    bool dirty(int i) const noexcept {
+        return dirty_[(std::size_t)i] != 0;
+    }
+
+    /** @brief Replaces the cached detections of tile @p i (full-image coordinates). */
+    void store(int i, const std::vector<Detection>& dets);
+
+    /** @brief Appends the cached detections of every clean tile to @p out. */
+    void append_clean(std::vector<Detection>& out) const;
+
+  private:
+    std::vector<cv::Rect> rects_;              ///< Tile layout the cache was built for
+    int frame_w_ = 0, frame_h_ = 0;            ///< Frame size the cache was built for
+    std::vector<cv::Mat> refs_;                ///< Tile pixels at their last inference
+    std::vector<std::vector<Detection>> dets_; ///< Detections of the last inference per tile
+    std::vector<int> age_;                     ///< Frames each tile has been reused since
+    std::vector<std::uint8_t> dirty_;          ///< Plan of the current frame
+};
+
+} // namespace idet::algo
@@ -0,0 +1,258 @@
+/**
+ * @file tile_merge.cpp
+ * @ingroup idet_algo
+ * @brief Implementation of @ref idet::algo::merge_tiled.
+ *
+ * @details
+ * Steps:
+ *  1) Tile adjacency: tiles whose rectangles come within the seam margin of each other (CSR).
+ *  2) Optional per-tile NMS (each tile's list is small, so this is cheaper than a global pass).
+ *  3) Classification: a detection is a seam candidate if its AABB reaches a neighbour tile.
+ *  4) NMS over seam candidates only.
+ *  5) Optional seam repair: drop covered border fragments, join abutting fragments.
+ *  6) Surviving candidates sorted by final score.
+ *
+ * Only steps 4-5 look at pairs of detections, and only at seam candidates.
+ */
+
+#include "algo/tile_merge.h"
+
+#include "algo/nms.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace idet::algo {
+
+namespace {
+
+/** @brief Own-tile borders a detection touches (bit set). */
+enum : unsigned { kLeft = 1u, kRight = 2u, kTop = 4u, kBottom = 8u };
+
+/** @brief Coverage of a fragment by a detection of another tile above which it is dropped. */
+constexpr float kFragmentCover = 0.8f;
+
+/** @brief Minimum overlap across the seam (fraction of the smaller extent) for joining. */
+constexpr float kJoinOverlap = 0.5f;
+
+static inline AABB box_of(const Detection& d) noexcept {
+    AABB b{d.pts[0].x, d.pts[0].y, d.pts[0].x, d.pts[0].y};
+    for (int k = 1; k < 4; ++k) {
+        b.minx = std::min(b.minx, d.pts[k].x);
+        b.miny = std::min(b.miny, d.pts[k].y);
+        b.maxx = std::max(b.maxx, d.pts[k].x);
+        b.maxy = std::max(b.maxy, d.pts[k].y);
+    }
+    return b;
+}
+
+/** @brief True if @p b comes within @p m pixels of @p r. */
+static inline bool near_rect(const AABB& b, const cv::Rect& r, float m) noexcept {
+    return !(b.maxx < (float)r.x - m || b.minx > (float)(r.x + r.width) + m || b.maxy < (float)r.y - m ||
+             b.miny > (float)(r.y + r.height) + m);
+}
+
+static inline float area_of(const AABB& b) noexcept {
+    return std::max(0.f, b.maxx - b.minx) * std::max(0.f, b.maxy - b.miny);
+}
+
+static inline float inter_of(const AABB& a, const AABB& b) noexcept {
+    const float w = std::min(a.maxx, b.maxx) - std::max(a.minx, b.minx);
+    const float h = std::min(a.maxy, b.maxy) - std::max(a.miny, b.miny);
+    return (w > 0.f && h > 0.f) ? w * h : 0.f;
+}
+
+/** @brief 1D overlap of [a0, a1] and [b0, b1] relative to the shorter interval. */
+static inline float overlap_1d(float a0, float a1, float b0, float b1) noexcept {
+    const float len = std::min(a1 - a0, b1 - b0);
+    if (len <= 0.f) return 0.f;
+    return std::max(0.f, std::min(a1, b1) - std::max(a0, b0)) / len;
+}
+
+/**
+ * @brief Borders of tile @p r touched by @p b that are shared with another tile.
+ *
+ * @details
+ * Borders on the image boundary (@p img_w, @p img_h) never cut anything and are excluded.
+ */
+static unsigned touched_borders(const AABB& b, const cv::Rect& r, int img_w, int img_h, float m) noexcept {
+    unsigned t = 0;
+    if (r.x > 0 && b.minx <= (float)r.x + m) t |= kLeft;
+    if (r.x + r.width < img_w && b.maxx >= (float)(r.x + r.width) - m) t |= kRight;
+    if (r.y > 0 && b.miny <= (float)r.y + m) t |= kTop;
+    if (r.y + r.height < img_h && b.maxy >= (float)(r.y + r.height) - m) t |= kBottom;
+    return t;
+}
+
+/** @brief Replaces @p a by the min-area quad around @p a and @p b (score weighted by box area). */
+static void join_into(Detection& a, const AABB& ba, const Detection& b, const AABB& bb) {
+    std::vector<cv::Point2f> pts;
+    pts.reserve(8);
+    pts.insert(pts.end(), a.pts.begin(), a.pts.end());
+    pts.insert(pts.end(), b.pts.begin(), b.pts.end());
+
+    cv::Point2f q[4];
+    cv::minAreaRect(pts).points(q);
+    order_quad(q);
+    for (int k = 0; k < 4; ++k)
+        a.pts[(std::size_t)k] = q[k];
+
+    const float wa = area_of(ba), wb = area_of(bb);
+    a.score = (wa + wb > 0.f) ? (a.score * wa + b.score * wb) / (wa + wb) : std::max(a.score, b.score);
+}
+
+/** @brief Drops covered border fragments and joins fragments across seams, in place. */
+static void repair_seams(std::vector<Detection>& kept, const std::vector<cv::Rect>& rects, float m) {
+    const std::size_t n = kept.size();
+    const int nt = (int)rects.size();
+
+    int img_w = 0, img_h = 0;
+    for (const auto& r : rects) {
+        img_w = std::max(img_w, r.x + r.width);
+        img_h = std::max(img_h, r.y + r.height);
+    }
+
+    std::vector<AABB> box(n);
+    std::vector<unsigned> touch(n, 0u);
+    std::vector<char> gone(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        box[i] = box_of(kept[i]);
+        const int t = kept[i].tile;
+        if (t >= 0 && t < nt) touch[i] = touched_borders(box[i], rects[(std::size_t)t], img_w, img_h, m);
+    }
+
+    // A fragment cut by its tile border but covered by a larger detection of another tile.
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!touch[i]) continue;
+        const float ai = area_of(box[i]);
+        for (std::size_t j = 0; j < n && ai > 0.f; ++j) {
+            if (j == i || gone[j] || kept[j].tile == kept[i].tile) continue;
+            if (area_of(box[j]) > ai && inter_of(box[i], box[j]) >= kFragmentCover * ai) {
+                gone[i] = 1;
+                break;
+            }
+        }
+    }
+
+    // Fragments abutting across a seam: i ends at its tile's right/bottom border, j starts at the left/top.
+    const float gap = 2.f * m;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (gone[i] || !(touch[i] & (kRight | kBottom))) continue;
+        bool joined = true;
+        while (joined) {
+            joined = false;
+            for (std::size_t j = 0; j < n; ++j) {
+                if (j == i || gone[j] || kept[j].tile == kept[i].tile) continue;
+                const AABB& a = box[i];
+                const AABB& b = box[j];
+                const bool horiz = (touch[i] & kRight) && (touch[j] & kLeft) && b.minx > a.minx &&
+                                   b.minx - a.maxx <= gap &&
+                                   overlap_1d(a.miny, a.maxy, b.miny, b.maxy) >= kJoinOverlap;
+                const bool vert = (touch[i] & kBottom) && (touch[j] & kTop) && b.miny > a.miny &&
+                                  b.miny - a.maxy <= gap && overlap_1d(a.minx, a.maxx, b.minx, b.maxx) >= kJoinOverlap;
+                if (!horiz && !vert) continue;
+
+                join_into(kept[i], box[i], kept[j], box[j]);
+                box[i] = box_of(kept[i]);
+                // The joined box continues wherever j was cut.
+                touch[i] = (touch[i] & ~(horiz ? kRight : kBottom)) | (touch[j] & ~(horiz ? kLeft : kTop));
+                gone[j] = 1;
+                joined = true;
+                break;
+            }
+        }
+    }
+
+    std::size_t w = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!gone[i]) {
+            if (w != i) kept[w] = std::move(kept[i]);
+            ++w;
+        }
+    }
+    kept.resize(w);
+}
+
+/** @brief NMS inside every tile; detections without a valid tile form one extra group. */
+static std::vector<Detection> nms_per_tile(const std::vector<Detection>& dets, int nt, const TileMergeParams& p,
+                                           FrameArena& arena) {
+    std::vector<std::vector<Detection>> groups((std::size_t)nt + 1);
+    for (const auto& d : dets)
+        groups[(d.tile >= 0 && d.tile < nt) ? (std::size_t)d.tile : (std::size_t)nt].push_back(d);
+
+    std::vector<Detection> all, kept;
+    all.reserve(dets.size());
+    for (const auto& g : groups) {
+        if (g.size() < 2) {
+            all.insert(all.end(), g.begin(), g.end());
+            continue;
+        }
+        nms_poly(g, p.iou_thr, p.use_fast_iou, arena, kept);
+        all.insert(all.end(), kept.begin(), kept.end());
+    }
+    return all;
+}
+
+} // namespace
+
+void merge_tiled(const std::vector<Detection>& dets, const std::vector<cv::Rect>& rects, const TileMergeParams& p,
+                 FrameArena& arena, std::vector<Detection>& out) {
+    out.clear();
+    if (dets.empty()) return;
+
+    const int nt = (int)rects.size();
+    const float m = std::max(0.f, p.seam_margin_px);
+    const bool suppress = p.iou_thr > 0.0f;
+
+    std::vector<Detection> per_tile;
+    if (suppress && p.per_tile_nms) per_tile = nms_per_tile(dets, nt, p, arena);
+    const std::vector<Detection>& src = (suppress && p.per_tile_nms) ? per_tile : dets;
+
+    // Tile adjacency (CSR): neighbours of tile i are the tiles within the margin of its rectangle.
+    int* nb_ofs = arena.alloc_fill<int>((std::size_t)nt + 1, 0);
+    int* nb = arena.alloc<int>((std::size_t)nt * (std::size_t)std::max(0, nt - 1) + 1);
+    int cnt = 0;
+    for (int i = 0; i < nt; ++i) {
+        const cv::Rect& ri = rects[(std::size_t)i];
+        const AABB bi{(float)ri.x, (float)ri.y, (float)(ri.x + ri.width), (float)(ri.y + ri.height)};
+        for (int j = 0; j < nt; ++j) {
+            if (j != i && near_rect(bi, rects[(std::size_t)j], m)) nb[cnt++] = j;
+        }
+        nb_ofs[i + 1] = cnt;
+    }
+
+    std::vector<Detection> cand;
+    out.reserve(src.size());
+    for (const auto& d : src) {
+        const int t = d.tile;
+        bool seam = (t < 0 || t >= nt);
+        if (!seam) {
+            const AABB b = box_of(d);
+            for (int k = nb_ofs[t]; k < nb_ofs[t + 1] && !seam; ++k)
+                seam = near_rect(b, rects[(std::size_t)nb[k]], m);
+        }
+        if (seam)
+            cand.push_back(d);
+        else
+            out.push_back(d);
+    }
+
+    std::vector<Detection> kept;
+    if (suppress && cand.size() > 1)
+        nms_poly(cand, p.iou_thr, p.use_fast_iou, arena, kept);
+    else
+        kept.swap(cand);
+
+    if (p.join_seams && kept.size() > 1) repair_seams(kept, rects, m);
+
+    // Unsuppressed candidates and re-weighted joins are not in score order; sort like nms_poly output.
+    std::stable_sort(kept.begin(), kept.end(),
+                     [](const Detection& a, const Detection& b) { return a.score > b.score; });
+
+    out.insert(out.end(), std::make_move_iterator(kept.begin()), std::make_move_iterator(kept.end()));
+}
+
+} // namespace idet::algo
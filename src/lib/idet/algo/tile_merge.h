@@ -0,0 +1,64 @@
+/**
+ * @file tile_merge.h
+ * @ingroup idet_algo
+ * @brief Tile-geometry-aware merge of tiled detections (seam suppression and joining).
+ *
+ * @details
+ * After tiled inference, duplicates can only exist where tiles meet: a detection whose box does
+ * not reach any other tile cannot overlap a detection of another tile. @ref idet::algo::merge_tiled
+ * therefore splits the merged list into
+ * - interior detections, kept as produced by the engine, and
+ * - seam candidates (box within @c seam_margin_px of another tile), which alone go through
+ *   @ref idet::algo::nms_poly,
+ * so the suppression cost follows the seam density instead of the total detection count.
+ *
+ * Optionally, seam candidates cut by a tile border are repaired: a fragment touching its tile
+ * border and mostly covered by a detection of another tile is dropped, and two fragments abutting
+ * across a seam are joined into one quad (text lines split by the grid).
+ *
+ * @note Interior detections are not suppressed against each other. Engines whose raw per-tile
+ *       output contains duplicates (anchor-based decoders) need @c per_tile_nms.
+ */
+
+#pragma once
+
+#include "algo/arena.h"
+#include "algo/geometry.h"
+#include "internal/opencv_headers.h" // IWYU pragma: keep
+
+#include <vector>
+
+namespace idet::algo {
+
+/**
+ * @brief Parameters of @ref merge_tiled.
+ */
+struct TileMergeParams {
+    float iou_thr = 0.3f;        ///< Suppression IoU threshold (<= 0 disables suppression)
+    bool use_fast_iou = false;   ///< AABB IoU approximation (see @ref quad_iou)
+    bool per_tile_nms = false;   ///< Run NMS inside every tile first (engine output has duplicates)
+    bool join_seams = false;     ///< Drop covered border fragments and join fragments across seams
+    float seam_margin_px = 2.0f; ///< Distance to another tile below which a detection is a seam candidate
+};
+
+/**
+ * @brief Merge detections of tiled inference using the tile layout.
+ *
+ * @details
+ * Detections must carry their source tile (@ref Detection::tile, index into @p rects); detections
+ * with an unknown tile are treated as seam candidates. Interior detections keep their input order
+ * and come first in @p out, followed by the surviving seam candidates in descending order of their
+ * final score (after seam joining; stable, also when suppression is disabled).
+ *
+ * @param dets Detections in full-image coordinates (must not alias @p out).
+ * @param rects Tile rectangles the detections were produced on (see @ref make_tiles).
+ * @param p Merge parameters.
+ * @param arena Scratch arena (not reset by this function).
+ * @param out Destination for the merged detections (cleared first).
+ *
+ * @throws std::bad_alloc On allocation failure.
+ */
+void merge_tiled(const std::vector<Detection>& dets, const std::vector<cv::Rect>& rects, const TileMergeParams& p,
+                 FrameArena& arena, std::vector<Detection>& out);
+
+} // namespace idet::algo
@@ -6,15 +6,22 @@
  * @details
  * This translation unit implements:
  *  - @ref idet::algo::make_tiles : regular grid tiling with optional overlap (clipped to image bounds)
- *  - @ref idet::algo::infer_tiled : per-tile inference (optionally OpenMP-parallel) with safe bound-mode policy
+ *  - @ref idet::algo::infer_tiled : per-tile inference (optionally parallel on the library
+ *    @ref idet::platform::ThreadPool) with safe bound-mode policy
  *
  * Key design points:
  *  - Tiles are represented as @c cv::Rect in full-image coordinates.
  *  - Tile extraction uses ROI views (@c cv::Mat tile = img_bgr(rc)), i.e. no deep copy.
  *  - Detections produced by engines are assumed to be tile-local and are translated back by (rc.x, rc.y).
+ *  - Tiles are scheduled dynamically (chunk size 1): a worker takes the next tile as soon as it is
+ *    free, which keeps threads busy when tile costs differ a lot (dense text vs background).
+ *  - With tile batching, equal-sized tiles are grouped into work items of up to
+ *    @ref idet::engine::IEngine::bound_batch tiles, each run by one batched session call.
  *  - In bound mode, parallel execution is allowed only when there are enough independent contexts
- *    (see @ref idet::engine::IEngine::setup_binding). Contexts are selected as (tid % contexts).
+ *    (see @ref idet::engine::IEngine::setup_binding). Each tile checks out a context from an
+ *    @ref idet::engine::ContextPool and returns it when done.
  *  - Errors are captured best-effort: the first failing status is propagated.
+ *  - With a @ref idet::algo::TileCache, clean tiles are skipped and contribute their cached detections.
  *
  * @note This module does not apply cross-tile NMS. The caller should run @ref idet::algo::nms_poly
  *       on the merged detections if needed.
@@ -22,17 +29,21 @@
 
 #include "algo/tiling.h"
 
+#include "engine/context_pool.h"
+#include "platform/thread_pool.h"
+
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
+#include <exception>
 #include <iterator>
+#include <mutex>
+#include <new>
+#include <string>
 #include <utility>
 #include <vector>
 
-#if defined(_OPENMP)
-    #include <omp.h>
-#endif
-
 namespace idet::algo {
 
 namespace {
@@ -96,26 +107,52 @@ static inline void split_1d(int L, int K, std::vector<int>& starts, std::vector<
 }
 
 /**
- * @brief Offset a detection quad by a constant integer translation.
+ * @brief Place fixed-length segments over [0, @p L) with at least @p min_overlap overlap.
  *
  * @details
- * Tiled inference produces detections in tile-local coordinates. This helper converts
- * them back to the global image coordinate space by adding the tile origin (dx, dy)
- * to each of the 4 quad vertices.
+ * n = ceil((L - ov) / (len - ov)) segments; origins are spread evenly over [0, L - len] so the
+ * first starts at 0 and the last ends at @p L. If @p L <= @p len, one segment of length @p L.
  *
- * @param d Detection to be modified in-place.
- * @param dx Translation along X axis (pixels).
- * @param dy Translation along Y axis (pixels).
+ * @param L Total length (> 0 expected by caller).
+ * @param len Segment length (> 0 expected by caller).
+ * @param min_overlap Requested minimum overlap, clamped to [0, len - 1].
+ * @param starts Output vector of starts.
+ * @return Effective segment length (@p len, or @p L if shorter).
  */
-static inline void offset_detection(algo::Detection& d, int dx, int dy) noexcept {
+static inline int place_1d(int L, int len, int min_overlap, std::vector<int>& starts) {
+    starts.clear();
+    if (L <= len) {
+        starts.push_back(0);
+        return L;
+    }
+
+    const int ov = clampi(min_overlap, 0, len - 1);
+    const int stride = len - ov;
+    const int n = 1 + (L - len + stride - 1) / stride;
+
+    starts.reserve((size_t)n);
+    const int span = L - len;
+    for (int i = 0; i < n; ++i)
+        starts.push_back((int)(((long long)span * i) / (n - 1)));
+    return len;
+}
+
+} // namespace
+
+void offset_detection(algo::Detection& d, int dx, int dy, int tile) noexcept {
     for (int k = 0; k < 4; ++k) {
         d.pts[k].x += float(dx);
         d.pts[k].y += float(dy);
     }
+    if (d.has_kps) {
+        for (auto& p : d.kps) {
+            p.x += float(dx);
+            p.y += float(dy);
+        }
+    }
+    d.tile = tile;
 }
 
-} // namespace
-
 std::vector<cv::Rect> make_tiles(int img_w, int img_h, const GridSpec& grid, float overlap) {
     std::vector<cv::Rect> out;
 
@@ -158,9 +195,42 @@ std::vector<cv::Rect> make_tiles(int img_w, int img_h, const GridSpec& grid, flo
     return out;
 }
 
+std::vector<cv::Rect> make_adaptive_tiles(int img_w, int img_h, int tile_w, int tile_h, int min_overlap_px) {
+    std::vector<cv::Rect> out;
+
+    if (img_h <= 0 || img_w <= 0) return out;
+    if (tile_w <= 0 || tile_h <= 0) return out;
+
+    std::vector<int> xs, ys;
+    const int tw = place_1d(img_w, tile_w, min_overlap_px, xs);
+    const int th = place_1d(img_h, tile_h, min_overlap_px, ys);
+
+    out.reserve(xs.size() * ys.size());
+    for (int y : ys) {
+        for (int x : xs)
+            out.emplace_back(x, y, tw, th);
+    }
+    return out;
+}
+
+std::vector<cv::Rect> make_tiles(int img_w, int img_h, const TileLayout& layout) {
+    if (layout.adaptive())
+        return make_adaptive_tiles(img_w, img_h, layout.tile_w, layout.tile_h, layout.min_overlap_px);
+    return make_tiles(img_w, img_h, layout.grid, layout.overlap_rel);
+}
+
 Result<std::vector<algo::Detection>> infer_tiled(engine::IEngine& eng, const cv::Mat& img_bgr, bool bound, int ctx_idx,
                                                  bool parallel_bound, const GridSpec& grid, float overlap_rel,
-                                                 int tile_omp_threads) noexcept {
+                                                 int tile_omp_threads, std::vector<TileTiming>* timings,
+                                                 TileCache* cache) noexcept {
+    return infer_tiled(eng, img_bgr, bound, ctx_idx, parallel_bound, TileLayout::of_grid(grid, overlap_rel),
+                       tile_omp_threads, timings, cache);
+}
+
+Result<std::vector<algo::Detection>> infer_tiled(engine::IEngine& eng, const cv::Mat& img_bgr, bool bound, int ctx_idx,
+                                                 bool parallel_bound, const TileLayout& layout, int tile_omp_threads,
+                                                 std::vector<TileTiming>* timings, TileCache* cache,
+                                                 engine::ContextPool* shared_contexts, bool batch_tiles) noexcept {
     if (img_bgr.empty() || img_bgr.type() != CV_8UC3) {
         return Result<std::vector<algo::Detection>>::Err(Status::Invalid("infer_tiled: expected CV_8UC3 BGR"));
     }
@@ -168,30 +238,33 @@ Result<std::vector<algo::Detection>> infer_tiled(engine::IEngine& eng, const cv:
     const int img_h = img_bgr.rows;
     const int img_w = img_bgr.cols;
 
-    const auto rects = make_tiles(img_w, img_h, grid, overlap_rel);
+    std::vector<cv::Rect> rects;
+    try {
+        rects = make_tiles(img_w, img_h, layout);
+    } catch (const std::bad_alloc&) {
+        return Result<std::vector<algo::Detection>>::Err(Status::OutOfMemory("infer_tiled: bad_alloc"));
+    }
 
     const int num_tiles = (int)rects.size();
     if (num_tiles == 0) return Result<std::vector<algo::Detection>>::Ok({});
+    if (cache && cache->size() != num_tiles) {
+        return Result<std::vector<algo::Detection>>::Err(Status::Invalid("infer_tiled: cache not planned for tiles"));
+    }
 
     /**
      * @details
-     * Determine tiling loop parallelism (best-effort):
-     * - If OpenMP is available, prefer user-provided tile_omp_threads (if > 0),
-     *   otherwise use omp_get_max_threads().
-     * - If OpenMP is not available, fall back to 1.
+     * Determine tiling loop parallelism (best-effort): user-provided tile_omp_threads (if > 0),
+     * otherwise one thread per CPU of the affinity mask. The pool may start fewer helpers.
      */
-    int n_threads = 1;
-#if defined(_OPENMP)
-    n_threads = (tile_omp_threads > 0) ? tile_omp_threads : omp_get_max_threads();
-    n_threads = std::max(1, n_threads);
-#endif
+    int n_threads = (tile_omp_threads > 0) ? tile_omp_threads : platform::ThreadPool::hardware_width();
+    n_threads = std::max(1, std::min(n_threads, num_tiles));
 
     /**
      * @details
      * Bound inference safety rules:
      * - Bound mode requires eng.binding_ready().
      * - If parallel_bound is false => force single-thread execution and validate ctx_idx.
-     * - If parallel_bound is true  => use at most 'contexts' threads and map tid -> ctx via tid%contexts.
+     * - If parallel_bound is true  => use at most 'contexts' threads; each tile checks out a context.
      */
     const int contexts = eng.bound_contexts();
     if (bound) {
@@ -216,9 +289,55 @@ Result<std::vector<algo::Detection>> infer_tiled(engine::IEngine& eng, const cv:
 
     /**
      * @details
-     * Per-thread output buffers (TLS).
+     * Work items: one tile each, or with @p batch_tiles up to @c bound_batch() dirty tiles of equal
+     * size that run as one batched session call. Clean tiles of a streaming cache are only
+     * reported in the timings.
+     */
+    const int batch = (bound && batch_tiles) ? std::max(1, eng.bound_batch()) : 1;
+    std::vector<std::vector<int>> jobs;
+    try {
+        if (timings) timings->assign((std::size_t)num_tiles, TileTiming{});
+        jobs.reserve((std::size_t)num_tiles);
+        std::vector<int> open; // job index of the newest job per distinct tile size
+        for (int i = 0; i < num_tiles; ++i) {
+            if (cache && !cache->dirty(i)) {
+                if (timings) {
+                    TileTiming& tt = (*timings)[(std::size_t)i];
+                    tt.tile = i;
+                    tt.reused = true;
+                }
+                continue;
+            }
+            if (batch <= 1) {
+                jobs.push_back({i});
+                continue;
+            }
+            const cv::Size sz = rects[(std::size_t)i].size();
+            auto it = std::find_if(open.begin(), open.end(), [&](int j) {
+                const cv::Rect& rc = rects[(std::size_t)jobs[(std::size_t)j].front()];
+                return rc.width == sz.width && rc.height == sz.height;
+            });
+            if (it != open.end() && (int)jobs[(std::size_t)*it].size() < batch) {
+                jobs[(std::size_t)*it].push_back(i);
+                continue;
+            }
+            jobs.push_back({i});
+            if (it != open.end())
+                *it = (int)jobs.size() - 1;
+            else
+                open.push_back((int)jobs.size() - 1);
+        }
+    } catch (const std::bad_alloc&) {
+        return Result<std::vector<algo::Detection>>::Err(Status::OutOfMemory("infer_tiled: bad_alloc"));
+    }
+    const int num_jobs = (int)jobs.size();
+    n_threads = std::max(1, std::min(n_threads, num_jobs));
+
+    /**
+     * @details
+     * Per-worker output buffers (TLS), indexed by the pool worker id of the region.
      *
-     * We accumulate detections per-thread to avoid contention in the hot loop.
+     * We accumulate detections per-worker to avoid contention in the hot loop.
      * After the parallel region finishes, we merge all TLS vectors into one output.
      *
      * Reserve heuristic: ~4 detections per tile on average (rough guess).
@@ -233,65 +352,99 @@ Result<std::vector<algo::Detection>> infer_tiled(engine::IEngine& eng, const cv:
      * - failed: atomic flag indicating that some iteration has failed.
      * - fail_status: first captured Status (best-effort).
      *
-     * Note: we use an OpenMP critical section to reduce races on fail_status assignment.
+     * Note: fail_status assignment is serialized by fail_mu.
      */
     std::atomic<bool> failed{false};
     Status fail_status = Status::Ok();
+    std::mutex fail_mu;
 
-#if defined(_OPENMP)
-    #pragma omp parallel num_threads(n_threads)
-#endif
-    {
-#if defined(_OPENMP)
-        const int tid = omp_get_thread_num();
-#else
-        const int tid = 0;
-#endif
-        auto& local = tls[(std::size_t)tid];
-
-#if defined(_OPENMP)
-    #pragma omp for schedule(static)
-#endif
-        for (int i = 0; i < num_tiles; ++i) {
-            if (failed.load(std::memory_order_relaxed)) continue;
+    /**
+     * @details
+     * Parallel bound mode: contexts are checked out per tile rather than derived from the thread id,
+     * so a tile never depends on which thread picked it up. With n_threads <= contexts a free
+     * context of the private pool is always available and checkout does not block; a shared pool
+     * may make a tile wait for a context held by another caller (each holder returns it after one
+     * inference, so the wait is bounded).
+     */
+    engine::ContextPool own_pool((bound && parallel_bound && !shared_contexts) ? contexts : 0);
+    engine::ContextPool& ctx_pool = shared_contexts ? *shared_contexts : own_pool;
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point t_frame = Clock::now();
+
+    try {
+        platform::ThreadPool::current().parallel_for(num_jobs, n_threads, [&](int j, int tid) {
+            auto& local = tls[(std::size_t)tid];
+            if (failed.load(std::memory_order_relaxed)) return;
 
-            const cv::Rect& rc = rects[(std::size_t)i];
+            const std::vector<int>& job = jobs[(std::size_t)j];
+            const int k = (int)job.size();
 
-            // Create a view into the source image (no copy): tile shares data with img_bgr.
-            cv::Mat tile = img_bgr(rc);
+            // Views into the source image (no copy): tiles share data with img_bgr.
+            std::vector<cv::Mat> views((std::size_t)k);
+            for (int t = 0; t < k; ++t)
+                views[(std::size_t)t] = img_bgr(rects[(std::size_t)job[(std::size_t)t]]);
 
             // Context selection (bound-only):
             // - safe mode: ctx_idx
-            // - parallel mode: tid % contexts
-            const int use_ctx = bound ? (parallel_bound ? (tid % contexts) : ctx_idx) : 0;
-
-            auto r = bound ? eng.infer_bound(tile, use_ctx) : eng.infer_unbound(tile);
+            // - parallel mode: any free context, held for this job only
+            const int use_ctx = bound ? (parallel_bound ? ctx_pool.acquire() : ctx_idx) : -1;
+
+            const Clock::time_point ts = Clock::now();
+            Result<std::vector<std::vector<algo::Detection>>> r =
+                Result<std::vector<std::vector<algo::Detection>>>::Ok({});
+            if (k > 1) {
+                r = eng.infer_bound_batch(views.data(), k, use_ctx);
+            } else {
+                auto one = bound ? eng.infer_bound(views[0], use_ctx) : eng.infer_unbound(views[0]);
+                if (one.ok()) {
+                    r.value().resize(1);
+                    r.value()[0].swap(one.value()); // O(1)
+                } else {
+                    r = Result<std::vector<std::vector<algo::Detection>>>::Err(one.status());
+                }
+            }
+            const Clock::time_point te = Clock::now();
+
+            if (bound && parallel_bound) ctx_pool.release(use_ctx);
+
+            if (timings) {
+                // Tiles of one batch share the run, so they all report its span.
+                for (int i : job) {
+                    TileTiming& tt = (*timings)[(std::size_t)i];
+                    tt.tile = i;
+                    tt.context = use_ctx;
+                    tt.worker = tid;
+                    tt.start_ms = std::chrono::duration<double, std::milli>(ts - t_frame).count();
+                    tt.ms = std::chrono::duration<double, std::milli>(te - ts).count();
+                }
+            }
 
             if (!r.ok()) {
                 failed.store(true, std::memory_order_relaxed);
-#if defined(_OPENMP)
-    #pragma omp critical
-#endif
-                {
-                    // Capture the first error status (best-effort).
-                    if (fail_status.ok()) fail_status = r.status();
-                }
-                continue;
+                std::lock_guard<std::mutex> lk(fail_mu);
+                // Capture the first error status (best-effort).
+                if (fail_status.ok()) fail_status = r.status();
+                return;
             }
 
-            /**
-             * @details
-             * Move out the returned detections with O(1) swap to avoid extra allocations.
-             * The result vector holds tile-local coordinates; convert to global coords.
-             */
-            std::vector<algo::Detection> dets;
-            dets.swap(r.value()); // O(1)
-
-            for (auto& d : dets)
-                offset_detection(d, rc.x, rc.y);
-
-            local.insert(local.end(), std::make_move_iterator(dets.begin()), std::make_move_iterator(dets.end()));
-        }
+            // Detections are tile-local; convert them to global coordinates.
+            for (int t = 0; t < k; ++t) {
+                const int i = job[(std::size_t)t];
+                const cv::Rect& rc = rects[(std::size_t)i];
+                std::vector<algo::Detection>& dets = r.value()[(std::size_t)t];
+                for (auto& d : dets)
+                    offset_detection(d, rc.x, rc.y, i);
+                if (cache) cache->store(i, dets);
+                local.insert(local.end(), std::make_move_iterator(dets.begin()), std::make_move_iterator(dets.end()));
+            }
+        });
+    } catch (const std::bad_alloc&) {
+        return Result<std::vector<algo::Detection>>::Err(Status::OutOfMemory("infer_tiled: bad_alloc"));
+    } catch (const std::exception& e) {
+        return Result<std::vector<algo::Detection>>::Err(Status::Internal(std::string("infer_tiled: ") + e.what()));
+    } catch (...) {
+        return Result<std::vector<algo::Detection>>::Err(Status::Internal("infer_tiled: unknown"));
     }
 
     if (failed.load(std::memory_order_relaxed)) {
@@ -310,6 +463,7 @@ Result<std::vector<algo::Detection>> infer_tiled(engine::IEngine& eng, const cv:
     all.reserve(total);
     for (auto& v : tls)
         all.insert(all.end(), std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+    if (cache) cache->append_clean(all);
 
     return Result<std::vector<algo::Detection>>::Ok(std::move(all));
 }
@@ -6,6 +6,7 @@
  * @details
  * This module provides:
  *  - A helper to split an image into a regular grid of (optionally overlapping) tiles.
+ *  - A helper to cover an image with fixed-size tiles matching the model input (adaptive tiling).
  *  - A generic tiled inference wrapper that runs engine inference per-tile and merges detections
  *    back into the full-image coordinate space.
  *
@@ -15,17 +16,22 @@
  *    and are shifted by (tile.x, tile.y) when merging.
  *
  * Threading:
- *  - The tiling loop may use OpenMP if available (implementation-defined).
+ *  - The tiling loop runs on the library @ref idet::platform::ThreadPool (the calling thread takes
+ *    part). Tiles are handed out dynamically (one at a time), so tiles with expensive
+ *    postprocessing do not hold back a statically assigned block of others.
  *  - If bound inference is used in parallel, each concurrently processed tile must use a distinct
- *    bound context (see @ref idet::engine::IEngine::setup_binding).
+ *    bound context (see @ref idet::engine::IEngine::setup_binding); contexts are checked out per
+ *    tile from an @ref idet::engine::ContextPool.
  *
  * @note This header declares utilities only. The implementation is expected to be best-effort
- *       w.r.t. threading knobs (OpenMP thread count) and must not throw across API boundaries.
+ *       w.r.t. threading knobs (tile thread count) and must not throw across API boundaries.
  */
 
 #pragma once
 
 #include "algo/geometry.h"
+#include "algo/tile_cache.h"
+#include "engine/context_pool.h"
 #include "engine/engine.h"
 #include "idet.h"
 #include "internal/opencv_headers.h" // IWYU pragma: keep
@@ -56,6 +62,54 @@ namespace idet::algo {
  */
 std::vector<cv::Rect> make_tiles(int img_w, int img_h, const GridSpec& grid, float overlap_rel);
 
+/**
+ * @brief Cover an image with tiles of exactly @p tile_w x @p tile_h pixels.
+ *
+ * @details
+ * Per axis, the number of tiles is the smallest count that covers the image while adjacent tiles
+ * overlap by at least @p min_overlap_px; tile origins are then spread evenly so the first tile
+ * starts at 0 and the last one ends at the image border. Tiles therefore never extend past the
+ * image (no tile is padding), and with @p tile_w x @p tile_h equal to the engine input shape the
+ * tiles reach the network without resampling. An axis shorter than the tile yields a single tile
+ * spanning that axis.
+ *
+ * @param img_w Image width in pixels (must be > 0).
+ * @param img_h Image height in pixels (must be > 0).
+ * @param tile_w Tile width in pixels (must be > 0).
+ * @param tile_h Tile height in pixels (must be > 0).
+ * @param min_overlap_px Minimum overlap between neighbours; objects up to this size are whole in
+ *        at least one tile (clamped to [0, tile - 1]).
+ * @return Tile rectangles in row-major order, or an empty vector for invalid input.
+ */
+std::vector<cv::Rect> make_adaptive_tiles(int img_w, int img_h, int tile_w, int tile_h, int min_overlap_px);
+
+/**
+ * @brief How @ref infer_tiled splits a frame: a fixed grid or fixed-size (adaptive) tiles.
+ */
+struct TileLayout {
+    GridSpec grid{1, 1};    ///< Grid of @ref make_tiles (ignored when adaptive)
+    float overlap_rel = 0;  ///< Relative overlap of @ref make_tiles
+    int tile_w = 0;         ///< Adaptive tile width; adaptive when both tile sizes are > 0
+    int tile_h = 0;         ///< Adaptive tile height
+    int min_overlap_px = 0; ///< Minimum overlap of @ref make_adaptive_tiles
+
+    /** @brief True if tiles have a fixed pixel size (@ref make_adaptive_tiles). */
+    bool adaptive() const noexcept {
+        return tile_w > 0 && tile_h > 0;
+    }
+
+    /** @brief Grid layout of @ref make_tiles. */
+    static TileLayout of_grid(const GridSpec& g, float overlap) noexcept {
+        TileLayout l;
+        l.grid = g;
+        l.overlap_rel = overlap;
+        return l;
+    }
+};
+
+/** @brief Tiles of an image for @p layout (dispatches to @ref make_tiles or @ref make_adaptive_tiles). */
+std::vector<cv::Rect> make_tiles(int img_w, int img_h, const TileLayout& layout);
+
 /**
  * @brief Run inference per-tile and merge detections into full-image coordinates.
  *
@@ -77,15 +131,16 @@ std::vector<cv::Rect> make_tiles(int img_w, int img_h, const GridSpec& grid, flo
  *
  * Bound contexts:
  *  - If @p parallel_bound is false, all tiles use @p ctx_idx.
- *  - If @p parallel_bound is true, tiles are distributed across contexts using a stable rule
- *    (documented contract: @c (tile_index % eng.bound_contexts())).
- *    Correctness/performance requires that the number of concurrently processed tiles does not
- *    exceed the number of prepared contexts; otherwise contexts may be reused concurrently
- *    (which is unsafe for bound inference).
+ *  - If @p parallel_bound is true, every tile checks out a free context for the duration of its
+ *    inference, so no context is ever used by two tiles at once. The loop uses at most
+ *    @c eng.bound_contexts() threads, hence a checkout from a private pool never waits; with a
+ *    shared pool (see the layout overload) tiles wait for contexts held by other callers.
  *
- * OpenMP:
- *  - @p tile_omp_threads is a best-effort request for the tiling loop parallelism.
- *    If OpenMP is unavailable or disabled, this parameter may be ignored.
+ * Threading:
+ *  - @p tile_omp_threads is a best-effort request for the tiling loop parallelism (threads of the
+ *    library pool including the caller; <= 0: one per CPU of the affinity mask).
+ *  - Tiles are scheduled dynamically; the order of merged detections therefore depends on
+ *    scheduling when more than one thread is used (each detection carries its tile index).
  *
  * @param eng Engine instance (DBNet/SCRFD/...).
  * @param img_bgr Input image (must be CV_8UC3 BGR).
@@ -94,7 +149,11 @@ std::vector<cv::Rect> make_tiles(int img_w, int img_h, const GridSpec& grid, flo
  * @param parallel_bound If true, distribute tiles across bound contexts.
  * @param grid Grid spec (rows x cols).
  * @param overlap_rel Relative overlap between tiles in [0..0.9] (best-effort).
- * @param tile_omp_threads Desired OpenMP threads for the tiling loop (best-effort).
+ * @param tile_omp_threads Desired threads for the tiling loop (best-effort).
+ * @param timings Optional output: per-tile timings indexed by tile (resized to the tile count).
+ * @param cache Optional streaming cache, already planned for this frame's tiles (@ref TileCache::plan).
+ *              Only dirty tiles are inferred (and their detections stored back); the cached
+ *              detections of clean tiles are appended to the result.
  *
  * @return Result with concatenated detections (full-image coordinates) or an error status.
  *
@@ -103,6 +162,37 @@ std::vector<cv::Rect> make_tiles(int img_w, int img_h, const GridSpec& grid, flo
  */
 Result<std::vector<algo::Detection>> infer_tiled(engine::IEngine& eng, const cv::Mat& img_bgr, bool bound, int ctx_idx,
                                                  bool parallel_bound, const GridSpec& grid, float overlap_rel,
-                                                 int tile_omp_threads) noexcept;
+                                                 int tile_omp_threads, std::vector<TileTiming>* timings = nullptr,
+                                                 TileCache* cache = nullptr) noexcept;
+
+/**
+ * @brief Same as the grid overload, with tiles built from @p layout (grid or adaptive).
+ *
+ * @param shared_contexts Optional pool over all bound contexts shared with concurrent callers of the
+ *        same engine; parallel bound tiles check out from it instead of from a private pool.
+ * @param batch_tiles Bound mode only: pack up to @ref idet::engine::IEngine::bound_batch tiles of
+ *        equal size into one @ref idet::engine::IEngine::infer_bound_batch call (one session run
+ *        per batch instead of per tile). Tiles of a batch share one context and report the
+ *        batch's span in @p timings.
+ */
+Result<std::vector<algo::Detection>> infer_tiled(engine::IEngine& eng, const cv::Mat& img_bgr, bool bound, int ctx_idx,
+                                                 bool parallel_bound, const TileLayout& layout, int tile_omp_threads,
+                                                 std::vector<TileTiming>* timings = nullptr, TileCache* cache = nullptr,
+                                                 engine::ContextPool* shared_contexts = nullptr,
+                                                 bool batch_tiles = false) noexcept;
+
+/**
+ * @brief Translate a tile-local detection into full-image coordinates.
+ *
+ * @details
+ * Adds (@p dx, @p dy) to the 4 quad vertices and, if present, to the landmarks, then records
+ * @p tile as the source tile.
+ *
+ * @param d Detection to be modified in-place.
+ * @param dx Tile origin X (pixels).
+ * @param dy Tile origin Y (pixels).
+ * @param tile Index of the source tile.
+ */
+void offset_detection(Detection& d, int dx, int dy, int tile) noexcept;
 
 } // namespace idet::algo
@@ -0,0 +1,161 @@
+/**
+ * @file tracker.cpp
+ * @ingroup idet_algo
+ * @brief Implementation of @ref idet::algo::Tracker, the verification regions and the interval control.
+ *
+ * @details
+ * Association is greedy over the candidate pairs sorted by IoU. Streams carry tens of objects at
+ * most, so the quadratic pair list is cheaper than a Hungarian solver and gives the same matches
+ * whenever the objects do not overlap each other.
+ */
+
+#include "algo/tracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace idet::algo {
+
+namespace {
+
+/// @brief Centre of the axis-aligned box around @p d.
+cv::Point2f centre(const Detection& d) noexcept {
+    float x0 = d.pts[0].x, y0 = d.pts[0].y, x1 = x0, y1 = y0;
+    for (const cv::Point2f& p : d.pts) {
+        x0 = std::min(x0, p.x);
+        y0 = std::min(y0, p.y);
+        x1 = std::max(x1, p.x);
+        y1 = std::max(y1, p.y);
+    }
+    return {0.5f * (x0 + x1), 0.5f * (y0 + y1)};
+}
+
+/// @brief Candidate association of track @c t and detection @c d.
+struct Pair {
+    float iou;
+    int t, d;
+};
+
+} // namespace
+
+void Tracker::reset() noexcept {
+    tracks_.clear();
+    next_id_ = 1;
+}
+
+void Tracker::predict() noexcept {
+    for (Track& t : tracks_) {
+        const cv::Point2f v = t.velocity;
+        for (cv::Point2f& p : t.det.pts)
+            p += v;
+        if (t.det.has_kps) {
+            for (cv::Point2f& p : t.det.kps)
+                p += v;
+        }
+    }
+}
+
+void Tracker::update(const std::vector<Detection>& dets, const TrackParams& p, bool keyframe) {
+    std::vector<Pair> pairs;
+    for (std::size_t t = 0; t < tracks_.size(); ++t) {
+        for (std::size_t d = 0; d < dets.size(); ++d) {
+            const float iou = quad_iou(tracks_[t].det.pts, dets[d].pts, p.use_fast_iou);
+            if (iou >= p.iou_match && iou > 0.0f) pairs.push_back({iou, (int)t, (int)d});
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) { return a.iou > b.iou; });
+
+    std::vector<int> track_of(dets.size(), -1);
+    std::vector<char> matched(tracks_.size(), 0);
+    for (const Pair& pr : pairs) {
+        if (matched[(std::size_t)pr.t] || track_of[(std::size_t)pr.d] >= 0) continue;
+        matched[(std::size_t)pr.t] = 1;
+        track_of[(std::size_t)pr.d] = pr.t;
+    }
+
+    const float g = std::clamp(p.velocity_gain, 0.0f, 1.0f);
+    for (std::size_t d = 0; d < dets.size(); ++d) {
+        const int ti = track_of[d];
+        if (ti < 0) continue;
+        Track& t = tracks_[(std::size_t)ti];
+        const cv::Point2f c = centre(dets[d]);
+        const float frames = (float)(t.misses + 1);
+        t.velocity = t.velocity * (1.0f - g) + (c - t.anchor) * (g / frames);
+        t.anchor = c;
+        t.det = dets[d];
+        t.misses = 0;
+    }
+
+    std::size_t w = 0;
+    for (std::size_t t = 0; t < tracks_.size(); ++t) {
+        if (!matched[t]) {
+            if (keyframe || ++tracks_[t].misses > p.max_misses) continue;
+        }
+        if (w != t) tracks_[w] = std::move(tracks_[t]);
+        ++w;
+    }
+    tracks_.resize(w);
+
+    for (std::size_t d = 0; d < dets.size(); ++d) {
+        if (track_of[d] >= 0) continue;
+        Track t;
+        t.det = dets[d];
+        t.anchor = centre(dets[d]);
+        t.id = next_id_++;
+        tracks_.push_back(std::move(t));
+    }
+}
+
+void tracking_regions(const std::vector<Track>& tracks, int frame_w, int frame_h, float margin,
+                      std::vector<cv::Rect>& out) {
+    out.clear();
+    if (frame_w < 2 || frame_h < 2) return;
+    margin = std::max(0.0f, margin);
+
+    for (const Track& t : tracks) {
+        float x0 = t.det.pts[0].x, y0 = t.det.pts[0].y, x1 = x0, y1 = y0;
+        for (const cv::Point2f& p : t.det.pts) {
+            x0 = std::min(x0, p.x);
+            y0 = std::min(y0, p.y);
+            x1 = std::max(x1, p.x);
+            y1 = std::max(y1, p.y);
+        }
+        const float pad = margin * std::max(x1 - x0, y1 - y0);
+        const float px = pad + std::abs(t.velocity.x);
+        const float py = pad + std::abs(t.velocity.y);
+        const int rx0 = std::clamp((int)std::floor(x0 - px), 0, frame_w) & ~1;
+        const int ry0 = std::clamp((int)std::floor(y0 - py), 0, frame_h) & ~1;
+        const int rx1 = std::min(frame_w, ((int)std::ceil(x1 + px) + 1) & ~1);
+        const int ry1 = std::min(frame_h, ((int)std::ceil(y1 + py) + 1) & ~1);
+        if (rx1 - rx0 < 2 || ry1 - ry0 < 2) continue;
+        out.emplace_back(rx0, ry0, rx1 - rx0, ry1 - ry0);
+    }
+
+    // Merge until no two regions overlap; a union can newly overlap a third region.
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (std::size_t i = 0; i < out.size() && !merged; ++i) {
+            for (std::size_t j = i + 1; j < out.size(); ++j) {
+                if ((out[i] & out[j]).area() <= 0) continue;
+                out[i] = out[i] | out[j];
+                out.erase(out.begin() + (std::ptrdiff_t)j);
+                merged = true;
+                break;
+            }
+        }
+    }
+}
+
+int adapt_interval(double key_ms, double track_ms, double budget_ms, int lo, int hi) noexcept {
+    lo = std::max(1, lo);
+    hi = std::max(lo, hi);
+    if (!(budget_ms > 0.0) || key_ms <= budget_ms) return lo;
+    if (track_ms >= budget_ms) return hi;
+
+    const double k = std::ceil((key_ms - track_ms) / (budget_ms - track_ms));
+    return (int)std::clamp(k, (double)lo, (double)hi);
+}
+
+} // namespace idet::algo
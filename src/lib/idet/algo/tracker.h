@@ -0,0 +1,126 @@
+/**
+ * @file tracker.h
+ * @ingroup idet_algo
+ * @brief IoU tracker with a constant-velocity model for tracking-assisted streaming detection.
+ *
+ * @details
+ * Between two full detections (keyframes) of @ref idet::Detector::detect_track, objects are not
+ * searched for in the whole frame. @ref idet::algo::Tracker instead
+ * - moves every track by its per-frame velocity (@ref idet::algo::Tracker::predict),
+ * - lists small regions around the predicted boxes (@ref idet::algo::tracking_regions) that the
+ *   detector verifies with ordinary (bound) inference on crops,
+ * - associates the verified detections with the predictions by IoU
+ *   (@ref idet::algo::Tracker::update) and refines the velocities.
+ *
+ * @ref idet::algo::adapt_interval picks the keyframe interval that keeps the amortized per-frame
+ * cost within a budget.
+ *
+ * @note A tracker belongs to one stream and is not thread-safe.
+ */
+
+#pragma once
+
+#include "algo/geometry.h"
+#include "internal/opencv_headers.h" // IWYU pragma: keep
+
+#include <vector>
+
+namespace idet::algo {
+
+/**
+ * @brief Parameters of @ref Tracker::update.
+ */
+struct TrackParams {
+    float iou_match = 0.3f;      ///< Minimum IoU between a prediction and a detection to associate them
+    bool use_fast_iou = true;    ///< AABB IoU approximation (see @ref quad_iou)
+    int max_misses = 2;          ///< Unverified frames after which a track is dropped (between keyframes)
+    float velocity_gain = 0.5f;  ///< Weight of the newest displacement in the velocity estimate, in (0, 1]
+};
+
+/**
+ * @brief One tracked object.
+ */
+struct Track {
+    Detection det;             ///< Current box: last matched detection moved by the predictions since
+    cv::Point2f velocity{};    ///< Box centre displacement per frame
+    cv::Point2f anchor{};      ///< Box centre of the last matched detection
+    int id = 0;                ///< Identifier, unique per tracker until @ref Tracker::reset
+    int misses = 0;            ///< Frames since the last match (0: matched this frame)
+};
+
+/**
+ * @brief Tracks of one video stream.
+ */
+class Tracker final {
+  public:
+    /** @brief Drops every track; identifiers restart at 1. */
+    void reset() noexcept;
+
+    /** @brief Current tracks (in creation order). */
+    const std::vector<Track>& tracks() const noexcept {
+        return tracks_;
+    }
+
+    /** @brief Moves every track (box and landmarks) by its velocity; call once per frame before @ref update. */
+    void predict() noexcept;
+
+    /**
+     * @brief Associates @p dets with the predicted tracks and updates them.
+     *
+     * @details
+     * Pairs with IoU >= @c p.iou_match are matched greedily in descending IoU order. A matched
+     * track takes the detection and blends its displacement into the velocity; an unmatched
+     * detection starts a new track at rest. An unmatched track is dropped at once on a
+     * @p keyframe (the full detection is authoritative) and otherwise after @c p.max_misses
+     * consecutive misses, keeping its predicted box meanwhile.
+     *
+     * @param dets Detections of the frame in full-image coordinates.
+     * @param p Association parameters.
+     * @param keyframe Whether @p dets come from a full-frame detection.
+     *
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void update(const std::vector<Detection>& dets, const TrackParams& p, bool keyframe);
+
+  private:
+    std::vector<Track> tracks_;
+    int next_id_ = 1;
+};
+
+/**
+ * @brief Verification regions around the tracks of a frame.
+ *
+ * @details
+ * Every track contributes its box grown by @p margin times its longer side (plus the velocity,
+ * so a speeding object stays inside) on every side, clipped to the frame and aligned to even
+ * coordinates (4:2:0 chroma). Overlapping regions are merged until none overlap, so no pixel is
+ * inferred twice.
+ *
+ * @param tracks Predicted tracks.
+ * @param frame_w Frame width in pixels.
+ * @param frame_h Frame height in pixels.
+ * @param margin Growth of each box on every side, as a fraction of its longer side (>= 0).
+ * @param out Receives the regions (cleared first).
+ *
+ * @throws std::bad_alloc On allocation failure.
+ */
+void tracking_regions(const std::vector<Track>& tracks, int frame_w, int frame_h, float margin,
+                      std::vector<cv::Rect>& out);
+
+/**
+ * @brief Keyframe interval whose amortized per-frame cost fits @p budget_ms.
+ *
+ * @details
+ * With one keyframe every @c k frames the mean cost is `(key_ms + (k - 1) * track_ms) / k`, so
+ * the smallest fitting interval is `(key_ms - track_ms) / (budget_ms - track_ms)`. Budgets that
+ * tracked frames alone exceed yield @p hi.
+ *
+ * @param key_ms Cost of a keyframe.
+ * @param track_ms Cost of a tracked frame.
+ * @param budget_ms Target mean cost per frame (<= 0: no budget, returns @p lo).
+ * @param lo Smallest interval returned (>= 1).
+ * @param hi Largest interval returned (>= @p lo).
+ */
+int adapt_interval(double key_ms, double track_ms, double budget_ms, int lo, int hi) noexcept;
+
+} // namespace idet::algo
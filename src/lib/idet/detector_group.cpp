@@ -0,0 +1,294 @@
+/**
+ * @file detector_group.cpp
+ * @ingroup idet
+ * @brief Implementation of @ref idet::DetectorGroup (NUMA-sharded detector replicas).
+ *
+ * @details
+ * Every replica is a plain @ref idet::Detector owned by one @ref idet::internal::DetectorWorker
+ * thread. The worker binds itself to a NUMA node before anything else runs on it, and afterwards
+ * executes every call on its detector (creation, binding, detection). Binding the *creating*
+ * thread is what makes the placement stick:
+ * - ORT spawns its intra-op pool from the thread that creates the session, and Linux threads
+ *   inherit the CPU mask and memory policy of their creator,
+ * - weights, bound buffers and scratch are first touched by the worker or its pool, so the
+ *   default first-touch policy allocates them on the node,
+ * - tiles and postprocessing run on a replica-owned @ref idet::platform::ThreadPool, whose threads
+ *   are started from the bound worker instead of the process-wide pool.
+ *
+ * Requests are dispatched to the replica with the fewest pending calls; callers block on a
+ * future until their replica has run the call.
+ */
+
+#include "idet.h"
+
+#include "internal/detector_worker.h"
+#include "platform/cross_topology.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace idet {
+
+namespace detail {
+
+/**
+ * @brief One node-bound worker thread owning one detector.
+ *
+ * @details
+ * The worker binds itself to @ref node in the job that creates its detector.
+ */
+class Replica final {
+  public:
+    explicit Replica(platform::NumaNode node) : node_(std::move(node)) {}
+
+    internal::DetectorWorker& worker() noexcept { return worker_; }
+    const internal::DetectorWorker& worker() const noexcept { return worker_; }
+    const platform::NumaNode& node() const noexcept { return node_; }
+
+  private:
+    platform::NumaNode node_;
+    internal::DetectorWorker worker_; ///< Declared last: its thread may run jobs reading @ref node_
+};
+
+/// @brief State behind @ref idet::DetectorGroup.
+struct DetectorGroupImpl final {
+    std::vector<std::unique_ptr<Replica>> replicas;
+    std::atomic<std::size_t> rr{0}; ///< Rotating tie-break start so equal loads spread evenly
+    bool verbose = false;
+
+    /// @brief Replica with the fewest pending calls (ties resolved round-robin).
+    Replica& pick() noexcept {
+        const std::size_t n = replicas.size();
+        const std::size_t start = rr.fetch_add(1, std::memory_order_relaxed) % n;
+        std::size_t best = start;
+        int best_load = replicas[start]->worker().pending();
+        for (std::size_t k = 1; k < n && best_load > 0; ++k) {
+            const std::size_t i = (start + k) % n;
+            const int load = replicas[i]->worker().pending();
+            if (load < best_load) {
+                best = i;
+                best_load = load;
+            }
+        }
+        return *replicas[best];
+    }
+};
+
+namespace {
+
+/// @brief 16 MiB probe: large enough for a meaningful page sample, small enough to be cheap.
+constexpr std::size_t kLocalityProbeBytes = 16u << 20;
+
+/**
+ * @brief Per-replica config: private session and pools, intra-op pool sized to the replica's CPU share.
+ *
+ * Worker pool threads are not pinned: they inherit the node mask of the replica worker.
+ */
+DetectorConfig replica_config(const DetectorConfig& cfg, const platform::NumaNode& node, int replicas_on_node) {
+    DetectorConfig rc = cfg;
+    rc.runtime.share_session = false;
+    rc.runtime.ort_global_pools = false;
+    rc.runtime.pin_worker_threads = false;
+    if (rc.runtime.ort_intra_threads <= 0) {
+        const int cpus = (int)node.cpu_ids.size();
+        rc.runtime.ort_intra_threads = std::max(1, cpus / std::max(1, replicas_on_node));
+    }
+    return rc;
+}
+
+} // namespace
+
+} // namespace detail
+
+DetectorGroup::~DetectorGroup() noexcept {
+    reset();
+}
+
+DetectorGroup::DetectorGroup(DetectorGroup&& other) noexcept : impl_(other.impl_) {
+    other.impl_ = nullptr;
+}
+
+DetectorGroup& DetectorGroup::operator=(DetectorGroup&& other) noexcept {
+    if (this != &other) {
+        reset();
+        impl_ = other.impl_;
+        other.impl_ = nullptr;
+    }
+    return *this;
+}
+
+DetectorGroup::operator bool() const noexcept {
+    return impl_ && !impl_->replicas.empty();
+}
+
+void DetectorGroup::reset() noexcept {
+    delete impl_; // joins every replica worker
+    impl_ = nullptr;
+}
+
+/**
+ * @brief Creates the replica workers and their detectors.
+ *
+ * @details
+ * Workers bind to their nodes and create their detectors concurrently, so session creation
+ * (model load and graph optimization) of all replicas overlaps. The first failing replica
+ * determines the returned status; in that case all replicas are torn down again.
+ */
+Result<DetectorGroup> DetectorGroup::create(const DetectorConfig& cfg, int replicas) noexcept {
+    using R = Result<DetectorGroup>;
+
+    const Status vs = cfg.validate();
+    if (!vs.ok()) return R::Err(vs);
+    if (replicas < 0) return R::Err(Status::Invalid("DetectorGroup::create: replicas must be >= 0"));
+
+    try {
+        const auto nodes = platform::detect_numa_nodes();
+        if (nodes.empty()) return R::Err(Status::Internal("DetectorGroup::create: no CPUs available"));
+
+        const std::size_t n = replicas > 0 ? (std::size_t)replicas : nodes.size();
+        std::vector<int> per_node(nodes.size(), 0);
+        for (std::size_t i = 0; i < n; ++i)
+            ++per_node[i % nodes.size()];
+
+        auto impl = std::make_unique<detail::DetectorGroupImpl>();
+        impl->verbose = cfg.verbose;
+        impl->replicas.reserve(n);
+
+        std::vector<std::future<Status>> started;
+        started.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t ni = i % nodes.size();
+            impl->replicas.push_back(std::make_unique<detail::Replica>(nodes[ni]));
+            detail::Replica* rep = impl->replicas.back().get();
+
+            DetectorConfig rc = detail::replica_config(cfg, nodes[ni], per_node[ni]);
+            started.push_back(rep->worker().post([rep, rc = std::move(rc)]() -> Status {
+                const Status bs = platform::bind_current_thread_to_node(rep->node(), rc.runtime);
+                if (!bs.ok()) return bs;
+
+                auto dr = Detector::create(rc);
+                if (!dr.ok()) return dr.status();
+                rep->worker().detector() = std::move(dr.value());
+                return Status::Ok();
+            }));
+        }
+
+        Status first = Status::Ok();
+        for (std::size_t i = 0; i < started.size(); ++i) {
+            const Status s = started[i].get();
+            if (!s.ok() && first.ok()) {
+                first = Status{s.code, "DetectorGroup::create: replica " + std::to_string(i) + " (node " +
+                                           std::to_string(impl->replicas[i]->node().node_id) + "): " + s.message};
+            }
+        }
+        if (!first.ok()) return R::Err(first);
+
+        DetectorGroup g;
+        g.impl_ = impl.release();
+        return R::Ok(std::move(g));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("DetectorGroup::create: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("DetectorGroup::create: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("DetectorGroup::create: unknown"));
+    }
+}
+
+std::size_t DetectorGroup::size() const noexcept {
+    return impl_ ? impl_->replicas.size() : 0;
+}
+
+int DetectorGroup::replica_node(std::size_t index) const noexcept {
+    if (!impl_ || index >= impl_->replicas.size()) return -1;
+    return impl_->replicas[index]->node().node_id;
+}
+
+/**
+ * @brief Binds every replica from its own worker and optionally checks page locality.
+ *
+ * @details
+ * In verbose mode each worker additionally first-touches a probe buffer right after binding
+ * and verifies with @ref platform::verify_buffer_pages_on_nodes that its pages landed on the
+ * replica's node. A failed check means the placement did not take effect (cpuset, disabled
+ * NUMA balancing assumptions, ...) and is reported as the binding error.
+ */
+Status DetectorGroup::prepare_binding(int width, int height) noexcept {
+    if (!*this) return Status::Invalid("DetectorGroup::prepare_binding: invalid group");
+
+    try {
+        std::vector<std::future<Status>> done;
+        done.reserve(impl_->replicas.size());
+        for (auto& up : impl_->replicas) {
+            detail::Replica* rep = up.get();
+            const bool check = impl_->verbose && rep->node().node_id >= 0;
+            done.push_back(rep->worker().post([rep, width, height, check]() -> Status {
+                const Status s = rep->worker().detector().prepare_binding(width, height, /*contexts=*/1);
+                if (!s.ok() || !check) return s;
+
+                std::vector<unsigned char> probe(detail::kLocalityProbeBytes, 1); // first touch
+                return platform::verify_buffer_pages_on_nodes(probe.data(), probe.size(), {rep->node().node_id});
+            }));
+        }
+
+        Status first = Status::Ok();
+        for (auto& f : done) {
+            const Status s = f.get();
+            if (!s.ok() && first.ok()) first = s;
+        }
+        return first;
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("DetectorGroup::prepare_binding: bad_alloc");
+    } catch (const std::exception& e) {
+        return Status::Internal(std::string("DetectorGroup::prepare_binding: ") + e.what());
+    } catch (...) {
+        return Status::Internal("DetectorGroup::prepare_binding: unknown");
+    }
+}
+
+Result<VecQuad> DetectorGroup::detect(const Image& image) noexcept {
+    using R = Result<VecQuad>;
+    if (!*this) return R::Err(Status::Invalid("DetectorGroup::detect: invalid group"));
+
+    try {
+        detail::Replica& rep = impl_->pick();
+        return rep.worker().call([&rep, &image] { return rep.worker().detector().detect(image); });
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("DetectorGroup::detect: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("DetectorGroup::detect: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("DetectorGroup::detect: unknown"));
+    }
+}
+
+Status DetectorGroup::detect_ex(const Image& image, VecDetection& out) noexcept {
+    if (!*this) {
+        out.clear();
+        return Status::Invalid("DetectorGroup::detect_ex: invalid group");
+    }
+
+    try {
+        detail::Replica& rep = impl_->pick();
+        return rep.worker().call([&rep, &image, &out] { return rep.worker().detector().detect_ex(image, out); });
+    } catch (const std::bad_alloc&) {
+        out.clear();
+        return Status::OutOfMemory("DetectorGroup::detect_ex: bad_alloc");
+    } catch (const std::exception& e) {
+        out.clear();
+        return Status::Internal(std::string("DetectorGroup::detect_ex: ") + e.what());
+    } catch (...) {
+        out.clear();
+        return Status::Internal("DetectorGroup::detect_ex: unknown");
+    }
+}
+
+} // namespace idet
@@ -0,0 +1,199 @@
+/**
+ * @file capture.cpp
+ * @ingroup idet_engine
+ * @brief Implementation of capture file writing (shared per path) and loading.
+ */
+
+#include "engine/capture.h"
+
+#include <cstring>
+#include <exception>
+#include <ios>
+#include <iterator>
+#include <map>
+#include <new>
+#include <utility>
+
+namespace idet::engine {
+
+namespace {
+
+constexpr char kMagic[8] = {'I', 'D', 'E', 'T', 'C', 'A', 'P', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kMaxRank = 8;
+constexpr std::uint32_t kMaxName = 4096;
+constexpr std::uint32_t kMaxTensors = 256;
+
+template <class T> void put(std::string& b, const T& v) {
+    b.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+/// @brief Bounds-checked cursor over the file bytes.
+struct Reader {
+    const char* p;
+    const char* end;
+
+    template <class T> bool get(T& v) noexcept {
+        if ((std::size_t)(end - p) < sizeof(T)) return false;
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+
+    bool bytes(void* dst, std::size_t n) noexcept {
+        if ((std::size_t)(end - p) < n) return false;
+        std::memcpy(dst, p, n);
+        p += n;
+        return true;
+    }
+};
+
+/// @brief Result of parsing one frame.
+enum class Parse { Ok, Truncated, Malformed };
+
+Parse read_frame(Reader& r, CaptureFrame& f) {
+    std::uint32_t nt = 0;
+    if (!r.get(f.orig_w) || !r.get(f.orig_h) || !r.get(f.in_w) || !r.get(f.in_h) || !r.get(f.sx) || !r.get(f.sy) ||
+        !r.get(nt))
+        return Parse::Truncated;
+    if (f.orig_w <= 0 || f.orig_h <= 0 || f.in_w < 0 || f.in_h < 0 || nt == 0 || nt > kMaxTensors)
+        return Parse::Malformed;
+
+    f.tensors.resize(nt);
+    for (CaptureTensor& t : f.tensors) {
+        std::uint32_t len = 0, rank = 0;
+        if (!r.get(len)) return Parse::Truncated;
+        if (len > kMaxName) return Parse::Malformed;
+        t.name.resize(len);
+        if (!r.bytes(&t.name[0], len) || !r.get(rank)) return Parse::Truncated;
+        if (rank == 0 || rank > kMaxRank) return Parse::Malformed;
+
+        t.shape.resize(rank);
+        std::size_t count = 1;
+        for (std::int64_t& d : t.shape) {
+            if (!r.get(d)) return Parse::Truncated;
+            if (d < 0) return Parse::Malformed;
+            // Compared before multiplying, so a corrupt dimension cannot overflow the count.
+            const std::size_t room = (std::size_t)(r.end - r.p) / sizeof(float);
+            if (d > 0 && count > room / (std::size_t)d) return Parse::Truncated;
+            count *= (std::size_t)d;
+        }
+        if (count > (std::size_t)(r.end - r.p) / sizeof(float)) return Parse::Truncated;
+        t.data.resize(count);
+        r.bytes(t.data.data(), count * sizeof(float));
+    }
+    return Parse::Ok;
+}
+
+} // namespace
+
+Result<std::shared_ptr<CaptureWriter>> CaptureWriter::open(const std::string& path, Task task) noexcept {
+    using R = Result<std::shared_ptr<CaptureWriter>>;
+    if (path.empty()) return R::Err(Status::Invalid("capture: empty path"));
+
+    static std::mutex mu;
+    static std::map<std::string, std::weak_ptr<CaptureWriter>> open_files;
+    try {
+        std::lock_guard<std::mutex> lk(mu);
+        if (auto w = open_files[path].lock()) {
+            if (w->task_ != task) return R::Err(Status::Invalid("capture: " + path + " records another task"));
+            return R::Ok(std::move(w));
+        }
+
+        std::shared_ptr<CaptureWriter> w(new CaptureWriter(task));
+        w->f_.open(path, std::ios::binary | std::ios::trunc);
+        if (!w->f_) return R::Err(Status::NotFound("capture: cannot create " + path));
+
+        std::string head;
+        head.append(kMagic, sizeof(kMagic));
+        put(head, kVersion);
+        put(head, (std::uint32_t)task);
+        w->f_.write(head.data(), (std::streamsize)head.size());
+        w->f_.flush();
+
+        open_files[path] = w;
+        return R::Ok(std::move(w));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("capture: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("capture: ") + e.what()));
+    }
+}
+
+void CaptureWriter::append(const CaptureFrame& geom, const CaptureView* tensors, std::size_t n) noexcept {
+    try {
+        // Serialized outside the lock; only the write itself is ordered.
+        std::string b;
+        put(b, (std::int32_t)geom.orig_w);
+        put(b, (std::int32_t)geom.orig_h);
+        put(b, (std::int32_t)geom.in_w);
+        put(b, (std::int32_t)geom.in_h);
+        put(b, geom.sx);
+        put(b, geom.sy);
+        put(b, (std::uint32_t)n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const CaptureView& t = tensors[i];
+            const std::size_t len = t.name ? std::strlen(t.name) : 0;
+            put(b, (std::uint32_t)len);
+            b.append(t.name ? t.name : "", len);
+            put(b, (std::uint32_t)t.rank);
+            std::size_t count = 1;
+            for (std::size_t k = 0; k < t.rank; ++k) {
+                put(b, t.shape[k]);
+                count *= (std::size_t)t.shape[k];
+            }
+            b.append(reinterpret_cast<const char*>(t.data), count * sizeof(float));
+        }
+
+        std::lock_guard<std::mutex> lk(mu_);
+        f_.write(b.data(), (std::streamsize)b.size());
+        f_.flush(); // a crashed process still leaves its complete frames behind
+        ++frames_;
+    } catch (...) {
+        // best-effort
+    }
+}
+
+std::size_t CaptureWriter::frames() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return frames_;
+}
+
+Result<Capture> read_capture(const std::string& path) noexcept {
+    try {
+        std::ifstream f(path, std::ios::binary);
+        if (!f) return Result<Capture>::Err(Status::NotFound("capture: cannot open " + path));
+        const std::vector<char> bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        if (f.bad()) return Result<Capture>::Err(Status::NotFound("capture: read error in " + path));
+
+        Reader r{bytes.data(), bytes.data() + bytes.size()};
+        char magic[sizeof(kMagic)];
+        std::uint32_t version = 0, task = 0;
+        if (!r.bytes(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !r.get(version) ||
+            !r.get(task))
+            return Result<Capture>::Err(Status::DecodeError("capture: " + path + " is not a capture file"));
+        if (version != kVersion)
+            return Result<Capture>::Err(Status::Unsupported("capture: unsupported version " + std::to_string(version)));
+        if (task != (std::uint32_t)Task::Text && task != (std::uint32_t)Task::Face)
+            return Result<Capture>::Err(Status::DecodeError("capture: unknown task in " + path));
+
+        Capture c;
+        c.task = (Task)task;
+        while (r.p != r.end) {
+            CaptureFrame fr;
+            const Parse st = read_frame(r, fr);
+            if (st == Parse::Truncated) break;
+            if (st == Parse::Malformed)
+                return Result<Capture>::Err(Status::DecodeError("capture: malformed frame " +
+                                                                std::to_string(c.frames.size()) + " in " + path));
+            c.frames.push_back(std::move(fr));
+        }
+        return Result<Capture>::Ok(std::move(c));
+    } catch (const std::bad_alloc&) {
+        return Result<Capture>::Err(Status::OutOfMemory("capture: bad_alloc"));
+    } catch (const std::exception& e) {
+        return Result<Capture>::Err(Status::Internal(std::string("capture: ") + e.what()));
+    }
+}
+
+} // namespace idet::engine
@@ -0,0 +1,124 @@
+/**
+ * @file capture.h
+ * @ingroup idet_engine
+ * @brief Capture files of raw model outputs: recording by the ORT engines, loading for replay.
+ *
+ * @details
+ * With @ref idet::RuntimePolicy::capture_file set, DBNet and SCRFD append every decoded frame to
+ * a capture: the tensors the decoder reads (the DBNet probability plane, the SCRFD head outputs)
+ * plus the geometry mapping them back to the image. @ref idet::EngineKind::Replay reads the file
+ * and feeds the frames through the same decoders, so the postprocessing and everything above it
+ * runs without a model.
+ *
+ * File layout (host byte order, no padding):
+ * @code
+ *   "IDETCAP1" u32:version u32:task
+ *   frame*:  i32:orig_w i32:orig_h i32:in_w i32:in_h f32:sx f32:sy u32:n_tensors
+ *            { u32:name_len char[name_len] u32:rank i64[rank]:shape f32[prod(shape)] } * n_tensors
+ * @endcode
+ * A truncated last frame (writer killed mid-frame) is ignored by the reader.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "idet.h"
+#include "status.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace idet::engine {
+
+/** @brief One recorded float32 tensor. */
+struct CaptureTensor {
+    std::string name;                ///< Session output name ("prob" for the DBNet plane)
+    std::vector<std::int64_t> shape; ///< Dimensions (batch 1)
+    std::vector<float> data;         ///< Row-major values, prod(shape) entries
+};
+
+/**
+ * @brief Decoder inputs of one frame.
+ *
+ * @details
+ * DBNet frames hold a single `[H, W]` plane (already cropped to the image content) and its
+ * map-to-image scales in @ref sx / @ref sy. SCRFD frames hold the head outputs in session output
+ * order, the input shape the heads were resolved for and the image-to-input scales.
+ */
+struct CaptureFrame {
+    int orig_w = 0, orig_h = 0; ///< Source image (or tile) size
+    int in_w = 0, in_h = 0;     ///< Network input size (SCRFD; 0 for DBNet)
+    float sx = 1.0f, sy = 1.0f; ///< Scales as passed to the decoder
+    std::vector<CaptureTensor> tensors;
+};
+
+/** @brief A loaded capture file. */
+struct Capture {
+    Task task = Task::None;
+    std::vector<CaptureFrame> frames;
+};
+
+/** @brief Non-owning tensor passed to @ref CaptureWriter::append (contiguous float32 data). */
+struct CaptureView {
+    const char* name;
+    const std::int64_t* shape;
+    std::size_t rank;
+    const float* data;
+};
+
+/**
+ * @brief Thread-safe appender of capture frames, shared by all engines recording into one file.
+ *
+ * @details
+ * @ref open returns the writer already open for a path (detector replicas, cascade probes) or
+ * truncates the file and writes the header. Frames are written whole under the lock, so frames
+ * of concurrent engines interleave but never mix.
+ */
+class CaptureWriter final {
+  public:
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /**
+     * @brief Writer for @p path recording frames of @p task.
+     * @return Invalid for an empty path or a task mismatch with the open writer, NotFound if the
+     *         file cannot be created, OutOfMemory on allocation failure.
+     */
+    static Result<std::shared_ptr<CaptureWriter>> open(const std::string& path, Task task) noexcept;
+
+    /**
+     * @brief Appends one frame; I/O errors are ignored (recording is best-effort).
+     *
+     * @param geom Frame geometry (its @c tensors are not read).
+     * @param tensors Tensors of the frame.
+     * @param n Number of entries of @p tensors.
+     */
+    void append(const CaptureFrame& geom, const CaptureView* tensors, std::size_t n) noexcept;
+
+    /** @brief Frames written so far. */
+    std::size_t frames() const;
+
+  private:
+    explicit CaptureWriter(Task task) : task_(task) {}
+
+    const Task task_;
+    mutable std::mutex mu_;
+    std::ofstream f_;
+    std::size_t frames_ = 0;
+};
+
+/**
+ * @brief Loads every complete frame of a capture file.
+ *
+ * @return NotFound if unreadable, DecodeError for a bad header or a malformed frame (other than a
+ *         truncated last one), OutOfMemory on allocation failure.
+ */
+Result<Capture> read_capture(const std::string& path) noexcept;
+
+} // namespace idet::engine
@@ -0,0 +1,103 @@
+/**
+ * @file context_pool.cpp
+ * @ingroup idet_engine
+ * @brief Implementation of the bound context checkout pool.
+ *
+ * @details
+ * The free contexts form a stack linked through @c next_; the head word carries a tag that every
+ * successful exchange increments, so a head popped and pushed back by other threads between a
+ * load and the exchange (ABA) makes the exchange fail instead of linking a stale successor.
+ *
+ * Waiting: a sleeper registers in @c waiters_ before re-checking the stack under @c mu_, and
+ * @ref idet::engine::ContextPool::release reads @c waiters_ after its push; with both accesses
+ * sequentially consistent either the sleeper sees the returned context or the releaser sees the
+ * sleeper and notifies it under the mutex.
+ */
+
+#include "engine/context_pool.h"
+
+#include <cstddef>
+
+namespace idet::engine {
+
+ContextPool::ContextPool(int contexts)
+    : size_(contexts > 0 ? contexts : 0), next_(new std::atomic<int>[(std::size_t)(size_ > 0 ? size_ : 1)]) {
+    // Linked so that the first acquire() returns context 0.
+    for (int k = 0; k < size_; ++k)
+        next_[(std::size_t)k].store(k + 1 < size_ ? k + 1 : -1, std::memory_order_relaxed);
+    head_.store(pack_(0, size_ > 0 ? 0 : -1), std::memory_order_relaxed);
+    free_count_.store(size_, std::memory_order_relaxed);
+}
+
+int ContextPool::acquire() noexcept {
+    int k = -1;
+    if (size_ == 0 || try_acquire(k)) return k;
+    (void)wait_(k, nullptr);
+    return k;
+}
+
+bool ContextPool::try_acquire(int& ctx) noexcept {
+    std::uint64_t h = head_.load(std::memory_order_acquire);
+    for (;;) {
+        const int top = (int)(std::uint32_t)h - 1;
+        if (top < 0) return false;
+        const int nxt = next_[(std::size_t)top].load(std::memory_order_relaxed);
+        if (head_.compare_exchange_weak(h, pack_((std::uint32_t)(h >> 32) + 1, nxt), std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+            free_count_.fetch_sub(1, std::memory_order_relaxed);
+            ctx = top;
+            return true;
+        }
+    }
+}
+
+bool ContextPool::acquire_for(int& ctx, std::chrono::milliseconds timeout) noexcept {
+    if (size_ == 0) return false;
+    if (try_acquire(ctx)) return true;
+    if (timeout.count() <= 0) return false;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    return wait_(ctx, &deadline);
+}
+
+bool ContextPool::wait_(int& ctx, const std::chrono::steady_clock::time_point* deadline) noexcept {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    bool got = false;
+    {
+        std::unique_lock<std::mutex> lk(mu_);
+        const auto ready = [&] { return try_acquire(ctx); };
+        if (deadline)
+            got = cv_.wait_until(lk, *deadline, ready);
+        else {
+            cv_.wait(lk, ready);
+            got = true;
+        }
+    }
+    waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    return got;
+}
+
+void ContextPool::release(int ctx) noexcept {
+    if (ctx < 0 || ctx >= size_) return;
+
+    std::uint64_t h = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        next_[(std::size_t)ctx].store((int)(std::uint32_t)h - 1, std::memory_order_relaxed);
+        if (head_.compare_exchange_weak(h, pack_((std::uint32_t)(h >> 32) + 1, ctx), std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+            break;
+    }
+    free_count_.fetch_add(1, std::memory_order_relaxed);
+
+    if (waiters_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lk(mu_);
+        cv_.notify_one();
+    }
+}
+
+int ContextPool::available() const noexcept {
+    // The counter trails the stack, so it can dip below zero while contexts change hands.
+    const int n = free_count_.load(std::memory_order_relaxed);
+    return n > 0 ? n : 0;
+}
+
+} // namespace idet::engine
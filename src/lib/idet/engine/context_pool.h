@@ -0,0 +1,129 @@
+/**
+ * @file context_pool.h
+ * @ingroup idet_engine
+ * @brief On-demand checkout of bound inference contexts.
+ *
+ * @details
+ * Bound inference (@ref idet::engine::IEngine::infer_bound) requires that a context index is never
+ * used by two threads at once. Instead of deriving the context from a thread id (which couples
+ * context ownership to a static work split), callers check a context out for the duration of one
+ * unit of work and return it afterwards:
+ * @code
+ *   engine::ContextPool pool(eng.bound_contexts());
+ *   {
+ *       engine::ContextPool::Lease lease(pool);   // blocks until a context is free
+ *       eng.infer_bound(tile, lease.ctx());
+ *   }                                             // context returned here
+ * @endcode
+ *
+ * Checkout and return are lock-free (a tagged Treiber stack over the context indices); only a
+ * caller that finds the pool empty and chooses to wait takes the mutex and sleeps.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace idet::engine {
+
+/**
+ * @brief Thread-safe pool of context indices [0, size).
+ *
+ * @details
+ * Contexts are handed out LIFO, so a lightly loaded pool keeps reusing the most recently
+ * touched (cache-warm) context. All methods may be called from any thread.
+ */
+class ContextPool final {
+  public:
+    /**
+     * @brief Creates a pool with contexts [0, @p contexts), all free.
+     *
+     * @throws std::bad_alloc On allocation failure.
+     */
+    explicit ContextPool(int contexts);
+
+    ContextPool(const ContextPool&) = delete;
+    ContextPool& operator=(const ContextPool&) = delete;
+
+    /** @brief Takes a free context, blocking until one is returned. Returns -1 for an empty pool. */
+    int acquire() noexcept;
+
+    /** @brief Takes a free context without blocking; returns false if none is free. */
+    bool try_acquire(int& ctx) noexcept;
+
+    /**
+     * @brief Takes a free context, waiting at most @p timeout for one to be returned.
+     * @return False if none became free in time (always false for an empty pool).
+     */
+    bool acquire_for(int& ctx, std::chrono::milliseconds timeout) noexcept;
+
+    /** @brief Returns @p ctx (previously acquired from this pool) and wakes one waiter. */
+    void release(int ctx) noexcept;
+
+    /** @brief Number of contexts managed by the pool. */
+    int size() const noexcept {
+        return size_;
+    }
+
+    /** @brief Number of contexts currently free (a snapshot while other threads check out). */
+    int available() const noexcept;
+
+    /** @brief Number of callers waiting for a context (a snapshot, the queue depth of the pool). */
+    int waiting() const noexcept {
+        return waiters_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief RAII checkout: acquires in the constructor, releases in the destructor.
+     */
+    class Lease final {
+      public:
+        explicit Lease(ContextPool& pool) noexcept : pool_(pool), ctx_(pool.acquire()) {}
+
+        /** @brief Adopts @p ctx, already acquired from @p pool (-1: holds nothing). */
+        Lease(ContextPool& pool, int ctx) noexcept : pool_(pool), ctx_(ctx) {}
+
+        ~Lease() noexcept {
+            if (ctx_ >= 0) pool_.release(ctx_);
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /** @brief Checked-out context index (-1 only for an empty pool). */
+        int ctx() const noexcept {
+            return ctx_;
+        }
+
+      private:
+        ContextPool& pool_;
+        const int ctx_;
+    };
+
+  private:
+    /** @brief Packs a stack head: ABA tag in the high half, top context + 1 (0: empty) in the low half. */
+    static std::uint64_t pack_(std::uint32_t tag, int top) noexcept {
+        return ((std::uint64_t)tag << 32) | (std::uint32_t)(top + 1);
+    }
+
+    /** @brief Blocks on @ref cv_ until a context is taken or @p deadline passes (nullptr: no deadline). */
+    bool wait_(int& ctx, const std::chrono::steady_clock::time_point* deadline) noexcept;
+
+    const int size_;
+    std::unique_ptr<std::atomic<int>[]> next_; ///< Stack link of each free context (-1: bottom)
+    std::atomic<std::uint64_t> head_{0};
+    std::atomic<int> free_count_{0};
+
+    std::atomic<int> waiters_{0}; ///< Callers sleeping (or about to) in @ref wait_
+    std::mutex mu_;
+    std::condition_variable cv_;
+};
+
+} // namespace idet::engine
@@ -5,20 +5,30 @@
  *
  * @details
  * This translation unit implements @ref idet::engine::DBNet:
- * - preprocessing: BGR U8 -> normalized CHW float32 (with optional resize),
+ * - preprocessing: BGR U8 -> normalized CHW float32 (with optional resize); float16 models get the
+ *   input converted and the output converted back around each run,
  * - inference: ONNX Runtime session execution (unbound or bound via IoBinding),
  * - output handling: layout-aware extraction of an HxW probability plane,
- * - postprocessing: binarization + contour extraction + rotated-rect quad + unclipping.
+ * - postprocessing: optional map pooling + binarization + contour extraction + rotated-rect quad + unclipping;
+ *   per-contour decoding optionally runs on the library thread pool (RuntimePolicy::post_omp_threads).
+ *   Logit outputs are binarized in logit space and activated only inside scored contours.
  *
  * Output layout handling:
  * - The model export may produce probmap as NCHW / NHWC / N1HW / HW. The implementation uses
- *   @ref idet::internal::make_desc_probmap and @ref idet::internal::extract_hw_channel to obtain
- *   a contiguous HxW plane (channel 0 by default).
+ *   @ref idet::internal::make_desc_probmap and the layout-specialized accessor of
+ *   @ref idet::internal::plane_fn_for (resolved once per bucket, or per output shape when unbound)
+ *   to obtain a contiguous HxW plane (channel 0 by default).
  *
  * Binding strategy:
- * - Bound mode probes the real output shape once (by a single unbound run with a zero input) to avoid
- *   forcing an assumed shape like {1,1,H,W}.
+ * - Bound mode resolves the real output shape once (declared by the model, cached, or probed by a single
+ *   unbound run with a zero input) to avoid forcing an assumed shape like {1,1,H,W}.
  * - Each bound context owns its own input/output buffers and @ref Ort::IoBinding instance.
+ * - With a bound batch N > 1 the buffers hold N consecutive slots; a second IoBinding binds the whole
+ *   [N,3,H,W] tensor while the single-image binding aliases slot 0.
+ * - A binding pool keeps one such set of contexts per input shape (bucket). Frames are routed to
+ *   the bucket that preserves the most pixels and letterboxed into it; the padded part of the output
+ *   map is cropped away before postprocessing. With @ref idet::InferenceOptions::letterbox a single
+ *   bound shape (and unbound inference) letterboxes frames the same way instead of stretching them.
  *
  * Thread-safety:
  * - Unbound inference is safe for concurrent calls.
@@ -28,7 +38,10 @@
 #include "engine/dbnet.h"
 
 #include "algo/geometry.h"
-#include "internal/chw_preprocess.h"
+#include "algo/half.h"
+#include "algo/preprocess.h"
+#include "algo/probmap.h"
+#include "platform/thread_pool.h"
 
 #include <algorithm>
 #include <array>
@@ -41,6 +54,21 @@ namespace idet::engine {
 
 namespace {
 
+/// @brief Contour count below which postprocessing stays serial (team start-up would dominate).
+constexpr int kMinParallelContours_ = 64;
+
+/// @brief Minimum contours per postprocessing thread.
+constexpr int kMinContoursPerThread_ = 16;
+
+/// @brief Input normalization mean in BGR order (ImageNet).
+constexpr float kMean_[3] = {0.406f * 255.0f, 0.456f * 255.0f, 0.485f * 255.0f};
+
+/// @brief Input normalization inverse standard deviation in BGR order (ImageNet).
+constexpr float kInvStd_[3] = {1.0f / (0.225f * 255.0f), 1.0f / (0.224f * 255.0f), 1.0f / (0.229f * 255.0f)};
+
+/// @brief Letterbox padding: a black pixel (value 0) after normalization.
+constexpr float kPad_[3] = {-kMean_[0] * kInvStd_[0], -kMean_[1] * kInvStd_[1], -kMean_[2] * kInvStd_[2]};
+
 /**
  * @brief Align an integer value up to the next multiple of @p a.
  *
@@ -53,15 +81,6 @@ static inline int align_up_(int v, int a) noexcept {
     return (v + a - 1) / a * a;
 }
 
-/**
- * @brief Numerically stable sigmoid for float (used optionally for probmap outputs).
- *
- * @note Used only when cfg_.infer.apply_sigmoid is enabled.
- */
-static inline float sigmoid_(float x) noexcept {
-    return 1.0f / (1.0f + std::exp(-x));
-}
-
 /**
  * @brief Clamp float value to [lo, hi].
  */
@@ -91,12 +110,14 @@ DBNet::DBNet(const DetectorConfig& cfg) : IEngine(cfg, "idet-dbnet") {
 
     auto s = create_session_(cfg_.model_path, cfg_.engine);
     if (!s.ok()) throw std::runtime_error(s.message);
+    s = open_capture_();
+    if (!s.ok()) throw std::runtime_error(s.message);
 
     try {
-        Ort::AllocatedStringPtr in0 = session_.GetInputNameAllocated(0, alloc_);
+        Ort::AllocatedStringPtr in0 = session_->GetInputNameAllocated(0, alloc_);
         in_name_ = in0 ? in0.get() : std::string("input");
 
-        Ort::AllocatedStringPtr out0 = session_.GetOutputNameAllocated(0, alloc_);
+        Ort::AllocatedStringPtr out0 = session_->GetOutputNameAllocated(0, alloc_);
         out_name_ = out0 ? out0.get() : std::string("output");
     } catch (...) {
         if (in_name_.empty()) in_name_ = "input";
@@ -106,6 +127,12 @@ DBNet::DBNet(const DetectorConfig& cfg) : IEngine(cfg, "idet-dbnet") {
     cache_hot_();
 }
 
+/// @brief Session-less decoder of capture frames (see @ref decode_capture).
+DBNet::DBNet(const DetectorConfig& cfg, DecodeOnly) : IEngine(cfg, "idet-dbnet") {
+    if (cfg_.task != Task::Text) throw std::runtime_error("DBNet: cfg.task must be Text");
+    cache_hot_();
+}
+
 /**
  * @brief Cache hot-update parameters from @ref cfg_ into local fields.
  *
@@ -116,10 +143,16 @@ void DBNet::cache_hot_() noexcept {
     apply_sigmoid_ = cfg_.infer.apply_sigmoid;
     bin_thresh_ = cfg_.infer.bin_thresh;
     box_thresh_ = cfg_.infer.box_thresh;
+    score_mode_ = cfg_.infer.score_mode;
+    post_threads_ = cfg_.runtime.post_omp_threads;
     unclip_ = cfg_.infer.unclip;
+    map_downsample_ = cfg_.infer.map_downsample;
+    map_pool_avg_ = cfg_.infer.map_pooling == MapPooling::Average;
+    map_u8_ = cfg_.infer.map_u8;
     max_img_ = cfg_.infer.max_img_size;
     min_w_ = cfg_.infer.min_roi_size_w;
     min_h_ = cfg_.infer.min_roi_size_h;
+    letterbox_unbound_ = cfg_.infer.letterbox;
 }
 
 /**
@@ -142,7 +175,9 @@ Status DBNet::update_hot(const DetectorConfig& next) noexcept {
  *
  * @details
  * - If force_w/force_h are provided, uses them (aligned up to multiple of 32).
- * - Otherwise performs "max side" downscale to @ref max_img_ and aligns both dims to 32.
+ * - Otherwise performs "max side" downscale to @ref max_img_ and aligns both dims to 32. The image
+ *   is stretched over the aligned shape, or with @ref letterbox_unbound_ keeps its downscaled size
+ *   in the top-left corner and the rest becomes padding.
  *
  * @note Alignment (32) matches common DBNet-family backbones with downsample/upsample constraints.
  */
@@ -153,6 +188,8 @@ DBNet::NetGeom DBNet::make_geom_(int orig_w, int orig_h, int force_w, int force_
     if (force_w > 0 && force_h > 0) {
         g.in_w = align_up_(force_w, align);
         g.in_h = align_up_(force_h, align);
+        g.content_w = g.in_w;
+        g.content_h = g.in_h;
         g.sx = (orig_w > 0) ? (float)g.in_w / (float)orig_w : 1.f;
         g.sy = (orig_h > 0) ? (float)g.in_h / (float)orig_h : 1.f;
         return g;
@@ -172,45 +209,52 @@ DBNet::NetGeom DBNet::make_geom_(int orig_w, int orig_h, int force_w, int force_
 
     g.in_w = align_up_(tw, align);
     g.in_h = align_up_(th, align);
-    g.sx = (orig_w > 0) ? (float)g.in_w / (float)orig_w : 1.f;
-    g.sy = (orig_h > 0) ? (float)g.in_h / (float)orig_h : 1.f;
+    g.content_w = letterbox_unbound_ ? tw : g.in_w;
+    g.content_h = letterbox_unbound_ ? th : g.in_h;
+    g.sx = (orig_w > 0) ? (float)g.content_w / (float)orig_w : 1.f;
+    g.sy = (orig_h > 0) ? (float)g.content_h / (float)orig_h : 1.f;
     return g;
 }
 
 /**
- * @brief Convert/resize a BGR U8 image into normalized CHW float32 tensor.
+ * @brief Convert/resize a BGR U8 image or a 4:2:0 frame into normalized CHW float32 tensor.
  *
  * @details
- * Uses ImageNet mean/std (converted to BGR order) and delegates to
- * @ref idet::internal::bgr_u8_to_chw_f32_resize.
+ * Uses ImageNet mean/std (converted to BGR order) and delegates to the fused
+ * @ref idet::algo::resize_to_chw kernel (no intermediate resized or BGR image).
  */
-void DBNet::fill_input_chw_(float* dst, int in_w, int in_h, const cv::Mat& bgr) const {
-    // mean/std in BGR order (ImageNet)
-    const float mean[3] = {0.406f * 255.0f, 0.456f * 255.0f, 0.485f * 255.0f};
-    const float inv_std[3] = {1.0f / (0.225f * 255.0f), 1.0f / (0.224f * 255.0f), 1.0f / (0.229f * 255.0f)};
-    internal::bgr_u8_to_chw_f32_resize(bgr, in_w, in_h, dst, mean, inv_std);
+void DBNet::fill_input_chw_(float* dst, int in_w, int in_h, const algo::ChwSource& src,
+                            algo::ResizeChwWorkspace* ws) const {
+    IDET_STAGE_SCOPE(&stats_, Stage::Preprocess);
+    algo::resize_to_chw(src, in_w, in_h, dst, kMean_, kInvStd_, ws);
 }
 
 /**
  * @brief Execute ORT inference in unbound mode and return output tensor.
  *
  * @details
- * - Creates a CPU tensor view over @p in (no copy).
+ * - Creates a CPU tensor view over @p in (no copy; float16 models get a converted copy) with
+ *   shape [batch,3,in_h,in_w].
  * - Runs the session with single input and single output.
  * - Returns the first output tensor.
  */
-Result<Ort::Value> DBNet::run_ort_unbound_(const float* in, std::size_t in_count, int in_h, int in_w) noexcept {
+Result<Ort::Value> DBNet::run_ort_unbound_(const float* in, std::size_t in_count, int batch, int in_h,
+                                           int in_w) noexcept {
     try {
-        static Ort::MemoryInfo cpu_mem = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-        const std::vector<int64_t> ishape = {1, 3, in_h, in_w};
+        const std::vector<int64_t> ishape = {batch, 3, in_h, in_w};
 
-        Ort::Value in_tensor =
-            Ort::Value::CreateTensor<float>(cpu_mem, const_cast<float*>(in), in_count, ishape.data(), ishape.size());
+        std::vector<std::uint16_t> in_f16;
+        Ort::Value in_tensor = input_tensor_(in, in_count, ishape, in_f16);
 
         const char* in_names[] = {in_name_.c_str()};
         const char* out_names[] = {out_name_.c_str()};
 
-        auto outs = session_.Run(Ort::RunOptions{nullptr}, in_names, &in_tensor, 1, out_names, 1);
+        std::vector<Ort::Value> outs;
+        {
+            IDET_STAGE_SCOPE(&stats_, Stage::Run);
+            outs = session_->Run(run_opts_, in_names, &in_tensor, 1, out_names, 1);
+        }
+        count_run_();
 
         if (outs.empty()) return Result<Ort::Value>::Err(Status::Internal("DBNet: session.Run returned no outputs"));
         return Result<Ort::Value>::Ok(std::move(outs[0]));
@@ -224,35 +268,20 @@ Result<Ort::Value> DBNet::run_ort_unbound_(const float* in, std::size_t in_count
 }
 
 /**
- * @brief Probe output layout/shape descriptor for a given input shape.
+ * @brief Resolve the real output tensor shape for a given input shape.
  *
  * @details
- * Performs one inference on a zero input to read the real output tensor shape,
- * then converts it into a layout-aware descriptor via @ref idet::internal::make_desc_probmap.
+ * Delegates to @ref IEngine::output_shapes_ (declared shapes, shape cache, or a zero-input
+ * probe run) and returns the shape of the probability-map output. The caller converts it into
+ * a layout-aware descriptor.
  *
  * @note Used by @ref setup_binding to allocate bound output buffers with the correct size.
  */
-Result<idet::internal::TensorDesc> DBNet::probe_output_desc_(int in_h, int in_w) noexcept {
-    try {
-        std::vector<float> zero((std::size_t)3 * (std::size_t)in_h * (std::size_t)in_w, 0.f);
-        auto r = run_ort_unbound_(zero.data(), zero.size(), in_h, in_w);
-        if (!r.ok()) return Result<idet::internal::TensorDesc>::Err(r.status());
-
-        Ort::Value out = std::move(r.value());
-        auto sh = out.GetTensorTypeAndShapeInfo().GetShape();
-
-        auto desc = idet::internal::make_desc_probmap(sh);
-        if (desc.layout == idet::internal::TensorLayout::Unknown || desc.H <= 0 || desc.W <= 0) {
-            return Result<idet::internal::TensorDesc>::Err(
-                Status::Unsupported("DBNet: cannot infer output probmap layout"));
-        }
-        return Result<idet::internal::TensorDesc>::Ok(std::move(desc));
-    } catch (const std::exception& e) {
-        return Result<idet::internal::TensorDesc>::Err(
-            Status::Internal(std::string("DBNet: probe_output_desc: ") + e.what()));
-    } catch (...) {
-        return Result<idet::internal::TensorDesc>::Err(Status::Internal("DBNet: probe_output_desc: unknown"));
-    }
+Result<std::vector<int64_t>> DBNet::probe_output_shape_(int batch, int in_h, int in_w) noexcept {
+    auto r = output_shapes_(batch, in_h, in_w);
+    if (!r.ok()) return Result<std::vector<int64_t>>::Err(r.status());
+    if (r.value().empty()) return Result<std::vector<int64_t>>::Err(Status::Internal("DBNet: model has no outputs"));
+    return Result<std::vector<int64_t>>::Ok(std::move(r.value()[0]));
 }
 
 /**
@@ -279,136 +308,309 @@ std::array<cv::Point2f, 4> DBNet::unclip_rect_like_(const std::array<cv::Point2f
 }
 
 /**
- * @brief Postprocess a contiguous HxW probability plane into detections.
+ * @brief Score one contour and convert it to an image-space detection.
  *
  * @details
- * Pipeline:
- * 1) Optional sigmoid (if output is logits).
- * 2) Binarize with @ref bin_thresh_ to a bitmap.
- * 3) Extract contours.
- * 4) Score each contour using probability map, filter by @ref box_thresh_.
- * 5) Fit min-area rotated rectangle, optionally unclip, map back to original image space.
- *
- * @note
- * The returned detections are sorted by descending score.
+ * Applies @ref score_mode_, @ref box_thresh_, the minimum size filters and unclipping. Uses only
+ * cached parameters and thread_local scoring buffers, so contours can be decoded concurrently.
  */
-std::vector<algo::Detection> DBNet::postprocess_hw_(const float* prob_hw, int out_w, int out_h, int orig_w,
-                                                    int orig_h) const {
-    std::vector<algo::Detection> dets;
-    if (!prob_hw || out_w <= 0 || out_h <= 0 || orig_w <= 0 || orig_h <= 0) return dets;
-
-    cv::Mat prob(out_h, out_w, CV_32F, const_cast<float*>(prob_hw));
-
-    cv::Mat prob2;
-    if (apply_sigmoid_) {
-        prob2 = prob.clone();
-        float* p = (float*)prob2.data;
-        const std::size_t n = (std::size_t)out_w * (std::size_t)out_h;
-        for (std::size_t i = 0; i < n; ++i)
-            p[i] = sigmoid_(p[i]);
+bool DBNet::contour_to_detection_(const cv::Mat& map, const std::vector<cv::Point>& c, float sx, float sy, float off,
+                                  bool logits, int orig_w, int orig_h, algo::Detection& d) const {
+    if (c.size() < 4) return false;
+
+    cv::RotatedRect rr;
+    float score = 0.0f;
+    if (score_mode_ == ScoreMode::Box) {
+        rr = cv::minAreaRect(c);
+        std::array<cv::Point2f, 4> rect{};
+        rr.points(rect.data());
+        score = algo::box_score(map, rect, logits);
+    } else if (score_mode_ == ScoreMode::Scanline) {
+        score = algo::contour_score_scanline(map, c, logits);
     } else {
-        prob2 = prob;
+        score = logits ? algo::contour_score_sigmoid(map, c) : algo::contour_score(map, c);
     }
+    if (score < box_thresh_) return false;
 
-    cv::Mat bitmap(out_h, out_w, CV_8U, cv::Scalar(0));
-    const float thr = clampf_(bin_thresh_, 0.0f, 1.0f);
-    for (int y = 0; y < out_h; ++y) {
-        const float* pr = prob2.ptr<float>(y);
-        std::uint8_t* br = bitmap.ptr<std::uint8_t>(y);
-        for (int x = 0; x < out_w; ++x)
-            br[x] = (pr[x] > thr) ? 255 : 0;
-    }
+    if (score_mode_ != ScoreMode::Box) rr = cv::minAreaRect(c);
+    const float w = rr.size.width;
+    const float h = rr.size.height;
+    if (w <= 1.f || h <= 1.f) return false;
 
-    std::vector<std::vector<cv::Point>> contours;
-    cv::findContours(bitmap, contours, cv::RETR_LIST, cv::CHAIN_APPROX_SIMPLE);
+    const float ow = w * sx;
+    const float oh = h * sy;
+    if (min_w_ > 0 && ow < (float)min_w_) return false;
+    if (min_h_ > 0 && oh < (float)min_h_) return false;
 
-    const float sx = (float)orig_w / (float)out_w;
-    const float sy = (float)orig_h / (float)out_h;
+    std::array<cv::Point2f, 4> box{};
+    rr.points(box.data());
 
-    for (auto& c : contours) {
-        if (c.size() < 4) continue;
+    if (unclip_ > 1.0f) box = unclip_rect_like_(box, unclip_);
 
-        const float score = algo::contour_score(prob2, c);
-        if (score < box_thresh_) continue;
+    for (auto& p : box) {
+        p.x = clampf_((p.x + off) * sx, 0.0f, (float)orig_w);
+        p.y = clampf_((p.y + off) * sy, 0.0f, (float)orig_h);
+    }
+
+    algo::order_quad(box.data());
 
-        cv::RotatedRect rr = cv::minAreaRect(c);
-        const float w = rr.size.width;
-        const float h = rr.size.height;
-        if (w <= 1.f || h <= 1.f) continue;
+    d = algo::Detection{};
+    d.score = score;
+    d.pts = box;
+    return true;
+}
+
+/**
+ * @brief Postprocess a contiguous HxW probability plane into detections.
+ *
+ * @details
+ * Pipeline:
+ * 1) Optional 2x2 / 4x4 pooling (@ref map_downsample_); the pooled map replaces @p map below.
+ * 2) Binarize with @ref bin_thresh_ to a bitmap (logits against the logit of the threshold).
+ * 3) Extract contours inside the active regions of the bitmap (@ref algo::find_contours_sparse).
+ * 4) Score each contour using probability map (per @ref score_mode_; 8-bit with @ref map_u8_),
+ *    filter by @ref box_thresh_.
+ * 5) Fit min-area rotated rectangle, optionally unclip, map back to original image space.
+ *
+ * Steps 4-5 (@ref contour_to_detection_) are independent per contour and are spread over
+ * @ref post_threads_ threads of the library pool when there are enough contours and the call is
+ * not already inside a parallel region (tiled inference). Contour extraction itself stays serial.
+ *
+ * @note
+ * The returned detections are sorted by descending score. All intermediate planes live in @p ps
+ * and are reused when the plane size does not change.
+ */
+void DBNet::postprocess_hw_(const cv::Mat& map, float sx, float sy, int orig_w, int orig_h,
+                            std::vector<algo::Detection>& dets, PostScratch& ps) const {
+    IDET_STAGE_SCOPE(&stats_, Stage::Decode);
+    dets.clear();
+    if (map.empty() || map.type() != CV_32F || orig_w <= 0 || orig_h <= 0) return;
+    if (capture_) record_(map, sx, sy, orig_w, orig_h);
+
+    // Pooled pixel i covers map pixels [f*i, f*i + f - 1]; its centre is mapped back, so the
+    // scales grow by f and coordinates shift by (f - 1) / (2f) pooled pixels.
+    const cv::Mat* src = &map;
+    int f = 1;
+    for (int k = 0; f < map_downsample_ && k < 2; ++k, f *= 2) {
+        algo::pool_map(*src, ps.pooled[k], map_pool_avg_);
+        if (ps.pooled[k].empty()) return;
+        src = &ps.pooled[k];
+    }
+    sx *= (float)f;
+    sy *= (float)f;
+    const float off = (float)(f - 1) / (float)(2 * f);
 
-        const float ow = w * sx;
-        const float oh = h * sy;
-        if (min_w_ > 0 && ow < (float)min_w_) continue;
-        if (min_h_ > 0 && oh < (float)min_h_) continue;
+    // One SIMD sweep builds the mask. Logits are thresholded at logit(bin_thresh) since the sigmoid
+    // is monotonic; it is evaluated later only for pixels inside scored contours.
+    const float thr = clampf_(bin_thresh_, 0.0f, 1.0f);
+    algo::binarize(*src, apply_sigmoid_ ? algo::logit_threshold(thr) : thr, ps.bitmap, ps.rows);
 
-        std::array<cv::Point2f, 4> box{};
-        rr.points(box.data());
+    // The tracer only visits regions with foreground; sparse maps skip most of the bitmap.
+    auto& contours = ps.contours;
+    algo::find_contours_sparse(ps.bitmap, ps.rows, contours, ps.regions);
 
-        if (unclip_ > 1.0f) box = unclip_rect_like_(box, unclip_);
+    // Scores then read bytes; logits are activated once, on rows with foreground only.
+    const cv::Mat* scored = src;
+    if (map_u8_ && !contours.empty()) {
+        algo::quantize_u8(*src, apply_sigmoid_, ps.rows, ps.quant);
+        scored = &ps.quant;
+    }
+    const bool logits = apply_sigmoid_ && scored == src;
 
-        for (auto& p : box) {
-            p.x = clampf_(p.x * sx, 0.0f, (float)orig_w);
-            p.y = clampf_(p.y * sy, 0.0f, (float)orig_h);
-        }
+    const int n = (int)contours.size();
 
-        algo::order_quad(box.data());
+    int threads = 1;
+    // Tiles already run inside a region; nested regions would only oversubscribe.
+    if (!platform::ThreadPool::in_parallel() && !serial_postprocess() && n >= kMinParallelContours_) {
+        threads = (post_threads_ > 0) ? post_threads_ : platform::ThreadPool::hardware_width();
+        threads = std::max(1, std::min(threads, n / kMinContoursPerThread_));
+    }
 
+    if (threads <= 1) {
         algo::Detection d;
-        d.score = score;
-        d.pts = box;
-        dets.push_back(d);
+        for (const auto& c : contours) {
+            if (contour_to_detection_(*scored, c, sx, sy, off, logits, orig_w, orig_h, d)) dets.push_back(d);
+        }
+    } else {
+        // Every contour owns one candidate slot, compacted in contour order afterwards, so the
+        // result matches the serial loop exactly.
+        ps.cand.resize((std::size_t)n);
+        ps.keep.assign((std::size_t)n, 0);
+
+        // Contours are handed out in blocks of 16 to keep the index counter off the hot path.
+        // The first exception is rethrown by parallel_for once all helpers returned.
+        constexpr int kBlock = 16;
+        platform::ThreadPool::current().parallel_for((n + kBlock - 1) / kBlock, threads, [&](int b, int) {
+            const int end = std::min(n, (b + 1) * kBlock);
+            for (int i = b * kBlock; i < end; ++i) {
+                const std::size_t k = (std::size_t)i;
+                const bool ok = contour_to_detection_(*scored, contours[k], sx, sy, off, logits, orig_w, orig_h,
+                                                      ps.cand[k]);
+                ps.keep[k] = ok ? 1 : 0;
+            }
+        });
+
+        for (int i = 0; i < n; ++i) {
+            if (ps.keep[(std::size_t)i]) dets.push_back(ps.cand[(std::size_t)i]);
+        }
     }
 
     std::sort(dets.begin(), dets.end(), [](const auto& a, const auto& b) { return a.score > b.score; });
-    return dets;
 }
 
-Status DBNet::setup_binding(int w, int h, int contexts) noexcept {
-    try {
-        unset_binding();
-
-        if (w <= 0 || h <= 0) return Status::Invalid("DBNet::setup_binding: non-positive w/h");
-        if (contexts <= 0) contexts = 1;
+/**
+ * @brief Prepare bound inference for a single shape; frames are stretched (or letterboxed) to it.
+ *
+ * @details
+ * - The single-image output shape is resolved for a batch-1 input (declared, cached or probed).
+ * - For @p batch > 1 the output shape is resolved again for a batch-N input; the model must scale
+ *   its output linearly with the batch dimension (N * slice), otherwise binding fails.
+ * - Each context allocates N consecutive input/output slots. The batch-1 binding aliases slot 0,
+ *   the batched binding covers all slots.
+ */
+Status DBNet::setup_binding(int w, int h, int contexts, int batch) noexcept {
+    unset_binding();
+    if (w <= 0 || h <= 0) return Status::Invalid("DBNet::setup_binding: non-positive w/h");
 
+    const NetGeom g = make_geom_(w, h, w, h);
+    const Status s = setup_buckets_({{g.in_w, g.in_h}}, contexts, batch, cfg_.infer.letterbox);
+    if (s.ok()) {
         bound_w_ = w;
         bound_h_ = h;
-        contexts_ = contexts;
-
-        const NetGeom g = make_geom_(w, h, w, h);
-
-        // Probe real output shape/layout once
-        auto pr = probe_output_desc_(g.in_h, g.in_w);
-        if (!pr.ok()) return pr.status();
-
-        bound_out_desc_ = pr.value();
-        bound_out_shape_ = bound_out_desc_.shape;
-        bound_out_h_ = (int)bound_out_desc_.H;
-        bound_out_w_ = (int)bound_out_desc_.W;
-
-        static Ort::MemoryInfo cpu_mem = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-
-        const std::vector<int64_t> ishape = {1, 3, g.in_h, g.in_w};
-        const std::size_t out_numel = bound_out_desc_.numel;
-
-        ctxs_.resize((std::size_t)contexts_);
-        for (int i = 0; i < contexts_; ++i) {
-            auto& c = ctxs_[(std::size_t)i];
-
-            c.in.assign((std::size_t)3 * (std::size_t)g.in_h * (std::size_t)g.in_w, 0.f);
-            c.out.assign(out_numel, 0.f);
-            c.scratch_prob_hw.clear();
+    }
+    return s;
+}
 
-            c.binding = std::make_unique<Ort::IoBinding>(session_);
+/**
+ * @brief Prepare one letterboxed bucket per distinct (aligned) shape, see @ref IEngine::setup_binding_pool.
+ */
+Status DBNet::setup_binding_pool(const std::vector<std::pair<int, int>>& shapes, int contexts, int batch) noexcept {
+    unset_binding();
+    try {
+        std::vector<std::pair<int, int>> aligned;
+        aligned.reserve(shapes.size());
+        for (const auto& sh : shapes) {
+            if (sh.first <= 0 || sh.second <= 0) return Status::Invalid("DBNet::setup_binding_pool: non-positive w/h");
+            const NetGeom g = make_geom_(sh.first, sh.second, sh.first, sh.second);
+            if (std::find(aligned.begin(), aligned.end(), std::make_pair(g.in_w, g.in_h)) == aligned.end())
+                aligned.emplace_back(g.in_w, g.in_h);
+        }
+        if (aligned.empty()) return Status::Invalid("DBNet::setup_binding_pool: no shapes");
+        return setup_buckets_(aligned, contexts, batch, /*letterbox=*/true);
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("DBNet::setup_binding_pool: bad_alloc");
+    }
+}
 
-            c.in_tensor =
-                Ort::Value::CreateTensor<float>(cpu_mem, c.in.data(), c.in.size(), ishape.data(), ishape.size());
-            c.out_tensor = Ort::Value::CreateTensor<float>(cpu_mem, c.out.data(), c.out.size(), bound_out_shape_.data(),
-                                                           bound_out_shape_.size());
+/**
+ * @brief Shared body of @ref setup_binding / @ref setup_binding_pool over already aligned shapes.
+ *
+ * @details
+ * Output shapes are resolved per bucket. @ref bound_w_ / @ref bound_h_ are set to the largest
+ * bucket extent; a single-shape caller overwrites them with its requested size.
+ */
+Status DBNet::setup_buckets_(const std::vector<std::pair<int, int>>& shapes, int contexts, int batch,
+                             bool letterbox) noexcept {
+    try {
+        if (contexts <= 0) contexts = 1;
+        if (batch <= 0) batch = 1;
 
-            c.binding->BindInput(in_name_.c_str(), c.in_tensor);
-            c.binding->BindOutput(out_name_.c_str(), c.out_tensor);
+        contexts_ = contexts;
+        batch_ = batch;
+        letterbox_ = letterbox;
+
+        buckets_.resize(shapes.size());
+        for (std::size_t bi = 0; bi < shapes.size(); ++bi) {
+            Bucket& bk = buckets_[bi];
+            bk.in_w = shapes[bi].first;
+            bk.in_h = shapes[bi].second;
+
+            // Resolve real output shape/layout once per bucket
+            auto pr = probe_output_shape_(1, bk.in_h, bk.in_w);
+            if (!pr.ok()) {
+                unset_binding();
+                return pr.status();
+            }
+
+            bk.out_desc = idet::internal::make_desc_probmap(pr.value());
+            bk.plane = idet::internal::plane_fn_for(bk.out_desc.layout);
+            if (!bk.plane || bk.out_desc.H <= 0 || bk.out_desc.W <= 0) {
+                unset_binding();
+                return Status::Unsupported("DBNet: cannot infer output probmap layout");
+            }
+            bk.out_shape = bk.out_desc.shape;
+            bk.out_h = (int)bk.out_desc.H;
+            bk.out_w = (int)bk.out_desc.W;
+
+            bk.in_slice = (std::size_t)3 * (std::size_t)bk.in_h * (std::size_t)bk.in_w;
+            bk.out_slice = bk.out_desc.numel;
+
+            if (batch_ > 1) {
+                auto pb = probe_output_shape_(batch_, bk.in_h, bk.in_w);
+                if (!pb.ok()) {
+                    unset_binding();
+                    return Status::Unsupported(std::string("DBNet::setup_binding: model rejects batch > 1: ") +
+                                               pb.status().message);
+                }
+                bk.batch_out_shape = std::move(pb.value());
+                if (idet::internal::safe_numel(bk.batch_out_shape) != (std::size_t)batch_ * bk.out_slice) {
+                    unset_binding();
+                    return Status::Unsupported("DBNet::setup_binding: output does not scale with batch dimension");
+                }
+            }
+
+            const std::vector<int64_t> ishape = {1, 3, bk.in_h, bk.in_w};
+            const std::vector<int64_t> bshape = {batch_, 3, bk.in_h, bk.in_w};
+
+            // Contexts are independent: allocate, first-touch and bind them in parallel.
+            bk.ctxs.resize((std::size_t)contexts_);
+            const int width = std::min(contexts_, platform::ThreadPool::hardware_width());
+            platform::ThreadPool::current().parallel_for(contexts_, width, [&](int i, int) {
+                auto& c = bk.ctxs[(std::size_t)i];
+
+                bound_assign_(c.in, (std::size_t)batch_ * bk.in_slice);
+                if (letterbox_) {
+                    // Every slot starts as padding; frames then only write their content.
+                    for (int k = 0; k < batch_; ++k)
+                        algo::fill_chw_padding(c.in.data() + (std::size_t)k * bk.in_slice, bk.in_w, bk.in_h, 0, 0,
+                                               kPad_);
+                }
+                bound_assign_(c.out, (std::size_t)batch_ * bk.out_slice);
+                bound_assign_(c.in_f16, half_input_() ? c.in.size() : 0);
+                bound_assign_(c.out_f16, half_output_(0) ? c.out.size() : 0);
+                std::uint16_t* in16 = c.in_f16.empty() ? nullptr : c.in_f16.data();
+                std::uint16_t* out16 = c.out_f16.empty() ? nullptr : c.out_f16.data();
+                c.slots.resize((std::size_t)batch_);
+                for (auto& sl : c.slots)
+                    sl.prob_hw.clear();
+                c.pad_w.assign((std::size_t)batch_, 0);
+                c.pad_h.assign((std::size_t)batch_, 0);
+
+                c.binding = std::make_unique<Ort::IoBinding>(*session_);
+
+                c.in_tensor = tensor_view_(c.in.data(), in16, bk.in_slice, ishape);
+                c.out_tensor = tensor_view_(c.out.data(), out16, bk.out_slice, bk.out_shape);
+
+                c.binding->BindInput(in_name_.c_str(), c.in_tensor);
+                c.binding->BindOutput(out_name_.c_str(), c.out_tensor);
+
+                if (batch_ > 1) {
+                    c.batch_binding = std::make_unique<Ort::IoBinding>(*session_);
+
+                    c.batch_in_tensor = tensor_view_(c.in.data(), in16, c.in.size(), bshape);
+                    c.batch_out_tensor = tensor_view_(c.out.data(), out16, c.out.size(), bk.batch_out_shape);
+
+                    c.batch_binding->BindInput(in_name_.c_str(), c.batch_in_tensor);
+                    c.batch_binding->BindOutput(out_name_.c_str(), c.batch_out_tensor);
+                }
+            });
+
+            bucket_shapes_.emplace_back(bk.in_w, bk.in_h);
+            bound_w_ = std::max(bound_w_, bk.in_w);
+            bound_h_ = std::max(bound_h_, bk.in_h);
         }
 
+        staged_.assign((std::size_t)contexts_, Placement{});
         binding_ready_ = true;
         return Status::Ok();
     } catch (const std::bad_alloc&) {
@@ -427,46 +629,96 @@ void DBNet::unset_binding() noexcept {
     binding_ready_ = false;
     bound_w_ = bound_h_ = 0;
     contexts_ = 0;
+    batch_ = 0;
+    letterbox_ = false;
+    bucket_shapes_.clear();
 
-    bound_out_desc_ = {};
-    bound_out_shape_.clear();
-    bound_out_w_ = bound_out_h_ = 0;
-
-    ctxs_.clear();
+    buckets_.clear();
+    staged_.clear();
 }
 
 Result<std::vector<algo::Detection>> DBNet::infer_unbound(const cv::Mat& bgr) noexcept {
-    try {
-        if (bgr.empty() || bgr.type() != CV_8UC3) {
-            return Result<std::vector<algo::Detection>>::Err(
-                Status::Invalid("DBNet::infer_unbound: expected CV_8UC3 BGR"));
-        }
+    if (bgr.empty() || bgr.type() != CV_8UC3) {
+        return Result<std::vector<algo::Detection>>::Err(Status::Invalid("DBNet::infer_unbound: expected CV_8UC3 BGR"));
+    }
+    return infer_unbound_(algo::ChwSource::of(bgr));
+}
+
+Status DBNet::infer_source_into(const algo::ChwSource& src, int ctx_idx, std::vector<algo::Detection>& out) noexcept {
+    out.clear();
+    if (!src.valid()) return Status::Invalid("DBNet::infer_source_into: unsupported or empty source");
+    if (ctx_idx >= 0) return infer_bound_into_(src, ctx_idx, out);
 
-        const int ow = bgr.cols;
-        const int oh = bgr.rows;
+    auto r = infer_unbound_(src);
+    if (!r.ok()) return r.status();
+    out = std::move(r.value());
+    return Status::Ok();
+}
+
+/**
+ * @brief Output layout and plane accessor for the unbound output shape @p sh.
+ *
+ * @details
+ * Unbound frames of one stream keep their output shape, so the parsed plan is kept per thread and
+ * reparsed only when the shape changes. It depends on the shape alone, hence is shared by every
+ * engine that runs on the thread.
+ */
+const DBNet::OutputPlan& DBNet::output_plan_(const std::vector<int64_t>& sh) {
+    thread_local OutputPlan plan;
+    if (plan.desc.shape != sh || plan.desc.layout == idet::internal::TensorLayout::Unknown) {
+        plan.desc = idet::internal::make_desc_probmap(sh);
+        plan.plane = idet::internal::plane_fn_for(plan.desc.layout);
+    }
+    return plan;
+}
+
+/** @brief Unbound inference body shared by the BGR and direct-source entry points. */
+Result<std::vector<algo::Detection>> DBNet::infer_unbound_(const algo::ChwSource& src) noexcept {
+    try {
+        const int ow = src.width();
+        const int oh = src.height();
 
         const NetGeom g = make_geom_(ow, oh, 0, 0);
+        const bool boxed = g.content_w != g.in_w || g.content_h != g.in_h;
 
         std::vector<float> in((std::size_t)3 * (std::size_t)g.in_h * (std::size_t)g.in_w);
-        fill_input_chw_(in.data(), g.in_w, g.in_h, bgr);
+        if (boxed) {
+            IDET_STAGE_SCOPE(&stats_, Stage::Preprocess);
+            algo::ResizeChwWorkspace ws;
+            algo::resize_to_chw_canvas(src, g.content_w, g.content_h, in.data(), g.in_w, g.in_h, kMean_, kInvStd_, ws);
+            algo::fill_chw_padding(in.data(), g.in_w, g.in_h, g.content_w, g.content_h, kPad_);
+        } else {
+            fill_input_chw_(in.data(), g.in_w, g.in_h, src);
+        }
 
-        auto rr = run_ort_unbound_(in.data(), in.size(), g.in_h, g.in_w);
+        auto rr = run_ort_unbound_(in.data(), in.size(), 1, g.in_h, g.in_w);
         if (!rr.ok()) return Result<std::vector<algo::Detection>>::Err(rr.status());
 
         Ort::Value out = std::move(rr.value());
-        auto sh = out.GetTensorTypeAndShapeInfo().GetShape();
-        auto desc = idet::internal::make_desc_probmap(sh);
+        const OutputPlan& plan = output_plan_(out.GetTensorTypeAndShapeInfo().GetShape());
+        const idet::internal::TensorDesc& desc = plan.desc;
 
-        const float* data = out.GetTensorData<float>();
+        std::vector<float> out_f32;
+        const float* data = tensor_f32_(out, out_f32);
         std::vector<float> scratch;
         // production default: channel 0
-        const float* prob_hw = idet::internal::extract_hw_channel(data, desc, /*channel=*/0, scratch);
+        const float* prob_hw = plan.plane ? plan.plane(data, desc, /*channel=*/0, scratch) : nullptr;
         if (!prob_hw) {
             return Result<std::vector<algo::Detection>>::Err(
                 Status::Unsupported("DBNet: cannot extract prob HW plane"));
         }
 
-        auto dets = postprocess_hw_(prob_hw, (int)desc.W, (int)desc.H, ow, oh);
+        // Raw model output (probabilities, or logits when apply_sigmoid_ is set); never copied.
+        // A letterboxed input is cropped to the part of the map that covers the image.
+        const int mw = (int)desc.W;
+        const int mh = (int)desc.H;
+        const algo::LetterboxView v = algo::letterbox_view(mw, mh, g.in_w, g.in_h, g.content_w, g.content_h, ow, oh);
+        const cv::Mat full(mh, mw, CV_32F, const_cast<float*>(prob_hw));
+        const cv::Mat map = (v.w == mw && v.h == mh) ? full : full(cv::Rect(0, 0, v.w, v.h));
+
+        std::vector<algo::Detection> dets;
+        PostScratch ps;
+        postprocess_hw_(map, v.sx, v.sy, ow, oh, dets, ps);
         return Result<std::vector<algo::Detection>>::Ok(std::move(dets));
     } catch (const std::bad_alloc&) {
         return Result<std::vector<algo::Detection>>::Err(Status::OutOfMemory("DBNet::infer_unbound: bad_alloc"));
@@ -478,43 +730,350 @@ Result<std::vector<algo::Detection>> DBNet::infer_unbound(const cv::Mat& bgr) no
     }
 }
 
+/**
+ * @brief Route a frame to its bucket and compute the size of the image inside the bucket input.
+ *
+ * @details
+ * Letterboxed buckets get an aspect-preserving content size (@ref idet::algo::letterbox_fit);
+ * otherwise the frame is stretched over the whole input.
+ */
+DBNet::Placement DBNet::place_(int orig_w, int orig_h) const noexcept {
+    Placement p;
+    p.bucket = std::max(0, pick_bucket_(orig_w, orig_h));
+    const Bucket& bk = buckets_[(std::size_t)p.bucket];
+    p.orig_w = orig_w;
+    p.orig_h = orig_h;
+    if (letterbox_) {
+        const algo::LetterboxFit f = algo::letterbox_fit(orig_w, orig_h, bk.in_w, bk.in_h, max_img_);
+        p.content_w = f.w;
+        p.content_h = f.h;
+    } else {
+        p.content_w = bk.in_w;
+        p.content_h = bk.in_h;
+    }
+    return p;
+}
+
+/**
+ * @brief Preprocess @p src into batch slot @p slot of context @p c according to @p p.
+ *
+ * @details
+ * Letterboxed slots are filled with padding at setup. A frame overwrites the content area of the
+ * previous one unless it is smaller in either dimension; only then is the padding re-written, so
+ * a steady stream of same-sized (or growing) frames never touches it after setup.
+ */
+void DBNet::fill_bound_(const Bucket& bk, BoundCtx& c, int slot, const algo::ChwSource& src,
+                        const Placement& p) const {
+    float* dst = c.in.data() + (std::size_t)slot * bk.in_slice;
+    algo::ResizeChwWorkspace& prep = c.slots[(std::size_t)slot].prep;
+    if (!letterbox_) {
+        fill_input_chw_(dst, bk.in_w, bk.in_h, src, &prep);
+        return;
+    }
+
+    IDET_STAGE_SCOPE(&stats_, Stage::Preprocess);
+    algo::resize_to_chw_canvas(src, p.content_w, p.content_h, dst, bk.in_w, bk.in_h, kMean_, kInvStd_, prep);
+
+    const std::size_t k = (std::size_t)slot;
+    if (p.content_w < c.pad_w[k] || p.content_h < c.pad_h[k])
+        algo::fill_chw_padding(dst, bk.in_w, bk.in_h, p.content_w, p.content_h, kPad_);
+    c.pad_w[k] = p.content_w;
+    c.pad_h[k] = p.content_h;
+}
+
+void DBNet::run_bound_(const Bucket& bk, BoundCtx& c, int count) {
+    IDET_STAGE_SCOPE(&stats_, Stage::Run);
+    const std::size_t n = (std::size_t)count;
+    if (!c.in_f16.empty()) algo::f32_to_f16(c.in.data(), c.in_f16.data(), n * bk.in_slice);
+
+    if (count == 1 || !c.batch_binding) {
+        session_->Run(run_opts_, *c.binding);
+    } else {
+        session_->Run(run_opts_, *c.batch_binding);
+    }
+    count_run_();
+
+    if (!c.out_f16.empty()) algo::f16_to_f32(c.out_f16.data(), c.out.data(), n * bk.out_slice);
+}
+
 Result<std::vector<algo::Detection>> DBNet::infer_bound(const cv::Mat& bgr, int ctx_idx) noexcept {
+    std::vector<algo::Detection> out;
+    const Status s = infer_bound_into(bgr, ctx_idx, out);
+    if (!s.ok()) return Result<std::vector<algo::Detection>>::Err(s);
+    return Result<std::vector<algo::Detection>>::Ok(std::move(out));
+}
+
+Status DBNet::infer_bound_into(const cv::Mat& bgr, int ctx_idx, std::vector<algo::Detection>& out) noexcept {
+    if (bgr.empty() || bgr.type() != CV_8UC3) {
+        out.clear();
+        return Status::Invalid("DBNet::infer_bound: expected CV_8UC3 BGR");
+    }
+    return infer_bound_into_(algo::ChwSource::of(bgr), ctx_idx, out);
+}
+
+/** @brief Bound inference body shared by the BGR and direct-source entry points. */
+Status DBNet::infer_bound_into_(const algo::ChwSource& src, int ctx_idx, std::vector<algo::Detection>& out) noexcept {
     try {
-        if (!binding_ready_)
-            return Result<std::vector<algo::Detection>>::Err(Status::Invalid("DBNet::infer_bound: binding not ready"));
-        if (ctx_idx < 0 || ctx_idx >= contexts_)
-            return Result<std::vector<algo::Detection>>::Err(
-                Status::Invalid("DBNet::infer_bound: ctx_idx out of range"));
-        if (bgr.empty() || bgr.type() != CV_8UC3)
-            return Result<std::vector<algo::Detection>>::Err(
-                Status::Invalid("DBNet::infer_bound: expected CV_8UC3 BGR"));
+        out.clear();
+        if (!binding_ready_) return Status::Invalid("DBNet::infer_bound: binding not ready");
+        if (ctx_idx < 0 || ctx_idx >= contexts_) return Status::Invalid("DBNet::infer_bound: ctx_idx out of range");
 
-        auto& c = ctxs_[(std::size_t)ctx_idx];
+        const Placement p = place_(src.width(), src.height());
+        const Bucket& bk = buckets_[(std::size_t)p.bucket];
+        auto& c = buckets_[(std::size_t)p.bucket].ctxs[(std::size_t)ctx_idx];
 
-        const int ow = bgr.cols;
-        const int oh = bgr.rows;
-        const NetGeom g = make_geom_(ow, oh, bound_w_, bound_h_);
+        fill_bound_(bk, c, 0, src, p);
+        run_bound_(bk, c, 1);
 
-        fill_input_chw_(c.in.data(), g.in_w, g.in_h, bgr);
+        return decode_bound_slot_(bk, c, 0, p, out);
+    } catch (const std::bad_alloc&) {
+        out.clear();
+        return Status::OutOfMemory("DBNet::infer_bound: bad_alloc");
+    } catch (const std::exception& e) {
+        out.clear();
+        return Status::Internal(std::string("DBNet::infer_bound: ") + e.what());
+    } catch (...) {
+        out.clear();
+        return Status::Internal("DBNet::infer_bound: unknown");
+    }
+}
 
-        session_.Run(Ort::RunOptions{nullptr}, *c.binding);
+/**
+ * @brief Batched bound inference on BGR frames (see @ref DBNet::infer_sources_batch).
+ */
+Result<std::vector<std::vector<algo::Detection>>> DBNet::infer_bound_batch(const cv::Mat* bgr, int count,
+                                                                           int ctx_idx) noexcept {
+    using R = Result<std::vector<std::vector<algo::Detection>>>;
+    try {
+        if (!bgr || count <= 0) return R::Err(Status::Invalid("DBNet::infer_bound_batch: empty batch"));
+        if (count > batch_) return R::Err(Status::Invalid("DBNet::infer_bound_batch: count exceeds bound batch"));
+
+        std::vector<algo::ChwSource> src((std::size_t)count);
+        for (int i = 0; i < count; ++i) {
+            if (bgr[i].empty() || bgr[i].type() != CV_8UC3)
+                return R::Err(Status::Invalid("DBNet::infer_bound_batch: expected CV_8UC3 BGR"));
+            src[(std::size_t)i] = algo::ChwSource::of(bgr[i]);
+        }
+        return infer_sources_batch(src.data(), count, ctx_idx);
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("DBNet::infer_bound_batch: bad_alloc"));
+    }
+}
 
-        const float* prob_hw =
-            idet::internal::extract_hw_channel(c.out.data(), bound_out_desc_, /*channel=*/0, c.scratch_prob_hw);
-        if (!prob_hw) {
-            return Result<std::vector<algo::Detection>>::Err(
-                Status::Unsupported("DBNet(bound): cannot extract prob HW plane"));
+/**
+ * @brief Batched bound inference: fill N input slots, run once, decode each slot.
+ *
+ * @details
+ * Uses the batch-1 binding when @p count == 1 so that single-image calls on a batched binding
+ * do not pay for the full batch. With a binding pool, the sources are grouped by the bucket they
+ * route to and each group runs as one batch (in the order the buckets first appear).
+ *
+ * Slots own their scratch (@ref SlotScratch), so filling and decoding spread over up to
+ * @ref post_threads_ threads of the library pool unless the call already runs inside a
+ * parallel region; contours of a slot are then scored serially.
+ */
+Result<std::vector<std::vector<algo::Detection>>> DBNet::infer_sources_batch(const algo::ChwSource* src, int count,
+                                                                             int ctx_idx) noexcept {
+    using R = Result<std::vector<std::vector<algo::Detection>>>;
+    try {
+        if (!binding_ready_) return R::Err(Status::Invalid("DBNet::infer_sources_batch: binding not ready"));
+        if (ctx_idx < 0 || ctx_idx >= contexts_)
+            return R::Err(Status::Invalid("DBNet::infer_sources_batch: ctx_idx out of range"));
+        if (!src || count <= 0) return R::Err(Status::Invalid("DBNet::infer_sources_batch: empty batch"));
+        if (count > batch_) return R::Err(Status::Invalid("DBNet::infer_sources_batch: count exceeds bound batch"));
+
+        std::vector<Placement> places((std::size_t)count);
+        for (int i = 0; i < count; ++i) {
+            if (!src[i].valid())
+                return R::Err(Status::Invalid("DBNet::infer_sources_batch: unsupported or empty source"));
+            places[(std::size_t)i] = place_(src[i].width(), src[i].height());
         }
 
-        auto dets = postprocess_hw_(prob_hw, bound_out_w_, bound_out_h_, ow, oh);
-        return Result<std::vector<algo::Detection>>::Ok(std::move(dets));
+        int threads = 1;
+        if (!platform::ThreadPool::in_parallel() && !serial_postprocess()) {
+            threads = (post_threads_ > 0) ? post_threads_ : platform::ThreadPool::hardware_width();
+            threads = std::max(1, std::min(threads, count));
+        }
+        platform::ThreadPool& pool = platform::ThreadPool::current();
+
+        std::vector<std::vector<algo::Detection>> out((std::size_t)count);
+        std::vector<char> done((std::size_t)count, 0);
+        std::vector<int> group;
+        group.reserve((std::size_t)count);
+        for (int first = 0; first < count; ++first) {
+            if (done[(std::size_t)first]) continue;
+            const int b = places[(std::size_t)first].bucket;
+            group.clear();
+            for (int i = first; i < count; ++i) {
+                if (!done[(std::size_t)i] && places[(std::size_t)i].bucket == b) {
+                    group.push_back(i);
+                    done[(std::size_t)i] = 1;
+                }
+            }
+
+            const Bucket& bk = buckets_[(std::size_t)b];
+            auto& c = buckets_[(std::size_t)b].ctxs[(std::size_t)ctx_idx];
+            const int n = (int)group.size();
+            const int t = std::min(threads, n);
+
+            pool.parallel_for(n, t, [&](int j, int) {
+                const int i = group[(std::size_t)j];
+                fill_bound_(bk, c, j, src[i], places[(std::size_t)i]);
+            });
+
+            run_bound_(bk, c, n);
+
+            std::vector<Status> st((std::size_t)n, Status::Ok());
+            pool.parallel_for(n, t, [&](int j, int) {
+                const std::size_t i = (std::size_t)group[(std::size_t)j];
+                st[(std::size_t)j] = decode_bound_slot_(bk, c, j, places[i], out[i]);
+            });
+            for (const Status& s : st) {
+                if (!s.ok()) return R::Err(s);
+            }
+        }
+        return R::Ok(std::move(out));
     } catch (const std::bad_alloc&) {
-        return Result<std::vector<algo::Detection>>::Err(Status::OutOfMemory("DBNet::infer_bound: bad_alloc"));
+        return R::Err(Status::OutOfMemory("DBNet::infer_sources_batch: bad_alloc"));
     } catch (const std::exception& e) {
-        return Result<std::vector<algo::Detection>>::Err(
-            Status::Internal(std::string("DBNet::infer_bound: ") + e.what()));
+        return R::Err(Status::Internal(std::string("DBNet::infer_sources_batch: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("DBNet::infer_sources_batch: unknown"));
+    }
+}
+
+
+/**
+ * @brief Staged bound inference, stage 1: validate, preprocess into the context input buffer.
+ *
+ * @details
+ * Stores the frame placement (bucket, geometry) per context so that @ref DBNet::stage_run and
+ * @ref DBNet::stage_output can run later, possibly on another thread, without the source image.
+ */
+Status DBNet::stage_input(const cv::Mat& bgr, int ctx_idx) noexcept {
+    try {
+        if (!binding_ready_) return Status::Invalid("DBNet::stage_input: binding not ready");
+        if (ctx_idx < 0 || ctx_idx >= contexts_) return Status::Invalid("DBNet::stage_input: ctx_idx out of range");
+        if (bgr.empty() || bgr.type() != CV_8UC3) return Status::Invalid("DBNet::stage_input: expected CV_8UC3 BGR");
+
+        const Placement p = place_(bgr.cols, bgr.rows);
+        const Bucket& bk = buckets_[(std::size_t)p.bucket];
+        fill_bound_(bk, buckets_[(std::size_t)p.bucket].ctxs[(std::size_t)ctx_idx], 0, algo::ChwSource::of(bgr), p);
+        staged_[(std::size_t)ctx_idx] = p;
+        return Status::Ok();
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("DBNet::stage_input: bad_alloc");
+    } catch (const std::exception& e) {
+        return Status::Internal(std::string("DBNet::stage_input: ") + e.what());
+    } catch (...) {
+        return Status::Internal("DBNet::stage_input: unknown");
+    }
+}
+
+/// @brief Staged bound inference, stage 2: run the batch-1 binding of the staged bucket.
+Status DBNet::stage_run(int ctx_idx) noexcept {
+    try {
+        if (!binding_ready_) return Status::Invalid("DBNet::stage_run: binding not ready");
+        if (ctx_idx < 0 || ctx_idx >= contexts_) return Status::Invalid("DBNet::stage_run: ctx_idx out of range");
+
+        const Placement& p = staged_[(std::size_t)ctx_idx];
+        Bucket& bk = buckets_[(std::size_t)p.bucket];
+        run_bound_(bk, bk.ctxs[(std::size_t)ctx_idx], 1);
+        return Status::Ok();
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("DBNet::stage_run: bad_alloc");
+    } catch (const std::exception& e) {
+        return Status::Internal(std::string("DBNet::stage_run: ") + e.what());
+    } catch (...) {
+        return Status::Internal("DBNet::stage_run: unknown");
+    }
+}
+
+/// @brief Staged bound inference, stage 3: decode slot 0 of the staged bucket outputs.
+Result<std::vector<algo::Detection>> DBNet::stage_output(int ctx_idx) noexcept {
+    using R = Result<std::vector<algo::Detection>>;
+    try {
+        if (!binding_ready_) return R::Err(Status::Invalid("DBNet::stage_output: binding not ready"));
+        if (ctx_idx < 0 || ctx_idx >= contexts_)
+            return R::Err(Status::Invalid("DBNet::stage_output: ctx_idx out of range"));
+
+        const Placement& p = staged_[(std::size_t)ctx_idx];
+        const Bucket& bk = buckets_[(std::size_t)p.bucket];
+        auto& c = buckets_[(std::size_t)p.bucket].ctxs[(std::size_t)ctx_idx];
+        std::vector<algo::Detection> dets;
+        const Status s = decode_bound_slot_(bk, c, 0, p, dets);
+        if (!s.ok()) return R::Err(s);
+        return R::Ok(std::move(dets));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("DBNet::stage_output: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("DBNet::stage_output: ") + e.what()));
     } catch (...) {
-        return Result<std::vector<algo::Detection>>::Err(Status::Internal("DBNet::infer_bound: unknown"));
+        return R::Err(Status::Internal("DBNet::stage_output: unknown"));
+    }
+}
+
+/**
+ * @brief Decode one output slot of a bound context.
+ *
+ * @details
+ * Slots are laid out batch-major, so slot @p slot starts at `slot * out_slice` and has the same
+ * per-image layout as the batch-1 probe described by @c Bucket::out_desc. For a letterboxed frame
+ * only the part of the map covering the image content is postprocessed.
+ */
+Status DBNet::decode_bound_slot_(const Bucket& bk, BoundCtx& c, int slot, const Placement& p,
+                                 std::vector<algo::Detection>& out) const {
+    out.clear();
+    const float* base = c.out.data() + (std::size_t)slot * bk.out_slice;
+    SlotScratch& ss = c.slots[(std::size_t)slot];
+    const float* prob_hw = bk.plane(base, bk.out_desc, /*channel=*/0, ss.prob_hw);
+    if (!prob_hw) return Status::Unsupported("DBNet(bound): cannot extract prob HW plane");
+
+    // Map extent of the content; equals the whole map unless the frame is letterboxed.
+    const algo::LetterboxView v =
+        algo::letterbox_view(bk.out_w, bk.out_h, bk.in_w, bk.in_h, p.content_w, p.content_h, p.orig_w, p.orig_h);
+    const cv::Mat full(bk.out_h, bk.out_w, CV_32F, const_cast<float*>(prob_hw));
+    const cv::Mat map = (v.w == bk.out_w && v.h == bk.out_h) ? full : full(cv::Rect(0, 0, v.w, v.h));
+
+    postprocess_hw_(map, v.sx, v.sy, p.orig_w, p.orig_h, out, ss.post);
+    return Status::Ok();
+}
+
+/**
+ * @brief Records the (possibly cropped) decoder input plane; a cropped view is copied first.
+ */
+void DBNet::record_(const cv::Mat& map, float sx, float sy, int orig_w, int orig_h) const {
+    const cv::Mat plane = map.isContinuous() ? map : map.clone();
+    const std::int64_t shape[2] = {plane.rows, plane.cols};
+    const CaptureView v{"prob", shape, 2, plane.ptr<float>()};
+
+    CaptureFrame g;
+    g.orig_w = orig_w;
+    g.orig_h = orig_h;
+    g.sx = sx;
+    g.sy = sy;
+    capture_->append(g, &v, 1);
+}
+
+/**
+ * @brief Decodes a recorded plane with the current thresholds (per-thread scratch).
+ */
+Status DBNet::decode_capture(const CaptureFrame& f, std::vector<algo::Detection>& out) const noexcept {
+    out.clear();
+    if (f.tensors.size() != 1 || f.tensors[0].shape.size() != 2)
+        return Status::DecodeError("DBNet: capture frame is not a single [H, W] plane");
+    const CaptureTensor& t = f.tensors[0];
+    try {
+        thread_local PostScratch ps;
+        const cv::Mat map((int)t.shape[0], (int)t.shape[1], CV_32F, const_cast<float*>(t.data.data()));
+        postprocess_hw_(map, f.sx, f.sy, f.orig_w, f.orig_h, out, ps);
+        return Status::Ok();
+    } catch (const std::bad_alloc&) {
+        out.clear();
+        return Status::OutOfMemory("DBNet::decode_capture: bad_alloc");
+    } catch (const std::exception& e) {
+        out.clear();
+        return Status::Internal(std::string("DBNet::decode_capture: ") + e.what());
     }
 }
 
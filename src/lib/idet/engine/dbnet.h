@@ -13,7 +13,7 @@
  * - Output tensor layout is inferred at runtime (NCHW / NHWC / N1HW / HW) and handled without undefined behavior.
  *
  * Expected model contract:
- * - Input:  float32 tensor with shape [1, 3, H, W] (CHW), normalized.
+ * - Input:  float32 tensor with shape [N, 3, H, W] (NCHW), normalized; N > 1 only for batched binding.
  * - Output: probability map-like tensor, commonly one of:
  *   - [1, 1, H, W] (NCHW)
  *   - [1, H, W, 1] (NHWC)
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include "algo/preprocess.h"
+#include "algo/probmap.h"
 #include "engine/engine.h"
 #include "internal/ort_tensor.h"
 
@@ -33,6 +35,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace idet::engine {
@@ -63,6 +66,13 @@ class DBNet final : public IEngine {
      */
     explicit DBNet(const DetectorConfig& cfg);
 
+    /**
+     * @brief Decode-only engine without a session: only @ref decode_capture may be used.
+     *
+     * @param cfg Configuration with @c task == Text (the engine kind is not checked).
+     */
+    DBNet(const DetectorConfig& cfg, DecodeOnly);
+
     /** @brief Engine kind identifier. */
     EngineKind kind() const noexcept override {
         return EngineKind::DBNet;
@@ -88,8 +98,13 @@ class DBNet final : public IEngine {
      * @param w Input width in pixels (> 0).
      * @param h Input height in pixels (> 0).
      * @param contexts Number of contexts (> 0).
+     * @param batch Maximum images per bound run (>= 1); > 1 requires a model with a dynamic batch dim.
      */
-    Status setup_binding(int w, int h, int contexts) noexcept override;
+    Status setup_binding(int w, int h, int contexts, int batch) noexcept override;
+
+    /** @brief Prepare one letterboxed bucket per input shape (see @ref IEngine::setup_binding_pool). */
+    Status setup_binding_pool(const std::vector<std::pair<int, int>>& shapes, int contexts,
+                              int batch) noexcept override;
 
     /** @brief Tear down bound-mode state and return to unbound mode. */
     void unset_binding() noexcept override;
@@ -111,6 +126,72 @@ class DBNet final : public IEngine {
      */
     Result<std::vector<algo::Detection>> infer_bound(const cv::Mat& bgr, int ctx_idx) noexcept override;
 
+    /**
+     * @brief Bound inference into a reusable vector, decoding with the context's scratch buffers.
+     *
+     * @param bgr Input BGR image (CV_8UC3).
+     * @param ctx_idx Context index in [0, bound_contexts()).
+     * @param out Destination detections (cleared first).
+     * @return Status::Ok() or error status.
+     */
+    Status infer_bound_into(const cv::Mat& bgr, int ctx_idx, std::vector<algo::Detection>& out) noexcept override;
+
+    /**
+     * @brief Unbound (@p ctx_idx < 0) or bound inference reading @p src directly in the fused kernel.
+     *
+     * @param src Packed RGB/RGBA/BGRA/BGR image or 4:2:0 planes (see @ref idet::algo::ChwSource::valid).
+     * @param ctx_idx Context index in [0, bound_contexts()), or -1 for unbound mode.
+     * @param out Destination detections (cleared first).
+     * @return Status::Ok() or error status.
+     */
+    Status infer_source_into(const algo::ChwSource& src, int ctx_idx,
+                             std::vector<algo::Detection>& out) noexcept override;
+
+    /**
+     * @brief Run bound inference for up to @ref bound_batch() images with one session run.
+     *
+     * @param bgr Pointer to @p count input BGR images (CV_8UC3).
+     * @param count Number of images in [1, bound_batch()].
+     * @param ctx_idx Context index in [0, bound_contexts()).
+     * @return Per-image detections or error status.
+     */
+    Result<std::vector<std::vector<algo::Detection>>> infer_bound_batch(const cv::Mat* bgr, int count,
+                                                                        int ctx_idx) noexcept override;
+
+    /**
+     * @brief Same as @ref infer_bound_batch for direct sources (packed or 4:2:0, e.g. crops of one frame).
+     *
+     * @param src Pointer to @p count valid sources (see @ref idet::algo::ChwSource::valid).
+     * @param count Number of sources in [1, bound_batch()].
+     * @param ctx_idx Index of binding context in [0, bound_contexts()).
+     * @return Per-source detections in source coordinates or an error status.
+     */
+    Result<std::vector<std::vector<algo::Detection>>> infer_sources_batch(const algo::ChwSource* src, int count,
+                                                                          int ctx_idx) noexcept override;
+
+    /** @brief Staged bound inference is supported (see @ref IEngine::supports_stages). */
+    bool supports_stages() const noexcept override {
+        return true;
+    }
+
+    /** @brief Preprocess @p bgr into context @p ctx_idx and remember its geometry. */
+    Status stage_input(const cv::Mat& bgr, int ctx_idx) noexcept override;
+
+    /** @brief Run the session on context @p ctx_idx (batch-1 binding). */
+    Status stage_run(int ctx_idx) noexcept override;
+
+    /** @brief Decode context @p ctx_idx outputs using the geometry stored by @ref stage_input. */
+    Result<std::vector<algo::Detection>> stage_output(int ctx_idx) noexcept override;
+
+    /**
+     * @brief Postprocesses a recorded probability plane exactly like a live one.
+     *
+     * @param f Capture frame holding one `[H, W]` plane.
+     * @param out Destination detections (cleared first).
+     * @return DecodeError if @p f holds no such plane.
+     */
+    Status decode_capture(const CaptureFrame& f, std::vector<algo::Detection>& out) const noexcept;
+
   private:
     /**
      * @brief Geometry mapping between original image size and network input size.
@@ -122,8 +203,40 @@ class DBNet final : public IEngine {
     struct NetGeom {
         int in_w = 0;
         int in_h = 0;
-        float sx = 1.0f; // in_w / orig_w
-        float sy = 1.0f; // in_h / orig_h
+        int content_w = 0; // resized image width inside the input (in_w unless letterboxed)
+        int content_h = 0; // resized image height inside the input (in_h unless letterboxed)
+        float sx = 1.0f;   // content_w / orig_w
+        float sy = 1.0f;   // content_h / orig_h
+    };
+
+    /**
+     * @brief Reusable postprocessing buffers (bitmap, contours).
+     *
+     * @details
+     * Owned per bound context so that steady-state decoding reuses capacity instead of allocating.
+     * OpenCV's contour tracer keeps its own internal storage, which is outside this scratch.
+     */
+    struct PostScratch {
+        cv::Mat pooled[2];                            ///< Downsampled maps (@ref map_downsample_ 2 and 4)
+        cv::Mat quant;                                ///< 8-bit probabilities scored with @ref map_u8_
+        cv::Mat bitmap;                               ///< Binarized probability map
+        std::vector<std::uint8_t> rows;               ///< Whether each row of @ref bitmap has foreground
+        algo::ContourScratch regions;                 ///< Active regions scanned for contours
+        std::vector<std::vector<cv::Point>> contours; ///< Contours of @ref bitmap
+        std::vector<algo::Detection> cand;            ///< Per-contour candidates (parallel decoding)
+        std::vector<std::uint8_t> keep;               ///< Whether @ref cand slot passed the filters
+    };
+
+    /**
+     * @brief Preprocessing and decoding scratch of one batch slot.
+     *
+     * @details
+     * Kept per slot so that the slots of a batched run can be filled and decoded concurrently.
+     */
+    struct SlotScratch {
+        algo::ResizeChwWorkspace prep; ///< Resize tables/row cache for input preprocessing
+        std::vector<float> prob_hw;    ///< Scratch for NHWC -> HW extraction
+        PostScratch post;              ///< Postprocessing buffers reused across frames
     };
 
     /**
@@ -134,13 +247,20 @@ class DBNet final : public IEngine {
      * The struct is move-only to avoid accidental expensive copies and to respect ORT handle semantics.
      */
     struct BoundCtx {
-        std::vector<float> in;              ///< CHW input buffer (size = 3 * bound_h * bound_w)
-        std::vector<float> out;             ///< Raw output buffer (size = numel(bound_out_shape_))
-        std::vector<float> scratch_prob_hw; ///< Scratch for NHWC -> HW extraction
+        platform::BoundBuffer<float> in;              ///< NCHW input buffer (size = batch * Bucket::in_slice)
+        platform::BoundBuffer<float> out;             ///< Raw output buffer (size = batch * Bucket::out_slice)
+        platform::BoundBuffer<std::uint16_t> in_f16;  ///< Bound float16 input (float16 models only, size of @ref in)
+        platform::BoundBuffer<std::uint16_t> out_f16; ///< Bound float16 output (float16 models only, size of @ref out)
+        std::vector<SlotScratch> slots;               ///< Per slot scratch (size = batch)
+        std::vector<int> pad_w, pad_h;                ///< Per slot: content extent written over the letterbox padding
 
-        std::unique_ptr<Ort::IoBinding> binding; ///< Per-context IoBinding handle
-        Ort::Value in_tensor{nullptr};           ///< Bound input tensor
-        Ort::Value out_tensor{nullptr};          ///< Bound output tensor
+        std::unique_ptr<Ort::IoBinding> binding; ///< Per-context IoBinding handle (batch 1, slot 0)
+        Ort::Value in_tensor{nullptr};           ///< Bound input tensor (slot 0 view)
+        Ort::Value out_tensor{nullptr};          ///< Bound output tensor (slot 0 view)
+
+        std::unique_ptr<Ort::IoBinding> batch_binding; ///< Batched IoBinding over all slots (batch > 1 only)
+        Ort::Value batch_in_tensor{nullptr};           ///< Bound [N,3,H,W] input tensor
+        Ort::Value batch_out_tensor{nullptr};          ///< Bound [N,...] output tensor
 
         BoundCtx() = default;
         BoundCtx(const BoundCtx&) = delete;
@@ -152,6 +272,38 @@ class DBNet final : public IEngine {
         ~BoundCtx() = default;
     };
 
+    /**
+     * @brief Bound state of one input shape.
+     *
+     * @details
+     * @ref setup_binding prepares a single bucket, @ref setup_binding_pool one per distinct shape.
+     * Every bucket holds all contexts, so a context index is valid whichever bucket a frame routes to.
+     */
+    struct Bucket {
+        int in_w = 0, in_h = 0;                  ///< Aligned input shape
+        idet::internal::TensorDesc out_desc{};   ///< Batch-1 output layout
+        idet::internal::PlaneFn plane = nullptr; ///< Plane accessor of @ref out_desc (resolved at binding)
+        std::vector<int64_t> out_shape;          ///< Real ORT output shape (batch 1)
+        std::vector<int64_t> batch_out_shape;    ///< Real ORT output shape for the batched input
+        std::size_t in_slice = 0;                ///< Floats per input slot (3 * in_h * in_w)
+        std::size_t out_slice = 0;               ///< Floats per output slot
+        int out_w = 0, out_h = 0;                ///< Probability map size
+        std::vector<BoundCtx> ctxs;              ///< Per-context state
+    };
+
+    /** @brief Where a frame goes in bound mode: bucket and size of the resized image inside its input. */
+    struct Placement {
+        int bucket = 0;                   ///< Index into @ref buckets_
+        int orig_w = 0, orig_h = 0;       ///< Source frame size
+        int content_w = 0, content_h = 0; ///< Resized frame size (the whole input unless letterboxed)
+    };
+
+    /** @brief Output layout of unbound inference with its plane accessor (see @ref output_plan_). */
+    struct OutputPlan {
+        idet::internal::TensorDesc desc{};       ///< Parsed output shape
+        idet::internal::PlaneFn plane = nullptr; ///< Accessor of @ref desc (null: unsupported layout)
+    };
+
   private:
     /** @brief Refresh cached hot parameters from @ref cfg_. */
     void cache_hot_() noexcept;
@@ -168,51 +320,141 @@ class DBNet final : public IEngine {
     NetGeom make_geom_(int orig_w, int orig_h, int force_w, int force_h) const;
 
     /**
-     * @brief Fill CHW float32 input buffer from BGR image, including resize/normalization as needed.
+     * @brief Fill CHW float32 input buffer from a BGR image or 4:2:0 frame, including resize/normalization.
      *
      * @param dst_chw Destination buffer (size = 3 * in_h * in_w).
      * @param in_w Target input width.
      * @param in_h Target input height.
-     * @param bgr Source image (CV_8UC3).
+     * @param src Source image (BGR CV_8UC3 or YUV planes).
+     * @param ws Resize scratch (per binding context); nullptr uses a thread-local one.
      */
-    void fill_input_chw_(float* dst_chw, int in_w, int in_h, const cv::Mat& bgr) const;
+    void fill_input_chw_(float* dst_chw, int in_w, int in_h, const algo::ChwSource& src,
+                         algo::ResizeChwWorkspace* ws = nullptr) const;
+
+    /** @brief Body of @ref infer_unbound for an already validated source. */
+    Result<std::vector<algo::Detection>> infer_unbound_(const algo::ChwSource& src) noexcept;
+
+    /** @brief Body of @ref infer_bound_into for an already validated source. */
+    Status infer_bound_into_(const algo::ChwSource& src, int ctx_idx, std::vector<algo::Detection>& out) noexcept;
 
     /**
      * @brief Run ONNX Runtime inference in unbound mode and return the raw output tensor.
      *
-     * @param in Pointer to contiguous CHW float input (size = in_count).
+     * @param in Pointer to contiguous NCHW float input (size = in_count).
      * @param in_count Number of floats in the input buffer.
+     * @param batch Leading (batch) dimension of the input tensor.
      * @param in_h Input height.
      * @param in_w Input width.
      * @return Result with the output tensor (Ort::Value) or error status.
      */
-    Result<Ort::Value> run_ort_unbound_(const float* in, std::size_t in_count, int in_h, int in_w) noexcept;
+    Result<Ort::Value> run_ort_unbound_(const float* in, std::size_t in_count, int batch, int in_h,
+                                        int in_w) noexcept;
 
     /**
-     * @brief Probe the real output tensor descriptor for a given input shape.
+     * @brief Probe the real output tensor shape for a given input shape.
      *
      * @details
      * Used during binding preparation to allocate output buffers with the correct size and
-     * to remember the real output layout/shape (never assume [1,1,H,W]).
+     * to remember the real output layout/shape (never assume [1,1,H,W]). Only runs the model
+     * when the shape is neither declared by the model nor cached (see @ref IEngine::output_shapes_).
      *
+     * @param batch Leading (batch) dimension of the probe input.
      * @param in_h Input height.
      * @param in_w Input width.
-     * @return Result with inferred tensor descriptor or error status.
+     * @return Result with the real output shape or error status.
+     */
+    Result<std::vector<int64_t>> probe_output_shape_(int batch, int in_h, int in_w) noexcept;
+
+    /**
+     * @brief Build one bucket per aligned shape (shared by @ref setup_binding and @ref setup_binding_pool).
+     *
+     * @param shapes Distinct aligned (w, h) input shapes.
+     * @param contexts Number of contexts per bucket.
+     * @param batch Maximum images per bound run.
+     * @param letterbox Letterbox frames into their bucket instead of stretching them.
      */
-    Result<idet::internal::TensorDesc> probe_output_desc_(int in_h, int in_w) noexcept;
+    Status setup_buckets_(const std::vector<std::pair<int, int>>& shapes, int contexts, int batch,
+                          bool letterbox) noexcept;
+
+    /** @brief Route a frame of the given size to a bucket and compute its content size. */
+    Placement place_(int orig_w, int orig_h) const noexcept;
 
     /**
-     * @brief Postprocess a contiguous HxW probability plane into detections.
+     * @brief Preprocess @p src into batch slot @p slot of @p c as described by @p p.
      *
-     * @param prob_hw Pointer to contiguous probability plane (size = out_h * out_w).
-     * @param out_w Probability plane width.
-     * @param out_h Probability plane height.
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void fill_bound_(const Bucket& bk, BoundCtx& c, int slot, const algo::ChwSource& src, const Placement& p) const;
+
+    /**
+     * @brief Run the bound session over the first @p count slots of @p c.
+     *
+     * @details
+     * Uses the batch-1 binding for @p count == 1 and the batch binding otherwise. For float16
+     * models the used slots are converted into @ref BoundCtx::in_f16 before and out of
+     * @ref BoundCtx::out_f16 after the run, so decoding always reads @ref BoundCtx::out.
+     */
+    void run_bound_(const Bucket& bk, BoundCtx& c, int count);
+
+    /**
+     * @brief Extract the probability plane of one bound output slot and postprocess it.
+     *
+     * @param bk Bucket the frame was run in.
+     * @param c Bound context holding the output buffer.
+     * @param slot Batch slot index in [0, bound_batch()).
+     * @param p Placement of the frame (original and content size).
+     * @param out Destination detections (cleared first).
+     * @return Status::Ok() or error status.
+     */
+    Status decode_bound_slot_(const Bucket& bk, BoundCtx& c, int slot, const Placement& p,
+                              std::vector<algo::Detection>& out) const;
+
+    /**
+     * @brief Layout plan of an unbound output shape, cached per thread.
+     *
+     * @param sh Output tensor shape of the current run.
+     * @return Plan valid until the next call on the same thread.
+     *
+     * @throws std::bad_alloc If the shape cannot be copied.
+     */
+    static const OutputPlan& output_plan_(const std::vector<int64_t>& sh);
+
+    /**
+     * @brief Postprocess an HxW probability plane into detections.
+     *
+     * @param map CV_32F probability (or logit, with apply_sigmoid) plane; may be a cropped view.
+     *            It is pooled by @ref map_downsample_ first; @p sx / @p sy stay full-map scales.
+     * @param sx Horizontal map-to-image scale.
+     * @param sy Vertical map-to-image scale.
      * @param orig_w Original image width.
      * @param orig_h Original image height.
-     * @return Vector of detections in original image coordinates.
+     * @param dets Destination for detections in original image coordinates (cleared first).
+     * @param ps Reusable scratch buffers.
      */
-    std::vector<algo::Detection> postprocess_hw_(const float* prob_hw, int out_w, int out_h, int orig_w,
-                                                 int orig_h) const;
+    void postprocess_hw_(const cv::Mat& map, float sx, float sy, int orig_w, int orig_h,
+                         std::vector<algo::Detection>& dets, PostScratch& ps) const;
+
+    /** @brief Appends the plane passed to @ref postprocess_hw_ to @ref capture_. */
+    void record_(const cv::Mat& map, float sx, float sy, int orig_w, int orig_h) const;
+
+    /**
+     * @brief Score one contour and turn it into a detection (filters, box fit, unclip, mapping).
+     *
+     * @param map Scored plane: CV_32F probabilities or logits, or CV_8U quantized probabilities.
+     * @param contour Contour in @p map coordinates.
+     * @param sx Horizontal @p map-to-image scale.
+     * @param sy Vertical @p map-to-image scale.
+     * @param off Offset added to @p map coordinates before scaling (pixel centre of a pooled map).
+     * @param logits Whether @p map holds logits.
+     * @param orig_w Original image width.
+     * @param orig_h Original image height.
+     * @param d Destination detection (written only on success).
+     * @return true if the contour passed all filters.
+     *
+     * @note Thread-safe: reads only cached parameters and uses thread_local scoring buffers.
+     */
+    bool contour_to_detection_(const cv::Mat& map, const std::vector<cv::Point>& contour, float sx, float sy,
+                               float off, bool logits, int orig_w, int orig_h, algo::Detection& d) const;
 
     /**
      * @brief Best-effort "rect-like" polygon expansion helper used by postprocessing.
@@ -235,20 +477,26 @@ class DBNet final : public IEngine {
     bool apply_sigmoid_ = false;
     float bin_thresh_ = 0.3f;
     float box_thresh_ = 0.5f;
+    ScoreMode score_mode_ = ScoreMode::Polygon;
     float unclip_ = 1.0f;
+    int map_downsample_ = 1;    ///< @ref InferenceOptions::map_downsample
+    bool map_pool_avg_ = false; ///< @ref InferenceOptions::map_pooling is @ref MapPooling::Average
+    bool map_u8_ = false;       ///< @ref InferenceOptions::map_u8
     int max_img_ = 960;
     int min_w_ = 5;
     int min_h_ = 5;
+    bool letterbox_unbound_ = false; ///< @ref InferenceOptions::letterbox for unbound frames
+
+    /** @brief Pool threads for per-contour decoding (@ref RuntimePolicy::post_omp_threads). */
+    int post_threads_ = 1;
 
     // --------------------------- binding metadata ----------------------------
 
-    idet::internal::TensorDesc bound_out_desc_{};
-    std::vector<int64_t> bound_out_shape_; // Real ORT output shape for the bound input shape.
-    int bound_out_w_ = 0;
-    int bound_out_h_ = 0;
+    /** @brief Bound input shapes with their per-context state. */
+    std::vector<Bucket> buckets_;
 
-    /** @brief Per-context bound inference state. */
-    std::vector<BoundCtx> ctxs_;
+    /** @brief Per context: placement of the frame staged by @ref stage_input. */
+    std::vector<Placement> staged_;
 };
 
 } // namespace idet::engine
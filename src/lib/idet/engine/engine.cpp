@@ -8,8 +8,20 @@
  * - immutable/hot-update validation contract (@ref idet::engine::IEngine::check_hot_update_),
  * - common hot-update field application (@ref idet::engine::IEngine::apply_hot_common_),
  * - ORT session creation from filesystem path or embedded model blob
- *   (@ref idet::engine::IEngine::create_session_),
- * - process-wide ORT environment singleton wiring (@ref idet::engine::IEngine::global_env_).
+ *   (@ref idet::engine::IEngine::create_session_), including the model content hash, sharing
+ *   through @ref idet::engine::SessionRegistry, optimized-model file reuse and memory-mapped /
+ *   in-place ORT-format models,
+ * - output shape resolution for a given input shape: declared shapes, @ref idet::engine::ShapeCache,
+ *   or a probe run (@ref idet::engine::IEngine::output_shapes_),
+ * - process-wide ORT environment singleton wiring (@ref idet::engine::IEngine::global_env_),
+ * - the per-image fallback for batched bound inference (@ref idet::engine::IEngine::infer_bound_batch,
+ *   @ref idet::engine::IEngine::infer_sources_batch),
+ * - the forwarding default of @ref idet::engine::IEngine::infer_bound_into,
+ * - the unsupported default of @ref idet::engine::IEngine::infer_source_into,
+ * - default (unsupported) binding pool setup and the frame-to-bucket routing of bound calls,
+ * - default (unsupported) staged bound inference hooks used by the async pipeline,
+ * - the per-thread serial-postprocess flag used by tile scheduler workers,
+ * - opening the shared capture writer of @ref idet::RuntimePolicy::capture_file.
  *
  * Notes:
  * - ORT session options are configured from @ref idet::DetectorConfig::runtime.
@@ -19,15 +31,108 @@
 
 #include "engine/engine.h"
 
+#include "algo/half.h"
+#include "engine/session_registry.h"
 #include "internal/embed_model.h"
 #include "platform/cross_topology.h"
+#include "platform/mapped_file.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <new>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace idet::engine {
 
+namespace {
+
+/// @brief Stamp file recording which model an optimized model file was produced from.
+std::string optimized_stamp_path(const std::string& file) {
+    return file + ".hash";
+}
+
+/// @brief True if @p file exists and was produced from the model with content hash @p model.
+bool optimized_model_current(const std::string& file, std::uint64_t model) {
+    if (model == 0 || !std::ifstream(file, std::ios::binary)) return false;
+    std::ifstream st(optimized_stamp_path(file));
+    std::string hex;
+    if (!(st >> hex)) return false;
+    char want[17];
+    std::snprintf(want, sizeof(want), "%016llx", (unsigned long long)model);
+    return hex == want;
+}
+
+/// @brief Best-effort: records that @p file now holds the optimized form of @p model.
+void stamp_optimized_model(const std::string& file, std::uint64_t model) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)model);
+    std::ofstream st(optimized_stamp_path(file), std::ios::trunc);
+    if (st) st << hex << '\n';
+}
+
+/// @brief True if @p blob is an ORT-format (flatbuffer) model: file identifier "ORTM" at byte 4.
+bool is_ort_format(const idet::internal::ModelBlob& blob) noexcept {
+    return !blob.empty() && blob.size >= 8 && std::memcmp(static_cast<const char*>(blob.data) + 4, "ORTM", 4) == 0;
+}
+
+/// @brief ORT name (as listed by @c Ort::GetAvailableProviders) of @p ep; nullptr for the CPU provider.
+const char* provider_name(ExecutionProvider ep) noexcept {
+    switch (ep) {
+    case ExecutionProvider::XNNPACK:
+        return "XnnpackExecutionProvider";
+    case ExecutionProvider::DNNL:
+        return "DnnlExecutionProvider";
+    case ExecutionProvider::CoreML:
+        return "CoreMLExecutionProvider";
+    default:
+        return nullptr;
+    }
+}
+
+/// @brief Registers @ref RuntimePolicy::ort_provider on @p so; Unsupported if ORT was built without it.
+Status append_provider(Ort::SessionOptions& so, const RuntimePolicy& rt) {
+    const char* name = provider_name(rt.ort_provider);
+    if (!name) return Status::Ok();
+
+    const std::vector<std::string> avail = Ort::GetAvailableProviders();
+    if (std::find(avail.begin(), avail.end(), name) == avail.end())
+        return Status::Unsupported(std::string("create_session: ") + name + " is not in this ONNX Runtime build");
+
+    switch (rt.ort_provider) {
+    case ExecutionProvider::XNNPACK: {
+        // XNNPACK schedules its kernels on a pool of its own, sized like the intra-op pool.
+        const std::string threads = std::to_string(std::max(1, rt.ort_intra_threads));
+        so.AppendExecutionProvider("XNNPACK", {{"intra_op_num_threads", threads}});
+        break;
+    }
+    case ExecutionProvider::DNNL: {
+        const OrtApi& api = Ort::GetApi();
+        OrtDnnlProviderOptions* opts = nullptr;
+        Ort::ThrowOnError(api.CreateDnnlProviderOptions(&opts));
+        std::unique_ptr<OrtDnnlProviderOptions, decltype(api.ReleaseDnnlProviderOptions)> guard(
+            opts, api.ReleaseDnnlProviderOptions);
+        Ort::ThrowOnError(api.SessionOptionsAppendExecutionProvider_Dnnl(so, opts));
+        break;
+    }
+    case ExecutionProvider::CoreML:
+        so.AppendExecutionProvider("CoreML", {});
+        break;
+    default:
+        break;
+    }
+    return Status::Ok();
+}
+
+} // namespace
+
 /**
  * @brief Base engine constructor.
  *
@@ -42,7 +147,8 @@ namespace idet::engine {
  * The log id affects only the first call that constructs the global environment singleton.
  * Subsequent engine instances will reuse the same environment.
  */
-IEngine::IEngine(const DetectorConfig& cfg, const char* log_id) : cfg_(cfg), env_(global_env_(log_id)) {}
+IEngine::IEngine(const DetectorConfig& cfg, const char* log_id)
+    : cfg_(cfg), env_(global_env_(cfg.runtime, log_id)) {}
 
 /**
  * @brief Validate whether the proposed configuration can be applied as a hot update.
@@ -80,8 +186,14 @@ Status IEngine::check_hot_update_(const DetectorConfig& next) const noexcept {
     const auto& b = next.runtime;
 
     if (b.ort_intra_threads != a.ort_intra_threads || b.ort_inter_threads != a.ort_inter_threads ||
-        b.tile_omp_threads != a.tile_omp_threads || b.soft_mem_bind != a.soft_mem_bind ||
-        b.numa_mem_policy != a.numa_mem_policy || b.suppress_opencv != a.suppress_opencv) {
+        b.tile_omp_threads != a.tile_omp_threads || b.post_omp_threads != a.post_omp_threads ||
+        b.soft_mem_bind != a.soft_mem_bind || b.numa_mem_policy != a.numa_mem_policy ||
+        b.suppress_opencv != a.suppress_opencv || b.share_session != a.share_session ||
+        b.optimized_model_file != a.optimized_model_file || b.ort_spin != a.ort_spin ||
+        b.ort_parallel != a.ort_parallel || b.ort_arena != a.ort_arena ||
+        b.ort_denormal_as_zero != a.ort_denormal_as_zero || b.ort_provider != a.ort_provider ||
+        b.ort_global_pools != a.ort_global_pools || b.pin_worker_threads != a.pin_worker_threads ||
+        b.capture_file != a.capture_file || b.bound_buffers != a.bound_buffers) {
         return Status::Invalid("update_hot: runtime cannot change (recreate detector)");
     }
 
@@ -117,11 +229,40 @@ void IEngine::apply_hot_common_(const DetectorConfig& next) noexcept {
  *
  * Current session options:
  * - Graph optimization: ORT_ENABLE_ALL
- * - Execution mode: ORT_SEQUENTIAL
- * - CPU memory arena: enabled (recommended for performance in most CPU workloads)
- * - Memory pattern: enabled (helps when shapes are stable; ORT uses it opportunistically)
+ * - Execution mode: ORT_SEQUENTIAL, or ORT_PARALLEL with cfg_.runtime.ort_parallel
+ * - CPU memory arena and memory pattern: per cfg_.runtime.ort_arena (both enabled by default;
+ *   @ref idet::ArenaPolicy::ArenaShrink additionally sets the shrinkage entry of @ref run_opts_)
  * - Intra-op threads: cfg_.runtime.ort_intra_threads (if > 0)
  * - Inter-op threads: cfg_.runtime.ort_inter_threads (if > 0)
+ * - With cfg_.runtime.ort_global_pools: no per-session threads; the session runs on the pools of
+ *   the environment (@ref OrtEnvironment), which must have been created with them
+ * - Spinning of idle pool threads: cfg_.runtime.ort_spin (ORT default unless set)
+ * - Denormals as zero: cfg_.runtime.ort_denormal_as_zero
+ * - Execution provider: cfg_.runtime.ort_provider ahead of the CPU provider; Unsupported if the
+ *   linked ORT lacks it
+ *
+ * Optimized model file (@ref idet::RuntimePolicy::optimized_model_file):
+ * - if the file exists and its stamp matches the model content hash, it is loaded instead of the
+ *   original model with graph optimizations disabled (they are already applied),
+ * - otherwise ORT writes it while creating the session from the original model, and the stamp
+ *   (`<file>.hash`) is updated afterwards.
+ *
+ * Sharing (@ref idet::RuntimePolicy::share_session):
+ * the session is looked up in @ref SessionRegistry::global by model hash and options; engines
+ * with the same key use one session and only keep private bindings.
+ *
+ * Profiling (@ref idet::RuntimePolicy::profile_prefix): enables the ORT profiler; such sessions
+ * are always private so that every trace covers the runs of one engine.
+ *
+ * Model bytes: with @ref idet::RuntimePolicy::mmap_model the file is mapped read-only and the
+ * session is created from the mapping. ORT-format models (mapped or embedded) are used in place
+ * (@c session.use_ort_model_bytes_directly / @c _for_initializers); a mapping they point into is
+ * then released together with the session, which may outlive this engine when shared. ORT-format
+ * models are already optimized offline, so @ref idet::RuntimePolicy::optimized_model_file is not
+ * written for them.
+ *
+ * Element types: the input/output types are read once (@ref resolve_io_types_); models with
+ * I/O other than float32/float16 are rejected here rather than failing inside @c Run.
  *
  * Error handling:
  * - Converts exceptions into @ref idet::Status to avoid exceptions crossing API boundaries.
@@ -140,29 +281,111 @@ void IEngine::apply_hot_common_(const DetectorConfig& next) noexcept {
 Status IEngine::create_session_(const std::string& model_path, EngineKind engine_kind) noexcept {
     try {
         so_.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
-        so_.SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
+        const RuntimePolicy& rt = cfg_.runtime;
+        so_.SetExecutionMode(rt.ort_parallel ? ExecutionMode::ORT_PARALLEL : ExecutionMode::ORT_SEQUENTIAL);
 
         // Arena + mem pattern are typical CPU-performance defaults.
         // ORT may ignore mem pattern in cases where it is not applicable.
-        so_.EnableCpuMemArena();
-        so_.EnableMemPattern();
+        if (rt.ort_arena == ArenaPolicy::Off) {
+            so_.DisableCpuMemArena();
+            so_.DisableMemPattern();
+        } else {
+            so_.EnableCpuMemArena();
+            so_.EnableMemPattern();
+        }
+        if (rt.ort_arena == ArenaPolicy::ArenaShrink) {
+            run_opts_ = Ort::RunOptions();
+            run_opts_.AddConfigEntry("memory.enable_memory_arena_shrinkage", "cpu:0");
+        }
+
+        if (rt.ort_spin != SpinPolicy::Default) {
+            const char* spin = (rt.ort_spin == SpinPolicy::Spin) ? "1" : "0";
+            so_.AddConfigEntry("session.intra_op.allow_spinning", spin);
+            so_.AddConfigEntry("session.inter_op.allow_spinning", spin);
+        }
+        if (rt.ort_denormal_as_zero) so_.AddConfigEntry("session.set_denormal_as_zero", "1");
 
         // Session log severity (0=VERBOSE, 1=INFO, 2=WARNING, 3=ERROR, 4=FATAL).
         so_.SetLogSeverityLevel(3);
 
-        if (cfg_.runtime.ort_intra_threads > 0) so_.SetIntraOpNumThreads(cfg_.runtime.ort_intra_threads);
-        if (cfg_.runtime.ort_inter_threads > 0) so_.SetInterOpNumThreads(cfg_.runtime.ort_inter_threads);
+        if (rt.ort_global_pools) {
+            if (!OrtEnvironment::global().has_global_pools())
+                return Status::Invalid("create_session: ort_global_pools needs the ORT environment to be created with "
+                                       "them (set it on the first detector or call setup_runtime_policy first)");
+            so_.DisablePerSessionThreads();
+        } else {
+            if (rt.ort_intra_threads > 0) so_.SetIntraOpNumThreads(rt.ort_intra_threads);
+            if (rt.ort_inter_threads > 0) so_.SetInterOpNumThreads(rt.ort_inter_threads);
+        }
 
-        if (!model_path.empty()) {
-            session_ = Ort::Session(env_, model_path.c_str(), so_);
+        const Status ps = append_provider(so_, rt);
+        if (!ps.ok()) return ps;
+
+        const std::string& prof = cfg_.runtime.profile_prefix;
+        if (!prof.empty()) so_.EnableProfiling(prof.c_str());
+
+        idet::internal::ModelBlob blob{};
+        std::shared_ptr<const platform::MappedFile> mapped;
+        if (!model_path.empty() && rt.mmap_model) {
+            auto mr = platform::MappedFile::open(model_path);
+            if (!mr.ok()) return mr.status();
+            mapped = std::move(mr.value());
+            blob = {mapped->data(), mapped->size()};
+            model_hash_ = ShapeCache::hash_bytes(blob.data, blob.size);
+        } else if (!model_path.empty()) {
+            model_hash_ = ShapeCache::hash_file(model_path);
         } else {
-            const auto blob = idet::internal::get_model_blob(engine_kind);
+            blob = idet::internal::get_model_blob(engine_kind);
             if (blob.empty()) {
                 return Status::Invalid("create_session: empty model path and no embedded model provided");
             }
-            session_ = Ort::Session(env_, blob.data, blob.size, so_);
+            model_hash_ = ShapeCache::hash_bytes(blob.data, blob.size);
         }
 
+        const bool in_place = is_ort_format(blob);
+        const std::string& opt_file = in_place ? std::string() : cfg_.runtime.optimized_model_file;
+        const bool use_opt = !opt_file.empty() && optimized_model_current(opt_file, model_hash_);
+        if (use_opt) {
+            so_.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_DISABLE_ALL);
+        } else if (!opt_file.empty()) {
+            so_.SetOptimizedModelFilePath(opt_file.c_str());
+        }
+        if (in_place) {
+            so_.AddConfigEntry("session.use_ort_model_bytes_directly", "1");
+            so_.AddConfigEntry("session.use_ort_model_bytes_for_initializers", "1");
+        }
+        // Bytes used in place must outlive the session; an ONNX-format mapping is done once parsed.
+        const std::shared_ptr<const void> keep_alive = in_place ? mapped : nullptr;
+
+        bool created = false;
+        auto make = [&]() -> Ort::Session {
+            created = true;
+            if (use_opt) return Ort::Session(env_, opt_file.c_str(), so_);
+            if (blob.empty()) return Ort::Session(env_, model_path.c_str(), so_);
+            return Ort::Session(env_, blob.data, blob.size, so_);
+        };
+
+        if (cfg_.runtime.share_session && model_hash_ != 0 && prof.empty()) {
+            SessionKey key;
+            key.model = model_hash_;
+            key.options = "intra=" + std::to_string(rt.ort_intra_threads) +
+                          ";inter=" + std::to_string(rt.ort_inter_threads) + ";opt=" + opt_file +
+                          ";spin=" + std::to_string((int)rt.ort_spin) + ";par=" + std::to_string((int)rt.ort_parallel) +
+                          ";arena=" + std::to_string((int)rt.ort_arena) +
+                          ";daz=" + std::to_string((int)rt.ort_denormal_as_zero) +
+                          ";ep=" + std::to_string((int)rt.ort_provider) +
+                          ";pools=" + std::to_string((int)rt.ort_global_pools);
+            session_ = SessionRegistry::global().acquire(key, make, nullptr, keep_alive);
+        } else {
+            session_ = SessionRegistry::own(make(), keep_alive);
+        }
+
+        if (created && !opt_file.empty() && !use_opt) stamp_optimized_model(opt_file, model_hash_);
+
+        const Status ts = resolve_io_types_();
+        if (!ts.ok()) return ts;
+        profiling_.store(!prof.empty(), std::memory_order_relaxed);
+
         // Best-effort diagnostic: confirm current threads are within the expected affinity mask.
         // This is not a functional requirement for ORT, but helps catch misordered policy setup.
         const auto vr_aff = idet::platform::verify_all_threads_affinity_subset(cfg_.verbose);
@@ -181,4 +404,299 @@ Status IEngine::create_session_(const std::string& model_path, EngineKind engine
     }
 }
 
+namespace {
+
+/**
+ * @brief Output shapes declared by the model for input [batch,3,in_h,in_w], if fully determined.
+ *
+ * @details
+ * Only trusted when the declared input has static H/W equal to the request (so spatial output
+ * axes cannot depend on it) and every output axis is static, except a symbolic leading axis
+ * which - if the input batch axis is symbolic too - is taken to be @p batch.
+ */
+bool declared_output_shapes(Ort::Session& session, int batch, int in_h, int in_w, ShapeList& out) {
+    if (session.GetInputCount() != 1) return false;
+
+    const auto ishape = session.GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+    if (ishape.size() != 4 || ishape[2] != in_h || ishape[3] != in_w) return false;
+    const bool dyn_batch = (ishape[0] < 0);
+    if (!dyn_batch && ishape[0] != batch) return false;
+
+    const std::size_t n = session.GetOutputCount();
+    out.assign(n, {});
+    for (std::size_t i = 0; i < n; ++i) {
+        auto shape = session.GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+        for (std::size_t d = 0; d < shape.size(); ++d) {
+            if (shape[d] > 0) continue;
+            if (d == 0 && dyn_batch) {
+                shape[d] = batch;
+                continue;
+            }
+            return false;
+        }
+        out[i] = std::move(shape);
+    }
+    return n > 0;
+}
+
+} // namespace
+
+Result<ShapeList> IEngine::output_shapes_(int batch, int in_h, int in_w) noexcept {
+    try {
+        if (batch <= 0 || in_h <= 0 || in_w <= 0)
+            return Result<ShapeList>::Err(Status::Invalid("output_shapes: bad shape"));
+
+        ShapeList shapes;
+        if (declared_output_shapes(*session_, batch, in_h, in_w, shapes))
+            return Result<ShapeList>::Ok(std::move(shapes));
+
+        const ShapeKey key{model_hash_, batch, in_h, in_w};
+        const std::string& file = cfg_.runtime.shape_cache_file;
+        if (model_hash_ != 0 && ShapeCache::global().lookup(key, shapes, file))
+            return Result<ShapeList>::Ok(std::move(shapes));
+
+        Ort::AllocatedStringPtr in0 = session_->GetInputNameAllocated(0, alloc_);
+        const std::string in_name = in0 ? in0.get() : std::string("input");
+
+        const std::size_t n = session_->GetOutputCount();
+        std::vector<std::string> names;
+        std::vector<const char*> names_c;
+        names.reserve(n);
+        names_c.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            Ort::AllocatedStringPtr on = session_->GetOutputNameAllocated(i, alloc_);
+            names.push_back(on ? on.get() : ("out_" + std::to_string(i)));
+        }
+        for (const auto& nm : names)
+            names_c.push_back(nm.c_str());
+
+        std::vector<float> zero((std::size_t)batch * 3 * (std::size_t)in_h * (std::size_t)in_w, 0.f);
+        const std::vector<int64_t> ishape = {batch, 3, in_h, in_w};
+        std::vector<std::uint16_t> zero_f16;
+        Ort::Value in_tensor = input_tensor_(zero.data(), zero.size(), ishape, zero_f16);
+
+        const char* in_names[] = {in_name.c_str()};
+        auto outs = session_->Run(run_opts_, in_names, &in_tensor, 1, names_c.data(), names_c.size());
+        count_run_();
+
+        shapes.clear();
+        shapes.reserve(outs.size());
+        for (auto& o : outs)
+            shapes.push_back(o.GetTensorTypeAndShapeInfo().GetShape());
+
+        if (model_hash_ != 0) ShapeCache::global().store(key, shapes, file);
+        return Result<ShapeList>::Ok(std::move(shapes));
+    } catch (const std::bad_alloc&) {
+        return Result<ShapeList>::Err(Status::OutOfMemory("output_shapes: bad_alloc"));
+    } catch (const std::exception& e) {
+        return Result<ShapeList>::Err(Status::Internal(std::string("output_shapes: ") + e.what()));
+    } catch (...) {
+        return Result<ShapeList>::Err(Status::Internal("output_shapes: unknown"));
+    }
+}
+
+/// @brief Default: forwards to @ref IEngine::infer_bound and moves the result into @p out.
+Status IEngine::infer_bound_into(const cv::Mat& bgr, int ctx_idx, std::vector<algo::Detection>& out) noexcept {
+    out.clear();
+    auto r = infer_bound(bgr, ctx_idx);
+    if (!r.ok()) return r.status();
+    out = std::move(r.value());
+    return Status::Ok();
+}
+
+/// @brief Default: no direct preprocessing of non-BGR sources, the caller converts the frame to BGR.
+Status IEngine::infer_source_into(const algo::ChwSource&, int, std::vector<algo::Detection>& out) noexcept {
+    out.clear();
+    return Status::Unsupported("infer_source_into: engine needs a BGR frame");
+}
+
+/**
+ * @brief Default batched bound inference: one @ref infer_bound call per image.
+ *
+ * @details
+ * Concrete engines override this with a single-run implementation over a `[N,3,H,W]` binding.
+ * The fallback only validates the arguments and preserves the per-image result order.
+ */
+Result<std::vector<std::vector<algo::Detection>>> IEngine::infer_bound_batch(const cv::Mat* bgr, int count,
+                                                                            int ctx_idx) noexcept {
+    using R = Result<std::vector<std::vector<algo::Detection>>>;
+    try {
+        if (!bgr || count <= 0) return R::Err(Status::Invalid("infer_bound_batch: empty batch"));
+        if (count > batch_) return R::Err(Status::Invalid("infer_bound_batch: count exceeds bound batch"));
+
+        std::vector<std::vector<algo::Detection>> out;
+        out.reserve((std::size_t)count);
+        for (int i = 0; i < count; ++i) {
+            auto r = infer_bound(bgr[i], ctx_idx);
+            if (!r.ok()) return R::Err(r.status());
+            out.push_back(std::move(r.value()));
+        }
+        return R::Ok(std::move(out));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("infer_bound_batch: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("infer_bound_batch: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("infer_bound_batch: unknown"));
+    }
+}
+
+/**
+ * @brief Default batched inference on direct sources: one call per source.
+ *
+ * @details
+ * BGR sources go through @ref infer_bound_into, so engines without direct preprocessing still
+ * serve them; other sources need @ref infer_source_into.
+ */
+Result<std::vector<std::vector<algo::Detection>>> IEngine::infer_sources_batch(const algo::ChwSource* src, int count,
+                                                                              int ctx_idx) noexcept {
+    using R = Result<std::vector<std::vector<algo::Detection>>>;
+    try {
+        if (!src || count <= 0) return R::Err(Status::Invalid("infer_sources_batch: empty batch"));
+        if (count > batch_) return R::Err(Status::Invalid("infer_sources_batch: count exceeds bound batch"));
+
+        std::vector<std::vector<algo::Detection>> out((std::size_t)count);
+        for (int i = 0; i < count; ++i) {
+            const algo::ChwSource& s = src[i];
+            const Status st = (s.packed && s.order == algo::ChannelOrder::BGR)
+                                  ? infer_bound_into(*s.packed, ctx_idx, out[(std::size_t)i])
+                                  : infer_source_into(s, ctx_idx, out[(std::size_t)i]);
+            if (!st.ok()) return R::Err(st);
+        }
+        return R::Ok(std::move(out));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("infer_sources_batch: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("infer_sources_batch: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("infer_sources_batch: unknown"));
+    }
+}
+
+/// @brief Default: engine supports a single bound shape only.
+Status IEngine::setup_binding_pool(const std::vector<std::pair<int, int>>&, int, int) noexcept {
+    return Status::Unsupported("setup_binding_pool: not supported by engine");
+}
+
+int IEngine::pick_bucket_(int w, int h) const noexcept {
+    if (bucket_shapes_.size() <= 1) return bucket_shapes_.empty() ? -1 : 0;
+    return algo::pick_bucket(bucket_shapes_, w, h, cfg_.infer.max_img_size);
+}
+
+Status IEngine::resolve_io_types_() {
+    auto accepted = [](ONNXTensorElementDataType t) {
+        return t == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT || t == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+    };
+    auto unsupported = [](const char* what, std::size_t i, ONNXTensorElementDataType t) {
+        return Status::Unsupported(std::string("create_session: ") + what + " " + std::to_string(i) +
+                                   " has element type " + std::to_string((int)t) +
+                                   "; only float32/float16 are supported (quantize in QDQ format to keep float I/O)");
+    };
+
+    in_type_ = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+    if (session_->GetInputCount() > 0) {
+        in_type_ = session_->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetElementType();
+        if (!accepted(in_type_)) return unsupported("input", 0, in_type_);
+    }
+
+    const std::size_t n = session_->GetOutputCount();
+    out_types_.assign(n, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+    for (std::size_t i = 0; i < n; ++i) {
+        out_types_[i] = session_->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetElementType();
+        if (!accepted(out_types_[i])) return unsupported("output", i, out_types_[i]);
+    }
+    return Status::Ok();
+}
+
+Ort::Value IEngine::tensor_view_(float* f32, std::uint16_t* f16, std::size_t n, const std::vector<int64_t>& shape) {
+    static Ort::MemoryInfo cpu_mem = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    if (f16) {
+        return Ort::Value::CreateTensor(cpu_mem, f16, n * sizeof(std::uint16_t), shape.data(), shape.size(),
+                                        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16);
+    }
+    return Ort::Value::CreateTensor<float>(cpu_mem, f32, n, shape.data(), shape.size());
+}
+
+Ort::Value IEngine::input_tensor_(const float* chw, std::size_t n, const std::vector<int64_t>& shape,
+                                  std::vector<std::uint16_t>& f16) const {
+    if (!half_input_()) return tensor_view_(const_cast<float*>(chw), nullptr, n, shape);
+    f16.resize(n);
+    algo::f32_to_f16(chw, f16.data(), n);
+    return tensor_view_(nullptr, f16.data(), n, shape);
+}
+
+const float* IEngine::tensor_f32_(const Ort::Value& v, std::vector<float>& scratch) {
+    const auto info = v.GetTensorTypeAndShapeInfo();
+    if (info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) return v.GetTensorData<float>();
+    const std::size_t n = info.GetElementCount();
+    scratch.resize(n);
+    algo::f16_to_f32(v.GetTensorData<std::uint16_t>(), scratch.data(), n);
+    return scratch.data();
+}
+
+Result<std::string> IEngine::end_profiling() noexcept {
+    using R = Result<std::string>;
+    try {
+        std::lock_guard<std::mutex> lk(profile_mu_);
+        if (profiling_.load(std::memory_order_relaxed)) {
+            if (!session_) return R::Err(Status::Internal("end_profiling: session is null"));
+            Ort::AllocatedStringPtr path = session_->EndProfilingAllocated(alloc_);
+            profile_file_ = path ? std::string(path.get()) : std::string();
+            profiling_.store(false, std::memory_order_relaxed);
+        }
+        if (profile_file_.empty()) return R::Err(Status::Invalid("end_profiling: profiling is not enabled"));
+        return R::Ok(profile_file_);
+    } catch (const Ort::Exception& e) {
+        return R::Err(Status::Internal(std::string("end_profiling: ") + e.what()));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("end_profiling: bad_alloc"));
+    } catch (...) {
+        return R::Err(Status::Internal("end_profiling: unknown"));
+    }
+}
+
+void IEngine::count_run_() noexcept {
+    if (!profiling_.load(std::memory_order_relaxed)) return;
+    const int limit = cfg_.runtime.profile_runs;
+    if (limit <= 0) return;
+    if (profiled_runs_.fetch_add(1, std::memory_order_relaxed) + 1 == limit) (void)end_profiling();
+}
+
+Status IEngine::open_capture_() noexcept {
+    if (cfg_.runtime.capture_file.empty()) return Status::Ok();
+    auto r = CaptureWriter::open(cfg_.runtime.capture_file, cfg_.task);
+    if (!r.ok()) return r.status();
+    capture_ = std::move(r.value());
+    return Status::Ok();
+}
+
+/// @brief Default: engine does not implement staged execution.
+Status IEngine::stage_input(const cv::Mat&, int) noexcept {
+    return Status::Unsupported("stage_input: not supported by engine");
+}
+
+/// @brief Default: engine does not implement staged execution.
+Status IEngine::stage_run(int) noexcept {
+    return Status::Unsupported("stage_run: not supported by engine");
+}
+
+/// @brief Default: engine does not implement staged execution.
+Result<std::vector<algo::Detection>> IEngine::stage_output(int) noexcept {
+    return Result<std::vector<algo::Detection>>::Err(Status::Unsupported("stage_output: not supported by engine"));
+}
+
+namespace {
+thread_local bool t_serial_postprocess = false;
+} // namespace
+
+/// @brief Sets the calling thread's serial-postprocess flag.
+void IEngine::set_serial_postprocess(bool on) noexcept {
+    t_serial_postprocess = on;
+}
+
+/// @brief Reads the calling thread's serial-postprocess flag.
+bool IEngine::serial_postprocess() noexcept {
+    return t_serial_postprocess;
+}
+
 } // namespace idet::engine
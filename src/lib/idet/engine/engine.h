@@ -21,18 +21,38 @@
 #pragma once
 
 #include "algo/geometry.h"
+#include "algo/preprocess.h"
+#include "engine/capture.h"
+#include "engine/ort_env.h"
+#include "engine/shape_cache.h"
 #include "idet.h"
 #include "internal/opencv_headers.h" // IWYU pragma: keep
 #include "internal/ort_headers.h"    // IWYU pragma: keep
+#include "internal/stage_stats.h"
+#include "platform/buffer_alloc.h"
 #include "status.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace idet::engine {
 
+/**
+ * @brief Tag of the session-less DBNet / SCRFD constructors.
+ *
+ * @details
+ * Such an engine only decodes capture frames (see @ref CaptureFrame) for the replay engine; it
+ * has no session and must not be bound or used for inference.
+ */
+struct DecodeOnly {
+    explicit DecodeOnly() = default;
+};
+
 /**
  * @brief Abstract engine interface for model inference.
  *
@@ -143,6 +163,35 @@ class IEngine {
         return contexts_;
     }
 
+    /**
+     * @brief Maximum batch size (leading input dimension) of the prepared binding.
+     *
+     * @details
+     * Each bound context owns a `[N,3,H,W]` input tensor where `N == bound_batch()`.
+     * A value of 1 means only single-image bound inference was prepared.
+     *
+     * @return Bound batch size, or 0 when no binding is prepared.
+     */
+    int bound_batch() const noexcept {
+        return batch_;
+    }
+
+    /**
+     * @brief Number of bound input shapes (buckets) prepared by the last setup call.
+     *
+     * @details
+     * 1 after @ref setup_binding, the number of distinct shapes after @ref setup_binding_pool and
+     * 0 without binding.
+     */
+    int bound_buckets() const noexcept {
+        return (int)bucket_shapes_.size();
+    }
+
+    /** @brief Effective (aligned) bound input shapes as {width, height}, one per bucket. */
+    const std::vector<std::pair<int, int>>& bucket_shapes() const noexcept {
+        return bucket_shapes_;
+    }
+
     /**
      * @brief Apply a hot configuration update without recreating the ONNX Runtime session.
      *
@@ -174,18 +223,53 @@ class IEngine {
      * Implementations are expected to:
      * - allocate and/or bind I/O buffers for the specified input dimensions,
      * - create per-context binding state to allow concurrent calls to @ref infer_bound,
-     * - set @ref binding_ready_ to true on success and fill @ref bound_w_, @ref bound_h_, @ref contexts_.
+     * - set @ref binding_ready_ to true on success and fill @ref bound_w_, @ref bound_h_, @ref contexts_,
+     *   @ref batch_.
+     *
+     * Batching:
+     * - With @p batch > 1 every context additionally binds a `[batch,3,H,W]` input tensor (and the
+     *   matching outputs) used by @ref infer_bound_batch. The single-image binding used by
+     *   @ref infer_bound aliases slot 0 of the same buffers, so no extra memory is spent on it.
+     * - The model must accept a dynamic (or matching) leading batch dimension; otherwise an
+     *   error status is returned.
+     *
+     * With @ref idet::InferenceOptions::letterbox frames are letterboxed into the bound shape like
+     * the buckets of @ref setup_binding_pool; the padding is written once here.
      *
      * @param w Target input width in pixels (must be > 0).
      * @param h Target input height in pixels (must be > 0).
      * @param contexts Number of contexts to prepare (must be > 0).
+     * @param batch Maximum number of images per bound run (normalized to >= 1).
      * @return @ref Status::Ok() on success, error status otherwise.
      *
      * @note
      * Some engines may internally align dimensions (e.g., to multiples of 32). In that case
      * @ref bound_w() / @ref bound_h() should reflect the effective bound shape.
      */
-    virtual Status setup_binding(int w, int h, int contexts) noexcept = 0;
+    virtual Status setup_binding(int w, int h, int contexts, int batch) noexcept = 0;
+
+    /**
+     * @brief Prepare bound inference for several input shapes at once (a binding pool).
+     *
+     * @details
+     * Every shape becomes a bucket with its own buffers and bindings for each of the @p contexts
+     * contexts. Each bound call routes its frame to the bucket that keeps the most image pixels
+     * (@ref idet::algo::pick_bucket) and letterboxes it there: the image is scaled without
+     * distortion into the top-left corner and the rest of the input is constant padding. The
+     * padded part of the output is never decoded. Context indices keep their meaning: a caller
+     * owning context @c i may use any bucket through it.
+     *
+     * Memory grows with `shapes x contexts x batch`; the ORT session is shared by all buckets.
+     * The default implementation returns Unsupported.
+     *
+     * @param shapes Input shapes as {width, height} (aligned like @ref setup_binding; duplicates
+     *        after alignment are merged).
+     * @param contexts Number of contexts to prepare (normalized to >= 1).
+     * @param batch Maximum number of images per bound run (normalized to >= 1).
+     * @return @ref Status::Ok() on success, error status otherwise.
+     */
+    virtual Status setup_binding_pool(const std::vector<std::pair<int, int>>& shapes, int contexts,
+                                      int batch) noexcept;
 
     /**
      * @brief Tear down any prepared binding state and return to unbound mode.
@@ -239,6 +323,160 @@ class IEngine {
      */
     virtual Result<std::vector<algo::Detection>> infer_bound(const cv::Mat& bgr, int ctx_idx) noexcept = 0;
 
+    /**
+     * @brief Bound inference that writes detections into a caller-owned vector.
+     *
+     * @details
+     * Same contract as @ref infer_bound, but @p out is cleared and refilled so its capacity is
+     * reused across frames. Engines override this to decode with per-context scratch, making the
+     * steady-state bound path allocation-free. The default forwards to @ref infer_bound.
+     *
+     * @param bgr Input image (expected BGR, `CV_8UC3`).
+     * @param ctx_idx Binding context index to use.
+     * @param out Destination detections (left empty on failure).
+     * @return @ref idet::Status::Ok() on success, otherwise an error status.
+     *
+     * @pre @ref binding_ready() is true.
+     */
+    virtual Status infer_bound_into(const cv::Mat& bgr, int ctx_idx, std::vector<algo::Detection>& out) noexcept;
+
+    /**
+     * @brief Inference on a non-BGR source (RGB/RGBA/BGRA or 4:2:0 YUV) without a converted copy.
+     *
+     * @details
+     * Engines whose preprocessing runs on @ref idet::algo::resize_to_chw override this to feed the
+     * source straight into the fused kernel. The default returns @ref idet::Status::Unsupported, and
+     * callers then convert the frame to BGR and use @ref infer_unbound / @ref infer_bound_into.
+     *
+     * @param src Packed image with its channel order, or luma/chroma planes.
+     * @param ctx_idx Binding context index, or -1 for unbound inference.
+     * @param out Destination detections (cleared first).
+     * @return @ref idet::Status::Ok() on success, otherwise an error status.
+     */
+    virtual Status infer_source_into(const algo::ChwSource& src, int ctx_idx,
+                                     std::vector<algo::Detection>& out) noexcept;
+
+    /**
+     * @brief Run bound inference on up to @ref bound_batch() images with a single session run.
+     *
+     * @details
+     * All images are preprocessed into consecutive slices of the context's `[N,3,H,W]` input
+     * tensor, the session is executed once, and each output slice is decoded independently.
+     * When @p count is smaller than @ref bound_batch(), the trailing slots keep stale data and
+     * their outputs are ignored.
+     *
+     * The default implementation falls back to calling @ref infer_bound once per image, which keeps
+     * engines without a batched binding functional.
+     *
+     * @param bgr Pointer to @p count input images (expected BGR, `CV_8UC3`).
+     * @param count Number of images in [1, bound_batch()].
+     * @param ctx_idx Binding context index to use.
+     * @return Per-image detections (same order as the input) or an error status.
+     *
+     * @pre @ref binding_ready() is true.
+     */
+    virtual Result<std::vector<std::vector<algo::Detection>>> infer_bound_batch(const cv::Mat* bgr, int count,
+                                                                                int ctx_idx) noexcept;
+
+    /**
+     * @brief Batched bound inference on direct sources (see @ref infer_source_into).
+     *
+     * @details
+     * Same contract as @ref infer_bound_batch, but each slot is resized straight from its source, so
+     * crops of one frame (zero-copy views into it) need no BGR copy. Engines with a binding pool
+     * run the sources of each bucket together. The default implementation calls
+     * @ref infer_bound_into for BGR sources and @ref infer_source_into for the others, one per
+     * source.
+     *
+     * @param src Pointer to @p count sources.
+     * @param count Number of sources in [1, bound_batch()].
+     * @param ctx_idx Binding context index to use.
+     * @return Per-source detections (same order as the input) or an error status.
+     *
+     * @pre @ref binding_ready() is true.
+     */
+    virtual Result<std::vector<std::vector<algo::Detection>>> infer_sources_batch(const algo::ChwSource* src,
+                                                                                  int count, int ctx_idx) noexcept;
+
+    /**
+     * @brief Whether this engine splits bound inference into the three stage calls below.
+     *
+     * @details
+     * Staged execution lets the asynchronous pipeline overlap preprocessing of frame N+1 with
+     * the session run of frame N and the decoding of frame N-1, each on a different context.
+     * Engines that return false are driven through @ref infer_bound instead.
+     */
+    virtual bool supports_stages() const noexcept {
+        return false;
+    }
+
+    /**
+     * @brief Stage 1 of bound inference: preprocess @p bgr into the input buffer of @p ctx_idx.
+     *
+     * @details
+     * Also records the per-frame geometry (source size, scale) needed by @ref stage_output.
+     * A sequence `stage_input -> stage_run -> stage_output` on one context is equivalent to
+     * @ref infer_bound. Different contexts may be in different stages concurrently.
+     *
+     * @param bgr Input image (expected BGR, `CV_8UC3`); only read during this call.
+     * @param ctx_idx Binding context index.
+     * @return @ref idet::Status::Ok() on success; Unsupported by default.
+     */
+    virtual Status stage_input(const cv::Mat& bgr, int ctx_idx) noexcept;
+
+    /**
+     * @brief Stage 2 of bound inference: run the session on the context's bound I/O.
+     * @param ctx_idx Binding context index previously filled by @ref stage_input.
+     * @return @ref idet::Status::Ok() on success; Unsupported by default.
+     */
+    virtual Status stage_run(int ctx_idx) noexcept;
+
+    /**
+     * @brief Stage 3 of bound inference: decode the context's bound outputs.
+     * @param ctx_idx Binding context index previously executed by @ref stage_run.
+     * @return Detections in original image coordinates; Unsupported by default.
+     */
+    virtual Result<std::vector<algo::Detection>> stage_output(int ctx_idx) noexcept;
+
+    /**
+     * @brief Marks the calling thread as one of several concurrent tile workers.
+     *
+     * @details
+     * Engines may parallelize postprocessing of a single map internally (see
+     * @ref idet::RuntimePolicy::post_omp_threads). Threads that already run tiles side by side set
+     * this flag so that decoding on them stays serial instead of spawning nested regions.
+     * Tile loops that run inside a @ref idet::platform::ThreadPool::parallel_for region are
+     * detected through @ref idet::platform::ThreadPool::in_parallel and need not set it.
+     *
+     * @param on New value for the calling thread.
+     */
+    static void set_serial_postprocess(bool on) noexcept;
+
+    /** @brief Whether @ref set_serial_postprocess was enabled on the calling thread. */
+    static bool serial_postprocess() noexcept;
+
+    /**
+     * @brief Stops ORT profiling of the session and returns the trace path.
+     *
+     * @details
+     * Idempotent: after the trace is written (here or by @ref count_run_) the same path is
+     * returned. Invalid when @ref idet::RuntimePolicy::profile_prefix was empty.
+     */
+    Result<std::string> end_profiling() noexcept;
+
+#if IDET_WITH_STATS
+    /**
+     * @brief Stage statistics of this engine.
+     *
+     * @details
+     * Engines record the preprocess, run and decode stages; the detector facade records
+     * suppression and frame counters into the same collector.
+     */
+    internal::StatsCollector& stats() const noexcept {
+        return stats_;
+    }
+#endif
+
   protected:
     /**
      * @brief Protected constructor for derived engines.
@@ -289,21 +527,22 @@ class IEngine {
      *
      * @details
      * ONNX Runtime uses an environment object to manage logging and global state. This helper provides
-     * a single process-wide instance:
+     * a single process-wide instance (@ref OrtEnvironment::global):
      * - Logging level is fixed to `ORT_LOGGING_LEVEL_ERROR`.
      * - Logging identifier is taken from @p log_id if non-empty, otherwise `"idet"`.
+     * - Global thread pools are created if @p rt requests @ref idet::RuntimePolicy::ort_global_pools.
      *
      * @warning
      * The first call constructs the static environment. Subsequent calls ignore different @p log_id
-     * values because the singleton already exists. If distinct per-engine log identifiers are required,
-     * the design would need to change.
+     * values and pool settings because the singleton already exists. If distinct per-engine log
+     * identifiers are required, the design would need to change.
      *
+     * @param rt Runtime policy of the engine.
      * @param log_id Optional logging identifier string (may be null/empty).
      * @return Reference to the global ORT environment.
      */
-    static Ort::Env& global_env_(const char* log_id) {
-        static Ort::Env env(ORT_LOGGING_LEVEL_ERROR, (log_id && log_id[0]) ? log_id : "idet");
-        return env;
+    static Ort::Env& global_env_(const RuntimePolicy& rt, const char* log_id) {
+        return OrtEnvironment::global().env(rt, log_id);
     }
 
     /**
@@ -314,7 +553,9 @@ class IEngine {
      * - resolve the model source:
      *   - from filesystem @p model_path, or
      *   - from an embedded model blob selected by @p engine_kind (if the build enables embedding),
-     * - initialize @ref session_ with @ref env_ and @ref so_.
+     * - initialize @ref session_ with @ref env_ and @ref so_, or share an equivalent live session
+     *   (@ref idet::RuntimePolicy::share_session),
+     * - load or produce @ref idet::RuntimePolicy::optimized_model_file when set.
      *
      * Errors should be converted into @ref idet::Status with actionable messages.
      *
@@ -324,6 +565,112 @@ class IEngine {
      */
     Status create_session_(const std::string& model_path, EngineKind engine_kind = EngineKind::None) noexcept;
 
+    /**
+     * @brief Opens @ref capture_ for @ref idet::RuntimePolicy::capture_file (no-op when empty).
+     *
+     * @details
+     * Called by the model-backed engine constructors; decode-only and replay engines never record.
+     */
+    Status open_capture_() noexcept;
+
+    /**
+     * @brief Output shapes of the session for an input of shape [batch,3,in_h,in_w].
+     *
+     * @details
+     * Resolution order, cheapest first:
+     * 1) shapes declared by the model (ORT type info), when the declared input matches the
+     *    requested one and every output dimension is static (a symbolic batch axis is filled
+     *    with @p batch),
+     * 2) @ref ShapeCache::global, keyed by @ref model_hash_ (and backed by
+     *    @ref idet::RuntimePolicy::shape_cache_file when set),
+     * 3) a zero-input probe run over all outputs, whose result is stored in the cache.
+     *
+     * @param batch Leading input dimension (> 0).
+     * @param in_h Input height (> 0).
+     * @param in_w Input width (> 0).
+     * @return One shape per session output (session order), or the probe error.
+     */
+    Result<ShapeList> output_shapes_(int batch, int in_h, int in_w) noexcept;
+
+    /**
+     * @brief Bucket of the current binding that a @p w x @p h frame is routed to.
+     *
+     * @details
+     * Always 0 for a single-shape binding; otherwise @ref idet::algo::pick_bucket over
+     * @ref bucket_shapes_ with the configured @c max_img_size.
+     *
+     * @return Bucket index, or -1 without binding.
+     */
+    int pick_bucket_(int w, int h) const noexcept;
+
+    /**
+     * @brief Counts one session run for @ref idet::RuntimePolicy::profile_runs.
+     *
+     * @details
+     * Called by engines after every @c Run; the run that reaches the limit writes the trace.
+     * A no-op (one relaxed load) when profiling is off.
+     */
+    void count_run_() noexcept;
+
+    /**
+     * @brief Reads the element types of the session input and outputs into @ref in_type_ / @ref out_types_.
+     *
+     * @details
+     * Called by @ref create_session_. Only float32 and float16 are accepted: engines preprocess and
+     * decode in float32 and convert float16 tensors with @ref idet::algo::f32_to_f16 /
+     * @ref idet::algo::f16_to_f32. INT8 QDQ models keep float32 I/O and need no conversion.
+     *
+     * @return Unsupported for any other element type.
+     */
+    Status resolve_io_types_();
+
+    /** @brief Whether the session input is float16. */
+    bool half_input_() const noexcept {
+        return in_type_ == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+    }
+
+    /** @brief Whether session output @p i is float16. */
+    bool half_output_(std::size_t i) const noexcept {
+        return i < out_types_.size() && out_types_[i] == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+    }
+
+    /**
+     * @brief CPU tensor view of @p n elements with shape @p shape for a binding.
+     *
+     * @details
+     * Views @p f16 as a float16 tensor when it is non-null, otherwise @p f32 as a float32 tensor.
+     * No data is copied; the caller keeps the buffer alive and converts it around each run.
+     */
+    static Ort::Value tensor_view_(float* f32, std::uint16_t* f16, std::size_t n, const std::vector<int64_t>& shape);
+
+    /**
+     * @brief Input tensor over a float32 CHW buffer for an unbound run.
+     *
+     * @details
+     * A view of @p chw for a float32 input; for a float16 input the data is converted into
+     * @p f16 (resized to @p n) and viewed from there, so @p f16 must outlive the run.
+     */
+    Ort::Value input_tensor_(const float* chw, std::size_t n, const std::vector<int64_t>& shape,
+                             std::vector<std::uint16_t>& f16) const;
+
+    /**
+     * @brief float32 data of an output tensor.
+     *
+     * @details
+     * Returns the tensor data directly for float32; converts a float16 tensor into @p scratch.
+     */
+    static const float* tensor_f32_(const Ort::Value& v, std::vector<float>& scratch);
+
+    /**
+     * @brief Replaces @p buf by @p n zeros allocated per @ref idet::RuntimePolicy::bound_buffers.
+     *
+     * @details
+     * The zeros are written by the calling thread, which thereby places the pages (first touch).
+     */
+    template <class T> void bound_assign_(platform::BoundBuffer<T>& buf, std::size_t n) const {
+        buf = platform::BoundBuffer<T>(n, T{}, platform::BufferAllocator<T>(cfg_.runtime.bound_buffers));
+    }
+
   protected:
     /**
      * @brief Stored configuration snapshot for the engine instance.
@@ -364,6 +711,29 @@ class IEngine {
      */
     int contexts_ = 0;
 
+    /**
+     * @brief Aligned input shape {width, height} of every prepared bucket.
+     *
+     * @see bucket_shapes
+     */
+    std::vector<std::pair<int, int>> bucket_shapes_;
+
+    /**
+     * @brief Whether bound frames are letterboxed into their bucket instead of stretched.
+     *
+     * @details
+     * Always set by @ref setup_binding_pool; a single-shape @ref setup_binding letterboxes only
+     * with @ref idet::InferenceOptions::letterbox and otherwise stretches frames to the bound shape.
+     */
+    bool letterbox_ = false;
+
+    /**
+     * @brief Prepared bound batch size (leading input dimension).
+     *
+     * @see bound_batch
+     */
+    int batch_ = 0;
+
     /**
      * @brief Reference to the process-wide ONNX Runtime environment.
      *
@@ -383,12 +753,23 @@ class IEngine {
     Ort::SessionOptions so_;
 
     /**
-     * @brief ONNX Runtime session handle (may be null before creation).
+     * @brief ONNX Runtime session handle (null before creation).
+     *
+     * @details
+     * Created by @ref create_session_; with @ref idet::RuntimePolicy::share_session it may be
+     * shared with other engines of the same model (see @ref SessionRegistry). Sessions are
+     * immutable and @c Run is thread-safe; all per-engine state lives in the bindings.
+     */
+    std::shared_ptr<Ort::Session> session_;
+
+    /**
+     * @brief Content hash of the loaded model (file or embedded blob); 0 if unknown.
      *
      * @details
-     * The session is created by @ref create_session_.
+     * Computed by @ref create_session_ and used to key @ref ShapeCache entries, so that
+     * different files with identical contents share probed shapes and edited files do not.
      */
-    Ort::Session session_{nullptr};
+    std::uint64_t model_hash_ = 0;
 
     /**
      * @brief Default ONNX Runtime allocator helper.
@@ -397,6 +778,46 @@ class IEngine {
      * Used for allocating ORT-managed buffers and for allocator-backed queries.
      */
     Ort::AllocatorWithDefaultOptions alloc_;
+
+    /**
+     * @brief Run options passed to every @c Session::Run of this engine.
+     *
+     * @details
+     * Null (ORT defaults) unless @ref idet::RuntimePolicy::ort_arena requests arena shrinkage,
+     * which is a per-run setting in ORT. Set up by @ref create_session_ and read-only afterwards.
+     */
+    Ort::RunOptions run_opts_{nullptr};
+
+    /** @brief Element type of the session input (see @ref resolve_io_types_). */
+    ONNXTensorElementDataType in_type_ = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+
+    /** @brief Element type of every session output, in session order. */
+    std::vector<ONNXTensorElementDataType> out_types_;
+
+    /** @brief Whether the session was created with profiling and the trace is not written yet. */
+    std::atomic<bool> profiling_{false};
+
+    /** @brief Session runs since creation while profiling (see @ref count_run_). */
+    std::atomic<int> profiled_runs_{0};
+
+    /** @brief Serializes @ref end_profiling. */
+    std::mutex profile_mu_;
+
+    /** @brief Path of the written trace (empty until then). */
+    std::string profile_file_;
+
+    /** @brief Recorder of the decoded frames (null unless @ref idet::RuntimePolicy::capture_file is set). */
+    std::shared_ptr<CaptureWriter> capture_;
+
+#if IDET_WITH_STATS
+    /**
+     * @brief Stage statistics (see @ref stats).
+     *
+     * @details
+     * Mutable because decoding helpers are const; the collector is internally synchronized.
+     */
+    mutable internal::StatsCollector stats_;
+#endif
 };
 
 } // namespace idet::engine
@@ -1,7 +1,7 @@
 /**
  * @file engine_factory.cpp
  * @ingroup idet_engine
- * @brief Engine factory implementation (DBNet/SCRFD selection).
+ * @brief Engine factory implementation (DBNet/SCRFD/Replay selection).
  *
  * @details
  * Implements @ref idet::engine::create_engine:
@@ -16,6 +16,7 @@
 #include "engine/engine_factory.h"
 
 #include "engine/dbnet.h"
+#include "engine/replay.h"
 #include "engine/scrfd.h"
 
 #include <exception>
@@ -77,6 +78,11 @@ Result<std::unique_ptr<IEngine>> create_engine(const DetectorConfig& cfg) noexce
             return Result<std::unique_ptr<IEngine>>::Ok(std::move(p));
         }
 
+        case EngineKind::Replay: {
+            std::unique_ptr<IEngine> p(new Replay(cfg));
+            return Result<std::unique_ptr<IEngine>>::Ok(std::move(p));
+        }
+
         default:
             return Result<std::unique_ptr<IEngine>>::Err(Status::Unsupported("engine_factory: unsupported EngineKind"));
         }
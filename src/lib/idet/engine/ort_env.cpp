@@ -0,0 +1,87 @@
+/**
+ * @file ort_env.cpp
+ * @ingroup idet_engine
+ * @brief Implementation of the process-wide ONNX Runtime environment.
+ */
+
+#include "engine/ort_env.h"
+
+#include "platform/cross_topology.h"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace idet::engine {
+
+namespace {
+
+/**
+ * @brief ORT affinity string for the intra-op pool: one entry per pool thread except the caller.
+ *
+ * @details
+ * ORT numbers logical processors from 1 and expects `intra_threads - 1` entries separated by
+ * ';'. Returns an empty string when the CPUs cannot cover the pool.
+ */
+std::string intra_affinity(const std::vector<int>& cpus, int intra_threads) {
+    if (intra_threads <= 1 || cpus.size() < (std::size_t)intra_threads) return {};
+    std::string s;
+    for (int t = 1; t < intra_threads; ++t) {
+        if (!s.empty()) s += ';';
+        s += std::to_string(cpus[(std::size_t)t] + 1);
+    }
+    return s;
+}
+
+} // namespace
+
+OrtEnvironment& OrtEnvironment::global() noexcept {
+    static OrtEnvironment environment;
+    return environment;
+}
+
+Ort::Env& OrtEnvironment::env(const RuntimePolicy& rt, const char* log_id) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (env_) return *env_;
+
+    const char* id = (log_id && log_id[0]) ? log_id : "idet";
+    if (!rt.ort_global_pools) {
+        env_ = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_ERROR, id);
+        return *env_;
+    }
+
+    Pools p;
+    p.intra_threads = rt.ort_intra_threads > 0 ? rt.ort_intra_threads : 0;
+    p.inter_threads = rt.ort_inter_threads > 0 ? rt.ort_inter_threads : 0;
+
+    Ort::ThreadingOptions to;
+    to.SetGlobalIntraOpNumThreads(p.intra_threads);
+    to.SetGlobalInterOpNumThreads(p.inter_threads);
+    if (rt.ort_spin != SpinPolicy::Default) to.SetGlobalSpinControl(rt.ort_spin == SpinPolicy::Spin ? 1 : 0);
+    if (rt.ort_denormal_as_zero) to.SetGlobalDenormalAsZero();
+
+    // Pin the pool threads; without a usable topology (non-Linux) they inherit the process mask.
+    const std::vector<int> cpus = platform::select_pool_cpus((std::size_t)p.intra_threads);
+    const std::string aff = intra_affinity(cpus, p.intra_threads);
+    if (!aff.empty()) {
+        Ort::ThrowOnError(Ort::GetApi().SetGlobalIntraOpThreadAffinity(to, aff.c_str()));
+        p.intra_cpus.assign(cpus.begin() + 1, cpus.begin() + p.intra_threads);
+    }
+
+    env_ = std::make_unique<Ort::Env>(to, ORT_LOGGING_LEVEL_ERROR, id);
+    global_pools_ = true;
+    pools_ = std::move(p);
+    return *env_;
+}
+
+bool OrtEnvironment::has_global_pools() const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return global_pools_;
+}
+
+OrtEnvironment::Pools OrtEnvironment::pools() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return pools_;
+}
+
+} // namespace idet::engine
@@ -0,0 +1,76 @@
+/**
+ * @file ort_env.h
+ * @ingroup idet_engine
+ * @brief Process-wide ONNX Runtime environment with optional global intra-/inter-op thread pools.
+ *
+ * @details
+ * By default every session owns its intra-op and inter-op pools, so several detectors in one
+ * process (e.g. text and face) each start pools sized as if they had the machine to themselves.
+ * With @ref idet::RuntimePolicy::ort_global_pools the environment is created with ORT global
+ * pools instead; sessions then disable their per-session threads and all detectors queue their
+ * operators on one set of threads. The intra-op pool threads are pinned one per CPU, picked by
+ * @ref idet::platform::select_pool_cpus (the same topology-aware order as the process placement).
+ *
+ * The environment is created once, by the first engine or by @ref idet::setup_runtime_policy;
+ * whether it has global pools, their sizes and pinning are fixed from then on.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "idet.h"
+#include "internal/ort_headers.h" // IWYU pragma: keep
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace idet::engine {
+
+/**
+ * @brief Owner of the process-wide @c Ort::Env.
+ *
+ * @details
+ * Thread-safe; the environment outlives every engine (static storage duration).
+ */
+class OrtEnvironment final {
+  public:
+    /** @brief Global pool setup of the environment (all zero/empty: per-session pools). */
+    struct Pools {
+        int intra_threads = 0;       ///< Intra-op pool size (0: ORT default, one per physical core)
+        int inter_threads = 0;       ///< Inter-op pool size (0: ORT default)
+        std::vector<int> intra_cpus; ///< CPU of each intra-op pool thread; the calling thread is not pinned
+    };
+
+    OrtEnvironment() = default;
+    OrtEnvironment(const OrtEnvironment&) = delete;
+    OrtEnvironment& operator=(const OrtEnvironment&) = delete;
+
+    /** @brief Process-wide instance. */
+    static OrtEnvironment& global() noexcept;
+
+    /**
+     * @brief Returns the environment, creating it on first use.
+     *
+     * @param rt Policy of the caller. Only the first call's @ref idet::RuntimePolicy::ort_global_pools,
+     *        thread counts, spin and denormal settings shape the pools.
+     * @param log_id ORT log identifier used on creation (@c "idet" when null/empty).
+     * @throws Ort::Exception or std::bad_alloc if the environment cannot be created.
+     */
+    Ort::Env& env(const RuntimePolicy& rt, const char* log_id = nullptr);
+
+    /** @brief True once the environment exists and was created with global pools. */
+    bool has_global_pools() const noexcept;
+
+    /** @brief Copy of the global pool setup (default-constructed if there are none). */
+    Pools pools() const;
+
+  private:
+    mutable std::mutex mu_;
+    std::unique_ptr<Ort::Env> env_;
+    bool global_pools_ = false;
+    Pools pools_;
+};
+
+} // namespace idet::engine
@@ -0,0 +1,161 @@
+/**
+ * @file replay.cpp
+ * @ingroup idet_engine
+ * @brief Replay engine implementation (frame cursor, synthetic latency, decoding).
+ */
+
+#include "engine/replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace idet::engine {
+
+namespace {
+
+/// @brief splitmix64 finalizer; maps a frame index to a well-mixed 64-bit value.
+std::uint64_t mix64(std::uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+Replay::Replay(const DetectorConfig& cfg) : IEngine(cfg, "idet-replay") {
+    const Status vs = cfg_.validate();
+    if (!vs.ok()) throw std::runtime_error(vs.message);
+    if (cfg_.engine != EngineKind::Replay) throw std::runtime_error("Replay: cfg.engine must be Replay");
+
+    auto r = read_capture(cfg_.model_path);
+    if (!r.ok()) throw std::runtime_error(r.status().message);
+    capture_data_ = std::move(r.value());
+    if (capture_data_.task != cfg_.task)
+        throw std::runtime_error("Replay: " + cfg_.model_path + " records another task");
+    if (capture_data_.frames.empty()) throw std::runtime_error("Replay: " + cfg_.model_path + " holds no frames");
+
+    if (cfg_.task == Task::Text) {
+        text_ = std::make_unique<DBNet>(cfg_, DecodeOnly{});
+    } else {
+        std::vector<std::string> names;
+        for (const CaptureTensor& t : capture_data_.frames.front().tensors)
+            names.push_back(t.name);
+        face_ = std::make_unique<SCRFD>(cfg_, DecodeOnly{}, std::move(names));
+    }
+    cache_hot_();
+}
+
+void Replay::cache_hot_() noexcept {
+    latency_ms_ = cfg_.infer.replay.latency_ms;
+    jitter_ms_ = cfg_.infer.replay.jitter_ms;
+    spin_ = cfg_.infer.replay.spin;
+    loop_ = cfg_.infer.replay.loop;
+}
+
+Status Replay::update_hot(const DetectorConfig& next) noexcept {
+    const Status chk = check_hot_update_(next);
+    if (!chk.ok()) return chk;
+
+    const Status ds = text_ ? text_->update_hot(next) : face_->update_hot(next);
+    if (!ds.ok()) return ds;
+
+    apply_hot_common_(next);
+    cache_hot_();
+    return Status::Ok();
+}
+
+Status Replay::setup_binding(int w, int h, int contexts, int batch) noexcept {
+    return setup_binding_pool({{w, h}}, contexts, batch);
+}
+
+Status Replay::setup_binding_pool(const std::vector<std::pair<int, int>>& shapes, int contexts, int batch) noexcept {
+    unset_binding();
+    try {
+        for (const auto& sh : shapes) {
+            if (sh.first <= 0 || sh.second <= 0) return Status::Invalid("Replay::setup_binding: non-positive w/h");
+            if (std::find(bucket_shapes_.begin(), bucket_shapes_.end(), sh) == bucket_shapes_.end())
+                bucket_shapes_.push_back(sh);
+            bound_w_ = std::max(bound_w_, sh.first);
+            bound_h_ = std::max(bound_h_, sh.second);
+        }
+        if (bucket_shapes_.empty()) return Status::Invalid("Replay::setup_binding: no shapes");
+    } catch (const std::bad_alloc&) {
+        unset_binding();
+        return Status::OutOfMemory("Replay::setup_binding: bad_alloc");
+    }
+    contexts_ = std::max(1, contexts);
+    batch_ = std::max(1, batch);
+    binding_ready_ = true;
+    return Status::Ok();
+}
+
+void Replay::unset_binding() noexcept {
+    binding_ready_ = false;
+    bound_w_ = bound_h_ = 0;
+    contexts_ = 0;
+    batch_ = 0;
+    bucket_shapes_.clear();
+}
+
+double Replay::latency_s_(std::uint64_t index) const noexcept {
+    double ms = latency_ms_;
+    if (jitter_ms_ > 0.0f) {
+        const double u = (double)(mix64(index) >> 11) * (1.0 / 9007199254740992.0); // [0, 1)
+        ms += (2.0 * u - 1.0) * jitter_ms_;
+    }
+    return ms > 0.0 ? ms * 1e-3 : 0.0;
+}
+
+Status Replay::next_(std::vector<algo::Detection>& out) noexcept {
+    out.clear();
+    const std::uint64_t index = cursor_.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t n = capture_data_.frames.size();
+    if (!loop_ && index >= n) return Status::Unavailable("Replay: all " + std::to_string(n) + " frames replayed");
+    const CaptureFrame& f = capture_data_.frames[(std::size_t)(index % n)];
+
+    const double wait = latency_s_(index);
+    if (wait > 0.0) {
+        IDET_STAGE_SCOPE(&stats_, Stage::Run);
+        using Clock = std::chrono::steady_clock;
+        const auto until =
+            Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(wait));
+        if (spin_) {
+            while (Clock::now() < until) {
+            }
+        } else {
+            std::this_thread::sleep_until(until);
+        }
+    }
+
+    IDET_STAGE_SCOPE(&stats_, Stage::Decode);
+    return text_ ? text_->decode_capture(f, out) : face_->decode_capture(f, out);
+}
+
+Result<std::vector<algo::Detection>> Replay::infer_unbound(const cv::Mat&) noexcept {
+    std::vector<algo::Detection> out;
+    const Status s = next_(out);
+    if (!s.ok()) return Result<std::vector<algo::Detection>>::Err(s);
+    return Result<std::vector<algo::Detection>>::Ok(std::move(out));
+}
+
+Result<std::vector<algo::Detection>> Replay::infer_bound(const cv::Mat& bgr, int ctx_idx) noexcept {
+    if (!binding_ready_) return Result<std::vector<algo::Detection>>::Err(Status::Invalid("Replay: binding not ready"));
+    if (ctx_idx < 0 || ctx_idx >= contexts_)
+        return Result<std::vector<algo::Detection>>::Err(Status::Invalid("Replay: ctx_idx out of range"));
+    return infer_unbound(bgr);
+}
+
+Status Replay::infer_bound_into(const cv::Mat&, int ctx_idx, std::vector<algo::Detection>& out) noexcept {
+    out.clear();
+    if (!binding_ready_) return Status::Invalid("Replay: binding not ready");
+    if (ctx_idx < 0 || ctx_idx >= contexts_) return Status::Invalid("Replay: ctx_idx out of range");
+    return next_(out);
+}
+
+} // namespace idet::engine
@@ -0,0 +1,109 @@
+/**
+ * @file replay.h
+ * @ingroup idet_engine
+ * @brief Model-free engine replaying recorded model outputs (see @ref idet::EngineKind::Replay).
+ *
+ * @details
+ * @ref idet::engine::Replay loads a capture file (see @ref capture.h) and answers every inference
+ * call with the next recorded frame, decoded by a session-less DBNet or SCRFD engine with the
+ * current thresholds. The input image is ignored; a synthetic latency stands in for the model run.
+ *
+ * This makes the layers above the engine (tiling, NMS, batching, the streaming pipeline, the
+ * stats) reproducible and measurable on machines without the model or ONNX Runtime providers.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "engine/capture.h"
+#include "engine/dbnet.h"
+#include "engine/engine.h"
+#include "engine/scrfd.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace idet::engine {
+
+/**
+ * @brief Engine serving recorded frames in order with a configurable latency.
+ *
+ * @details
+ * Frames are handed out by one atomic cursor shared by all callers and contexts, so concurrent
+ * callers each get a distinct frame. The latency (@ref idet::ReplayOptions) is drawn per frame
+ * index, so a replay is deterministic regardless of thread timing.
+ *
+ * Binding only records the requested shapes: bound and unbound calls behave the same.
+ *
+ * Thread-safety: all inference entry points are safe for concurrent calls.
+ */
+class Replay final : public IEngine {
+  public:
+    /**
+     * @brief Loads the capture @c cfg.model_path and creates the decoder for @c cfg.task.
+     *
+     * @throws std::runtime_error if the file cannot be read, holds no frames or records another task.
+     */
+    explicit Replay(const DetectorConfig& cfg);
+
+    EngineKind kind() const noexcept override {
+        return EngineKind::Replay;
+    }
+
+    Task task() const noexcept override {
+        return cfg_.task;
+    }
+
+    /** @brief Number of recorded frames. */
+    std::size_t frames() const noexcept {
+        return capture_data_.frames.size();
+    }
+
+    /** @brief Applies thresholds and the latency model; forwarded to the decoder. */
+    Status update_hot(const DetectorConfig& cfg) noexcept override;
+
+    /** @brief Records the bound shape; no buffers are allocated. */
+    Status setup_binding(int w, int h, int contexts, int batch) noexcept override;
+
+    /** @brief Records the bucket shapes; no buffers are allocated. */
+    Status setup_binding_pool(const std::vector<std::pair<int, int>>& shapes, int contexts,
+                              int batch) noexcept override;
+
+    void unset_binding() noexcept override;
+
+    /** @brief Decodes the next frame (@p bgr is ignored). */
+    Result<std::vector<algo::Detection>> infer_unbound(const cv::Mat& bgr) noexcept override;
+
+    /** @brief Same as @ref infer_unbound once a binding is set up. */
+    Result<std::vector<algo::Detection>> infer_bound(const cv::Mat& bgr, int ctx_idx) noexcept override;
+
+    /** @brief Same as @ref infer_bound, reusing the capacity of @p out. */
+    Status infer_bound_into(const cv::Mat& bgr, int ctx_idx, std::vector<algo::Detection>& out) noexcept override;
+
+  private:
+    /** @brief Copies the latency model from @ref cfg_. */
+    void cache_hot_() noexcept;
+
+    /** @brief Takes the next frame, waits its latency and decodes it into @p out. */
+    Status next_(std::vector<algo::Detection>& out) noexcept;
+
+    /** @brief Latency of frame @p index in seconds (jitter from a hash of the index). */
+    double latency_s_(std::uint64_t index) const noexcept;
+
+    Capture capture_data_;
+    std::unique_ptr<DBNet> text_;  ///< Decoder of Text captures
+    std::unique_ptr<SCRFD> face_;  ///< Decoder of Face captures
+    std::atomic<std::uint64_t> cursor_{0};
+
+    float latency_ms_ = 0.0f;
+    float jitter_ms_ = 0.0f;
+    bool spin_ = false;
+    bool loop_ = true;
+};
+
+} // namespace idet::engine
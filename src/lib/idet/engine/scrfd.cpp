@@ -5,7 +5,7 @@
  *
  * @details
  * This translation unit implements @ref idet::engine::SCRFD:
- * - CHW float32 preprocessing from BGR input,
+ * - CHW float32 preprocessing from BGR input (converted to float16 for float16 models),
  * - unbound inference (per-call tensors) via Ort::Session::Run,
  * - bound inference via Ort::IoBinding and preallocated I/O buffers,
  * - robust probing of SCRFD output tensor layouts/shapes across common export variants,
@@ -15,7 +15,10 @@
  * SCRFD exports differ across toolchains/opsets. For each head, this implementation infers:
  * - score layout: CHW / Flat / HW
  * - bbox layout:  CHW / Flat / HW4
- * and then decodes them with layout-aware accessors.
+ * and then decodes them with accessors specialized at compile time per layout combination (plus
+ * landmark layout and activation), picked once when the heads are resolved. Each score
+ * row is gated with one SIMD compare in raw (logit) space before any box is decoded, and the
+ * stride heads of a large input are decoded in parallel.
  *
  * Thread-safety contract:
  * - Unbound mode is safe for concurrent calls.
@@ -24,13 +27,18 @@
 
 #include "engine/scrfd.h"
 
-#include "internal/chw_preprocess.h"
+#include "algo/geometry.h"
+#include "algo/half.h"
+#include "algo/preprocess.h"
+#include "algo/probmap.h"
+#include "platform/thread_pool.h"
 
 #include <algorithm>
 #include <cmath>
 #include <exception>
 #include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace idet::engine {
@@ -55,6 +63,34 @@ static inline float clampf_(float v, float lo, float hi) noexcept {
     return std::max(lo, std::min(hi, v));
 }
 
+/**
+ * @brief Logit margin below logit(score threshold) used for gating.
+ *
+ * @details
+ * The gate only has to be conservative: survivors are activated and rechecked against the exact
+ * probability threshold. The slope of the sigmoid is at most 1/4, so a 1e-4 margin covers its
+ * float rounding many times over.
+ */
+constexpr float kGateLogitMargin_ = 1e-4f;
+
+/**
+ * @brief Gate for thresholds the sigmoid cannot separate from 1 (logit(1) = +inf).
+ *
+ * @details
+ * sigmoid(x) rounds to 1.0f only for x > ~16.6, so no logit below 15 can pass a threshold >= 1.
+ */
+constexpr float kGateLogitMax_ = 15.0f;
+
+/// @brief Score entries over all heads below which heads are decoded serially.
+constexpr std::size_t kMinParallelEntries_ = 16384;
+
+/// @brief SCRFD input normalization: (x - 127.5) / 128.
+constexpr float kMean_[3] = {127.5f, 127.5f, 127.5f};
+constexpr float kInvStd_[3] = {1.0f / 128.0f, 1.0f / 128.0f, 1.0f / 128.0f};
+
+/// @brief Letterbox padding: a black pixel (value 0) after normalization.
+constexpr float kPad_[3] = {-kMean_[0] * kInvStd_[0], -kMean_[1] * kInvStd_[1], -kMean_[2] * kInvStd_[2]};
+
 } // namespace
 
 /**
@@ -63,7 +99,7 @@ static inline float clampf_(float v, float lo, float hi) noexcept {
  * @details
  * Sequence:
  * 1) Validate @ref idet::DetectorConfig and enforce task/engine invariants.
- * 2) Create ORT session (model path or embedded blob) via @ref IEngine::create_session_.
+ * 2) Create ORT session (model path or embedded blob) via @ref IEngine::create_session_->
  * 3) Query input/output node names from ORT metadata.
  * 4) Cache hot inference parameters for fast-path decoding.
  *
@@ -82,6 +118,22 @@ SCRFD::SCRFD(const DetectorConfig& cfg) : IEngine(cfg, "idet-scrfd") {
 
     init_io_names_();
     cache_hot_();
+
+    const Status cs = open_capture_();
+    if (!cs.ok()) throw std::runtime_error(cs.message);
+}
+
+/**
+ * @brief Decode-only engine for capture replay: no session, outputs named like the recorded model.
+ *
+ * @throws std::runtime_error if @p cfg is not a Face configuration or @p out_names is empty.
+ */
+SCRFD::SCRFD(const DetectorConfig& cfg, DecodeOnly, std::vector<std::string> out_names)
+    : IEngine(cfg, "idet-scrfd-decode") {
+    if (cfg_.task != Task::Face) throw std::runtime_error("SCRFD: cfg.task must be Face");
+    if (out_names.empty()) throw std::runtime_error("SCRFD: decode-only engine needs output names");
+    out_names_ = std::move(out_names);
+    cache_hot_();
 }
 
 /**
@@ -97,7 +149,15 @@ SCRFD::SCRFD(const DetectorConfig& cfg) : IEngine(cfg, "idet-scrfd") {
 void SCRFD::cache_hot_() noexcept {
     apply_sigmoid_ = cfg_.infer.apply_sigmoid;
     score_thr_ = cfg_.infer.box_thresh;
+    if (apply_sigmoid_) {
+        const float lt = algo::logit_threshold(score_thr_);
+        gate_thr_ = std::isinf(lt) && lt > 0.f ? kGateLogitMax_ : lt - kGateLogitMargin_;
+    } else {
+        gate_thr_ = score_thr_;
+    }
+    post_threads_ = cfg_.runtime.post_omp_threads;
     max_img_ = cfg_.infer.max_img_size;
+    letterbox_unbound_ = cfg_.infer.letterbox;
     min_w_ = cfg_.infer.min_roi_size_w;
     min_h_ = cfg_.infer.min_roi_size_h;
 }
@@ -122,14 +182,14 @@ Status SCRFD::update_hot(const DetectorConfig& next) noexcept {
  * Names are used to bind tensors in bound mode via Ort::IoBinding.
  */
 void SCRFD::init_io_names_() {
-    Ort::AllocatedStringPtr in0 = session_.GetInputNameAllocated(0, alloc_);
+    Ort::AllocatedStringPtr in0 = session_->GetInputNameAllocated(0, alloc_);
     in_name_ = in0 ? in0.get() : std::string("input");
 
-    const std::size_t nout = session_.GetOutputCount();
+    const std::size_t nout = session_->GetOutputCount();
     out_names_.clear();
     out_names_.reserve(nout);
     for (std::size_t i = 0; i < nout; ++i) {
-        Ort::AllocatedStringPtr on = session_.GetOutputNameAllocated(i, alloc_);
+        Ort::AllocatedStringPtr on = session_->GetOutputNameAllocated(i, alloc_);
         out_names_.push_back(on ? on.get() : ("out_" + std::to_string(i)));
     }
 }
@@ -156,13 +216,13 @@ algo::Detection SCRFD::rect_to_det_(float x1, float y1, float x2, float y2, floa
  *
  * @param dst Destination buffer in CHW order (size = 3 * in_h * in_w).
  * @param in_w/in_h Target network input dimensions (already aligned if needed).
- * @param bgr Source image in BGR order (CV_8UC3).
+ * @param src Source image (BGR CV_8UC3, or 4:2:0 planes converted on the fly).
+ * @param ws Resize scratch; nullptr uses the thread-local workspace.
  */
-void SCRFD::fill_input_chw_(float* dst, int in_w, int in_h, const cv::Mat& bgr) const {
-    // SCRFD: (x - 127.5) / 128
-    const float mean[3] = {127.5f, 127.5f, 127.5f};
-    const float inv_std[3] = {1.0f / 128.0f, 1.0f / 128.0f, 1.0f / 128.0f};
-    internal::bgr_u8_to_chw_f32_resize(bgr, in_w, in_h, dst, mean, inv_std);
+void SCRFD::fill_input_chw_(float* dst, int in_w, int in_h, const algo::ChwSource& src,
+                            algo::ResizeChwWorkspace* ws) const {
+    IDET_STAGE_SCOPE(&stats_, Stage::Preprocess);
+    algo::resize_to_chw(src, in_w, in_h, dst, kMean_, kInvStd_, ws);
 }
 
 /**
@@ -177,22 +237,24 @@ void SCRFD::fill_input_chw_(float* dst, int in_w, int in_h, const cv::Mat& bgr)
  * Geometry:
  * - sx = in_w / orig_w, sy = in_h / orig_h are returned to map decoded boxes back
  *   to original image coordinates in @ref decode_.
+ * - With @ref letterbox_unbound_ (and no forced shape) the downscaled image keeps its size in the
+ *   top-left corner of the aligned input and sx = sy; @ref decode_ skips the padding.
  *
- * @param bgr Input image (BGR, CV_8UC3).
+ * @param src Input image (BGR CV_8UC3 or 4:2:0 planes).
  * @param force_w/force_h If both > 0, force a fixed input shape (still aligned to 32).
  * @param sx/sy Output scale factors (network / original).
  * @param in_w/in_h Output effective network input shape.
  * @return Vector of Ort::Value outputs in the same order as @ref out_names_.
  */
-Result<std::vector<Ort::Value>> SCRFD::run_unbound_(const cv::Mat& bgr, int force_w, int force_h, float& sx, float& sy,
-                                                    int& in_w, int& in_h) noexcept {
+Result<std::vector<Ort::Value>> SCRFD::run_unbound_(const algo::ChwSource& src, int force_w, int force_h, float& sx,
+                                                    float& sy, int& in_w, int& in_h) noexcept {
     try {
-        if (bgr.empty() || bgr.type() != CV_8UC3) {
-            return Result<std::vector<Ort::Value>>::Err(Status::Invalid("SCRFD: run_unbound expects CV_8UC3 BGR"));
+        if (src.empty()) {
+            return Result<std::vector<Ort::Value>>::Err(Status::Invalid("SCRFD: run_unbound expects an image"));
         }
 
-        const int ow = bgr.cols;
-        const int oh = bgr.rows;
+        const int ow = src.width();
+        const int oh = src.height();
 
         int tw = force_w;
         int th = force_h;
@@ -208,23 +270,52 @@ Result<std::vector<Ort::Value>> SCRFD::run_unbound_(const cv::Mat& bgr, int forc
                 }
             }
         }
+        const bool boxed = letterbox_unbound_ && (force_w <= 0 || force_h <= 0);
+        const int cw = tw;
+        const int ch = th;
         tw = align_up_(tw, 32);
         th = align_up_(th, 32);
 
         in_w = tw;
         in_h = th;
 
-        sx = (float)tw / (float)ow;
-        sy = (float)th / (float)oh;
-
         std::vector<float> chw((std::size_t)3 * (std::size_t)th * (std::size_t)tw);
-        fill_input_chw_(chw.data(), tw, th, bgr);
+        if (boxed && (cw != tw || ch != th)) {
+            IDET_STAGE_SCOPE(&stats_, Stage::Preprocess);
+            algo::ResizeChwWorkspace ws;
+            algo::resize_to_chw_canvas(src, cw, ch, chw.data(), tw, th, kMean_, kInvStd_, ws);
+            algo::fill_chw_padding(chw.data(), tw, th, cw, ch, kPad_);
+            sx = (float)cw / (float)ow;
+            sy = (float)ch / (float)oh;
+        } else {
+            fill_input_chw_(chw.data(), tw, th, src);
+            sx = (float)tw / (float)ow;
+            sy = (float)th / (float)oh;
+        }
 
-        static Ort::MemoryInfo cpu_mem = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-        const std::vector<int64_t> ishape = {1, 3, in_h, in_w};
+        return run_chw_unbound_(chw.data(), chw.size(), 1, in_h, in_w);
+    } catch (const std::bad_alloc&) {
+        return Result<std::vector<Ort::Value>>::Err(Status::OutOfMemory("SCRFD: run_unbound bad_alloc"));
+    } catch (const std::exception& e) {
+        return Result<std::vector<Ort::Value>>::Err(Status::Internal(std::string("SCRFD: run_unbound: ") + e.what()));
+    } catch (...) {
+        return Result<std::vector<Ort::Value>>::Err(Status::Internal("SCRFD: run_unbound: unknown"));
+    }
+}
+
+/**
+ * @brief Run the session on a prepared [batch,3,in_h,in_w] buffer and return all outputs.
+ *
+ * @details
+ * Used by @ref run_unbound_ (batch 1) after preprocessing into the thread-local CHW buffer.
+ */
+Result<std::vector<Ort::Value>> SCRFD::run_chw_unbound_(const float* chw, std::size_t count, int batch, int in_h,
+                                                        int in_w) noexcept {
+    try {
+        const std::vector<int64_t> ishape = {batch, 3, in_h, in_w};
 
-        Ort::Value in_tensor =
-            Ort::Value::CreateTensor<float>(cpu_mem, chw.data(), chw.size(), ishape.data(), ishape.size());
+        std::vector<std::uint16_t> in_f16;
+        Ort::Value in_tensor = input_tensor_(chw, count, ishape, in_f16);
 
         std::vector<const char*> out_names_c;
         out_names_c.reserve(out_names_.size());
@@ -233,16 +324,19 @@ Result<std::vector<Ort::Value>> SCRFD::run_unbound_(const cv::Mat& bgr, int forc
 
         const char* in_names[] = {in_name_.c_str()};
 
+        IDET_STAGE_SCOPE(&stats_, Stage::Run);
         auto outs =
-            session_.Run(Ort::RunOptions{nullptr}, in_names, &in_tensor, 1, out_names_c.data(), out_names_c.size());
+            session_->Run(run_opts_, in_names, &in_tensor, 1, out_names_c.data(), out_names_c.size());
+        count_run_();
 
         return Result<std::vector<Ort::Value>>::Ok(std::move(outs));
     } catch (const std::bad_alloc&) {
-        return Result<std::vector<Ort::Value>>::Err(Status::OutOfMemory("SCRFD: run_unbound bad_alloc"));
+        return Result<std::vector<Ort::Value>>::Err(Status::OutOfMemory("SCRFD: run_chw_unbound bad_alloc"));
     } catch (const std::exception& e) {
-        return Result<std::vector<Ort::Value>>::Err(Status::Internal(std::string("SCRFD: run_unbound: ") + e.what()));
+        return Result<std::vector<Ort::Value>>::Err(
+            Status::Internal(std::string("SCRFD: run_chw_unbound: ") + e.what()));
     } catch (...) {
-        return Result<std::vector<Ort::Value>>::Err(Status::Internal("SCRFD: run_unbound: unknown"));
+        return Result<std::vector<Ort::Value>>::Err(Status::Internal("SCRFD: run_chw_unbound: unknown"));
     }
 }
 
@@ -253,10 +347,13 @@ Result<std::vector<Ort::Value>> SCRFD::run_unbound_(const cv::Mat& bgr, int forc
  * The method runs a dummy inference at a fixed input shape and then:
  * - resolves output indices for each stride head (8/16/32) by matching output names
  *   against common substrings ("score"/"bbox"/"cls"/"conf"/"reg") and stride token,
- * - falls back to a conventional 6-output ordering if name matching fails,
+ * - falls back to a conventional 6-output (or 9-output, with landmarks) ordering if name matching fails,
+ * - optionally resolves the 5-point landmark output ("kps"/"landmark"/"lmk"); a head whose
+ *   landmark tensor is missing or inconsistent is kept without landmarks,
  * - reads tensor shapes from ORT and infers layouts:
  *   - score: CHW ([1,C,H,W]) / Flat ([1,N,C] or [1,N,1]) / HW ([H,W] or [1,H,W])
  *   - bbox : CHW ([1,4,H,W]) / Flat ([1,N,4]) / HW4 ([H,W,4] or [1,H,W,4])
+ *   - kps  : CHW ([1,10,H,W]) / Flat ([1,N,10]) / HW10 ([H,W,10] or [1,H,W,10])
  * - infers anchors for flat exports by checking N % (Hs*Ws) == 0.
  *
  * @param in_h/in_w Effective network input shape (already aligned).
@@ -265,16 +362,21 @@ Result<std::vector<Ort::Value>> SCRFD::run_unbound_(const cv::Mat& bgr, int forc
  * @retval Status::Unsupported if no consistent heads could be resolved.
  */
 Status SCRFD::probe_heads_layout_(int in_h, int in_w, std::vector<Head>* heads) noexcept {
-    try {
-        cv::Mat dummy(in_h, in_w, CV_8UC3, cv::Scalar(0, 0, 0));
-
-        float sx = 1.f, sy = 1.f;
-        int iw = 0, ih = 0;
-        auto r = run_unbound_(dummy, in_w, in_h, sx, sy, iw, ih);
-        if (!r.ok()) return r.status();
+    auto r = output_shapes_(1, in_h, in_w);
+    if (!r.ok()) return r.status();
+    return resolve_heads_(r.value(), in_h, in_w, heads);
+}
 
-        auto outs = std::move(r.value());
-        if (outs.size() != out_names_.size()) return Status::Internal("SCRFD: probe outputs count mismatch");
+/**
+ * @brief Infer per-head layouts from the output shapes of a batch-1 run (see @ref probe_heads_layout_).
+ *
+ * @details
+ * Pure shape logic: does not touch the session, so it can be fed with shapes of a regular
+ * inference as well as with declared, cached or probed shapes.
+ */
+Status SCRFD::resolve_heads_(const ShapeList& shapes, int in_h, int in_w, std::vector<Head>* heads) const noexcept {
+    try {
+        if (shapes.size() != out_names_.size()) return Status::Internal("SCRFD: probe outputs count mismatch");
 
         // Name-based best-effort matching: robust across exporters that keep semantic tokens.
         auto find_by = [&](const std::string& what, const std::string& stride) -> int {
@@ -333,6 +435,19 @@ Status SCRFD::probe_heads_layout_(int in_h, int in_w, std::vector<Head>* heads)
             }
         };
 
+        auto infer_kps_layout = [&](const std::vector<int64_t>& kshape, Head& h) {
+            // common: [1,10,H,W] or [1,N,10] or [1,H,W,10]
+            const int hw = std::max(1, h.Hs * h.Ws);
+            h.kps_layout = Layout::Unknown;
+            if (kshape.size() == 4 && kshape[1] == 10) {
+                if (h.anchors == 1 && kshape[2] == h.Hs && kshape[3] == h.Ws) h.kps_layout = Layout::Kps_CHW;
+            } else if (kshape.size() == 3 && kshape[2] == 10) {
+                if (kshape[1] == (int64_t)hw * h.anchors) h.kps_layout = Layout::Kps_Flat;
+            } else if (kshape.size() == 4 && kshape[3] == 10) {
+                if (h.anchors == 1 && kshape[1] == h.Hs && kshape[2] == h.Ws) h.kps_layout = Layout::Kps_HW10;
+            }
+        };
+
         auto add_head = [&](int stride) {
             Head h;
             h.stride = stride;
@@ -346,12 +461,18 @@ Status SCRFD::probe_heads_layout_(int in_h, int in_w, std::vector<Head>* heads)
             if (si < 0) si = find_by("conf", s);
             if (bi < 0) bi = find_by("reg", s);
 
+            int ki = find_by("kps", s);
+            if (ki < 0) ki = find_by("landmark", s);
+            if (ki < 0) ki = find_by("lmk", s);
+
             if (si < 0 || bi < 0) {
                 // Fallback for common exports with fixed output ordering:
-                // (score8, score16, score32, bbox8, bbox16, bbox32).
+                // (score8, score16, score32, bbox8, bbox16, bbox32[, kps8, kps16, kps32]).
                 if (out_names_.size() >= 6) {
-                    si = (stride == 8) ? 0 : (stride == 16 ? 1 : 2);
-                    bi = (stride == 8) ? 3 : (stride == 16 ? 4 : 5);
+                    const int k = (stride == 8) ? 0 : (stride == 16 ? 1 : 2);
+                    si = k;
+                    bi = 3 + k;
+                    if (ki < 0 && out_names_.size() >= 9) ki = 6 + k;
                 } else {
                     return;
                 }
@@ -360,8 +481,8 @@ Status SCRFD::probe_heads_layout_(int in_h, int in_w, std::vector<Head>* heads)
             h.score_idx = si;
             h.bbox_idx = bi;
 
-            h.score_shape = outs[(std::size_t)si].GetTensorTypeAndShapeInfo().GetShape();
-            h.bbox_shape = outs[(std::size_t)bi].GetTensorTypeAndShapeInfo().GetShape();
+            h.score_shape = shapes[(std::size_t)si];
+            h.bbox_shape = shapes[(std::size_t)bi];
 
             // base guess
             h.Hs = std::max(1, in_h / stride);
@@ -388,6 +509,19 @@ Status SCRFD::probe_heads_layout_(int in_h, int in_w, std::vector<Head>* heads)
                 return; // skip inconsistent head
             }
 
+            // landmarks are optional: keep the head even if they cannot be interpreted
+            if (ki >= 0 && ki != si && ki != bi) {
+                h.kps_shape = shapes[(std::size_t)ki];
+                infer_kps_layout(h.kps_shape, h);
+                if (h.kps_layout != Layout::Unknown) {
+                    h.kps_idx = ki;
+                } else {
+                    h.kps_shape.clear();
+                }
+            }
+
+            h.decode[0] = decoder_for_(h, false);
+            h.decode[1] = decoder_for_(h, true);
             hs.push_back(std::move(h));
         };
 
@@ -399,204 +533,449 @@ Status SCRFD::probe_heads_layout_(int in_h, int in_w, std::vector<Head>* heads)
         *heads = std::move(hs);
         return Status::Ok();
     } catch (const std::exception& e) {
-        return Status::Internal(std::string("SCRFD: probe_heads_layout: ") + e.what());
+        return Status::Internal(std::string("SCRFD: resolve_heads: ") + e.what());
     } catch (...) {
-        return Status::Internal("SCRFD: probe_heads_layout: unknown");
+        return Status::Internal("SCRFD: resolve_heads: unknown");
     }
 }
 
 /**
- * @brief Decode per-head SCRFD outputs into detections.
+ * @brief Decode one head with accessors specialized for its score (@p SL) and bbox (@p BL) layouts.
  *
  * @details
- * For each head (stride 8/16/32), iterate over all spatial locations and anchors:
- * - read score using the inferred score layout,
- * - optionally apply sigmoid,
- * - read bbox distances/coords using inferred bbox layout,
+ * Every score row (the locations of one map row that intersect the image content) is first
+ * gated with @ref idet::algo::select_ge against @ref gate_thr_, i.e. compared in the raw
+ * (possibly logit) space of the tensor. Only survivors are activated, rechecked against the
+ * probability threshold and decoded:
  * - convert (dl,dt,dr,db) and center point to (x1,y1,x2,y2),
  * - scale back to original image coordinates using (sx, sy),
- * - clamp to image bounds and apply min size filtering.
+ * - clamp to image bounds and apply min size filtering,
+ * - for kept boxes, decode the 5 landmarks (center + offset * stride) when the head has them.
  *
- * @note Channel selection:
- * This implementation uses a fixed channel choice for multi-channel score outputs
- * (currently: channel 1 if score_ch>1 else 0). If your exports differ (e.g. face class at ch=0),
- * this should be made configurable in the config/infer params.
+ * Detections are appended in (y, x, anchor) order.
  */
-std::vector<algo::Detection> SCRFD::decode_(const std::vector<Head>& heads, const std::vector<const float*>& score_ptrs,
-                                            const std::vector<const float*>& bbox_ptrs, float sx, float sy, int orig_w,
-                                            int orig_h) const {
-    std::vector<algo::Detection> dets;
-    dets.reserve(256);
+template <SCRFD::Layout SL, SCRFD::Layout BL, SCRFD::Layout KL, bool kSigmoid>
+void SCRFD::decode_head_(const Head& h, const float* score, const float* bbox, const float* kps, float sx, float sy,
+                         int orig_w, int orig_h, std::vector<algo::Detection>& dets) const {
+    const int Hs = std::max(1, h.Hs);
+    const int Ws = std::max(1, h.Ws);
+    const int A = std::max(1, h.anchors);
+    const int stride = h.stride;
+    const std::size_t hw = (std::size_t)Hs * (std::size_t)Ws;
+
+    // Rows/cols whose cells intersect the image content.
+    const int ys = (stride > 0) ? std::min(Hs, (int)std::ceil((float)orig_h * sy / (float)stride)) : Hs;
+    const int xs = (stride > 0) ? std::min(Ws, (int)std::ceil((float)orig_w * sx / (float)stride)) : Ws;
+
+    // production default: take channel 0 (или "face" во втором канале — это лучше параметризовать)
+    const int ch = (h.score_ch > 1) ? 1 : 0;
+
+    // Score_CHW / Score_HW hold one score per location (shared by its anchors), Score_Flat one per anchor.
+    constexpr bool kPerAnchor = (SL == Layout::Score_Flat);
+    const int row_n = kPerAnchor ? xs * A : xs;
+    const int row_step = kPerAnchor ? h.score_ch : 1;
+
+    auto emit = [&](int y, int x, int a, float raw) {
+        const float sc = kSigmoid ? sigmoid_(raw) : raw;
+        if (sc < score_thr_) return;
+
+        const std::size_t idx = (std::size_t)y * (std::size_t)Ws + (std::size_t)x;
+        const std::size_t loc = idx * (std::size_t)A + (std::size_t)a;
+        float dl, dt, dr, db;
+        if constexpr (BL == Layout::BBox_CHW) {
+            dl = bbox[0 * hw + idx];
+            dt = bbox[1 * hw + idx];
+            dr = bbox[2 * hw + idx];
+            db = bbox[3 * hw + idx];
+        } else if constexpr (BL == Layout::BBox_Flat) {
+            dl = bbox[loc * 4 + 0];
+            dt = bbox[loc * 4 + 1];
+            dr = bbox[loc * 4 + 2];
+            db = bbox[loc * 4 + 3];
+        } else {
+            // BBox_HW4: [H,W,4] contiguous
+            dl = bbox[idx * 4 + 0];
+            dt = bbox[idx * 4 + 1];
+            dr = bbox[idx * 4 + 2];
+            db = bbox[idx * 4 + 3];
+        }
 
-    for (std::size_t hi = 0; hi < heads.size(); ++hi) {
-        const auto& h = heads[hi];
-        const float* score = score_ptrs[hi];
-        const float* bbox = bbox_ptrs[hi];
-        if (!score || !bbox) continue;
-
-        const int Hs = std::max(1, h.Hs);
-        const int Ws = std::max(1, h.Ws);
-        const int A = std::max(1, h.anchors);
-        const int stride = h.stride;
-        const int hw = Hs * Ws;
-
-        auto score_at = [&](int y, int x, int a) -> float {
-            // production default: take channel 0 (или "face" во втором канале — это лучше параметризовать)
-            const int ch = (h.score_ch > 1) ? 1 : 0;
-
-            if (h.score_layout == Layout::Score_CHW) {
-                return score[ch * hw + (y * Ws + x)];
+        const float cx = (x + 0.5f) * stride;
+        const float cy = (y + 0.5f) * stride;
+
+        const float x1 = clampf_((cx - dl * stride) / sx, 0.f, (float)orig_w);
+        const float y1 = clampf_((cy - dt * stride) / sy, 0.f, (float)orig_h);
+        const float x2 = clampf_((cx + dr * stride) / sx, 0.f, (float)orig_w);
+        const float y2 = clampf_((cy + db * stride) / sy, 0.f, (float)orig_h);
+
+        if (x2 <= x1 || y2 <= y1) return;
+        if (min_w_ > 0 && (x2 - x1) < (float)min_w_) return;
+        if (min_h_ > 0 && (y2 - y1) < (float)min_h_) return;
+
+        dets.push_back(rect_to_det_(x1, y1, x2, y2, sc));
+        if constexpr (KL != Layout::Unknown) {
+            if (!kps) return;
+
+            // Landmark offsets (x0,y0,...,x4,y4) in input pixels, relative to the location center.
+            // Kps_Flat ([N,10], N = H*W*A) and Kps_HW10 ([H,W,10], A == 1) share the per-location stride.
+            auto& d = dets.back();
+            for (int j = 0; j < 5; ++j) {
+                const std::size_t kx = (std::size_t)(2 * j), ky = kx + 1;
+                const float ox = (KL == Layout::Kps_CHW) ? kps[kx * hw + idx] : kps[loc * 10 + kx];
+                const float oy = (KL == Layout::Kps_CHW) ? kps[ky * hw + idx] : kps[loc * 10 + ky];
+                d.kps[(std::size_t)j].x = clampf_((cx + ox * stride) / sx, 0.f, (float)orig_w);
+                d.kps[(std::size_t)j].y = clampf_((cy + oy * stride) / sy, 0.f, (float)orig_h);
             }
-            if (h.score_layout == Layout::Score_Flat) {
-                const int loc = (y * Ws + x) * A + a;
-                return score[loc * h.score_ch + ch];
+            d.has_kps = true;
+        } else {
+            (void)kps;
+        }
+    };
+
+    int sel[kGateChunk_];
+    for (int y = 0; y < ys; ++y) {
+        const std::size_t row0 = (std::size_t)y * (std::size_t)Ws;
+        const float* row = nullptr;
+        if constexpr (SL == Layout::Score_CHW)
+            row = score + (std::size_t)ch * hw + row0;
+        else if constexpr (SL == Layout::Score_Flat)
+            row = score + row0 * (std::size_t)A * (std::size_t)h.score_ch + (std::size_t)ch;
+        else
+            row = score + row0; // Score_HW
+
+        auto emit_at = [&](int i, float raw) {
+            if constexpr (kPerAnchor) {
+                emit(y, i / A, i % A, raw);
+            } else {
+                for (int a = 0; a < A; ++a)
+                    emit(y, i, a, raw);
             }
-            // Score_HW
-            return score[y * Ws + x];
         };
 
-        auto bbox_at = [&](int y, int x, int a, float& dl, float& dt, float& dr, float& db) {
-            if (h.bbox_layout == Layout::BBox_CHW) {
-                const int idx = (y * Ws + x);
-                dl = bbox[0 * hw + idx] * stride;
-                dt = bbox[1 * hw + idx] * stride;
-                dr = bbox[2 * hw + idx] * stride;
-                db = bbox[3 * hw + idx] * stride;
-                return;
+        if (row_step != 1) {
+            // Interleaved multi-class flat scores: no contiguous row to gate.
+            for (int i = 0; i < row_n; ++i) {
+                const float v = row[(std::size_t)i * (std::size_t)row_step];
+                if (v >= gate_thr_) emit_at(i, v);
             }
-            if (h.bbox_layout == Layout::BBox_Flat) {
-                const int loc = (y * Ws + x) * A + a;
-                dl = bbox[loc * 4 + 0] * stride;
-                dt = bbox[loc * 4 + 1] * stride;
-                dr = bbox[loc * 4 + 2] * stride;
-                db = bbox[loc * 4 + 3] * stride;
-                return;
-            }
-            // BBox_HW4: [H,W,4] contiguous
-            const int idx = (y * Ws + x) * 4;
-            dl = bbox[idx + 0] * stride;
-            dt = bbox[idx + 1] * stride;
-            dr = bbox[idx + 2] * stride;
-            db = bbox[idx + 3] * stride;
-        };
-
-        for (int y = 0; y < Hs; ++y) {
-            for (int x = 0; x < Ws; ++x) {
-                for (int a = 0; a < A; ++a) {
-                    float sc = score_at(y, x, a);
-                    if (apply_sigmoid_) sc = sigmoid_(sc);
-                    if (sc < score_thr_) continue;
+            continue;
+        }
 
-                    float dl = 0, dt = 0, dr = 0, db = 0;
-                    bbox_at(y, x, a, dl, dt, dr, db);
+        for (int c0 = 0; c0 < row_n; c0 += kGateChunk_) {
+            const int cn = std::min(kGateChunk_, row_n - c0);
+            const int k = algo::select_ge(row + c0, cn, gate_thr_, sel);
+            for (int j = 0; j < k; ++j)
+                emit_at(c0 + sel[j], row[c0 + sel[j]]);
+        }
+    }
+}
 
-                    const float cx = (x + 0.5f) * stride;
-                    const float cy = (y + 0.5f) * stride;
+/**
+ * @brief Pick the @ref decode_head_ instance of the layouts of @p h.
+ *
+ * @details
+ * Unknown score/bbox layouts never reach decoding (@ref resolve_heads_ drops such heads); they map
+ * to the plain [H,W] / [H,W,4] accessors. Kps_HW10 shares the Kps_Flat accessor (same stride).
+ */
+SCRFD::HeadDecodeFn SCRFD::decoder_for_(const Head& h, bool sigmoid) noexcept {
+    auto pick = [&](auto sl, auto bl, auto kl) -> HeadDecodeFn {
+        constexpr Layout SL = decltype(sl)::value, BL = decltype(bl)::value, KL = decltype(kl)::value;
+        return sigmoid ? &SCRFD::decode_head_<SL, BL, KL, true> : &SCRFD::decode_head_<SL, BL, KL, false>;
+    };
+    auto with_kps = [&](auto sl, auto bl) {
+        switch (h.kps_layout) {
+        case Layout::Kps_CHW:
+            return pick(sl, bl, std::integral_constant<Layout, Layout::Kps_CHW>{});
+        case Layout::Kps_Flat:
+        case Layout::Kps_HW10:
+            return pick(sl, bl, std::integral_constant<Layout, Layout::Kps_Flat>{});
+        default:
+            return pick(sl, bl, std::integral_constant<Layout, Layout::Unknown>{});
+        }
+    };
+    auto with_bbox = [&](auto sl) {
+        switch (h.bbox_layout) {
+        case Layout::BBox_CHW:
+            return with_kps(sl, std::integral_constant<Layout, Layout::BBox_CHW>{});
+        case Layout::BBox_Flat:
+            return with_kps(sl, std::integral_constant<Layout, Layout::BBox_Flat>{});
+        default:
+            return with_kps(sl, std::integral_constant<Layout, Layout::BBox_HW4>{});
+        }
+    };
+    switch (h.score_layout) {
+    case Layout::Score_CHW:
+        return with_bbox(std::integral_constant<Layout, Layout::Score_CHW>{});
+    case Layout::Score_Flat:
+        return with_bbox(std::integral_constant<Layout, Layout::Score_Flat>{});
+    default:
+        return with_bbox(std::integral_constant<Layout, Layout::Score_HW>{});
+    }
+}
 
-                    float x1 = (cx - dl) / sx;
-                    float y1 = (cy - dt) / sy;
-                    float x2 = (cx + dr) / sx;
-                    float y2 = (cy + db) / sy;
+/**
+ * @brief Decode per-head SCRFD outputs into detections.
+ *
+ * @details
+ * Every head (stride 8/16/32) is decoded by its resolved @ref decode_head_ instance. Heads are independent, so
+ * with enough score entries they run on @ref post_threads_ pool threads (at most one
+ * thread per head), unless the call already runs inside a parallel region or on a thread that
+ * decodes serially (@ref IEngine::serial_postprocess). Per-head results are concatenated in
+ * head order, so the output matches the serial loop exactly.
+ *
+ * Locations beyond the mapped image (`orig * s` input pixels, i.e. letterbox padding) are skipped;
+ * for a stretched input this is the whole map.
+ *
+ * @note Channel selection:
+ * This implementation uses a fixed channel choice for multi-channel score outputs
+ * (currently: channel 1 if score_ch>1 else 0). If your exports differ (e.g. face class at ch=0),
+ * this should be made configurable in the config/infer params.
+ */
+void SCRFD::decode_(const std::vector<Head>& heads, const std::vector<const float*>& score_ptrs,
+                    const std::vector<const float*>& bbox_ptrs, const std::vector<const float*>& kps_ptrs, float sx,
+                    float sy, int orig_w, int orig_h, std::vector<algo::Detection>& dets) const {
+    IDET_STAGE_SCOPE(&stats_, Stage::Decode);
+    dets.clear();
+    dets.reserve(256);
+    if (capture_) record_(heads, score_ptrs, bbox_ptrs, kps_ptrs, sx, sy, orig_w, orig_h);
+
+    const int nh = (int)heads.size();
+    auto decode_one = [&](int hi, std::vector<algo::Detection>& out) {
+        const auto& h = heads[(std::size_t)hi];
+        const float* score = score_ptrs[(std::size_t)hi];
+        const float* bbox = bbox_ptrs[(std::size_t)hi];
+        const bool has_kps = (std::size_t)hi < kps_ptrs.size() && h.kps_layout != Layout::Unknown;
+        const float* kps = has_kps ? kps_ptrs[(std::size_t)hi] : nullptr;
+        const HeadDecodeFn fn = h.decode[apply_sigmoid_ ? 1 : 0];
+        if (!score || !bbox || !fn) return;
+        (this->*fn)(h, score, bbox, kps, sx, sy, orig_w, orig_h, out);
+    };
+
+    int threads = 1;
+    if (nh > 1 && !platform::ThreadPool::in_parallel() && !serial_postprocess()) {
+        std::size_t entries = 0;
+        for (const auto& h : heads)
+            entries += (std::size_t)std::max(1, h.Hs * h.Ws) * (std::size_t)std::max(1, h.anchors);
+        if (entries >= kMinParallelEntries_) {
+            threads = (post_threads_ > 0) ? post_threads_ : platform::ThreadPool::hardware_width();
+            threads = std::max(1, std::min(threads, nh));
+        }
+    }
 
-                    x1 = clampf_(x1, 0.f, (float)orig_w);
-                    y1 = clampf_(y1, 0.f, (float)orig_h);
-                    x2 = clampf_(x2, 0.f, (float)orig_w);
-                    y2 = clampf_(y2, 0.f, (float)orig_h);
+    if (threads <= 1) {
+        for (int hi = 0; hi < nh; ++hi)
+            decode_one(hi, dets);
+    } else {
+        std::vector<std::vector<algo::Detection>> parts((std::size_t)nh);
 
-                    if (x2 <= x1 || y2 <= y1) continue;
-                    if (min_w_ > 0 && (x2 - x1) < (float)min_w_) continue;
-                    if (min_h_ > 0 && (y2 - y1) < (float)min_h_) continue;
+        // The first exception is rethrown by parallel_for once all helpers returned.
+        platform::ThreadPool::current().parallel_for(nh, threads,
+                                                    [&](int hi, int) { decode_one(hi, parts[(std::size_t)hi]); });
 
-                    dets.push_back(rect_to_det_(x1, y1, x2, y2, sc));
-                }
-            }
-        }
+        for (const auto& part : parts)
+            dets.insert(dets.end(), part.begin(), part.end());
     }
 
     std::sort(dets.begin(), dets.end(), [](const auto& a, const auto& b) { return a.score > b.score; });
-    return dets;
 }
 
 /**
- * @brief Prepare bound inference: preallocate per-context I/O and bind outputs by name.
+ * @brief Prepare bound inference for a single shape; frames are stretched (or letterboxed) to it.
  *
  * @details
  * - Input shape is aligned to 32 and fixed for all subsequent bound calls.
- * - Heads and output indices are probed once and then frozen in @ref heads_ and @ref bound_out_indices_.
- * - Each context allocates:
- *   - input CHW buffer,
- *   - output buffers for [score,bbox,...] in @ref bound_out_indices_ order,
- *   - Ort::Value tensors wrapping these buffers,
+ * - Heads and output indices are resolved once per bucket and then frozen (see @ref setup_buckets_).
+ */
+Status SCRFD::setup_binding(int w, int h, int contexts, int batch) noexcept {
+    unset_binding();
+    if (w <= 0 || h <= 0) return Status::Invalid("SCRFD::setup_binding: non-positive w/h");
+
+    const Status s = setup_buckets_({{align_up_(w, 32), align_up_(h, 32)}}, contexts, batch, cfg_.infer.letterbox);
+    if (s.ok()) {
+        bound_w_ = w;
+        bound_h_ = h;
+    }
+    return s;
+}
+
+/**
+ * @brief Prepare one letterboxed bucket per distinct (aligned) shape, see @ref IEngine::setup_binding_pool.
+ */
+Status SCRFD::setup_binding_pool(const std::vector<std::pair<int, int>>& shapes, int contexts, int batch) noexcept {
+    unset_binding();
+    try {
+        std::vector<std::pair<int, int>> aligned;
+        aligned.reserve(shapes.size());
+        for (const auto& sh : shapes) {
+            if (sh.first <= 0 || sh.second <= 0) return Status::Invalid("SCRFD::setup_binding_pool: non-positive w/h");
+            const auto a = std::make_pair(align_up_(sh.first, 32), align_up_(sh.second, 32));
+            if (std::find(aligned.begin(), aligned.end(), a) == aligned.end()) aligned.push_back(a);
+        }
+        if (aligned.empty()) return Status::Invalid("SCRFD::setup_binding_pool: no shapes");
+        return setup_buckets_(aligned, contexts, batch, /*letterbox=*/true);
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("SCRFD::setup_binding_pool: bad_alloc");
+    }
+}
+
+/**
+ * @brief Shared body of @ref setup_binding / @ref setup_binding_pool over already aligned shapes.
+ *
+ * @details
+ * For every bucket:
+ * - heads are resolved for its input shape and frozen in @c Bucket::heads / @c Bucket::out_indices,
+ * - each context allocates:
+ *   - input NCHW buffer with @p batch slots,
+ *   - output buffers for [score,bbox(,kps)] per head in @c Bucket::out_indices order (@p batch slots each),
+ *   - Ort::Value tensors wrapping slot 0 (single-image binding) and, for @p batch > 1, all slots,
  *   - Ort::IoBinding bindings for fast Session::Run.
  *
+ * Batching:
+ * For @p batch > 1 the batch-N output shapes are resolved (declared, cached or probed) as well.
+ * Every bound output must grow linearly with the batch (N * slice); exports without a batch
+ * dimension are rejected.
+ *
  * Concurrency:
  * Each context must be used by at most one concurrent caller.
  */
-Status SCRFD::setup_binding(int w, int h, int contexts) noexcept {
+Status SCRFD::setup_buckets_(const std::vector<std::pair<int, int>>& shapes, int contexts, int batch,
+                             bool letterbox) noexcept {
     try {
-        unset_binding();
-
-        if (w <= 0 || h <= 0) return Status::Invalid("SCRFD::setup_binding: non-positive w/h");
         if (contexts <= 0) contexts = 1;
+        if (batch <= 0) batch = 1;
 
-        bound_w_ = w;
-        bound_h_ = h;
         contexts_ = contexts;
+        batch_ = batch;
+        letterbox_ = letterbox;
+
+        buckets_.resize(shapes.size());
+        for (std::size_t bi = 0; bi < shapes.size(); ++bi) {
+            Bucket& bk = buckets_[bi];
+            bk.in_w = shapes[bi].first;
+            bk.in_h = shapes[bi].second;
+            const int in_w = bk.in_w;
+            const int in_h = bk.in_h;
+
+            Status ps = probe_heads_layout_(in_h, in_w, &bk.heads);
+            if (!ps.ok()) {
+                unset_binding();
+                return ps;
+            }
 
-        const int in_w = align_up_(w, 32);
-        const int in_h = align_up_(h, 32);
-
-        std::vector<Head> heads;
-        Status ps = probe_heads_layout_(in_h, in_w, &heads);
-        if (!ps.ok()) return ps;
-
-        heads_ = std::move(heads);
-
-        bound_out_indices_.clear();
-        bound_out_indices_.reserve(heads_.size() * 2);
-        for (auto& hd : heads_) {
-            bound_out_indices_.push_back(hd.score_idx);
-            bound_out_indices_.push_back(hd.bbox_idx);
-        }
-
-        static Ort::MemoryInfo cpu_mem = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+            bk.out_indices.reserve(bk.heads.size() * 3);
+            bk.out_shapes.reserve(bk.heads.size() * 3);
+            auto bind_out = [&](int out_idx, const std::vector<int64_t>& shape) -> int {
+                bk.out_indices.push_back(out_idx);
+                bk.out_shapes.push_back(shape);
+                return (int)bk.out_indices.size() - 1;
+            };
+            for (auto& hd : bk.heads) {
+                hd.bound_score = bind_out(hd.score_idx, hd.score_shape);
+                hd.bound_bbox = bind_out(hd.bbox_idx, hd.bbox_shape);
+                hd.bound_kps = (hd.kps_idx >= 0) ? bind_out(hd.kps_idx, hd.kps_shape) : -1;
+            }
 
-        ctxs_.resize((std::size_t)contexts_);
-        for (int ci = 0; ci < contexts_; ++ci) {
-            auto& c = ctxs_[(std::size_t)ci];
+            bk.in_slice = (std::size_t)3 * (std::size_t)in_h * (std::size_t)in_w;
+            bk.out_slices.assign(bk.out_indices.size(), 0);
+            for (std::size_t oi = 0; oi < bk.out_indices.size(); ++oi)
+                bk.out_slices[oi] = idet::internal::safe_numel(bk.out_shapes[oi]);
+
+            // Batched output shapes (real ORT shapes for [batch,3,H,W]).
+            std::vector<std::vector<int64_t>> batch_shapes;
+            if (batch_ > 1) {
+                auto pr = output_shapes_(batch_, in_h, in_w);
+                if (!pr.ok()) {
+                    unset_binding();
+                    return Status::Unsupported(std::string("SCRFD::setup_binding: model rejects batch > 1: ") +
+                                               pr.status().message);
+                }
 
-            c.binding = std::make_unique<Ort::IoBinding>(session_);
+                auto& outs = pr.value();
+                batch_shapes.reserve(bk.out_indices.size());
+                for (std::size_t oi = 0; oi < bk.out_indices.size(); ++oi) {
+                    auto sh = outs[(std::size_t)bk.out_indices[oi]];
+                    if (idet::internal::safe_numel(sh) != (std::size_t)batch_ * bk.out_slices[oi]) {
+                        unset_binding();
+                        return Status::Unsupported("SCRFD::setup_binding: outputs do not scale with batch dimension");
+                    }
+                    batch_shapes.push_back(std::move(sh));
+                }
+            }
 
-            c.in.assign((std::size_t)3 * (std::size_t)in_h * (std::size_t)in_w, 0.f);
-            std::vector<int64_t> ishape = {1, 3, in_h, in_w};
-            c.in_tensor =
-                Ort::Value::CreateTensor<float>(cpu_mem, c.in.data(), c.in.size(), ishape.data(), ishape.size());
-            c.binding->BindInput(in_name_.c_str(), c.in_tensor);
+            const std::vector<int64_t> ishape = {1, 3, in_h, in_w};
+            const std::vector<int64_t> bshape = {batch_, 3, in_h, in_w};
 
-            c.outs.clear();
-            c.out_tensors.clear();
-            c.outs.resize(bound_out_indices_.size());
-            c.out_tensors.reserve(bound_out_indices_.size());
+            // Contexts are independent: allocate, first-touch and bind them in parallel.
+            bk.ctxs.resize((std::size_t)contexts_);
+            const int width = std::min(contexts_, platform::ThreadPool::hardware_width());
+            platform::ThreadPool::current().parallel_for(contexts_, width, [&](int ci, int) {
+                auto& c = bk.ctxs[(std::size_t)ci];
 
-            for (std::size_t oi = 0; oi < bound_out_indices_.size(); ++oi) {
-                const bool is_score = (oi % 2 == 0);
-                const Head& hd = heads_[(std::size_t)(oi / 2)];
-                const int out_idx = bound_out_indices_[oi];
+                c.binding = std::make_unique<Ort::IoBinding>(*session_);
 
-                const auto& shape = is_score ? hd.score_shape : hd.bbox_shape;
+                bound_assign_(c.in, (std::size_t)batch_ * bk.in_slice);
+                if (letterbox_) {
+                    // Every slot starts as padding; frames then only write their content.
+                    for (int k = 0; k < batch_; ++k)
+                        algo::fill_chw_padding(c.in.data() + (std::size_t)k * bk.in_slice, bk.in_w, bk.in_h, 0, 0,
+                                               kPad_);
+                }
+                bound_assign_(c.in_f16, half_input_() ? c.in.size() : 0);
+                std::uint16_t* in16 = c.in_f16.empty() ? nullptr : c.in_f16.data();
+                c.pad_w.assign((std::size_t)batch_, 0);
+                c.pad_h.assign((std::size_t)batch_, 0);
+                c.in_tensor = tensor_view_(c.in.data(), in16, bk.in_slice, ishape);
+                c.binding->BindInput(in_name_.c_str(), c.in_tensor);
+
+                if (batch_ > 1) {
+                    c.batch_binding = std::make_unique<Ort::IoBinding>(*session_);
+                    c.batch_in_tensor = tensor_view_(c.in.data(), in16, c.in.size(), bshape);
+                    c.batch_binding->BindInput(in_name_.c_str(), c.batch_in_tensor);
+                }
 
-                std::size_t numel = 1;
-                for (auto v : shape)
-                    numel *= (std::size_t)std::max<int64_t>(1, v);
+                c.slots.resize((std::size_t)batch_);
+                for (auto& sl : c.slots) {
+                    sl.score_ptrs.assign(bk.heads.size(), nullptr);
+                    sl.bbox_ptrs.assign(bk.heads.size(), nullptr);
+                    sl.kps_ptrs.assign(bk.heads.size(), nullptr);
+                }
 
-                c.outs[oi].assign(numel, 0.f);
-                c.out_tensors.emplace_back(Ort::Value::CreateTensor<float>(
-                    cpu_mem, c.outs[oi].data(), c.outs[oi].size(), shape.data(), shape.size()));
+                c.outs.clear();
+                c.outs_f16.clear();
+                c.out_tensors.clear();
+                c.batch_out_tensors.clear();
+                c.outs.resize(bk.out_indices.size());
+                c.outs_f16.resize(bk.out_indices.size());
+                c.out_tensors.reserve(bk.out_indices.size());
+                c.batch_out_tensors.reserve(batch_shapes.size());
+
+                for (std::size_t oi = 0; oi < bk.out_indices.size(); ++oi) {
+                    const int out_idx = bk.out_indices[oi];
+                    const char* out_name = out_names_[(std::size_t)out_idx].c_str();
+
+                    const auto& shape = bk.out_shapes[oi];
+                    const std::size_t slice = bk.out_slices[oi];
+
+                    bound_assign_(c.outs[oi], (std::size_t)batch_ * slice);
+                    bound_assign_(c.outs_f16[oi], half_output_((std::size_t)out_idx) ? c.outs[oi].size() : 0);
+                    std::uint16_t* out16 = c.outs_f16[oi].empty() ? nullptr : c.outs_f16[oi].data();
+                    c.out_tensors.emplace_back(tensor_view_(c.outs[oi].data(), out16, slice, shape));
+                    c.binding->BindOutput(out_name, c.out_tensors.back());
+
+                    if (batch_ > 1) {
+                        c.batch_out_tensors.emplace_back(
+                            tensor_view_(c.outs[oi].data(), out16, c.outs[oi].size(), batch_shapes[oi]));
+                        c.batch_binding->BindOutput(out_name, c.batch_out_tensors.back());
+                    }
+                }
+            });
 
-                c.binding->BindOutput(out_names_[(std::size_t)out_idx].c_str(), c.out_tensors.back());
-            }
+            bucket_shapes_.emplace_back(in_w, in_h);
+            bound_w_ = std::max(bound_w_, in_w);
+            bound_h_ = std::max(bound_h_, in_h);
         }
 
+        staged_.assign((std::size_t)contexts_, Placement{});
         binding_ready_ = true;
         return Status::Ok();
     } catch (const std::bad_alloc&) {
@@ -615,27 +994,152 @@ void SCRFD::unset_binding() noexcept {
     binding_ready_ = false;
     bound_w_ = bound_h_ = 0;
     contexts_ = 0;
-    ctxs_.clear();
+    batch_ = 0;
+    letterbox_ = false;
+    bucket_shapes_.clear();
+    buckets_.clear();
+    staged_.clear();
+    heads_ready_.store(false, std::memory_order_relaxed);
     heads_.clear();
-    bound_out_indices_.clear();
 }
 
 /**
  * @brief Unbound inference: run ORT and decode to detections.
  *
  * @details
- * Probes heads lazily on first call if @ref heads_ is empty (export-dependent).
+ * Resolves heads lazily on first call if @ref heads_ is empty (export-dependent), from the output
+ * shapes of that call itself. Concurrent first calls resolve under @ref heads_mu_; the first one
+ * publishes, the others reuse its result.
  */
 Result<std::vector<algo::Detection>> SCRFD::infer_unbound(const cv::Mat& bgr) noexcept {
+    if (bgr.empty() || bgr.type() != CV_8UC3) {
+        return Result<std::vector<algo::Detection>>::Err(Status::Invalid("SCRFD::infer_unbound: expected CV_8UC3 BGR"));
+    }
+    return infer_unbound_(algo::ChwSource::of(bgr));
+}
+
+/**
+ * @brief Records the decoded head outputs in session output order.
+ *
+ * @details
+ * Every used output is written once (a tensor may be shared by heads of some exports) with its
+ * batch-1 shape. Inputs are aligned to 32, so the input size follows from the largest head map.
+ */
+void SCRFD::record_(const std::vector<Head>& heads, const std::vector<const float*>& score_ptrs,
+                    const std::vector<const float*>& bbox_ptrs, const std::vector<const float*>& kps_ptrs, float sx,
+                    float sy, int orig_w, int orig_h) const {
+    struct Used {
+        int idx;
+        const std::vector<int64_t>* shape;
+        const float* data;
+    };
+    std::vector<Used> used;
+    auto add = [&](int idx, const std::vector<int64_t>& shape, const float* data) {
+        if (idx < 0 || !data) return;
+        for (const Used& u : used)
+            if (u.idx == idx) return;
+        used.push_back({idx, &shape, data});
+    };
+
+    CaptureFrame g;
+    g.orig_w = orig_w;
+    g.orig_h = orig_h;
+    g.sx = sx;
+    g.sy = sy;
+    for (std::size_t hi = 0; hi < heads.size(); ++hi) {
+        const Head& h = heads[hi];
+        add(h.score_idx, h.score_shape, score_ptrs[hi]);
+        add(h.bbox_idx, h.bbox_shape, bbox_ptrs[hi]);
+        if (hi < kps_ptrs.size() && h.kps_layout != Layout::Unknown) add(h.kps_idx, h.kps_shape, kps_ptrs[hi]);
+        g.in_w = std::max(g.in_w, h.Ws * h.stride);
+        g.in_h = std::max(g.in_h, h.Hs * h.stride);
+    }
+    if (used.empty()) return;
+    std::sort(used.begin(), used.end(), [](const Used& a, const Used& b) { return a.idx < b.idx; });
+
+    std::vector<CaptureView> views;
+    views.reserve(used.size());
+    for (const Used& u : used)
+        views.push_back({out_names_[(std::size_t)u.idx].c_str(), u.shape->data(), u.shape->size(), u.data});
+    capture_->append(g, views.data(), views.size());
+}
+
+/**
+ * @brief Decodes a recorded frame; its heads are resolved once per distinct output shape set.
+ *
+ * @details
+ * The frame must hold every output of this engine under its name (as recorded by an engine on the
+ * same model with landmarks resolved). Tensors are matched by name, so the recorded order does not
+ * matter.
+ */
+Status SCRFD::decode_capture(const CaptureFrame& f, std::vector<algo::Detection>& out) noexcept {
+    out.clear();
     try {
-        if (bgr.empty() || bgr.type() != CV_8UC3) {
-            return Result<std::vector<algo::Detection>>::Err(
-                Status::Invalid("SCRFD::infer_unbound: expected CV_8UC3 BGR"));
+        std::vector<const CaptureTensor*> by_out(out_names_.size(), nullptr);
+        for (const CaptureTensor& t : f.tensors) {
+            const auto it = std::find(out_names_.begin(), out_names_.end(), t.name);
+            if (it == out_names_.end()) return Status::DecodeError("SCRFD: capture tensor '" + t.name + "' unknown");
+            by_out[(std::size_t)(it - out_names_.begin())] = &t;
+        }
+
+        // Outputs the recording engine did not use (e.g. unresolvable landmarks) keep an empty shape.
+        ShapeList shapes(out_names_.size());
+        for (std::size_t i = 0; i < by_out.size(); ++i)
+            if (by_out[i]) shapes[i] = by_out[i]->shape;
+
+        const std::vector<Head>* heads = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(heads_mu_);
+            auto it = capture_heads_.find(shapes);
+            if (it == capture_heads_.end()) {
+                std::vector<Head> hs;
+                const Status ps = resolve_heads_(shapes, f.in_h, f.in_w, &hs);
+                if (!ps.ok()) return Status::DecodeError("SCRFD: capture frame: " + ps.message);
+                it = capture_heads_.emplace(shapes, std::move(hs)).first;
+            }
+            heads = &it->second;
         }
 
+        const std::size_t nh = heads->size();
+        std::vector<const float*> score_ptrs(nh, nullptr), bbox_ptrs(nh, nullptr), kps_ptrs(nh, nullptr);
+        auto data = [&](int idx) -> const float* {
+            const CaptureTensor* t = idx >= 0 ? by_out[(std::size_t)idx] : nullptr;
+            return t ? t->data.data() : nullptr;
+        };
+        for (std::size_t hi = 0; hi < nh; ++hi) {
+            const Head& hd = (*heads)[hi];
+            score_ptrs[hi] = data(hd.score_idx);
+            bbox_ptrs[hi] = data(hd.bbox_idx);
+            kps_ptrs[hi] = data(hd.kps_idx);
+        }
+
+        decode_(*heads, score_ptrs, bbox_ptrs, kps_ptrs, f.sx, f.sy, f.orig_w, f.orig_h, out);
+        return Status::Ok();
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("SCRFD::decode_capture: bad_alloc");
+    } catch (const std::exception& e) {
+        return Status::Internal(std::string("SCRFD::decode_capture: ") + e.what());
+    }
+}
+
+/// @brief Runs packed and 4:2:0 sources through the fused kernel, bound when @p ctx_idx >= 0.
+Status SCRFD::infer_source_into(const algo::ChwSource& src, int ctx_idx, std::vector<algo::Detection>& out) noexcept {
+    out.clear();
+    if (!src.valid()) return Status::Invalid("SCRFD::infer_source_into: unsupported or empty source");
+    if (ctx_idx >= 0) return infer_bound_into_(src, ctx_idx, out);
+
+    auto r = infer_unbound_(src);
+    if (!r.ok()) return r.status();
+    out = std::move(r.value());
+    return Status::Ok();
+}
+
+/// @brief Unbound inference body shared by the BGR and direct-source entry points.
+Result<std::vector<algo::Detection>> SCRFD::infer_unbound_(const algo::ChwSource& src) noexcept {
+    try {
         float sx = 1.f, sy = 1.f;
         int in_w = 0, in_h = 0;
-        auto rr = run_unbound_(bgr, 0, 0, sx, sy, in_w, in_h);
+        auto rr = run_unbound_(src, 0, 0, sx, sy, in_w, in_h);
         if (!rr.ok()) return Result<std::vector<algo::Detection>>::Err(rr.status());
 
         auto outs = std::move(rr.value());
@@ -643,25 +1147,42 @@ Result<std::vector<algo::Detection>> SCRFD::infer_unbound(const cv::Mat& bgr) no
             return Result<std::vector<algo::Detection>>::Err(Status::Internal("SCRFD: outputs count mismatch"));
         }
 
-        if (heads_.empty()) {
-            std::vector<Head> hs;
-            Status ps = probe_heads_layout_(in_h, in_w, &hs);
-            if (!ps.ok()) return Result<std::vector<algo::Detection>>::Err(ps);
-            heads_ = std::move(hs);
+        if (!heads_ready_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lk(heads_mu_);
+            if (!heads_ready_.load(std::memory_order_relaxed)) {
+                // The outputs of this very run describe the layout; no separate probe inference.
+                ShapeList shapes;
+                shapes.reserve(outs.size());
+                for (auto& o : outs)
+                    shapes.push_back(o.GetTensorTypeAndShapeInfo().GetShape());
+
+                std::vector<Head> hs;
+                Status ps = resolve_heads_(shapes, in_h, in_w, &hs);
+                if (!ps.ok()) return Result<std::vector<algo::Detection>>::Err(ps);
+                heads_ = std::move(hs);
+                heads_ready_.store(true, std::memory_order_release);
+            }
         }
 
         std::vector<const float*> score_ptrs(heads_.size(), nullptr);
         std::vector<const float*> bbox_ptrs(heads_.size(), nullptr);
+        std::vector<const float*> kps_ptrs(heads_.size(), nullptr);
+
+        // float32 views of the outputs (float16 outputs are converted into `f32`)
+        std::vector<std::vector<float>> f32(outs.size());
+        auto data = [&](int idx) { return tensor_f32_(outs[(std::size_t)idx], f32[(std::size_t)idx]); };
 
         for (std::size_t hi = 0; hi < heads_.size(); ++hi) {
             const Head& hd = heads_[hi];
             if (hd.score_idx < 0 || hd.bbox_idx < 0) continue;
 
-            score_ptrs[hi] = outs[(std::size_t)hd.score_idx].GetTensorData<float>();
-            bbox_ptrs[hi] = outs[(std::size_t)hd.bbox_idx].GetTensorData<float>();
+            score_ptrs[hi] = data(hd.score_idx);
+            bbox_ptrs[hi] = data(hd.bbox_idx);
+            if (hd.kps_idx >= 0) kps_ptrs[hi] = data(hd.kps_idx);
         }
 
-        auto dets = decode_(heads_, score_ptrs, bbox_ptrs, sx, sy, bgr.cols, bgr.rows);
+        std::vector<algo::Detection> dets;
+        decode_(heads_, score_ptrs, bbox_ptrs, kps_ptrs, sx, sy, src.width(), src.height(), dets);
         return Result<std::vector<algo::Detection>>::Ok(std::move(dets));
     } catch (const std::bad_alloc&) {
         return Result<std::vector<algo::Detection>>::Err(Status::OutOfMemory("SCRFD::infer_unbound: bad_alloc"));
@@ -673,57 +1194,323 @@ Result<std::vector<algo::Detection>> SCRFD::infer_unbound(const cv::Mat& bgr) no
     }
 }
 
+/**
+ * @brief Route a frame to its bucket and compute its content size and input/original scales.
+ *
+ * @details
+ * Letterboxed buckets get an aspect-preserving content size (@ref idet::algo::letterbox_fit);
+ * otherwise the frame is stretched over the whole input.
+ */
+SCRFD::Placement SCRFD::place_(int orig_w, int orig_h) const noexcept {
+    Placement p;
+    p.bucket = std::max(0, pick_bucket_(orig_w, orig_h));
+    const Bucket& bk = buckets_[(std::size_t)p.bucket];
+    p.orig_w = orig_w;
+    p.orig_h = orig_h;
+    if (letterbox_) {
+        const algo::LetterboxFit f = algo::letterbox_fit(orig_w, orig_h, bk.in_w, bk.in_h, max_img_);
+        p.content_w = f.w;
+        p.content_h = f.h;
+    } else {
+        p.content_w = bk.in_w;
+        p.content_h = bk.in_h;
+    }
+    p.sx = (float)p.content_w / (float)orig_w;
+    p.sy = (float)p.content_h / (float)orig_h;
+    return p;
+}
+
+/**
+ * @brief Preprocess @p bgr into batch slot @p slot of context @p c according to @p p.
+ *
+ * @details
+ * Letterboxed slots are filled with padding at setup; it is re-written only when a frame is smaller
+ * than the previous one of the slot in either dimension.
+ */
+void SCRFD::fill_bound_(const Bucket& bk, BoundCtx& c, int slot, const algo::ChwSource& src,
+                        const Placement& p) const {
+    float* dst = c.in.data() + (std::size_t)slot * bk.in_slice;
+    algo::ResizeChwWorkspace& prep = c.slots[(std::size_t)slot].prep;
+    if (!letterbox_) {
+        fill_input_chw_(dst, bk.in_w, bk.in_h, src, &prep);
+        return;
+    }
+
+    IDET_STAGE_SCOPE(&stats_, Stage::Preprocess);
+    algo::resize_to_chw_canvas(src, p.content_w, p.content_h, dst, bk.in_w, bk.in_h, kMean_, kInvStd_, prep);
+
+    const std::size_t k = (std::size_t)slot;
+    if (p.content_w < c.pad_w[k] || p.content_h < c.pad_h[k])
+        algo::fill_chw_padding(dst, bk.in_w, bk.in_h, p.content_w, p.content_h, kPad_);
+    c.pad_w[k] = p.content_w;
+    c.pad_h[k] = p.content_h;
+}
+
 /**
  * @brief Bound inference: uses preallocated per-context buffers and IoBinding.
  *
  * @pre @ref binding_ready() is true and ctx_idx is valid.
- * @note The implementation assumes the bound input shape is (align_up(bound_w_,32), align_up(bound_h_,32)).
  */
 Result<std::vector<algo::Detection>> SCRFD::infer_bound(const cv::Mat& bgr, int ctx_idx) noexcept {
+    std::vector<algo::Detection> out;
+    const Status s = infer_bound_into(bgr, ctx_idx, out);
+    if (!s.ok()) return Result<std::vector<algo::Detection>>::Err(s);
+    return Result<std::vector<algo::Detection>>::Ok(std::move(out));
+}
+
+void SCRFD::run_bound_(const Bucket& bk, BoundCtx& c, int count) {
+    IDET_STAGE_SCOPE(&stats_, Stage::Run);
+    const std::size_t n = (std::size_t)count;
+    if (!c.in_f16.empty()) algo::f32_to_f16(c.in.data(), c.in_f16.data(), n * bk.in_slice);
+
+    if (count == 1 || !c.batch_binding) {
+        session_->Run(run_opts_, *c.binding);
+    } else {
+        session_->Run(run_opts_, *c.batch_binding);
+    }
+    count_run_();
+
+    for (std::size_t oi = 0; oi < c.outs_f16.size(); ++oi) {
+        if (!c.outs_f16[oi].empty())
+            algo::f16_to_f32(c.outs_f16[oi].data(), c.outs[oi].data(), n * bk.out_slices[oi]);
+    }
+}
+
+/// @brief Same as @ref SCRFD::infer_bound, decoding into @p out with the context's pointer tables.
+Status SCRFD::infer_bound_into(const cv::Mat& bgr, int ctx_idx, std::vector<algo::Detection>& out) noexcept {
+    if (bgr.empty() || bgr.type() != CV_8UC3) {
+        out.clear();
+        return Status::Invalid("SCRFD::infer_bound: expected CV_8UC3 BGR");
+    }
+    return infer_bound_into_(algo::ChwSource::of(bgr), ctx_idx, out);
+}
+
+/// @brief Bound inference body shared by the BGR and direct-source entry points.
+Status SCRFD::infer_bound_into_(const algo::ChwSource& src, int ctx_idx, std::vector<algo::Detection>& out) noexcept {
     try {
-        if (!binding_ready_)
-            return Result<std::vector<algo::Detection>>::Err(Status::Invalid("SCRFD::infer_bound: binding not ready"));
-        if (ctx_idx < 0 || ctx_idx >= contexts_)
-            return Result<std::vector<algo::Detection>>::Err(
-                Status::Invalid("SCRFD::infer_bound: ctx_idx out of range"));
-        if (bgr.empty() || bgr.type() != CV_8UC3)
-            return Result<std::vector<algo::Detection>>::Err(
-                Status::Invalid("SCRFD::infer_bound: expected CV_8UC3 BGR"));
+        out.clear();
+        if (!binding_ready_) return Status::Invalid("SCRFD::infer_bound: binding not ready");
+        if (ctx_idx < 0 || ctx_idx >= contexts_) return Status::Invalid("SCRFD::infer_bound: ctx_idx out of range");
 
-        auto& c = ctxs_[(std::size_t)ctx_idx];
+        const Placement p = place_(src.width(), src.height());
+        const Bucket& bk = buckets_[(std::size_t)p.bucket];
+        auto& c = buckets_[(std::size_t)p.bucket].ctxs[(std::size_t)ctx_idx];
 
-        const int in_w = align_up_(bound_w_, 32);
-        const int in_h = align_up_(bound_h_, 32);
+        fill_bound_(bk, c, 0, src, p);
+        run_bound_(bk, c, 1);
 
-        const float sx = (float)in_w / (float)bgr.cols;
-        const float sy = (float)in_h / (float)bgr.rows;
+        decode_bound_slot_(bk, c, 0, p, out);
+        return Status::Ok();
+    } catch (const std::bad_alloc&) {
+        out.clear();
+        return Status::OutOfMemory("SCRFD::infer_bound: bad_alloc");
+    } catch (const std::exception& e) {
+        out.clear();
+        return Status::Internal(std::string("SCRFD::infer_bound: ") + e.what());
+    } catch (...) {
+        out.clear();
+        return Status::Internal("SCRFD::infer_bound: unknown");
+    }
+}
+
+/**
+ * @brief Batched bound inference on BGR frames (see @ref SCRFD::infer_sources_batch).
+ */
+Result<std::vector<std::vector<algo::Detection>>> SCRFD::infer_bound_batch(const cv::Mat* bgr, int count,
+                                                                           int ctx_idx) noexcept {
+    using R = Result<std::vector<std::vector<algo::Detection>>>;
+    try {
+        if (!bgr || count <= 0) return R::Err(Status::Invalid("SCRFD::infer_bound_batch: empty batch"));
+        if (count > batch_) return R::Err(Status::Invalid("SCRFD::infer_bound_batch: count exceeds bound batch"));
+
+        std::vector<algo::ChwSource> src((std::size_t)count);
+        for (int i = 0; i < count; ++i) {
+            if (bgr[i].empty() || bgr[i].type() != CV_8UC3)
+                return R::Err(Status::Invalid("SCRFD::infer_bound_batch: expected CV_8UC3 BGR"));
+            src[(std::size_t)i] = algo::ChwSource::of(bgr[i]);
+        }
+        return infer_sources_batch(src.data(), count, ctx_idx);
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("SCRFD::infer_bound_batch: bad_alloc"));
+    }
+}
+
+/**
+ * @brief Batched bound inference: fill N input slots, run once, decode each slot.
+ *
+ * @details
+ * A single-image call uses the batch-1 binding so it does not pay for unused slots. With a
+ * binding pool, the sources are grouped by the bucket they route to and each group runs as one
+ * batch (in the order the buckets first appear).
+ *
+ * Slots own their scratch (@ref SlotScratch), so filling and decoding spread over up to
+ * @ref post_threads_ threads of the library pool unless the call already runs inside a
+ * parallel region; the heads of a slot are then decoded serially.
+ */
+Result<std::vector<std::vector<algo::Detection>>> SCRFD::infer_sources_batch(const algo::ChwSource* src, int count,
+                                                                             int ctx_idx) noexcept {
+    using R = Result<std::vector<std::vector<algo::Detection>>>;
+    try {
+        if (!binding_ready_) return R::Err(Status::Invalid("SCRFD::infer_sources_batch: binding not ready"));
+        if (ctx_idx < 0 || ctx_idx >= contexts_)
+            return R::Err(Status::Invalid("SCRFD::infer_sources_batch: ctx_idx out of range"));
+        if (!src || count <= 0) return R::Err(Status::Invalid("SCRFD::infer_sources_batch: empty batch"));
+        if (count > batch_) return R::Err(Status::Invalid("SCRFD::infer_sources_batch: count exceeds bound batch"));
+
+        std::vector<Placement> places((std::size_t)count);
+        for (int i = 0; i < count; ++i) {
+            if (!src[i].valid())
+                return R::Err(Status::Invalid("SCRFD::infer_sources_batch: unsupported or empty source"));
+            places[(std::size_t)i] = place_(src[i].width(), src[i].height());
+        }
 
-        const float mean[3] = {127.5f, 127.5f, 127.5f};
-        const float inv_std[3] = {1.0f / 128.0f, 1.0f / 128.0f, 1.0f / 128.0f};
-        internal::bgr_u8_to_chw_f32_resize(bgr, in_w, in_h, c.in.data(), mean, inv_std);
+        int threads = 1;
+        if (!platform::ThreadPool::in_parallel() && !serial_postprocess()) {
+            threads = (post_threads_ > 0) ? post_threads_ : platform::ThreadPool::hardware_width();
+            threads = std::max(1, std::min(threads, count));
+        }
+        platform::ThreadPool& pool = platform::ThreadPool::current();
+
+        std::vector<std::vector<algo::Detection>> out((std::size_t)count);
+        std::vector<char> done((std::size_t)count, 0);
+        std::vector<int> group;
+        group.reserve((std::size_t)count);
+        for (int first = 0; first < count; ++first) {
+            if (done[(std::size_t)first]) continue;
+            const int b = places[(std::size_t)first].bucket;
+            group.clear();
+            for (int i = first; i < count; ++i) {
+                if (!done[(std::size_t)i] && places[(std::size_t)i].bucket == b) {
+                    group.push_back(i);
+                    done[(std::size_t)i] = 1;
+                }
+            }
 
-        session_.Run(Ort::RunOptions{nullptr}, *c.binding);
+            const Bucket& bk = buckets_[(std::size_t)b];
+            auto& c = buckets_[(std::size_t)b].ctxs[(std::size_t)ctx_idx];
+            const int n = (int)group.size();
+            const int t = std::min(threads, n);
 
-        std::vector<const float*> score_ptrs(heads_.size(), nullptr);
-        std::vector<const float*> bbox_ptrs(heads_.size(), nullptr);
+            pool.parallel_for(n, t, [&](int j, int) {
+                const int i = group[(std::size_t)j];
+                fill_bound_(bk, c, j, src[i], places[(std::size_t)i]);
+            });
 
-        for (std::size_t hi = 0; hi < heads_.size(); ++hi) {
-            const std::size_t score_i = hi * 2 + 0;
-            const std::size_t bbox_i = hi * 2 + 1;
-            score_ptrs[hi] = (score_i < c.outs.size()) ? c.outs[score_i].data() : nullptr;
-            bbox_ptrs[hi] = (bbox_i < c.outs.size()) ? c.outs[bbox_i].data() : nullptr;
+            run_bound_(bk, c, n);
+
+            pool.parallel_for(n, t, [&](int j, int) {
+                const std::size_t i = (std::size_t)group[(std::size_t)j];
+                decode_bound_slot_(bk, c, j, places[i], out[i]);
+            });
         }
+        return R::Ok(std::move(out));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("SCRFD::infer_sources_batch: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("SCRFD::infer_sources_batch: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("SCRFD::infer_sources_batch: unknown"));
+    }
+}
 
-        auto dets = decode_(heads_, score_ptrs, bbox_ptrs, sx, sy, bgr.cols, bgr.rows);
-        return Result<std::vector<algo::Detection>>::Ok(std::move(dets));
+/**
+ * @brief Staged bound inference, stage 1: validate, preprocess into the context input buffer.
+ *
+ * @details
+ * Stores the frame placement (bucket, geometry) per context so that @ref SCRFD::stage_run and
+ * @ref SCRFD::stage_output can run later, possibly on another thread, without the source image.
+ */
+Status SCRFD::stage_input(const cv::Mat& bgr, int ctx_idx) noexcept {
+    try {
+        if (!binding_ready_) return Status::Invalid("SCRFD::stage_input: binding not ready");
+        if (ctx_idx < 0 || ctx_idx >= contexts_) return Status::Invalid("SCRFD::stage_input: ctx_idx out of range");
+        if (bgr.empty() || bgr.type() != CV_8UC3) return Status::Invalid("SCRFD::stage_input: expected CV_8UC3 BGR");
+
+        const Placement p = place_(bgr.cols, bgr.rows);
+        const Bucket& bk = buckets_[(std::size_t)p.bucket];
+        fill_bound_(bk, buckets_[(std::size_t)p.bucket].ctxs[(std::size_t)ctx_idx], 0, algo::ChwSource::of(bgr), p);
+        staged_[(std::size_t)ctx_idx] = p;
+        return Status::Ok();
     } catch (const std::bad_alloc&) {
-        return Result<std::vector<algo::Detection>>::Err(Status::OutOfMemory("SCRFD::infer_bound: bad_alloc"));
+        return Status::OutOfMemory("SCRFD::stage_input: bad_alloc");
     } catch (const std::exception& e) {
-        return Result<std::vector<algo::Detection>>::Err(
-            Status::Internal(std::string("SCRFD::infer_bound: ") + e.what()));
+        return Status::Internal(std::string("SCRFD::stage_input: ") + e.what());
     } catch (...) {
-        return Result<std::vector<algo::Detection>>::Err(Status::Internal("SCRFD::infer_bound: unknown"));
+        return Status::Internal("SCRFD::stage_input: unknown");
     }
 }
 
+/// @brief Staged bound inference, stage 2: run the batch-1 binding of the staged bucket.
+Status SCRFD::stage_run(int ctx_idx) noexcept {
+    try {
+        if (!binding_ready_) return Status::Invalid("SCRFD::stage_run: binding not ready");
+        if (ctx_idx < 0 || ctx_idx >= contexts_) return Status::Invalid("SCRFD::stage_run: ctx_idx out of range");
+
+        const Placement& p = staged_[(std::size_t)ctx_idx];
+        Bucket& bk = buckets_[(std::size_t)p.bucket];
+        run_bound_(bk, bk.ctxs[(std::size_t)ctx_idx], 1);
+        return Status::Ok();
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("SCRFD::stage_run: bad_alloc");
+    } catch (const std::exception& e) {
+        return Status::Internal(std::string("SCRFD::stage_run: ") + e.what());
+    } catch (...) {
+        return Status::Internal("SCRFD::stage_run: unknown");
+    }
+}
+
+/// @brief Staged bound inference, stage 3: decode slot 0 of the staged bucket outputs.
+Result<std::vector<algo::Detection>> SCRFD::stage_output(int ctx_idx) noexcept {
+    using R = Result<std::vector<algo::Detection>>;
+    try {
+        if (!binding_ready_) return R::Err(Status::Invalid("SCRFD::stage_output: binding not ready"));
+        if (ctx_idx < 0 || ctx_idx >= contexts_)
+            return R::Err(Status::Invalid("SCRFD::stage_output: ctx_idx out of range"));
+
+        const Placement& p = staged_[(std::size_t)ctx_idx];
+        const Bucket& bk = buckets_[(std::size_t)p.bucket];
+        std::vector<algo::Detection> dets;
+        decode_bound_slot_(bk, buckets_[(std::size_t)p.bucket].ctxs[(std::size_t)ctx_idx], 0, p, dets);
+        return R::Ok(std::move(dets));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("SCRFD::stage_output: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("SCRFD::stage_output: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("SCRFD::stage_output: unknown"));
+    }
+}
+
+/**
+ * @brief Decode one batch slot of bound outputs.
+ *
+ * @details
+ * Outputs are batch-major: slot @p slot of output @c oi starts at `slot * Bucket::out_slices[oi]`
+ * and has the per-image layout recorded in @c Bucket::heads.
+ */
+void SCRFD::decode_bound_slot_(const Bucket& bk, BoundCtx& c, int slot, const Placement& p,
+                               std::vector<algo::Detection>& out) const {
+    SlotScratch& ss = c.slots[(std::size_t)slot];
+    auto& score_ptrs = ss.score_ptrs;
+    auto& bbox_ptrs = ss.bbox_ptrs;
+    auto& kps_ptrs = ss.kps_ptrs;
+    score_ptrs.assign(bk.heads.size(), nullptr); // sized in setup_binding, so no reallocation
+    bbox_ptrs.assign(bk.heads.size(), nullptr);
+    kps_ptrs.assign(bk.heads.size(), nullptr);
+
+    auto slot_ptr = [&](int oi) -> const float* {
+        if (oi < 0 || (std::size_t)oi >= c.outs.size()) return nullptr;
+        return c.outs[(std::size_t)oi].data() + (std::size_t)slot * bk.out_slices[(std::size_t)oi];
+    };
+
+    for (std::size_t hi = 0; hi < bk.heads.size(); ++hi) {
+        const Head& hd = bk.heads[hi];
+        score_ptrs[hi] = slot_ptr(hd.bound_score);
+        bbox_ptrs[hi] = slot_ptr(hd.bound_bbox);
+        kps_ptrs[hi] = slot_ptr(hd.bound_kps);
+    }
+
+    decode_(bk.heads, score_ptrs, bbox_ptrs, kps_ptrs, p.sx, p.sy, p.orig_w, p.orig_h, out);
+}
+
 } // namespace idet::engine
@@ -15,10 +15,12 @@
  * conversion pipeline and opset:
  * - score tensors:  rank-2/3/4 (flat or spatial maps)
  * - bbox tensors:   rank-3/4 or HW4-like
+ * - kps tensors:    optional 5-point landmarks, rank-3/4 (10 values per location)
  *
  * This implementation **infers layout per head** independently for:
- * - classification/score output, and
- * - bbox regression output.
+ * - classification/score output,
+ * - bbox regression output, and
+ * - landmark regression output (when the export provides it).
  *
  * The decoder then consumes score/bbox pointers in a layout-aware way to produce
  * @ref idet::algo::Detection results in original image coordinates.
@@ -28,18 +30,22 @@
  * - @ref infer_bound is thread-safe **only** if each concurrent caller uses a unique @p ctx_idx.
  *
  * @note
- * Input tensors are expected to be float32 in CHW layout ([1,3,H,W]) with engine-defined
- * normalization consistent with the training recipe.
+ * Input tensors are expected to be float32 in NCHW layout ([N,3,H,W]; N > 1 only for batched
+ * binding) with engine-defined normalization consistent with the training recipe.
  */
 
 #pragma once
 
+#include "algo/preprocess.h"
 #include "engine/engine.h"
 #include "internal/ort_tensor.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -55,10 +61,9 @@ namespace idet::engine {
  * - a score/classification tensor (face confidence),
  * - a bbox regression tensor (x1,y1,x2,y2 or equivalent parameterization, export-dependent).
  *
- * The implementation keeps a cached list of heads (@ref heads_) where each head stores
- * probed output indices and inferred layouts/shapes. This probing is performed during
- * binding setup (fixed shape) and may also be performed lazily for unbound inference
- * depending on the model export characteristics.
+ * The implementation keeps cached lists of heads where each head stores probed output indices
+ * and inferred layouts/shapes. Bound buckets resolve their own heads during binding setup;
+ * unbound inference resolves @ref heads_ lazily from its first run (once, also under concurrent calls).
  *
  * Hot-update contract:
  * @ref update_hot accepts only changes that do not require recreating ORT session or rebinding.
@@ -68,6 +73,8 @@ namespace idet::engine {
  * - @ref setup_binding creates @p contexts independent binding contexts.
  * - Each context owns its input buffer, output buffers, and an Ort::IoBinding object.
  * - The caller must ensure exclusive use of each context during @ref infer_bound.
+ * - @ref setup_binding_pool keeps one such set of contexts per input shape; frames are letterboxed
+ *   into the best bucket and anchors over the padding are never decoded.
  */
 class SCRFD final : public IEngine {
   public:
@@ -83,6 +90,14 @@ class SCRFD final : public IEngine {
      */
     explicit SCRFD(const DetectorConfig& cfg);
 
+    /**
+     * @brief Decode-only engine without a session: only @ref decode_capture may be used.
+     *
+     * @param cfg Configuration with @c task == Face (the engine kind is not checked).
+     * @param out_names Output names of the recorded model, in session order.
+     */
+    SCRFD(const DetectorConfig& cfg, DecodeOnly, std::vector<std::string> out_names);
+
     /** @brief Engine kind identifier. */
     EngineKind kind() const noexcept override {
         return EngineKind::SCRFD;
@@ -115,12 +130,20 @@ class SCRFD final : public IEngine {
      * - allocate input and output buffers for each context,
      * - create per-context Ort::IoBinding and bind inputs/outputs.
      *
+     * With @p batch > 1 each context additionally binds `[batch,3,H,W]` input and batch-scaled
+     * outputs; the model must accept a dynamic batch dimension.
+     *
      * @param w Target input width (pixels), must be > 0.
      * @param h Target input height (pixels), must be > 0.
      * @param contexts Number of independent contexts to prepare (>= 1).
+     * @param batch Maximum images per bound run (>= 1).
      * @return Status::Ok() on success; error status otherwise.
      */
-    Status setup_binding(int w, int h, int contexts) noexcept override;
+    Status setup_binding(int w, int h, int contexts, int batch) noexcept override;
+
+    /** @brief Prepare one letterboxed bucket per input shape (see @ref IEngine::setup_binding_pool). */
+    Status setup_binding_pool(const std::vector<std::pair<int, int>>& shapes, int contexts,
+                              int batch) noexcept override;
 
     /**
      * @brief Release bound inference resources and return to unbound mode.
@@ -148,6 +171,75 @@ class SCRFD final : public IEngine {
      */
     Result<std::vector<algo::Detection>> infer_bound(const cv::Mat& bgr, int ctx_idx) noexcept override;
 
+    /**
+     * @brief Bound inference into a reusable vector (no per-frame allocations once warm).
+     *
+     * @param bgr Input BGR image (CV_8UC3).
+     * @param ctx_idx Context index in [0, bound_contexts()).
+     * @param out Destination detections (cleared first).
+     * @return Status::Ok() or error status.
+     */
+    Status infer_bound_into(const cv::Mat& bgr, int ctx_idx, std::vector<algo::Detection>& out) noexcept override;
+
+    /**
+     * @brief Unbound (@p ctx_idx < 0) or bound inference reading @p src directly in the fused kernel.
+     *
+     * @param src Packed RGB/RGBA/BGRA/BGR image or 4:2:0 planes (see @ref idet::algo::ChwSource::valid).
+     * @param ctx_idx Context index in [0, bound_contexts()), or -1 for unbound mode.
+     * @param out Destination detections (cleared first).
+     * @return Status::Ok() or error status.
+     */
+    Status infer_source_into(const algo::ChwSource& src, int ctx_idx,
+                             std::vector<algo::Detection>& out) noexcept override;
+
+    /**
+     * @brief Run bound inference for up to @ref bound_batch() images with one session run.
+     *
+     * @param bgr Pointer to @p count input images (CV_8UC3).
+     * @param count Number of images in [1, bound_batch()].
+     * @param ctx_idx Index of binding context in [0, bound_contexts()).
+     * @return Per-image detections in original image coordinates or an error status.
+     */
+    Result<std::vector<std::vector<algo::Detection>>> infer_bound_batch(const cv::Mat* bgr, int count,
+                                                                        int ctx_idx) noexcept override;
+
+    /**
+     * @brief Same as @ref infer_bound_batch for direct sources (packed or 4:2:0, e.g. crops of one frame).
+     *
+     * @param src Pointer to @p count valid sources (see @ref idet::algo::ChwSource::valid).
+     * @param count Number of sources in [1, bound_batch()].
+     * @param ctx_idx Index of binding context in [0, bound_contexts()).
+     * @return Per-source detections in source coordinates or an error status.
+     */
+    Result<std::vector<std::vector<algo::Detection>>> infer_sources_batch(const algo::ChwSource* src, int count,
+                                                                          int ctx_idx) noexcept override;
+
+    /** @brief Staged bound inference is supported (see @ref IEngine::supports_stages). */
+    bool supports_stages() const noexcept override {
+        return true;
+    }
+
+    /** @brief Preprocess @p bgr into context @p ctx_idx and remember its geometry. */
+    Status stage_input(const cv::Mat& bgr, int ctx_idx) noexcept override;
+
+    /** @brief Run the session on context @p ctx_idx (batch-1 binding). */
+    Status stage_run(int ctx_idx) noexcept override;
+
+    /** @brief Decode context @p ctx_idx outputs using the geometry stored by @ref stage_input. */
+    Result<std::vector<algo::Detection>> stage_output(int ctx_idx) noexcept override;
+
+    /**
+     * @brief Decodes recorded head outputs exactly like live ones.
+     *
+     * @details
+     * Heads are resolved once per distinct set of output shapes and kept for later frames.
+     *
+     * @param f Capture frame holding the head tensors named like this engine's outputs.
+     * @param out Destination detections (cleared first).
+     * @return DecodeError if the tensors do not match the outputs or no head can be resolved.
+     */
+    Status decode_capture(const CaptureFrame& f, std::vector<algo::Detection>& out) noexcept;
+
   private:
     /**
      * @brief Internal classification/bbox output layout tags for SCRFD exports.
@@ -175,32 +267,73 @@ class SCRFD final : public IEngine {
         BBox_Flat,
 
         /** @brief Per-pixel boxes: [H,W,4] or [1,H,W,4]. */
-        BBox_HW4
+        BBox_HW4,
+
+        /** @brief Landmark map in channels-first layout: [1,10,H,W]. */
+        Kps_CHW,
+
+        /** @brief Flat landmarks: [1,N,10]. */
+        Kps_Flat,
+
+        /** @brief Per-pixel landmarks: [H,W,10] or [1,H,W,10]. */
+        Kps_HW10
     };
 
     /**
      * @brief Per-stride head metadata with inferred tensor interpretation.
      *
      * @details
-     * Stores the ONNX output indices for the head's score and bbox tensors,
-     * along with inferred shapes and decoder-relevant parameters (H/W/anchors/channels).
+     * Stores the ONNX output indices for the head's score and bbox tensors (and the optional
+     * 5-point landmark tensor), along with inferred shapes and decoder-relevant parameters
+     * (H/W/anchors/channels).
+     *
+     * @c bound_* fields are positions in @c Bucket::out_indices (and thus in @c BoundCtx::outs),
+     * or -1 when the output is not bound.
      */
+    struct Head;
+
+    /** @brief Decoder of one head (an instance of @ref decode_head_). */
+    using HeadDecodeFn = void (SCRFD::*)(const Head& h, const float* score, const float* bbox, const float* kps,
+                                         float sx, float sy, int orig_w, int orig_h,
+                                         std::vector<algo::Detection>& dets) const;
+
     struct Head {
         int stride = 0;
 
         int score_idx = -1;
         int bbox_idx = -1;
+        int kps_idx = -1;
 
         std::vector<int64_t> score_shape;
         std::vector<int64_t> bbox_shape;
+        std::vector<int64_t> kps_shape;
 
         Layout score_layout = Layout::Unknown;
         Layout bbox_layout = Layout::Unknown;
+        Layout kps_layout = Layout::Unknown;
+
+        int bound_score = -1;
+        int bound_bbox = -1;
+        int bound_kps = -1;
 
         int Hs = 0;
         int Ws = 0;
         int anchors = 1;
         int score_ch = 1;
+
+        /// Decoders specialized for the layouts above, without / with sigmoid (see @ref decoder_for_).
+        HeadDecodeFn decode[2] = {nullptr, nullptr};
+    };
+
+    /**
+     * @brief Preprocessing and decoding scratch of one batch slot.
+     *
+     * @details
+     * Kept per slot so that the slots of a batched run can be filled and decoded concurrently.
+     */
+    struct SlotScratch {
+        algo::ResizeChwWorkspace prep;                             ///< Resize tables/row cache for input preprocessing
+        std::vector<const float*> score_ptrs, bbox_ptrs, kps_ptrs; ///< Per-head decode inputs (reused per frame)
     };
 
     /**
@@ -214,12 +347,45 @@ class SCRFD final : public IEngine {
      * - Ort::IoBinding instance used for fast-path inference.
      */
     struct BoundCtx {
-        std::vector<float> in;                ///< CHW input buffer
-        std::vector<std::vector<float>> outs; ///< raw outputs in [score,bbox,score,bbox,...] order
-        std::vector<Ort::Value> out_tensors;  ///< ORT tensor wrappers for outs
+        platform::BoundBuffer<float> in;                ///< NCHW input buffer (batch slots)
+        std::vector<platform::BoundBuffer<float>> outs; ///< raw outputs in Bucket::out_indices order (batch slots)
+        platform::BoundBuffer<std::uint16_t> in_f16;    ///< Bound float16 input (float16 models only, size of @ref in)
+        std::vector<platform::BoundBuffer<std::uint16_t>> outs_f16; ///< Bound float16 outputs (empty for float32)
+        std::vector<Ort::Value> out_tensors;            ///< ORT tensor wrappers for outs (slot 0 views)
+        std::vector<SlotScratch> slots;                 ///< Per slot scratch (size = batch)
+        std::vector<int> pad_w, pad_h;                  ///< Per slot: content extent written over the letterbox padding
 
         std::unique_ptr<Ort::IoBinding> binding;
         Ort::Value in_tensor{nullptr};
+
+        std::vector<Ort::Value> batch_out_tensors;     ///< ORT tensor wrappers over all slots (batch > 1 only)
+        std::unique_ptr<Ort::IoBinding> batch_binding; ///< Batched binding (batch > 1 only)
+        Ort::Value batch_in_tensor{nullptr};
+    };
+
+    /**
+     * @brief Bound state of one input shape.
+     *
+     * @details
+     * Head grids depend on the input shape, so every bucket resolves its own heads. Every bucket
+     * holds all contexts, so a context index is valid whichever bucket a frame routes to.
+     */
+    struct Bucket {
+        int in_w = 0, in_h = 0;                       ///< Aligned input shape
+        std::vector<Head> heads;                      ///< Heads resolved for this shape
+        std::vector<int> out_indices;                 ///< Subset/order of model outputs that are bound
+        std::size_t in_slice = 0;                     ///< Floats per input slot (3 * in_h * in_w)
+        std::vector<std::size_t> out_slices;          ///< Floats per output slot, in out_indices order
+        std::vector<std::vector<int64_t>> out_shapes; ///< Single-image output shapes, in out_indices order
+        std::vector<BoundCtx> ctxs;                   ///< Per-context state
+    };
+
+    /** @brief Where a frame goes in bound mode: bucket, content size and input/original scales. */
+    struct Placement {
+        int bucket = 0;                   ///< Index into @ref buckets_
+        int orig_w = 0, orig_h = 0;       ///< Source frame size
+        int content_w = 0, content_h = 0; ///< Resized frame size (the whole input unless letterboxed)
+        float sx = 1.f, sy = 1.f;         ///< content / orig
     };
 
     /** @brief Cache cfg_.infer hot fields into POD members for fast access in the hot path. */
@@ -229,7 +395,7 @@ class SCRFD final : public IEngine {
     void init_io_names_();
 
     /**
-     * @brief Probe output indices and infer per-head layouts for a fixed input shape.
+     * @brief Resolve output shapes for a fixed input shape and infer per-head layouts from them.
      *
      * @param in_h Effective input height.
      * @param in_w Effective input width.
@@ -239,14 +405,64 @@ class SCRFD final : public IEngine {
     Status probe_heads_layout_(int in_h, int in_w, std::vector<Head>* heads) noexcept;
 
     /**
-     * @brief Fill CHW float input tensor from a BGR image with SCRFD normalization.
+     * @brief Infer per-head layouts from known batch-1 output shapes (no inference).
+     *
+     * @param shapes Output shapes in @ref out_names_ order.
+     * @param in_h Effective input height.
+     * @param in_w Effective input width.
+     * @param heads Output vector to fill with inferred head metadata.
+     * @return Status::Ok() on success; error status otherwise.
+     */
+    Status resolve_heads_(const ShapeList& shapes, int in_h, int in_w, std::vector<Head>* heads) const noexcept;
+
+    /**
+     * @brief Build one bucket per aligned shape (shared by @ref setup_binding and @ref setup_binding_pool).
+     *
+     * @param shapes Distinct aligned (w, h) input shapes.
+     * @param contexts Number of contexts per bucket.
+     * @param batch Maximum images per bound run.
+     * @param letterbox Letterbox frames into their bucket instead of stretching them.
+     */
+    Status setup_buckets_(const std::vector<std::pair<int, int>>& shapes, int contexts, int batch,
+                          bool letterbox) noexcept;
+
+    /** @brief Route a frame of the given size to a bucket and compute its placement. */
+    Placement place_(int orig_w, int orig_h) const noexcept;
+
+    /**
+     * @brief Preprocess @p src into batch slot @p slot of @p c as described by @p p.
+     *
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void fill_bound_(const Bucket& bk, BoundCtx& c, int slot, const algo::ChwSource& src, const Placement& p) const;
+
+    /**
+     * @brief Run the bound session over the first @p count slots of @p c.
+     *
+     * @details
+     * Uses the batch-1 binding for @p count == 1 and the batch binding otherwise. float16 inputs
+     * and outputs are converted from / into the float32 buffers around the run, so decoding
+     * always reads @ref BoundCtx::outs.
+     */
+    void run_bound_(const Bucket& bk, BoundCtx& c, int count);
+
+    /** @brief Body of @ref infer_unbound for an already validated source. */
+    Result<std::vector<algo::Detection>> infer_unbound_(const algo::ChwSource& src) noexcept;
+
+    /** @brief Body of @ref infer_bound_into for an already validated source. */
+    Status infer_bound_into_(const algo::ChwSource& src, int ctx_idx, std::vector<algo::Detection>& out) noexcept;
+
+    /**
+     * @brief Fill CHW float input tensor from a BGR image or 4:2:0 frame with SCRFD normalization.
      *
      * @param dst Destination CHW buffer (size = 3 * in_h * in_w).
      * @param in_w Effective input width.
      * @param in_h Effective input height.
-     * @param bgr Source image (CV_8UC3).
+     * @param src Source image (BGR CV_8UC3 or YUV planes).
+     * @param ws Resize scratch (per binding context); nullptr uses a thread-local one.
      */
-    void fill_input_chw_(float* dst, int in_w, int in_h, const cv::Mat& bgr) const;
+    void fill_input_chw_(float* dst, int in_w, int in_h, const algo::ChwSource& src,
+                         algo::ResizeChwWorkspace* ws = nullptr) const;
 
     /**
      * @brief Run ORT in unbound mode and return all model outputs.
@@ -255,7 +471,7 @@ class SCRFD final : public IEngine {
      * Performs preprocessing and returns raw ORT outputs. Also reports the geometric
      * scale factors to map detections back to original image coordinates.
      *
-     * @param bgr Input BGR image.
+     * @param src Input image (BGR or 4:2:0 planes).
      * @param force_w If > 0, forces preprocessing to this width (engine-defined alignment may apply).
      * @param force_h If > 0, forces preprocessing to this height.
      * @param sx Output: scale X (in_w / orig_w).
@@ -263,8 +479,33 @@ class SCRFD final : public IEngine {
      * @param in_w Output: effective preprocessed width.
      * @param in_h Output: effective preprocessed height.
      */
-    Result<std::vector<Ort::Value>> run_unbound_(const cv::Mat& bgr, int force_w, int force_h, float& sx, float& sy,
-                                                 int& in_w, int& in_h) noexcept;
+    Result<std::vector<Ort::Value>> run_unbound_(const algo::ChwSource& src, int force_w, int force_h, float& sx,
+                                                 float& sy, int& in_w, int& in_h) noexcept;
+
+    /**
+     * @brief Run ORT in unbound mode on an already prepared NCHW buffer.
+     *
+     * @param chw Contiguous input of size @p count (= batch * 3 * in_h * in_w).
+     * @param count Number of floats in @p chw.
+     * @param batch Leading (batch) dimension.
+     * @param in_h Input height.
+     * @param in_w Input width.
+     * @return All model outputs in @ref out_names_ order.
+     */
+    Result<std::vector<Ort::Value>> run_chw_unbound_(const float* chw, std::size_t count, int batch, int in_h,
+                                                     int in_w) noexcept;
+
+    /**
+     * @brief Decode one batch slot of a bound context.
+     *
+     * @param bk Bucket the frame was run in.
+     * @param c Bound context.
+     * @param slot Batch slot index in [0, bound_batch()).
+     * @param p Placement of the frame (scales and original size).
+     * @param out Destination detections (cleared first).
+     */
+    void decode_bound_slot_(const Bucket& bk, BoundCtx& c, int slot, const Placement& p,
+                            std::vector<algo::Detection>& out) const;
 
     /** @brief Stable sigmoid helper for score decoding. */
     static inline float sigmoid_(float x) noexcept;
@@ -280,17 +521,45 @@ class SCRFD final : public IEngine {
      */
     static algo::Detection rect_to_det_(float x1, float y1, float x2, float y2, float score);
 
+    /// @brief Stack buffer size (score entries) for one gating pass over a score row.
+    static constexpr int kGateChunk_ = 256;
+
+    /**
+     * @brief Decode one head with accessors specialized for its score/bbox/landmark layouts.
+     *
+     * @details
+     * Appends to @p dets; @p kps may be null. @p KL is @c Layout::Unknown for heads without
+     * landmarks; @p kSigmoid activates raw scores. See @ref decode_ for the coordinate mapping.
+     */
+    template <Layout SL, Layout BL, Layout KL, bool kSigmoid>
+    void decode_head_(const Head& h, const float* score, const float* bbox, const float* kps, float sx, float sy,
+                      int orig_w, int orig_h, std::vector<algo::Detection>& dets) const;
+
+    /**
+     * @brief The @ref decode_head_ instance for the layouts of @p h.
+     *
+     * @details
+     * Called once per head when the heads are resolved (first unbound run, binding setup), so
+     * per-frame decoding never dispatches on layouts.
+     */
+    static HeadDecodeFn decoder_for_(const Head& h, bool sigmoid) noexcept;
+
     /**
      * @brief Decode model heads into detections.
      *
      * @details
-     * Consumes per-head pointers to score tensors and bbox tensors, interpreting each
-     * according to the inferred @ref Head::score_layout and @ref Head::bbox_layout.
+     * Consumes per-head pointers to score, bbox and (optional, may be null) landmark tensors,
+     * interpreting each according to the inferred @ref Head layouts.
      * Produces detections mapped to original image coordinates using scale factors.
      */
-    std::vector<algo::Detection> decode_(const std::vector<Head>& heads, const std::vector<const float*>& score_ptrs,
-                                         const std::vector<const float*>& bbox_ptrs, float sx, float sy, int orig_w,
-                                         int orig_h) const;
+    void decode_(const std::vector<Head>& heads, const std::vector<const float*>& score_ptrs,
+                 const std::vector<const float*>& bbox_ptrs, const std::vector<const float*>& kps_ptrs, float sx,
+                 float sy, int orig_w, int orig_h, std::vector<algo::Detection>& dets) const;
+
+    /** @brief Appends the head tensors passed to @ref decode_ to @ref capture_ (session output order). */
+    void record_(const std::vector<Head>& heads, const std::vector<const float*>& score_ptrs,
+                 const std::vector<const float*>& bbox_ptrs, const std::vector<const float*>& kps_ptrs, float sx,
+                 float sy, int orig_w, int orig_h) const;
 
   private:
     /** @brief ORT input node name (single input). */
@@ -299,21 +568,29 @@ class SCRFD final : public IEngine {
     /** @brief ORT output node names (score/bbox outputs). */
     std::vector<std::string> out_names_;
 
-    /** @brief Inferred per-stride head metadata (valid after probing/binding). */
+    /** @brief Inferred per-stride head metadata for unbound inference (resolved lazily). */
     std::vector<Head> heads_;
+    std::atomic<bool> heads_ready_{false}; ///< Set once @ref heads_ is resolved; read without @ref heads_mu_
+    std::mutex heads_mu_;                  ///< Serializes the lazy resolution of @ref heads_ and @ref capture_heads_
+
+    /** @brief Heads of decoded capture frames per output shape set (map nodes stay put). */
+    std::map<ShapeList, std::vector<Head>> capture_heads_;
 
     // cached hot params
     bool apply_sigmoid_ = false;
     float score_thr_ = 0.6f;
+    float gate_thr_ = 0.6f; ///< @ref score_thr_ in raw tensor space (logit when @ref apply_sigmoid_), minus a margin
+    int post_threads_ = 1;
     int max_img_ = 960;
     int min_w_ = 10;
     int min_h_ = 10;
+    bool letterbox_unbound_ = false; ///< @ref InferenceOptions::letterbox for unbound frames
 
-    /** @brief Subset/order of model outputs used for bound inference binding. */
-    std::vector<int> bound_out_indices_;
+    /** @brief Bound input shapes with their heads and per-context resources. */
+    std::vector<Bucket> buckets_;
 
-    /** @brief Per-context bound-mode resources. */
-    std::vector<BoundCtx> ctxs_;
+    /** @brief Per context: placement of the frame staged by @ref stage_input. */
+    std::vector<Placement> staged_;
 };
 
 } // namespace idet::engine
@@ -0,0 +1,79 @@
+/**
+ * @file session_registry.cpp
+ * @ingroup idet_engine
+ * @brief Implementation of the shared ONNX Runtime session registry.
+ */
+
+#include "engine/session_registry.h"
+
+#include <utility>
+#include <vector>
+
+namespace idet::engine {
+
+SessionRegistry& SessionRegistry::global() noexcept {
+    static SessionRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<Ort::Session> SessionRegistry::own(Ort::Session&& session, std::shared_ptr<const void> keep_alive) {
+    if (!keep_alive) return std::make_shared<Ort::Session>(std::move(session));
+    // The deleter (and with it keep_alive) is destroyed after it deleted the session.
+    return std::shared_ptr<Ort::Session>(new Ort::Session(std::move(session)),
+                                         [keep = std::move(keep_alive)](Ort::Session* s) { delete s; });
+}
+
+std::shared_ptr<Ort::Session> SessionRegistry::acquire(const SessionKey& key, const Factory& make, bool* created,
+                                                       std::shared_ptr<const void> keep_alive) {
+    if (created) *created = false;
+
+    std::shared_ptr<Entry> e;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+
+        // Drop entries of sessions that are gone, so the map does not grow with model churn. An
+        // entry another caller holds may be building its session right now: keep it.
+        for (auto it = sessions_.begin(); it != sessions_.end();) {
+            bool gone = it->second.use_count() == 1;
+            if (gone) {
+                std::lock_guard<std::mutex> bk(it->second->build_mu);
+                gone = it->second->session.expired();
+            }
+            if (gone)
+                it = sessions_.erase(it);
+            else
+                ++it;
+        }
+
+        auto& slot = sessions_[key];
+        if (!slot) slot = std::make_shared<Entry>();
+        e = slot;
+    }
+
+    std::lock_guard<std::mutex> bk(e->build_mu);
+    if (auto s = e->session.lock()) return s;
+
+    auto s = own(make(), std::move(keep_alive));
+    e->session = s;
+    if (created) *created = true;
+    return s;
+}
+
+std::size_t SessionRegistry::live() const {
+    // Entries are read outside the map lock: one of them may be building its session.
+    std::vector<std::shared_ptr<Entry>> entries;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        entries.reserve(sessions_.size());
+        for (const auto& kv : sessions_)
+            entries.push_back(kv.second);
+    }
+    std::size_t n = 0;
+    for (const auto& e : entries) {
+        std::lock_guard<std::mutex> bk(e->build_mu);
+        n += e->session.expired() ? 0u : 1u;
+    }
+    return n;
+}
+
+} // namespace idet::engine
@@ -0,0 +1,98 @@
+/**
+ * @file session_registry.h
+ * @ingroup idet_engine
+ * @brief Process-wide registry of shared, reference-counted ONNX Runtime sessions.
+ *
+ * @details
+ * An @c Ort::Session is immutable after creation and @c Session::Run is thread-safe, so several
+ * detectors running the same model can share one session (weights loaded and graph optimized
+ * once) while keeping private IoBinding contexts and buffers. The registry keys sessions by
+ * model content hash and a fingerprint of the session options, and only holds weak references:
+ * a session is released when its last engine goes away.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "internal/ort_headers.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace idet::engine {
+
+/** @brief Registry key: model identity and everything in the session options that changes the session. */
+struct SessionKey {
+    std::uint64_t model = 0; ///< Content hash of the model (see @ref ShapeCache::hash_bytes)
+    std::string options;     ///< Session options fingerprint (threads, optimization, ...)
+
+    bool operator<(const SessionKey& o) const noexcept {
+        return std::tie(model, options) < std::tie(o.model, o.options);
+    }
+};
+
+/**
+ * @brief Thread-safe map from @ref SessionKey to a live shared session.
+ *
+ * @details
+ * Creation runs under a per-key lock, so concurrent detectors asking for the same model wait
+ * for the first one instead of loading the weights twice, while sessions of different keys
+ * (other models, or the same model with other options) are built in parallel.
+ */
+class SessionRegistry final {
+  public:
+    /** @brief Builds a new session on a registry miss; may throw (ORT or allocation errors). */
+    using Factory = std::function<Ort::Session()>;
+
+    SessionRegistry() = default;
+    SessionRegistry(const SessionRegistry&) = delete;
+    SessionRegistry& operator=(const SessionRegistry&) = delete;
+
+    /** @brief Process-wide instance shared by all engines. */
+    static SessionRegistry& global() noexcept;
+
+    /**
+     * @brief Returns the live session for @p key, creating it with @p make if there is none.
+     *
+     * @param key Model/options key.
+     * @param make Session factory, called at most once per miss.
+     * @param created Optional; set to true if @p make was called.
+     * @param keep_alive Released together with a session created by this call, e.g. the model
+     *        mapping its weights point into. Unused on a hit (the live session holds its own).
+     * @return Shared session handle (never null).
+     *
+     * @throws Whatever @p make throws; the registry is left unchanged in that case.
+     */
+    std::shared_ptr<Ort::Session> acquire(const SessionKey& key, const Factory& make, bool* created = nullptr,
+                                          std::shared_ptr<const void> keep_alive = {});
+
+    /**
+     * @brief Wraps a new session so that @p keep_alive is released right after the session.
+     *
+     * @details
+     * Used directly by engines that do not share their session.
+     */
+    static std::shared_ptr<Ort::Session> own(Ort::Session&& session, std::shared_ptr<const void> keep_alive);
+
+    /** @brief Number of sessions currently alive (waits for sessions being built). */
+    std::size_t live() const;
+
+  private:
+    /** @brief One key: the live session and the lock its creation runs under. */
+    struct Entry {
+        std::mutex build_mu;
+        std::weak_ptr<Ort::Session> session; ///< Guarded by @ref build_mu
+    };
+
+    mutable std::mutex mu_; ///< Guards the map only, never held while a session is built
+    std::map<SessionKey, std::shared_ptr<Entry>> sessions_;
+};
+
+} // namespace idet::engine
@@ -0,0 +1,162 @@
+/**
+ * @file shape_cache.cpp
+ * @ingroup idet_engine
+ * @brief Implementation of the probed output shape cache and model content hashing.
+ */
+
+#include "engine/shape_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <sstream>
+
+namespace idet::engine {
+
+namespace {
+
+constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+/// @brief Word-wise FNV-1a state; feeding chunks whose sizes are multiples of 8 is equivalent to one call.
+struct Hasher {
+    std::uint64_t h = kFnvOffset;
+    std::uint64_t total = 0;
+
+    void update(const unsigned char* p, std::size_t n) noexcept {
+        total += n;
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            std::uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            h = (h ^ w) * kFnvPrime;
+        }
+        for (; i < n; ++i)
+            h = (h ^ p[i]) * kFnvPrime;
+    }
+
+    std::uint64_t finish() const noexcept {
+        std::uint64_t r = (h ^ total) * kFnvPrime;
+        r ^= r >> 29;
+        return r ? r : 1; // 0 is reserved for "unknown model"
+    }
+};
+
+} // namespace
+
+ShapeCache& ShapeCache::global() noexcept {
+    static ShapeCache cache;
+    return cache;
+}
+
+std::uint64_t ShapeCache::hash_bytes(const void* data, std::size_t size) noexcept {
+    Hasher hs;
+    if (data && size) hs.update(static_cast<const unsigned char*>(data), size);
+    return hs.finish();
+}
+
+std::uint64_t ShapeCache::hash_file(const std::string& path) noexcept {
+    try {
+        std::ifstream f(path, std::ios::binary);
+        if (!f) return 0;
+
+        Hasher hs;
+        std::vector<char> buf((std::size_t)1 << 20); // multiple of 8: chunking does not change the hash
+        while (f) {
+            f.read(buf.data(), (std::streamsize)buf.size());
+            const std::streamsize got = f.gcount();
+            if (got > 0) hs.update(reinterpret_cast<const unsigned char*>(buf.data()), (std::size_t)got);
+        }
+        if (f.bad()) return 0;
+        return hs.finish();
+    } catch (...) {
+        return 0;
+    }
+}
+
+void ShapeCache::load_file_locked_(const std::string& file) {
+    if (file.empty() || !loaded_files_.insert(file).second) return;
+
+    std::ifstream f(file);
+    if (!f) return;
+
+    std::string line;
+    while (std::getline(f, line)) {
+        std::istringstream is(line);
+        ShapeKey k;
+        std::string hex;
+        std::size_t n = 0;
+        if (!(is >> hex >> k.batch >> k.in_h >> k.in_w >> n)) continue;
+        if (n == 0 || n > 4096 || k.batch <= 0 || k.in_h <= 0 || k.in_w <= 0) continue;
+
+        char* end = nullptr;
+        k.model = std::strtoull(hex.c_str(), &end, 16);
+        if (!end || *end != '\0' || k.model == 0) continue;
+
+        ShapeList shapes(n);
+        bool ok = true;
+        for (auto& s : shapes) {
+            std::size_t rank = 0;
+            if (!(is >> rank) || rank > 16) {
+                ok = false;
+                break;
+            }
+            s.resize(rank);
+            for (auto& d : s) {
+                if (!(is >> d) || d < 0) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (!ok) break;
+        }
+        if (ok) entries_[k] = std::move(shapes);
+    }
+}
+
+bool ShapeCache::lookup(const ShapeKey& key, ShapeList& out, const std::string& file) {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_file_locked_(file);
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void ShapeCache::store(const ShapeKey& key, const ShapeList& shapes, const std::string& file) {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_file_locked_(file);
+    entries_[key] = shapes;
+
+    if (file.empty()) return;
+
+    std::ostringstream os;
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)key.model);
+    os << hex << ' ' << key.batch << ' ' << key.in_h << ' ' << key.in_w << ' ' << shapes.size();
+    for (const auto& s : shapes) {
+        os << ' ' << s.size();
+        for (auto d : s)
+            os << ' ' << d;
+    }
+    os << '\n';
+
+    // Best-effort: a single appended line per probe, failures leave the in-memory entry intact.
+    std::ofstream f(file, std::ios::app);
+    if (f) f << os.str() << std::flush;
+}
+
+std::size_t ShapeCache::size() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return entries_.size();
+}
+
+void ShapeCache::clear() noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    entries_.clear();
+    loaded_files_.clear();
+}
+
+} // namespace idet::engine
@@ -0,0 +1,105 @@
+/**
+ * @file shape_cache.h
+ * @ingroup idet_engine
+ * @brief Process-wide (optionally persistent) cache of probed model output shapes.
+ *
+ * @details
+ * Bound inference needs the real output shapes of a model for a given input shape before any
+ * buffer can be allocated. Models with dynamic spatial axes only reveal them by running, so
+ * engines used to run a full zero-input inference on every @c setup_binding. The cache keys
+ * probed shapes by (model content hash, batch, input H, input W): repeated setups, additional
+ * detector instances of the same model and - with a cache file - restarts skip the probe run.
+ *
+ * File format (one entry per line, appended on every new probe; unknown/malformed lines are
+ * ignored, later lines win):
+ * @code
+ *   <model-hash-hex> <batch> <in_h> <in_w> <n_outputs> { <rank> <d0> ... <dN> } * n_outputs
+ * @endcode
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace idet::engine {
+
+/** @brief Output tensor shapes of a model, indexed like the session outputs. */
+using ShapeList = std::vector<std::vector<std::int64_t>>;
+
+/** @brief Cache key: model identity and the probed input shape [batch,3,in_h,in_w]. */
+struct ShapeKey {
+    std::uint64_t model = 0; ///< Content hash of the model (see @ref ShapeCache::hash_bytes)
+    int batch = 1;           ///< Leading input dimension
+    int in_h = 0;            ///< Input height
+    int in_w = 0;            ///< Input width
+
+    bool operator<(const ShapeKey& o) const noexcept {
+        return std::tie(model, batch, in_h, in_w) < std::tie(o.model, o.batch, o.in_h, o.in_w);
+    }
+};
+
+/**
+ * @brief Thread-safe map from @ref ShapeKey to probed output shapes, with optional file backing.
+ *
+ * @details
+ * Every method taking @p file merges that file into memory the first time it is seen, and
+ * @ref store appends new entries to it. An empty @p file keeps the cache in memory only.
+ * File I/O is best-effort: unreadable or unwritable files never fail a lookup or store.
+ */
+class ShapeCache final {
+  public:
+    ShapeCache() = default;
+    ShapeCache(const ShapeCache&) = delete;
+    ShapeCache& operator=(const ShapeCache&) = delete;
+
+    /** @brief Process-wide instance shared by all engines. */
+    static ShapeCache& global() noexcept;
+
+    /**
+     * @brief Looks up shapes for @p key.
+     *
+     * @param key Model/input key.
+     * @param out Receives the cached shapes on hit.
+     * @param file Optional cache file merged before the lookup.
+     * @return true on hit.
+     */
+    bool lookup(const ShapeKey& key, ShapeList& out, const std::string& file = {});
+
+    /**
+     * @brief Records shapes for @p key (and appends them to @p file when given).
+     *
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void store(const ShapeKey& key, const ShapeList& shapes, const std::string& file = {});
+
+    /** @brief Number of in-memory entries. */
+    std::size_t size() const;
+
+    /** @brief Drops all in-memory entries and forgets which files were merged. */
+    void clear() noexcept;
+
+    /** @brief 64-bit content hash (FNV-1a over 8-byte words) used as @ref ShapeKey::model. */
+    static std::uint64_t hash_bytes(const void* data, std::size_t size) noexcept;
+
+    /** @brief @ref hash_bytes over the contents of @p path; returns 0 if the file cannot be read. */
+    static std::uint64_t hash_file(const std::string& path) noexcept;
+
+  private:
+    /** @brief Merges @p file into @ref entries_ once (requires @ref mu_). */
+    void load_file_locked_(const std::string& file);
+
+    mutable std::mutex mu_;
+    std::map<ShapeKey, ShapeList> entries_;
+    std::set<std::string> loaded_files_;
+};
+
+} // namespace idet::engine
@@ -9,6 +9,8 @@
  * - The public @ref idet::Detector PImpl/vtable facade (ABI-stable public surface)
  * - A private implementation class (`detail::DetectorImpl`) that owns the engine instance
  *   and orchestrates preprocessing, tiling, filtering, and NMS.
+ * - The asynchronous submit/poll/wait API backed by @ref idet::pipeline::AsyncPipeline
+ *   (or @ref idet::pipeline::TileScheduler when tiling is enabled).
  *
  * ABI stability strategy:
  * - Public header does not expose implementation types.
@@ -22,19 +24,46 @@
 
 #include "idet.h"
 
+#include "algo/arena.h"
+#include "algo/detection_buffer.h"
+#include "algo/geometry.h"
 #include "algo/nms.h"
+#include "algo/quality.h"
+#include "algo/tile_cache.h"
+#include "algo/tile_merge.h"
 #include "algo/tiling.h"
+#include "algo/tracker.h"
+#include "engine/context_pool.h"
 #include "engine/engine_factory.h"
+#include "engine/ort_env.h"
+#include "internal/chw_source.h"
 #include "internal/cv_bgr.h"
 #include "internal/opencv_headers.h" // IWYU pragma: keep
+#include "internal/stage_stats.h"
+#include "pipeline/async_pipeline.h"
+#include "pipeline/tile_scheduler.h"
+#include "platform/cross_topology.h"
 #include "platform/runtime_policy_setup.h"
+#include "platform/thread_pool.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <condition_variable>
+#include <cstdint>
 #include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <new>
+#include <optional>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace idet {
 
@@ -75,8 +104,7 @@ static inline bool passes_min_size_(const algo::Detection& d, int min_w, int min
  * @brief Converts internal detections into the public API quadrilateral list.
  *
  * @details
- * The public API exposes only geometry (quads). Scores remain internal to keep
- * the external surface minimal and stable.
+ * Geometry only; use @ref to_public_results_ for scores and landmarks.
  *
  * @param dets Vector of internal detection objects.
  * @return Public @ref idet::VecQuad where each element is a @ref idet::Quad.
@@ -95,6 +123,116 @@ static inline VecQuad to_public_quads_(const std::vector<algo::Detection>& dets)
     return out;
 }
 
+/**
+ * @brief Converts internal detections into structured public results.
+ *
+ * @param dets Vector of internal detection objects.
+ * @param out Destination; cleared first, capacity is reused.
+ */
+static inline void to_public_results_(const std::vector<algo::Detection>& dets, VecDetection& out) {
+    out.clear();
+    out.reserve(dets.size());
+    for (const auto& d : dets) {
+        DetectionResult r;
+        for (int i = 0; i < 4; ++i) {
+            r.quad[i].x = d.pts[i].x;
+            r.quad[i].y = d.pts[i].y;
+        }
+        r.score = d.score;
+        r.has_landmarks = d.has_kps;
+        if (d.has_kps) {
+            for (std::size_t i = 0; i < r.landmarks.size(); ++i) {
+                r.landmarks[i].x = d.kps[i].x;
+                r.landmarks[i].y = d.kps[i].y;
+            }
+        }
+        r.tile = d.tile;
+        out.push_back(r);
+    }
+}
+
+/**
+ * @brief Sub-view of @p v covering @p r, without copying pixels.
+ *
+ * @details
+ * Chroma planes of 4:2:0 views are offset by half of @p r and get explicit strides, since the
+ * sub-view no longer has the contiguous single-buffer layout.
+ *
+ * @param r Region inside the view with even origin and size.
+ */
+static ImageView crop_view_(const ImageView& v, const cv::Rect& r) noexcept {
+    ImageView c = v;
+    c.width = r.width;
+    c.height = r.height;
+    if (!v.is_yuv()) {
+        c.data = v.data + (std::size_t)r.y * v.stride_bytes + (std::size_t)r.x * (std::size_t)v.channels();
+        return c;
+    }
+
+    c.data = v.data + (std::size_t)r.y * v.stride_bytes + (std::size_t)r.x;
+    const bool planar = v.format == PixelFormat::I420_U8;
+    for (int i = 0; i < (planar ? 2 : 1); ++i) {
+        const std::size_t cs = v.chroma_stride(i);
+        // Interleaved UV keeps one byte per luma column; planar U and V have half of them.
+        c.chroma[i] = v.chroma_plane(i) + (std::size_t)(r.y / 2) * cs + (std::size_t)(planar ? r.x / 2 : r.x);
+        c.chroma_stride_bytes[i] = cs;
+    }
+    return c;
+}
+
+/**
+ * @brief Clips @p r to the extent of @p v; 4:2:0 views widen it outwards to even coordinates.
+ *
+ * @return The region for @ref crop_view_ (empty if @p r does not overlap the view).
+ */
+static cv::Rect clip_roi_(const ImageView& v, const Rect& r) noexcept {
+    const long long x0 = std::max<long long>(0, r.x);
+    const long long y0 = std::max<long long>(0, r.y);
+    const long long x1 = std::min<long long>(v.width, (long long)r.x + std::max(0, r.width));
+    const long long y1 = std::min<long long>(v.height, (long long)r.y + std::max(0, r.height));
+    if (x1 <= x0 || y1 <= y0) return {};
+    if (!v.is_yuv()) return {(int)x0, (int)y0, (int)(x1 - x0), (int)(y1 - y0)};
+
+    // 4:2:0 frames have even dimensions, so rounding the far edges up stays inside.
+    const int ex0 = (int)(x0 & ~1LL);
+    const int ey0 = (int)(y0 & ~1LL);
+    const int ex1 = (int)std::min<long long>(v.width, (x1 + 1) & ~1LL);
+    const int ey1 = (int)std::min<long long>(v.height, (y1 + 1) & ~1LL);
+    return {ex0, ey0, ex1 - ex0, ey1 - ey0};
+}
+
+/**
+ * @brief Starts the worker pool threads the policy will use, from the calling thread.
+ *
+ * @details
+ * Threads started here inherit the caller's placement instead of that of whichever thread runs
+ * the first parallel frame. On the first start with @ref RuntimePolicy::pin_worker_threads the
+ * workers are pinned in @ref idet::platform::select_pool_cpus order, skipping the first CPU (left
+ * to the calling thread) and the CPUs of pinned global ORT intra-op threads.
+ *
+ * @throws std::system_error If a thread cannot be started.
+ * @throws std::bad_alloc On allocation failure.
+ */
+static void prepare_worker_pool_(const RuntimePolicy& rt) {
+    const int hw = platform::ThreadPool::hardware_width();
+    const int tile = (rt.tile_omp_threads > 0) ? rt.tile_omp_threads : hw;
+    const int post = (rt.post_omp_threads > 0) ? rt.post_omp_threads : hw;
+    const int helpers = std::max(tile, post) - 1;
+    if (helpers <= 0) return;
+
+    auto& pool = platform::ThreadPool::current();
+    if (rt.pin_worker_threads && pool.size() == 0) {
+        const std::vector<int> order = platform::select_pool_cpus(std::numeric_limits<std::size_t>::max());
+        const std::vector<int> ort = engine::OrtEnvironment::global().pools().intra_cpus;
+        std::vector<int> cpus;
+        for (std::size_t i = 1; i < order.size(); ++i) {
+            if (std::find(ort.begin(), ort.end(), order[i]) == ort.end()) cpus.push_back(order[i]);
+        }
+        pool.pin_workers(std::move(cpus));
+    }
+    pool.reserve((std::size_t)helpers);
+}
+
 } // namespace
 
 /// @brief Builds a minimal detector configuration for a given task and model path.
@@ -124,28 +262,116 @@ Status DetectorConfig::validate() const noexcept {
     if (task == Task::None) return Status::Invalid("DetectorConfig: task==None");
     if (engine == EngineKind::None) return Status::Invalid("DetectorConfig: engine==None");
 
-    const Task et = engine_task(engine);
+    // Replay decodes with the DBNet or SCRFD postprocessing depending on the task.
+    const Task et = engine == EngineKind::Replay ? task : engine_task(engine);
     if (et == Task::None) return Status::Unsupported("DetectorConfig: unknown engine");
     if (et != task) return Status::Invalid("DetectorConfig: engine/task mismatch");
+    if (engine == EngineKind::Replay) {
+        if (task != Task::Text && task != Task::Face) return Status::Unsupported("Replay: unknown task");
+        if (model_path.empty()) return Status::Invalid("Replay: model_path must name a capture file");
+        if (!(infer.replay.latency_ms >= 0.0f) || !(infer.replay.jitter_ms >= 0.0f))
+            return Status::Invalid("Replay: latency_ms and jitter_ms must be >= 0");
+    }
 
     if (infer.tiles_dim.rows <= 0 || infer.tiles_dim.cols <= 0)
         return Status::Invalid("DetectorConfig: tiles_dim must be > 0");
     if (!(infer.tile_overlap >= 0.0f && infer.tile_overlap < 1.0f))
         return Status::Invalid("DetectorConfig: tile_overlap must be in [0,1)");
+    if (infer.tile_mode != TileMode::Grid && infer.tile_mode != TileMode::Adaptive)
+        return Status::Invalid("DetectorConfig: unknown tile_mode");
+    if (infer.tile_min_object < 0) return Status::Invalid("DetectorConfig: tile_min_object must be >= 0");
+    if (infer.tile_merge != TileMerge::Nms && infer.tile_merge != TileMerge::Seams &&
+        infer.tile_merge != TileMerge::SeamsJoin)
+        return Status::Invalid("DetectorConfig: unknown tile_merge");
+    if (infer.tile_mode == TileMode::Adaptive && infer.max_img_size <= 0 &&
+        (infer.fixed_input_dim.rows <= 0 || infer.fixed_input_dim.cols <= 0))
+        return Status::Invalid("DetectorConfig: adaptive tiling needs fixed_input_dim or max_img_size > 0");
 
     if (infer.min_roi_size_w < 0 || infer.min_roi_size_h < 0)
         return Status::Invalid("DetectorConfig: min_roi_size must be >= 0");
 
-    if (infer.bind_io && (infer.fixed_input_dim.rows <= 0 || infer.fixed_input_dim.cols <= 0))
-        return Status::Invalid("DetectorConfig: bind_io requires fixed_input_dim (HxW) with values > 0");
+    if (infer.stream.pixel_diff < 0 || infer.stream.pixel_diff > 255)
+        return Status::Invalid("DetectorConfig: stream.pixel_diff must be in [0,255]");
+    if (!(infer.stream.tile_change >= 0.0f && infer.stream.tile_change <= 1.0f))
+        return Status::Invalid("DetectorConfig: stream.tile_change must be in [0,1]");
+    if (infer.stream.sample_step < 1 || infer.stream.refresh_frames < 0)
+        return Status::Invalid("DetectorConfig: stream.sample_step must be >= 1, refresh_frames >= 0");
+
+    if (infer.nms_mode != NmsMode::Hard && infer.nms_mode != NmsMode::SoftLinear &&
+        infer.nms_mode != NmsMode::SoftGaussian && infer.nms_mode != NmsMode::Weighted)
+        return Status::Invalid("DetectorConfig: unknown nms_mode");
+    if (!(infer.nms_sigma > 0.0f)) return Status::Invalid("DetectorConfig: nms_sigma must be > 0");
+
+    const CascadeOptions& cc = infer.cascade;
+    if (cc.enabled && (cc.probe_size < 32 || cc.probe_size % 32 != 0))
+        return Status::Invalid("DetectorConfig: cascade.probe_size must be a positive multiple of 32");
+    if (!(cc.trigger >= 0.0f && cc.trigger <= 1.0f))
+        return Status::Invalid("DetectorConfig: cascade.trigger must be in [0,1]");
+    if (!(cc.roi_margin >= 0.0f) || !(cc.roi_max_area >= 0.0f && cc.roi_max_area <= 1.0f))
+        return Status::Invalid("DetectorConfig: cascade.roi_margin must be >= 0, roi_max_area in [0,1]");
+
+    const TrackOptions& tr = infer.track;
+    if (tr.keyframe_interval < 1 || tr.max_interval < tr.keyframe_interval)
+        return Status::Invalid("DetectorConfig: track.keyframe_interval must be >= 1, max_interval >= it");
+    if (!(tr.scene_change >= 0.0f && tr.scene_change <= 1.0f) || !(tr.iou_match >= 0.0f && tr.iou_match <= 1.0f))
+        return Status::Invalid("DetectorConfig: track.scene_change and track.iou_match must be in [0,1]");
+    if (!(tr.verify_margin >= 0.0f) || tr.max_misses < 0 ||
+        !(tr.max_region_area >= 0.0f && tr.max_region_area <= 1.0f))
+        return Status::Invalid("DetectorConfig: track.verify_margin/max_misses must be >= 0, max_region_area in [0,1]");
+    if (!(tr.target_ms >= 0.0f) || !(tr.cpu_share >= 0.0f && tr.cpu_share <= 1.0f))
+        return Status::Invalid("DetectorConfig: track.target_ms must be >= 0, cpu_share in [0,1]");
+
+    const QualityOptions& qo = infer.quality;
+    if (!(qo.target_ms >= 0.0f) || qo.max_queue < 0)
+        return Status::Invalid("DetectorConfig: quality.target_ms and quality.max_queue must be >= 0");
+    if (qo.hold_frames < 1 || !(qo.recover > 0.0f && qo.recover <= 1.0f))
+        return Status::Invalid("DetectorConfig: quality.hold_frames must be >= 1, recover in (0,1]");
+    for (const QualityLevel& l : qo.levels) {
+        if (l.max_img_size < 0 || l.tiles_dim.rows < 0 || l.tiles_dim.cols < 0 ||
+            (l.tiles_dim.rows > 0) != (l.tiles_dim.cols > 0))
+            return Status::Invalid("DetectorConfig: quality.levels need max_img_size >= 0, tiles_dim 0x0 or > 0");
+    }
+    if (qo.levels.empty() && (qo.target_ms > 0.0f || qo.max_queue > 0) && infer.max_img_size < 64)
+        return Status::Invalid("DetectorConfig: quality without levels needs max_img_size >= 64");
 
-    if (engine == EngineKind::DBNet) {
+    for (const GridSpec& b : infer.bind_buckets) {
+        if (b.rows <= 0 || b.cols <= 0) return Status::Invalid("DetectorConfig: bind_buckets values must be > 0");
+    }
+    if (infer.context_overflow != ContextOverflow::Wait && infer.context_overflow != ContextOverflow::Unbound &&
+        infer.context_overflow != ContextOverflow::Fail)
+        return Status::Invalid("DetectorConfig: unknown context_overflow");
+    if (infer.context_wait_ms < 0) return Status::Invalid("DetectorConfig: context_wait_ms must be >= 0");
+    if (infer.bind_io && infer.bind_buckets.empty() &&
+        (infer.fixed_input_dim.rows <= 0 || infer.fixed_input_dim.cols <= 0))
+        return Status::Invalid("DetectorConfig: bind_io requires fixed_input_dim (HxW) or bind_buckets, values > 0");
+
+    if (runtime.ort_spin != SpinPolicy::Default && runtime.ort_spin != SpinPolicy::Spin &&
+        runtime.ort_spin != SpinPolicy::NoSpin)
+        return Status::Invalid("DetectorConfig: unknown ort_spin");
+    if (runtime.ort_arena != ArenaPolicy::Arena && runtime.ort_arena != ArenaPolicy::ArenaShrink &&
+        runtime.ort_arena != ArenaPolicy::Off)
+        return Status::Invalid("DetectorConfig: unknown ort_arena");
+    if (runtime.ort_provider != ExecutionProvider::CPU && runtime.ort_provider != ExecutionProvider::XNNPACK &&
+        runtime.ort_provider != ExecutionProvider::DNNL && runtime.ort_provider != ExecutionProvider::CoreML)
+        return Status::Invalid("DetectorConfig: unknown ort_provider");
+    if (runtime.bound_buffers != BufferPolicy::Heap && runtime.bound_buffers != BufferPolicy::Aligned &&
+        runtime.bound_buffers != BufferPolicy::HugePages)
+        return Status::Invalid("DetectorConfig: unknown bound_buffers");
+
+    if (et == Task::Text) {
         if (!(infer.bin_thresh > 0.f && infer.bin_thresh < 1.f))
             return Status::Invalid("DBNet: bin_thresh must be in (0,1)");
         if (!(infer.box_thresh > 0.f && infer.box_thresh < 1.f))
             return Status::Invalid("DBNet: box_thresh must be in (0,1)");
         if (!(infer.unclip > 0.f)) return Status::Invalid("DBNet: unclip must be > 0");
-    } else if (engine == EngineKind::SCRFD) {
+        if (infer.score_mode != ScoreMode::Polygon && infer.score_mode != ScoreMode::Scanline &&
+            infer.score_mode != ScoreMode::Box)
+            return Status::Invalid("DBNet: unknown score_mode");
+        if (infer.map_downsample != 1 && infer.map_downsample != 2 && infer.map_downsample != 4)
+            return Status::Invalid("DBNet: map_downsample must be 1, 2 or 4");
+        if (infer.map_pooling != MapPooling::Max && infer.map_pooling != MapPooling::Average)
+            return Status::Invalid("DBNet: unknown map_pooling");
+    } else if (et == Task::Face) {
         if (!(infer.box_thresh > 0.f && infer.box_thresh < 1.f))
             return Status::Invalid("SCRFD: box_thresh must be in (0,1)");
     }
@@ -171,10 +397,114 @@ namespace detail {
  * This class is not part of the public ABI. It is accessed only via an internal vtable.
  */
 class DetectorImpl final {
+  private:
+    /**
+     * @brief Per-context buffers of the allocation-free bound path (see @ref run_into_).
+     *
+     * @details
+     * Vectors and matrices keep their capacity across frames, and so does the NMS grid and
+     * result storage inside @ref nms.
+     */
+    struct FrameScratch {
+        cv::Mat bgr;                       ///< Color conversion target for non-BGR inputs
+        std::vector<algo::Detection> raw;  ///< Engine detections
+        std::vector<algo::Detection> kept; ///< Detections after min-size filter and NMS
+        std::vector<algo::Detection> probe; ///< Cascade probe detections
+        algo::DetectionBuffer buf;          ///< Columnar copy of @ref raw that filtering and NMS run on
+        algo::NmsWorkspace nms;             ///< NMS state, reused every frame
+    };
+
+    /** @brief Binding request of the last successful @ref prepare_binding / @ref prepare_binding_pool. */
+    struct BindingPlan {
+        bool pool = false;           ///< Multi-resolution pool from @ref sizes, else one @ref w x @ref h binding
+        int w = 0, h = 0;            ///< Single binding size
+        std::vector<GridSpec> sizes; ///< Representative frame sizes of the pool
+        int contexts = 1;
+        int max_batch = 1;
+    };
+
+    /** @brief Engine, binding and configuration built off to the side by @ref reload. */
+    struct Generation {
+        DetectorConfig cfg;
+        std::unique_ptr<engine::IEngine> engine;
+        std::unique_ptr<engine::IEngine> probe;
+        bool binding_ready = false;
+        std::vector<FrameScratch> scratch;
+        std::unique_ptr<engine::ContextPool> contexts;
+    };
+
+    /**
+     * @brief Async backend of the previous engine whose completed frames were not collected at the swap.
+     *
+     * @details
+     * Its frames finished before the swap, so it runs nothing: it only answers @ref poll / @ref wait
+     * for tickets below @ref end and is released together with its engine once they are collected.
+     */
+    struct Retired {
+        std::unique_ptr<engine::IEngine> engine; ///< Declared first so the async backend is destroyed before it
+        std::unique_ptr<pipeline::AsyncPipeline> pipeline;
+        std::unique_ptr<pipeline::TileScheduler> tiles;
+        Ticket end = 0; ///< First ticket not issued by the retired backend
+    };
+
   public:
     /// @brief Constructs the implementation with an initial configuration snapshot.
     explicit DetectorImpl(DetectorConfig cfg) : cfg_(std::move(cfg)) {}
 
+    /// @brief Waits for a background reload (see @ref reload_async) before releasing the engine.
+    ~DetectorImpl() noexcept {
+        if (reload_thread_.joinable()) reload_thread_.join();
+    }
+
+    DetectorImpl(const DetectorImpl&) = delete;
+    DetectorImpl& operator=(const DetectorImpl&) = delete;
+
+    /**
+     * @brief Shared hold of the swap gate, taken by the facade around every call that uses the engine.
+     *
+     * @details
+     * Concurrent bound calls on distinct contexts all hold it together; @ref reload takes it
+     * exclusively only for the swap, so the swap waits for in-flight calls to drain.
+     */
+    std::shared_lock<std::shared_mutex> shared_gate() const {
+        return std::shared_lock<std::shared_mutex>(gate_);
+    }
+
+    /// @brief Exclusive hold of the swap gate, taken by the facade around calls that rebind or reconfigure.
+    std::unique_lock<std::shared_mutex> exclusive_gate() const {
+        return std::unique_lock<std::shared_mutex>(gate_);
+    }
+
+    /// @brief Runs @p f under @ref shared_gate, then applies a changed quality level (see @ref settle_quality).
+    template <class F> auto shared_call(F&& f) {
+        auto r = [&] {
+            const auto lk = shared_gate();
+            return f();
+        }();
+        settle_quality();
+        return r;
+    }
+
+    /**
+     * @brief Applies the level chosen by the quality controller if it differs from the one in effect.
+     *
+     * @details
+     * Called by the facade after a measured call released its shared hold of the gate. The level
+     * changes under the exclusive gate, like @ref update_config; while one caller applies it the
+     * others return right away.
+     */
+    void settle_quality() noexcept {
+        if (quality_want_.load(std::memory_order_relaxed) == quality_level_.load(std::memory_order_relaxed)) return;
+        if (quality_busy_.exchange(true, std::memory_order_acquire)) return;
+        try {
+            const auto lk = exclusive_gate();
+            apply_quality_(quality_want_.load(std::memory_order_relaxed));
+        } catch (...) {
+            // Retried by the next call.
+        }
+        quality_busy_.store(false, std::memory_order_release);
+    }
+
     /// @brief Returns the configured task.
     Task task() const noexcept {
         return cfg_.task;
@@ -190,19 +520,13 @@ class DetectorImpl final {
      *
      * @return @ref idet::Status::Ok() on success, otherwise a non-OK status.
      *
-     * @note Engine creation is delegated to @ref idet::engine::create_engine.
+     * @note Called once by @ref idet::Detector::create: call paths never create the engine lazily,
+     *       which would race between threads sharing the detector.
      */
     Status init_engine() noexcept {
-        const Status s = cfg_.validate();
-        if (!s.ok()) return s;
-
-        auto r = engine::create_engine(cfg_);
-        if (!r.ok()) return r.status();
-
-        engine_ = std::move(r.value());
-        if (!engine_) return Status::Internal("DetectorImpl: create_engine returned null");
-
-        return Status::Ok();
+        const Status s = create_engines_(cfg_, engine_, probe_);
+        if (s.ok()) reset_quality_();
+        return s;
     }
 
     /**
@@ -217,123 +541,1927 @@ class DetectorImpl final {
      * - inference options
      * - verbosity
      *
+     * Model path and runtime policy change through @ref reload instead.
+     *
      * @param cfg New configuration.
      * @return @ref idet::Status::Ok() on success, otherwise a non-OK status.
      */
     Status update_config(const DetectorConfig& cfg) noexcept {
         if (cfg.task != cfg_.task) return Status::Invalid("update_config: task cannot change");
         if (cfg.engine != cfg_.engine) return Status::Invalid("update_config: engine cannot change");
-        if (cfg.model_path != cfg_.model_path) return Status::Invalid("update_config: model_path cannot change");
+        if (cfg.model_path != cfg_.model_path)
+            return Status::Invalid("update_config: model_path cannot change (use reload)");
 
         const auto& a = cfg_.runtime;
         const auto& b = cfg.runtime;
         if (b.ort_intra_threads != a.ort_intra_threads || b.ort_inter_threads != a.ort_inter_threads ||
-            b.tile_omp_threads != a.tile_omp_threads || b.soft_mem_bind != a.soft_mem_bind ||
-            b.suppress_opencv != a.suppress_opencv) {
-            return Status::Invalid("update_config: runtime cannot change (recreate detector)");
+            b.tile_omp_threads != a.tile_omp_threads || b.post_omp_threads != a.post_omp_threads ||
+            b.soft_mem_bind != a.soft_mem_bind || b.suppress_opencv != a.suppress_opencv ||
+            b.share_session != a.share_session || b.optimized_model_file != a.optimized_model_file ||
+            b.profile_prefix != a.profile_prefix || b.profile_runs != a.profile_runs || b.ort_spin != a.ort_spin ||
+            b.ort_parallel != a.ort_parallel || b.ort_arena != a.ort_arena ||
+            b.ort_denormal_as_zero != a.ort_denormal_as_zero || b.ort_provider != a.ort_provider ||
+            b.ort_global_pools != a.ort_global_pools || b.pin_worker_threads != a.pin_worker_threads ||
+            b.capture_file != a.capture_file || b.bound_buffers != a.bound_buffers) {
+            return Status::Invalid("update_config: runtime cannot change (use reload)");
+        }
+
+        // In-flight async frames must not observe a half-applied update.
+        if (pipeline_) pipeline_->drain();
+        if (tiles_) tiles_->drain();
+
+        const CascadeOptions& was = cfg_.infer.cascade;
+        const CascadeOptions& now = cfg.infer.cascade;
+        const bool new_probe = now.enabled != was.enabled || now.probe_size != was.probe_size;
+
+        cfg_.infer = cfg.infer;
+        cfg_.verbose = cfg.verbose;
+        stream_.reset(); // cached tile detections were produced under the old thresholds
+        track_ = TrackState{};
+        reset_quality_(); // back to level 0 of the new options
+
+        if (!engine_) return Status::Invalid("update_config: engine not initialized");
+        const Status s = engine_->update_hot(cfg_);
+        if (!s.ok()) return s;
+        if (!new_probe) {
+            if (!probe_) return Status::Ok();
+            try {
+                return probe_->update_hot(probe_config_(cfg_));
+            } catch (const std::bad_alloc&) {
+                return Status::OutOfMemory("update_config: probe: bad_alloc");
+            }
+        }
+
+        const Status ps = create_probe_(cfg_, probe_);
+        if (!ps.ok() || !binding_ready_) return ps;
+        return bind_probe_(cfg_, probe_.get(), engine_->bound_contexts());
+    }
+
+    /**
+     * @brief Prepares bound I/O resources for a fixed input resolution and number of contexts.
+     *
+     * @param w Input width in pixels.
+     * @param h Input height in pixels.
+     * @param contexts Number of independent binding contexts (normalized to >= 1).
+     * @param max_batch Maximum images per bound run (normalized to >= 1).
+     * @return @ref idet::Status::Ok() on success, otherwise a non-OK status.
+     */
+    Status prepare_binding(int w, int h, int contexts, int max_batch) noexcept {
+        if (!engine_) return Status::Invalid("prepare_binding: engine not initialized");
+        if (w <= 0 || h <= 0) return Status::Invalid("prepare_binding: non-positive w/h");
+        if (contexts <= 0) contexts = 1;
+        if (max_batch <= 0) max_batch = 1;
+        if ((pipeline_ && pipeline_->in_flight() > 0) || (tiles_ && tiles_->in_flight() > 0))
+            return Status::Invalid("prepare_binding: async frames in flight (wait for them first)");
+
+        BindingPlan plan;
+        plan.w = w;
+        plan.h = h;
+        plan.contexts = contexts;
+        plan.max_batch = max_batch;
+
+        scratch_.clear();
+        const Status s = finish_binding_(engine_->setup_binding(w, h, contexts, max_batch), "prepare_binding");
+        return record_binding_(s, std::move(plan));
+    }
+
+    /**
+     * @brief Prepares a multi-resolution binding pool from representative frame sizes.
+     *
+     * @details
+     * Every size is mapped to the unbound engine input shape (@ref algo::aspect_fit32 with
+     * @c max_img_size); duplicates are dropped before the engine binds one bucket per shape.
+     */
+    Status prepare_binding_pool(const GridSpec* sizes, std::size_t count, int contexts, int max_batch) noexcept {
+        if (!engine_) return Status::Invalid("prepare_binding_pool: engine not initialized");
+        if (!sizes || count == 0) return Status::Invalid("prepare_binding_pool: no sizes");
+        if (contexts <= 0) contexts = 1;
+        if (max_batch <= 0) max_batch = 1;
+        if ((pipeline_ && pipeline_->in_flight() > 0) || (tiles_ && tiles_->in_flight() > 0))
+            return Status::Invalid("prepare_binding_pool: async frames in flight (wait for them first)");
+
+        BindingPlan plan;
+        std::vector<std::pair<int, int>> shapes;
+        try {
+            plan.pool = true;
+            plan.sizes.assign(sizes, sizes + count);
+            plan.contexts = contexts;
+            plan.max_batch = max_batch;
+            const Status s = pool_shapes_(plan, base_infer_(), shapes);
+            if (!s.ok()) return s;
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("prepare_binding_pool: bad_alloc");
+        }
+
+        scratch_.clear();
+        const Status s =
+            finish_binding_(engine_->setup_binding_pool(shapes, contexts, max_batch), "prepare_binding_pool");
+        return record_binding_(s, std::move(plan));
+    }
+
+    /**
+     * @brief Runs synthetic frames through every context ahead of traffic (see @ref Detector::warmup).
+     *
+     * @details
+     * Each frame is black BGR of one of the shapes. With a prepared binding every context runs it
+     * @p iterations times through its frame scratch and, for @c max_batch > 1, once more as a
+     * full batch, so every input slot, output buffer and both IoBindings have been used. The
+     * contexts warm up in parallel, which also grows the ORT arena to what concurrent calls
+     * need. Without a binding (or with tiling) the frames take the regular unbound path.
+     * The statistics are reset afterwards.
+     *
+     * @param shapes Frame sizes (cols = width); empty: the bound bucket shapes.
+     */
+    Status warmup(const GridSpec* shapes, std::size_t count, int iterations) noexcept {
+        if (!engine_) return Status::Invalid("warmup: engine not initialized");
+        if (iterations < 0) return Status::Invalid("warmup: negative iterations");
+        if (count > 0 && !shapes) return Status::Invalid("warmup: null shapes");
+        if ((pipeline_ && pipeline_->in_flight() > 0) || (tiles_ && tiles_->in_flight() > 0))
+            return Status::Invalid("warmup: async frames in flight (wait for them first)");
+
+        try {
+            std::vector<std::pair<int, int>> sizes;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (shapes[i].cols <= 0 || shapes[i].rows <= 0) return Status::Invalid("warmup: non-positive shape");
+                sizes.emplace_back(shapes[i].cols, shapes[i].rows);
+            }
+            if (count == 0) {
+                if (!binding_ready_) return Status::Invalid("warmup: no shapes and no binding prepared");
+                sizes = engine_->bucket_shapes();
+            }
+
+            const bool bound = binding_ready_ && !tiled_() && !scratch_.empty();
+            const int contexts = bound ? (int)scratch_.size() : 0;
+            const int batch = bound ? engine_->bound_batch() : 1;
+
+            std::vector<std::uint8_t> pixels;
+            for (const auto& [w, h] : sizes) {
+                pixels.assign((std::size_t)w * (std::size_t)h * 3, 0);
+                const Image frame = Image::wrap(PixelFormat::BGR_U8, w, h, pixels.data(), (std::size_t)w * 3);
+
+                if (!bound) {
+                    for (int it = 0; it < iterations; ++it) {
+                        auto r = run_dets_(frame, /*force_bound=*/false, -1, /*explicit_bound_call=*/false);
+                        if (!r.ok()) return r.status();
+                    }
+                    continue;
+                }
+
+                const cv::Mat bgr(h, w, CV_8UC3, pixels.data());
+                const std::vector<cv::Mat> slots((std::size_t)batch, bgr);
+                std::vector<Status> st((std::size_t)contexts, Status::Ok());
+                const int width = std::min(contexts, platform::ThreadPool::hardware_width());
+                platform::ThreadPool::current().parallel_for(contexts, width, [&](int ctx, int) {
+                    Status& cs = st[(std::size_t)ctx];
+                    for (int it = 0; it < iterations && cs.ok(); ++it)
+                        cs = run_bound_scratch_(frame, ctx, scratch_[(std::size_t)ctx]);
+                    if (cs.ok() && iterations > 0 && batch > 1) {
+                        auto r = engine_->infer_bound_batch(slots.data(), batch, ctx);
+                        if (!r.ok()) cs = r.status();
+                    }
+                });
+                for (const Status& cs : st) {
+                    if (!cs.ok()) return cs;
+                }
+            }
+            reset_stats();
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("warmup: bad_alloc");
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("warmup: ") + e.what());
+        }
+    }
+
+    /**
+     * @brief Replaces model and/or runtime policy without interrupting detection.
+     *
+     * @details
+     * Double-buffered: a new engine for @p cfg is created and, if binding was prepared, bound
+     * with the same request (so shape probing runs on the new model) while other threads keep
+     * detecting on the current one. Only then is the swap gate taken exclusively: in-flight calls
+     * and submitted frames drain on the old engine, the new engine, binding, scratch and
+     * configuration are moved in, and the gate is released. The old engine is destroyed after
+     * the gate is released; if completed async frames were not collected yet it stays behind as
+     * @ref Retired until @ref wait consumes them.
+     *
+     * Task and engine kind are fixed. Statistics, the stream cache and tile timings restart with
+     * the new engine. Process-wide state (ORT environment pools, worker pool pinning) keeps the
+     * settings of its first user.
+     *
+     * On failure the detector keeps running the old engine unchanged.
+     */
+    Status reload(const DetectorConfig& cfg) noexcept {
+        try {
+            std::lock_guard<std::mutex> serial(reload_mu_);
+
+            Generation g;
+            BindingPlan plan;
+            bool bound = false;
+            std::uint64_t epoch = 0;
+            {
+                const auto lk = shared_gate();
+                if (cfg.task != cfg_.task) return Status::Invalid("reload: task cannot change");
+                if (cfg.engine != cfg_.engine) return Status::Invalid("reload: engine cannot change");
+                bound = binding_ready_;
+                if (bound) plan = binding_;
+                epoch = binding_epoch_;
+            }
+
+            g.cfg = cfg;
+            const Status s = build_(bound ? &plan : nullptr, g);
+            if (!s.ok()) return s;
+            return commit_(g, epoch);
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("reload: bad_alloc");
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("reload: ") + e.what());
+        }
+    }
+
+    /**
+     * @brief Starts @ref reload on a background thread and returns immediately.
+     *
+     * @return Ok once the thread runs; Unavailable while a previous background reload is running.
+     */
+    Status reload_async(const DetectorConfig& cfg) noexcept {
+        try {
+            std::lock_guard<std::mutex> lk(async_mu_);
+            if (reload_busy_) return Status::Unavailable("reload_async: a reload is already running");
+            if (reload_thread_.joinable()) reload_thread_.join();
+
+            reload_busy_ = true;
+            try {
+                reload_thread_ = std::thread([this, cfg] {
+                    const Status s = reload(cfg);
+                    std::lock_guard<std::mutex> done(async_mu_);
+                    reload_result_ = s;
+                    reload_busy_ = false;
+                    reload_cv_.notify_all();
+                });
+            } catch (...) {
+                reload_busy_ = false;
+                throw;
+            }
+            reload_started_ = true;
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("reload_async: bad_alloc");
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("reload_async: cannot start thread: ") + e.what());
+        }
+    }
+
+    /// @brief Blocks until the background reload finishes and returns its outcome.
+    Status wait_reload() noexcept {
+        try {
+            std::unique_lock<std::mutex> lk(async_mu_);
+            if (!reload_started_) return Status::Invalid("wait_reload: no reload was started");
+            reload_cv_.wait(lk, [this] { return !reload_busy_; });
+            return reload_result_;
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("wait_reload: ") + e.what());
+        }
+    }
+
+    /// @brief Public entry point for unbound (or internally managed) inference.
+    Result<VecQuad> detect(const Image& img) noexcept {
+        return run_(img, /*force_bound=*/false, /*ctx=*/0, /*explicit_bound_call=*/false);
+    }
+
+    /**
+     * @brief Public entry point for bound inference using an explicit context index.
+     *
+     * @param img Input image.
+     * @param ctx Context index (must be >= 0).
+     * @return Result of detections or an error status.
+     */
+    Result<VecQuad> detect_bound(const Image& img, int ctx) noexcept {
+        if (ctx < 0) return Result<VecQuad>::Err(Status::Invalid("detect_bound: ctx < 0"));
+        return run_(img, /*force_bound=*/true, ctx, /*explicit_bound_call=*/true);
+    }
+
+    /// @brief Public entry point for structured results written into a caller-owned buffer.
+    Status detect_ex(const Image& img, VecDetection& out) noexcept {
+        return run_ex_(img, /*force_bound=*/false, /*ctx=*/0, /*explicit_bound_call=*/false, out);
+    }
+
+    /// @brief Bound variant of @ref detect_ex; allocation-free in steady state (see @ref run_into_).
+    Status detect_bound_ex(const Image& img, int ctx, VecDetection& out) noexcept {
+        if (ctx < 0) {
+            out.clear();
+            return Status::Invalid("detect_bound_ex: ctx < 0");
+        }
+        return run_ex_(img, /*force_bound=*/true, ctx, /*explicit_bound_call=*/true, out);
+    }
+
+    /**
+     * @brief Public entry point for streaming detection with per-tile change detection.
+     *
+     * @details
+     * Runs @ref algo::infer_tiled with @ref stream_ planned for this frame, so only dirty tiles
+     * reach the engine. On failure the cache is dropped: a partially updated cache must not
+     * leak stale detections into the next frame.
+     *
+     * Calls are serialized: the cache describes one stream, so concurrent callers take turns.
+     */
+    Status detect_stream(const Image& img, const MotionMask* mask, VecDetection& out) noexcept {
+        out.clear();
+        try {
+            std::lock_guard<std::mutex> lk(stream_mu_);
+            if (!engine_) return Status::Invalid("detect_stream: engine not initialized");
+            if (cfg_.infer.bind_io && !binding_ready_)
+                return Status::Invalid("detect_stream: bind_io enabled but binding not prepared");
+
+            auto bm_res = internal::BgrMat::from(Image(img));
+            if (!bm_res.ok()) return bm_res.status();
+            const cv::Mat& bgr = bm_res.value().mat();
+
+            cv::Mat mask_mat;
+            if (mask) {
+                if (!mask->data || mask->width != bgr.cols || mask->height != bgr.rows ||
+                    mask->stride_bytes < (std::size_t)mask->width)
+                    return Status::Invalid("detect_stream: motion mask must match the frame size");
+                mask_mat = cv::Mat(mask->height, mask->width, CV_8UC1, const_cast<std::uint8_t*>(mask->data),
+                                   mask->stride_bytes);
+            }
+
+            const StreamOptions& so = cfg_.infer.stream;
+            algo::TileChangeParams p;
+            p.pixel_diff = so.pixel_diff;
+            p.min_changed = so.tile_change;
+            p.sample_step = so.sample_step;
+            p.refresh_frames = so.refresh_frames;
+
+            const algo::TileLayout layout = tile_layout_();
+            const auto rects = algo::make_tiles(bgr.cols, bgr.rows, layout);
+            stream_.plan(bgr, rects, mask ? &mask_mat : nullptr, p);
+
+            const bool bound = cfg_.infer.bind_io && binding_ready_;
+            std::vector<TileTiming> timings;
+            auto r = algo::infer_tiled(*engine_, bgr, bound, /*ctx_idx=*/0, /*parallel_bound=*/bound, layout,
+                                       cfg_.runtime.tile_omp_threads, &timings, &stream_, contexts_.get(),
+                                       cfg_.infer.tile_batch);
+            store_timings_(std::move(timings));
+            if (!r.ok()) {
+                stream_.reset();
+                return r.status();
+            }
+
+            to_public_results_(postprocess_tiled_(std::move(r.value()), rects), out);
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            stream_.reset();
+            out.clear();
+            return Status::OutOfMemory("detect_stream: bad_alloc");
+        }
+    }
+
+    /// @brief Drops the streaming tile cache.
+    void reset_stream() noexcept {
+        std::lock_guard<std::mutex> lk(stream_mu_);
+        stream_.reset();
+    }
+
+    /**
+     * @brief Public entry point for tracking-assisted streaming detection (see @ref TrackOptions).
+     *
+     * @details
+     * Keyframes go through @ref run_into_ like @ref detect_ex; tracked frames run
+     * @ref verify_regions_ on the crops around the predicted tracks. The cost of both kinds is
+     * measured here and fed to @ref algo::adapt_interval with the budget of this stream. On
+     * failure the tracks are dropped, so the next frame is a keyframe.
+     *
+     * Calls are serialized: the tracks describe one stream, so concurrent callers take turns.
+     */
+    Status detect_track(const Image& img, VecDetection& out) noexcept {
+        out.clear();
+        try {
+            std::lock_guard<std::mutex> lk(track_mu_);
+            if (!engine_) return Status::Invalid("detect_track: engine not initialized");
+            if (cfg_.infer.bind_io && !binding_ready_)
+                return Status::Invalid("detect_track: bind_io enabled but binding not prepared");
+            const ImageView& v = img.view();
+            if (!v.is_valid()) return Status::Invalid("detect_track: invalid Image");
+
+            TrackState& ts = track_;
+            const TrackOptions& to = cfg_.infer.track;
+            const auto t0 = std::chrono::steady_clock::now();
+            if (ts.frames > 0) ts.period_ms = ema_(ts.period_ms, ms_between_(ts.last_call, t0));
+            ts.last_call = t0;
+
+            cv::Mat thumb;
+            scene_thumb_(v, thumb);
+            bool key = ts.frames == 0 || v.width != ts.frame_w || v.height != ts.frame_h ||
+                       ++ts.since_key >= ts.interval ||
+                       algo::changed_fraction(thumb, ts.thumb, cfg_.infer.stream.pixel_diff, 1) > to.scene_change;
+
+            algo::TrackParams tp;
+            tp.iou_match = to.iou_match;
+            tp.use_fast_iou = cfg_.infer.use_fast_iou;
+            tp.max_misses = to.max_misses;
+
+            ts.tracker.predict();
+            if (!key) {
+                algo::tracking_regions(ts.tracker.tracks(), v.width, v.height, to.verify_margin, ts.regions);
+                double area = 0.0;
+                for (const cv::Rect& r : ts.regions)
+                    area += (double)r.area();
+                key = area > (double)to.max_region_area * (double)v.width * (double)v.height;
+            }
+
+            Status s = key ? detect_keyframe_(img, ts.found) : verify_regions_(img, ts.regions, ts.found);
+            if (!s.ok()) {
+                track_ = TrackState{};
+                return s;
+            }
+            ts.tracker.update(ts.found, tp, key);
+            if (key) {
+                ts.thumb = thumb;
+                ts.frame_w = v.width;
+                ts.frame_h = v.height;
+                ts.since_key = 0;
+            }
+
+            const double ms = ms_between_(t0, std::chrono::steady_clock::now());
+            double& cost = key ? ts.key_ms : ts.track_ms;
+            cost = ema_(cost, ms);
+            double budget = to.target_ms > 0.0f ? (double)to.target_ms : 0.0;
+            if (to.cpu_share > 0.0f && ts.period_ms > 0.0) {
+                const double share = (double)to.cpu_share * ts.period_ms;
+                budget = budget > 0.0 ? std::min(budget, share) : share;
+            }
+            ts.interval = algo::adapt_interval(ts.key_ms, ts.track_ms, budget, to.keyframe_interval, to.max_interval);
+            ++ts.frames;
+
+            const std::vector<algo::Track>& tracks = ts.tracker.tracks();
+            ts.found.clear();
+            for (const algo::Track& t : tracks)
+                ts.found.push_back(t.det);
+            to_public_results_(ts.found, out);
+            for (std::size_t i = 0; i < out.size(); ++i)
+                out[i].track_id = tracks[i].id;
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            track_ = TrackState{};
+            out.clear();
+            return Status::OutOfMemory("detect_track: bad_alloc");
+        }
+    }
+
+    /// @brief Drops the tracks of @ref detect_track.
+    void reset_track() noexcept {
+        std::lock_guard<std::mutex> lk(track_mu_);
+        track_ = TrackState{};
+    }
+
+    /**
+     * @brief Public entry point for multi-image inference.
+     *
+     * @details
+     * With a prepared binding (and no tiling) images are processed in chunks of
+     * @ref idet::engine::IEngine::bound_batch on one checked-out context, i.e. one session run per
+     * chunk. Otherwise (or when the overflow policy falls back to unbound) every image goes through
+     * the regular @ref detect path.
+     *
+     * @param images Pointer to @p count input images.
+     * @param count Number of images.
+     * @return Per-image detections in input order, or an error status.
+     */
+    Result<std::vector<VecQuad>> detect_batch(const Image* images, std::size_t count) noexcept {
+        using R = Result<std::vector<VecQuad>>;
+
+        if (count == 0) return R::Ok(std::vector<VecQuad>{});
+        if (!images) return R::Err(Status::Invalid("detect_batch: null images"));
+
+        if (!engine_) return R::Err(Status::Invalid("detect_batch: engine not initialized"));
+
+        std::vector<VecQuad> out;
+        out.reserve(count);
+
+        // One checkout covers the whole batch; without a free context the overflow policy decides.
+        std::optional<engine::ContextPool::Lease> lease;
+        int ctx = -1;
+        if (auto_bound_()) {
+            const Status cs = checkout_(lease, ctx);
+            if (!cs.ok()) return R::Err(cs);
+        }
+
+        if (ctx < 0) {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto r = detect(images[i]);
+                if (!r.ok()) return R::Err(r.status());
+                out.push_back(std::move(r.value()));
+            }
+            return R::Ok(std::move(out));
+        }
+
+        const std::size_t chunk = (std::size_t)std::max(1, engine_->bound_batch());
+
+        std::vector<internal::BgrMat> holders;
+        std::vector<cv::Mat> mats;
+        holders.reserve(std::min(chunk, count));
+        mats.reserve(std::min(chunk, count));
+
+        for (std::size_t first = 0; first < count; first += chunk) {
+            const std::size_t n = std::min(chunk, count - first);
+
+            holders.clear();
+            mats.clear();
+            for (std::size_t i = 0; i < n; ++i) {
+                auto bm_res = internal::BgrMat::from(Image(images[first + i]));
+                if (!bm_res.ok()) return R::Err(bm_res.status());
+                holders.push_back(std::move(bm_res.value()));
+                mats.push_back(holders.back().mat());
+            }
+
+            auto r = engine_->infer_bound_batch(mats.data(), (int)n, ctx);
+            if (!r.ok()) return R::Err(r.status());
+
+            for (auto& dets : r.value())
+                out.push_back(finalize_(std::move(dets)));
+        }
+
+        return R::Ok(std::move(out));
+    }
+
+    /**
+     * @brief Crop-and-detect over @p count regions of one frame (see @ref Detector::detect_rois).
+     *
+     * @details
+     * Crops are zero-copy sub-views (@ref crop_view_). With a prepared binding one context is
+     * checked out for the whole call and the crops are resized straight into the slots of its
+     * batched input tensor, @ref engine::IEngine::bound_batch of them per session run
+     * (@ref engine::IEngine::infer_sources_batch). Otherwise, or when the overflow policy falls
+     * back to unbound, every crop runs unbound as in @ref verify_regions_. Each crop is
+     * postprocessed on its own, then offset into frame coordinates like a tile.
+     */
+    Status detect_rois(const Image& img, const Rect* rois, std::size_t count, std::vector<VecDetection>& out) noexcept {
+        out.clear();
+        if (count == 0) return Status::Ok();
+        if (!rois) return Status::Invalid("detect_rois: null rois");
+        if (!engine_) return Status::Invalid("detect_rois: engine not initialized");
+        const ImageView& v = img.view();
+        if (!v.is_valid()) return Status::Invalid("detect_rois: invalid Image");
+
+        try {
+            out.resize(count);
+            std::vector<cv::Rect> rects(count);
+            for (std::size_t i = 0; i < count; ++i)
+                rects[i] = clip_roi_(v, rois[i]);
+
+            std::optional<engine::ContextPool::Lease> lease;
+            int ctx = -1;
+            if (cfg_.infer.bind_io && binding_ready_ && contexts_) {
+                const Status cs = checkout_(lease, ctx);
+                if (!cs.ok()) return fail_rois_(out, cs);
+            }
+
+            // Maps the detections of crop i into the frame, postprocesses and publishes them.
+            algo::DetectionBuffer buf;
+            algo::NmsWorkspace ws;
+            std::vector<algo::Detection> kept;
+            auto emit = [&](std::size_t i, const std::vector<algo::Detection>& dets) {
+                buf.assign(dets);
+                buf.offset(0, float(rects[i].x), float(rects[i].y), (int)i);
+                postprocess_buffer_(buf, ws, 0, kept);
+                to_public_results_(kept, out[i]);
+            };
+
+            if (ctx < 0) {
+                std::vector<algo::Detection> local;
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (rects[i].empty()) continue;
+                    const Image crop = Image::view(crop_view_(v, rects[i]));
+                    local.clear();
+                    Status s = try_direct_(*engine_, crop, -1, local);
+                    if (s.code == Status::Code::Unsupported) {
+                        auto bm_res = internal::BgrMat::from(crop);
+                        if (!bm_res.ok()) return fail_rois_(out, bm_res.status());
+                        auto rs = run_single_(bm_res.value().mat(), false, -1);
+                        if (!rs.ok()) return fail_rois_(out, rs.status());
+                        local = std::move(rs.value());
+                        s = Status::Ok();
+                    }
+                    if (!s.ok()) return fail_rois_(out, s);
+                    emit(i, local);
+                }
+                return Status::Ok();
+            }
+
+            algo::ChannelOrder order = algo::ChannelOrder::BGR;
+            if (!v.is_yuv() && !internal::packed_channel_order(v.format, order))
+                return fail_rois_(out, Status::Unsupported("detect_rois: unknown PixelFormat"));
+            const int type = algo::channel_count(order) == 4 ? CV_8UC4 : CV_8UC3;
+
+            // Sources point into these per-slot descriptors, which are sized once and not reallocated.
+            const std::size_t chunk = (std::size_t)std::max(1, engine_->bound_batch());
+            std::vector<cv::Mat> mats(chunk);
+            std::vector<algo::Yuv420Planes> planes(chunk);
+            std::vector<algo::ChwSource> src(chunk);
+            std::vector<std::size_t> slot_roi(chunk);
+            std::vector<internal::BgrMat> holders;
+
+            std::size_t next = 0;
+            while (next < count) {
+                std::size_t n = 0;
+                for (; next < count && n < chunk; ++next) {
+                    if (rects[next].empty()) continue;
+                    const ImageView c = crop_view_(v, rects[next]);
+                    if (v.is_yuv()) {
+                        planes[n] = internal::yuv420_planes(c);
+                        src[n] = algo::ChwSource::of(planes[n]);
+                    } else {
+                        // Read-only view into the caller's pixels.
+                        mats[n] = cv::Mat(c.height, c.width, type, const_cast<std::uint8_t*>(c.data), c.stride_bytes);
+                        src[n] = algo::ChwSource::of(mats[n], order);
+                    }
+                    slot_roi[n++] = next;
+                }
+                if (n == 0) break;
+
+                auto r = engine_->infer_sources_batch(src.data(), (int)n, ctx);
+                if (!r.ok() && r.status().code == Status::Code::Unsupported) {
+                    // The engine needs BGR frames: convert the crops of this chunk.
+                    holders.clear();
+                    for (std::size_t j = 0; j < n; ++j) {
+                        auto bm_res = internal::BgrMat::from(Image::view(crop_view_(v, rects[slot_roi[j]])));
+                        if (!bm_res.ok()) return fail_rois_(out, bm_res.status());
+                        holders.push_back(std::move(bm_res.value()));
+                        mats[j] = holders.back().mat();
+                    }
+                    r = engine_->infer_bound_batch(mats.data(), (int)n, ctx);
+                }
+                if (!r.ok()) return fail_rois_(out, r.status());
+                for (std::size_t j = 0; j < n; ++j)
+                    emit(slot_roi[j], r.value()[j]);
+            }
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            return fail_rois_(out, Status::OutOfMemory("detect_rois: bad_alloc"));
+        } catch (const std::exception& e) {
+            return fail_rois_(out, Status::Internal(std::string("detect_rois: ") + e.what()));
+        }
+    }
+
+    /// @brief Error exit of @ref detect_rois: drops partial results.
+    static Status fail_rois_(std::vector<VecDetection>& out, Status s) noexcept {
+        out.clear();
+        return s;
+    }
+
+    /**
+     * @brief Enqueues a frame into the asynchronous pipeline (created on first use).
+     *
+     * @param img Input image (non-owning views must outlive the returned ticket's completion).
+     * @return Ticket for @ref poll / @ref wait, or an error status.
+     */
+    Result<Ticket> submit(const Image& img) noexcept {
+        std::unique_lock<std::mutex> bk(backend_mu_);
+        const Status s = ensure_pipeline_();
+        if (!s.ok()) return Result<Ticket>::Err(s);
+        const PinnedBackend b(*this);
+        bk.unlock();
+
+        // The backend allocates the ticket; it may block here on backpressure.
+        Result<Ticket> r = b.tiles ? b.tiles->submit(img, tile_layout_()) : b.pipeline->submit(img);
+        const std::size_t queued = b.tiles ? b.tiles->in_flight() : b.pipeline->in_flight();
+        if (r.ok()) quality_observe_(-1.0, context_queue_() + (int)queued);
+        return r;
+    }
+
+    /// @brief Returns true if the frame identified by @p t has completed.
+    bool poll(Ticket t) const noexcept {
+        {
+            std::lock_guard<std::mutex> rk(retired_mu_);
+            if (retired_.engine && t < retired_.end)
+                return retired_.tiles ? retired_.tiles->ready(t) : retired_.pipeline->ready(t);
+        }
+        std::unique_lock<std::mutex> bk(backend_mu_);
+        const PinnedBackend b(*this);
+        bk.unlock();
+        if (b.tiles) return b.tiles->ready(t);
+        return b.pipeline && b.pipeline->ready(t);
+    }
+
+    /**
+     * @brief Blocks until the frame identified by @p t completes and returns its detections.
+     *
+     * @details
+     * For tiled frames, min-size filtering and NMS run here on the caller's thread and the
+     * frame's tile timings become the ones reported by @ref last_tile_timings.
+     */
+    Result<VecQuad> wait(Ticket t) noexcept {
+        {
+            std::unique_lock<std::mutex> rk(retired_mu_);
+            if (retired_.engine && t < retired_.end) return wait_retired_(t, rk);
+        }
+        std::unique_lock<std::mutex> bk(backend_mu_);
+        const PinnedBackend b(*this);
+        bk.unlock();
+        if (b.tiles) {
+            auto r = b.tiles->wait(t);
+            if (!r.ok()) return Result<VecQuad>::Err(r.status());
+            store_timings_(std::move(r.value().timings));
+            auto& fr = r.value();
+            return Result<VecQuad>::Ok(to_public_quads_(postprocess_tiled_(std::move(fr.dets), fr.rects)));
+        }
+        if (!b.pipeline) return Result<VecQuad>::Err(Status::Invalid("wait: no frames were submitted"));
+        return b.pipeline->wait(t);
+    }
+
+    /// @brief Copies the per-tile timings of the most recent tiled frame into @p out.
+    Status last_tile_timings(std::vector<TileTiming>& out) const noexcept {
+        try {
+            std::lock_guard<std::mutex> lk(timings_mu_);
+            out = tile_timings_;
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            out.clear();
+            return Status::OutOfMemory("last_tile_timings: bad_alloc");
+        }
+    }
+
+    /// @brief Snapshot of the stage statistics (Unsupported when compiled out).
+    Status stats(DetectorStats& out) const noexcept {
+        out = DetectorStats{};
+#if IDET_WITH_STATS
+        if (!engine_) return Status::Invalid("stats: engine not initialized");
+        engine_->stats().snapshot(out);
+        out.quality_level = quality_level_.load(std::memory_order_relaxed);
+        return Status::Ok();
+#else
+        return Status::Unsupported("stats: built without the idet_stats option");
+#endif
+    }
+
+    /// @brief Zeroes the stage statistics.
+    void reset_stats() noexcept {
+#if IDET_WITH_STATS
+        if (engine_) engine_->stats().reset();
+#endif
+    }
+
+    /// @brief Stops ORT profiling of the engine session and returns the trace path.
+    Result<std::string> end_profiling() noexcept {
+        if (!engine_) return Result<std::string>::Err(Status::Invalid("end_profiling: engine not initialized"));
+        return engine_->end_profiling();
+    }
+
+  private:
+    /**
+     * @brief Validates @p cfg and creates its engine into @p out.
+     *
+     * @note Engine creation is delegated to @ref idet::engine::create_engine.
+     */
+    static Status create_engine_(const DetectorConfig& cfg, std::unique_ptr<engine::IEngine>& out) noexcept {
+        const Status s = cfg.validate();
+        if (!s.ok()) return s;
+
+        auto r = engine::create_engine(cfg);
+        if (!r.ok()) return r.status();
+        if (!r.value()) return Status::Internal("DetectorImpl: create_engine returned null");
+
+        // After the engine, so that global ORT pools (if any) already hold their CPUs.
+        try {
+            prepare_worker_pool_(cfg.runtime);
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("DetectorImpl: worker pool: bad_alloc");
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("DetectorImpl: worker pool: ") + e.what());
+        }
+
+        out = std::move(r.value());
+        return Status::Ok();
+    }
+
+    /**
+     * @brief Configuration of the cascade probe engine.
+     *
+     * @details
+     * Same model and runtime as @p cfg (so the session is shared), untiled, unbound by config,
+     * at @ref CascadeOptions::probe_size with the thresholds lowered to @ref CascadeOptions::trigger.
+     * Contours are scored by their box: the probe only needs to know whether anything is there.
+     *
+     * @throws std::bad_alloc On allocation failure.
+     */
+    static DetectorConfig probe_config_(const DetectorConfig& cfg) {
+        DetectorConfig pc = cfg;
+        InferenceOptions& io = pc.infer;
+        const CascadeOptions& c = cfg.infer.cascade;
+        io.max_img_size = c.probe_size;
+        io.fixed_input_dim = GridSpec{0, 0};
+        io.bind_io = false;
+        io.bind_buckets.clear();
+        io.tiles_dim = GridSpec{1, 1};
+        io.tile_mode = TileMode::Grid;
+        io.box_thresh = c.trigger;
+        io.bin_thresh = std::min(io.bin_thresh, c.trigger);
+        io.score_mode = ScoreMode::Box;
+        io.min_roi_size_w = 0;
+        io.min_roi_size_h = 0;
+        io.cascade.enabled = false;
+        pc.runtime.share_session = true;
+        pc.runtime.profile_prefix.clear();
+        pc.runtime.capture_file.clear(); // a capture holds the full-resolution frames only
+        return pc;
+    }
+
+    /// @brief Creates the cascade probe of @p cfg into @p out (reset when the cascade is disabled).
+    static Status create_probe_(const DetectorConfig& cfg, std::unique_ptr<engine::IEngine>& out) noexcept {
+        out.reset();
+        if (!cfg.infer.cascade.enabled) return Status::Ok();
+        try {
+            auto r = engine::create_engine(probe_config_(cfg));
+            if (!r.ok()) return r.status();
+            if (!r.value()) return Status::Internal("DetectorImpl: probe: create_engine returned null");
+            out = std::move(r.value());
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("DetectorImpl: probe: bad_alloc");
+        }
+    }
+
+    /**
+     * @brief Creates the engine and the cascade probe of @p cfg, building the probe session on a
+     *        second thread meanwhile (serially if the thread cannot start).
+     */
+    static Status create_engines_(const DetectorConfig& cfg, std::unique_ptr<engine::IEngine>& eng,
+                                  std::unique_ptr<engine::IEngine>& probe) noexcept {
+        if (!cfg.infer.cascade.enabled) {
+            probe.reset();
+            return create_engine_(cfg, eng);
+        }
+
+        Status ps = Status::Ok();
+        std::thread t;
+        try {
+            t = std::thread([&] { ps = create_probe_(cfg, probe); });
+        } catch (const std::exception&) {
+        }
+        const Status s = create_engine_(cfg, eng);
+        if (t.joinable())
+            t.join();
+        else
+            ps = create_probe_(cfg, probe);
+        return s.ok() ? ps : s;
+    }
+
+    /**
+     * @brief Binds @p probe to one letterboxed @ref CascadeOptions::probe_size square per main context.
+     *
+     * @details
+     * Context @c k of the probe belongs to context @c k of the main engine, so a call that checked
+     * out a main context also owns the matching probe context.
+     */
+    static Status bind_probe_(const DetectorConfig& cfg, engine::IEngine* probe, int contexts) noexcept {
+        if (!probe) return Status::Ok();
+        try {
+            const int side = cfg.infer.cascade.probe_size;
+            return probe->setup_binding_pool({{side, side}}, std::max(1, contexts), 1);
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("DetectorImpl: probe binding: bad_alloc");
+        }
+    }
+
+    /**
+     * @brief Maps the representative sizes of a pool plan to distinct engine input shapes.
+     *
+     * @details
+     * Every size is mapped to the unbound engine input shape (@ref algo::aspect_fit32 with
+     * @c max_img_size of @p io); duplicates are dropped.
+     *
+     * With quality control, every reduced level adds the shape holding the size scaled to the
+     * level's @c max_img_size, rounded up to 32: @ref algo::pick_bucket then finds the whole scaled
+     * frame in it and prefers it over the larger buckets.
+     *
+     * @throws std::bad_alloc On allocation failure.
+     */
+    static Status pool_shapes_(const BindingPlan& plan, const InferenceOptions& io,
+                               std::vector<std::pair<int, int>>& shapes) {
+        const std::vector<QualityLevel> levels = quality_levels_of_(io);
+        shapes.clear();
+        shapes.reserve(plan.sizes.size() * levels.size());
+        auto add = [&](std::pair<int, int> sh) {
+            if (std::find(shapes.begin(), shapes.end(), sh) == shapes.end()) shapes.push_back(sh);
+        };
+        for (const GridSpec& g : plan.sizes) {
+            if (g.rows <= 0 || g.cols <= 0) return Status::Invalid("prepare_binding_pool: non-positive size");
+            add(algo::aspect_fit32(g.cols, g.rows, io.max_img_size));
+            for (std::size_t i = 1; i < levels.size(); ++i) {
+                const int side = levels[i].max_img_size;
+                const int m = std::max(g.cols, g.rows);
+                if (side <= 0 || side >= m) continue;
+                auto up32 = [&](int v) { return (int)(((long long)v * side + m - 1) / m + 31) & ~31; };
+                add({up32(g.cols), up32(g.rows)});
+            }
+        }
+        return Status::Ok();
+    }
+
+    /// @brief Remembers @p plan for @ref reload after a successful binding call.
+    Status record_binding_(const Status& s, BindingPlan plan) noexcept {
+        ++binding_epoch_;
+        if (s.ok()) binding_ = std::move(plan);
+        return s;
+    }
+
+    /**
+     * @brief Creates the engine of @p g and, given a @p plan, binds it the same way as the current one.
+     *
+     * @details
+     * Touches no detector state, so it runs while other threads detect.
+     */
+    static Status build_(const BindingPlan* plan, Generation& g) noexcept {
+        Status s = create_engines_(g.cfg, g.engine, g.probe);
+        if (!s.ok() || !plan) return s;
+
+        try {
+            if (plan->pool) {
+                std::vector<std::pair<int, int>> shapes;
+                s = pool_shapes_(*plan, g.cfg.infer, shapes);
+                if (s.ok()) s = g.engine->setup_binding_pool(shapes, plan->contexts, plan->max_batch);
+            } else {
+                s = g.engine->setup_binding(plan->w, plan->h, plan->contexts, plan->max_batch);
+            }
+            if (s.ok()) s = bind_probe_(g.cfg, g.probe.get(), g.engine->bound_contexts());
+            if (!s.ok()) return s;
+
+            g.scratch.resize((std::size_t)g.engine->bound_contexts());
+            g.contexts = std::make_unique<engine::ContextPool>(g.engine->bound_contexts());
+            g.binding_ready = true;
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("reload: binding: bad_alloc");
+        }
+    }
+
+    /**
+     * @brief Swaps @p g in once in-flight calls and submitted frames have drained.
+     *
+     * @param epoch Binding epoch @p g was built for; a binding prepared meanwhile wins.
+     */
+    Status commit_(Generation& g, std::uint64_t epoch) {
+        // Released after the gate, in reverse order: async backends before the engine they drive.
+        std::unique_ptr<engine::IEngine> old_probe;
+        std::unique_ptr<engine::IEngine> old_engine;
+        std::unique_ptr<pipeline::AsyncPipeline> old_pipeline;
+        std::unique_ptr<pipeline::TileScheduler> old_tiles;
+
+        const auto lk = exclusive_gate();
+        if (epoch != binding_epoch_) return Status::Invalid("reload: binding changed while reloading (reload again)");
+
+        if (pipeline_) pipeline_->drain();
+        if (tiles_) tiles_->drain();
+        const bool uncollected = (pipeline_ && !pipeline_->idle()) || (tiles_ && !tiles_->idle());
+        {
+            std::lock_guard<std::mutex> rk(retired_mu_);
+            if (uncollected && retired_.engine)
+                return Status::Invalid("reload: frames of the previous model are not collected yet (wait() first)");
+
+            note_tickets_();
+            if (uncollected) {
+                retired_.engine = std::move(engine_);
+                retired_.pipeline = std::move(pipeline_);
+                retired_.tiles = std::move(tiles_);
+                retired_.end = next_ticket_;
+            } else {
+                old_engine = std::move(engine_);
+                old_pipeline = std::move(pipeline_);
+                old_tiles = std::move(tiles_);
+            }
+        }
+
+        engine_ = std::move(g.engine);
+        old_probe = std::move(probe_);
+        probe_ = std::move(g.probe);
+        cfg_ = std::move(g.cfg);
+        binding_ready_ = g.binding_ready;
+        scratch_.swap(g.scratch);
+        contexts_ = std::move(g.contexts);
+        stream_.reset();
+        track_ = TrackState{};
+        tile_timings_.clear();
+        reset_quality_();
+        return Status::Ok();
+    }
+
+    /// @brief Advances @ref next_ticket_ past every ticket issued by the current async backends.
+    void note_tickets_() noexcept {
+        if (pipeline_) next_ticket_ = std::max(next_ticket_, pipeline_->next_ticket());
+        if (tiles_) next_ticket_ = std::max(next_ticket_, tiles_->next_ticket());
+    }
+
+    /**
+     * @brief Async backends seen by one @ref submit / @ref poll / @ref wait call.
+     *
+     * @details
+     * Taken under @ref backend_mu_; while it exists, @ref ensure_pipeline_ does not replace the
+     * backends, so the call can use them after releasing the mutex (a @ref wait may block).
+     */
+    class PinnedBackend final {
+      public:
+        explicit PinnedBackend(const DetectorImpl& d) noexcept
+            : pipeline(d.pipeline_.get()), tiles(d.tiles_.get()), users_(d.backend_users_) {
+            users_.fetch_add(1, std::memory_order_relaxed);
+        }
+        ~PinnedBackend() {
+            users_.fetch_sub(1, std::memory_order_release);
+        }
+        PinnedBackend(const PinnedBackend&) = delete;
+        PinnedBackend& operator=(const PinnedBackend&) = delete;
+
+        pipeline::AsyncPipeline* const pipeline;
+        pipeline::TileScheduler* const tiles;
+
+      private:
+        std::atomic<int>& users_;
+    };
+
+    /// @brief True if backend @p b has frames to collect or is pinned by a call (see @ref PinnedBackend).
+    template <class Backend> bool busy_(const std::unique_ptr<Backend>& b) const noexcept {
+        return b && (!b->idle() || backend_users_.load(std::memory_order_acquire) > 0);
+    }
+
+    /// @brief Destroys async backend @p b, keeping its tickets from being issued again.
+    template <class Backend> void release_backend_(std::unique_ptr<Backend>& b) noexcept {
+        if (!b) return;
+        next_ticket_ = std::max(next_ticket_, b->next_ticket());
+        b.reset();
+    }
+
+    /**
+     * @brief @ref wait for a ticket of the retired backend; releases it once all its frames are collected.
+     *
+     * @param rk Lock of @ref retired_mu_, held on entry.
+     */
+    Result<VecQuad> wait_retired_(Ticket t, std::unique_lock<std::mutex>& rk) {
+        Retired done;
+        Result<VecQuad> out = Result<VecQuad>::Err(Status::Internal("wait: no result"));
+        Result<pipeline::TileScheduler::FrameResult> fr =
+            Result<pipeline::TileScheduler::FrameResult>::Err(Status::Internal("wait: no result"));
+
+        // The retired frames completed before the swap, so neither wait blocks.
+        const bool tiled = retired_.tiles != nullptr;
+        if (tiled)
+            fr = retired_.tiles->wait(t);
+        else
+            out = retired_.pipeline->wait(t);
+        if (tiled ? retired_.tiles->idle() : retired_.pipeline->idle()) done = std::move(retired_);
+        rk.unlock();
+
+        if (!tiled) return out;
+        if (!fr.ok()) return Result<VecQuad>::Err(fr.status());
+        store_timings_(std::move(fr.value().timings));
+        return Result<VecQuad>::Ok(to_public_quads_(postprocess_tiled_(std::move(fr.value().dets), fr.value().rects)));
+    }
+
+    /**
+     * @brief Records the outcome of an engine binding call and sizes the per-context scratch and checkout pool.
+     *
+     * @param s Status returned by the engine.
+     * @param who Caller name used in error messages.
+     */
+    Status finish_binding_(const Status& s, const char* who) noexcept {
+        binding_ready_ = s.ok();
+        contexts_.reset();
+        if (!binding_ready_) {
+            if (probe_) probe_->unset_binding();
+            return s;
+        }
+
+        const Status ps = bind_probe_(cfg_, probe_.get(), engine_->bound_contexts());
+        if (!ps.ok()) {
+            engine_->unset_binding();
+            binding_ready_ = false;
+            return ps;
+        }
+        try {
+            scratch_.resize((std::size_t)engine_->bound_contexts());
+            contexts_ = std::make_unique<engine::ContextPool>(engine_->bound_contexts());
+        } catch (const std::bad_alloc&) {
+            engine_->unset_binding();
+            if (probe_) probe_->unset_binding();
+            binding_ready_ = false;
+            return Status::OutOfMemory(std::string(who) + ": bad_alloc");
+        }
+        return s;
+    }
+
+    /**
+     * @brief Creates (or re-creates) the async pipeline to match the current configuration.
+     *
+     * @details
+     * Tiled configurations use a @ref idet::pipeline::TileScheduler with @c tile_omp_threads
+     * workers, so tiles of consecutive frames interleave. Otherwise, staged mode is used when bound
+     * I/O is prepared and the engine supports stage calls; the pipeline depth then equals the
+     * number of bound contexts. Anything else gets a fallback pipeline running @ref detect per
+     * frame. A backend whose mode no longer matches is replaced only once it has no pending or
+     * uncollected frames and no call pins it. Called with @ref backend_mu_ held.
+     */
+    Status ensure_pipeline_() {
+        if (!engine_) return Status::Invalid("submit: engine not initialized");
+
+        const bool tiled = tiled_();
+        if (tiled) return ensure_tile_scheduler_();
+        if (busy_(tiles_))
+            return Status::Invalid("submit: configuration changed; wait() for pending tickets first");
+        release_backend_(tiles_);
+
+        const bool staged = binding_ready_ && !tiled && engine_->supports_stages();
+        const int depth = staged ? std::max(1, engine_->bound_contexts()) : kFallbackPipelineDepth;
+
+        if (pipeline_ && pipeline_->staged() == staged && pipeline_->depth() == depth) return Status::Ok();
+        if (busy_(pipeline_))
+            return Status::Invalid("submit: configuration changed; wait() for pending tickets first");
+
+        release_backend_(pipeline_);
+        try {
+            pipeline_ = std::make_unique<pipeline::AsyncPipeline>(
+                *engine_, staged, depth, [this](std::vector<algo::Detection> d) { return finalize_(std::move(d)); },
+                [this](const Image& img) { return detect(img); }, next_ticket_);
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("submit: cannot create pipeline (bad_alloc)");
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("submit: cannot create pipeline: ") + e.what());
+        }
+        return Status::Ok();
+    }
+
+    /// @brief Creates (or re-creates) the tile scheduler used by @ref submit for tiled configurations.
+    Status ensure_tile_scheduler_() {
+        if (cfg_.infer.bind_io && !binding_ready_)
+            return Status::Invalid("submit: bind_io enabled but binding not prepared");
+
+        const bool bound = cfg_.infer.bind_io && binding_ready_;
+        const int contexts = bound ? engine_->bound_contexts() : 0;
+        const int workers = std::max(1, cfg_.runtime.tile_omp_threads);
+
+        if (busy_(pipeline_))
+            return Status::Invalid("submit: configuration changed; wait() for pending tickets first");
+        release_backend_(pipeline_);
+
+        if (tiles_ && tiles_->bound() == bound && tiles_->contexts() == contexts && tiles_->workers() == workers)
+            return Status::Ok();
+        if (busy_(tiles_))
+            return Status::Invalid("submit: configuration changed; wait() for pending tickets first");
+
+        release_backend_(tiles_);
+        try {
+            tiles_ = std::make_unique<pipeline::TileScheduler>(*engine_, bound, workers, kTiledPipelineDepth,
+                                                                next_ticket_);
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("submit: cannot create tile scheduler (bad_alloc)");
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("submit: cannot create tile scheduler: ") + e.what());
+        }
+        return Status::Ok();
+    }
+
+    /**
+     * @brief Executes the end-to-end pipeline and returns public quadrilateral results.
+     *
+     * @details
+     * Steps:
+     *  1) Ensure engine is initialized.
+     *  2) Convert input image to BGR `cv::Mat`.
+     *  3) Decide single vs tiled execution.
+     *  4) Enforce binding requirements for bound inference.
+     *  5) Run inference (single or tiled).
+     *  6) Apply common postprocessing:
+     *     - min-size filtering
+     *     - NMS (or score sort if NMS disabled)
+     */
+    Result<VecQuad> run_(const Image& img, bool force_bound, int ctx, bool explicit_bound_call) noexcept {
+        const auto t0 = std::chrono::steady_clock::now();
+        std::optional<engine::ContextPool::Lease> lease;
+        if (!explicit_bound_call && auto_bound_()) {
+            const Status cs = checkout_(lease, ctx);
+            if (!cs.ok()) return Result<VecQuad>::Err(cs);
+        }
+
+        std::vector<algo::Detection> local;
+        const std::vector<algo::Detection>* dets = nullptr;
+        const Status s = run_into_(img, force_bound, ctx, explicit_bound_call, local, dets);
+        if (!s.ok()) return Result<VecQuad>::Err(s);
+        quality_observe_(ms_between_(t0, std::chrono::steady_clock::now()), context_queue_());
+        return Result<VecQuad>::Ok(to_public_quads_(*dets));
+    }
+
+    /// @brief Shared body of @ref detect_ex / @ref detect_bound_ex.
+    Status run_ex_(const Image& img, bool force_bound, int ctx, bool explicit_bound_call, VecDetection& out) noexcept {
+        out.clear();
+        try {
+            const auto t0 = std::chrono::steady_clock::now();
+            // Held until the results left the context's scratch.
+            std::optional<engine::ContextPool::Lease> lease;
+            if (!explicit_bound_call && auto_bound_()) {
+                const Status cs = checkout_(lease, ctx);
+                if (!cs.ok()) return cs;
+            }
+
+            std::vector<algo::Detection> local;
+            const std::vector<algo::Detection>* dets = nullptr;
+            const Status s = run_into_(img, force_bound, ctx, explicit_bound_call, local, dets);
+            if (!s.ok()) return s;
+            to_public_results_(*dets, out);
+            quality_observe_(ms_between_(t0, std::chrono::steady_clock::now()), context_queue_());
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            out.clear();
+            return Status::OutOfMemory("detect_ex: bad_alloc");
+        }
+    }
+
+    /**
+     * @brief Runs detection and points @p result at the postprocessed detections.
+     *
+     * @details
+     * Bound, non-tiled calls on a prepared context use that context's @ref FrameScratch:
+     * color conversion, engine decoding, min-size filtering and NMS all reuse per-context buffers
+     * and the per-frame arena, so once warm they do not touch the heap. @p result then points into
+     * the scratch and stays valid until the next call on the same context.
+     * Every other path stores its result in @p local.
+     *
+     * A negative @p ctx (overflow fallback of @ref checkout_) runs unbound despite a prepared binding.
+     *
+     * With the cascade enabled, @ref probe_frame_ runs first: empty frames end here, and frames
+     * whose triggered region is small enough run the full pass on that region only.
+     */
+    Status run_into_(const Image& img, bool force_bound, int ctx, bool explicit_bound_call,
+                     std::vector<algo::Detection>& local, const std::vector<algo::Detection>*& result) noexcept {
+        if (!probe_) return run_full_(img, force_bound, ctx, explicit_bound_call, local, result);
+
+        const bool want_bound = ctx >= 0 && (force_bound || (cfg_.infer.bind_io && binding_ready_));
+        bool hit = false;
+        cv::Rect roi;
+        const Status ps = probe_frame_(img, want_bound ? ctx : -1, hit, roi);
+        if (!ps.ok()) return ps;
+        record_cascade_(!hit, hit && !roi.empty());
+
+        if (!hit) {
+            local.clear();
+            result = &local;
+            return Status::Ok();
+        }
+        if (roi.empty()) return run_full_(img, force_bound, ctx, explicit_bound_call, local, result);
+
+        const Image crop = Image::view(crop_view_(img.view(), roi));
+        const std::vector<algo::Detection>* dets = nullptr;
+        const Status s = run_full_(crop, force_bound, ctx, explicit_bound_call, local, dets);
+        if (!s.ok()) return s;
+        try {
+            if (dets != &local) local.assign(dets->begin(), dets->end());
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("detect: cascade: bad_alloc");
+        }
+        for (algo::Detection& d : local)
+            algo::offset_detection(d, roi.x, roi.y, d.tile);
+        result = &local;
+        return Status::Ok();
+    }
+
+    /// @brief Full (non-cascade) pass of @ref run_into_.
+    Status run_full_(const Image& img, bool force_bound, int ctx, bool explicit_bound_call,
+                     std::vector<algo::Detection>& local, const std::vector<algo::Detection>*& result) noexcept {
+        const bool tiled = tiled_();
+        const bool want_bound = ctx >= 0 && (force_bound || (cfg_.infer.bind_io && binding_ready_));
+
+        if (engine_ && want_bound && binding_ready_ && !tiled && ctx >= 0 && (std::size_t)ctx < scratch_.size()) {
+            FrameScratch& fs = scratch_[(std::size_t)ctx];
+            const Status s = run_bound_scratch_(img, ctx, fs);
+            if (!s.ok()) return s;
+            result = &fs.kept;
+            return Status::Ok();
+        }
+
+        auto r = run_dets_(img, force_bound, ctx, explicit_bound_call);
+        if (!r.ok()) return r.status();
+        local = std::move(r.value());
+        result = &local;
+        return Status::Ok();
+    }
+
+    /// @brief Keyframe of @ref detect_track: the regular detection path, results copied into @p out.
+    Status detect_keyframe_(const Image& img, std::vector<algo::Detection>& out) noexcept {
+        std::optional<engine::ContextPool::Lease> lease;
+        int ctx = 0;
+        if (auto_bound_()) {
+            const Status cs = checkout_(lease, ctx);
+            if (!cs.ok()) return cs;
+        }
+
+        std::vector<algo::Detection> local;
+        const std::vector<algo::Detection>* dets = nullptr;
+        const Status s = run_into_(img, /*force_bound=*/false, ctx, /*explicit_bound_call=*/false, local, dets);
+        if (!s.ok()) return s;
+        try {
+            out.assign(dets->begin(), dets->end());
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("detect_track: bad_alloc");
+        }
+        return Status::Ok();
+    }
+
+    /**
+     * @brief Tracked frame of @ref detect_track: single-pass detection on every region.
+     *
+     * @details
+     * Crops skip the cascade and tiling (they are small by construction). With a prepared binding
+     * one context is checked out for the whole frame and every crop runs on it through
+     * @ref run_bound_scratch_, resized into the bound shape; otherwise crops run unbound.
+     *
+     * @param regions Disjoint crops with even coordinates (see @ref algo::tracking_regions).
+     * @param out Receives the detections in full-frame coordinates (cleared first).
+     */
+    Status verify_regions_(const Image& img, const std::vector<cv::Rect>& regions,
+                           std::vector<algo::Detection>& out) noexcept {
+        out.clear();
+        if (regions.empty()) return Status::Ok();
+        try {
+            std::optional<engine::ContextPool::Lease> lease;
+            int ctx = -1;
+            if (cfg_.infer.bind_io && binding_ready_ && contexts_) {
+                const Status cs = checkout_(lease, ctx);
+                if (!cs.ok()) return cs;
+            }
+
+            std::vector<algo::Detection> local;
+            for (const cv::Rect& r : regions) {
+                const Image crop = Image::view(crop_view_(img.view(), r));
+                const std::vector<algo::Detection>* dets = &local;
+                if (ctx >= 0 && (std::size_t)ctx < scratch_.size()) {
+                    FrameScratch& fs = scratch_[(std::size_t)ctx];
+                    const Status s = run_bound_scratch_(crop, ctx, fs);
+                    if (!s.ok()) return s;
+                    dets = &fs.kept;
+                } else {
+                    local.clear();
+                    Status s = try_direct_(*engine_, crop, ctx, local);
+                    if (s.code == Status::Code::Unsupported) {
+                        auto bm_res = internal::BgrMat::from(crop);
+                        if (!bm_res.ok()) return bm_res.status();
+                        auto rs = run_single_(bm_res.value().mat(), ctx >= 0, ctx);
+                        if (!rs.ok()) return rs.status();
+                        local = std::move(rs.value());
+                        s = Status::Ok();
+                    }
+                    if (!s.ok()) return s;
+                    local = postprocess_(std::move(local));
+                }
+                for (const algo::Detection& d : *dets) {
+                    out.push_back(d);
+                    algo::offset_detection(out.back(), r.x, r.y, -1);
+                }
+            }
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            out.clear();
+            return Status::OutOfMemory("detect_track: verify: bad_alloc");
+        } catch (const std::exception& e) {
+            out.clear();
+            return Status::Internal(std::string("detect_track: verify: ") + e.what());
+        }
+    }
+
+    /**
+     * @brief Coarse 3-channel thumbnail of @p v for the scene change test of @ref detect_track.
+     *
+     * @details
+     * Nearest-neighbour sampling reads only the sampled pixels; YUV frames sample their luma
+     * plane. Channel order does not matter, the thumbnail is only compared with earlier ones.
+     */
+    static void scene_thumb_(const ImageView& v, cv::Mat& out) {
+        const int tw = std::min(v.width, kSceneThumbSide);
+        const int th = std::max(1, (int)((long long)v.height * tw / std::max(1, v.width)));
+        const cv::Size size(tw, std::min(th, kSceneThumbSide));
+        auto* data = const_cast<std::uint8_t*>(v.data);
+        if (v.is_yuv()) {
+            cv::Mat small;
+            cv::resize(cv::Mat(v.height, v.width, CV_8UC1, data, v.stride_bytes), small, size, 0, 0,
+                       cv::INTER_NEAREST);
+            cv::cvtColor(small, out, cv::COLOR_GRAY2BGR);
+            return;
+        }
+        if (v.channels() == 4) {
+            cv::Mat small;
+            cv::resize(cv::Mat(v.height, v.width, CV_8UC4, data, v.stride_bytes), small, size, 0, 0,
+                       cv::INTER_NEAREST);
+            cv::cvtColor(small, out, cv::COLOR_BGRA2BGR);
+            return;
+        }
+        cv::resize(cv::Mat(v.height, v.width, CV_8UC3, data, v.stride_bytes), out, size, 0, 0, cv::INTER_NEAREST);
+    }
+
+    /// @brief Exponential moving average of the @ref detect_track costs (the first sample initializes).
+    static double ema_(double avg, double x) noexcept {
+        return avg > 0.0 ? avg + 0.2 * (x - avg) : x;
+    }
+
+    /// @brief Milliseconds from @p a to @p b.
+    static double ms_between_(std::chrono::steady_clock::time_point a,
+                              std::chrono::steady_clock::time_point b) noexcept {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    }
+
+    /// @brief Whether @p io enables the quality controller (see @ref QualityOptions).
+    static bool quality_enabled_(const InferenceOptions& io) noexcept {
+        return io.quality.target_ms > 0.0f || io.quality.max_queue > 0;
+    }
+
+    /**
+     * @brief Quality levels of @p io with zero fields resolved; level 0 is the configured one.
+     *
+     * @details
+     * Without explicit levels: 3/4 and 1/2 of @c max_img_size, aligned down to 32, kept while
+     * they are smaller than the level before. A single level means that the control is off.
+     *
+     * @throws std::bad_alloc On allocation failure.
+     */
+    static std::vector<QualityLevel> quality_levels_of_(const InferenceOptions& io) {
+        std::vector<QualityLevel> out{QualityLevel{io.max_img_size, io.tiles_dim}};
+        if (!quality_enabled_(io)) return out;
+        if (io.quality.levels.empty()) {
+            for (const int quarters : {3, 2}) {
+                const int side = io.max_img_size * quarters / 4 / 32 * 32;
+                if (side >= 32 && side < out.back().max_img_size) out.push_back({side, io.tiles_dim});
+            }
+            return out;
+        }
+        for (const QualityLevel& l : io.quality.levels) {
+            QualityLevel r = out.front();
+            if (l.max_img_size > 0) r.max_img_size = l.max_img_size;
+            if (l.tiles_dim.rows > 0 && l.tiles_dim.cols > 0) r.tiles_dim = l.tiles_dim;
+            out.push_back(r);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Cost of quality level @p l relative to @p base: input pixels per tile times tiles.
+     *
+     * @details
+     * A @c max_img_size of 0 (no limit) counts as the base size; adaptive tiles ignore the grid.
+     */
+    static double quality_cost_(const QualityLevel& l, const QualityLevel& base, const InferenceOptions& io) noexcept {
+        double c = 1.0;
+        if (l.max_img_size > 0 && base.max_img_size > 0) {
+            const double s = (double)l.max_img_size / (double)base.max_img_size;
+            c = s * s;
+        }
+        if (io.tile_mode == TileMode::Grid) {
+            const int n = std::max(1, base.tiles_dim.rows * base.tiles_dim.cols);
+            c *= (double)(l.tiles_dim.rows * l.tiles_dim.cols) / (double)n;
+        }
+        return c;
+    }
+
+    /**
+     * @brief Restarts the quality control at level 0 of @ref cfg_ (after a configuration change).
+     *
+     * @details
+     * Runs while no call uses the detector (creation, or the exclusive gate). On allocation
+     * failure the control stays off until the next configuration change.
+     */
+    void reset_quality_() noexcept {
+        std::lock_guard<std::mutex> lk(quality_mu_);
+        quality_want_.store(0, std::memory_order_relaxed);
+        quality_level_.store(0, std::memory_order_relaxed);
+        try {
+            std::vector<QualityLevel> levels = quality_levels_of_(cfg_.infer);
+            std::vector<double> costs;
+            costs.reserve(levels.size());
+            for (const QualityLevel& l : levels)
+                costs.push_back(quality_cost_(l, levels.front(), cfg_.infer));
+            quality_.reset(std::move(costs));
+            quality_levels_.swap(levels);
+        } catch (const std::bad_alloc&) {
+            quality_.reset({});
+            quality_levels_.clear();
+        }
+    }
+
+    /// @brief Configured inference options, @ref cfg_ without the overrides of the current quality level.
+    InferenceOptions base_infer_() const {
+        InferenceOptions io = cfg_.infer;
+        if (!quality_levels_.empty()) {
+            io.max_img_size = quality_levels_.front().max_img_size;
+            io.tiles_dim = quality_levels_.front().tiles_dim;
+        }
+        return io;
+    }
+
+    /// @brief Callers waiting for a bound context (0 without binding).
+    int context_queue_() const noexcept {
+        return contexts_ ? contexts_->waiting() : 0;
+    }
+
+    /**
+     * @brief Feeds one call to the quality controller.
+     *
+     * @param ms Latency of the call (< 0: asynchronous submission, queue depth only).
+     * @param queue Callers waiting for a context plus asynchronous frames in flight.
+     */
+    void quality_observe_(double ms, int queue) noexcept {
+        if (quality_levels_.size() <= 1) return;
+        const QualityOptions& qo = cfg_.infer.quality;
+        algo::QualityParams p;
+        p.target_ms = qo.target_ms;
+        p.max_queue = qo.max_queue;
+        p.recover = qo.recover;
+        p.hold = qo.hold_frames;
+        std::lock_guard<std::mutex> lk(quality_mu_);
+        quality_want_.store(quality_.observe(ms, queue, p), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Switches the engine and the tile grid to quality level @p level (exclusive gate held).
+     *
+     * @details
+     * Submitted frames drain first, as in @ref update_config. The stream cache is dropped when
+     * the grid changes, since its tiles no longer match.
+     *
+     * @throws std::bad_alloc On allocation failure (the level stays unchanged).
+     */
+    void apply_quality_(int level) {
+        if (!engine_ || level < 0 || (std::size_t)level >= quality_levels_.size()) return;
+        if (level == quality_level_.load(std::memory_order_relaxed)) return;
+
+        if (pipeline_) pipeline_->drain();
+        if (tiles_) tiles_->drain();
+
+        const QualityLevel& l = quality_levels_[(std::size_t)level];
+        DetectorConfig next = cfg_;
+        next.infer.max_img_size = l.max_img_size;
+        next.infer.tiles_dim = l.tiles_dim;
+        if (!engine_->update_hot(next).ok()) return;
+
+        const GridSpec& was = cfg_.infer.tiles_dim;
+        if (was.rows != l.tiles_dim.rows || was.cols != l.tiles_dim.cols) stream_.reset();
+        cfg_.infer.max_img_size = l.max_img_size;
+        cfg_.infer.tiles_dim = l.tiles_dim;
+        quality_level_.store(level, std::memory_order_relaxed);
+#if IDET_WITH_STATS
+        engine_->stats().add_quality_change();
+#endif
+    }
+
+    /**
+     * @brief Cascade pre-pass (see @ref CascadeOptions): runs @ref probe_ on @p img.
+     *
+     * @details
+     * Bound calls use the probe context matching their main context, and its @ref FrameScratch
+     * keeps the probe detections; unbound calls run the probe unbound.
+     *
+     * @param ctx Main context of the call, or -1 when it runs unbound.
+     * @param hit Receives whether the probe found anything above the trigger.
+     * @param roi Receives the region for the full pass, grown by the margin and aligned to even
+     *        coordinates (4:2:0 chroma); empty when the whole frame has to run.
+     */
+    Status probe_frame_(const Image& img, int ctx, bool& hit, cv::Rect& roi) noexcept {
+        hit = false;
+        roi = cv::Rect();
+        const ImageView& v = img.view();
+        if (!v.is_valid()) return Status::Invalid("detect: invalid Image");
+
+        try {
+            const bool bound = ctx >= 0 && ctx < probe_->bound_contexts() && (std::size_t)ctx < scratch_.size();
+            const int pctx = bound ? ctx : -1;
+            std::vector<algo::Detection> local;
+            std::vector<algo::Detection>& dets = bound ? scratch_[(std::size_t)ctx].probe : local;
+
+            Status s = try_direct_(*probe_, img, pctx, dets);
+            if (s.code == Status::Code::Unsupported) {
+                cv::Mat conv;
+                auto bm_res = internal::BgrMat::from(Image(img), bound ? scratch_[(std::size_t)ctx].bgr : conv);
+                if (!bm_res.ok()) return bm_res.status();
+                s = probe_->infer_source_into(algo::ChwSource::of(bm_res.value().mat(), algo::ChannelOrder::BGR),
+                                              pctx, dets);
+            }
+            if (!s.ok()) return s;
+            if (dets.empty()) return Status::Ok();
+            hit = true;
+
+            const CascadeOptions& c = cfg_.infer.cascade;
+            float x0 = (float)v.width, y0 = (float)v.height, x1 = 0.0f, y1 = 0.0f;
+            for (const algo::Detection& d : dets) {
+                for (const cv::Point2f& p : d.pts) {
+                    x0 = std::min(x0, p.x);
+                    y0 = std::min(y0, p.y);
+                    x1 = std::max(x1, p.x);
+                    y1 = std::max(y1, p.y);
+                }
+            }
+            const float pad = c.roi_margin * std::max(x1 - x0, y1 - y0);
+            const int rx0 = std::max(0, (int)std::floor(x0 - pad)) & ~1;
+            const int ry0 = std::max(0, (int)std::floor(y0 - pad)) & ~1;
+            const int rx1 = std::min(v.width, ((int)std::ceil(x1 + pad) + 1) & ~1);
+            const int ry1 = std::min(v.height, ((int)std::ceil(y1 + pad) + 1) & ~1);
+            if (rx1 - rx0 < 2 || ry1 - ry0 < 2) return Status::Ok();
+
+            const double area = (double)(rx1 - rx0) * (double)(ry1 - ry0);
+            if (area <= (double)c.roi_max_area * (double)v.width * (double)v.height)
+                roi = cv::Rect(rx0, ry0, rx1 - rx0, ry1 - ry0);
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("detect: cascade probe: bad_alloc");
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("detect: cascade probe: ") + e.what());
+        }
+    }
+
+    /// @brief Records the cascade outcome of one frame (no-op when statistics are compiled out).
+    void record_cascade_(bool skipped, bool cropped) const noexcept {
+#if IDET_WITH_STATS
+        if (engine_) engine_->stats().add_cascade(skipped, cropped);
+#else
+        (void)skipped;
+        (void)cropped;
+#endif
+    }
+
+    /// @brief True if an untiled call without an explicit context runs bound (and so needs a checkout).
+    bool auto_bound_() const noexcept {
+        return cfg_.infer.bind_io && binding_ready_ && contexts_ && !tiled_();
+    }
+
+    /**
+     * @brief Checks a bound context out of @ref contexts_ for one call.
+     *
+     * @details
+     * Lock-free when a context is free. Otherwise @ref InferenceOptions::context_overflow decides:
+     * wait for one, or after @ref InferenceOptions::context_wait_ms run unbound (@p ctx = -1)
+     * or fail.
+     *
+     * @param lease Receives the checkout; the context returns to the pool when it is destroyed.
+     * @param ctx Receives the context index (-1: run unbound).
+     * @return Unavailable when no context became free and the policy is @ref ContextOverflow::Fail.
+     */
+    Status checkout_(std::optional<engine::ContextPool::Lease>& lease, int& ctx) const noexcept {
+        const InferenceOptions& io = cfg_.infer;
+        int k = -1;
+        if (io.context_overflow == ContextOverflow::Wait)
+            k = contexts_->acquire();
+        else
+            (void)contexts_->acquire_for(k, std::chrono::milliseconds(io.context_wait_ms));
+
+        ctx = k;
+        if (k >= 0) {
+            lease.emplace(*contexts_, k);
+            return Status::Ok();
+        }
+        if (io.context_overflow == ContextOverflow::Unbound) return Status::Ok();
+        return Status::Unavailable("detect: all " + std::to_string(contexts_->size()) + " bound contexts are in use");
+    }
+
+    /// @brief Allocation-free bound detection into @p fs (result in @c fs.kept).
+    Status run_bound_scratch_(const Image& img, int ctx, FrameScratch& fs) noexcept {
+        try {
+            Status s = try_direct_(*engine_, img, ctx, fs.raw);
+            if (s.code == Status::Code::Unsupported) {
+                auto bm_res = internal::BgrMat::from(Image(img), fs.bgr);
+                if (!bm_res.ok()) return bm_res.status();
+                s = engine_->infer_bound_into(bm_res.value().mat(), ctx, fs.raw);
+            }
+            if (!s.ok()) return s;
+
+            if (nms_applies_(fs.raw.size())) {
+                fs.buf.assign(fs.raw);
+                postprocess_buffer_(fs.buf, fs.nms, 0, fs.kept);
+            } else {
+                apply_min_size_(fs.raw);
+                fs.kept.swap(fs.raw);
+                record_frame_(0, fs.kept.size(), fs.kept.size(), 0);
+            }
+            return Status::Ok();
+        } catch (const std::bad_alloc&) {
+            return Status::OutOfMemory("detect_bound: bad_alloc");
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("detect_bound: ") + e.what());
+        } catch (...) {
+            return Status::Internal("detect_bound: unknown");
+        }
+    }
+
+    /// @brief Same as @ref run_ but returns postprocessed internal detections (scores, landmarks, tiles).
+    Result<std::vector<algo::Detection>> run_dets_(const Image& img, bool force_bound, int ctx,
+                                                   bool explicit_bound_call) noexcept {
+        using R = Result<std::vector<algo::Detection>>;
+        if (!engine_) return R::Err(Status::Invalid("detect: engine not initialized"));
+
+        const bool tiled = tiled_();
+        const bool want_bound = ctx >= 0 && (force_bound || (cfg_.infer.bind_io && binding_ready_));
+
+        if (want_bound && !binding_ready_) {
+            return R::Err(Status::Invalid(explicit_bound_call ? "detect_bound: binding not prepared"
+                                                              : "detect: bind_io enabled but binding not prepared"));
+        }
+
+        if (!tiled) {
+            std::vector<algo::Detection> dets;
+            const Status s = try_direct_(*engine_, img, want_bound ? ctx : -1, dets);
+            if (s.ok()) return R::Ok(postprocess_(std::move(dets)));
+            if (s.code != Status::Code::Unsupported) return R::Err(s);
+        }
+
+        // Convert public Image into a BGR cv::Mat view (implementation defined).
+        auto bm_res = internal::BgrMat::from(Image(img));
+        if (!bm_res.ok()) return R::Err(bm_res.status());
+        const cv::Mat& bgr = std::move(bm_res.value().mat());
+
+        if (tiled) {
+            R r = run_tiled_(bgr, want_bound, ctx, explicit_bound_call);
+            if (!r.ok()) return r;
+            const auto rects = algo::make_tiles(bgr.cols, bgr.rows, tile_layout_());
+            return R::Ok(postprocess_tiled_(std::move(r.value()), rects));
+        }
+
+        R r = run_single_(bgr, want_bound, ctx);
+        if (!r.ok()) return r;
+        return R::Ok(postprocess_(std::move(r.value())));
+    }
+
+    /**
+     * @brief Feeds a non-BGR image (RGB/RGBA/BGRA or 4:2:0 YUV) straight into the engine's fused
+     *        preprocessing, skipping the @c cv::cvtColor copy.
+     *
+     * @param e Engine to run (@ref engine_, or @ref probe_ for the cascade pre-pass).
+     * @param ctx Binding context, or -1 for unbound inference.
+     * @return Status::Unsupported for BGR images (already zero-copy) or when the engine needs a BGR
+     *         frame; the caller then takes the @ref internal::BgrMat path.
+     */
+    static Status try_direct_(engine::IEngine& e, const Image& img, int ctx,
+                              std::vector<algo::Detection>& out) noexcept {
+        const ImageView& v = img.view();
+        if (v.format == PixelFormat::BGR_U8) return Status::Unsupported("BGR image");
+        if (!v.is_valid()) return Status::Invalid("detect: invalid Image");
+
+        if (v.is_yuv()) {
+            const algo::Yuv420Planes planes = internal::yuv420_planes(v);
+            return e.infer_source_into(algo::ChwSource::of(planes), ctx, out);
         }
 
-        cfg_.infer = cfg.infer;
-        cfg_.verbose = cfg.verbose;
+        algo::ChannelOrder order = algo::ChannelOrder::BGR;
+        if (!internal::packed_channel_order(v.format, order)) return Status::Unsupported("unknown PixelFormat");
+        try {
+            // Read-only view into the caller's pixels.
+            const cv::Mat m(v.height, v.width, algo::channel_count(order) == 4 ? CV_8UC4 : CV_8UC3,
+                            const_cast<std::uint8_t*>(v.data), v.stride_bytes);
+            return e.infer_source_into(algo::ChwSource::of(m, order), ctx, out);
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("detect: ") + e.what());
+        }
+    }
 
-        if (!engine_) return Status::Invalid("update_config: engine not initialized");
-        return engine_->update_hot(cfg_);
+    /// @brief Applies common postprocessing and converts detections to public quads.
+    VecQuad finalize_(std::vector<algo::Detection> dets) const {
+        return to_public_quads_(postprocess_(std::move(dets)));
     }
 
     /**
-     * @brief Prepares bound I/O resources for a fixed input resolution and number of contexts.
+     * @brief Applies common postprocessing to engine detections.
      *
-     * @param w Input width in pixels.
-     * @param h Input height in pixels.
-     * @param contexts Number of independent binding contexts (normalized to >= 1).
-     * @return @ref idet::Status::Ok() on success, otherwise a non-OK status.
+     * @details
+     * - min-size filtering
+     * - NMS (disabled when threshold <= 0)
+     *
+     * @param tiles Tile count of the frame, for the statistics (0 for untiled frames).
      */
-    Status prepare_binding(int w, int h, int contexts) noexcept {
-        if (!engine_) return Status::Invalid("prepare_binding: engine not initialized");
-        if (w <= 0 || h <= 0) return Status::Invalid("prepare_binding: non-positive w/h");
-        if (contexts <= 0) contexts = 1;
-
-        const Status s = engine_->setup_binding(w, h, contexts);
-        if (s.ok()) binding_ready_ = true;
-        return s;
+    std::vector<algo::Detection> postprocess_(std::vector<algo::Detection> dets, std::size_t tiles = 0) const {
+        if (!nms_applies_(dets.size())) {
+            apply_min_size_(dets);
+            record_frame_(tiles, dets.size(), dets.size(), 0);
+            return dets;
+        }
+        algo::DetectionBuffer buf;
+        algo::NmsWorkspace ws;
+        buf.assign(dets);
+        postprocess_buffer_(buf, ws, tiles, dets);
+        return dets;
     }
 
-    /// @brief Public entry point for unbound (or internally managed) inference.
-    Result<VecQuad> detect(const Image& img) noexcept {
-        return run_(img, /*force_bound=*/false, /*ctx=*/0, /*explicit_bound_call=*/false);
+    /** @brief Whether @ref postprocess_ runs NMS over @p n candidates (before min-size filtering). */
+    bool nms_applies_(std::size_t n) const noexcept {
+        return cfg_.infer.nms_iou > 0.0f && n > 1;
     }
 
     /**
-     * @brief Public entry point for bound inference using an explicit context index.
+     * @brief @ref postprocess_ on a columnar buffer: min-size filter in place, then NMS on the
+     *        cached boxes, kept detections exported to @p out (cleared first).
      *
-     * @param img Input image.
-     * @param ctx Context index (must be >= 0).
-     * @return Result of detections or an error status.
+     * @param buf Candidates in final (frame) coordinates; filtered in place.
+     * @param ws NMS state; reused by per-context and per-call loops.
+     * @param tiles Tile count of the frame, for the statistics.
      */
-    Result<VecQuad> detect_bound(const Image& img, int ctx) noexcept {
-        if (ctx < 0) return Result<VecQuad>::Err(Status::Invalid("detect_bound: ctx < 0"));
-        return run_(img, /*force_bound=*/true, ctx, /*explicit_bound_call=*/true);
+    void postprocess_buffer_(algo::DetectionBuffer& buf, algo::NmsWorkspace& ws, std::size_t tiles,
+                             std::vector<algo::Detection>& out) const {
+        const std::size_t candidates = buf.filter_min_size(cfg_.infer.min_roi_size_w, cfg_.infer.min_roi_size_h);
+        std::size_t scratch = 0;
+        if (nms_applies_(candidates)) {
+            IDET_STAGE_SCOPE(stats_ptr_(), Stage::Nms);
+            ws.run(buf, nms_params_(candidates));
+            ws.gather(buf, out);
+            scratch = ws.arena().used();
+        } else {
+            buf.export_to(out);
+        }
+        record_frame_(tiles, candidates, out.size(), scratch);
     }
 
-  private:
     /**
-     * @brief Executes the end-to-end pipeline and returns public quadrilateral results.
+     * @brief Postprocessing of a tiled frame split into @p rects.
      *
      * @details
-     * Steps:
-     *  1) Ensure engine is initialized.
-     *  2) Convert input image to BGR `cv::Mat`.
-     *  3) Decide single vs tiled execution.
-     *  4) Enforce binding requirements for bound inference.
-     *  5) Run inference (single or tiled).
-     *  6) Apply common postprocessing:
-     *     - min-size filtering
-     *     - NMS (or score sort if NMS disabled)
+     * Same as @ref postprocess_ for @ref TileMerge::Nms; otherwise min-size filtering followed by
+     * @ref algo::merge_tiled, which only suppresses detections near tile seams.
      */
-    Result<VecQuad> run_(const Image& img, bool force_bound, int ctx, bool explicit_bound_call) noexcept {
-        if (!engine_) {
-            const Status s = init_engine();
-            if (!s.ok()) return Result<VecQuad>::Err(s);
+    std::vector<algo::Detection> postprocess_tiled_(std::vector<algo::Detection> dets,
+                                                    const std::vector<cv::Rect>& rects) const {
+        const TileMerge mode = cfg_.infer.tile_merge;
+        if (mode == TileMerge::Nms) return postprocess_(std::move(dets), rects.size());
+
+        apply_min_size_(dets);
+
+        algo::TileMergeParams p;
+        p.iou_thr = cfg_.infer.nms_iou;
+        p.use_fast_iou = cfg_.infer.use_fast_iou;
+        p.per_tile_nms = cfg_.task == Task::Face; // raw anchors overlap inside a tile
+        p.join_seams = mode == TileMerge::SeamsJoin && cfg_.task == Task::Text;
+
+        algo::FrameArena arena;
+        std::vector<algo::Detection> out;
+        {
+            IDET_STAGE_SCOPE(stats_ptr_(), Stage::Nms);
+            algo::merge_tiled(dets, rects, p, arena, out);
         }
+        record_frame_(rects.size(), dets.size(), out.size(), arena.used());
+        return out;
+    }
 
-        // Convert public Image into a BGR cv::Mat view (implementation defined).
-        auto bm_res = internal::BgrMat::from(Image(img));
-        if (!bm_res.ok()) return Result<VecQuad>::Err(bm_res.status());
-        const cv::Mat& bgr = std::move(bm_res.value().mat());
-
-        const bool tiled = (cfg_.infer.tiles_dim.rows * cfg_.infer.tiles_dim.cols) > 1;
-        const bool want_bound = force_bound || (cfg_.infer.bind_io && binding_ready_);
+#if IDET_WITH_STATS
+    /// @brief Collector of the engine, or null before the engine exists.
+    internal::StatsCollector* stats_ptr_() const noexcept {
+        return engine_ ? &engine_->stats() : nullptr;
+    }
+#endif
 
-        if (want_bound && !binding_ready_) {
-            return Result<VecQuad>::Err(Status::Invalid(explicit_bound_call
-                                                            ? "detect_bound: binding not prepared"
-                                                            : "detect: bind_io enabled but binding not prepared"));
+    /**
+     * @brief Parameters of the common NMS over @p n candidates.
+     *
+     * @details
+     * Large candidate sets (dense text pages) are split into overlap clusters that run on the
+     * post-processing threads; inside tiled inference the pool is already busy and NMS stays serial.
+     */
+    algo::NmsParams nms_params_(std::size_t n) const noexcept {
+        constexpr std::size_t kParallelNmsMin = 2048;
+
+        algo::NmsParams p;
+        p.iou_thr = cfg_.infer.nms_iou;
+        p.use_fast_iou = cfg_.infer.use_fast_iou;
+        p.sigma = cfg_.infer.nms_sigma;
+        p.min_score = cfg_.infer.box_thresh;
+        switch (cfg_.infer.nms_mode) {
+        case NmsMode::SoftLinear:
+            p.method = algo::NmsMethod::Linear;
+            break;
+        case NmsMode::SoftGaussian:
+            p.method = algo::NmsMethod::Gaussian;
+            break;
+        case NmsMode::Weighted:
+            p.method = algo::NmsMethod::Weighted;
+            break;
+        default:
+            p.method = algo::NmsMethod::Hard;
+            break;
         }
-
-        Result<std::vector<algo::Detection>> r =
-            tiled ? run_tiled_(bgr, want_bound, ctx, explicit_bound_call) : run_single_(bgr, want_bound, ctx);
-
-        if (!r.ok()) return Result<VecQuad>::Err(r.status());
-
-        auto dets = std::move(r.value());
-
-        // Common min-size filter.
-        if (cfg_.infer.min_roi_size_w > 0 || cfg_.infer.min_roi_size_h > 0) {
-            std::vector<algo::Detection> filtered;
-            filtered.reserve(dets.size());
-            for (auto& d : dets) {
-                if (passes_min_size_(d, cfg_.infer.min_roi_size_w, cfg_.infer.min_roi_size_h))
-                    filtered.push_back(std::move(d));
-            }
-            dets.swap(filtered);
+        if (n >= kParallelNmsMin && !platform::ThreadPool::in_parallel()) {
+            const int t = cfg_.runtime.post_omp_threads;
+            p.threads = (t > 0) ? t : platform::ThreadPool::hardware_width();
         }
+        return p;
+    }
 
-        // Common NMS (disabled when threshold <= 0).
-        if (cfg_.infer.nms_iou > 0.0f && dets.size() > 1) {
-            dets = algo::nms_poly(dets, cfg_.infer.nms_iou, cfg_.infer.use_fast_iou);
-        }
+    /// @brief Records the counters of one postprocessed frame (no-op when statistics are compiled out).
+    void record_frame_(std::size_t tiles, std::size_t candidates, std::size_t kept,
+                       std::size_t scratch_bytes) const noexcept {
+#if IDET_WITH_STATS
+        if (engine_) engine_->stats().add_frame(tiles, candidates, kept, scratch_bytes);
+#else
+        (void)tiles;
+        (void)candidates;
+        (void)kept;
+        (void)scratch_bytes;
+#endif
+    }
 
-        return Result<VecQuad>::Ok(to_public_quads_(dets));
+    /// @brief Common min-size filter, applied in place (order preserving, no allocation).
+    void apply_min_size_(std::vector<algo::Detection>& dets) const {
+        const int mw = cfg_.infer.min_roi_size_w;
+        const int mh = cfg_.infer.min_roi_size_h;
+        if (mw <= 0 && mh <= 0) return;
+        dets.erase(std::remove_if(dets.begin(), dets.end(),
+                                  [&](const algo::Detection& d) { return !passes_min_size_(d, mw, mh); }),
+                   dets.end());
     }
 
     /// @brief Runs inference on a single image (no tiling).
@@ -352,8 +2480,61 @@ class DetectorImpl final {
                                                     bool explicit_bound_call) noexcept {
         const bool parallel_bound = bound ? (!explicit_bound_call) : false;
 
-        return algo::infer_tiled(*engine_, bgr, bound, ctx, parallel_bound, cfg_.infer.tiles_dim,
-                                 cfg_.infer.tile_overlap, cfg_.runtime.tile_omp_threads);
+        std::vector<TileTiming> timings;
+        auto r = algo::infer_tiled(*engine_, bgr, bound, ctx, parallel_bound, tile_layout_(),
+                                   cfg_.runtime.tile_omp_threads, &timings, /*cache=*/nullptr, contexts_.get(),
+                                   cfg_.infer.tile_batch);
+        store_timings_(std::move(timings));
+        return r;
+    }
+
+    /// @brief Publishes the tile timings of the latest tiled frame (see @ref last_tile_timings).
+    void store_timings_(std::vector<TileTiming>&& timings) noexcept {
+        std::lock_guard<std::mutex> lk(timings_mu_);
+        tile_timings_.swap(timings);
+    }
+
+    /// @brief True if frames go through the tiled path (grid larger than 1x1, or adaptive tiles).
+    bool tiled_() const noexcept {
+        const GridSpec& g = cfg_.infer.tiles_dim;
+        return cfg_.infer.tile_mode == TileMode::Adaptive || (g.rows * g.cols) > 1;
+    }
+
+    /**
+     * @brief Tile layout of the current configuration.
+     *
+     * @details
+     * Adaptive tiles take the model input shape so that tiles skip resampling: the largest bound
+     * bucket when binding is prepared, else @c fixed_input_dim, else @c max_img_size squared, all
+     * aligned down to the engines' stride of 32. The overlap is @c tile_overlap of the smaller tile
+     * side, raised to @c tile_min_object.
+     */
+    algo::TileLayout tile_layout_() const noexcept {
+        const InferenceOptions& io = cfg_.infer;
+        if (io.tile_mode != TileMode::Adaptive) return algo::TileLayout::of_grid(io.tiles_dim, io.tile_overlap);
+
+        int tw = 0, th = 0;
+        if (engine_ && binding_ready_) {
+            for (const auto& sh : engine_->bucket_shapes()) {
+                if ((long long)sh.first * sh.second > (long long)tw * th) {
+                    tw = sh.first;
+                    th = sh.second;
+                }
+            }
+        }
+        if (tw <= 0 || th <= 0) {
+            const bool fixed = io.fixed_input_dim.rows > 0 && io.fixed_input_dim.cols > 0;
+            tw = fixed ? io.fixed_input_dim.cols : io.max_img_size;
+            th = fixed ? io.fixed_input_dim.rows : io.max_img_size;
+            tw = std::max(32, tw / 32 * 32);
+            th = std::max(32, th / 32 * 32);
+        }
+
+        algo::TileLayout l;
+        l.tile_w = tw;
+        l.tile_h = th;
+        l.min_overlap_px = std::max(io.tile_min_object, (int)std::lround(io.tile_overlap * (float)std::min(tw, th)));
+        return l;
     }
 
   private:
@@ -363,8 +2544,107 @@ class DetectorImpl final {
     /** @brief Owned engine backend implementation (DBNet, SCRFD, ...). */
     std::unique_ptr<idet::engine::IEngine> engine_;
 
+    /** @brief Low-resolution engine of the cascade pre-pass (null when disabled, see @ref probe_frame_). */
+    std::unique_ptr<idet::engine::IEngine> probe_;
+
     /** @brief Whether bound I/O has been prepared successfully. */
     bool binding_ready_ = false;
+
+    /** @brief One scratch per bound context (sized by @ref prepare_binding). */
+    std::vector<FrameScratch> scratch_;
+
+    /** @brief Free bound contexts, checked out per call by untiled and tiled detection (null while unbound). */
+    std::unique_ptr<engine::ContextPool> contexts_;
+
+    /** @brief In-flight frames of the fallback (non-staged) async pipeline. */
+    static constexpr int kFallbackPipelineDepth = 2;
+
+    /** @brief In-flight frames of the tile scheduler (tiles of both frames interleave). */
+    static constexpr int kTiledPipelineDepth = 2;
+
+    /** @brief Per-tile timings of the most recent tiled frame (see @ref last_tile_timings). */
+    std::vector<TileTiming> tile_timings_;
+    mutable std::mutex timings_mu_;
+
+    /** @brief Tile references and cached detections of @ref detect_stream (guarded by @ref stream_mu_). */
+    algo::TileCache stream_;
+    std::mutex stream_mu_;
+
+    /** @brief Tracks, reference thumbnail and cost estimates of one @ref detect_track stream. */
+    struct TrackState {
+        algo::Tracker tracker;
+        cv::Mat thumb;                      ///< Scene thumbnail of the last keyframe
+        int frame_w = 0, frame_h = 0;       ///< Frame size of the last keyframe
+        int since_key = 0;                  ///< Frames since the last keyframe
+        int interval = 1;                   ///< Current keyframe interval
+        std::uint64_t frames = 0;           ///< Frames since the last reset
+        double key_ms = 0.0;                ///< Mean keyframe cost
+        double track_ms = 0.0;              ///< Mean tracked-frame cost
+        double period_ms = 0.0;             ///< Mean time between calls
+        std::chrono::steady_clock::time_point last_call{};
+        std::vector<cv::Rect> regions;      ///< Verification crops of the current frame
+        std::vector<algo::Detection> found; ///< Detections of the current frame
+    };
+
+    /** @brief Side bound of the @ref scene_thumb_ thumbnail in pixels. */
+    static constexpr int kSceneThumbSide = 64;
+
+    /** @brief State of @ref detect_track (guarded by @ref track_mu_). */
+    TrackState track_;
+    std::mutex track_mu_;
+
+    /** @brief Resolved quality levels (level 0: the configured values, see @ref quality_levels_of_). */
+    std::vector<QualityLevel> quality_levels_;
+
+    /** @brief Level decisions from the measured calls (guarded by @ref quality_mu_). */
+    algo::QualityController quality_;
+    std::mutex quality_mu_;
+
+    std::atomic<int> quality_want_{0};      ///< Level chosen by @ref quality_
+    std::atomic<int> quality_level_{0};     ///< Level in effect (changed under the exclusive gate)
+    std::atomic<bool> quality_busy_{false}; ///< A caller is inside @ref settle_quality
+
+    /** @brief Lazily created async pipeline (declared after engine_ so it is destroyed first). */
+    std::unique_ptr<pipeline::AsyncPipeline> pipeline_;
+
+    /** @brief Lazily created tile scheduler for asynchronous tiled detection (exclusive with pipeline_). */
+    std::unique_ptr<pipeline::TileScheduler> tiles_;
+
+    /** @brief First ticket of the next async backend, so tickets stay unique across backends and engines. */
+    Ticket next_ticket_ = 1;
+
+    /**
+     * @brief Serializes creation and replacement of @ref pipeline_ / @ref tiles_ and @ref next_ticket_
+     * among concurrent @ref submit / @ref poll / @ref wait calls (@ref reload uses the exclusive gate).
+     */
+    mutable std::mutex backend_mu_;
+
+    /** @brief Live @ref PinnedBackend count; backends are replaced only at zero. */
+    mutable std::atomic<int> backend_users_{0};
+
+    /** @brief Binding request replayed by @ref reload (valid while @ref binding_ready_). */
+    BindingPlan binding_;
+
+    /** @brief Bumped by every binding call; a reload built for an older epoch is not swapped in. */
+    std::uint64_t binding_epoch_ = 0;
+
+    /** @brief Shared by calls that use the engine, exclusive for the swap of @ref reload. */
+    mutable std::shared_mutex gate_;
+
+    /** @brief Previous engine kept for uncollected async frames (guarded by @ref retired_mu_). */
+    Retired retired_;
+    mutable std::mutex retired_mu_;
+
+    /** @brief Serializes reloads (building two engines at once only doubles the peak memory). */
+    std::mutex reload_mu_;
+
+    /** @brief State of @ref reload_async. */
+    std::mutex async_mu_;
+    std::condition_variable reload_cv_;
+    bool reload_busy_ = false;
+    bool reload_started_ = false; ///< A background reload ran at least once (@ref reload_result_ is its outcome)
+    Status reload_result_ = Status::Ok();
+    std::thread reload_thread_; ///< Joined by the destructor before any engine is released
 };
 
 } // namespace detail
@@ -385,9 +2665,29 @@ namespace detail {
 struct DetectorVTable {
     void (*destroy)(void*) noexcept;
     Status (*update)(void*, const DetectorConfig&) noexcept;
-    Status (*prepare_binding)(void*, int, int, int) noexcept;
+    Status (*prepare_binding)(void*, int, int, int, int) noexcept;
+    Status (*prepare_binding_pool)(void*, const GridSpec*, std::size_t, int, int) noexcept;
     Result<VecQuad> (*detect)(void*, const Image&) noexcept;
     Result<VecQuad> (*detect_bound)(void*, const Image&, int) noexcept;
+    Status (*detect_ex)(void*, const Image&, VecDetection&) noexcept;
+    Status (*detect_bound_ex)(void*, const Image&, int, VecDetection&) noexcept;
+    Result<std::vector<VecQuad>> (*detect_batch)(void*, const Image*, std::size_t) noexcept;
+    Status (*detect_rois)(void*, const Image&, const Rect*, std::size_t, std::vector<VecDetection>&) noexcept;
+    Result<Ticket> (*submit)(void*, const Image&) noexcept;
+    bool (*poll)(const void*, Ticket) noexcept;
+    Result<VecQuad> (*wait)(void*, Ticket) noexcept;
+    Status (*last_tile_timings)(const void*, std::vector<TileTiming>&) noexcept;
+    Status (*detect_stream)(void*, const Image&, const MotionMask*, VecDetection&) noexcept;
+    void (*reset_stream)(void*) noexcept;
+    Status (*detect_track)(void*, const Image&, VecDetection&) noexcept;
+    void (*reset_track)(void*) noexcept;
+    Status (*stats)(const void*, DetectorStats&) noexcept;
+    void (*reset_stats)(void*) noexcept;
+    Result<std::string> (*end_profiling)(void*) noexcept;
+    Status (*warmup)(void*, const GridSpec*, std::size_t, int) noexcept;
+    Status (*reload)(void*, const DetectorConfig&) noexcept;
+    Status (*reload_async)(void*, const DetectorConfig&) noexcept;
+    Status (*wait_reload)(void*) noexcept;
 
     Task (*task)(const void*) noexcept;
     EngineKind (*engine)(const void*) noexcept;
@@ -401,7 +2701,9 @@ static const DetectorVTable kVt{
     // update
     [](void* p, const DetectorConfig& cfg) noexcept -> Status {
         try {
-            return static_cast<detail::DetectorImpl*>(p)->update_config(cfg);
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->exclusive_gate();
+            return d->update_config(cfg);
         } catch (const std::exception& e) {
             return Status::Internal(std::string("update_config threw: ") + e.what());
         } catch (...) {
@@ -410,9 +2712,11 @@ static const DetectorVTable kVt{
     },
 
     // prepare_binding
-    [](void* p, int w, int h, int c) noexcept -> Status {
+    [](void* p, int w, int h, int c, int b) noexcept -> Status {
         try {
-            return static_cast<detail::DetectorImpl*>(p)->prepare_binding(w, h, c);
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->exclusive_gate();
+            return d->prepare_binding(w, h, c, b);
         } catch (const std::exception& e) {
             return Status::Internal(std::string("prepare_binding threw: ") + e.what());
         } catch (...) {
@@ -420,10 +2724,24 @@ static const DetectorVTable kVt{
         }
     },
 
+    // prepare_binding_pool
+    [](void* p, const GridSpec* sizes, std::size_t n, int c, int b) noexcept -> Status {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->exclusive_gate();
+            return d->prepare_binding_pool(sizes, n, c, b);
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("prepare_binding_pool threw: ") + e.what());
+        } catch (...) {
+            return Status::Internal("prepare_binding_pool threw (unknown)");
+        }
+    },
+
     // detect
     [](void* p, const Image& img) noexcept -> Result<VecQuad> {
         try {
-            return static_cast<detail::DetectorImpl*>(p)->detect(img);
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            return d->shared_call([&] { return d->detect(img); });
         } catch (const std::exception& e) {
             return Result<VecQuad>::Err(Status::Internal(std::string("detect threw: ") + e.what()));
         } catch (...) {
@@ -434,7 +2752,8 @@ static const DetectorVTable kVt{
     // detect_bound
     [](void* p, const Image& img, int ctx) noexcept -> Result<VecQuad> {
         try {
-            return static_cast<detail::DetectorImpl*>(p)->detect_bound(img, ctx);
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            return d->shared_call([&] { return d->detect_bound(img, ctx); });
         } catch (const std::exception& e) {
             return Result<VecQuad>::Err(Status::Internal(std::string("detect_bound threw: ") + e.what()));
         } catch (...) {
@@ -442,6 +2761,211 @@ static const DetectorVTable kVt{
         }
     },
 
+    // detect_ex
+    [](void* p, const Image& img, VecDetection& out) noexcept -> Status {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            return d->shared_call([&] { return d->detect_ex(img, out); });
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("detect_ex threw: ") + e.what());
+        } catch (...) {
+            return Status::Internal("detect_ex threw (unknown)");
+        }
+    },
+
+    // detect_bound_ex
+    [](void* p, const Image& img, int ctx, VecDetection& out) noexcept -> Status {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            return d->shared_call([&] { return d->detect_bound_ex(img, ctx, out); });
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("detect_bound_ex threw: ") + e.what());
+        } catch (...) {
+            return Status::Internal("detect_bound_ex threw (unknown)");
+        }
+    },
+
+    // detect_batch
+    [](void* p, const Image* imgs, std::size_t n) noexcept -> Result<std::vector<VecQuad>> {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->detect_batch(imgs, n);
+        } catch (const std::bad_alloc&) {
+            return Result<std::vector<VecQuad>>::Err(Status::OutOfMemory("detect_batch: bad_alloc"));
+        } catch (const std::exception& e) {
+            return Result<std::vector<VecQuad>>::Err(Status::Internal(std::string("detect_batch threw: ") + e.what()));
+        } catch (...) {
+            return Result<std::vector<VecQuad>>::Err(Status::Internal("detect_batch threw (unknown)"));
+        }
+    },
+
+    // detect_rois
+    [](void* p, const Image& img, const Rect* rois, std::size_t n, std::vector<VecDetection>& out) noexcept -> Status {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->detect_rois(img, rois, n, out);
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("detect_rois threw: ") + e.what());
+        } catch (...) {
+            return Status::Internal("detect_rois threw (unknown)");
+        }
+    },
+
+    // submit
+    [](void* p, const Image& img) noexcept -> Result<Ticket> {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            return d->shared_call([&] { return d->submit(img); });
+        } catch (const std::exception& e) {
+            return Result<Ticket>::Err(Status::Internal(std::string("submit threw: ") + e.what()));
+        } catch (...) {
+            return Result<Ticket>::Err(Status::Internal("submit threw (unknown)"));
+        }
+    },
+
+    // poll
+    [](const void* p, Ticket t) noexcept -> bool {
+        try {
+            auto* d = static_cast<const detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->poll(t);
+        } catch (...) {
+            return false;
+        }
+    },
+
+    // wait
+    [](void* p, Ticket t) noexcept -> Result<VecQuad> {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->wait(t);
+        } catch (const std::exception& e) {
+            return Result<VecQuad>::Err(Status::Internal(std::string("wait threw: ") + e.what()));
+        } catch (...) {
+            return Result<VecQuad>::Err(Status::Internal("wait threw (unknown)"));
+        }
+    },
+
+    // last_tile_timings
+    [](const void* p, std::vector<TileTiming>& out) noexcept -> Status {
+        try {
+            auto* d = static_cast<const detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->last_tile_timings(out);
+        } catch (const std::exception& e) {
+            out.clear();
+            return Status::Internal(std::string("last_tile_timings threw: ") + e.what());
+        }
+    },
+
+    // detect_stream
+    [](void* p, const Image& img, const MotionMask* mask, VecDetection& out) noexcept -> Status {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->detect_stream(img, mask, out);
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("detect_stream threw: ") + e.what());
+        } catch (...) {
+            return Status::Internal("detect_stream threw (unknown)");
+        }
+    },
+
+    // reset_stream
+    [](void* p) noexcept {
+        auto* d = static_cast<detail::DetectorImpl*>(p);
+        try {
+            const auto gate = d->shared_gate();
+            d->reset_stream();
+        } catch (...) {
+        }
+    },
+
+    // detect_track
+    [](void* p, const Image& img, VecDetection& out) noexcept -> Status {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->detect_track(img, out);
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("detect_track threw: ") + e.what());
+        } catch (...) {
+            return Status::Internal("detect_track threw (unknown)");
+        }
+    },
+
+    // reset_track
+    [](void* p) noexcept {
+        auto* d = static_cast<detail::DetectorImpl*>(p);
+        try {
+            const auto gate = d->shared_gate();
+            d->reset_track();
+        } catch (...) {
+        }
+    },
+
+    // stats
+    [](const void* p, DetectorStats& out) noexcept -> Status {
+        try {
+            auto* d = static_cast<const detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->stats(out);
+        } catch (const std::exception& e) {
+            out = DetectorStats{};
+            return Status::Internal(std::string("stats threw: ") + e.what());
+        }
+    },
+
+    // reset_stats
+    [](void* p) noexcept {
+        auto* d = static_cast<detail::DetectorImpl*>(p);
+        try {
+            const auto gate = d->shared_gate();
+            d->reset_stats();
+        } catch (...) {
+        }
+    },
+
+    // end_profiling
+    [](void* p) noexcept -> Result<std::string> {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->shared_gate();
+            return d->end_profiling();
+        } catch (const std::exception& e) {
+            return Result<std::string>::Err(Status::Internal(std::string("end_profiling threw: ") + e.what()));
+        }
+    },
+
+    // warmup
+    [](void* p, const GridSpec* shapes, std::size_t n, int iterations) noexcept -> Status {
+        try {
+            auto* d = static_cast<detail::DetectorImpl*>(p);
+            const auto gate = d->exclusive_gate();
+            return d->warmup(shapes, n, iterations);
+        } catch (const std::exception& e) {
+            return Status::Internal(std::string("warmup threw: ") + e.what());
+        } catch (...) {
+            return Status::Internal("warmup threw (unknown)");
+        }
+    },
+
+    // reload (gates itself: the build runs while other calls proceed)
+    [](void* p, const DetectorConfig& cfg) noexcept -> Status {
+        return static_cast<detail::DetectorImpl*>(p)->reload(cfg);
+    },
+
+    // reload_async
+    [](void* p, const DetectorConfig& cfg) noexcept -> Status {
+        return static_cast<detail::DetectorImpl*>(p)->reload_async(cfg);
+    },
+
+    // wait_reload
+    [](void* p) noexcept -> Status { return static_cast<detail::DetectorImpl*>(p)->wait_reload(); },
+
     // task
     [](const void* p) noexcept -> Task { return static_cast<const detail::DetectorImpl*>(p)->task(); },
 
@@ -542,11 +3066,21 @@ Status Detector::update_config(const DetectorConfig& cfg) noexcept {
 }
 
 /// @brief Prepares binding resources via the internal vtable boundary.
-Status Detector::prepare_binding(int width, int height, int contexts) noexcept {
+Status Detector::prepare_binding(int width, int height, int contexts, int max_batch) noexcept {
     if (!impl_ || !vtbl_) return Status::Invalid("Detector::prepare_binding: invalid detector");
     if (width <= 0 || height <= 0) return Status::Invalid("Detector::prepare_binding: non-positive w/h");
     if (contexts <= 0) contexts = 1;
-    return vtbl_->prepare_binding(impl_, width, height, contexts);
+    if (max_batch <= 0) max_batch = 1;
+    return vtbl_->prepare_binding(impl_, width, height, contexts, max_batch);
+}
+
+/// @brief Prepares a multi-resolution binding pool via the internal vtable boundary.
+Status Detector::prepare_binding_pool(const GridSpec* sizes, std::size_t count, int contexts, int max_batch) noexcept {
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::prepare_binding_pool: invalid detector");
+    if (!sizes || count == 0) return Status::Invalid("Detector::prepare_binding_pool: no sizes");
+    if (contexts <= 0) contexts = 1;
+    if (max_batch <= 0) max_batch = 1;
+    return vtbl_->prepare_binding_pool(impl_, sizes, count, contexts, max_batch);
 }
 
 /// @brief Runs detection via the internal vtable boundary.
@@ -561,6 +3095,125 @@ Result<VecQuad> Detector::detect_bound(const Image& image, int ctx_idx) noexcept
     return vtbl_->detect_bound(impl_, image, ctx_idx);
 }
 
+/// @brief Runs structured detection into a caller-owned buffer via the internal vtable boundary.
+Status Detector::detect_ex(const Image& image, VecDetection& out) noexcept {
+    out.clear();
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::detect_ex: invalid detector");
+    return vtbl_->detect_ex(impl_, image, out);
+}
+
+/// @brief Runs bound structured detection into a caller-owned buffer via the internal vtable boundary.
+Status Detector::detect_bound_ex(const Image& image, int ctx_idx, VecDetection& out) noexcept {
+    out.clear();
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::detect_bound_ex: invalid detector");
+    return vtbl_->detect_bound_ex(impl_, image, ctx_idx, out);
+}
+
+/// @brief Runs multi-image detection via the internal vtable boundary.
+Result<std::vector<VecQuad>> Detector::detect_batch(const Image* images, std::size_t count) noexcept {
+    if (!impl_ || !vtbl_)
+        return Result<std::vector<VecQuad>>::Err(Status::Invalid("Detector::detect_batch: invalid detector"));
+    return vtbl_->detect_batch(impl_, images, count);
+}
+
+/// @brief Runs crop-and-detect over regions of one image via the internal vtable boundary.
+Status Detector::detect_rois(const Image& image, const Rect* rois, std::size_t count,
+                             std::vector<VecDetection>& out) noexcept {
+    out.clear();
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::detect_rois: invalid detector");
+    return vtbl_->detect_rois(impl_, image, rois, count, out);
+}
+
+/// @brief Submits a frame to the asynchronous pipeline via the internal vtable boundary.
+Result<Ticket> Detector::submit(const Image& image) noexcept {
+    if (!impl_ || !vtbl_) return Result<Ticket>::Err(Status::Invalid("Detector::submit: invalid detector"));
+    return vtbl_->submit(impl_, image);
+}
+
+/// @brief Checks ticket completion via the internal vtable boundary.
+bool Detector::poll(Ticket ticket) const noexcept {
+    return (impl_ && vtbl_) ? vtbl_->poll(impl_, ticket) : false;
+}
+
+/// @brief Waits for a submitted frame via the internal vtable boundary.
+Result<VecQuad> Detector::wait(Ticket ticket) noexcept {
+    if (!impl_ || !vtbl_) return Result<VecQuad>::Err(Status::Invalid("Detector::wait: invalid detector"));
+    return vtbl_->wait(impl_, ticket);
+}
+
+/// @brief Reads the tile timings of the most recent tiled frame via the internal vtable boundary.
+Status Detector::last_tile_timings(std::vector<TileTiming>& out) const noexcept {
+    out.clear();
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::last_tile_timings: invalid detector");
+    return vtbl_->last_tile_timings(impl_, out);
+}
+
+/// @brief Streaming detection via the internal vtable boundary.
+Status Detector::detect_stream(const Image& frame, VecDetection& out, const MotionMask* motion_mask) noexcept {
+    out.clear();
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::detect_stream: invalid detector");
+    return vtbl_->detect_stream(impl_, frame, motion_mask, out);
+}
+
+/// @brief Drops the streaming tile cache via the internal vtable boundary.
+void Detector::reset_stream() noexcept {
+    if (impl_ && vtbl_) vtbl_->reset_stream(impl_);
+}
+
+/// @brief Tracking-assisted streaming detection via the internal vtable boundary.
+Status Detector::detect_track(const Image& frame, VecDetection& out) noexcept {
+    out.clear();
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::detect_track: invalid detector");
+    return vtbl_->detect_track(impl_, frame, out);
+}
+
+/// @brief Drops the tracks of detect_track via the internal vtable boundary.
+void Detector::reset_track() noexcept {
+    if (impl_ && vtbl_) vtbl_->reset_track(impl_);
+}
+
+/// @brief Reads the stage statistics via the internal vtable boundary.
+Status Detector::stats(DetectorStats& out) const noexcept {
+    out = DetectorStats{};
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::stats: invalid detector");
+    return vtbl_->stats(impl_, out);
+}
+
+/// @brief Zeroes the stage statistics via the internal vtable boundary.
+void Detector::reset_stats() noexcept {
+    if (impl_ && vtbl_) vtbl_->reset_stats(impl_);
+}
+
+/// @brief Finishes the ORT profiling trace via the internal vtable boundary.
+Result<std::string> Detector::end_profiling() noexcept {
+    if (!impl_ || !vtbl_) return Result<std::string>::Err(Status::Invalid("Detector::end_profiling: invalid detector"));
+    return vtbl_->end_profiling(impl_);
+}
+
+/// @brief Warms the contexts up via the internal vtable boundary.
+Status Detector::warmup(const GridSpec* shapes, std::size_t count, int iterations) noexcept {
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::warmup: invalid detector");
+    return vtbl_->warmup(impl_, shapes, count, iterations);
+}
+
+/// @brief Rebuilds the engine from a new configuration and swaps it in via the internal vtable boundary.
+Status Detector::reload(const DetectorConfig& cfg) noexcept {
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::reload: invalid detector");
+    return vtbl_->reload(impl_, cfg);
+}
+
+/// @brief Starts a background reload via the internal vtable boundary.
+Status Detector::reload_async(const DetectorConfig& cfg) noexcept {
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::reload_async: invalid detector");
+    return vtbl_->reload_async(impl_, cfg);
+}
+
+/// @brief Waits for the background reload via the internal vtable boundary.
+Status Detector::wait_reload() noexcept {
+    if (!impl_ || !vtbl_) return Status::Invalid("Detector::wait_reload: invalid detector");
+    return vtbl_->wait_reload(impl_);
+}
+
 /**
  * @brief Applies the requested runtime policy (thread/CPU/memory binding).
  *
@@ -569,12 +3222,36 @@ Result<VecQuad> Detector::detect_bound(const Image& image, int ctx_idx) noexcept
  * On non-supported platforms, the implementation may return @ref idet::Status::Ok()
  * without applying any binding.
  *
+ * With @ref idet::RuntimePolicy::ort_global_pools the process-wide ORT environment and its
+ * global pools are created right after placement, so pool threads start inside the chosen mask.
+ * The library worker pool threads the policy asks for are started the same way (and pinned with
+ * @ref idet::RuntimePolicy::pin_worker_threads).
+ *
  * @param policy Runtime policy (CPU set, NUMA node set, binding knobs).
  * @param verbose If true, prints diagnostic details (best-effort).
  * @return Status::Ok() if applied (or not supported but safely ignored), otherwise an error status.
  */
 IDET_API Status setup_runtime_policy(const RuntimePolicy& policy, bool verbose) noexcept {
-    return platform::setup_runtime_policy_impl(policy, verbose);
+    Status st = platform::setup_runtime_policy_impl(policy, verbose);
+    if (!st.ok()) return st;
+
+    try {
+        if (policy.ort_global_pools) {
+            engine::OrtEnvironment::global().env(policy);
+            if (!engine::OrtEnvironment::global().has_global_pools())
+                return Status::Invalid("setup_runtime_policy: ORT environment already exists without global pools");
+        }
+        prepare_worker_pool_(policy);
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("setup_runtime_policy: bad_alloc");
+    } catch (const Ort::Exception& e) {
+        return Status::Invalid(std::string("setup_runtime_policy: ORT exception: ") + e.what());
+    } catch (const std::exception& e) {
+        return Status::Internal(std::string("setup_runtime_policy: worker pool: ") + e.what());
+    } catch (...) {
+        return Status::Internal("setup_runtime_policy: unknown");
+    }
+    return st;
 }
 
 } // namespace idet
@@ -5,7 +5,8 @@
  * @details
  * This translation unit implements:
  * - @ref idet::Image::copy_from        : deep copy into an owning buffer.
- * - @ref idet::load_image              : image decoding from disk (stb_image) and format conversion.
+ * - @ref idet::load_image              : image decoding from disk (stb_image) and format conversion,
+ *   optionally at a reduced scale (OpenCV @c IMREAD_REDUCED_COLOR_*).
  * - @ref idet::load_image_or_throw     : throwing convenience wrapper.
  *
  * Decoding is performed via stb_image (@c stbi_load). The implementation:
@@ -21,6 +22,8 @@
 
 #include "image.h"
 
+#include "internal/opencv_headers.h" // IWYU pragma: keep
+
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
@@ -146,6 +149,40 @@ void flip_y_in_place(std::uint8_t* data, int w, int h, int ch) {
     }
 }
 
+/**
+ * @brief Picks the decode reduction (1, 2, 4 or 8) for a source image and a target longest side.
+ *
+ * @details
+ * Returns the largest factor whose reduced longest side (rounded up, as libjpeg does) is still
+ * at least @p target, so the engine's own resize keeps its full input resolution.
+ *
+ * @param w Source width in pixels.
+ * @param h Source height in pixels.
+ * @param target Target longest side in pixels (<= 0: no reduction).
+ */
+[[nodiscard]] int pick_reduction(int w, int h, int target) noexcept {
+    if (target <= 0) return 1;
+    const int side = std::max(w, h);
+    for (int d = 8; d > 1; d /= 2) {
+        if ((side + d - 1) / d >= target) return d;
+    }
+    return 1;
+}
+
+/// @brief OpenCV conversion from BGR to @p fmt (-1: already BGR).
+[[nodiscard]] int bgr_conversion(PixelFormat fmt) noexcept {
+    switch (fmt) {
+    case PixelFormat::RGB_U8:
+        return cv::COLOR_BGR2RGB;
+    case PixelFormat::RGBA_U8:
+        return cv::COLOR_BGR2RGBA;
+    case PixelFormat::BGRA_U8:
+        return cv::COLOR_BGR2BGRA;
+    default:
+        return -1;
+    }
+}
+
 } // namespace
 
 /**
@@ -287,6 +324,69 @@ IDET_API Result<Image> load_image(const std::string& path, PixelFormat output_fo
     return Result<Image>::Ok(std::move(img));
 }
 
+/**
+ * @brief Loads an image from disk, decoding it at the reduction picked from the target size.
+ *
+ * @details
+ * The source size comes from the file header (@c stbi_info), so choosing the factor costs no
+ * decode. Reduced decodes go through @c cv::imread with @c IMREAD_REDUCED_COLOR_{2,4,8}: JPEG is
+ * DCT-scaled by libjpeg, other codecs decode and downsample inside OpenCV. The BGR result is
+ * adopted as is, or converted to the requested format by one @c cv::cvtColor over the reduced
+ * pixels; the optional flip also runs on the reduced image.
+ *
+ * @param path Filesystem path to the input image file.
+ * @param options Output format, flip and target size.
+ * @return `Result<LoadedImage>` with the image and its scale on success, or an error status on failure.
+ */
+IDET_API Result<LoadedImage> load_image(const std::string& path, const LoadOptions& options) noexcept {
+    using R = Result<LoadedImage>;
+
+    const int out_ch = get_channels(options.output_format);
+    if (out_ch != 3 && out_ch != 4) return R::Err(Status::Unsupported("load_image: unsupported output PixelFormat"));
+
+    LoadedImage out;
+    int n = 0;
+    const bool known = options.target_max_side > 0 &&
+                       stbi_info(path.c_str(), &out.source_width, &out.source_height, &n) != 0;
+    const int d = known ? pick_reduction(out.source_width, out.source_height, options.target_max_side) : 1;
+
+    if (d == 1) {
+        auto r = load_image(path, options.output_format, options.flip_y);
+        if (!r.ok()) return R::Err(r.status());
+        out.image = std::move(r.value());
+        out.source_width = out.image.view().width;
+        out.source_height = out.image.view().height;
+        return R::Ok(std::move(out));
+    }
+
+    try {
+        const int reduced = d == 2 ? cv::IMREAD_REDUCED_COLOR_2 : d == 4 ? cv::IMREAD_REDUCED_COLOR_4
+                                                                         : cv::IMREAD_REDUCED_COLOR_8;
+        auto mat = std::make_shared<cv::Mat>(cv::imread(path, reduced | cv::IMREAD_IGNORE_ORIENTATION));
+        if (mat->empty()) return R::Err(Status::DecodeError("load_image: cv::imread failed: " + path));
+
+        const int code = bgr_conversion(options.output_format);
+        if (code >= 0) {
+            cv::Mat converted;
+            cv::cvtColor(*mat, converted, code);
+            *mat = std::move(converted);
+        }
+        if (options.flip_y) cv::flip(*mat, *mat, 0);
+
+        out.image = Image::wrap(options.output_format, mat->cols, mat->rows, mat->data, mat->step[0],
+                                std::static_pointer_cast<void>(mat));
+        if (!out.image) return R::Err(Status::Internal("load_image: invalid Image after decode"));
+
+        out.scale_x = (float)mat->cols / (float)out.source_width;
+        out.scale_y = (float)mat->rows / (float)out.source_height;
+        return R::Ok(std::move(out));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("load_image: allocation failed"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::DecodeError(std::string("load_image: ") + e.what()));
+    }
+}
+
 /**
  * @brief Loads an image from disk or throws on failure.
  *
@@ -0,0 +1,83 @@
+/**
+ * @file chw_source.h
+ * @ingroup idet_internal
+ * @brief Maps an @ref idet::ImageView onto the source descriptors of the fused resize kernel.
+ *
+ * @note
+ * This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "algo/preprocess.h"
+#include "image.h"
+
+namespace idet::internal {
+
+/**
+ * @brief Channel order the resize kernels use to read a packed @p f directly.
+ *
+ * @param f Pixel format of the view.
+ * @param order Set on success.
+ * @return False for non-packed (YUV) or unknown formats.
+ */
+[[nodiscard]] inline bool packed_channel_order(idet::PixelFormat f, algo::ChannelOrder& order) noexcept {
+    switch (f) {
+    case idet::PixelFormat::BGR_U8:
+        order = algo::ChannelOrder::BGR;
+        return true;
+    case idet::PixelFormat::RGB_U8:
+        order = algo::ChannelOrder::RGB;
+        return true;
+    case idet::PixelFormat::BGRA_U8:
+        order = algo::ChannelOrder::BGRA;
+        return true;
+    case idet::PixelFormat::RGBA_U8:
+        order = algo::ChannelOrder::RGBA;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Resolves the luma/chroma planes of a 4:2:0 view (defaults included, see @ref idet::ImageView::chroma).
+ *
+ * @param v A valid view with a YUV format.
+ * @return Plane descriptor; empty() if @p v is not a YUV view.
+ */
+[[nodiscard]] inline algo::Yuv420Planes yuv420_planes(const idet::ImageView& v) noexcept {
+    algo::Yuv420Planes p;
+    if (!v.is_yuv()) return p;
+
+    p.width = v.width;
+    p.height = v.height;
+    p.y = v.data;
+    p.y_stride = v.stride_bytes;
+
+    const std::uint8_t* c0 = v.chroma_plane(0);
+    switch (v.format) {
+    case idet::PixelFormat::NV12_U8:
+        p.u = c0;
+        p.v = c0 ? c0 + 1 : nullptr;
+        p.u_stride = p.v_stride = v.chroma_stride(0);
+        p.chroma_step = 2;
+        break;
+    case idet::PixelFormat::NV21_U8:
+        p.v = c0;
+        p.u = c0 ? c0 + 1 : nullptr;
+        p.u_stride = p.v_stride = v.chroma_stride(0);
+        p.chroma_step = 2;
+        break;
+    default: // I420
+        p.u = c0;
+        p.u_stride = v.chroma_stride(0);
+        p.v = v.chroma_plane(1);
+        p.v_stride = v.chroma_stride(1);
+        p.chroma_step = 1;
+        break;
+    }
+    return p;
+}
+
+} // namespace idet::internal
@@ -36,6 +36,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <utility>
 
@@ -52,6 +53,8 @@ namespace idet::internal {
  *   the existing buffer (no copy). In this case, the input @ref idet::Image is stored inside the
  *   returned object to keep the backing memory alive.
  * - If input format is RGB/RGBA/BGRA U8, @c cv::cvtColor is used to produce a new BGR matrix.
+ * - If input format is NV12/NV21/I420, the planes are viewed (or, for split / padded planes, packed
+ *   into one contiguous buffer) and converted with @c cv::cvtColor.
  *
  * Output:
  * - @ref mat() always returns a @c cv::Mat with type @c CV_8UC3 representing BGR pixels on success.
@@ -96,6 +99,36 @@ class BgrMat final {
      * converts them into @ref Status::Internal.
      */
     [[nodiscard]] static idet::Result<BgrMat> from(idet::Image img) noexcept {
+        return from_(std::move(img), nullptr);
+    }
+
+    /**
+     * @brief Same as @ref from, but converts into a caller-owned reusable buffer.
+     *
+     * @details
+     * When conversion is required, the result is written into @p scratch and @ref mat() shares its
+     * pixel buffer. Once @p scratch has the right size it is reused, so steady-state calls with a
+     * fixed frame size do not allocate. The returned matrix is valid until @p scratch is
+     * reused for another frame.
+     *
+     * @param img Input image.
+     * @param scratch Per-context conversion buffer (unused for BGR inputs).
+     */
+    [[nodiscard]] static idet::Result<BgrMat> from(idet::Image img, cv::Mat& scratch) noexcept {
+        return from_(std::move(img), &scratch);
+    }
+
+    /**
+     * @brief Returns the resulting BGR matrix.
+     * @return Const reference to the stored @c cv::Mat (type is @c CV_8UC3 on success).
+     */
+    [[nodiscard]] const cv::Mat& mat() const noexcept {
+        return mat_;
+    }
+
+  private:
+    /** @brief Shared implementation of both @ref from overloads; @p scratch may be null. */
+    [[nodiscard]] static idet::Result<BgrMat> from_(idet::Image img, cv::Mat* scratch) noexcept {
         const auto& v = img.view();
         if (!v.is_valid()) {
             return idet::Result<BgrMat>::Err(idet::Status::Invalid("BgrMat::from: invalid Image"));
@@ -113,6 +146,8 @@ class BgrMat final {
             return idet::Result<BgrMat>::Ok(std::move(out));
         }
 
+        if (v.is_yuv()) return from_yuv_(v, scratch);
+
         const int ch = v.channels();
         if (ch != 3 && ch != 4) {
             return idet::Result<BgrMat>::Err(idet::Status::Unsupported("BgrMat::from: unsupported PixelFormat"));
@@ -131,7 +166,12 @@ class BgrMat final {
         }
 
         try {
-            cv::cvtColor(src, out.mat_, code);
+            if (scratch) {
+                cv::cvtColor(src, *scratch, code);
+                out.mat_ = *scratch;
+            } else {
+                cv::cvtColor(src, out.mat_, code);
+            }
         } catch (const cv::Exception& e) {
             return idet::Result<BgrMat>::Err(
                 idet::Status::Internal(std::string("BgrMat::from: cvtColor failed: ") + e.what()));
@@ -146,14 +186,64 @@ class BgrMat final {
     }
 
     /**
-     * @brief Returns the resulting BGR matrix.
-     * @return Const reference to the stored @c cv::Mat (type is @c CV_8UC3 on success).
+     * @brief YUV 4:2:0 branch of @ref from_.
+     *
+     * @c cv::cvtColor expects one contiguous @c (h*3/2) x w single-channel buffer. Frames already in
+     * that layout are converted through a view; otherwise the planes are packed row by row first.
      */
-    [[nodiscard]] const cv::Mat& mat() const noexcept {
-        return mat_;
+    [[nodiscard]] static idet::Result<BgrMat> from_yuv_(const idet::ImageView& v, cv::Mat* scratch) noexcept {
+        using PF = idet::PixelFormat;
+        const int code = v.format == PF::NV12_U8   ? cv::COLOR_YUV2BGR_NV12
+                         : v.format == PF::NV21_U8 ? cv::COLOR_YUV2BGR_NV21
+                                                   : cv::COLOR_YUV2BGR_I420;
+        const std::size_t w = static_cast<std::size_t>(v.width);
+        const int h = v.height;
+        const bool i420 = v.format == PF::I420_U8;
+
+        const std::uint8_t* c0 = v.chroma_plane(0);
+        const std::uint8_t* c1 = v.chroma_plane(1);
+        const std::size_t cs0 = v.chroma_stride(0);
+        const std::size_t cs1 = v.chroma_stride(1);
+        const std::size_t y_bytes = w * static_cast<std::size_t>(h);
+        const bool contiguous = v.stride_bytes == w && c0 == v.data + y_bytes &&
+                                (i420 ? (cs0 == w / 2 && cs1 == w / 2 && c1 == c0 + y_bytes / 4) : cs0 == w);
+
+        BgrMat out;
+        try {
+            cv::Mat packed;
+            if (contiguous) {
+                packed = cv::Mat(h * 3 / 2, v.width, CV_8UC1, const_cast<std::uint8_t*>(v.data));
+            } else {
+                packed.create(h * 3 / 2, v.width, CV_8UC1);
+                std::uint8_t* dst = packed.ptr<std::uint8_t>(0);
+                for (int y = 0; y < h; ++y, dst += w)
+                    std::memcpy(dst, v.data + static_cast<std::size_t>(y) * v.stride_bytes, w);
+                const std::size_t crow = i420 ? w / 2 : w;
+                for (int y = 0; y < h / 2; ++y, dst += crow)
+                    std::memcpy(dst, c0 + static_cast<std::size_t>(y) * cs0, crow);
+                for (int y = 0; i420 && y < h / 2; ++y, dst += crow)
+                    std::memcpy(dst, c1 + static_cast<std::size_t>(y) * cs1, crow);
+            }
+
+            if (scratch) {
+                cv::cvtColor(packed, *scratch, code);
+                out.mat_ = *scratch;
+            } else {
+                cv::cvtColor(packed, out.mat_, code);
+            }
+        } catch (const cv::Exception& e) {
+            return idet::Result<BgrMat>::Err(
+                idet::Status::Internal(std::string("BgrMat::from: cvtColor failed: ") + e.what()));
+        } catch (const std::exception& e) {
+            return idet::Result<BgrMat>::Err(
+                idet::Status::Internal(std::string("BgrMat::from: exception: ") + e.what()));
+        } catch (...) {
+            return idet::Result<BgrMat>::Err(idet::Status::Internal("BgrMat::from: unknown exception"));
+        }
+
+        return idet::Result<BgrMat>::Ok(std::move(out));
     }
 
-  private:
     /**
      * @brief Returns OpenCV color conversion code to produce BGR from a given pixel format.
      *
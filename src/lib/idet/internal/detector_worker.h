@@ -0,0 +1,122 @@
+/**
+ * @file detector_worker.h
+ * @ingroup idet_internal
+ * @brief Dedicated worker thread that owns one detector and runs every call on it.
+ *
+ * @details
+ * Used by @ref idet::DetectorGroup (one worker per NUMA replica) and @ref idet::MultiDetector
+ * (one worker per model). The first job posted to a worker typically places the thread (CPU
+ * affinity, memory policy) and creates the detector, so the ORT intra-op pool spawned by session
+ * creation and every buffer first-touched afterwards inherit that placement. Tiles and
+ * postprocessing run on a worker-owned @ref idet::platform::ThreadPool whose threads are started
+ * from the placed worker instead of the process-wide pool.
+ *
+ * @note
+ * This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "idet.h"
+
+#include "platform/thread_pool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace idet::internal {
+
+/**
+ * @brief One worker thread owning one detector.
+ *
+ * @details
+ * Calls are executed strictly in submission order on the worker. @ref pending counts queued
+ * plus running calls and serves as a load metric for routing.
+ */
+class DetectorWorker final {
+  public:
+    DetectorWorker() {
+        worker_ = std::thread([this] { loop_(); });
+    }
+
+    /** @brief Runs the queued calls, destroys the detector on the worker and joins it. */
+    ~DetectorWorker() {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    DetectorWorker(const DetectorWorker&) = delete;
+    DetectorWorker& operator=(const DetectorWorker&) = delete;
+
+    /**
+     * @brief Queues @p fn on the worker and returns a future for its result.
+     * @throws std::bad_alloc On allocation failure.
+     */
+    template <class F> auto post(F&& fn) -> std::future<decltype(fn())> {
+        using R = decltype(fn());
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(fn));
+        std::future<R> fut = task->get_future();
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            jobs_.emplace_back([task] { (*task)(); });
+        }
+        cv_.notify_one();
+        return fut;
+    }
+
+    /// @brief Runs @p fn on the worker and waits for it, keeping @ref pending accurate meanwhile.
+    template <class F> auto call(F&& fn) -> decltype(fn()) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        struct Done {
+            std::atomic<int>& n;
+            ~Done() { n.fetch_sub(1, std::memory_order_relaxed); }
+        } done{pending_};
+        return post(std::forward<F>(fn)).get();
+    }
+
+    int pending() const noexcept { return pending_.load(std::memory_order_relaxed); }
+
+    /// @brief Detector of this worker; touch it only from inside @ref post / @ref call.
+    Detector& detector() noexcept { return det_; }
+
+  private:
+    void loop_() {
+        platform::ThreadPool::set_current(&pool_);
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lk(mu_);
+                cv_.wait(lk, [&] { return stop_ || !jobs_.empty(); });
+                if (jobs_.empty()) break; // stop_ set and queue drained
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+        det_.reset(); // release sessions/buffers on the owning thread
+    }
+
+    platform::ThreadPool pool_; ///< Workers started from this thread; current pool of the worker
+    Detector det_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    bool stop_ = false;
+    std::atomic<int> pending_{0};
+
+    std::thread worker_; ///< Declared last: started after every other member is initialized
+};
+
+} // namespace idet::internal
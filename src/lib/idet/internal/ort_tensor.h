@@ -273,11 +273,83 @@ static inline TensorDesc make_desc_probmap(const std::vector<int64_t>& sh) noexc
     return d;
 }
 
+/**
+ * @brief Plane accessor specialized for one layout (see @ref extract_hw_channel for the contract).
+ *
+ * Resolved once per output shape with @ref plane_fn_for, so per-frame decoding calls straight into
+ * the layout's accessor instead of switching on @ref TensorDesc::layout.
+ */
+using PlaneFn = const float* (*)(const float* data, const TensorDesc& desc, int channel, std::vector<float>& scratch);
+
+/**
+ * @brief @ref PlaneFn instance for layout @p L.
+ *
+ * @details
+ * - @ref TensorLayout::NCHW: pointer into the channel plane of batch 0,
+ * - @ref TensorLayout::NHWC: channel gathered into @p scratch (a plain copy when C == 1),
+ * - @ref TensorLayout::N1HW / @ref TensorLayout::HW: @p data itself.
+ */
+template <TensorLayout L>
+const float* extract_plane(const float* data, const TensorDesc& desc, int channel, std::vector<float>& scratch) {
+    static_assert(L == TensorLayout::NCHW || L == TensorLayout::NHWC || L == TensorLayout::N1HW ||
+                      L == TensorLayout::HW,
+                  "extract_plane: not a probmap-like layout");
+    if (!data || desc.H <= 0 || desc.W <= 0) return nullptr;
+
+    const std::size_t hw = static_cast<std::size_t>(desc.H) * static_cast<std::size_t>(desc.W);
+    if constexpr (L == TensorLayout::N1HW || L == TensorLayout::HW) {
+        // Single-channel layouts: the buffer already represents an HxW plane.
+        (void)channel;
+        (void)scratch;
+        return data;
+    } else {
+        channel = std::max(0, channel);
+        if (desc.C > 0) channel = std::min<int>(channel, static_cast<int>(desc.C - 1));
+
+        if constexpr (L == TensorLayout::NCHW) {
+            // [N,C,H,W] — return pointer into channel plane (batch 0).
+            (void)scratch;
+            return data + static_cast<std::size_t>(channel) * hw;
+        } else {
+            // [N,H,W,C] — gather plane into scratch (batch 0).
+            const std::size_t C = static_cast<std::size_t>(std::max<int64_t>(1, desc.C));
+            scratch.resize(hw);
+            if (C == 1) {
+                std::copy(data, data + hw, scratch.data());
+                return scratch.data();
+            }
+            const float* src = data + static_cast<std::size_t>(channel);
+            for (std::size_t i = 0; i < hw; ++i)
+                scratch[i] = src[i * C];
+            return scratch.data();
+        }
+    }
+}
+
+/**
+ * @brief Accessor of @p layout, or null for layouts that are not probmap-like.
+ */
+static inline PlaneFn plane_fn_for(TensorLayout layout) noexcept {
+    switch (layout) {
+    case TensorLayout::NCHW:
+        return &extract_plane<TensorLayout::NCHW>;
+    case TensorLayout::NHWC:
+        return &extract_plane<TensorLayout::NHWC>;
+    case TensorLayout::N1HW:
+        return &extract_plane<TensorLayout::N1HW>;
+    case TensorLayout::HW:
+        return &extract_plane<TensorLayout::HW>;
+    default:
+        return nullptr;
+    }
+}
+
 /**
  * @brief Extract a contiguous HxW float plane for a given channel.
  *
  * This helper returns a pointer to a contiguous plane of size @c H*W floats that represents
- * the requested channel for batch 0.
+ * the requested channel for batch 0. It dispatches on @p desc at every call; hot paths resolve
+ * the accessor once with @ref plane_fn_for instead.
  *
  * Behavior by layout:
  * - @ref TensorLayout::NCHW:
@@ -305,35 +377,8 @@ static inline TensorDesc make_desc_probmap(const std::vector<int64_t>& sh) noexc
  */
 static inline const float* extract_hw_channel(const float* data, const TensorDesc& desc, int channel,
                                               std::vector<float>& scratch) {
-    if (!data) return nullptr;
-    if (desc.H <= 0 || desc.W <= 0) return nullptr;
-
-    const std::size_t hw = static_cast<std::size_t>(desc.H) * static_cast<std::size_t>(desc.W);
-
-    channel = std::max(0, channel);
-    if (desc.C > 0) channel = std::min<int>(channel, static_cast<int>(desc.C - 1));
-
-    switch (desc.layout) {
-    case TensorLayout::NCHW: {
-        // [N,C,H,W] — return pointer into channel plane (batch 0).
-        return data + static_cast<std::size_t>(channel) * hw;
-    }
-    case TensorLayout::NHWC: {
-        // [N,H,W,C] — gather plane into scratch (batch 0).
-        const std::size_t C = static_cast<std::size_t>(std::max<int64_t>(1, desc.C));
-        scratch.resize(hw);
-        for (std::size_t i = 0; i < hw; ++i) {
-            scratch[i] = data[i * C + static_cast<std::size_t>(channel)];
-        }
-        return scratch.data();
-    }
-    case TensorLayout::N1HW:
-    case TensorLayout::HW:
-        // Single-channel layouts: the buffer already represents an HxW plane.
-        return data;
-    default:
-        return nullptr;
-    }
+    const PlaneFn fn = plane_fn_for(desc.layout);
+    return fn ? fn(data, desc, channel, scratch) : nullptr;
 }
 
 } // namespace idet::internal
@@ -0,0 +1,187 @@
+/**
+ * @file stage_stats.h
+ * @ingroup idet_internal
+ * @brief Lock-free per-stage latency recording behind @ref idet::Detector::stats.
+ *
+ * @details
+ * @ref idet::internal::StatsCollector keeps one histogram per @ref idet::Stage in relaxed atomics,
+ * so concurrent tile workers and bound contexts record into it without locks.
+ * @ref IDET_STAGE_SCOPE times the enclosing scope into a collector.
+ *
+ * Recording is compiled in only when @c IDET_WITH_STATS is non-zero (Meson option
+ * @c idet_stats). Otherwise @ref IDET_STAGE_SCOPE expands to nothing and engines carry no
+ * collector, so the instrumented paths are identical to an uninstrumented build.
+ *
+ * @note
+ * This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "idet.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef IDET_WITH_STATS
+    #define IDET_WITH_STATS 0
+#endif
+
+namespace idet::internal {
+
+/**
+ * @brief Thread-safe accumulator of per-stage histograms and counters.
+ */
+class StatsCollector final {
+  public:
+    StatsCollector() noexcept {
+        reset();
+    }
+
+    StatsCollector(const StatsCollector&) = delete;
+    StatsCollector& operator=(const StatsCollector&) = delete;
+
+    /** @brief Records one sample of @p ns nanoseconds for stage @p s. */
+    void add(Stage s, std::uint64_t ns) noexcept {
+        Hist& h = hist_[(std::size_t)s];
+        h.count.fetch_add(1, std::memory_order_relaxed);
+        h.total_ns.fetch_add(ns, std::memory_order_relaxed);
+        h.buckets[(std::size_t)StageHistogram::bucket_of(ns / 1000u)].fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t m = h.max_ns.load(std::memory_order_relaxed);
+        while (ns > m && !h.max_ns.compare_exchange_weak(m, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Records one postprocessed frame.
+     *
+     * @param tiles Tiles of the frame (0 for untiled frames).
+     * @param candidates Detections entering suppression.
+     * @param kept Detections left after suppression.
+     * @param bytes Arena bytes used by suppression.
+     */
+    void add_frame(std::size_t tiles, std::size_t candidates, std::size_t kept, std::size_t bytes) noexcept {
+        frames_.fetch_add(1, std::memory_order_relaxed);
+        tiles_.fetch_add(tiles, std::memory_order_relaxed);
+        candidates_.fetch_add(candidates, std::memory_order_relaxed);
+        kept_.fetch_add(kept, std::memory_order_relaxed);
+        bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records one frame of the cascade pre-pass (see @ref idet::CascadeOptions).
+     *
+     * @param skipped The probe found nothing and the full pass did not run.
+     * @param cropped The full pass ran on the triggered region only.
+     */
+    void add_cascade(bool skipped, bool cropped) noexcept {
+        if (skipped) cascade_skipped_.fetch_add(1, std::memory_order_relaxed);
+        if (cropped) cascade_cropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** @brief Records one applied quality level change (see @ref idet::QualityOptions). */
+    void add_quality_change() noexcept {
+        quality_changes_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** @brief Copies the current values into @p out. */
+    void snapshot(DetectorStats& out) const noexcept {
+        for (int s = 0; s < kStageCount; ++s) {
+            const Hist& h = hist_[(std::size_t)s];
+            StageHistogram& o = out.stages[(std::size_t)s];
+            o.count = h.count.load(std::memory_order_relaxed);
+            o.total_ms = (double)h.total_ns.load(std::memory_order_relaxed) * 1e-6;
+            o.max_ms = (double)h.max_ns.load(std::memory_order_relaxed) * 1e-6;
+            for (int b = 0; b < StageHistogram::kBuckets; ++b)
+                o.buckets[(std::size_t)b] = h.buckets[(std::size_t)b].load(std::memory_order_relaxed);
+        }
+        out.frames = frames_.load(std::memory_order_relaxed);
+        out.tiles = tiles_.load(std::memory_order_relaxed);
+        out.candidates = candidates_.load(std::memory_order_relaxed);
+        out.kept = kept_.load(std::memory_order_relaxed);
+        out.bytes_allocated = bytes_.load(std::memory_order_relaxed);
+        out.cascade_skipped = cascade_skipped_.load(std::memory_order_relaxed);
+        out.cascade_cropped = cascade_cropped_.load(std::memory_order_relaxed);
+        out.quality_changes = quality_changes_.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Zeroes all values. */
+    void reset() noexcept {
+        for (Hist& h : hist_) {
+            h.count.store(0, std::memory_order_relaxed);
+            h.total_ns.store(0, std::memory_order_relaxed);
+            h.max_ns.store(0, std::memory_order_relaxed);
+            for (auto& b : h.buckets)
+                b.store(0, std::memory_order_relaxed);
+        }
+        frames_.store(0, std::memory_order_relaxed);
+        tiles_.store(0, std::memory_order_relaxed);
+        candidates_.store(0, std::memory_order_relaxed);
+        kept_.store(0, std::memory_order_relaxed);
+        bytes_.store(0, std::memory_order_relaxed);
+        cascade_skipped_.store(0, std::memory_order_relaxed);
+        cascade_cropped_.store(0, std::memory_order_relaxed);
+        quality_changes_.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    struct Hist {
+        std::atomic<std::uint64_t> count;
+        std::atomic<std::uint64_t> total_ns;
+        std::atomic<std::uint64_t> max_ns;
+        std::atomic<std::uint64_t> buckets[StageHistogram::kBuckets];
+    };
+
+    Hist hist_[kStageCount];
+    std::atomic<std::uint64_t> frames_;
+    std::atomic<std::uint64_t> tiles_;
+    std::atomic<std::uint64_t> candidates_;
+    std::atomic<std::uint64_t> kept_;
+    std::atomic<std::uint64_t> bytes_;
+    std::atomic<std::uint64_t> cascade_skipped_;
+    std::atomic<std::uint64_t> cascade_cropped_;
+    std::atomic<std::uint64_t> quality_changes_;
+};
+
+/**
+ * @brief Records the lifetime of the scope into a collector (no-op for a null collector).
+ */
+class StageTimer final {
+  public:
+    StageTimer(StatsCollector* c, Stage s) noexcept : c_(c), s_(s) {
+        if (c_) t0_ = std::chrono::steady_clock::now();
+    }
+
+    ~StageTimer() noexcept {
+        if (c_) {
+            const auto dt = std::chrono::steady_clock::now() - t0_;
+            c_->add(s_, (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count());
+        }
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+  private:
+    StatsCollector* c_;
+    Stage s_;
+    std::chrono::steady_clock::time_point t0_{};
+};
+
+} // namespace idet::internal
+
+#define IDET_STATS_CAT2_(a, b) a##b
+#define IDET_STATS_CAT_(a, b) IDET_STATS_CAT2_(a, b)
+
+/**
+ * @def IDET_STAGE_SCOPE
+ * @brief Times the rest of the enclosing scope as stage @p stage into collector pointer @p collector.
+ */
+#if IDET_WITH_STATS
+    #define IDET_STAGE_SCOPE(collector, stage)                                                                         \
+        const ::idet::internal::StageTimer IDET_STATS_CAT_(idet_stage_timer_, __LINE__)((collector), (stage))
+#else
+    #define IDET_STAGE_SCOPE(collector, stage) ((void)0)
+#endif
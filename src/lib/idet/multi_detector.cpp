@@ -0,0 +1,262 @@
+/**
+ * @file multi_detector.cpp
+ * @ingroup idet
+ * @brief Implementation of @ref idet::MultiDetector (several models on one frame).
+ *
+ * @details
+ * Every member is a plain @ref idet::Detector owned by one @ref idet::internal::DetectorWorker.
+ * The worker restricts itself to the member's CPU partition before it creates the detector, so
+ * the ORT intra-op pool and the worker-owned tile pool start inside the partition and the
+ * sessions of different members never share cores.
+ *
+ * A frame is handed to all members at once and the caller waits for every result. The frame is
+ * converted to BGR at most once (only when some member tiles and the frame is not BGR already);
+ * otherwise every engine reads the caller's pixels through its fused resize/normalize kernel.
+ */
+
+#include "idet.h"
+
+#include "internal/cv_bgr.h"
+#include "internal/detector_worker.h"
+#include "platform/cross_topology.h"
+
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace idet {
+
+namespace detail {
+
+/// @brief State behind @ref idet::MultiDetector.
+struct MultiDetectorImpl final {
+    std::vector<std::unique_ptr<internal::DetectorWorker>> members;
+    std::vector<std::vector<int>> cpus; ///< Partition per member (empty: not partitioned)
+    bool needs_bgr = false;             ///< Some member tiles, so it reads BGR frames
+};
+
+namespace {
+
+/// @brief True if @p cfg sends frames through the tiled path (which needs a BGR frame).
+bool tiled_config(const DetectorConfig& cfg) noexcept {
+    const GridSpec& g = cfg.infer.tiles_dim;
+    return cfg.infer.tile_mode == TileMode::Adaptive || (g.rows * g.cols) > 1;
+}
+
+/// @brief Per-member config: own pools inside the partition, intra-op pool sized to it.
+DetectorConfig member_config(const DetectorConfig& cfg, const std::vector<int>& cpus) {
+    DetectorConfig mc = cfg;
+    mc.runtime.ort_global_pools = false;
+    mc.runtime.pin_worker_threads = false;
+    if (mc.runtime.ort_intra_threads <= 0 && !cpus.empty()) mc.runtime.ort_intra_threads = (int)cpus.size();
+    return mc;
+}
+
+/// @brief Returned by @ref idet::MultiDetector::member_cpus for invalid indices.
+const std::vector<int> kNoCpus;
+
+} // namespace
+
+} // namespace detail
+
+MultiDetector::~MultiDetector() noexcept {
+    reset();
+}
+
+MultiDetector::MultiDetector(MultiDetector&& other) noexcept : impl_(other.impl_) {
+    other.impl_ = nullptr;
+}
+
+MultiDetector& MultiDetector::operator=(MultiDetector&& other) noexcept {
+    if (this != &other) {
+        reset();
+        impl_ = other.impl_;
+        other.impl_ = nullptr;
+    }
+    return *this;
+}
+
+MultiDetector::operator bool() const noexcept {
+    return impl_ && !impl_->members.empty();
+}
+
+void MultiDetector::reset() noexcept {
+    delete impl_; // joins every member worker
+    impl_ = nullptr;
+}
+
+/**
+ * @brief Partitions the CPUs and creates the members concurrently on their workers.
+ *
+ * @details
+ * Session creation of all members overlaps. The first failing member determines the returned
+ * status; in that case all members are torn down again.
+ */
+Result<MultiDetector> MultiDetector::create(const std::vector<DetectorConfig>& configs) noexcept {
+    using R = Result<MultiDetector>;
+
+    if (configs.empty()) return R::Err(Status::Invalid("MultiDetector::create: no configurations"));
+    for (const auto& cfg : configs) {
+        const Status vs = cfg.validate();
+        if (!vs.ok()) return R::Err(vs);
+    }
+
+    try {
+        auto impl = std::make_unique<detail::MultiDetectorImpl>();
+        std::vector<int> want;
+        want.reserve(configs.size());
+        for (const auto& cfg : configs)
+            want.push_back(cfg.runtime.ort_intra_threads);
+        impl->cpus = platform::partition_cpus(platform::select_pool_cpus(platform::available_cpu_count()), want);
+        impl->members.reserve(configs.size());
+
+        std::vector<std::future<Status>> started;
+        started.reserve(configs.size());
+        for (std::size_t i = 0; i < configs.size(); ++i) {
+            impl->needs_bgr = impl->needs_bgr || detail::tiled_config(configs[i]);
+            impl->members.push_back(std::make_unique<internal::DetectorWorker>());
+            internal::DetectorWorker* w = impl->members.back().get();
+
+            const std::vector<int>& cpus = impl->cpus[i];
+            started.push_back(w->post([w, &cpus, mc = detail::member_config(configs[i], cpus)]() -> Status {
+                const Status bs = platform::bind_current_thread_to_cpus(cpus);
+                if (!bs.ok()) return bs;
+
+                auto dr = Detector::create(mc);
+                if (!dr.ok()) return dr.status();
+                w->detector() = std::move(dr.value());
+                return Status::Ok();
+            }));
+        }
+
+        Status first = Status::Ok();
+        for (std::size_t i = 0; i < started.size(); ++i) {
+            const Status s = started[i].get();
+            if (!s.ok() && first.ok())
+                first = Status{s.code, "MultiDetector::create: member " + std::to_string(i) + ": " + s.message};
+        }
+        if (!first.ok()) return R::Err(first);
+
+        MultiDetector m;
+        m.impl_ = impl.release();
+        return R::Ok(std::move(m));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("MultiDetector::create: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("MultiDetector::create: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("MultiDetector::create: unknown"));
+    }
+}
+
+std::size_t MultiDetector::size() const noexcept {
+    return impl_ ? impl_->members.size() : 0;
+}
+
+const std::vector<int>& MultiDetector::member_cpus(std::size_t index) const noexcept {
+    if (!impl_ || index >= impl_->cpus.size()) return detail::kNoCpus;
+    return impl_->cpus[index];
+}
+
+Status MultiDetector::prepare_binding(std::size_t index, int width, int height, int contexts, int max_batch) noexcept {
+    if (!*this) return Status::Invalid("MultiDetector::prepare_binding: invalid multi-detector");
+    if (index >= impl_->members.size()) return Status::Invalid("MultiDetector::prepare_binding: index out of range");
+
+    try {
+        internal::DetectorWorker& w = *impl_->members[index];
+        return w.call([&w, width, height, contexts, max_batch] {
+            return w.detector().prepare_binding(width, height, contexts, max_batch);
+        });
+    } catch (const std::bad_alloc&) {
+        return Status::OutOfMemory("MultiDetector::prepare_binding: bad_alloc");
+    } catch (const std::exception& e) {
+        return Status::Internal(std::string("MultiDetector::prepare_binding: ") + e.what());
+    } catch (...) {
+        return Status::Internal("MultiDetector::prepare_binding: unknown");
+    }
+}
+
+Result<std::vector<VecQuad>> MultiDetector::detect(const Image& image) noexcept {
+    using R = Result<std::vector<VecQuad>>;
+    try {
+        std::vector<VecDetection> dets;
+        const Status s = detect_ex(image, dets);
+        if (!s.ok()) return R::Err(s);
+
+        std::vector<VecQuad> out(dets.size());
+        for (std::size_t i = 0; i < dets.size(); ++i) {
+            out[i].reserve(dets[i].size());
+            for (const auto& d : dets[i])
+                out[i].push_back(d.quad);
+        }
+        return R::Ok(std::move(out));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("MultiDetector::detect: bad_alloc"));
+    }
+}
+
+/**
+ * @brief Prepares the frame once and runs all members on it concurrently.
+ *
+ * @details
+ * The shared BGR copy (when needed) lives on the caller's stack; members only see a non-owning
+ * view of it, which stays valid because the caller waits for every member before returning.
+ */
+Status MultiDetector::detect_ex(const Image& image, std::vector<VecDetection>& out) noexcept {
+    out.clear();
+    if (!*this) return Status::Invalid("MultiDetector::detect_ex: invalid multi-detector");
+    if (!image.view().is_valid()) return Status::Invalid("MultiDetector::detect_ex: invalid Image");
+
+    try {
+        Image frame = image;
+        internal::BgrMat bgr;
+        if (impl_->needs_bgr && image.view().format != PixelFormat::BGR_U8) {
+            auto br = internal::BgrMat::from(image);
+            if (!br.ok()) return br.status();
+            bgr = std::move(br.value());
+            const cv::Mat& m = bgr.mat();
+            ImageView v;
+            v.data = m.data;
+            v.width = m.cols;
+            v.height = m.rows;
+            v.stride_bytes = m.step[0];
+            v.format = PixelFormat::BGR_U8;
+            frame = Image::view(v);
+        }
+
+        const std::size_t n = impl_->members.size();
+        out.resize(n);
+        std::vector<std::future<Status>> done;
+        done.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            internal::DetectorWorker* w = impl_->members[i].get();
+            VecDetection* dst = &out[i];
+            done.push_back(w->post([w, &frame, dst] { return w->detector().detect_ex(frame, *dst); }));
+        }
+
+        // Wait for every member before touching `frame` or `out` again.
+        Status first = Status::Ok();
+        for (auto& f : done) {
+            const Status s = f.get();
+            if (!s.ok() && first.ok()) first = s;
+        }
+        if (!first.ok()) out.clear();
+        return first;
+    } catch (const std::bad_alloc&) {
+        out.clear();
+        return Status::OutOfMemory("MultiDetector::detect_ex: bad_alloc");
+    } catch (const std::exception& e) {
+        out.clear();
+        return Status::Internal(std::string("MultiDetector::detect_ex: ") + e.what());
+    } catch (...) {
+        out.clear();
+        return Status::Internal("MultiDetector::detect_ex: unknown");
+    }
+}
+
+} // namespace idet
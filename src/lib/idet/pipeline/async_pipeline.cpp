@@ -0,0 +1,266 @@
+/**
+ * @file async_pipeline.cpp
+ * @ingroup idet_pipeline
+ * @brief Implementation of the bounded three-stage asynchronous detection pipeline.
+ *
+ * @details
+ * Frames move between stages as slot indices through three FIFO queues guarded by one mutex.
+ * The lock is held only for queue/bookkeeping operations; engine calls run unlocked.
+ * Since every stage processes slots in FIFO order, frames complete in submission order.
+ *
+ * Error handling:
+ * - a failing stage completes the frame immediately with its status (later stages are skipped),
+ * - exceptions thrown by callbacks are converted into @ref idet::Status at the worker boundary.
+ */
+
+#include "pipeline/async_pipeline.h"
+
+#include <exception>
+#include <initializer_list>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace idet::pipeline {
+
+AsyncPipeline::AsyncPipeline(engine::IEngine& eng, bool staged, int depth, Finalize finalize, Fallback fallback,
+                             Ticket first_ticket)
+    : eng_(eng), staged_(staged), depth_(depth > 0 ? depth : 1), finalize_(std::move(finalize)),
+      fallback_(std::move(fallback)), next_id_(first_ticket) {
+    jobs_.resize((std::size_t)depth_);
+    free_.reserve((std::size_t)depth_);
+    for (int k = depth_ - 1; k >= 0; --k)
+        free_.push_back(k);
+    for (Queue* q : {&pre_q_, &run_q_, &post_q_})
+        q->buf.resize((std::size_t)depth_);
+
+    try {
+        workers_.emplace_back([this] { pre_loop_(); });
+        workers_.emplace_back([this] { run_loop_(); });
+        workers_.emplace_back([this] { post_loop_(); });
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        pre_cv_.notify_all();
+        run_cv_.notify_all();
+        post_cv_.notify_all();
+        for (auto& t : workers_)
+            t.join();
+        throw;
+    }
+}
+
+AsyncPipeline::~AsyncPipeline() noexcept {
+    drain();
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+    }
+    slot_cv_.notify_all();
+    pre_cv_.notify_all();
+    run_cv_.notify_all();
+    post_cv_.notify_all();
+    done_cv_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+Result<AsyncPipeline::Ticket> AsyncPipeline::submit(Image img) noexcept {
+    using R = Result<Ticket>;
+    try {
+        if (!img.view().is_valid()) return R::Err(Status::Invalid("AsyncPipeline::submit: invalid Image"));
+
+        std::unique_lock<std::mutex> lk(mu_);
+        slot_cv_.wait(lk, [this] { return stop_ || !free_.empty(); });
+        if (stop_) return R::Err(Status::Internal("AsyncPipeline::submit: pipeline stopped"));
+
+        const int k = free_.back();
+        free_.pop_back();
+
+        Job& j = jobs_[(std::size_t)k];
+        j.id = next_id_++;
+        j.img = std::move(img);
+        pending_.insert(j.id);
+        pre_q_.push(k);
+
+        const Ticket id = j.id;
+        lk.unlock();
+        pre_cv_.notify_one();
+        return R::Ok(id);
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("AsyncPipeline::submit: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("AsyncPipeline::submit: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("AsyncPipeline::submit: unknown"));
+    }
+}
+
+bool AsyncPipeline::ready(Ticket t) const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return done_.find(t) != done_.end();
+}
+
+Result<VecQuad> AsyncPipeline::wait(Ticket t) noexcept {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (done_.find(t) == done_.end() && pending_.find(t) == pending_.end())
+        return Result<VecQuad>::Err(Status::Invalid("AsyncPipeline::wait: unknown or consumed ticket"));
+
+    done_cv_.wait(lk, [&] { return done_.find(t) != done_.end() || pending_.find(t) == pending_.end(); });
+
+    auto it = done_.find(t);
+    if (it == done_.end())
+        return Result<VecQuad>::Err(Status::OutOfMemory("AsyncPipeline::wait: result lost (out of memory)"));
+    Result<VecQuad> r = std::move(it->second);
+    done_.erase(it);
+    return r;
+}
+
+void AsyncPipeline::drain() noexcept {
+    std::unique_lock<std::mutex> lk(mu_);
+    done_cv_.wait(lk, [this] { return pending_.empty(); });
+}
+
+AsyncPipeline::Ticket AsyncPipeline::next_ticket() const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return next_id_;
+}
+
+std::size_t AsyncPipeline::in_flight() const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return pending_.size();
+}
+
+bool AsyncPipeline::idle() const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return pending_.empty() && done_.empty();
+}
+
+int AsyncPipeline::pop_(std::unique_lock<std::mutex>& lk, std::condition_variable& cv, Queue& q) {
+    cv.wait(lk, [&] { return stop_ || !q.empty(); });
+    if (q.empty()) return -1;
+    return q.pop();
+}
+
+void AsyncPipeline::complete_(int k, Result<VecQuad> r) noexcept {
+    Job& j = jobs_[(std::size_t)k];
+    j.img = Image{};
+    try {
+        // Insert before the ticket leaves pending_ so wait()/drain() never miss it.
+        done_.emplace(j.id, std::move(r));
+    } catch (...) {
+        // OOM while publishing: the ticket is dropped and wait() reports it as lost.
+    }
+    pending_.erase(j.id);
+    free_.push_back(k); // capacity reserved in the constructor
+    slot_cv_.notify_one();
+    done_cv_.notify_all();
+}
+
+/// @brief Stage 1: BGR conversion + engine preprocessing into context @c k.
+void AsyncPipeline::pre_loop_() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+        const int k = pop_(lk, pre_cv_, pre_q_);
+        if (k < 0) return;
+        Job& j = jobs_[(std::size_t)k];
+        Image img = j.img;
+        lk.unlock();
+
+        Status s = Status::Ok();
+        if (staged_) {
+            try {
+                auto bm = internal::BgrMat::from(std::move(img));
+                s = bm.ok() ? eng_.stage_input(bm.value().mat(), k) : bm.status();
+            } catch (const std::bad_alloc&) {
+                s = Status::OutOfMemory("AsyncPipeline(pre): bad_alloc");
+            } catch (const std::exception& e) {
+                s = Status::Internal(std::string("AsyncPipeline(pre): ") + e.what());
+            } catch (...) {
+                s = Status::Internal("AsyncPipeline(pre): unknown");
+            }
+        }
+
+        lk.lock();
+        if (!s.ok()) {
+            complete_(k, Result<VecQuad>::Err(std::move(s)));
+            continue;
+        }
+        // The source pixels are no longer needed once the input tensor is filled.
+        if (staged_) j.img = Image{};
+        run_q_.push(k);
+        run_cv_.notify_one();
+    }
+}
+
+/// @brief Stage 2: session run (staged) or full synchronous detection (fallback).
+void AsyncPipeline::run_loop_() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+        const int k = pop_(lk, run_cv_, run_q_);
+        if (k < 0) return;
+        Job& j = jobs_[(std::size_t)k];
+        Image img = staged_ ? Image{} : j.img;
+        lk.unlock();
+
+        Status s = Status::Ok();
+        Result<VecQuad> fb = Result<VecQuad>::Err(Status::Internal("AsyncPipeline: no result"));
+        try {
+            if (staged_)
+                s = eng_.stage_run(k);
+            else
+                fb = fallback_(img);
+        } catch (const std::bad_alloc&) {
+            s = Status::OutOfMemory("AsyncPipeline(run): bad_alloc");
+        } catch (const std::exception& e) {
+            s = Status::Internal(std::string("AsyncPipeline(run): ") + e.what());
+        } catch (...) {
+            s = Status::Internal("AsyncPipeline(run): unknown");
+        }
+
+        lk.lock();
+        if (!s.ok()) {
+            complete_(k, Result<VecQuad>::Err(std::move(s)));
+            continue;
+        }
+        if (!staged_) j.result = std::move(fb);
+        post_q_.push(k);
+        post_cv_.notify_one();
+    }
+}
+
+/// @brief Stage 3: decode + finalize (NMS) and publish the result.
+void AsyncPipeline::post_loop_() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+        const int k = pop_(lk, post_cv_, post_q_);
+        if (k < 0) return;
+        Job& j = jobs_[(std::size_t)k];
+        lk.unlock();
+
+        Result<VecQuad> r = Result<VecQuad>::Err(Status::Internal("AsyncPipeline: no result"));
+        try {
+            if (staged_) {
+                auto dets = eng_.stage_output(k);
+                r = dets.ok() ? Result<VecQuad>::Ok(finalize_(std::move(dets.value())))
+                              : Result<VecQuad>::Err(dets.status());
+            } else {
+                r = std::move(j.result);
+            }
+        } catch (const std::bad_alloc&) {
+            r = Result<VecQuad>::Err(Status::OutOfMemory("AsyncPipeline(post): bad_alloc"));
+        } catch (const std::exception& e) {
+            r = Result<VecQuad>::Err(Status::Internal(std::string("AsyncPipeline(post): ") + e.what()));
+        } catch (...) {
+            r = Result<VecQuad>::Err(Status::Internal("AsyncPipeline(post): unknown"));
+        }
+
+        lk.lock();
+        complete_(k, std::move(r));
+    }
+}
+
+} // namespace idet::pipeline
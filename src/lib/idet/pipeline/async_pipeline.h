@@ -0,0 +1,185 @@
+/**
+ * @file async_pipeline.h
+ * @ingroup idet_pipeline
+ * @brief Bounded three-stage asynchronous detection pipeline (preprocess -> run -> postprocess).
+ *
+ * @details
+ * @ref idet::pipeline::AsyncPipeline accepts frames via @ref idet::pipeline::AsyncPipeline::submit
+ * and returns tickets that are later resolved by @ref idet::pipeline::AsyncPipeline::wait.
+ *
+ * Staged mode (engine supports stages, bound I/O prepared, no tiling):
+ * - each in-flight frame owns one binding context for its whole lifetime,
+ * - three worker threads run @c stage_input, @c stage_run and @c stage_output + finalize,
+ *   so frame N+1 is preprocessed while frame N is in the session and frame N-1 is decoded,
+ * - the number of in-flight frames is bounded by the number of binding contexts.
+ *
+ * Fallback mode (anything else): a single worker runs the full synchronous detection per frame.
+ * This keeps the API uniform; it only overlaps caller work with detection.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "algo/geometry.h"
+#include "engine/engine.h"
+#include "idet.h"
+#include "internal/cv_bgr.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace idet::pipeline {
+
+/**
+ * @brief Bounded, ticketed asynchronous detection pipeline.
+ *
+ * @details
+ * Thread-safety: all public methods may be called from any thread. Results are delivered once:
+ * a successful @ref wait consumes the ticket.
+ */
+class AsyncPipeline final {
+  public:
+    using Ticket = std::uint64_t;
+
+    /** @brief Converts raw engine detections into final public results (min-size filter, NMS). */
+    using Finalize = std::function<VecQuad(std::vector<algo::Detection>)>;
+
+    /** @brief Full synchronous detection used in fallback mode. */
+    using Fallback = std::function<Result<VecQuad>(const Image&)>;
+
+    /**
+     * @brief Starts the pipeline workers.
+     *
+     * @param eng Engine to drive (must outlive the pipeline).
+     * @param staged Use staged bound execution (requires @ref idet::engine::IEngine::supports_stages
+     *        and a prepared binding); otherwise run @p fallback per frame.
+     * @param depth Maximum number of in-flight frames. In staged mode this must not exceed
+     *        the number of bound contexts; context @c i is used by slot @c i.
+     * @param finalize Postprocessing applied to staged results.
+     * @param fallback Synchronous detection used in fallback mode.
+     * @param first_ticket Ticket of the first submitted frame, so that tickets stay unique across
+     *        the pipelines a detector creates over its lifetime.
+     *
+     * @throws std::system_error If worker threads cannot be started.
+     * @throws std::bad_alloc On allocation failure.
+     */
+    AsyncPipeline(engine::IEngine& eng, bool staged, int depth, Finalize finalize, Fallback fallback,
+                  Ticket first_ticket = 1);
+
+    /** @brief Completes all in-flight frames, then stops and joins the workers. */
+    ~AsyncPipeline() noexcept;
+
+    AsyncPipeline(const AsyncPipeline&) = delete;
+    AsyncPipeline& operator=(const AsyncPipeline&) = delete;
+
+    /**
+     * @brief Enqueues a frame; blocks while @ref depth frames are already in flight.
+     *
+     * @param img Input image. For non-owning views the pixel memory must stay valid until the
+     *        ticket completes (@ref ready returns true).
+     * @return Ticket identifying the frame, or an error status.
+     */
+    Result<Ticket> submit(Image img) noexcept;
+
+    /** @brief Returns true if the result for @p t is available (wait will not block). */
+    bool ready(Ticket t) const noexcept;
+
+    /**
+     * @brief Blocks until @p t completes and returns its result (consumes the ticket).
+     * @return Detections, the frame's error status, or Invalid for unknown/consumed tickets.
+     */
+    Result<VecQuad> wait(Ticket t) noexcept;
+
+    /** @brief Blocks until no frame is in flight. Completed results stay available. */
+    void drain() noexcept;
+
+    /** @brief Number of submitted frames that have not completed yet. */
+    std::size_t in_flight() const noexcept;
+
+    /** @brief True if nothing is in flight and no completed result is waiting to be collected. */
+    bool idle() const noexcept;
+
+    /** @brief Maximum number of in-flight frames. */
+    int depth() const noexcept {
+        return depth_;
+    }
+
+    /** @brief Whether the staged (overlapped) execution mode is active. */
+    bool staged() const noexcept {
+        return staged_;
+    }
+
+    /** @brief Ticket the next submitted frame will get. */
+    Ticket next_ticket() const noexcept;
+
+  private:
+    /** @brief Per-slot frame state; slot index == binding context index in staged mode. */
+    struct Job {
+        Ticket id = 0;
+        Image img;
+        Result<VecQuad> result = Result<VecQuad>::Err(Status::Internal("AsyncPipeline: no result"));
+    };
+
+    /** @brief Fixed-capacity FIFO of slot indices (capacity == depth, so push never allocates). */
+    struct Queue {
+        std::vector<int> buf;
+        std::size_t head = 0, size = 0;
+
+        bool empty() const noexcept {
+            return size == 0;
+        }
+        void push(int k) noexcept {
+            buf[(head + size++) % buf.size()] = k;
+        }
+        int pop() noexcept {
+            const int k = buf[head];
+            head = (head + 1) % buf.size();
+            --size;
+            return k;
+        }
+    };
+
+    void pre_loop_();
+    void run_loop_();
+    void post_loop_();
+
+    /** @brief Pops the next slot from @p q or returns -1 when stopping. Caller holds @p lk. */
+    int pop_(std::unique_lock<std::mutex>& lk, std::condition_variable& cv, Queue& q);
+
+    /** @brief Publishes the result of slot @p k and releases the slot. Caller holds the lock. */
+    void complete_(int k, Result<VecQuad> r) noexcept;
+
+    engine::IEngine& eng_;
+    const bool staged_;
+    const int depth_;
+    Finalize finalize_;
+    Fallback fallback_;
+
+    mutable std::mutex mu_;
+    std::condition_variable slot_cv_; ///< Signals a freed slot (submit backpressure)
+    std::condition_variable pre_cv_;
+    std::condition_variable run_cv_;
+    std::condition_variable post_cv_;
+    std::condition_variable done_cv_; ///< Signals a completed frame
+
+    std::vector<Job> jobs_;
+    std::vector<int> free_;
+    Queue pre_q_, run_q_, post_q_;
+
+    std::unordered_set<Ticket> pending_;
+    std::unordered_map<Ticket, Result<VecQuad>> done_;
+    Ticket next_id_;
+    bool stop_ = false;
+
+    std::vector<std::thread> workers_;
+};
+
+} // namespace idet::pipeline
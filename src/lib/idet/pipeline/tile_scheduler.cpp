@@ -0,0 +1,278 @@
+/**
+ * @file tile_scheduler.cpp
+ * @ingroup idet_pipeline
+ * @brief Implementation of the dynamic cross-frame tile scheduler.
+ *
+ * @details
+ * All bookkeeping (task FIFO, frame slots, tickets, runners) is guarded by one mutex, which is held
+ * only to pop a task or to record a finished tile; inference runs unlocked. Frame slots stay alive
+ * until their last tile finishes, so runners may read a slot's image and tile rectangles without
+ * locking.
+ *
+ * Runners are pool tasks: @c submit starts one per queued tile up to the worker limit, and a runner
+ * leaves as soon as the FIFO is empty, returning its pool thread to other detectors.
+ *
+ * Error handling:
+ * - the first failing tile sets the frame status; its remaining tiles are skipped,
+ * - exceptions are converted into @ref idet::Status at the worker boundary.
+ */
+
+#include "pipeline/tile_scheduler.h"
+
+#include "algo/tiling.h"
+
+#include <exception>
+#include <iterator>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace idet::pipeline {
+
+TileScheduler::TileScheduler(engine::IEngine& eng, bool bound, int workers, int depth, Ticket first_ticket)
+    : eng_(eng), bound_(bound), depth_(depth > 0 ? depth : 1), workers_(workers > 0 ? workers : 1),
+      threads_(platform::ThreadPool::current()), next_id_(first_ticket) {
+    if (bound_) pool_ = std::make_unique<engine::ContextPool>(eng_.bound_contexts());
+
+    frames_.resize((std::size_t)depth_);
+    free_.reserve((std::size_t)depth_);
+    for (int k = depth_ - 1; k >= 0; --k)
+        free_.push_back(k);
+
+    free_ids_.reserve((std::size_t)workers_);
+    for (int w = workers_ - 1; w >= 0; --w)
+        free_ids_.push_back(w);
+
+    threads_.reserve((std::size_t)workers_);
+}
+
+TileScheduler::~TileScheduler() noexcept {
+    drain();
+    std::unique_lock<std::mutex> lk(mu_);
+    stop_ = true;
+    slot_cv_.notify_all();
+    done_cv_.notify_all();
+    // Runners touch the scheduler until they leave; the last one signals under the lock.
+    idle_cv_.wait(lk, [this] { return running_ == 0; });
+}
+
+Result<TileScheduler::Ticket> TileScheduler::submit(Image img, const GridSpec& grid, float overlap_rel) noexcept {
+    return submit(std::move(img), algo::TileLayout::of_grid(grid, overlap_rel));
+}
+
+Result<TileScheduler::Ticket> TileScheduler::submit(Image img, const algo::TileLayout& layout) noexcept {
+    using R = Result<Ticket>;
+    try {
+        if (!img.view().is_valid()) return R::Err(Status::Invalid("TileScheduler::submit: invalid Image"));
+        if (bound_ && !eng_.binding_ready())
+            return R::Err(Status::Invalid("TileScheduler::submit: binding not ready"));
+
+        // Conversion and tiling happen on the caller's thread, before a slot is taken.
+        auto bm = internal::BgrMat::from(std::move(img));
+        if (!bm.ok()) return R::Err(bm.status());
+        auto rects = algo::make_tiles(bm.value().mat().cols, bm.value().mat().rows, layout);
+
+        std::unique_lock<std::mutex> lk(mu_);
+        slot_cv_.wait(lk, [this] { return stop_ || !free_.empty(); });
+        if (stop_) return R::Err(Status::Internal("TileScheduler::submit: scheduler stopped"));
+
+        const int k = free_.back();
+        Frame& f = frames_[(std::size_t)k];
+        const int n = (int)rects.size();
+
+        f.per_tile.resize((std::size_t)n);
+        f.timings.assign((std::size_t)n, TileTiming{});
+        const std::size_t queued = tasks_.size();
+        try {
+            for (int i = 0; i < n; ++i)
+                tasks_.push_back(Task{k, i});
+            pending_.insert(next_id_);
+            start_runners_();
+        } catch (...) {
+            // Runners already started find no tiles of this frame and leave.
+            tasks_.resize(queued);
+            pending_.erase(next_id_);
+            throw;
+        }
+
+        // Nothing below throws: the slot is committed.
+        free_.pop_back();
+        f.id = next_id_++;
+        f.bgr = std::move(bm.value());
+        f.rects = std::move(rects);
+        f.remaining = n;
+        f.status = Status::Ok();
+        f.t0 = Clock::now();
+
+        const Ticket id = f.id;
+        if (n == 0) complete_(k);
+        return R::Ok(id);
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("TileScheduler::submit: bad_alloc"));
+    } catch (const std::exception& e) {
+        return R::Err(Status::Internal(std::string("TileScheduler::submit: ") + e.what()));
+    } catch (...) {
+        return R::Err(Status::Internal("TileScheduler::submit: unknown"));
+    }
+}
+
+bool TileScheduler::ready(Ticket t) const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return done_.find(t) != done_.end();
+}
+
+Result<TileScheduler::FrameResult> TileScheduler::wait(Ticket t) noexcept {
+    using R = Result<FrameResult>;
+    std::unique_lock<std::mutex> lk(mu_);
+    if (done_.find(t) == done_.end() && pending_.find(t) == pending_.end())
+        return R::Err(Status::Invalid("TileScheduler::wait: unknown or consumed ticket"));
+
+    done_cv_.wait(lk, [&] { return done_.find(t) != done_.end() || pending_.find(t) == pending_.end(); });
+
+    auto it = done_.find(t);
+    if (it == done_.end()) return R::Err(Status::OutOfMemory("TileScheduler::wait: result lost (out of memory)"));
+    R r = std::move(it->second);
+    done_.erase(it);
+    return r;
+}
+
+void TileScheduler::drain() noexcept {
+    std::unique_lock<std::mutex> lk(mu_);
+    done_cv_.wait(lk, [this] { return pending_.empty(); });
+}
+
+TileScheduler::Ticket TileScheduler::next_ticket() const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return next_id_;
+}
+
+std::size_t TileScheduler::in_flight() const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return pending_.size();
+}
+
+bool TileScheduler::idle() const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return pending_.empty() && done_.empty();
+}
+
+Status TileScheduler::run_tile_(const cv::Mat& tile, int worker, Clock::time_point t0,
+                                std::vector<algo::Detection>& dets, TileTiming& timing) noexcept {
+    // The context is held only while the tile runs, so any worker can use any free context.
+    int ctx = -1;
+    if (bound_) ctx = pool_->acquire();
+
+    const auto ts = Clock::now();
+    auto r = bound_ ? eng_.infer_bound(tile, ctx) : eng_.infer_unbound(tile);
+    const auto te = Clock::now();
+
+    if (bound_) pool_->release(ctx);
+
+    timing.context = ctx;
+    timing.worker = worker;
+    timing.start_ms = std::chrono::duration<double, std::milli>(ts - t0).count();
+    timing.ms = std::chrono::duration<double, std::milli>(te - ts).count();
+
+    if (!r.ok()) return r.status();
+    dets.swap(r.value());
+    return Status::Ok();
+}
+
+void TileScheduler::complete_(int k) noexcept {
+    Frame& f = frames_[(std::size_t)k];
+
+    Result<FrameResult> r = Result<FrameResult>::Err(f.status);
+    if (f.status.ok()) {
+        try {
+            FrameResult fr;
+            std::size_t total = 0;
+            for (const auto& v : f.per_tile)
+                total += v.size();
+            fr.dets.reserve(total);
+            for (auto& v : f.per_tile)
+                fr.dets.insert(fr.dets.end(), std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+            fr.timings = std::move(f.timings);
+            fr.rects = std::move(f.rects);
+            r = Result<FrameResult>::Ok(std::move(fr));
+        } catch (const std::bad_alloc&) {
+            r = Result<FrameResult>::Err(Status::OutOfMemory("TileScheduler: bad_alloc while merging tiles"));
+        }
+    }
+
+    try {
+        // Insert before the ticket leaves pending_ so wait()/drain() never miss it.
+        done_.emplace(f.id, std::move(r));
+    } catch (...) {
+        // OOM while publishing: the ticket is dropped and wait() reports it as lost.
+    }
+    pending_.erase(f.id);
+
+    f.bgr = internal::BgrMat{};
+    f.rects.clear();
+    f.per_tile.clear();
+    f.timings.clear();
+    free_.push_back(k); // capacity reserved in the constructor
+    slot_cv_.notify_one();
+    done_cv_.notify_all();
+}
+
+void TileScheduler::start_runners_() {
+    while (running_ < workers_ && (std::size_t)running_ < tasks_.size()) {
+        threads_.submit([this] { run_tasks_(); });
+        ++running_;
+    }
+}
+
+void TileScheduler::run_tasks_() noexcept {
+    std::unique_lock<std::mutex> lk(mu_);
+    const int worker = free_ids_.back(); // running_ <= workers_ leaves one free id per runner
+    free_ids_.pop_back();
+
+    // Tiles already occupy the pool threads; decoding a tile must not fan out further. The pool
+    // thread is shared, so its previous setting is restored on exit.
+    const bool serial = engine::IEngine::serial_postprocess();
+    engine::IEngine::set_serial_postprocess(workers_ > 1);
+
+    while (!tasks_.empty()) {
+        const Task t = tasks_.front();
+        tasks_.pop_front();
+        Frame& f = frames_[(std::size_t)t.slot];
+        const bool skip = !f.status.ok();
+        const cv::Rect rc = f.rects[(std::size_t)t.tile];
+        const Clock::time_point t0 = f.t0;
+        lk.unlock();
+
+        Status s = Status::Ok();
+        std::vector<algo::Detection> dets;
+        TileTiming timing{};
+        timing.tile = t.tile;
+        if (!skip) {
+            try {
+                // ROI view into the frame image (no copy).
+                s = run_tile_(f.bgr.mat()(rc), worker, t0, dets, timing);
+                if (s.ok()) {
+                    for (auto& d : dets)
+                        algo::offset_detection(d, rc.x, rc.y, t.tile);
+                }
+            } catch (const std::bad_alloc&) {
+                s = Status::OutOfMemory("TileScheduler(tile): bad_alloc");
+            } catch (const std::exception& e) {
+                s = Status::Internal(std::string("TileScheduler(tile): ") + e.what());
+            } catch (...) {
+                s = Status::Internal("TileScheduler(tile): unknown");
+            }
+        }
+
+        lk.lock();
+        if (!s.ok() && f.status.ok()) f.status = std::move(s);
+        f.per_tile[(std::size_t)t.tile].swap(dets);
+        f.timings[(std::size_t)t.tile] = timing;
+        if (--f.remaining == 0) complete_(t.slot);
+    }
+
+    engine::IEngine::set_serial_postprocess(serial);
+    free_ids_.push_back(worker); // capacity reserved in the constructor
+    if (--running_ == 0) idle_cv_.notify_all();
+}
+
+} // namespace idet::pipeline
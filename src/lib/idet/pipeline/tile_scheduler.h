@@ -0,0 +1,200 @@
+/**
+ * @file tile_scheduler.h
+ * @ingroup idet_pipeline
+ * @brief Dynamic, cross-frame tile scheduler for asynchronous tiled detection.
+ *
+ * @details
+ * @ref idet::pipeline::TileScheduler splits every submitted frame into tiles and pushes one task
+ * per tile into a single FIFO drained by up to @c workers runners on the library
+ * @ref idet::platform::ThreadPool:
+ * - workers pull the next task when they become free, so a slow (text-dense) tile only delays
+ *   the worker processing it, never a statically assigned block of other tiles,
+ * - tasks of frame N+1 are queued right behind those of frame N: workers that finish early start
+ *   on the next frame while the stragglers of the previous one are still running,
+ * - in bound mode a context is checked out from an @ref idet::engine::ContextPool for each tile,
+ *   so the worker count is independent of the number of bound contexts,
+ * - runners exist only while tiles are queued, so an idle scheduler holds no thread; pool threads
+ *   are shared with tiling and postprocessing regions of all detectors.
+ *
+ * Each completed frame reports per-tile timings (@ref idet::TileTiming). Detections are merged
+ * in tile order, so results do not depend on scheduling.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "algo/geometry.h"
+#include "algo/tiling.h"
+#include "engine/context_pool.h"
+#include "engine/engine.h"
+#include "idet.h"
+#include "internal/cv_bgr.h"
+#include "platform/thread_pool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace idet::pipeline {
+
+/**
+ * @brief Bounded, ticketed tiled detection with dynamic tile scheduling across frames.
+ *
+ * @details
+ * Thread-safety: all public methods may be called from any thread. Results are delivered once:
+ * a successful @ref wait consumes the ticket.
+ */
+class TileScheduler final {
+  public:
+    using Ticket = std::uint64_t;
+
+    /** @brief Merged (not yet NMS-ed) detections of one frame and the timing of its tiles. */
+    struct FrameResult {
+        std::vector<algo::Detection> dets;
+        std::vector<TileTiming> timings;
+        std::vector<cv::Rect> rects; ///< Tiles the frame was split into (see @ref idet::algo::merge_tiled)
+    };
+
+    /**
+     * @brief Creates the scheduler and makes sure the pool has enough threads for its workers.
+     *
+     * @param eng Engine to drive (must outlive the scheduler).
+     * @param bound Use bound inference; requires a prepared binding. Contexts are checked out
+     *        per tile from [0, @ref idet::engine::IEngine::bound_contexts).
+     * @param workers Maximum number of tiles processed concurrently (normalized to >= 1).
+     * @param depth Maximum number of in-flight frames (normalized to >= 1).
+     * @param first_ticket Ticket of the first submitted frame (see @ref AsyncPipeline::AsyncPipeline).
+     *
+     * @throws std::system_error If pool threads cannot be started.
+     * @throws std::bad_alloc On allocation failure.
+     */
+    TileScheduler(engine::IEngine& eng, bool bound, int workers, int depth, Ticket first_ticket = 1);
+
+    /** @brief Completes all in-flight frames and waits until no runner uses the scheduler. */
+    ~TileScheduler() noexcept;
+
+    TileScheduler(const TileScheduler&) = delete;
+    TileScheduler& operator=(const TileScheduler&) = delete;
+
+    /**
+     * @brief Splits @p img into tiles and enqueues them; blocks while @ref depth frames are in flight.
+     *
+     * @param img Input image. For non-owning views the pixel memory must stay valid until the
+     *        ticket completes (@ref ready returns true).
+     * @param grid Tiling grid (see @ref idet::algo::make_tiles).
+     * @param overlap_rel Relative tile overlap.
+     * @return Ticket identifying the frame, or an error status.
+     */
+    Result<Ticket> submit(Image img, const GridSpec& grid, float overlap_rel) noexcept;
+
+    /** @brief Same as the grid overload, with tiles built from @p layout (see @ref idet::algo::TileLayout). */
+    Result<Ticket> submit(Image img, const algo::TileLayout& layout) noexcept;
+
+    /** @brief Returns true if the result for @p t is available (wait will not block). */
+    bool ready(Ticket t) const noexcept;
+
+    /**
+     * @brief Blocks until @p t completes and returns its result (consumes the ticket).
+     * @return Frame result, the frame's first error, or Invalid for unknown/consumed tickets.
+     */
+    Result<FrameResult> wait(Ticket t) noexcept;
+
+    /** @brief Blocks until no frame is in flight. Completed results stay available. */
+    void drain() noexcept;
+
+    /** @brief Number of submitted frames that have not completed yet. */
+    std::size_t in_flight() const noexcept;
+
+    /** @brief True if nothing is in flight and no completed result is waiting to be collected. */
+    bool idle() const noexcept;
+
+    /** @brief Maximum number of in-flight frames. */
+    int depth() const noexcept {
+        return depth_;
+    }
+
+    /** @brief Maximum number of concurrently processed tiles. */
+    int workers() const noexcept {
+        return workers_;
+    }
+
+    /** @brief Whether tiles use bound inference. */
+    bool bound() const noexcept {
+        return bound_;
+    }
+
+    /** @brief Number of bound contexts shared by the workers (0 in unbound mode). */
+    int contexts() const noexcept {
+        return pool_ ? pool_->size() : 0;
+    }
+
+    /** @brief Ticket the next submitted frame will get. */
+    Ticket next_ticket() const noexcept;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Per-slot frame state. */
+    struct Frame {
+        Ticket id = 0;
+        internal::BgrMat bgr;
+        std::vector<cv::Rect> rects;
+        std::vector<std::vector<algo::Detection>> per_tile; ///< Indexed by tile; merged on completion
+        std::vector<TileTiming> timings;                    ///< Indexed by tile
+        int remaining = 0;                                  ///< Tiles not finished yet
+        Status status = Status::Ok();                       ///< First tile error (later tiles are skipped)
+        Clock::time_point t0{};
+    };
+
+    /** @brief One unit of work: tile @c tile of the frame in slot @c slot. */
+    struct Task {
+        int slot = 0;
+        int tile = 0;
+    };
+
+    /** @brief Starts runners on the pool until all workers run or every queued tile has one. Caller holds the lock. */
+    void start_runners_();
+
+    /** @brief Runner: pops tiles of any in-flight frame in FIFO order until the queue is empty. */
+    void run_tasks_() noexcept;
+
+    /** @brief Runs one tile outside the lock; fills @p dets and @p timing. */
+    Status run_tile_(const cv::Mat& tile, int worker, Clock::time_point t0, std::vector<algo::Detection>& dets,
+                     TileTiming& timing) noexcept;
+
+    /** @brief Merges slot @p k, publishes its result and releases the slot. Caller holds the lock. */
+    void complete_(int k) noexcept;
+
+    engine::IEngine& eng_;
+    const bool bound_;
+    const int depth_;
+    const int workers_;
+    platform::ThreadPool& threads_;
+    std::unique_ptr<engine::ContextPool> pool_; ///< Bound mode only
+
+    mutable std::mutex mu_;
+    std::condition_variable slot_cv_; ///< Signals a freed slot (submit backpressure)
+    std::condition_variable idle_cv_; ///< Signals the last runner leaving
+    std::condition_variable done_cv_; ///< Signals a completed frame
+
+    std::vector<Frame> frames_;
+    std::vector<int> free_;
+    std::deque<Task> tasks_;   ///< Tiles of all in-flight frames, in submission order
+    std::vector<int> free_ids_; ///< Worker ids not held by a runner (reported in TileTiming::worker)
+    int running_ = 0;           ///< Runners queued or active on the pool
+
+    std::unordered_set<Ticket> pending_;
+    std::unordered_map<Ticket, Result<FrameResult>> done_;
+    Ticket next_id_;
+    bool stop_ = false;
+};
+
+} // namespace idet::pipeline
@@ -0,0 +1,90 @@
+/**
+ * @file buffer_alloc.cpp
+ * @ingroup idet_platform
+ * @brief Implementation of the bound buffer allocator (aligned new, @c mmap with huge pages).
+ */
+
+#include "platform/buffer_alloc.h"
+
+#include <cstdint>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+namespace idet::platform {
+
+namespace {
+
+#if defined(__linux__)
+/// @brief Whether a block of @p bytes is mapped (rather than allocated like Aligned).
+bool mapped(std::size_t bytes, BufferPolicy policy) noexcept {
+    return policy == BufferPolicy::HugePages && bytes >= kHugePage / 2;
+}
+
+std::size_t huge_round(std::size_t bytes) noexcept {
+    return (bytes + kHugePage - 1) & ~(kHugePage - 1);
+}
+
+/**
+ * @brief Maps @p len bytes (a multiple of @ref kHugePage) in huge pages, or returns nullptr.
+ *
+ * @details
+ * Explicit huge pages are reserved at @c mmap time for private mappings, so that call fails
+ * cleanly when the pool is empty. The fallback maps one extra huge page, trims the mapping to an
+ * aligned run and asks for transparent huge pages; whether it gets them is up to the kernel
+ * (@c /sys/kernel/mm/transparent_hugepage/enabled must be @c madvise or @c always).
+ */
+void* map_huge(std::size_t len) noexcept {
+    constexpr int kProt = PROT_READ | PROT_WRITE;
+    constexpr int kFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #if defined(MAP_HUGETLB)
+    void* p = ::mmap(nullptr, len, kProt, kFlags | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) return p;
+    #endif
+
+    const std::size_t span = len + kHugePage;
+    void* raw = ::mmap(nullptr, span, kProt, kFlags, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    const std::uintptr_t b = (std::uintptr_t)raw;
+    const std::uintptr_t a = (b + kHugePage - 1) & ~(std::uintptr_t)(kHugePage - 1);
+    if (a > b) ::munmap(raw, a - b);
+    const std::uintptr_t tail = b + span - (a + len);
+    if (tail > 0) ::munmap((void*)(a + len), tail);
+    #if defined(MADV_HUGEPAGE)
+    (void)::madvise((void*)a, len, MADV_HUGEPAGE);
+    #endif
+    return (void*)a;
+}
+#endif
+
+} // namespace
+
+void* buffer_allocate(std::size_t bytes, BufferPolicy policy) {
+#if defined(__linux__)
+    if (mapped(bytes, policy)) {
+        void* p = map_huge(huge_round(bytes));
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+#endif
+    if (policy == BufferPolicy::Heap) return ::operator new(bytes);
+    return ::operator new(bytes, std::align_val_t(kBufferAlign));
+}
+
+void buffer_deallocate(void* p, std::size_t bytes, BufferPolicy policy) noexcept {
+    if (!p) return;
+#if defined(__linux__)
+    if (mapped(bytes, policy)) {
+        ::munmap(p, huge_round(bytes));
+        return;
+    }
+#endif
+    if (policy == BufferPolicy::Heap)
+        ::operator delete(p);
+    else
+        ::operator delete(p, std::align_val_t(kBufferAlign));
+}
+
+} // namespace idet::platform
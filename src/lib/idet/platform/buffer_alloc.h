@@ -0,0 +1,97 @@
+/**
+ * @file buffer_alloc.h
+ * @ingroup idet_platform
+ * @brief Allocator of the bound I/O buffers (aligned heap blocks or 2 MiB pages).
+ *
+ * @details
+ * Bound contexts own input/output buffers of several MB that every frame walks through. With
+ * @ref idet::BufferPolicy::HugePages such buffers are backed by 2 MiB pages, which cuts the TLB
+ * misses of the preprocessing, the session run and the decoder to a few per frame.
+ *
+ * Placement follows first touch: engines zero the buffers while setting up the binding, so the
+ * pages land on the NUMA node of the thread running the setup (the replica node in
+ * @ref idet::DetectorGroup, whose replicas are created on node-bound threads).
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "idet.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace idet::platform {
+
+/** @brief Alignment of @ref BufferPolicy::Aligned blocks (one cache line). */
+inline constexpr std::size_t kBufferAlign = 64;
+
+/** @brief Page size used by @ref BufferPolicy::HugePages. */
+inline constexpr std::size_t kHugePage = std::size_t(2) << 20;
+
+/**
+ * @brief Allocates @p bytes (> 0) under @p policy.
+ *
+ * @details
+ * HugePages maps blocks of at least half a huge page in whole huge pages: explicit ones
+ * (@c MAP_HUGETLB) when the system has them reserved, else a huge-page aligned anonymous mapping
+ * marked for transparent huge pages. Smaller blocks, and every block on platforms without huge
+ * page support, are allocated like @ref BufferPolicy::Aligned.
+ *
+ * @throws std::bad_alloc if the memory cannot be obtained.
+ */
+void* buffer_allocate(std::size_t bytes, BufferPolicy policy);
+
+/** @brief Releases a block of @ref buffer_allocate (same @p bytes and @p policy). */
+void buffer_deallocate(void* p, std::size_t bytes, BufferPolicy policy) noexcept;
+
+/**
+ * @brief Standard allocator over @ref buffer_allocate carrying its policy.
+ *
+ * @details
+ * The policy propagates with the container on copy, move and swap, so a buffer keeps the
+ * allocation it was created with.
+ */
+template <class T> class BufferAllocator {
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    BufferAllocator() noexcept = default;
+    explicit BufferAllocator(BufferPolicy policy) noexcept : policy_(policy) {}
+    template <class U> BufferAllocator(const BufferAllocator<U>& o) noexcept : policy_(o.policy()) {}
+
+    T* allocate(std::size_t n) {
+        if (n > (std::size_t)-1 / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(buffer_allocate(n * sizeof(T), policy_));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        buffer_deallocate(p, n * sizeof(T), policy_);
+    }
+
+    BufferPolicy policy() const noexcept {
+        return policy_;
+    }
+
+    template <class U> bool operator==(const BufferAllocator<U>& o) const noexcept {
+        return policy_ == o.policy();
+    }
+    template <class U> bool operator!=(const BufferAllocator<U>& o) const noexcept {
+        return policy_ != o.policy();
+    }
+
+  private:
+    BufferPolicy policy_ = BufferPolicy::Heap;
+};
+
+/** @brief Vector over a @ref BufferAllocator (bound input/output buffers). */
+template <class T> using BoundBuffer = std::vector<T, BufferAllocator<T>>;
+
+} // namespace idet::platform
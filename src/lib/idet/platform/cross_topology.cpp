@@ -48,6 +48,7 @@ namespace fs = std::filesystem;
     #include <dirent.h>
     #include <numaif.h> // move_pages
     #include <sched.h>
+    #include <thread>
     #include <unistd.h>
 
 #elif defined(__APPLE__)
@@ -733,6 +734,92 @@ static Topology detect_linux() {
     return topo;
 }
 
+/**
+ * @brief Deterministic choice of @p desired_threads CPUs out of @p global_avail.
+ *
+ * Socket of the calling thread first, then larger sockets; a single socket when one can host all
+ * threads, otherwise a compact spill. Within a socket physical cores come before SMT siblings.
+ * Returns fewer CPUs than requested only if the topology and @p global_avail disagree.
+ */
+static std::vector<int> choose_cpus(const Topology& topology, const std::vector<int>& global_avail,
+                                    std::size_t desired_threads) {
+    // Build socket candidates: intersect socket CPUs with global_avail, then apply a physical-first ordering.
+    const std::set<int> G(global_avail.begin(), global_avail.end());
+
+    struct SockCand {
+        int socket_id = -1;
+        std::vector<int> avail_ordered;
+        bool contains_current_cpu = false;
+    };
+
+    const int current_cpu = sched_getcpu();
+
+    std::vector<SockCand> cands;
+    cands.reserve(topology.sockets.size());
+
+    for (const auto& s : topology.sockets) {
+        const auto& src = !s.available_cpu_ids.empty() ? s.available_cpu_ids : s.logical_cpu_ids;
+
+        std::vector<int> avail;
+        avail.reserve(src.size());
+        for (int c : src)
+            if (G.count(c)) avail.push_back(c);
+
+        std::sort(avail.begin(), avail.end());
+        avail.erase(std::unique(avail.begin(), avail.end()), avail.end());
+        if (avail.empty()) continue;
+
+        SockCand sc;
+        sc.socket_id = s.socket_id;
+        sc.contains_current_cpu =
+            (current_cpu >= 0) && (std::find(avail.begin(), avail.end(), current_cpu) != avail.end());
+        sc.avail_ordered = physical_first_order(avail);
+        cands.push_back(std::move(sc));
+    }
+
+    // If socket decomposition is missing/unreliable, treat the entire available set as a single candidate.
+    if (cands.empty()) {
+        SockCand sc;
+        sc.socket_id = 0;
+        sc.contains_current_cpu = (current_cpu >= 0) && (std::find(global_avail.begin(), global_avail.end(),
+                                                                   current_cpu) != global_avail.end());
+        sc.avail_ordered = physical_first_order(global_avail);
+        cands.push_back(std::move(sc));
+    }
+
+    // Prefer the socket that contains the current CPU, then prefer larger candidates (more CPUs available).
+    std::sort(cands.begin(), cands.end(), [](const SockCand& a, const SockCand& b) {
+        if (a.contains_current_cpu != b.contains_current_cpu) return a.contains_current_cpu > b.contains_current_cpu;
+        if (a.avail_ordered.size() != b.avail_ordered.size()) return a.avail_ordered.size() > b.avail_ordered.size();
+        return a.socket_id < b.socket_id;
+    });
+
+    std::vector<int> chosen_cpus;
+    chosen_cpus.reserve(desired_threads);
+
+    // 1) Single-socket placement if any socket can host all desired threads.
+    for (const auto& sc : cands) {
+        if (sc.avail_ordered.size() >= desired_threads) {
+            chosen_cpus.assign(sc.avail_ordered.begin(),
+                               sc.avail_ordered.begin() + static_cast<std::ptrdiff_t>(desired_threads));
+            break;
+        }
+    }
+
+    // 2) Compact spill across sockets: fill candidates in sorted preference order until enough CPUs are selected.
+    if (chosen_cpus.empty()) {
+        for (const auto& sc : cands) {
+            for (int c : sc.avail_ordered) {
+                if (chosen_cpus.size() == desired_threads) break;
+                chosen_cpus.push_back(c);
+            }
+            if (chosen_cpus.size() == desired_threads) break;
+        }
+    }
+
+    return chosen_cpus;
+}
+
 #endif // __linux__
 
 #if defined(__APPLE__)
@@ -884,82 +971,10 @@ idet::Status apply_process_placement_policy(const idet::RuntimePolicy& runtime_p
         return idet::Status::Invalid(oss.str());
     }
 
-    // Build socket candidates: intersect socket CPUs with global_avail, then apply a physical-first ordering.
-    const std::set<int> G(global_avail.begin(), global_avail.end());
-
-    struct SockCand {
-        int socket_id = -1;
-        std::vector<int> avail_ordered;
-        bool contains_current_cpu = false;
-    };
-
-    const int current_cpu = sched_getcpu();
-
-    std::vector<SockCand> cands;
-    cands.reserve(topology.sockets.size());
-
-    for (const auto& s : topology.sockets) {
-        const auto& src = !s.available_cpu_ids.empty() ? s.available_cpu_ids : s.logical_cpu_ids;
-
-        std::vector<int> avail;
-        avail.reserve(src.size());
-        for (int c : src)
-            if (G.count(c)) avail.push_back(c);
-
-        std::sort(avail.begin(), avail.end());
-        avail.erase(std::unique(avail.begin(), avail.end()), avail.end());
-        if (avail.empty()) continue;
-
-        SockCand sc;
-        sc.socket_id = s.socket_id;
-        sc.contains_current_cpu =
-            (current_cpu >= 0) && (std::find(avail.begin(), avail.end(), current_cpu) != avail.end());
-        sc.avail_ordered = physical_first_order(avail);
-        cands.push_back(std::move(sc));
-    }
-
-    // If socket decomposition is missing/unreliable, treat the entire available set as a single candidate.
-    if (cands.empty()) {
-        SockCand sc;
-        sc.socket_id = 0;
-        sc.contains_current_cpu = (current_cpu >= 0) && (std::find(global_avail.begin(), global_avail.end(),
-                                                                   current_cpu) != global_avail.end());
-        sc.avail_ordered = physical_first_order(global_avail);
-        cands.push_back(std::move(sc));
-    }
-
-    // Prefer the socket that contains the current CPU, then prefer larger candidates (more CPUs available).
-    std::sort(cands.begin(), cands.end(), [](const SockCand& a, const SockCand& b) {
-        if (a.contains_current_cpu != b.contains_current_cpu) return a.contains_current_cpu > b.contains_current_cpu;
-        if (a.avail_ordered.size() != b.avail_ordered.size()) return a.avail_ordered.size() > b.avail_ordered.size();
-        return a.socket_id < b.socket_id;
-    });
-
-    std::vector<int> chosen_cpus;
-    chosen_cpus.reserve(desired_threads);
-
-    // 1) Single-socket placement if any socket can host all desired threads.
-    for (const auto& sc : cands) {
-        if (sc.avail_ordered.size() >= desired_threads) {
-            chosen_cpus.assign(sc.avail_ordered.begin(),
-                               sc.avail_ordered.begin() + static_cast<std::ptrdiff_t>(desired_threads));
-            break;
-        }
-    }
-
-    // 2) Compact spill across sockets: fill candidates in sorted preference order until enough CPUs are selected.
-    if (chosen_cpus.empty()) {
-        for (const auto& sc : cands) {
-            for (int c : sc.avail_ordered) {
-                if (chosen_cpus.size() == desired_threads) break;
-                chosen_cpus.push_back(c);
-            }
-            if (chosen_cpus.size() == desired_threads) break;
-        }
-        if (chosen_cpus.size() != desired_threads) {
-            return idet::Status::Internal(
-                "apply_process_placement_policy: could not gather enough CPUs; inconsistent topology/cpuset?");
-        }
+    const std::vector<int> chosen_cpus = choose_cpus(topology, global_avail, desired_threads);
+    if (chosen_cpus.size() != desired_threads) {
+        return idet::Status::Internal(
+            "apply_process_placement_policy: could not gather enough CPUs; inconsistent topology/cpuset?");
     }
 
     // 3) Apply CPU affinity to ALL current threads in the process.
@@ -996,6 +1011,138 @@ idet::Status apply_process_placement_policy(const idet::RuntimePolicy& runtime_p
 #endif
 }
 
+std::vector<NumaNode> detect_numa_nodes() {
+    std::vector<NumaNode> out;
+#if defined(__linux__)
+    const auto topology = detect_topology();
+    const auto& avail = !topology.available_cpu_ids.empty() ? topology.available_cpu_ids : topology.all_cpu_ids;
+    const std::set<int> A(avail.begin(), avail.end());
+
+    for (const auto& [node, cpus] : linux_numa_node_to_cpus()) {
+        NumaNode n;
+        n.node_id = node;
+        for (int c : cpus)
+            if (A.count(c)) n.cpu_ids.push_back(c);
+        std::sort(n.cpu_ids.begin(), n.cpu_ids.end());
+        n.cpu_ids.erase(std::unique(n.cpu_ids.begin(), n.cpu_ids.end()), n.cpu_ids.end());
+        if (!n.cpu_ids.empty()) out.push_back(std::move(n));
+    }
+    if (!out.empty()) return out;
+
+    NumaNode all;
+    all.cpu_ids.assign(A.begin(), A.end());
+    out.push_back(std::move(all));
+#else
+    NumaNode all;
+    all.cpu_ids = detect_topology().available_cpu_ids;
+    out.push_back(std::move(all));
+#endif
+    return out;
+}
+
+std::vector<int> select_pool_cpus(std::size_t count) {
+#if defined(__linux__)
+    const auto topology = detect_topology();
+    const auto& avail = !topology.available_cpu_ids.empty() ? topology.available_cpu_ids : topology.all_cpu_ids;
+    return choose_cpus(topology, avail, std::min(count, avail.size()));
+#else
+    (void)count;
+    return {};
+#endif
+}
+
+std::vector<std::vector<int>> partition_cpus(const std::vector<int>& cpus, const std::vector<int>& want) {
+    const std::size_t k = want.size();
+    std::vector<std::vector<int>> parts(k);
+    if (cpus.size() < k) return parts;
+
+    std::vector<std::size_t> share(k, 0);
+    std::size_t fixed = 0, autos = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+        if (want[i] > 0) {
+            share[i] = (std::size_t)want[i];
+            fixed += share[i];
+        } else {
+            ++autos;
+        }
+    }
+
+    if (fixed + autos > cpus.size()) {
+        // Requests do not fit: even split.
+        for (std::size_t i = 0; i < k; ++i)
+            share[i] = cpus.size() / k + (i < cpus.size() % k ? 1 : 0);
+    } else if (autos > 0) {
+        const std::size_t rest = cpus.size() - fixed;
+        std::size_t a = 0;
+        for (std::size_t i = 0; i < k; ++i) {
+            if (want[i] > 0) continue;
+            share[i] = rest / autos + (a < rest % autos ? 1 : 0);
+            ++a;
+        }
+    }
+
+    std::size_t at = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+        parts[i].assign(cpus.begin() + (std::ptrdiff_t)at, cpus.begin() + (std::ptrdiff_t)(at + share[i]));
+        at += share[i];
+    }
+    return parts;
+}
+
+std::size_t available_cpu_count() noexcept {
+#if defined(__linux__)
+    try {
+        const std::size_t n = linux_affinity_cpu_ids().size();
+        if (n > 0) return n;
+    } catch (...) {
+    }
+#endif
+    const unsigned hc = std::thread::hardware_concurrency();
+    return hc > 0 ? (std::size_t)hc : 1u;
+}
+
+idet::Status pin_current_thread(int cpu) {
+#if defined(__linux__)
+    return linux_set_affinity_tid(0, {cpu});
+#else
+    (void)cpu;
+    return idet::Status::Ok();
+#endif
+}
+
+idet::Status bind_current_thread_to_cpus(const std::vector<int>& cpus) {
+#if defined(__linux__)
+    if (cpus.empty()) return idet::Status::Ok();
+    return linux_set_affinity_tid(0, cpus);
+#else
+    (void)cpus;
+    return idet::Status::Ok();
+#endif
+}
+
+idet::Status bind_current_thread_to_node(const NumaNode& node, const idet::RuntimePolicy& runtime_policy) {
+#if !defined(__linux__)
+    (void)node;
+    (void)runtime_policy;
+    return idet::Status::Ok();
+#else
+    if (node.node_id < 0 || node.cpu_ids.empty()) return idet::Status::Ok();
+
+    auto r = linux_set_affinity_tid(0, node.cpu_ids);
+    if (!r.ok()) return r;
+
+    if (runtime_policy.soft_mem_bind) {
+    #if HAS_LIBNUMA
+        return linux_apply_soft_mempolicy({node.node_id}, runtime_policy.numa_mem_policy);
+    #else
+        return idet::Status::Invalid("bind_current_thread_to_node: soft_mem_bind requested, but built without libnuma "
+                                     "(define USE_LIBNUMA and install libnuma-dev)");
+    #endif
+    }
+    return idet::Status::Ok();
+#endif
+}
+
 // ----------------------------- Diagnostics -----------------------------
 
 idet::Status verify_all_threads_affinity_subset(const std::vector<int>& allowed_cpus, bool verbose) {
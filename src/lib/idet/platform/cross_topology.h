@@ -124,6 +124,100 @@ void print_topology(const Topology& topology);
  */
 idet::Status apply_process_placement_policy(const idet::RuntimePolicy& runtime_policy, std::size_t desired_threads);
 
+/**
+ * @brief NUMA node together with the CPUs of it that this process may run on.
+ */
+struct NumaNode {
+    /** @brief Linux NUMA node id; -1 for the single pseudo-node used when NUMA is unavailable. */
+    int node_id = -1;
+
+    /** @brief Process-available CPUs (cpuset/affinity) belonging to this node, ascending. */
+    std::vector<int> cpu_ids;
+};
+
+/**
+ * @brief Groups the process-available CPUs by NUMA node.
+ *
+ * Nodes without any available CPU are omitted. When the platform exposes no NUMA information
+ * (non-Linux, or no @c /sys/devices/system/node), a single pseudo-node holding all available
+ * CPUs is returned, so the result is never empty.
+ *
+ * @return Nodes ordered by id.
+ */
+std::vector<NumaNode> detect_numa_nodes();
+
+/**
+ * @brief CPUs for pinning the threads of a shared thread pool, one per thread, in thread order.
+ *
+ * Uses the same selection as @ref apply_process_placement_policy (socket of the calling thread,
+ * compact spill across sockets, physical cores before SMT siblings) over the process-available
+ * CPUs, so the pool lands inside the mask chosen by an earlier placement call.
+ *
+ * @param count Number of pool threads.
+ * @return Up to @p count CPU ids (fewer if fewer are available); empty on non-Linux platforms.
+ */
+std::vector<int> select_pool_cpus(std::size_t count);
+
+/**
+ * @brief Splits @p cpus into one contiguous partition per entry of @p want.
+ *
+ * @details
+ * @p cpus typically comes from @ref select_pool_cpus, so contiguous ranges keep physical cores
+ * (and sockets) together. Entries of @p want > 0 get that many CPUs and the rest is shared evenly
+ * among the entries <= 0 (earlier entries take the remainder). When the requests do not fit, every
+ * entry gets an even share instead.
+ *
+ * @param cpus CPUs to split, in preference order.
+ * @param want Requested CPUs per partition (<= 0: share of the rest).
+ * @return One partition per entry of @p want; all empty when there are fewer CPUs than entries.
+ */
+std::vector<std::vector<int>> partition_cpus(const std::vector<int>& cpus, const std::vector<int>& want);
+
+/**
+ * @brief Number of CPUs the calling thread may run on (its affinity mask).
+ *
+ * One @c sched_getaffinity(2) call on Linux, so it is cheap enough to query per frame and
+ * follows later placement changes; @c std::thread::hardware_concurrency() elsewhere.
+ *
+ * @return Count >= 1.
+ */
+std::size_t available_cpu_count() noexcept;
+
+/**
+ * @brief Pins the calling thread to the single CPU @p cpu.
+ *
+ * @param cpu CPU id (as returned by @ref select_pool_cpus).
+ * @return @ref idet::Status::Ok() on success (and on non-Linux platforms, where it is a no-op).
+ */
+idet::Status pin_current_thread(int cpu);
+
+/**
+ * @brief Restricts the calling thread to the CPUs in @p cpus.
+ *
+ * Threads created afterwards by the calling thread inherit the mask.
+ *
+ * @param cpus CPU ids (as returned by @ref select_pool_cpus); empty leaves the mask unchanged.
+ * @return @ref idet::Status::Ok() on success (and on non-Linux platforms, where it is a no-op).
+ */
+idet::Status bind_current_thread_to_cpus(const std::vector<int>& cpus);
+
+/**
+ * @brief Binds the calling thread to @p node: CPU affinity and, optionally, a node-local memory policy.
+ *
+ * With the default Linux first-touch policy, affinity alone already places pages the thread
+ * touches first on @p node. If @c runtime_policy.soft_mem_bind is set, the thread additionally
+ * gets @c numa_mem_policy applied to the single node (requires libnuma, as in
+ * @ref apply_process_placement_policy).
+ *
+ * Threads created afterwards by the calling thread (e.g. an ONNX Runtime intra-op pool) inherit
+ * both the affinity mask and the memory policy.
+ *
+ * @param node Target node as returned by @ref detect_numa_nodes.
+ * @param runtime_policy Runtime policy; only @c soft_mem_bind and @c numa_mem_policy are used.
+ * @return @ref idet::Status::Ok() on success (and on non-Linux platforms / pseudo-nodes, where it is a no-op).
+ */
+idet::Status bind_current_thread_to_node(const NumaNode& node, const idet::RuntimePolicy& runtime_policy);
+
 /**
  * @brief Diagnostic: verifies all current threads' affinity is a subset of @p allowed_cpus.
  *
@@ -0,0 +1,67 @@
+/**
+ * @file mapped_file.cpp
+ * @ingroup idet_platform
+ * @brief Implementation of read-only file mappings (POSIX @c mmap).
+ */
+
+#include "platform/mapped_file.h"
+
+#include <new>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+namespace idet::platform {
+
+Result<std::shared_ptr<const MappedFile>> MappedFile::open(const std::string& path) noexcept {
+    using R = Result<std::shared_ptr<const MappedFile>>;
+#if defined(_WIN32)
+    (void)path;
+    return R::Err(Status::Unsupported("MappedFile: memory-mapped files are not supported on this platform"));
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return R::Err(Status::Invalid("MappedFile: cannot open " + path + ": " + std::strerror(errno)));
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return R::Err(Status::Invalid("MappedFile: empty or unreadable file: " + path));
+    }
+
+    const std::size_t size = (std::size_t)st.st_size;
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int err = errno;
+    ::close(fd); // the mapping keeps its own reference to the file
+    if (p == MAP_FAILED)
+        return R::Err(Status::Invalid("MappedFile: mmap failed for " + path + ": " + std::strerror(err)));
+
+    // Session creation reads the whole model front to back.
+    (void)::madvise(p, size, MADV_WILLNEED);
+
+    const MappedFile* m = new (std::nothrow) MappedFile(p, size);
+    if (!m) {
+        ::munmap(p, size);
+        return R::Err(Status::OutOfMemory("MappedFile: bad_alloc"));
+    }
+    try {
+        return R::Ok(std::shared_ptr<const MappedFile>(m));
+    } catch (const std::bad_alloc&) {
+        return R::Err(Status::OutOfMemory("MappedFile: bad_alloc")); // the failed shared_ptr deleted m
+    }
+#endif
+}
+
+MappedFile::~MappedFile() noexcept {
+#if !defined(_WIN32)
+    if (data_) ::munmap(data_, size_);
+#endif
+}
+
+} // namespace idet::platform
@@ -0,0 +1,64 @@
+/**
+ * @file mapped_file.h
+ * @ingroup idet_platform
+ * @brief Read-only memory mapping of a file (model weights shared through the page cache).
+ *
+ * @details
+ * A model created from a mapping instead of a path is read straight from the page cache: no
+ * private heap copy of the file is made while loading, and for ORT-format models whose bytes are
+ * used in place (@c session.use_ort_model_bytes_directly) the weight pages stay file-backed, so
+ * every process mapping the same file shares one physical copy.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include "status.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace idet::platform {
+
+/**
+ * @brief Owner of a private read-only mapping of a whole file.
+ *
+ * @details
+ * Immutable once opened, so a shared instance may be read from any thread.
+ */
+class MappedFile final {
+  public:
+    /**
+     * @brief Maps @p path read-only.
+     *
+     * @return The mapping, Invalid if the file cannot be opened, is empty or cannot be mapped,
+     *         Unsupported on platforms without @c mmap.
+     */
+    static Result<std::shared_ptr<const MappedFile>> open(const std::string& path) noexcept;
+
+    /** @brief Unmaps the file. */
+    ~MappedFile() noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /** @brief First byte of the mapping. */
+    const void* data() const noexcept {
+        return data_;
+    }
+
+    /** @brief Mapped size in bytes (the file size at @ref open). */
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+  private:
+    MappedFile(void* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace idet::platform
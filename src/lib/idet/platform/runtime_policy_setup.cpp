@@ -5,10 +5,11 @@
  *
  * @details
  * Implements @ref idet::platform::setup_runtime_policy_impl:
- * - computes a conservative desired concurrency from ORT intra/inter and tile OpenMP threads,
+ * - computes a conservative desired concurrency from ORT intra/inter and tile/postprocess OpenMP threads,
  * - applies process/thread affinity via @ref idet::platform::apply_process_placement_policy,
  * - optionally prints topology and runs affinity/NUMA diagnostics,
- * - configures OpenMP environment/runtime via @ref idet::platform::configure_openmp_affinity,
+ * - configures OpenMP environment/runtime via @ref idet::platform::configure_openmp_affinity
+ *   (for application OpenMP code; the library itself runs on @ref idet::platform::ThreadPool),
  * - optionally suppresses OpenCV internal threading (cv::setNumThreads(1)).
  *
  * @warning
@@ -77,24 +78,28 @@ idet::Status setup_runtime_policy_impl(const idet::RuntimePolicy& policy, bool v
         const std::size_t ort_intra_th = clamp_threads_(policy.ort_intra_threads);
         const std::size_t ort_inter_th = clamp_threads_(policy.ort_inter_threads);
         const std::size_t tile_omp_th = clamp_threads_(policy.tile_omp_threads);
+        const std::size_t post_omp_th = clamp_threads_(policy.post_omp_threads);
 
         /**
          * @details
          * Compute a conservative estimate of "peak concurrency" requested by the configuration.
          *
          * Rationale:
-         * - In tiling mode, OpenMP often provides most parallelism => desired ~= tile_omp_th.
+         * - In tiling mode, the worker pool provides most parallelism => desired ~= tile_omp_th.
          * - In non-tiling mode, ORT thread pools dominate => desired ~= max(intra, inter).
          * - If both ORT intra and inter are > 1, concurrent activity can exceed either value;
          *   a simple upper bound is intra + inter.
          *
          * The final desired thread budget is chosen as a conservative sum:
-         *   desired_threads = tile_omp_th + ort_peak
+         *   desired_threads = max(tile_omp_th, post_omp_th) + ort_peak
          * so that tiling workers and ORT workers are less likely to oversubscribe a tight CPU mask.
+         * Postprocessing teams never run next to tile workers (tiles decode serially), hence the max.
          *
          * @note
          * This is an estimate. The true number of runnable threads depends on ORT execution patterns,
-         * OpenMP runtime behavior, and operator-specific parallelism.
+         * OpenMP runtime behavior, and operator-specific parallelism. Only with
+         * @ref idet::RuntimePolicy::ort_global_pools does the ORT part bound all detectors of the
+         * process; per-session pools add up per detector.
          */
         std::size_t ort_peak = 1;
         if (ort_intra_th > 1 && ort_inter_th > 1) {
@@ -102,7 +107,7 @@ idet::Status setup_runtime_policy_impl(const idet::RuntimePolicy& policy, bool v
         } else {
             ort_peak = std::max<std::size_t>(ort_intra_th, ort_inter_th);
         }
-        const std::size_t desired_threads = tile_omp_th + ort_peak;
+        const std::size_t desired_threads = std::max(tile_omp_th, post_omp_th) + ort_peak;
 
         /**
          * @details
@@ -156,7 +161,7 @@ idet::Status setup_runtime_policy_impl(const idet::RuntimePolicy& policy, bool v
          * Some OpenMP runtimes may already be initialized by other libraries; in such cases only
          * a subset of settings may take effect.
          */
-        configure_openmp_affinity(tile_omp_th, verbose);
+        configure_openmp_affinity(std::max(tile_omp_th, post_omp_th), verbose);
 
         /**
          * @details
@@ -0,0 +1,207 @@
+/**
+ * @file thread_pool.cpp
+ * @ingroup idet_platform
+ * @brief Implementation of the library worker pool.
+ *
+ * @details
+ * Workers block on one mutex-guarded FIFO. A @c parallel_for region is a shared state object:
+ * the caller and every helper task pull indices from one atomic counter. Helpers check in under
+ * the region mutex before touching the body; the caller closes the region after its own loop and
+ * waits only for helpers that already checked in, so late helpers return without running anything
+ * and the caller's stack frame (body, captures) is never used after it returns.
+ */
+
+#include "platform/thread_pool.h"
+
+#include "platform/cross_topology.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <exception>
+#include <memory>
+
+namespace idet::platform {
+
+namespace {
+
+/// @brief Set while the calling thread runs the body of a parallel region.
+thread_local bool t_in_region = false;
+
+/// @brief Per-thread override of ThreadPool::current (nullptr: global pool).
+thread_local ThreadPool* t_current = nullptr;
+
+/** @brief Shared state of one @c parallel_for region. */
+struct Region {
+    void (*fn)(void*, int, int) = nullptr;
+    void* ctx = nullptr;
+    int n = 0;
+
+    std::atomic<int> next{0};     ///< Next index to hand out
+    std::atomic<int> ids{1};      ///< Next helper worker id
+    std::atomic<bool> failed{false};
+
+    std::mutex mu;
+    std::condition_variable cv; ///< Signals the last active helper leaving
+    int active = 0;             ///< Helpers that checked in and have not returned yet
+    bool closed = false;        ///< Set by the caller; later helpers return immediately
+    std::exception_ptr err;     ///< First exception thrown by the body
+};
+
+/// @brief Pulls and runs indices of @p r until they are exhausted or the body failed.
+void work(Region& r, int worker) noexcept {
+    const bool outer = t_in_region;
+    t_in_region = true;
+    while (!r.failed.load(std::memory_order_relaxed)) {
+        const int i = r.next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= r.n) break;
+        try {
+            r.fn(r.ctx, i, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lk(r.mu);
+            if (!r.err) r.err = std::current_exception();
+            r.failed.store(true, std::memory_order_relaxed);
+        }
+    }
+    t_in_region = outer;
+}
+
+} // namespace
+
+ThreadPool::~ThreadPool() noexcept {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+    }
+    task_cv_.notify_all();
+    for (auto& t : workers_) {
+        // exit() called from a task runs this destructor on a worker, which cannot join itself.
+        if (t.get_id() == std::this_thread::get_id())
+            t.detach();
+        else if (t.joinable())
+            t.join();
+    }
+}
+
+ThreadPool& ThreadPool::global() noexcept {
+    static ThreadPool pool;
+    return pool;
+}
+
+ThreadPool& ThreadPool::current() noexcept {
+    return t_current ? *t_current : global();
+}
+
+void ThreadPool::set_current(ThreadPool* pool) noexcept {
+    t_current = pool;
+}
+
+int ThreadPool::hardware_width() noexcept {
+    return (int)std::min<std::size_t>(available_cpu_count(), (std::size_t)INT_MAX);
+}
+
+bool ThreadPool::in_parallel() noexcept {
+    return t_in_region;
+}
+
+std::size_t ThreadPool::size() const noexcept {
+    std::lock_guard<std::mutex> lk(mu_);
+    return workers_.size();
+}
+
+void ThreadPool::pin_workers(std::vector<int> cpus) {
+    std::lock_guard<std::mutex> lk(mu_);
+    pin_cpus_ = std::move(cpus);
+}
+
+void ThreadPool::reserve(std::size_t workers) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (workers_.size() >= workers) return;
+    workers_.reserve(workers);
+    while (workers_.size() < workers) {
+        const int cpu = pin_cpus_.empty() ? -1 : pin_cpus_[workers_.size() % pin_cpus_.size()];
+        workers_.emplace_back([this, cpu] { worker_loop_(cpu); });
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (workers_.empty()) {
+            const int cpu = pin_cpus_.empty() ? -1 : pin_cpus_.front();
+            workers_.emplace_back([this, cpu] { worker_loop_(cpu); });
+        }
+        tasks_.push_back(std::move(task));
+    }
+    task_cv_.notify_one();
+}
+
+void ThreadPool::run_(int n, int width, BodyFn fn, void* ctx) {
+    if (n <= 0) return;
+    if (width <= 0) width = hardware_width();
+    width = std::min(width, n);
+
+    if (width <= 1 || t_in_region) {
+        for (int i = 0; i < n; ++i)
+            fn(ctx, i, 0);
+        return;
+    }
+
+    auto region = std::make_shared<Region>();
+    region->fn = fn;
+    region->ctx = ctx;
+    region->n = n;
+
+    // Best-effort: with fewer workers or queue slots the caller simply runs more indices itself.
+    const int helpers = width - 1;
+    try {
+        reserve((std::size_t)helpers);
+    } catch (...) {
+    }
+    try {
+        for (int h = 0; h < helpers; ++h) {
+            submit([region] {
+                {
+                    std::lock_guard<std::mutex> lk(region->mu);
+                    if (region->closed) return;
+                    ++region->active;
+                }
+                work(*region, region->ids.fetch_add(1, std::memory_order_relaxed));
+                std::lock_guard<std::mutex> lk(region->mu);
+                if (--region->active == 0) region->cv.notify_all();
+            });
+        }
+    } catch (...) {
+    }
+
+    work(*region, 0);
+    {
+        std::unique_lock<std::mutex> lk(region->mu);
+        region->closed = true;
+        region->cv.wait(lk, [&] { return region->active == 0; });
+    }
+    if (region->err) std::rethrow_exception(region->err);
+}
+
+void ThreadPool::worker_loop_(int cpu) {
+    if (cpu >= 0) (void)pin_current_thread(cpu); // best-effort: an unavailable CPU keeps the inherited mask
+    t_current = this;
+
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+        task_cv_.wait(lk, [this] { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;
+
+        std::function<void()> task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lk.unlock();
+        try {
+            task();
+        } catch (...) {
+        }
+        task = nullptr; // release captured state before blocking again
+        lk.lock();
+    }
+}
+
+} // namespace idet::platform
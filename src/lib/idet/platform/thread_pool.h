@@ -0,0 +1,145 @@
+/**
+ * @file thread_pool.h
+ * @ingroup idet_platform
+ * @brief Library-owned persistent worker pool for tile, postprocessing and pipeline parallelism.
+ *
+ * @details
+ * All library-side parallelism runs on one process-wide set of worker threads instead of
+ * OpenMP teams, so it neither depends on @c OMP_* environment variables being set before the
+ * runtime starts nor competes with an application's own OpenMP/TBB runtime:
+ * - @ref idet::platform::ThreadPool::parallel_for splits an index range over the calling thread
+ *   and up to @c width - 1 pool workers (dynamic scheduling, one index at a time),
+ * - @ref idet::platform::ThreadPool::submit queues a detached task (used by the tile scheduler).
+ *
+ * Workers are started on demand and never shrink. They inherit the affinity mask of the thread
+ * that starts them, or are pinned one per CPU once @ref idet::platform::ThreadPool::pin_workers
+ * has been called (see @ref idet::RuntimePolicy::pin_worker_threads).
+ *
+ * Library code schedules onto @ref idet::platform::ThreadPool::current: the process-wide pool,
+ * unless the calling thread selected another one (NUMA replicas use a node-local pool so their
+ * tiles stay on the node). Pool workers have their own pool as current.
+ *
+ * Nesting: a @c parallel_for issued from inside another region runs serially on its caller
+ * (@ref idet::platform::ThreadPool::in_parallel). The caller never waits for a helper that has not
+ * started, so regions issued from pool tasks cannot deadlock even when all workers are busy.
+ *
+ * @note This is an internal header and is not part of the stable public API.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace idet::platform {
+
+/**
+ * @brief Persistent worker threads with a FIFO task queue and a fork-join loop helper.
+ *
+ * @details
+ * Thread-safe: all methods may be called from any thread, including pool workers.
+ */
+class ThreadPool final {
+  public:
+    ThreadPool() = default;
+
+    /** @brief Runs the queued tasks to completion, then stops and joins the workers. */
+    ~ThreadPool() noexcept;
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** @brief Process-wide pool shared by all detectors. */
+    static ThreadPool& global() noexcept;
+
+    /** @brief Pool library code on the calling thread schedules onto (@ref global unless overridden). */
+    static ThreadPool& current() noexcept;
+
+    /**
+     * @brief Overrides @ref current for the calling thread.
+     *
+     * @param pool Pool to use (must outlive its use on this thread); nullptr restores @ref global.
+     */
+    static void set_current(ThreadPool* pool) noexcept;
+
+    /** @brief Default region width: CPUs of the calling thread's affinity mask (>= 1). */
+    static int hardware_width() noexcept;
+
+    /** @brief True while the calling thread executes the body of a @ref parallel_for. */
+    static bool in_parallel() noexcept;
+
+    /** @brief Number of started worker threads. */
+    std::size_t size() const noexcept;
+
+    /**
+     * @brief Pins workers started from now on: worker @c w runs on @c cpus[w % cpus.size()].
+     *
+     * @details
+     * Already running workers keep their mask, so call this before the first @ref reserve.
+     * An empty list restores inheritance of the starting thread's mask.
+     */
+    void pin_workers(std::vector<int> cpus);
+
+    /**
+     * @brief Starts workers until at least @p workers are running.
+     *
+     * @throws std::system_error If a thread cannot be started (already started workers stay).
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void reserve(std::size_t workers);
+
+    /**
+     * @brief Queues @p task for a worker, starting one if the pool is empty.
+     *
+     * @details
+     * Tasks run in FIFO order; an exception escaping a task is swallowed.
+     *
+     * @throws std::system_error If no worker runs and none can be started.
+     * @throws std::bad_alloc On allocation failure.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Calls @p body(i, worker) for every i in [0, @p n), on at most @p width threads.
+     *
+     * @details
+     * The calling thread takes part as worker 0; helpers get ids 1..width-1, so per-worker
+     * buffers indexed by @c worker need @p width entries. Indices are handed out one at a time
+     * as threads become free. Runs serially on the caller when @p width <= 1, @p n <= 1, inside
+     * another region, or if no helper can be queued.
+     *
+     * The first exception thrown by @p body stops handing out indices and is rethrown on the
+     * caller once every started helper has returned.
+     *
+     * @param n Number of indices.
+     * @param width Maximum number of threads including the caller (<= 0: @ref hardware_width).
+     * @param body Callable as @c body(int index, int worker).
+     */
+    template <class F> void parallel_for(int n, int width, F&& body) {
+        using Fn = std::remove_reference_t<F>;
+        run_(n, width, [](void* ctx, int i, int worker) { (*static_cast<Fn*>(ctx))(i, worker); },
+             const_cast<void*>(static_cast<const void*>(&body)));
+    }
+
+  private:
+    using BodyFn = void (*)(void*, int, int);
+
+    void run_(int n, int width, BodyFn fn, void* ctx);
+    void worker_loop_(int cpu);
+
+    mutable std::mutex mu_;
+    std::condition_variable task_cv_; ///< Signals queued tasks and stop
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+    std::vector<int> pin_cpus_; ///< CPU per worker index (empty: inherit the mask)
+    bool stop_ = false;
+};
+
+} // namespace idet::platform
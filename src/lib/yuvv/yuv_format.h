@@ -0,0 +1,65 @@
+#pragma once
+
+#include "yuvv.h"
+
+#include <cstddef>
+
+#if defined(__has_include) && __has_include(<opencv4/opencv2/imgproc.hpp>)
+    #include <opencv4/opencv2/imgproc.hpp> // IWYU pragma: keep
+#elif defined(__has_include) && __has_include(<opencv2/imgproc.hpp>)
+    #include <opencv2/imgproc.hpp> // IWYU pragma: keep
+#else
+    #error "[ERROR] OpenCV 'imgproc.hpp' header not found"
+#endif
+
+/**
+ * @file yuv_format.h
+ * @brief Internal raw YUV layout helpers shared by the viewer and the reader
+ */
+
+namespace yuvv::detail {
+
+// True for the 4:2:0 (planar / semi-planar) formats, false for packed 4:2:2
+inline bool is_420(YuvFormat fmt) {
+    return fmt == YuvFormat::I420 || fmt == YuvFormat::NV12 || fmt == YuvFormat::NV21;
+}
+
+// Computes the expected raw frame byte size for a given format
+inline size_t frame_size_bytes(int w, int h, YuvFormat fmt) {
+    if (w <= 0 || h <= 0) return 0;
+    switch (fmt) {
+    case YuvFormat::I420:
+    case YuvFormat::NV12:
+    case YuvFormat::NV21:
+        return (size_t)w * (size_t)h * 3 / 2; // 4:2:0
+    case YuvFormat::YUY2:
+    case YuvFormat::UYVY:
+        return (size_t)w * (size_t)h * 2; // 4:2:2 packed
+    }
+    return 0;
+}
+
+// Maps the internal format enum to OpenCV conversion code for cv::cvtColor()
+inline int cvt_code(YuvFormat fmt) {
+    switch (fmt) {
+    case YuvFormat::I420:
+        return cv::COLOR_YUV2BGR_I420;
+    case YuvFormat::NV12:
+        return cv::COLOR_YUV2BGR_NV12;
+    case YuvFormat::NV21:
+        return cv::COLOR_YUV2BGR_NV21;
+    case YuvFormat::YUY2:
+        return cv::COLOR_YUV2BGR_YUY2;
+    case YuvFormat::UYVY:
+        return cv::COLOR_YUV2BGR_UYVY;
+    }
+    return -1;
+}
+
+// Wraps a contiguous raw frame as the single-matrix layout cv::cvtColor() expects (no copy)
+inline cv::Mat raw_frame_mat(const uint8_t* data, int w, int h, YuvFormat fmt) {
+    auto* p = const_cast<uint8_t*>(data); // cvtColor only reads its source
+    return is_420(fmt) ? cv::Mat(h * 3 / 2, w, CV_8UC1, p) : cv::Mat(h, w, CV_8UC2, p);
+}
+
+} // namespace yuvv::detail
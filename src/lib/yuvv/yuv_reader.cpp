@@ -0,0 +1,240 @@
+/**
+ * @file yuv_reader.cpp
+ * @brief Headless raw YUV frame source (memory-mapped on POSIX)
+ *
+ * The whole file is mapped once with MADV_SEQUENTIAL, so the kernel reads ahead aggressively
+ * and may drop pages behind the cursor. Each frame() additionally hints the next
+ * @c readahead_frames frames with MADV_WILLNEED, which keeps the page cache ahead of a
+ * consumer that is faster than plain sequential readahead (e.g. after a seek or on loop).
+ * Without mmap (or with ReaderConfig::use_mmap off) frames are read through an ifstream.
+ */
+
+#include "yuv_format.h"
+#include "yuvv.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define YUVV_HAVE_MMAP 1
+#else
+    #define YUVV_HAVE_MMAP 0
+#endif
+
+namespace yuvv {
+
+class YuvReader::Impl {
+  public:
+    explicit Impl(ReaderConfig cfg) : cfg_(std::move(cfg)) {
+        frame_bytes_ = detail::frame_size_bytes(cfg_.w, cfg_.h, cfg_.fmt);
+        if (frame_bytes_ == 0) throw std::runtime_error("YuvReader: invalid frame size params");
+        if (detail::is_420(cfg_.fmt) && ((cfg_.w | cfg_.h) & 1))
+            throw std::runtime_error("YuvReader: 4:2:0 formats require even width and height");
+        if (!detail::is_420(cfg_.fmt) && (cfg_.w & 1))
+            throw std::runtime_error("YuvReader: 4:2:2 packed formats require even width");
+
+        open_file();
+    }
+
+    ~Impl() {
+#if YUVV_HAVE_MMAP
+        if (map_) ::munmap(map_, map_bytes_);
+#endif
+    }
+
+    Impl(const Impl&) = delete;
+    Impl& operator=(const Impl&) = delete;
+
+    int64_t total_frames() const {
+        return total_frames_;
+    }
+
+    size_t frame_bytes() const {
+        return frame_bytes_;
+    }
+
+    const ReaderConfig& config() const {
+        return cfg_;
+    }
+
+    YuvFrameView frame(int64_t frame_idx) {
+        if (frame_idx < 0 || frame_idx >= total_frames_)
+            throw std::out_of_range("YuvReader: frame " + std::to_string(frame_idx) + " out of range [0, " +
+                                    std::to_string(total_frames_) + ")");
+        return make_view(frame_data(frame_idx), frame_idx);
+    }
+
+    BgrFrameView frame_bgr(int64_t frame_idx, std::vector<uint8_t>& storage) {
+        const YuvFrameView v = frame(frame_idx);
+
+        const size_t bgr_bytes = (size_t)cfg_.w * (size_t)cfg_.h * 3;
+        if (storage.size() < bgr_bytes) storage.resize(bgr_bytes);
+
+        cv::Mat dst(cfg_.h, cfg_.w, CV_8UC3, storage.data());
+        cv::cvtColor(detail::raw_frame_mat(v.planes[0].data, cfg_.w, cfg_.h, cfg_.fmt), dst,
+                     detail::cvt_code(cfg_.fmt));
+
+        BgrFrameView out;
+        out.w = cfg_.w;
+        out.h = cfg_.h;
+        out.channels = 3;
+        out.stride_bytes = cfg_.w * 3;
+        out.data = storage.data();
+        return out;
+    }
+
+  private:
+    void open_file() {
+#if YUVV_HAVE_MMAP
+        if (cfg_.use_mmap) {
+            map_file();
+            return;
+        }
+#endif
+        file_.open(cfg_.file, std::ios::binary);
+        if (!file_) throw std::runtime_error("YuvReader: cannot open file: " + cfg_.file);
+
+        file_.seekg(0, std::ios::end);
+        const std::streamoff file_size = file_.tellg();
+        total_frames_ = file_size > 0 ? (int64_t)(file_size / (std::streamoff)frame_bytes_) : 0;
+        if (total_frames_ <= 0) throw std::runtime_error("YuvReader: file too small for one frame: " + cfg_.file);
+
+        buf_.assign(frame_bytes_, 0);
+    }
+
+#if YUVV_HAVE_MMAP
+    void map_file() {
+        const int fd = ::open(cfg_.file.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("YuvReader: cannot open file: " + cfg_.file);
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            throw std::runtime_error("YuvReader: empty or unreadable file: " + cfg_.file);
+        }
+
+        total_frames_ = (int64_t)((size_t)st.st_size / frame_bytes_);
+        if (total_frames_ <= 0) {
+            ::close(fd);
+            throw std::runtime_error("YuvReader: file too small for one frame: " + cfg_.file);
+        }
+
+        // Map only whole frames; a trailing partial frame is never exposed
+        map_bytes_ = (size_t)total_frames_ * frame_bytes_;
+        void* p = ::mmap(nullptr, map_bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps its own reference to the file
+        if (p == MAP_FAILED) throw std::runtime_error("YuvReader: mmap failed: " + cfg_.file);
+
+        map_ = static_cast<uint8_t*>(p);
+        (void)::madvise(map_, map_bytes_, MADV_SEQUENTIAL);
+
+        const long page = ::sysconf(_SC_PAGESIZE);
+        page_ = page > 0 ? (size_t)page : 4096;
+    }
+#endif
+
+    const uint8_t* frame_data(int64_t frame_idx) {
+        const size_t off = (size_t)frame_idx * frame_bytes_;
+#if YUVV_HAVE_MMAP
+        if (map_) {
+            if (cfg_.readahead_frames > 0 && frame_idx + 1 < total_frames_) {
+                // Hint the upcoming frames; madvise needs a page-aligned start
+                const size_t begin = (off + frame_bytes_) / page_ * page_;
+                const size_t end = std::min(map_bytes_, off + frame_bytes_ * (size_t)(1 + cfg_.readahead_frames));
+                if (end > begin) (void)::madvise(map_ + begin, end - begin, MADV_WILLNEED);
+            }
+            return map_ + off;
+        }
+#endif
+        file_.clear();
+        file_.seekg((std::streamoff)off, std::ios::beg);
+        file_.read(reinterpret_cast<char*>(buf_.data()), (std::streamsize)buf_.size());
+        if (!file_ || file_.gcount() != (std::streamsize)buf_.size())
+            throw std::runtime_error("YuvReader: read failed at frame " + std::to_string(frame_idx));
+        return buf_.data();
+    }
+
+    YuvFrameView make_view(const uint8_t* p, int64_t frame_idx) const {
+        const int w = cfg_.w;
+        const int h = cfg_.h;
+
+        YuvFrameView v;
+        v.w = w;
+        v.h = h;
+        v.fmt = cfg_.fmt;
+        v.index = frame_idx;
+
+        switch (cfg_.fmt) {
+        case YuvFormat::I420:
+            v.plane_count = 3;
+            v.planes[0] = {w, h, w, p};
+            v.planes[1] = {w / 2, h / 2, w / 2, p + (size_t)w * h};
+            v.planes[2] = {w / 2, h / 2, w / 2, p + (size_t)w * h + (size_t)(w / 2) * (h / 2)};
+            break;
+        case YuvFormat::NV12:
+        case YuvFormat::NV21:
+            v.plane_count = 2;
+            v.planes[0] = {w, h, w, p};
+            v.planes[1] = {w / 2, h / 2, w, p + (size_t)w * h};
+            break;
+        case YuvFormat::YUY2:
+        case YuvFormat::UYVY:
+            v.plane_count = 1;
+            v.planes[0] = {w, h, w * 2, p};
+            break;
+        }
+        return v;
+    }
+
+  private:
+    ReaderConfig cfg_;
+
+    size_t frame_bytes_ = 0;
+    int64_t total_frames_ = 0;
+
+#if YUVV_HAVE_MMAP
+    uint8_t* map_ = nullptr;
+    size_t map_bytes_ = 0;
+    size_t page_ = 4096;
+#endif
+    std::ifstream file_; // fallback without a mapping
+    std::vector<uint8_t> buf_;
+};
+
+YuvReader::YuvReader(ReaderConfig cfg) : impl_(std::make_unique<Impl>(std::move(cfg))) {}
+
+YuvReader::~YuvReader() = default;
+
+YuvReader::YuvReader(YuvReader&&) noexcept = default;
+YuvReader& YuvReader::operator=(YuvReader&&) noexcept = default;
+
+int64_t YuvReader::total_frames() const {
+    return impl_->total_frames();
+}
+
+size_t YuvReader::frame_bytes() const {
+    return impl_->frame_bytes();
+}
+
+const ReaderConfig& YuvReader::config() const {
+    return impl_->config();
+}
+
+YuvFrameView YuvReader::frame(int64_t frame_idx) {
+    return impl_->frame(frame_idx);
+}
+
+BgrFrameView YuvReader::frame_bgr(int64_t frame_idx, std::vector<uint8_t>& storage) {
+    return impl_->frame_bgr(frame_idx, storage);
+}
+
+} // namespace yuvv
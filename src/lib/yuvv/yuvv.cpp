@@ -1,7 +1,8 @@
 #include "yuvv.h"
 
+#include "yuv_format.h"
+
 #include <algorithm>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -20,6 +21,9 @@
  * @file yuvv.cpp
  * @brief Implementation of a lightweight raw YUV player with OpenCV preview
  *
+ * Frames are taken from a @ref yuvv::YuvReader (memory-mapped on POSIX); headless mode skips
+ * the window and only feeds the post-preview callback.
+ *
  * Supported formats:
  *  - I420 (YUV420p planar), NV12, NV21 (YUV420 semi-planar)
  *  - YUY2, UYVY (YUV422 packed)
@@ -33,6 +37,7 @@ class YuvViewer::Impl {
 
     int run() {
         if (!open_file()) return 2;
+        if (cfg_.headless) return run_headless();
 
         cv::namedWindow(cfg_.window_name, cv::WINDOW_NORMAL);
 
@@ -109,37 +114,22 @@ class YuvViewer::Impl {
     }
 
   private:
-    // Computes the expected raw frame byte size for a given format
-    static size_t frame_size_bytes(int w, int h, YuvFormat fmt) {
-        switch (fmt) {
-        case YuvFormat::I420:
-        case YuvFormat::NV12:
-        case YuvFormat::NV21:
-            return (size_t)w * (size_t)h * 3 / 2; // 4:2:0
-        case YuvFormat::YUY2:
-        case YuvFormat::UYVY:
-            return (size_t)w * (size_t)h * 2; // 4:2:2 packed
+    // Decodes [start_frame, start_frame + max_frames) once, without window or pacing
+    int run_headless() {
+        const int64_t end =
+            cfg_.max_frames >= 0 ? std::min(total_frames_, cfg_.start_frame + cfg_.max_frames) : total_frames_;
+
+        cv::Mat bgr;
+        for (; frame_idx_ < end; ++frame_idx_, ++shown_) {
+            if (!read_frame_bgr(frame_idx_, bgr)) {
+                std::cerr << "[ERROR] Read failed at frame " << frame_idx_ << "\n";
+                return 1;
+            }
+            if (post_preview_cb_) post_preview_cb_(make_view(bgr), frame_idx_);
         }
         return 0;
     }
 
-    // Maps the internal format enum to OpenCV conversion code for cv::cvtColor()
-    static int cvt_code(YuvFormat fmt) {
-        switch (fmt) {
-        case YuvFormat::I420:
-            return cv::COLOR_YUV2BGR_I420;
-        case YuvFormat::NV12:
-            return cv::COLOR_YUV2BGR_NV12;
-        case YuvFormat::NV21:
-            return cv::COLOR_YUV2BGR_NV21;
-        case YuvFormat::YUY2:
-            return cv::COLOR_YUV2BGR_YUY2;
-        case YuvFormat::UYVY:
-            return cv::COLOR_YUV2BGR_UYVY;
-        }
-        return -1;
-    }
-
     // Convert OpenCV matrix structure to custom wrapper
     static BgrFrameView make_view(const cv::Mat& bgr) {
         BgrFrameView v;
@@ -154,43 +144,29 @@ class YuvViewer::Impl {
     bool open_file() {
         if (file_opened_) return true;
 
-        frame_bytes_ = frame_size_bytes(cfg_.w, cfg_.h, cfg_.fmt);
-        if (frame_bytes_ == 0) {
-            std::cerr << "[ERROR] Invalid frame size params\n";
-            return false;
-        }
-        if (cvt_code(cfg_.fmt) < 0) {
+        if (detail::cvt_code(cfg_.fmt) < 0) {
             std::cerr << "[ERROR] Unsupported YUV format for cvtColor\n";
             return false;
         }
 
-        file_.open(cfg_.file, std::ios::binary);
-        if (!file_) {
-            std::cerr << "[ERROR] Cannot open file: " << cfg_.file << "\n";
-            return false;
-        }
-
-        file_.seekg(0, std::ios::end);
-        const std::streamoff file_size = file_.tellg();
-        if (file_size <= 0) {
-            std::cerr << "[ERROR] Empty file\n";
+        ReaderConfig rc;
+        rc.file = cfg_.file;
+        rc.w = cfg_.w;
+        rc.h = cfg_.h;
+        rc.fmt = cfg_.fmt;
+        try {
+            reader_ = std::make_unique<YuvReader>(std::move(rc));
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR] " << e.what() << "\n";
             return false;
         }
+        total_frames_ = reader_->total_frames();
 
-        total_frames_ = (int64_t)(file_size / (std::streamoff)frame_bytes_);
-        file_.seekg(0, std::ios::beg);
-
-        if (total_frames_ <= 0) {
-            std::cerr << "[ERROR] File too small for one frame\n";
-            return false;
-        }
         if (cfg_.start_frame >= total_frames_) {
             std::cerr << "[ERROR] start_frame " << cfg_.start_frame << " >= total_frames " << total_frames_ << "\n";
             return false;
         }
 
-        buf_.assign(frame_bytes_, 0);
-
         frame_idx_ = cfg_.start_frame;
         shown_ = 0;
         paused_ = false;
@@ -202,27 +178,16 @@ class YuvViewer::Impl {
         return true;
     }
 
-    bool seek_to_frame(int64_t frame_idx) {
-        const std::streamoff off = (std::streamoff)frame_idx * (std::streamoff)frame_bytes_;
-        file_.clear();
-        file_.seekg(off, std::ios::beg);
-        return (bool)file_;
-    }
-
+    // Converts straight from the reader's frame view (no intermediate copy of the raw frame)
     bool read_frame_bgr(int64_t frame_idx, cv::Mat& out_bgr) {
-        if (!seek_to_frame(frame_idx)) return false;
-
-        file_.read(reinterpret_cast<char*>(buf_.data()), (std::streamsize)buf_.size());
-        if (!file_ || file_.gcount() != (std::streamsize)buf_.size()) return false;
-
-        cv::Mat yuv;
-        if (cfg_.fmt == YuvFormat::I420 || cfg_.fmt == YuvFormat::NV12 || cfg_.fmt == YuvFormat::NV21) {
-            yuv = cv::Mat(cfg_.h * 3 / 2, cfg_.w, CV_8UC1, buf_.data());
-        } else {
-            yuv = cv::Mat(cfg_.h, cfg_.w, CV_8UC2, buf_.data());
+        YuvFrameView v;
+        try {
+            v = reader_->frame(frame_idx);
+        } catch (const std::exception&) {
+            return false;
         }
 
-        cv::cvtColor(yuv, out_bgr, cvt_code(cfg_.fmt));
+        cv::cvtColor(detail::raw_frame_mat(v.planes[0].data, v.w, v.h, v.fmt), out_bgr, detail::cvt_code(v.fmt));
         return true;
     }
 
@@ -272,14 +237,11 @@ class YuvViewer::Impl {
   private:
     ViewerConfig cfg_;
 
-    std::ifstream file_;
+    std::unique_ptr<YuvReader> reader_;
     bool file_opened_ = false;
 
-    size_t frame_bytes_ = 0;
     int64_t total_frames_ = 0;
 
-    std::vector<uint8_t> buf_;
-
     bool paused_ = false;
     bool step_once_ = false;
 
@@ -0,0 +1,422 @@
+// Python module `idet`: in-process access to Detector, DetectorConfig and RuntimePolicy.
+//
+// Frames are NumPy uint8 arrays wrapped as ImageView without copying: (H, W, 3|4) for packed
+// formats, (H * 3 / 2, W) for the 4:2:0 YUV formats. Rows may be strided (slices of a larger
+// frame), pixels must be contiguous. The GIL is released for the duration of every call into
+// the library that may run inference, so several Python threads can share one Detector exactly
+// like C++ callers do; the caller must not modify a frame while a call on it is running.
+
+// Python.h (through pybind11) must come before any standard header.
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <idet.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace {
+
+// Raises the Python exception matching a failed Status.
+[[noreturn]] void raise_status(const idet::Status& s) {
+    switch (s.code) {
+    case idet::Status::Code::InvalidArgument:
+        throw py::value_error(s.message);
+    case idet::Status::Code::NotFound:
+        PyErr_SetString(PyExc_FileNotFoundError, s.message.c_str());
+        throw py::error_already_set();
+    case idet::Status::Code::Unsupported:
+        PyErr_SetString(PyExc_NotImplementedError, s.message.c_str());
+        throw py::error_already_set();
+    case idet::Status::Code::OutOfMemory:
+        throw std::bad_alloc();
+    default:
+        throw std::runtime_error(s.message);
+    }
+}
+
+void check(const idet::Status& s) {
+    if (!s.ok()) raise_status(s);
+}
+
+// Borrowed view of a NumPy frame; `frame` keeps the array alive and bound to the call.
+struct Frame {
+    py::array array;
+    idet::Image image;
+};
+
+Frame wrap_frame(const py::array& a, idet::PixelFormat format) {
+    if (!py::isinstance<py::array_t<std::uint8_t>>(a) || a.itemsize() != 1)
+        throw py::type_error("idet: frame must be a uint8 array");
+
+    idet::ImageView v;
+    v.format = format;
+    v.data = static_cast<const std::uint8_t*>(a.data());
+    if (idet::is_yuv420(format)) {
+        if (a.ndim() != 2) throw py::value_error("idet: YUV frame must have shape (H * 3 / 2, W)");
+        if (a.shape(0) % 3 != 0) throw py::value_error("idet: YUV frame rows must be a multiple of 3");
+        if (a.strides(1) != 1) throw py::value_error("idet: YUV frame rows must be contiguous");
+        v.width = (int)a.shape(1);
+        v.height = (int)(a.shape(0) / 3 * 2);
+        // I420 chroma rows are half as wide: only a tightly packed buffer has the implied layout.
+        if (format == idet::PixelFormat::I420_U8 && a.strides(0) != a.shape(1))
+            throw py::value_error("idet: I420 frame must be C-contiguous");
+    } else {
+        const int ch = idet::get_channels(format);
+        if (a.ndim() != 3 || a.shape(2) != ch)
+            throw py::value_error("idet: frame must have shape (H, W, " + std::to_string(ch) + ")");
+        if (a.strides(2) != 1 || a.strides(1) != ch) throw py::value_error("idet: frame pixels must be contiguous");
+        v.width = (int)a.shape(1);
+        v.height = (int)a.shape(0);
+    }
+    if (a.strides(0) <= 0) throw py::value_error("idet: frame rows must have a positive stride");
+    v.stride_bytes = (std::size_t)a.strides(0);
+    if (!v.is_valid()) throw py::value_error("idet: frame does not form a valid image view");
+    return Frame{a, idet::Image::view(v)};
+}
+
+// Detections as a dict of arrays: quads (N, 4, 2), scores (N,), landmarks (N, 5, 2),
+// has_landmarks (N,), tiles (N,).
+py::dict to_numpy(const idet::VecDetection& dets) {
+    const py::ssize_t n = (py::ssize_t)dets.size();
+    py::array_t<float> quads({n, (py::ssize_t)4, (py::ssize_t)2});
+    py::array_t<float> scores(n);
+    py::array_t<float> landmarks({n, (py::ssize_t)5, (py::ssize_t)2});
+    py::array_t<bool> has_landmarks(n);
+    py::array_t<std::int32_t> tiles(n);
+
+    auto q = quads.mutable_unchecked<3>();
+    auto s = scores.mutable_unchecked<1>();
+    auto l = landmarks.mutable_unchecked<3>();
+    auto h = has_landmarks.mutable_unchecked<1>();
+    auto t = tiles.mutable_unchecked<1>();
+    for (py::ssize_t i = 0; i < n; ++i) {
+        const idet::DetectionResult& d = dets[(std::size_t)i];
+        for (py::ssize_t k = 0; k < 4; ++k) {
+            q(i, k, 0) = d.quad[(std::size_t)k].x;
+            q(i, k, 1) = d.quad[(std::size_t)k].y;
+        }
+        for (py::ssize_t k = 0; k < 5; ++k) {
+            l(i, k, 0) = d.has_landmarks ? d.landmarks[(std::size_t)k].x : 0.0f;
+            l(i, k, 1) = d.has_landmarks ? d.landmarks[(std::size_t)k].y : 0.0f;
+        }
+        s(i) = d.score;
+        h(i) = d.has_landmarks;
+        t(i) = d.tile;
+    }
+
+    py::dict out;
+    out["quads"] = std::move(quads);
+    out["scores"] = std::move(scores);
+    out["landmarks"] = std::move(landmarks);
+    out["has_landmarks"] = std::move(has_landmarks);
+    out["tiles"] = std::move(tiles);
+    return out;
+}
+
+py::array_t<float> quads_to_numpy(const idet::VecQuad& quads) {
+    const py::ssize_t n = (py::ssize_t)quads.size();
+    py::array_t<float> out({n, (py::ssize_t)4, (py::ssize_t)2});
+    auto q = out.mutable_unchecked<3>();
+    for (py::ssize_t i = 0; i < n; ++i) {
+        for (py::ssize_t k = 0; k < 4; ++k) {
+            q(i, k, 0) = quads[(std::size_t)i][(std::size_t)k].x;
+            q(i, k, 1) = quads[(std::size_t)i][(std::size_t)k].y;
+        }
+    }
+    return out;
+}
+
+std::vector<idet::GridSpec> grid_list(const std::vector<std::pair<int, int>>& shapes) {
+    std::vector<idet::GridSpec> out;
+    out.reserve(shapes.size());
+    for (const auto& s : shapes)
+        out.push_back(idet::GridSpec{s.first, s.second});
+    return out;
+}
+
+void bind_enums(py::module_& m) {
+    py::enum_<idet::Task>(m, "Task")
+        .value("None_", idet::Task::None)
+        .value("Text", idet::Task::Text)
+        .value("Face", idet::Task::Face);
+    py::enum_<idet::EngineKind>(m, "EngineKind")
+        .value("None_", idet::EngineKind::None)
+        .value("DBNet", idet::EngineKind::DBNet)
+        .value("SCRFD", idet::EngineKind::SCRFD)
+        .value("Replay", idet::EngineKind::Replay);
+    py::enum_<idet::PixelFormat>(m, "PixelFormat")
+        .value("RGB", idet::PixelFormat::RGB_U8)
+        .value("BGR", idet::PixelFormat::BGR_U8)
+        .value("RGBA", idet::PixelFormat::RGBA_U8)
+        .value("BGRA", idet::PixelFormat::BGRA_U8)
+        .value("NV12", idet::PixelFormat::NV12_U8)
+        .value("NV21", idet::PixelFormat::NV21_U8)
+        .value("I420", idet::PixelFormat::I420_U8);
+    py::enum_<idet::ScoreMode>(m, "ScoreMode")
+        .value("Polygon", idet::ScoreMode::Polygon)
+        .value("Scanline", idet::ScoreMode::Scanline)
+        .value("Box", idet::ScoreMode::Box);
+    py::enum_<idet::MapPooling>(m, "MapPooling")
+        .value("Max", idet::MapPooling::Max)
+        .value("Average", idet::MapPooling::Average);
+    py::enum_<idet::NmsMode>(m, "NmsMode")
+        .value("Hard", idet::NmsMode::Hard)
+        .value("SoftLinear", idet::NmsMode::SoftLinear)
+        .value("SoftGaussian", idet::NmsMode::SoftGaussian)
+        .value("Weighted", idet::NmsMode::Weighted);
+    py::enum_<idet::TileMode>(m, "TileMode")
+        .value("Grid", idet::TileMode::Grid)
+        .value("Adaptive", idet::TileMode::Adaptive);
+    py::enum_<idet::TileMerge>(m, "TileMerge")
+        .value("Nms", idet::TileMerge::Nms)
+        .value("Seams", idet::TileMerge::Seams)
+        .value("SeamsJoin", idet::TileMerge::SeamsJoin);
+    py::enum_<idet::ContextOverflow>(m, "ContextOverflow")
+        .value("Wait", idet::ContextOverflow::Wait)
+        .value("Unbound", idet::ContextOverflow::Unbound)
+        .value("Fail", idet::ContextOverflow::Fail);
+    py::enum_<idet::NumaMemPolicy>(m, "NumaMemPolicy")
+        .value("Latency", idet::NumaMemPolicy::Latency)
+        .value("Throughput", idet::NumaMemPolicy::Throughput)
+        .value("Strict", idet::NumaMemPolicy::Strict);
+    py::enum_<idet::SpinPolicy>(m, "SpinPolicy")
+        .value("Default", idet::SpinPolicy::Default)
+        .value("Spin", idet::SpinPolicy::Spin)
+        .value("NoSpin", idet::SpinPolicy::NoSpin);
+    py::enum_<idet::ArenaPolicy>(m, "ArenaPolicy")
+        .value("Arena", idet::ArenaPolicy::Arena)
+        .value("ArenaShrink", idet::ArenaPolicy::ArenaShrink)
+        .value("Off", idet::ArenaPolicy::Off);
+    py::enum_<idet::ExecutionProvider>(m, "ExecutionProvider")
+        .value("CPU", idet::ExecutionProvider::CPU)
+        .value("XNNPACK", idet::ExecutionProvider::XNNPACK)
+        .value("DNNL", idet::ExecutionProvider::DNNL)
+        .value("CoreML", idet::ExecutionProvider::CoreML);
+    py::enum_<idet::BufferPolicy>(m, "BufferPolicy")
+        .value("Heap", idet::BufferPolicy::Heap)
+        .value("Aligned", idet::BufferPolicy::Aligned)
+        .value("HugePages", idet::BufferPolicy::HugePages);
+}
+
+void bind_config(py::module_& m) {
+    py::class_<idet::GridSpec>(m, "GridSpec")
+        .def(py::init<>())
+        .def(py::init([](int rows, int cols) { return idet::GridSpec{rows, cols}; }), py::arg("rows"),
+             py::arg("cols"))
+        .def_readwrite("rows", &idet::GridSpec::rows)
+        .def_readwrite("cols", &idet::GridSpec::cols);
+
+    // Nested option groups (stream, cascade, track, quality, replay) keep their C++ defaults.
+    using IO = idet::InferenceOptions;
+    py::class_<IO>(m, "InferenceOptions")
+        .def(py::init<>())
+        .def_readwrite("apply_sigmoid", &IO::apply_sigmoid)
+        .def_readwrite("bind_io", &IO::bind_io)
+        .def_readwrite("bin_thresh", &IO::bin_thresh)
+        .def_readwrite("box_thresh", &IO::box_thresh)
+        .def_readwrite("score_mode", &IO::score_mode)
+        .def_readwrite("unclip", &IO::unclip)
+        .def_readwrite("map_downsample", &IO::map_downsample)
+        .def_readwrite("map_pooling", &IO::map_pooling)
+        .def_readwrite("map_u8", &IO::map_u8)
+        .def_readwrite("max_img_size", &IO::max_img_size)
+        .def_readwrite("min_roi_size_w", &IO::min_roi_size_w)
+        .def_readwrite("min_roi_size_h", &IO::min_roi_size_h)
+        .def_readwrite("fixed_input_dim", &IO::fixed_input_dim)
+        .def_readwrite("bind_buckets", &IO::bind_buckets)
+        .def_readwrite("letterbox", &IO::letterbox)
+        .def_readwrite("context_overflow", &IO::context_overflow)
+        .def_readwrite("context_wait_ms", &IO::context_wait_ms)
+        .def_readwrite("tiles_dim", &IO::tiles_dim)
+        .def_readwrite("tile_overlap", &IO::tile_overlap)
+        .def_readwrite("tile_mode", &IO::tile_mode)
+        .def_readwrite("tile_min_object", &IO::tile_min_object)
+        .def_readwrite("tile_merge", &IO::tile_merge)
+        .def_readwrite("tile_batch", &IO::tile_batch)
+        .def_readwrite("nms_iou", &IO::nms_iou)
+        .def_readwrite("use_fast_iou", &IO::use_fast_iou)
+        .def_readwrite("nms_mode", &IO::nms_mode)
+        .def_readwrite("nms_sigma", &IO::nms_sigma);
+
+    using RP = idet::RuntimePolicy;
+    py::class_<RP>(m, "RuntimePolicy")
+        .def(py::init<>())
+        .def_readwrite("ort_intra_threads", &RP::ort_intra_threads)
+        .def_readwrite("ort_inter_threads", &RP::ort_inter_threads)
+        .def_readwrite("tile_omp_threads", &RP::tile_omp_threads)
+        .def_readwrite("post_omp_threads", &RP::post_omp_threads)
+        .def_readwrite("pin_worker_threads", &RP::pin_worker_threads)
+        .def_readwrite("soft_mem_bind", &RP::soft_mem_bind)
+        .def_readwrite("numa_mem_policy", &RP::numa_mem_policy)
+        .def_readwrite("suppress_opencv", &RP::suppress_opencv)
+        .def_readwrite("shape_cache_file", &RP::shape_cache_file)
+        .def_readwrite("share_session", &RP::share_session)
+        .def_readwrite("optimized_model_file", &RP::optimized_model_file)
+        .def_readwrite("mmap_model", &RP::mmap_model)
+        .def_readwrite("profile_prefix", &RP::profile_prefix)
+        .def_readwrite("profile_runs", &RP::profile_runs)
+        .def_readwrite("ort_spin", &RP::ort_spin)
+        .def_readwrite("ort_parallel", &RP::ort_parallel)
+        .def_readwrite("ort_arena", &RP::ort_arena)
+        .def_readwrite("ort_denormal_as_zero", &RP::ort_denormal_as_zero)
+        .def_readwrite("ort_provider", &RP::ort_provider)
+        .def_readwrite("bound_buffers", &RP::bound_buffers)
+        .def_readwrite("capture_file", &RP::capture_file)
+        .def_readwrite("ort_global_pools", &RP::ort_global_pools);
+
+    using DC = idet::DetectorConfig;
+    py::class_<DC>(m, "DetectorConfig")
+        .def(py::init<>())
+        .def_static("setup", &DC::setup, py::arg("task"), py::arg("model_path"))
+        .def_readwrite("task", &DC::task)
+        .def_readwrite("engine", &DC::engine)
+        .def_readwrite("infer", &DC::infer)
+        .def_readwrite("runtime", &DC::runtime)
+        .def_readwrite("model_path", &DC::model_path)
+        .def_readwrite("verbose", &DC::verbose)
+        .def(
+            "validate", [](const DC& c) { check(c.validate()); }, "Raises on the first inconsistency.");
+
+    m.def(
+        "setup_runtime_policy",
+        [](const RP& policy, bool verbose) {
+            idet::Status s;
+            {
+                py::gil_scoped_release nogil;
+                s = idet::setup_runtime_policy(policy, verbose);
+            }
+            check(s);
+        },
+        py::arg("policy"), py::arg("verbose") = true);
+}
+
+void bind_frames(py::module_& m) {
+    m.def(
+        "frame_info",
+        [](const py::array& frame, idet::PixelFormat format) {
+            const Frame f = wrap_frame(frame, format);
+            const idet::ImageView& v = f.image.view();
+            return py::make_tuple(v.width, v.height, v.stride_bytes);
+        },
+        py::arg("frame"), py::arg("format") = idet::PixelFormat::BGR_U8,
+        "Checks a frame the way detect does; returns (width, height, stride_bytes) of the wrapped view.");
+}
+
+void bind_detector(py::module_& m) {
+    using idet::Detector;
+    py::class_<Detector>(m, "Detector")
+        .def(py::init([](const idet::DetectorConfig& cfg) {
+                 auto r = [&] {
+                     py::gil_scoped_release nogil;
+                     return Detector::create(cfg);
+                 }();
+                 check(r.status());
+                 return std::make_unique<Detector>(std::move(r.value()));
+             }),
+             py::arg("config"))
+        .def("update_config",
+             [](Detector& d, const idet::DetectorConfig& cfg) {
+                 idet::Status s;
+                 {
+                     py::gil_scoped_release nogil;
+                     s = d.update_config(cfg);
+                 }
+                 check(s);
+             },
+             py::arg("config"))
+        .def("reload",
+             [](Detector& d, const idet::DetectorConfig& cfg) {
+                 idet::Status s;
+                 {
+                     py::gil_scoped_release nogil;
+                     s = d.reload(cfg);
+                 }
+                 check(s);
+             },
+             py::arg("config"))
+        .def(
+            "prepare_binding",
+            [](Detector& d, int width, int height, int contexts, int max_batch) {
+                idet::Status s;
+                {
+                    py::gil_scoped_release nogil;
+                    s = d.prepare_binding(width, height, contexts, max_batch);
+                }
+                check(s);
+            },
+            py::arg("width"), py::arg("height"), py::arg("contexts") = 1, py::arg("max_batch") = 1)
+        .def(
+            "warmup",
+            [](Detector& d, const std::vector<std::pair<int, int>>& shapes, int iterations) {
+                const std::vector<idet::GridSpec> grid = grid_list(shapes);
+                idet::Status s;
+                {
+                    py::gil_scoped_release nogil;
+                    s = d.warmup(grid, iterations);
+                }
+                check(s);
+            },
+            py::arg("shapes") = std::vector<std::pair<int, int>>{}, py::arg("iterations") = 1,
+            "Runs every (rows, cols) shape (default: the bound shapes) and resets the statistics.")
+        .def(
+            "detect",
+            [](Detector& d, const py::array& frame, idet::PixelFormat format) {
+                const Frame f = wrap_frame(frame, format);
+                idet::VecDetection out;
+                idet::Status s;
+                {
+                    py::gil_scoped_release nogil;
+                    s = d.detect_ex(f.image, out);
+                }
+                check(s);
+                return to_numpy(out);
+            },
+            py::arg("frame"), py::arg("format") = idet::PixelFormat::BGR_U8,
+            "Detects on one frame; returns a dict of arrays (quads, scores, landmarks, has_landmarks, tiles).")
+        .def(
+            "detect_batch",
+            [](Detector& d, const std::vector<py::array>& frames, idet::PixelFormat format) {
+                std::vector<Frame> held;
+                std::vector<idet::Image> images;
+                held.reserve(frames.size());
+                images.reserve(frames.size());
+                for (const py::array& a : frames) {
+                    held.push_back(wrap_frame(a, format));
+                    images.push_back(held.back().image);
+                }
+                auto r = [&] {
+                    py::gil_scoped_release nogil;
+                    return d.detect_batch(images);
+                }();
+                check(r.status());
+                py::list out;
+                for (const idet::VecQuad& q : r.value())
+                    out.append(quads_to_numpy(q));
+                return out;
+            },
+            py::arg("frames"), py::arg("format") = idet::PixelFormat::BGR_U8,
+            "Detects on several frames (batched session runs when bound); returns one (N, 4, 2) quad array each.")
+        .def("reset_stats", &Detector::reset_stats)
+        .def("reset_stream", &Detector::reset_stream)
+        .def("reset_track", &Detector::reset_track);
+}
+
+} // namespace
+
+PYBIND11_MODULE(idet, m) {
+    m.doc() = "In-process IDet text / face detection over NumPy frames";
+    bind_enums(m);
+    bind_config(m);
+    bind_frames(m);
+    bind_detector(m);
+}
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+
+"""
+Smoke test of the `idet` Python module: frames are checked through idet.frame_info, which runs
+the same wrapping as Detector.detect, so no model is needed.
+"""
+
+import unittest
+
+import numpy as np
+
+import idet
+
+
+class FrameWrapping(unittest.TestCase):
+    def test_packed_frame_and_strided_rows(self):
+        frame = np.zeros((4, 6, 3), np.uint8)
+        self.assertEqual(idet.frame_info(frame), (6, 4, 18))
+
+        # A crop of a wider frame keeps the parent's row stride.
+        wide = np.zeros((4, 10, 4), np.uint8)
+        self.assertEqual(idet.frame_info(wide[:, 2:8], idet.PixelFormat.RGBA), (6, 4, 40))
+
+    def test_packed_frame_rejects_bad_shapes(self):
+        with self.assertRaises(ValueError):
+            idet.frame_info(np.zeros((4, 6, 4), np.uint8), idet.PixelFormat.BGR)
+        with self.assertRaises(ValueError):
+            idet.frame_info(np.zeros((4, 6), np.uint8), idet.PixelFormat.BGR)
+        with self.assertRaises(TypeError):
+            idet.frame_info(np.zeros((4, 6, 3), np.float32))
+
+    def test_packed_frame_rejects_bad_strides(self):
+        frame = np.zeros((4, 12, 3), np.uint8)
+        with self.assertRaises(ValueError):
+            idet.frame_info(frame[:, ::2])  # pixels not adjacent
+        with self.assertRaises(ValueError):
+            idet.frame_info(frame[::-1])  # negative row stride
+        with self.assertRaises(ValueError):
+            idet.frame_info(np.asfortranarray(frame))
+
+    def test_yuv_frame(self):
+        nv12 = np.zeros((6, 4), np.uint8)
+        self.assertEqual(idet.frame_info(nv12, idet.PixelFormat.NV12), (4, 4, 4))
+
+        with self.assertRaises(ValueError):
+            idet.frame_info(np.zeros((5, 4), np.uint8), idet.PixelFormat.NV12)
+        with self.assertRaises(ValueError):
+            idet.frame_info(np.zeros((6, 8), np.uint8)[:, ::2], idet.PixelFormat.NV21)
+        # I420 chroma layout is implied by a tightly packed buffer only.
+        with self.assertRaises(ValueError):
+            idet.frame_info(np.zeros((6, 8), np.uint8)[:, :4], idet.PixelFormat.I420)
+
+
+class Signatures(unittest.TestCase):
+    def test_config_keyword(self):
+        for method in (idet.Detector.update_config, idet.Detector.reload):
+            self.assertIn("config:", method.__doc__)
+
+
+if __name__ == "__main__":
+    unittest.main()
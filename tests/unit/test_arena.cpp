@@ -0,0 +1,156 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "algo/arena.h"
+#include "algo/nms.h"
+#include "internal/cv_bgr.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Counting global allocator: only allocations made while g_count_allocs is set are recorded.
+namespace {
+thread_local bool g_count_allocs = false;
+std::atomic<std::uint64_t> g_allocs{0};
+} // namespace
+
+void* operator new(std::size_t n) {
+    if (g_count_allocs) g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+/// @brief Counts heap allocations of the calling thread within its scope.
+struct AllocCounter {
+    std::uint64_t start;
+    AllocCounter() : start(g_allocs.load()) {
+        g_count_allocs = true;
+    }
+    ~AllocCounter() {
+        g_count_allocs = false;
+    }
+    std::uint64_t count() const {
+        return g_allocs.load() - start;
+    }
+};
+
+static std::vector<idet::algo::Detection> make_grid_dets(int n) {
+    std::vector<idet::algo::Detection> v;
+    v.reserve((std::size_t)n);
+    for (int i = 0; i < n; ++i) {
+        const float x = (float)((i * 37) % 600);
+        const float y = (float)((i * 53) % 400);
+        idet::algo::Detection d;
+        d.score = 0.3f + 0.7f * (float)((i * 7919) % 1000) / 1000.f;
+        d.pts[0] = {x, y};
+        d.pts[1] = {x + 40.f, y};
+        d.pts[2] = {x + 40.f, y + 20.f};
+        d.pts[3] = {x, y + 20.f};
+        v.push_back(d);
+    }
+    return v;
+}
+
+} // namespace
+
+TEST(FrameArena, AlignsAndCoalescesOnReset) {
+    idet::algo::FrameArena arena;
+    EXPECT_EQ(arena.capacity(), 0u);
+
+    auto* a = arena.alloc<std::uint8_t>(3);
+    auto* b = arena.alloc<double>(4);
+    (void)a;
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % alignof(double), 0u);
+
+    // Overflow the first block several times.
+    for (int i = 0; i < 8; ++i)
+        (void)arena.alloc<float>(16 * 1024);
+    const std::uint64_t grown = arena.upstream_allocations();
+    const std::size_t frame_bytes = arena.used();
+    EXPECT_GT(grown, 1u);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_GE(arena.capacity(), frame_bytes);
+    const std::uint64_t after_reset = arena.upstream_allocations();
+
+    // The same frame now fits without touching the heap.
+    for (int f = 0; f < 3; ++f) {
+        (void)arena.alloc<std::uint8_t>(3);
+        (void)arena.alloc<double>(4);
+        for (int i = 0; i < 8; ++i)
+            (void)arena.alloc<float>(16 * 1024);
+        arena.reset();
+    }
+    EXPECT_EQ(arena.upstream_allocations(), after_reset);
+}
+
+TEST(FrameArena, NmsArenaOverloadMatchesAndIsAllocationFreeWhenWarm) {
+    const auto dets = make_grid_dets(500);
+
+    for (bool fast : {false, true}) {
+        const auto ref = idet::algo::nms_poly(dets, 0.3f, fast);
+
+        idet::algo::FrameArena arena;
+        std::vector<idet::algo::Detection> out;
+        idet::algo::nms_poly(dets, 0.3f, fast, arena, out);
+
+        ASSERT_EQ(out.size(), ref.size());
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            EXPECT_FLOAT_EQ(out[i].score, ref[i].score);
+            EXPECT_FLOAT_EQ(out[i].pts[0].x, ref[i].pts[0].x);
+            EXPECT_FLOAT_EQ(out[i].pts[0].y, ref[i].pts[0].y);
+        }
+    }
+
+    // Exact IoU goes through OpenCV polygon routines; the fast path is pure IDet code.
+    idet::algo::FrameArena arena;
+    std::vector<idet::algo::Detection> out;
+    idet::algo::nms_poly(dets, 0.3f, /*use_fast_iou=*/true, arena, out); // warmup frame
+    arena.reset();                                                       // coalesces its blocks
+
+    std::uint64_t allocs = 0;
+    for (int f = 0; f < 5; ++f) {
+        AllocCounter c;
+        idet::algo::nms_poly(dets, 0.3f, /*use_fast_iou=*/true, arena, out);
+        arena.reset();
+        allocs += c.count();
+    }
+    EXPECT_EQ(allocs, 0u);
+}
+
+TEST(FrameArena, BgrMatReusesConversionScratch) {
+    std::vector<std::uint8_t> px((std::size_t)32 * 16 * 3, 7);
+    auto img = idet::Image::copy_from(idet::PixelFormat::RGB_U8, 32, 16, px.data(), 32 * 3);
+    ASSERT_TRUE(img.ok());
+
+    cv::Mat scratch;
+    auto r1 = idet::internal::BgrMat::from(img.value(), scratch);
+    ASSERT_TRUE(r1.ok());
+    const std::uint8_t* first = r1.value().mat().data;
+    EXPECT_EQ(first, scratch.data);
+
+    auto r2 = idet::internal::BgrMat::from(img.value(), scratch);
+    ASSERT_TRUE(r2.ok());
+    EXPECT_EQ(r2.value().mat().data, first);
+    EXPECT_EQ(r2.value().mat().type(), CV_8UC3);
+}
@@ -0,0 +1,65 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "platform/buffer_alloc.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+using idet::BufferPolicy;
+using idet::platform::BoundBuffer;
+using idet::platform::BufferAllocator;
+
+bool aligned_to(const void* p, std::size_t a) {
+    return (std::uintptr_t)p % a == 0;
+}
+
+} // namespace
+
+TEST(BufferAlloc, SmallBlocksHonourPolicyAlignment) {
+    for (BufferPolicy pol : {BufferPolicy::Aligned, BufferPolicy::HugePages}) {
+        BoundBuffer<float> v(1000, 1.0f, BufferAllocator<float>(pol));
+        EXPECT_TRUE(aligned_to(v.data(), idet::platform::kBufferAlign));
+        EXPECT_EQ(v.get_allocator().policy(), pol);
+        EXPECT_EQ(v[999], 1.0f);
+    }
+}
+
+TEST(BufferAlloc, LargeHugePageBlocksAreZeroedAndWritable) {
+    // 3 MiB: mapped in two huge pages (explicit or transparent) on Linux.
+    const std::size_t n = (std::size_t(3) << 20) / sizeof(float);
+    BoundBuffer<float> v(n, 0.0f, BufferAllocator<float>(BufferPolicy::HugePages));
+#if defined(__linux__)
+    EXPECT_TRUE(aligned_to(v.data(), idet::platform::kHugePage));
+#endif
+    for (std::size_t i = 0; i < n; i += 4096)
+        v[i] = (float)i;
+    EXPECT_EQ(v[n - 1], 0.0f);
+    EXPECT_EQ(v[4096], 4096.0f);
+
+    // Growing moves the data into a new mapping and releases the old one.
+    v.resize(2 * n, 2.0f);
+    EXPECT_EQ(v[4096], 4096.0f);
+    EXPECT_EQ(v[2 * n - 1], 2.0f);
+}
+
+TEST(BufferAlloc, PolicyPropagatesOnMoveAssignment) {
+    BoundBuffer<std::uint16_t> a;
+    EXPECT_EQ(a.get_allocator().policy(), BufferPolicy::Heap);
+
+    a = BoundBuffer<std::uint16_t>(16, 7, BufferAllocator<std::uint16_t>(BufferPolicy::Aligned));
+    EXPECT_EQ(a.get_allocator().policy(), BufferPolicy::Aligned);
+    EXPECT_EQ(a[15], 7);
+
+    BoundBuffer<std::uint16_t> b(std::move(a));
+    EXPECT_EQ(b.get_allocator().policy(), BufferPolicy::Aligned);
+    EXPECT_TRUE(BufferAllocator<float>(BufferPolicy::Aligned) == b.get_allocator());
+    EXPECT_TRUE(BufferAllocator<float>(BufferPolicy::Heap) != b.get_allocator());
+}
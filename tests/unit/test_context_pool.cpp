@@ -0,0 +1,93 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "engine/context_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using idet::engine::ContextPool;
+
+TEST(ContextPool, HandsOutEveryContextOnceLifo) {
+    ContextPool pool(3);
+    EXPECT_EQ(pool.size(), 3);
+    EXPECT_EQ(pool.available(), 3);
+
+    int a = -1, b = -1, c = -1, d = -1;
+    ASSERT_TRUE(pool.try_acquire(a));
+    ASSERT_TRUE(pool.try_acquire(b));
+    ASSERT_TRUE(pool.try_acquire(c));
+    EXPECT_EQ(a, 0);
+    EXPECT_EQ(b, 1);
+    EXPECT_EQ(c, 2);
+    EXPECT_FALSE(pool.try_acquire(d));
+    EXPECT_EQ(pool.available(), 0);
+
+    // The most recently returned context comes back first.
+    pool.release(b);
+    ASSERT_TRUE(pool.try_acquire(d));
+    EXPECT_EQ(d, 1);
+
+    pool.release(7); // foreign index: ignored
+    EXPECT_EQ(pool.available(), 0);
+}
+
+TEST(ContextPool, EmptyPoolNeverBlocks) {
+    ContextPool pool(0);
+    int k = 5;
+    EXPECT_EQ(pool.acquire(), -1);
+    EXPECT_FALSE(pool.try_acquire(k));
+    EXPECT_FALSE(pool.acquire_for(k, std::chrono::milliseconds(50)));
+}
+
+TEST(ContextPool, AcquireForTimesOutAndWakesOnRelease) {
+    ContextPool pool(1);
+    int held = -1;
+    ASSERT_TRUE(pool.try_acquire(held));
+
+    int k = -1;
+    const auto t0 = std::chrono::steady_clock::now();
+    EXPECT_FALSE(pool.acquire_for(k, std::chrono::milliseconds(20)));
+    EXPECT_GE(std::chrono::steady_clock::now() - t0, std::chrono::milliseconds(20));
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pool.release(held);
+    });
+    EXPECT_TRUE(pool.acquire_for(k, std::chrono::seconds(10)));
+    EXPECT_EQ(k, 0);
+    releaser.join();
+}
+
+TEST(ContextPool, ConcurrentCheckoutsNeverShareAContext) {
+    constexpr int kContexts = 3;
+    constexpr int kThreads = 8;
+    constexpr int kRounds = 2000;
+    ContextPool pool(kContexts);
+
+    std::vector<std::atomic<int>> owners(kContexts);
+    std::atomic<int> shared{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kRounds; ++i) {
+                ContextPool::Lease lease(pool);
+                const int k = lease.ctx();
+                if (owners[(std::size_t)k].fetch_add(1) != 0) shared.fetch_add(1);
+                owners[(std::size_t)k].fetch_sub(1);
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(shared.load(), 0);
+    EXPECT_EQ(pool.available(), kContexts);
+}
@@ -0,0 +1,142 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "algo/detection_buffer.h"
+#include "algo/nms.h"
+#include "algo/tiling.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+using idet::algo::Detection;
+using idet::algo::DetectionBuffer;
+
+Detection quad(float x, float y, float w, float h, float score, bool kps = false) {
+    Detection d;
+    d.score = score;
+    d.pts[0] = {x, y};
+    d.pts[1] = {x + w, y + 0.25f * h};
+    d.pts[2] = {x + w, y + h};
+    d.pts[3] = {x, y + 0.75f * h};
+    d.has_kps = kps;
+    for (std::size_t k = 0; k < d.kps.size(); ++k)
+        d.kps[k] = {x + (float)k, y + (float)k};
+    return d;
+}
+
+std::vector<Detection> random_scene(unsigned seed, int n, float extent) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(0.f, extent), size(4.f, 60.f), score(0.f, 1.f);
+    std::vector<Detection> v;
+    for (int i = 0; i < n; ++i)
+        v.push_back(quad(pos(rng), pos(rng), size(rng), size(rng), score(rng), i % 3 == 0));
+    return v;
+}
+
+void expect_same(const Detection& a, const Detection& b) {
+    for (std::size_t k = 0; k < 4; ++k) {
+        EXPECT_EQ(a.pts[k].x, b.pts[k].x);
+        EXPECT_EQ(a.pts[k].y, b.pts[k].y);
+    }
+    EXPECT_EQ(a.has_kps, b.has_kps);
+    for (std::size_t k = 0; k < 5; ++k) {
+        EXPECT_EQ(a.kps[k].x, b.kps[k].x);
+        EXPECT_EQ(a.kps[k].y, b.kps[k].y);
+    }
+    EXPECT_EQ(a.score, b.score);
+    EXPECT_EQ(a.tile, b.tile);
+}
+
+} // namespace
+
+TEST(DetectionBuffer, RoundTripsAndCachesBoxes) {
+    const auto dets = random_scene(3, 50, 500.f);
+    DetectionBuffer buf;
+    buf.append({dets.begin(), dets.begin() + 20});
+    for (std::size_t i = 20; i < dets.size(); ++i)
+        buf.push_back(dets[i]);
+    ASSERT_EQ(buf.size(), dets.size());
+
+    std::vector<Detection> out;
+    buf.export_to(out);
+    ASSERT_EQ(out.size(), dets.size());
+    for (std::size_t i = 0; i < dets.size(); ++i) {
+        expect_same(out[i], dets[i]);
+        const idet::algo::AABB b = buf.aabb(i);
+        EXPECT_EQ(b.minx, dets[i].pts[0].x);
+        EXPECT_EQ(b.maxx, dets[i].pts[1].x);
+        EXPECT_EQ(b.miny, dets[i].pts[0].y);
+        EXPECT_EQ(b.maxy, dets[i].pts[2].y);
+    }
+
+    buf.clear();
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(DetectionBuffer, OffsetMatchesOffsetDetection) {
+    auto dets = random_scene(5, 40, 300.f);
+    DetectionBuffer buf;
+    buf.assign(dets);
+    buf.offset(10, 64.f, 128.f, 7);
+
+    for (std::size_t i = 10; i < dets.size(); ++i)
+        idet::algo::offset_detection(dets[i], 64, 128, 7);
+    for (std::size_t i = 0; i < dets.size(); ++i) {
+        expect_same(buf.get(i), dets[i]);
+        EXPECT_EQ(buf.aabb(i).minx, dets[i].pts[0].x);
+        EXPECT_EQ(buf.aabb(i).maxy, dets[i].pts[2].y);
+    }
+}
+
+TEST(DetectionBuffer, MinSizeFilterIsStableAndInPlace) {
+    std::vector<Detection> dets = {quad(0, 0, 10, 40, 0.9f), quad(0, 0, 40, 40, 0.8f), quad(0, 0, 40, 10, 0.7f),
+                                   quad(0, 0, 20, 20, 0.6f), quad(0, 0, 50, 30, 0.5f)};
+    DetectionBuffer buf;
+    buf.assign(dets);
+    EXPECT_EQ(buf.filter_min_size(0, 0), 5u);
+    EXPECT_EQ(buf.filter_min_size(20, 20), 3u);
+    ASSERT_EQ(buf.size(), 3u);
+    EXPECT_EQ(buf.score(0), 0.8f);
+    EXPECT_EQ(buf.score(1), 0.6f);
+    EXPECT_EQ(buf.score(2), 0.5f);
+    EXPECT_EQ(buf.aabb(2).maxx, 50.f);
+
+    // One dimension only.
+    buf.assign(dets);
+    EXPECT_EQ(buf.filter_min_size(0, 35), 2u);
+}
+
+TEST(DetectionBuffer, NmsMatchesVectorInput) {
+    const auto dets = random_scene(11, 600, 800.f);
+    DetectionBuffer buf;
+    buf.assign(dets);
+
+    for (auto method : {idet::algo::NmsMethod::Hard, idet::algo::NmsMethod::Weighted,
+                        idet::algo::NmsMethod::Gaussian}) {
+        for (bool fast : {false, true}) {
+            idet::algo::NmsParams p;
+            p.method = method;
+            p.use_fast_iou = fast;
+            p.iou_thr = 0.3f;
+            idet::algo::NmsWorkspace on_vec, on_buf;
+            const std::vector<int> a = on_vec.run(dets, p);
+            const std::vector<int> b = on_buf.run(buf, p);
+            EXPECT_EQ(a, b);
+            EXPECT_EQ(on_vec.scores(), on_buf.scores());
+
+            std::vector<Detection> oa, ob;
+            on_vec.gather(dets, oa);
+            on_buf.gather(buf, ob);
+            ASSERT_EQ(oa.size(), ob.size());
+            for (std::size_t i = 0; i < oa.size(); ++i)
+                expect_same(oa[i], ob[i]);
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "engine/capture.h"
+#include "idet.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Detector-level tests on the Replay engine: the recorded model output is fixed, so only the
+// layers above the engine (region mapping, reload, ...) decide the results.
+
+namespace {
+
+using idet::engine::CaptureFrame;
+using idet::engine::CaptureView;
+using idet::engine::CaptureWriter;
+
+static std::string temp_path(const char* tag) {
+    return std::string(::testing::TempDir()) + "idet_detector_" + tag + ".bin";
+}
+
+/// @brief One DBNet-style frame: a 64x64 plane with a bright 30x10 bar at (10, 20).
+static void write_text_capture(const std::string& path) {
+    std::vector<float> plane(64 * 64, 0.0f);
+    for (int y = 20; y < 30; ++y)
+        for (int x = 10; x < 40; ++x)
+            plane[(std::size_t)(y * 64 + x)] = 0.9f;
+
+    auto w = CaptureWriter::open(path, idet::Task::Text);
+    ASSERT_TRUE(w.ok()) << w.status().message;
+    const std::int64_t shape[2] = {64, 64};
+    const CaptureView v{"prob", shape, 2, plane.data()};
+    CaptureFrame g;
+    g.orig_w = g.orig_h = 64;
+    w.value()->append(g, &v, 1);
+}
+
+static idet::DetectorConfig replay_config(const std::string& path) {
+    idet::DetectorConfig cfg;
+    cfg.task = idet::Task::Text;
+    cfg.engine = idet::EngineKind::Replay;
+    cfg.model_path = path;
+    cfg.verbose = false;
+    return cfg;
+}
+
+/// @brief Replay detector over a fresh one-frame text capture (removed by the destructor).
+struct ReplayFixture {
+    std::string path;
+    idet::Detector det;
+
+    explicit ReplayFixture(const char* tag, float latency_ms = 0.0f) : path(temp_path(tag)) {
+        write_text_capture(path);
+        auto cfg = replay_config(path);
+        cfg.infer.replay.latency_ms = latency_ms;
+        auto r = idet::Detector::create(cfg);
+        EXPECT_TRUE(r.ok()) << r.status().message;
+        if (r.ok()) det = std::move(r.value());
+    }
+
+    ~ReplayFixture() {
+        std::remove(path.c_str());
+    }
+};
+
+static idet::Point2f center(const idet::Quad& q) {
+    idet::Point2f c;
+    for (const auto& p : q) {
+        c.x += 0.25f * p.x;
+        c.y += 0.25f * p.y;
+    }
+    return c;
+}
+
+/// @brief Black frame of @p w x @p h in @p fmt (packed BGR or a 4:2:0 layout in one buffer).
+struct Frame {
+    std::vector<std::uint8_t> pixels;
+    idet::Image image;
+
+    Frame(int w, int h, idet::PixelFormat fmt) {
+        idet::ImageView v;
+        v.format = fmt;
+        v.width = w;
+        v.height = h;
+        v.stride_bytes = idet::is_yuv420(fmt) ? (std::size_t)w : (std::size_t)w * 3;
+        pixels.assign(idet::is_yuv420(fmt) ? (std::size_t)w * h * 3 / 2 : v.stride_bytes * h, 0);
+        v.data = pixels.data();
+        image = idet::Image::view(v);
+    }
+};
+
+} // namespace
+
+TEST(DetectRois, MapsBoxesIntoFrameCoordinatesAndClipsAtEdges) {
+    ReplayFixture f("rois");
+    ASSERT_TRUE(f.det);
+    const Frame frame(200, 160, idet::PixelFormat::BGR_U8);
+
+    const std::vector<idet::Rect> rois = {
+        {0, 0, 64, 64},      // reference: crop coordinates == frame coordinates
+        {40, 30, 64, 64},    // interior
+        {150, -20, 64, 64},  // clipped at the top and right edges to (150, 0, 50, 44)
+        {300, 300, 10, 10},  // outside the frame
+    };
+    std::vector<idet::VecDetection> out;
+    ASSERT_TRUE(f.det.detect_rois(frame.image, rois, out).ok());
+    ASSERT_EQ(out.size(), rois.size());
+    ASSERT_EQ(out[0].size(), 1u);
+    ASSERT_EQ(out[1].size(), 1u);
+    ASSERT_EQ(out[2].size(), 1u);
+    EXPECT_TRUE(out[3].empty());
+
+    const idet::Point2f base = center(out[0][0].quad);
+    EXPECT_NEAR(base.x, 25.0f, 2.0f);
+    EXPECT_NEAR(base.y, 25.0f, 2.0f);
+
+    const idet::Point2f in = center(out[1][0].quad);
+    EXPECT_NEAR(in.x, base.x + 40.0f, 1e-3f);
+    EXPECT_NEAR(in.y, base.y + 30.0f, 1e-3f);
+    EXPECT_EQ(out[1][0].tile, 1);
+
+    // The clipped region starts at the frame edge, not at the requested origin.
+    const idet::Point2f edge = center(out[2][0].quad);
+    EXPECT_NEAR(edge.x, base.x + 150.0f, 1e-3f);
+    EXPECT_NEAR(edge.y, base.y, 1e-3f);
+    EXPECT_EQ(out[2][0].tile, 2);
+}
+
+TEST(DetectRois, YuvRegionsStartOnEvenCoordinates) {
+    ReplayFixture f("rois_yuv");
+    ASSERT_TRUE(f.det);
+    const std::vector<idet::Rect> rois = {{0, 0, 64, 64}, {41, 31, 64, 64}};
+
+    std::vector<idet::VecDetection> bgr, nv12, i420;
+    ASSERT_TRUE(f.det.detect_rois(Frame(200, 160, idet::PixelFormat::BGR_U8).image, rois, bgr).ok());
+    ASSERT_TRUE(f.det.detect_rois(Frame(200, 160, idet::PixelFormat::NV12_U8).image, rois, nv12).ok());
+    ASSERT_TRUE(f.det.detect_rois(Frame(200, 160, idet::PixelFormat::I420_U8).image, rois, i420).ok());
+    for (const auto* out : {&bgr, &nv12, &i420}) {
+        ASSERT_EQ(out->size(), 2u);
+        ASSERT_EQ((*out)[0].size(), 1u);
+        ASSERT_EQ((*out)[1].size(), 1u);
+    }
+
+    // Packed frames crop at the exact origin; 4:2:0 frames widen the region to (40, 30).
+    const idet::Point2f base = center(bgr[0][0].quad);
+    const idet::Point2f exact = center(bgr[1][0].quad);
+    EXPECT_NEAR(exact.x, base.x + 41.0f, 1e-3f);
+    EXPECT_NEAR(exact.y, base.y + 31.0f, 1e-3f);
+    for (const auto* out : {&nv12, &i420}) {
+        const idet::Point2f even = center((*out)[1][0].quad);
+        EXPECT_NEAR(even.x, base.x + 40.0f, 1e-3f);
+        EXPECT_NEAR(even.y, base.y + 30.0f, 1e-3f);
+    }
+}
+
+TEST(Reload, WaitWithoutBackgroundReloadFails) {
+    ReplayFixture f("reload_none");
+    ASSERT_TRUE(f.det);
+    EXPECT_EQ(f.det.wait_reload().code, idet::Status::Code::InvalidArgument);
+}
+
+TEST(Reload, SecondBackgroundReloadIsUnavailableUntilTheFirstFinishes) {
+    ReplayFixture f("reload_busy", /*latency_ms=*/500.0f);
+    ASSERT_TRUE(f.det);
+    const Frame frame(64, 64, idet::PixelFormat::BGR_U8);
+
+    // A detection in flight holds the engine, so the first reload cannot swap until it returns.
+    std::thread caller([&] { EXPECT_TRUE(f.det.detect(frame.image).ok()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto cfg = replay_config(f.path);
+    ASSERT_TRUE(f.det.reload_async(cfg).ok());
+    EXPECT_EQ(f.det.reload_async(cfg).code, idet::Status::Code::Unavailable);
+
+    caller.join();
+    EXPECT_TRUE(f.det.wait_reload().ok());
+    EXPECT_TRUE(f.det.wait_reload().ok()) << "the outcome stays available";
+    EXPECT_TRUE(f.det.reload_async(cfg).ok());
+    EXPECT_TRUE(f.det.wait_reload().ok());
+}
@@ -7,11 +7,14 @@
 #endif
 
 #include "algo/geometry.h"
+#include "algo/probmap.h"
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <iostream>
 #include <limits>
 #include <random>
 #include <set>
@@ -401,6 +404,138 @@ TEST(Geometry, ContourScore_ContourOutsideBounds_DoesNotCrash_Finite) {
     EXPECT_GE(got, 0.f);
 }
 
+TEST(Geometry, ContourScoreScanline_Rect_EqualsMeanUnderMask) {
+    const int W = 8, H = 6;
+    cv::Mat prob(H, W, CV_32F);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            prob.at<float>(y, x) = float(x + 10 * y);
+        }
+    }
+    const std::vector<cv::Point> contour = {{2, 1}, {5, 1}, {5, 4}, {2, 4}};
+    EXPECT_NEAR(idet::algo::contour_score_scanline(prob, contour), idet::algo::contour_score(prob, contour), 1e-5f);
+}
+
+TEST(Geometry, ContourScoreScanline_ConcaveContour_MatchesMaskedMean) {
+    const int W = 16, H = 12;
+    cv::Mat prob(H, W, CV_32F);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            prob.at<float>(y, x) = float((x * 7 + y * 13) % 17) / 16.f;
+        }
+    }
+    // "U" shape: two legs joined at the bottom; the notch must not be counted.
+    const std::vector<cv::Point> contour = {{2, 1}, {4, 1}, {4, 7}, {9, 7}, {9, 1}, {11, 1}, {11, 9}, {2, 9}};
+    EXPECT_NEAR(idet::algo::contour_score_scanline(prob, contour), idet::algo::contour_score(prob, contour), 1e-5f);
+}
+
+TEST(Geometry, ContourScoreScanline_EmptyOrOutside_IsZero) {
+    cv::Mat prob(10, 10, CV_32F, cv::Scalar(0.5f));
+    EXPECT_FLOAT_EQ(idet::algo::contour_score_scanline(prob, {}), 0.f);
+    const std::vector<cv::Point> outside = {{20, 20}, {30, 20}, {30, 30}, {20, 30}};
+    EXPECT_FLOAT_EQ(idet::algo::contour_score_scanline(prob, outside), 0.f);
+
+    const std::vector<cv::Point> clipped = {{-100, -100}, {20, -100}, {20, 20}, {-100, 20}};
+    EXPECT_NEAR(idet::algo::contour_score_scanline(prob, clipped), 0.5f, 1e-6f);
+}
+
+TEST(Geometry, ContourScoreScanline_Logits_MatchesActivatedMask) {
+    const int W = 20, H = 14;
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> u(-6.f, 6.f);
+    cv::Mat logits(H, W, CV_32F);
+    for (int y = 0; y < H; ++y)
+        for (int x = 0; x < W; ++x)
+            logits.at<float>(y, x) = u(rng);
+
+    const std::vector<cv::Point> contour = {{1, 2}, {17, 2}, {17, 11}, {1, 11}};
+    EXPECT_NEAR(idet::algo::contour_score_scanline(logits, contour, /*logits=*/true),
+                idet::algo::contour_score_sigmoid(logits, contour), 1e-5f);
+}
+
+TEST(Geometry, BoxScore_AxisAlignedQuad_EqualsRectMean) {
+    const int W = 12, H = 10;
+    cv::Mat prob(H, W, CV_32F);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            prob.at<float>(y, x) = float(x + y) / 20.f;
+        }
+    }
+    const auto quad = make_rect(3.f, 2.f, 8.f, 6.f);
+    const float ref = (float)cv::mean(prob(cv::Rect(3, 2, 6, 5)))[0];
+    EXPECT_NEAR(idet::algo::box_score(prob, quad), ref, 1e-5f);
+}
+
+// Micro-benchmark on a synthetic dense page: reports per-mode cost and checks that the
+// approximate scoring modes stay close to the masked reference.
+TEST(Geometry, ContourScoreModes_DensePage_CostAndDeviation) {
+    const int W = 1280, H = 960, kRegions = 600;
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> cx_d(20.f, (float)W - 20.f), cy_d(10.f, (float)H - 10.f);
+    std::uniform_real_distribution<float> len_d(12.f, 60.f), hgt_d(5.f, 14.f), ang_d(-0.35f, 0.35f);
+    std::uniform_real_distribution<float> noise_d(-0.08f, 0.08f), level_d(0.55f, 0.9f);
+
+    cv::Mat canvas(H, W, CV_32F, cv::Scalar(0.05f));
+    for (int i = 0; i < kRegions; ++i) {
+        const cv::RotatedRect rr({cx_d(rng), cy_d(rng)}, {len_d(rng), hgt_d(rng)}, ang_d(rng) * 57.29578f);
+        cv::Point2f c[4];
+        rr.points(c);
+        std::vector<std::vector<cv::Point>> poly(1);
+        for (const auto& p : c)
+            poly[0].emplace_back((int)std::lround(p.x), (int)std::lround(p.y));
+        cv::fillPoly(canvas, poly, cv::Scalar(level_d(rng)));
+    }
+    for (int y = 0; y < H; ++y)
+        for (int x = 0; x < W; ++x)
+            canvas.at<float>(y, x) = std::min(1.f, std::max(0.f, canvas.at<float>(y, x) + noise_d(rng)));
+
+    cv::Mat mask;
+    idet::algo::binarize(canvas.ptr<float>(0), W, H, 0.3f, mask);
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(mask, contours, cv::RETR_LIST, cv::CHAIN_APPROX_SIMPLE);
+    ASSERT_GT(contours.size(), (std::size_t)200);
+
+    std::vector<std::array<cv::Point2f, 4>> boxes(contours.size());
+    for (std::size_t i = 0; i < contours.size(); ++i)
+        cv::minAreaRect(contours[i]).points(boxes[i].data());
+
+    std::vector<float> ref(contours.size()), scan(contours.size()), box(contours.size());
+    auto time_ms = [&](auto&& fn) {
+        constexpr int kReps = 3;
+        double best = 1e30;
+        for (int r = 0; r < kReps; ++r) {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < contours.size(); ++i)
+                fn(i);
+            const auto t1 = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+        }
+        return best;
+    };
+
+    const double ms_ref = time_ms([&](std::size_t i) { ref[i] = idet::algo::contour_score(canvas, contours[i]); });
+    const double ms_scan =
+        time_ms([&](std::size_t i) { scan[i] = idet::algo::contour_score_scanline(canvas, contours[i]); });
+    const double ms_box = time_ms([&](std::size_t i) { box[i] = idet::algo::box_score(canvas, boxes[i]); });
+
+    double dev_scan = 0.0, dev_box = 0.0, max_scan = 0.0;
+    for (std::size_t i = 0; i < contours.size(); ++i) {
+        dev_scan += std::fabs(scan[i] - ref[i]);
+        dev_box += std::fabs(box[i] - ref[i]);
+        max_scan = std::max(max_scan, (double)std::fabs(scan[i] - ref[i]));
+    }
+    dev_scan /= (double)contours.size();
+    dev_box /= (double)contours.size();
+
+    std::cout << "[ bench    ] " << contours.size() << " contours: polygon " << ms_ref << " ms, scanline " << ms_scan
+              << " ms (mean |dev| " << dev_scan << ", max " << max_scan << "), box " << ms_box << " ms (mean |dev| "
+              << dev_box << ")\n";
+
+    EXPECT_LT(dev_scan, 0.01);
+    EXPECT_LT(max_scan, 0.1);
+    EXPECT_LT(dev_box, 0.1);
+}
+
 // ------------------------------- aabb_iou ------------------------------------
 
 TEST(Geometry, AabbIou_IdenticalIsOne) {
@@ -528,6 +663,17 @@ TEST(Geometry, QuadIou_TranslationInvariance) {
     EXPECT_NEAR(idet::algo::quad_iou(A1, B1), base, 1e-5f);
 }
 
+TEST(Geometry, QuadIou_RotatedSquare_InsideSquare_MatchesAnalytic) {
+    // Diamond with vertices on the square's edge midpoints covers half of the square.
+    const auto A = make_rect(0.f, 0.f, 10.f, 10.f);
+    std::array<cv::Point2f, 4> B = {{{5.f, 0.f}, {10.f, 5.f}, {5.f, 10.f}, {0.f, 5.f}}};
+    EXPECT_NEAR(idet::algo::quad_iou(A, B), 0.5f, 1e-5f);
+
+    // Vertex order (clockwise or not) must not matter.
+    std::array<cv::Point2f, 4> Bccw = {{B[0], B[3], B[2], B[1]}};
+    EXPECT_NEAR(idet::algo::quad_iou(A, Bccw), 0.5f, 1e-5f);
+}
+
 // ------------------------------ aspect_fit32 ---------------------------------
 
 TEST(Geometry, AspectFit32_InvalidInput_Returns32) {
@@ -553,3 +699,75 @@ TEST(Geometry, AspectFit32_NoUpscale_WhenAlreadyBelowSide) {
     EXPECT_EQ(r.first % 32, 0);
     EXPECT_EQ(r.second % 32, 0);
 }
+
+// ------------------------- letterbox_fit / pick_bucket -----------------------
+
+TEST(Geometry, LetterboxFit_KeepsAspectInsideCanvas) {
+    auto f = idet::algo::letterbox_fit(1280, 720, 960, 544, 960);
+    EXPECT_EQ(f.w, 960);
+    EXPECT_EQ(f.h, 540);
+
+    // Canvas narrower than the capped frame: width is the binding constraint.
+    f = idet::algo::letterbox_fit(1280, 720, 640, 640, 960);
+    EXPECT_EQ(f.w, 640);
+    EXPECT_EQ(f.h, 360);
+}
+
+TEST(Geometry, LetterboxFit_NoUpscale_AndInvalidInput) {
+    auto f = idet::algo::letterbox_fit(300, 200, 960, 544, 960);
+    EXPECT_EQ(f.w, 300);
+    EXPECT_EQ(f.h, 200);
+
+    f = idet::algo::letterbox_fit(0, 200, 960, 544, 960);
+    EXPECT_EQ(f.w, 0);
+    EXPECT_EQ(f.h, 0);
+}
+
+TEST(Geometry, LetterboxView_CropsPaddingAndMapsBackToTheFrame) {
+    // 1280x720 capped to 960 in a 960x544 input: 4 padding rows below the content.
+    const auto f = idet::algo::letterbox_fit(1280, 720, 960, 544, 960);
+    ASSERT_EQ(f.w, 960);
+    ASSERT_EQ(f.h, 540);
+
+    // Stride-4 map: 240x136, of which 240x135 (rounded up) covers the content.
+    const auto v = idet::algo::letterbox_view(240, 136, 960, 544, f.w, f.h, 1280, 720);
+    EXPECT_EQ(v.w, 240);
+    EXPECT_EQ(v.h, 135);
+    EXPECT_NEAR(v.sx, 1280.0f / 240.0f, 1e-5f);
+    EXPECT_NEAR(v.sy, 720.0f / 135.0f, 1e-5f);
+    EXPECT_NEAR(v.sx, v.sy, 1e-5f) << "letterboxing keeps one scale on both axes";
+
+    // The content starts at the map origin: the map corners of the view land on the frame corners.
+    EXPECT_NEAR((float)v.w * v.sx, 1280.0f, 1e-2f);
+    EXPECT_NEAR((float)v.h * v.sy, 720.0f, 1e-2f);
+    EXPECT_NEAR(60.0f * v.sx, 320.0f, 1e-2f); // a quarter of the width
+}
+
+TEST(Geometry, LetterboxView_PortraitFramePadsToTheRight) {
+    const auto f = idet::algo::letterbox_fit(720, 1280, 960, 544, 960);
+    ASSERT_EQ(f.h, 544);
+    ASSERT_EQ(f.w, 306);
+
+    const auto v = idet::algo::letterbox_view(240, 136, 960, 544, f.w, f.h, 720, 1280);
+    EXPECT_EQ(v.w, 77); // ceil(306 / 4)
+    EXPECT_EQ(v.h, 136);
+    EXPECT_NEAR(v.sx, 720.0f / 76.5f, 1e-4f);
+    EXPECT_NEAR(v.sy, 1280.0f / 136.0f, 1e-4f);
+}
+
+TEST(Geometry, LetterboxView_WithoutLetterboxKeepsTheWholeMap) {
+    const auto v = idet::algo::letterbox_view(240, 136, 960, 544, 960, 544, 1280, 720);
+    EXPECT_EQ(v.w, 240);
+    EXPECT_EQ(v.h, 136);
+    EXPECT_NEAR(v.sx, 1280.0f / 240.0f, 1e-5f);
+    EXPECT_NEAR(v.sy, 720.0f / 136.0f, 1e-5f);
+}
+
+TEST(Geometry, PickBucket_PrefersOrientationAndSmallerCanvasOnTie) {
+    const std::vector<std::pair<int, int>> buckets = {{960, 544}, {544, 960}, {1280, 736}};
+
+    EXPECT_EQ(idet::algo::pick_bucket(buckets, 1280, 720, 960), 0); // 1280 capped to 960: smaller canvas wins
+    EXPECT_EQ(idet::algo::pick_bucket(buckets, 720, 1280, 960), 1);
+    EXPECT_EQ(idet::algo::pick_bucket(buckets, 1280, 720, 2000), 2); // no cap: full resolution only fits in 2
+    EXPECT_EQ(idet::algo::pick_bucket({}, 100, 100, 960), -1);
+}
@@ -0,0 +1,101 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "algo/half.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using idet::algo::SimdLevel;
+
+namespace {
+
+float from_bits(std::uint32_t x) {
+    float f = 0.0f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+bool is_nan_half(std::uint16_t h) {
+    return (h & 0x7c00u) == 0x7c00u && (h & 0x03ffu) != 0;
+}
+
+} // namespace
+
+TEST(Half, KnownValuesRoundToNearestEven) {
+    using idet::algo::f32_to_f16_bits;
+    EXPECT_EQ(f32_to_f16_bits(0.0f), 0x0000u);
+    EXPECT_EQ(f32_to_f16_bits(-0.0f), 0x8000u);
+    EXPECT_EQ(f32_to_f16_bits(1.0f), 0x3c00u);
+    EXPECT_EQ(f32_to_f16_bits(-2.0f), 0xc000u);
+    EXPECT_EQ(f32_to_f16_bits(65504.0f), 0x7bffu);
+    EXPECT_EQ(f32_to_f16_bits(65519.0f), 0x7bffu);
+    EXPECT_EQ(f32_to_f16_bits(65520.0f), 0x7c00u);
+    EXPECT_EQ(f32_to_f16_bits(std::numeric_limits<float>::infinity()), 0x7c00u);
+    EXPECT_EQ(f32_to_f16_bits(std::ldexp(1.0f, -24)), 0x0001u); // smallest subnormal
+    EXPECT_EQ(f32_to_f16_bits(std::ldexp(1.0f, -25)), 0x0000u); // tie -> even (zero)
+    EXPECT_EQ(f32_to_f16_bits(std::ldexp(3.0f, -26)), 0x0001u);
+    EXPECT_EQ(f32_to_f16_bits(1.0f + std::ldexp(1.0f, -11)), 0x3c00u);       // tie -> even
+    EXPECT_EQ(f32_to_f16_bits(1.0f + 3.0f * std::ldexp(1.0f, -11)), 0x3c02u); // tie -> even
+    EXPECT_TRUE(is_nan_half(f32_to_f16_bits(std::numeric_limits<float>::quiet_NaN())));
+}
+
+TEST(Half, EveryHalfRoundTripsExactly) {
+    for (std::uint32_t h = 0; h <= 0xffffu; ++h) {
+        const float f = idet::algo::f16_bits_to_f32((std::uint16_t)h);
+        if (is_nan_half((std::uint16_t)h)) {
+            ASSERT_TRUE(std::isnan(f)) << std::hex << h;
+            continue;
+        }
+        ASSERT_EQ(idet::algo::f32_to_f16_bits(f), h) << std::hex << h;
+    }
+}
+
+TEST(Half, SimdLevelsMatchScalar) {
+    std::mt19937 rng(7);
+    std::vector<float> src;
+    // Random bit patterns cover subnormals, overflow and NaN; scaled normals cover typical tensors.
+    for (int i = 0; i < 4099; ++i)
+        src.push_back(from_bits((std::uint32_t)rng()));
+    std::normal_distribution<float> nd(0.0f, 4.0f);
+    for (int i = 0; i < 4099; ++i)
+        src.push_back(nd(rng));
+
+    std::vector<std::uint16_t> ref(src.size()), got(src.size());
+    idet::algo::f32_to_f16(src.data(), ref.data(), src.size(), SimdLevel::Scalar);
+    std::vector<float> back_ref(src.size()), back(src.size());
+    idet::algo::f16_to_f32(ref.data(), back_ref.data(), ref.size(), SimdLevel::Scalar);
+
+    for (SimdLevel lv : {SimdLevel::NEON, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (!idet::algo::simd_level_supported(lv)) continue;
+        SCOPED_TRACE(idet::algo::simd_level_name(lv));
+
+        idet::algo::f32_to_f16(src.data(), got.data(), src.size(), lv);
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            if (std::isnan(src[i])) {
+                ASSERT_TRUE(is_nan_half(got[i])) << i;
+            } else {
+                ASSERT_EQ(got[i], ref[i]) << i;
+            }
+        }
+
+        idet::algo::f16_to_f32(ref.data(), back.data(), ref.size(), lv);
+        for (std::size_t i = 0; i < ref.size(); ++i) {
+            if (std::isnan(back_ref[i])) {
+                ASSERT_TRUE(std::isnan(back[i])) << i;
+            } else {
+                ASSERT_EQ(back[i], back_ref[i]) << i;
+            }
+        }
+    }
+}
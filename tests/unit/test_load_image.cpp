@@ -0,0 +1,120 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "idet.h"
+#include "image.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// Decode-time downscaling of load_image(path, LoadOptions) on a binary PPM, which both stb_image
+// (header probe, full-size path) and OpenCV (reduced path) read.
+
+namespace {
+
+constexpr int kW = 640;
+constexpr int kH = 480;
+
+// White box on black, aligned to the strongest reduction (1/8) so every scale keeps its edges.
+constexpr int kBoxX0 = 200;
+constexpr int kBoxY0 = 160;
+constexpr int kBoxX1 = 328;
+constexpr int kBoxY1 = 224;
+
+struct TempImage {
+    std::string path;
+
+    explicit TempImage(const char* tag) : path(std::string(::testing::TempDir()) + "idet_load_" + tag + ".ppm") {
+        std::ofstream out(path, std::ios::binary);
+        out << "P6\n" << kW << " " << kH << "\n255\n";
+        for (int y = 0; y < kH; ++y)
+            for (int x = 0; x < kW; ++x) {
+                const bool in = x >= kBoxX0 && x < kBoxX1 && y >= kBoxY0 && y < kBoxY1;
+                const char v = in ? '\xff' : '\0';
+                out.put(v).put(v).put(v);
+            }
+    }
+
+    ~TempImage() {
+        std::remove(path.c_str());
+    }
+};
+
+static idet::LoadedImage load(const std::string& path, int target) {
+    idet::LoadOptions lo;
+    lo.target_max_side = target;
+    auto r = idet::load_image(path, lo);
+    EXPECT_TRUE(r.ok()) << r.status().message;
+    return r.ok() ? std::move(r.value()) : idet::LoadedImage{};
+}
+
+/// @brief Axis-aligned quad around the bright pixels of the first channel of a packed BGR image.
+static idet::Quad bright_box(const idet::ImageView& v) {
+    int x0 = v.width, y0 = v.height, x1 = -1, y1 = -1;
+    for (int y = 0; y < v.height; ++y) {
+        const std::uint8_t* row = v.data + (std::size_t)y * v.stride_bytes;
+        for (int x = 0; x < v.width; ++x) {
+            if (row[3 * x] < 128) continue;
+            x0 = std::min(x0, x);
+            y0 = std::min(y0, y);
+            x1 = std::max(x1, x + 1);
+            y1 = std::max(y1, y + 1);
+        }
+    }
+    const float l = (float)x0, t = (float)y0, r = (float)x1, b = (float)y1;
+    return {idet::Point2f{l, t}, idet::Point2f{r, t}, idet::Point2f{r, b}, idet::Point2f{l, b}};
+}
+
+} // namespace
+
+TEST(LoadImage, DecodeScaleIsTheStrongestReductionThatKeepsTheTarget) {
+    const TempImage img("scale");
+    // target -> expected reduction of the 640 px longest side
+    const int cases[][2] = {{0, 1}, {80, 8}, {81, 4}, {160, 4}, {161, 2}, {320, 2}, {321, 1}, {1000, 1}};
+    for (const auto& c : cases) {
+        const idet::LoadedImage li = load(img.path, c[0]);
+        ASSERT_TRUE(li.image) << "target " << c[0];
+        EXPECT_EQ(li.source_width, kW);
+        EXPECT_EQ(li.source_height, kH);
+        EXPECT_EQ(li.image.view().width, kW / c[1]) << "target " << c[0];
+        EXPECT_EQ(li.image.view().height, kH / c[1]) << "target " << c[0];
+        EXPECT_FLOAT_EQ(li.scale_x, 1.0f / (float)c[1]);
+        EXPECT_FLOAT_EQ(li.scale_y, 1.0f / (float)c[1]);
+        EXPECT_GE(std::max(li.image.view().width, li.image.view().height), std::min(c[0], kW));
+    }
+}
+
+TEST(LoadImage, BoxesOnAReducedDecodeMapBackToSourcePixels) {
+    const TempImage img("map");
+    for (int target : {0, 320, 160, 80}) {
+        const idet::LoadedImage li = load(img.path, target);
+        ASSERT_TRUE(li.image);
+        idet::VecQuad quads = {bright_box(li.image.view())};
+        idet::map_to_source(quads, li);
+
+        // One reduced pixel spans 1 / scale source pixels; the box edges are aligned to it.
+        const float tol = 0.5f / li.scale_x;
+        EXPECT_NEAR(quads[0][0].x, (float)kBoxX0, tol) << "target " << target;
+        EXPECT_NEAR(quads[0][0].y, (float)kBoxY0, tol) << "target " << target;
+        EXPECT_NEAR(quads[0][2].x, (float)kBoxX1, tol) << "target " << target;
+        EXPECT_NEAR(quads[0][2].y, (float)kBoxY1, tol) << "target " << target;
+    }
+}
+
+TEST(LoadImage, ReducedDecodeRejectsNonPackedOutputs) {
+    const TempImage img("format");
+    idet::LoadOptions lo;
+    lo.output_format = idet::PixelFormat::NV12_U8;
+    lo.target_max_side = 160;
+    const auto r = idet::load_image(img.path, lo);
+    ASSERT_FALSE(r.ok());
+    EXPECT_EQ(r.status().code, idet::Status::Code::Unsupported);
+}
@@ -7,12 +7,14 @@
 #endif
 
 #include "algo/nms.h"
+#include "algo/tile_merge.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
 #include <limits>
+#include <random>
 #include <vector>
 
 namespace {
@@ -38,6 +40,11 @@ static idet::algo::Detection diamond(float cx, float cy, float r, float score) {
     return d;
 }
 
+static idet::algo::Detection in_tile(idet::algo::Detection d, int tile) {
+    d.tile = tile;
+    return d;
+}
+
 static bool is_sorted_desc(const std::vector<idet::algo::Detection>& v) {
     for (std::size_t i = 1; i < v.size(); ++i) {
         if (v[i - 1].score < v[i].score) return false;
@@ -244,3 +251,366 @@ TEST(NMS, NaNScore_HandledDeterministically_NoCrash) {
     // If NaNs are present, you may want a policy: treat as -inf or 0
     // If you implement that, tighten this test accordingly
 }
+
+TEST(NMS, AabbIouBatch_AllSimdLevelsMatchScalarIou) {
+    using idet::algo::SimdLevel;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(0.f, 100.f), ext(0.f, 30.f);
+
+    const std::size_t n = 37; // not a multiple of any vector width
+    std::vector<float> x0(n), y0(n), x1(n), y1(n);
+    std::vector<std::array<cv::Point2f, 4>> quads(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        x0[k] = pos(rng);
+        y0[k] = pos(rng);
+        x1[k] = x0[k] + ((k % 9 == 0) ? 0.f : ext(rng)); // some zero-width boxes
+        y1[k] = y0[k] + ext(rng);
+        quads[k] = rect(x0[k], y0[k], x1[k], y1[k], 1.f).pts;
+    }
+    const idet::algo::AABB a{20.f, 30.f, 60.f, 55.f};
+    const auto qa = rect(a.minx, a.miny, a.maxx, a.maxy, 1.f).pts;
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::NEON, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (!idet::algo::simd_level_supported(level)) continue;
+        std::vector<float> iou(n, -1.f);
+        idet::algo::aabb_iou_batch(a, {x0.data(), y0.data(), x1.data(), y1.data()}, n, iou.data(), level);
+        for (std::size_t k = 0; k < n; ++k)
+            EXPECT_FLOAT_EQ(iou[k], idet::algo::aabb_iou(qa, quads[k]))
+                << idet::algo::simd_level_name(level) << " k=" << k;
+    }
+}
+
+TEST(NMS, GridScene_KeptBoxesDoNotOverlapAboveThreshold) {
+    // Enough boxes for the grid path, several candidates per cell.
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> pos(0.f, 600.f), ext(8.f, 60.f), sc(0.f, 1.f);
+    std::vector<idet::algo::Detection> dets;
+    for (int i = 0; i < 400; ++i) {
+        const float x = pos(rng), y = pos(rng);
+        dets.push_back(rect(x, y, x + ext(rng), y + ext(rng), sc(rng)));
+    }
+
+    for (bool fast : {false, true}) {
+        const float thr = 0.3f;
+        auto out = idet::algo::nms_poly(dets, thr, fast);
+        ASSERT_FALSE(out.empty());
+        EXPECT_TRUE(is_sorted_desc(out));
+        for (std::size_t i = 0; i < out.size(); ++i)
+            for (std::size_t j = i + 1; j < out.size(); ++j)
+                EXPECT_LT(idet::algo::quad_iou(out[i].pts, out[j].pts, fast), thr);
+    }
+}
+
+// --------------------------- NmsWorkspace ---------------------------
+
+namespace {
+
+static std::vector<idet::algo::Detection> random_scene(unsigned seed, int n, float span) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(0.f, span), ext(8.f, 60.f), sc(0.f, 1.f);
+    std::vector<idet::algo::Detection> dets;
+    for (int i = 0; i < n; ++i) {
+        const float x = pos(rng), y = pos(rng);
+        dets.push_back(rect(x, y, x + ext(rng), y + ext(rng), sc(rng)));
+    }
+    return dets;
+}
+
+static void expect_same_boxes(const std::vector<idet::algo::Detection>& a,
+                              const std::vector<idet::algo::Detection>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_FLOAT_EQ(a[i].score, b[i].score) << "i=" << i;
+        EXPECT_FLOAT_EQ(a[i].pts[0].x, b[i].pts[0].x) << "i=" << i;
+        EXPECT_FLOAT_EQ(a[i].pts[2].y, b[i].pts[2].y) << "i=" << i;
+    }
+}
+
+} // namespace
+
+TEST(NmsWorkspace, HardMatchesNmsPolyAndReusesCapacity) {
+    const auto dets = random_scene(11, 400, 600.f);
+    idet::algo::NmsWorkspace ws;
+    std::vector<idet::algo::Detection> out;
+
+    for (bool fast : {false, true}) {
+        idet::algo::NmsParams p;
+        p.use_fast_iou = fast;
+        ws.run(dets, p);
+        ws.gather(dets, out);
+        expect_same_boxes(out, idet::algo::nms_poly(dets, p.iou_thr, fast));
+        EXPECT_EQ(ws.clusters(), 0u) << "serial hard NMS does not cluster";
+    }
+
+    const auto warm = ws.arena().upstream_allocations();
+    idet::algo::NmsParams p;
+    ws.run(dets, p);
+    EXPECT_EQ(ws.arena().upstream_allocations(), warm) << "steady state must not grow the arena";
+}
+
+TEST(NmsWorkspace, ClusteredRunMatchesSerial) {
+    // Sparse enough to fall apart into many clusters (a dense scene percolates into one).
+    const auto dets = random_scene(23, 1500, 3000.f);
+    idet::algo::NmsParams p;
+    p.iou_thr = 0.2f;
+
+    for (auto method : {idet::algo::NmsMethod::Hard, idet::algo::NmsMethod::Weighted}) {
+        p.method = method;
+        idet::algo::NmsWorkspace serial, parallel;
+        p.threads = 1;
+        const std::vector<int> a = serial.run(dets, p);
+        p.threads = 4;
+        const std::vector<int> b = parallel.run(dets, p);
+        EXPECT_EQ(a, b);
+        EXPECT_GT(parallel.clusters(), 1u);
+
+        std::vector<idet::algo::Detection> oa, ob;
+        serial.gather(dets, oa);
+        parallel.gather(dets, ob);
+        expect_same_boxes(oa, ob);
+    }
+}
+
+TEST(NmsWorkspace, SoftNmsDecaysInsteadOfRemoving) {
+    std::vector<idet::algo::Detection> dets;
+    dets.push_back(rect(0, 0, 10, 10, 0.9f));
+    dets.push_back(rect(0, 0, 10, 5, 0.8f));        // IoU 0.5 with the first box
+    dets.push_back(rect(100, 100, 110, 110, 0.7f)); // disjoint
+
+    idet::algo::NmsWorkspace ws;
+    idet::algo::NmsParams p;
+    p.iou_thr = 0.3f;
+
+    p.method = idet::algo::NmsMethod::Linear;
+    ASSERT_EQ(ws.run(dets, p).size(), 3u);
+    EXPECT_EQ(ws.kept()[0], 0);
+    EXPECT_EQ(ws.kept()[1], 2) << "decayed below the disjoint box";
+    EXPECT_EQ(ws.kept()[2], 1);
+    EXPECT_NEAR(ws.scores()[2], 0.8f * 0.5f, 1e-5f);
+    EXPECT_FLOAT_EQ(ws.scores()[1], 0.7f);
+
+    p.method = idet::algo::NmsMethod::Gaussian;
+    p.sigma = 0.5f;
+    ASSERT_EQ(ws.run(dets, p).size(), 3u);
+    EXPECT_NEAR(ws.scores()[2], 0.8f * std::exp(-0.25f / 0.5f), 1e-5f);
+
+    p.min_score = 0.6f;
+    ASSERT_EQ(ws.run(dets, p).size(), 2u) << "decayed below min_score";
+    EXPECT_EQ(ws.kept()[1], 2);
+}
+
+// Dense clusters of heavily overlapping boxes around a few centres; scores are distinct.
+static std::vector<idet::algo::Detection> clustered_scene(unsigned seed, int clusters, int per_cluster) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> centre(100.f, 900.f), jitter(-12.f, 12.f), ext(20.f, 50.f);
+    std::vector<idet::algo::Detection> dets;
+    for (int c = 0; c < clusters; ++c) {
+        const float cx = centre(rng), cy = centre(rng);
+        for (int k = 0; k < per_cluster; ++k) {
+            const float x = cx + jitter(rng), y = cy + jitter(rng);
+            if (k % 4 == 0)
+                dets.push_back(diamond(x, y, 0.5f * ext(rng), 0.f));
+            else
+                dets.push_back(rect(x, y, x + ext(rng), y + ext(rng), 0.f));
+        }
+    }
+    std::vector<int> perm(dets.size());
+    for (std::size_t i = 0; i < perm.size(); ++i)
+        perm[i] = (int)i;
+    std::shuffle(perm.begin(), perm.end(), rng);
+    for (std::size_t i = 0; i < dets.size(); ++i)
+        dets[i].score = (float)(perm[i] + 1) / (float)(dets.size() + 1);
+    return dets;
+}
+
+// Textbook Soft-NMS: every step scans all remaining boxes.
+static std::vector<std::pair<int, float>> soft_nms_reference(const std::vector<idet::algo::Detection>& dets,
+                                                             const idet::algo::NmsParams& p) {
+    const bool linear = p.method == idet::algo::NmsMethod::Linear;
+    const float inv_sigma = 1.0f / std::max(1e-6f, p.sigma);
+    std::vector<float> cur(dets.size());
+    std::vector<bool> alive(dets.size(), true);
+    for (std::size_t i = 0; i < dets.size(); ++i)
+        cur[i] = dets[i].score;
+
+    std::vector<std::pair<int, float>> kept;
+    for (;;) {
+        int best = -1;
+        for (std::size_t i = 0; i < dets.size(); ++i)
+            if (alive[i] && (best < 0 || cur[i] > cur[(std::size_t)best])) best = (int)i;
+        if (best < 0 || !(cur[(std::size_t)best] >= p.min_score)) break;
+        alive[(std::size_t)best] = false;
+        kept.emplace_back(best, cur[(std::size_t)best]);
+
+        for (std::size_t j = 0; j < dets.size(); ++j) {
+            if (!alive[j]) continue;
+            const float iou = idet::algo::quad_iou(dets[(std::size_t)best].pts, dets[j].pts, p.use_fast_iou);
+            if (linear) {
+                if (iou >= p.iou_thr) cur[j] *= 1.0f - iou;
+            } else {
+                cur[j] *= std::exp(-iou * iou * inv_sigma);
+            }
+        }
+    }
+    std::stable_sort(kept.begin(), kept.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    return kept;
+}
+
+TEST(NmsWorkspace, SoftNmsMatchesBruteForceOnDenseClusters) {
+    const auto dets = clustered_scene(31, 6, 150);
+
+    for (auto method : {idet::algo::NmsMethod::Linear, idet::algo::NmsMethod::Gaussian}) {
+        for (bool fast : {false, true}) {
+            idet::algo::NmsParams p;
+            p.method = method;
+            p.use_fast_iou = fast;
+            p.iou_thr = 0.3f;
+            p.min_score = 0.05f;
+            const auto ref = soft_nms_reference(dets, p);
+
+            for (int threads : {1, 4}) {
+                p.threads = threads;
+                idet::algo::NmsWorkspace ws;
+                const std::vector<int>& kept = ws.run(dets, p);
+                ASSERT_EQ(kept.size(), ref.size()) << "method=" << (int)method << " fast=" << fast;
+                for (std::size_t k = 0; k < ref.size(); ++k) {
+                    EXPECT_EQ(kept[k], ref[k].first) << "k=" << k;
+                    EXPECT_NEAR(ws.scores()[k], ref[k].second, 1e-5f) << "k=" << k;
+                }
+            }
+        }
+    }
+}
+
+TEST(NmsWorkspace, WeightedMergesSuppressedQuads) {
+    std::vector<idet::algo::Detection> dets;
+    dets.push_back(rect(0, 0, 10, 10, 0.6f));
+    dets.push_back(rect(2, 0, 12, 10, 0.2f)); // IoU 8/12 with the first box
+    dets.push_back(rect(50, 50, 60, 60, 0.5f));
+
+    idet::algo::NmsWorkspace ws;
+    idet::algo::NmsParams p;
+    p.method = idet::algo::NmsMethod::Weighted;
+    ASSERT_EQ(ws.run(dets, p).size(), 2u);
+
+    std::vector<idet::algo::Detection> out;
+    ws.gather(dets, out);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_FLOAT_EQ(out[0].score, 0.6f);
+    EXPECT_NEAR(out[0].pts[0].x, 0.5f, 1e-5f); // (0.6 * 0 + 0.2 * 2) / 0.8
+    EXPECT_NEAR(out[0].pts[1].x, 10.5f, 1e-5f);
+    EXPECT_FLOAT_EQ(out[1].pts[0].x, 50.0f) << "nothing to merge";
+}
+
+// --------------------------- tile-aware merge ---------------------------
+
+TEST(TileMerge, SuppressesOnlyAtSeams) {
+    // Two tiles with a 20 px overlap strip at x in [40, 60]
+    const std::vector<cv::Rect> tiles = {{0, 0, 60, 40}, {40, 0, 60, 40}};
+    const std::vector<idet::algo::Detection> dets = {
+        in_tile(rect(2, 2, 20, 20, 0.9f), 0), in_tile(rect(4, 4, 20, 20, 0.8f), 0), // interior, overlapping
+        in_tile(rect(42, 5, 55, 30, 0.7f), 0), in_tile(rect(42, 5, 55, 30, 0.6f), 1), // same object, both tiles
+    };
+
+    idet::algo::TileMergeParams p;
+    p.iou_thr = 0.3f;
+    idet::algo::FrameArena arena;
+    std::vector<idet::algo::Detection> out;
+    idet::algo::merge_tiled(dets, tiles, p, arena, out);
+
+    expect_all_scores_present(out, {0.9f, 0.8f, 0.7f});
+    // Interior detections come first, in input order
+    EXPECT_FLOAT_EQ(out[0].score, 0.9f);
+    EXPECT_FLOAT_EQ(out[1].score, 0.8f);
+
+    p.per_tile_nms = true;
+    idet::algo::merge_tiled(dets, tiles, p, arena, out);
+    expect_all_scores_present(out, {0.9f, 0.7f});
+}
+
+TEST(TileMerge, JoinsFragmentsAcrossSeam) {
+    // Adjacent tiles without overlap; a text line cut at x = 50
+    const std::vector<cv::Rect> tiles = {{0, 0, 50, 40}, {50, 0, 50, 40}};
+    const std::vector<idet::algo::Detection> dets = {
+        in_tile(rect(30, 10, 50, 20, 0.8f), 0),
+        in_tile(rect(50, 11, 72, 21, 0.6f), 1),
+        in_tile(rect(5, 30, 15, 35, 0.9f), 0), // unrelated
+    };
+
+    idet::algo::TileMergeParams p;
+    p.iou_thr = 0.3f;
+    idet::algo::FrameArena arena;
+    std::vector<idet::algo::Detection> out;
+
+    idet::algo::merge_tiled(dets, tiles, p, arena, out);
+    EXPECT_EQ(out.size(), 3u);
+
+    p.join_seams = true;
+    idet::algo::merge_tiled(dets, tiles, p, arena, out);
+    ASSERT_EQ(out.size(), 2u);
+
+    const auto& j = out[1];
+    float minx = j.pts[0].x, maxx = j.pts[0].x;
+    for (const auto& q : j.pts) {
+        minx = std::min(minx, q.x);
+        maxx = std::max(maxx, q.x);
+    }
+    EXPECT_NEAR(minx, 30.f, 1.f);
+    EXPECT_NEAR(maxx, 72.f, 1.f);
+    EXPECT_GT(j.score, 0.6f);
+    EXPECT_LT(j.score, 0.8f);
+}
+
+TEST(TileMerge, DropsBorderFragmentCoveredByOtherTile) {
+    // Tile 0 cuts the word at x = 60; tile 1 sees it whole
+    const std::vector<cv::Rect> tiles = {{0, 0, 60, 40}, {40, 0, 60, 40}};
+    const std::vector<idet::algo::Detection> dets = {
+        in_tile(rect(45, 10, 60, 20, 0.9f), 0),
+        in_tile(rect(45, 10, 75, 20, 0.7f), 1),
+    };
+
+    idet::algo::TileMergeParams p;
+    p.iou_thr = 0.6f; // IoU 0.5: plain suppression keeps both
+    idet::algo::FrameArena arena;
+    std::vector<idet::algo::Detection> out;
+
+    idet::algo::merge_tiled(dets, tiles, p, arena, out);
+    EXPECT_EQ(out.size(), 2u);
+
+    p.join_seams = true;
+    idet::algo::merge_tiled(dets, tiles, p, arena, out);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_FLOAT_EQ(out[0].score, 0.7f);
+}
+
+TEST(TileMerge, SeamCandidatesComeOutInScoreOrder) {
+    const std::vector<cv::Rect> tiles = {{0, 0, 50, 60}, {50, 0, 50, 60}};
+    std::vector<idet::algo::Detection> dets = {
+        in_tile(rect(45, 2, 55, 8, 0.3f), 0),
+        in_tile(rect(5, 2, 15, 8, 0.1f), 0), // interior
+        in_tile(rect(45, 12, 55, 18, 0.9f), 1),
+        in_tile(rect(45, 22, 55, 28, 0.6f), 0),
+    };
+
+    idet::algo::TileMergeParams p;
+    p.iou_thr = 0.0f; // no suppression: candidates pass through
+    idet::algo::FrameArena arena;
+    std::vector<idet::algo::Detection> out;
+    idet::algo::merge_tiled(dets, tiles, p, arena, out);
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_FLOAT_EQ(out[0].score, 0.1f);
+    EXPECT_FLOAT_EQ(out[1].score, 0.9f);
+    EXPECT_FLOAT_EQ(out[2].score, 0.6f);
+    EXPECT_FLOAT_EQ(out[3].score, 0.3f);
+
+    // A joined pair gets a blended score and still lands in order.
+    dets.push_back(in_tile(rect(30, 40, 50, 50, 0.8f), 0));
+    dets.push_back(in_tile(rect(50, 41, 72, 51, 0.6f), 1));
+    p.iou_thr = 0.3f;
+    p.join_seams = true;
+    idet::algo::merge_tiled(dets, tiles, p, arena, out);
+    ASSERT_EQ(out.size(), 5u);
+    EXPECT_FLOAT_EQ(out[0].score, 0.1f);
+    for (std::size_t i = 2; i < out.size(); ++i)
+        EXPECT_GE(out[i - 1].score, out[i].score);
+}
@@ -403,6 +403,49 @@ TEST(OrtTensor, ExtractHWChannel_ZeroHW_ReturnsNull) {
     EXPECT_EQ(p, nullptr);
 }
 
+TEST(OrtTensor, PlaneFnFor_MatchesExtractHWChannel) {
+    const int H = 3, W = 5, C = 2;
+    std::vector<float> data((std::size_t)(H * W * C));
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = (float)i;
+
+    for (TensorLayout l : {TensorLayout::NCHW, TensorLayout::NHWC, TensorLayout::N1HW, TensorLayout::HW}) {
+        TensorDesc d;
+        d.layout = l;
+        d.H = H;
+        d.W = W;
+        d.C = (l == TensorLayout::NCHW || l == TensorLayout::NHWC) ? C : 1;
+
+        const idet::internal::PlaneFn fn = idet::internal::plane_fn_for(l);
+        ASSERT_NE(fn, nullptr);
+        for (int ch = 0; ch < C; ++ch) {
+            std::vector<float> s0, s1;
+            const float* ref = idet::internal::extract_hw_channel(data.data(), d, ch, s0);
+            const float* got = fn(data.data(), d, ch, s1);
+            ASSERT_NE(ref, nullptr);
+            ASSERT_NE(got, nullptr);
+            EXPECT_TRUE(std::equal(ref, ref + H * W, got)) << "layout " << (int)l << " channel " << ch;
+        }
+    }
+
+    EXPECT_EQ(idet::internal::plane_fn_for(TensorLayout::Unknown), nullptr);
+    EXPECT_EQ(idet::internal::plane_fn_for(TensorLayout::FlatNC), nullptr);
+}
+
+TEST(OrtTensor, ExtractHWChannel_NHWC_SingleChannelCopies) {
+    TensorDesc d;
+    d.layout = TensorLayout::NHWC;
+    d.H = 2;
+    d.W = 3;
+    d.C = 1;
+
+    const std::vector<float> data = {1, 2, 3, 4, 5, 6};
+    std::vector<float> scratch;
+    const float* p = idet::internal::extract_hw_channel(data.data(), d, 0, scratch);
+    ASSERT_EQ(p, scratch.data());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), p));
+}
+
 // ----------------------------------- make_desc_probmap -----------------------------------------
 
 TEST(OrtTensor, MakeDescProbmap_HeuristicPrefersNCHWWhenBothSeemValid) {
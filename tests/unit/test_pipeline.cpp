@@ -0,0 +1,413 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "engine/engine.h"
+#include "pipeline/async_pipeline.h"
+#include "pipeline/tile_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Engine with staged bound inference: each frame yields one box of the frame's width in x.
+class StagedEngine final : public idet::engine::IEngine {
+  public:
+    explicit StagedEngine(const idet::DetectorConfig& cfg, bool staged) : IEngine(cfg, "staged"), staged_(staged) {}
+
+    idet::EngineKind kind() const noexcept override {
+        return cfg_.engine;
+    }
+    idet::Task task() const noexcept override {
+        return cfg_.task;
+    }
+
+    idet::Status update_hot(const idet::DetectorConfig&) noexcept override {
+        return idet::Status::Ok();
+    }
+
+    idet::Status setup_binding(int w, int h, int contexts, int batch) noexcept override {
+        binding_ready_ = true;
+        bound_w_ = w;
+        bound_h_ = h;
+        contexts_ = (contexts > 0) ? contexts : 1;
+        batch_ = (batch > 0) ? batch : 1;
+        widths_.assign((std::size_t)contexts_, 0);
+        return idet::Status::Ok();
+    }
+
+    void unset_binding() noexcept override {
+        binding_ready_ = false;
+        contexts_ = 0;
+        widths_.clear();
+    }
+
+    idet::Result<std::vector<idet::algo::Detection>> infer_unbound(const cv::Mat& bgr) noexcept override {
+        return idet::Result<std::vector<idet::algo::Detection>>::Ok(box(bgr.cols));
+    }
+
+    idet::Result<std::vector<idet::algo::Detection>> infer_bound(const cv::Mat& bgr, int) noexcept override {
+        return idet::Result<std::vector<idet::algo::Detection>>::Ok(box(bgr.cols));
+    }
+
+    bool supports_stages() const noexcept override {
+        return staged_;
+    }
+
+    idet::Status stage_input(const cv::Mat& bgr, int ctx_idx) noexcept override {
+        if (bgr.cols == kFailWidth) return idet::Status::DecodeError("bad frame");
+        const int now = busy.fetch_add(1) + 1;
+        int prev = peak_busy.load();
+        while (now > prev && !peak_busy.compare_exchange_weak(prev, now)) {
+        }
+        widths_[(std::size_t)ctx_idx] = bgr.cols;
+        return idet::Status::Ok();
+    }
+
+    idet::Status stage_run(int) noexcept override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return idet::Status::Ok();
+    }
+
+    idet::Result<std::vector<idet::algo::Detection>> stage_output(int ctx_idx) noexcept override {
+        busy.fetch_sub(1);
+        return idet::Result<std::vector<idet::algo::Detection>>::Ok(box(widths_[(std::size_t)ctx_idx]));
+    }
+
+    static constexpr int kFailWidth = 13;
+
+    std::atomic<int> busy{0};
+    std::atomic<int> peak_busy{0};
+
+  private:
+    static std::vector<idet::algo::Detection> box(int w) {
+        idet::algo::Detection d;
+        d.score = 1.f;
+        d.pts[0] = {0.f, 0.f};
+        d.pts[1] = {float(w), 0.f};
+        d.pts[2] = {float(w), 1.f};
+        d.pts[3] = {0.f, 1.f};
+        return {d};
+    }
+
+    bool staged_ = true;
+    std::vector<int> widths_;
+};
+
+// Engine for tiled runs: one box per tile, optional slow tile, per-context overlap detection.
+class TiledEngine final : public idet::engine::IEngine {
+  public:
+    explicit TiledEngine(const idet::DetectorConfig& cfg) : IEngine(cfg, "tiled") {}
+
+    idet::EngineKind kind() const noexcept override {
+        return cfg_.engine;
+    }
+    idet::Task task() const noexcept override {
+        return cfg_.task;
+    }
+
+    idet::Status update_hot(const idet::DetectorConfig&) noexcept override {
+        return idet::Status::Ok();
+    }
+
+    idet::Status setup_binding(int w, int h, int contexts, int batch) noexcept override {
+        binding_ready_ = true;
+        bound_w_ = w;
+        bound_h_ = h;
+        contexts_ = (contexts > 0) ? contexts : 1;
+        batch_ = (batch > 0) ? batch : 1;
+        return idet::Status::Ok();
+    }
+
+    void unset_binding() noexcept override {
+        binding_ready_ = false;
+        contexts_ = 0;
+    }
+
+    idet::Result<std::vector<idet::algo::Detection>> infer_unbound(const cv::Mat& bgr) noexcept override {
+        return run(bgr);
+    }
+
+    idet::Result<std::vector<idet::algo::Detection>> infer_bound(const cv::Mat& bgr, int ctx_idx) noexcept override {
+        if (ctx_idx < 0 || ctx_idx >= 8) return idet::Result<std::vector<idet::algo::Detection>>::Err(
+                                                 idet::Status::Invalid("bad ctx"));
+        if (ctx_busy[ctx_idx].fetch_add(1) != 0) ctx_shared.store(true);
+        auto r = run(bgr);
+        ctx_busy[ctx_idx].fetch_sub(1);
+        return r;
+    }
+
+    /// Tile whose ROI starts at this address sleeps (the top-left tile of that image).
+    const std::uint8_t* slow_origin = nullptr;
+
+    std::atomic<int> ctx_busy[8] = {};
+    std::atomic<bool> ctx_shared{false};
+
+    /// Tiles decoded on a thread that would allow a nested postprocessing team.
+    std::atomic<int> fanout_tiles{0};
+
+    /// Start/end events in global order: {width, +1 start / -1 end}.
+    std::mutex log_mu;
+    std::vector<std::pair<int, int>> log;
+
+  private:
+    idet::Result<std::vector<idet::algo::Detection>> run(const cv::Mat& bgr) {
+        const bool slow = (bgr.data == slow_origin);
+        if (!serial_postprocess()) fanout_tiles.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lk(log_mu);
+            log.emplace_back(bgr.cols, slow ? +2 : +1);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(slow ? 60 : 2));
+        {
+            std::lock_guard<std::mutex> lk(log_mu);
+            log.emplace_back(bgr.cols, slow ? -2 : -1);
+        }
+        idet::algo::Detection d;
+        d.score = 1.f;
+        d.pts[0] = {0.f, 0.f};
+        d.pts[1] = {float(bgr.cols), 0.f};
+        d.pts[2] = {float(bgr.cols), float(bgr.rows)};
+        d.pts[3] = {0.f, float(bgr.rows)};
+        return idet::Result<std::vector<idet::algo::Detection>>::Ok({d});
+    }
+};
+
+static idet::GridSpec grid(int cols, int rows) {
+    idet::GridSpec g{};
+    g.cols = cols;
+    g.rows = rows;
+    return g;
+}
+
+static idet::Image make_image(int w, int h) {
+    std::vector<std::uint8_t> px((std::size_t)w * (std::size_t)h * 3, 128);
+    auto r = idet::Image::copy_from(idet::PixelFormat::BGR_U8, w, h, px.data(), (std::size_t)w * 3);
+    return r.ok() ? r.value() : idet::Image{};
+}
+
+static idet::VecQuad to_quads(std::vector<idet::algo::Detection> dets) {
+    idet::VecQuad out;
+    for (const auto& d : dets) {
+        idet::Quad q{};
+        for (int i = 0; i < 4; ++i)
+            q[i] = {d.pts[i].x, d.pts[i].y};
+        out.push_back(q);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(AsyncPipeline, StagedFramesCompleteInOrderAndOverlap) {
+    idet::DetectorConfig cfg;
+    StagedEngine eng(cfg, /*staged=*/true);
+    ASSERT_TRUE(eng.setup_binding(64, 64, 3, 1).ok());
+
+    std::atomic<int> fallback_calls{0};
+    idet::pipeline::AsyncPipeline pipe(eng, /*staged=*/true, eng.bound_contexts(), to_quads,
+                                       [&](const idet::Image&) {
+                                           fallback_calls.fetch_add(1);
+                                           return idet::Result<idet::VecQuad>::Err(idet::Status::Internal("unused"));
+                                       });
+
+    std::vector<idet::Ticket> tickets;
+    for (int i = 0; i < 12; ++i) {
+        auto t = pipe.submit(make_image(20 + i, 8));
+        ASSERT_TRUE(t.ok());
+        tickets.push_back(t.value());
+        EXPECT_LE(pipe.in_flight(), (std::size_t)pipe.depth());
+    }
+
+    for (int i = 0; i < 12; ++i) {
+        auto r = pipe.wait(tickets[(std::size_t)i]);
+        ASSERT_TRUE(r.ok()) << r.status().message;
+        ASSERT_EQ(r.value().size(), 1u);
+        EXPECT_FLOAT_EQ(r.value()[0][1].x, float(20 + i));
+    }
+
+    EXPECT_EQ(fallback_calls.load(), 0);
+    EXPECT_GT(eng.peak_busy.load(), 1) << "no stage overlap observed";
+    EXPECT_LE(eng.peak_busy.load(), 3);
+    EXPECT_TRUE(pipe.idle());
+}
+
+TEST(AsyncPipeline, ErrorsAndTicketsAreReportedPerFrame) {
+    idet::DetectorConfig cfg;
+    StagedEngine eng(cfg, /*staged=*/true);
+    ASSERT_TRUE(eng.setup_binding(64, 64, 2, 1).ok());
+
+    idet::pipeline::AsyncPipeline pipe(eng, /*staged=*/true, 2, to_quads, [](const idet::Image&) {
+        return idet::Result<idet::VecQuad>::Err(idet::Status::Internal("unused"));
+    });
+
+    auto bad = pipe.submit(make_image(StagedEngine::kFailWidth, 4));
+    auto good = pipe.submit(make_image(32, 4));
+    ASSERT_TRUE(bad.ok());
+    ASSERT_TRUE(good.ok());
+
+    auto rb = pipe.wait(bad.value());
+    EXPECT_FALSE(rb.ok());
+    EXPECT_EQ(rb.status().code, idet::Status::Code::DecodeError);
+
+    auto rg = pipe.wait(good.value());
+    ASSERT_TRUE(rg.ok());
+    EXPECT_TRUE(pipe.ready(good.value()) == false);
+
+    // consumed / never issued tickets
+    EXPECT_FALSE(pipe.wait(good.value()).ok());
+    EXPECT_FALSE(pipe.wait(9999).ok());
+    EXPECT_FALSE(pipe.submit(idet::Image{}).ok());
+}
+
+TEST(AsyncPipeline, FallbackModeRunsFullDetection) {
+    idet::DetectorConfig cfg;
+    StagedEngine eng(cfg, /*staged=*/false);
+
+    std::atomic<int> fallback_calls{0};
+    idet::pipeline::AsyncPipeline pipe(eng, /*staged=*/false, 2, to_quads, [&](const idet::Image& img) {
+        fallback_calls.fetch_add(1);
+        idet::VecQuad q(1);
+        q[0][1].x = float(img.view().width);
+        return idet::Result<idet::VecQuad>::Ok(q);
+    });
+
+    std::vector<idet::Ticket> tickets;
+    for (int i = 0; i < 5; ++i) {
+        auto t = pipe.submit(make_image(40 + i, 4));
+        ASSERT_TRUE(t.ok());
+        tickets.push_back(t.value());
+    }
+    pipe.drain();
+    EXPECT_EQ(pipe.in_flight(), 0u);
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(pipe.ready(tickets[(std::size_t)i]));
+        auto r = pipe.wait(tickets[(std::size_t)i]);
+        ASSERT_TRUE(r.ok());
+        EXPECT_FLOAT_EQ(r.value()[0][1].x, float(40 + i));
+    }
+    EXPECT_EQ(fallback_calls.load(), 5);
+}
+
+TEST(AsyncPipeline, TicketsContinueFromFirstTicket) {
+    idet::DetectorConfig cfg;
+    StagedEngine eng(cfg, /*staged=*/false);
+
+    idet::pipeline::AsyncPipeline pipe(
+        eng, /*staged=*/false, 2, to_quads,
+        [](const idet::Image&) { return idet::Result<idet::VecQuad>::Ok(idet::VecQuad{}); }, /*first_ticket=*/100);
+    EXPECT_EQ(pipe.next_ticket(), 100u);
+
+    auto a = pipe.submit(make_image(32, 4));
+    auto b = pipe.submit(make_image(32, 4));
+    ASSERT_TRUE(a.ok());
+    ASSERT_TRUE(b.ok());
+    EXPECT_EQ(a.value(), 100u);
+    EXPECT_EQ(b.value(), 101u);
+    EXPECT_EQ(pipe.next_ticket(), 102u);
+    EXPECT_TRUE(pipe.wait(a.value()).ok());
+    EXPECT_TRUE(pipe.wait(b.value()).ok());
+}
+
+TEST(TileScheduler, MergesInTileOrderAndReportsTimings) {
+    idet::DetectorConfig cfg;
+    TiledEngine eng(cfg);
+    idet::pipeline::TileScheduler sched(eng, /*bound=*/false, /*workers=*/3, /*depth=*/2);
+
+    auto t = sched.submit(make_image(80, 60), grid(2, 2), 0.0f);
+    ASSERT_TRUE(t.ok());
+    auto r = sched.wait(t.value());
+    ASSERT_TRUE(r.ok()) << r.status().message;
+
+    const auto& dets = r.value().dets;
+    ASSERT_EQ(dets.size(), 4u);
+    const float ox[4] = {0.f, 40.f, 0.f, 40.f};
+    const float oy[4] = {0.f, 0.f, 30.f, 30.f};
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(dets[(std::size_t)i].tile, i);
+        EXPECT_FLOAT_EQ(dets[(std::size_t)i].pts[0].x, ox[i]);
+        EXPECT_FLOAT_EQ(dets[(std::size_t)i].pts[0].y, oy[i]);
+    }
+
+    const auto& tt = r.value().timings;
+    ASSERT_EQ(tt.size(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(tt[(std::size_t)i].tile, i);
+        EXPECT_EQ(tt[(std::size_t)i].context, -1);
+        EXPECT_GE(tt[(std::size_t)i].worker, 0);
+        EXPECT_LT(tt[(std::size_t)i].worker, 3);
+        EXPECT_GT(tt[(std::size_t)i].ms, 0.0);
+    }
+
+    EXPECT_EQ(eng.fanout_tiles.load(), 0) << "tile workers must decode serially";
+    EXPECT_FALSE(idet::engine::IEngine::serial_postprocess());
+
+    EXPECT_FALSE(sched.wait(t.value()).ok());
+    EXPECT_TRUE(sched.idle());
+}
+
+TEST(TileScheduler, NextFrameTilesRunWhileSlowTileIsBusy) {
+    idet::DetectorConfig cfg;
+    TiledEngine eng(cfg);
+    idet::pipeline::TileScheduler sched(eng, /*bound=*/false, /*workers=*/2, /*depth=*/2);
+
+    idet::Image a = make_image(80, 40); // tiles 40 px wide
+    idet::Image b = make_image(96, 40); // tiles 48 px wide
+    eng.slow_origin = a.view().data;
+
+    auto ta = sched.submit(a, grid(2, 1), 0.0f);
+    auto tb = sched.submit(b, grid(2, 1), 0.0f);
+    ASSERT_TRUE(ta.ok());
+    ASSERT_TRUE(tb.ok());
+    ASSERT_TRUE(sched.wait(ta.value()).ok());
+    ASSERT_TRUE(sched.wait(tb.value()).ok());
+
+    // Some tile of frame B must start before the slow tile of frame A ends.
+    bool b_started = false, interleaved = false;
+    for (const auto& e : eng.log) {
+        if (e.first == 48 && e.second == +1) b_started = true;
+        if (e.second == -2) {
+            interleaved = b_started;
+            break;
+        }
+    }
+    EXPECT_TRUE(interleaved);
+}
+
+TEST(TileScheduler, BoundTilesNeverShareAContext) {
+    idet::DetectorConfig cfg;
+    TiledEngine eng(cfg);
+    ASSERT_TRUE(eng.setup_binding(64, 64, 2, 1).ok());
+
+    // More workers than contexts: workers wait for a free context instead of sharing one.
+    idet::pipeline::TileScheduler sched(eng, /*bound=*/true, /*workers=*/4, /*depth=*/2);
+    EXPECT_EQ(sched.contexts(), 2);
+
+    std::vector<idet::pipeline::TileScheduler::Ticket> tickets;
+    for (int i = 0; i < 4; ++i) {
+        auto t = sched.submit(make_image(64 + 4 * i, 32), grid(4, 2), 0.1f);
+        ASSERT_TRUE(t.ok());
+        tickets.push_back(t.value());
+    }
+    for (auto t : tickets) {
+        auto r = sched.wait(t);
+        ASSERT_TRUE(r.ok()) << r.status().message;
+        EXPECT_EQ(r.value().dets.size(), 8u);
+        for (const auto& tt : r.value().timings) {
+            EXPECT_GE(tt.context, 0);
+            EXPECT_LT(tt.context, 2);
+        }
+    }
+    EXPECT_FALSE(eng.ctx_shared.load());
+}
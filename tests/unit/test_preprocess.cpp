@@ -0,0 +1,249 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "algo/preprocess.h"
+#include "internal/chw_preprocess.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+static cv::Mat make_pattern(int w, int h, unsigned seed) {
+    cv::Mat m(h, w, CV_8UC3);
+    std::uint32_t s = seed;
+    for (int y = 0; y < h; ++y) {
+        auto* p = m.ptr<std::uint8_t>(y);
+        for (int x = 0; x < w; ++x) {
+            // smooth gradient + LCG noise, so both flat and high-frequency regions are covered
+            s = s * 1664525u + 1013904223u;
+            p[3 * x + 0] = (std::uint8_t)((x * 255) / std::max(1, w - 1));
+            p[3 * x + 1] = (std::uint8_t)((y * 255) / std::max(1, h - 1));
+            p[3 * x + 2] = (std::uint8_t)(s >> 24);
+        }
+    }
+    return m;
+}
+
+static std::vector<float> reference_chw(const cv::Mat& bgr, int dw, int dh, const float mean[3],
+                                        const float inv_std[3]) {
+    std::vector<float> out((std::size_t)3 * dw * dh);
+    idet::internal::bgr_u8_to_chw_f32_resize(bgr, dw, dh, out.data(), mean, inv_std);
+    return out;
+}
+
+static float max_abs_diff(const std::vector<float>& a, const std::vector<float>& b) {
+    float m = 0.f;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        m = std::max(m, std::fabs(a[i] - b[i]));
+    return m;
+}
+
+static const idet::algo::SimdLevel kLevels[] = {
+    idet::algo::SimdLevel::Scalar,
+    idet::algo::SimdLevel::NEON,
+    idet::algo::SimdLevel::AVX2,
+    idet::algo::SimdLevel::AVX512,
+};
+
+} // namespace
+
+TEST(Preprocess, FusedResizeMatchesOpenCVWithinOneLevel) {
+    // ImageNet constants (BGR), same as DBNet
+    const float mean[3] = {0.406f * 255.0f, 0.456f * 255.0f, 0.485f * 255.0f};
+    const float inv_std[3] = {1.0f / (0.225f * 255.0f), 1.0f / (0.224f * 255.0f), 1.0f / (0.229f * 255.0f)};
+    const float tol = *std::max_element(inv_std, inv_std + 3); // one u8 intensity level
+
+    struct Case {
+        int sw, sh, dw, dh;
+    };
+    const Case cases[] = {
+        {640, 480, 320, 256}, // downscale, non-integer
+        {200, 100, 480, 224}, // upscale
+        {301, 157, 301, 157}, // identity
+        {128, 128, 64, 64},   // exact 2x (OpenCV switches to INTER_AREA)
+        {97, 33, 37, 91},     // mixed + odd widths (SIMD tails)
+    };
+
+    for (const auto& c : cases) {
+        const cv::Mat img = make_pattern(c.sw, c.sh, 12345u + (unsigned)c.sw);
+        const auto ref = reference_chw(img, c.dw, c.dh, mean, inv_std);
+
+        for (auto lvl : kLevels) {
+            if (!idet::algo::simd_level_supported(lvl)) continue;
+            SCOPED_TRACE(idet::algo::simd_level_name(lvl));
+
+            std::vector<float> got((std::size_t)3 * c.dw * c.dh, -1e9f);
+            idet::algo::ResizeChwWorkspace ws;
+            idet::algo::resize_bgr_to_chw(img, c.dw, c.dh, got.data(), mean, inv_std, ws, lvl);
+            EXPECT_LE(max_abs_diff(got, ref), tol) << c.sw << "x" << c.sh << " -> " << c.dw << "x" << c.dh;
+        }
+    }
+}
+
+TEST(Preprocess, WorkspaceReuseAndRoiInput) {
+    const float mean[3] = {127.5f, 127.5f, 127.5f};
+    const float inv_std[3] = {1.0f / 128.0f, 1.0f / 128.0f, 1.0f / 128.0f};
+
+    const cv::Mat big = make_pattern(300, 200, 7u);
+    const cv::Mat roi = big(cv::Rect(13, 9, 150, 120)); // non-continuous rows
+
+    idet::algo::ResizeChwWorkspace ws;
+    std::vector<float> a((std::size_t)3 * 96 * 64), b(a.size());
+
+    idet::algo::resize_bgr_to_chw(roi, 96, 64, a.data(), mean, inv_std, ws);
+    idet::algo::resize_bgr_to_chw(big, 96, 64, b.data(), mean, inv_std, ws); // different geometry
+    idet::algo::resize_bgr_to_chw(roi, 96, 64, b.data(), mean, inv_std, ws); // back: must not reuse stale rows
+
+    EXPECT_EQ(max_abs_diff(a, b), 0.f);
+    EXPECT_LE(max_abs_diff(a, reference_chw(roi, 96, 64, mean, inv_std)), inv_std[0]);
+}
+
+TEST(Preprocess, SameSizeSourceIsNormalizedExactly) {
+    const float mean[3] = {103.9f, 116.7f, 123.6f};
+    const float inv_std[3] = {1.0f / 57.4f, 1.0f / 57.1f, 1.0f / 58.4f};
+
+    const cv::Mat big = make_pattern(90, 70, 13u);
+    const cv::Mat roi = big(cv::Rect(5, 3, 64, 48)); // tile view, non-continuous rows
+
+    std::vector<float> out((std::size_t)3 * 64 * 48);
+    idet::algo::ResizeChwWorkspace ws;
+    idet::algo::resize_bgr_to_chw(roi, 64, 48, out.data(), mean, inv_std, ws);
+
+    for (int c = 0; c < 3; ++c) {
+        for (int y = 0; y < 48; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                const float want = (float)roi.ptr<std::uint8_t>(y)[3 * x + c] * inv_std[c] - mean[c] * inv_std[c];
+                ASSERT_NEAR(out[(std::size_t)c * 64 * 48 + (std::size_t)y * 64 + (std::size_t)x], want, 1e-5f)
+                    << "c=" << c << " x=" << x << " y=" << y;
+            }
+        }
+    }
+}
+
+TEST(Preprocess, CanvasResizeMatchesDenseAndPaddingIsFilled) {
+    const float mean[3] = {127.5f, 127.5f, 127.5f};
+    const float inv_std[3] = {1.0f / 128.0f, 1.0f / 128.0f, 1.0f / 128.0f};
+    const float pad[3] = {-1.f, -2.f, -3.f};
+
+    const cv::Mat img = make_pattern(160, 90, 3u);
+    const int dw = 96, dh = 54, cw = 128, ch = 64;
+
+    idet::algo::ResizeChwWorkspace ws;
+    std::vector<float> dense((std::size_t)3 * dw * dh);
+    idet::algo::resize_bgr_to_chw(img, dw, dh, dense.data(), mean, inv_std, ws);
+
+    std::vector<float> canvas((std::size_t)3 * cw * ch, 42.f);
+    idet::algo::resize_bgr_to_chw_canvas(img, dw, dh, canvas.data(), cw, ch, mean, inv_std, ws);
+    idet::algo::fill_chw_padding(canvas.data(), cw, ch, dw, dh, pad);
+
+    for (int c = 0; c < 3; ++c) {
+        for (int y = 0; y < ch; ++y) {
+            for (int x = 0; x < cw; ++x) {
+                const float v = canvas[((std::size_t)c * ch + y) * cw + x];
+                if (x < dw && y < dh)
+                    ASSERT_EQ(v, dense[((std::size_t)c * dh + y) * dw + x]) << "c=" << c << " y=" << y << " x=" << x;
+                else
+                    ASSERT_EQ(v, pad[c]) << "c=" << c << " y=" << y << " x=" << x;
+            }
+        }
+    }
+}
+
+TEST(Preprocess, Yuv420MatchesConvertThenResizeForAllLayouts) {
+    const float mean[3] = {127.5f, 127.5f, 127.5f};
+    const float inv_std[3] = {1.0f / 128.0f, 1.0f / 128.0f, 1.0f / 128.0f};
+    const int w = 158, h = 94, dw = 96, dh = 160;
+
+    // I420 reference buffer: Y, then U, then V (contiguous), with noise in every plane
+    std::vector<std::uint8_t> i420((std::size_t)w * h * 3 / 2);
+    std::uint32_t s = 99u;
+    for (std::size_t i = 0; i < i420.size(); ++i) {
+        s = s * 1664525u + 1013904223u;
+        i420[i] = (std::uint8_t)((i % 251) ^ (s >> 26));
+    }
+    const std::uint8_t* Y = i420.data();
+    const std::uint8_t* U = Y + (std::size_t)w * h;
+    const std::uint8_t* V = U + (std::size_t)(w / 2) * (h / 2);
+
+    std::vector<std::uint8_t> uv((std::size_t)w * (h / 2)), vu(uv.size());
+    for (std::size_t i = 0; i < (std::size_t)(w / 2) * (h / 2); ++i) {
+        uv[2 * i] = vu[2 * i + 1] = U[i];
+        uv[2 * i + 1] = vu[2 * i] = V[i];
+    }
+
+    cv::Mat bgr;
+    cv::cvtColor(cv::Mat(h * 3 / 2, w, CV_8UC1, i420.data()), bgr, cv::COLOR_YUV2BGR_I420);
+    idet::algo::ResizeChwWorkspace ws;
+    std::vector<float> ref((std::size_t)3 * dw * dh);
+    idet::algo::resize_bgr_to_chw(bgr, dw, dh, ref.data(), mean, inv_std, ws);
+
+    idet::algo::Yuv420Planes planar{w, h, Y, (std::size_t)w, U, (std::size_t)w / 2, V, (std::size_t)w / 2, 1};
+    idet::algo::Yuv420Planes nv12{w, h, Y, (std::size_t)w, uv.data(), (std::size_t)w, uv.data() + 1, (std::size_t)w, 2};
+    idet::algo::Yuv420Planes nv21{w, h, Y, (std::size_t)w, vu.data() + 1, (std::size_t)w, vu.data(), (std::size_t)w, 2};
+
+    std::vector<float> got_i420(ref.size()), got(ref.size());
+    idet::algo::resize_yuv420_to_chw(planar, dw, dh, got_i420.data(), mean, inv_std, ws);
+    EXPECT_LE(max_abs_diff(got_i420, ref), inv_std[0]);
+
+    for (const auto* f : {&nv12, &nv21}) {
+        for (auto lvl : kLevels) {
+            if (!idet::algo::simd_level_supported(lvl)) continue;
+            SCOPED_TRACE(idet::algo::simd_level_name(lvl));
+            std::fill(got.begin(), got.end(), -1e9f);
+            idet::algo::resize_yuv420_to_chw(*f, dw, dh, got.data(), mean, inv_std, ws, lvl);
+            EXPECT_LE(max_abs_diff(got, got_i420), 1e-6f);
+        }
+    }
+
+    // Same workspace geometry but a BGR source afterwards: tables must be rebuilt for 3 bytes/pixel
+    std::vector<float> again(ref.size());
+    idet::algo::resize_to_chw(idet::algo::ChwSource::of(bgr), dw, dh, again.data(), mean, inv_std, &ws);
+    EXPECT_EQ(max_abs_diff(again, ref), 0.f);
+}
+
+TEST(Preprocess, PackedChannelOrdersMatchBgrWithoutConversion) {
+    const float mean[3] = {0.406f * 255.f, 0.456f * 255.f, 0.485f * 255.f};
+    const float inv_std[3] = {1.f / (0.225f * 255.f), 1.f / (0.224f * 255.f), 1.f / (0.229f * 255.f)};
+    const int dw = 128, dh = 72;
+    const cv::Mat bgr = make_pattern(203, 117, 5u);
+
+    cv::Mat rgb, bgra, rgba;
+    cv::cvtColor(bgr, rgb, cv::COLOR_BGR2RGB);
+    cv::cvtColor(bgr, bgra, cv::COLOR_BGR2BGRA);
+    cv::cvtColor(bgr, rgba, cv::COLOR_BGR2RGBA);
+
+    using idet::algo::ChannelOrder;
+    const std::pair<const cv::Mat*, ChannelOrder> inputs[] = {
+        {&rgb, ChannelOrder::RGB}, {&bgra, ChannelOrder::BGRA}, {&rgba, ChannelOrder::RGBA}, {&bgr, ChannelOrder::BGR}};
+
+    idet::algo::ResizeChwWorkspace ws;
+    std::vector<float> ref((std::size_t)3 * dw * dh), got(ref.size());
+    for (auto lvl : kLevels) {
+        if (!idet::algo::simd_level_supported(lvl)) continue;
+        SCOPED_TRACE(idet::algo::simd_level_name(lvl));
+        idet::algo::resize_bgr_to_chw(bgr, dw, dh, ref.data(), mean, inv_std, ws, lvl);
+        for (const auto& in : inputs) {
+            std::fill(got.begin(), got.end(), -1e9f);
+            idet::algo::resize_packed_to_chw_canvas(*in.first, in.second, dw, dh, got.data(), dw, dh, mean, inv_std,
+                                                    ws, lvl);
+            EXPECT_EQ(max_abs_diff(got, ref), 0.f) << "order " << (int)in.second;
+        }
+    }
+
+    // Mismatched Mat type for the declared order is rejected (output untouched)
+    std::fill(got.begin(), got.end(), -1e9f);
+    EXPECT_FALSE(idet::algo::ChwSource::of(bgr, ChannelOrder::RGBA).valid());
+    idet::algo::resize_to_chw(idet::algo::ChwSource::of(bgr, ChannelOrder::RGBA), dw, dh, got.data(), mean, inv_std,
+                              &ws);
+    EXPECT_EQ(got[0], -1e9f);
+}
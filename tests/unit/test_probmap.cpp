@@ -0,0 +1,297 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "algo/geometry.h"
+#include "algo/probmap.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+static float sigmoid(float x) {
+    return 1.0f / (1.0f + std::exp(-x));
+}
+
+static std::vector<float> random_logits(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> u(-8.f, 8.f);
+    std::vector<float> v(n);
+    for (auto& x : v)
+        x = u(rng);
+    return v;
+}
+
+} // namespace
+
+TEST(ProbMap, LogitThresholdEdgesAndMidpoint) {
+    EXPECT_FLOAT_EQ(idet::algo::logit_threshold(0.5f), 0.0f);
+    EXPECT_NEAR(idet::algo::logit_threshold(0.3f), std::log(0.3f / 0.7f), 1e-6f);
+    EXPECT_TRUE(std::isinf(idet::algo::logit_threshold(0.0f)) && idet::algo::logit_threshold(0.0f) < 0.f);
+    EXPECT_TRUE(std::isinf(idet::algo::logit_threshold(1.0f)) && idet::algo::logit_threshold(1.0f) > 0.f);
+    EXPECT_TRUE(idet::algo::logit_threshold(std::numeric_limits<float>::quiet_NaN()) < 0.f);
+}
+
+TEST(ProbMap, BinarizeRowAllLevelsMatchScalar) {
+    const float thr = 0.25f;
+    for (int n : {1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 257}) {
+        auto src = random_logits((std::size_t)n, 11u + (unsigned)n);
+        for (float& x : src)
+            x *= 0.1f;
+        src[0] = thr;                                                      // equal -> 0
+        src[(std::size_t)n / 2] = std::numeric_limits<float>::quiet_NaN(); // NaN -> 0
+
+        std::vector<std::uint8_t> ref((std::size_t)n);
+        for (int i = 0; i < n; ++i)
+            ref[(std::size_t)i] = (src[(std::size_t)i] > thr) ? 255 : 0;
+
+        for (auto level : {idet::algo::SimdLevel::Scalar, idet::algo::SimdLevel::NEON, idet::algo::SimdLevel::AVX2,
+                           idet::algo::SimdLevel::AVX512}) {
+            if (!idet::algo::simd_level_supported(level)) continue;
+            std::vector<std::uint8_t> out((std::size_t)n + 1, 0xAB);
+            idet::algo::binarize_row(src.data(), out.data(), n, thr, level);
+            for (int i = 0; i < n; ++i)
+                ASSERT_EQ(out[(std::size_t)i], ref[(std::size_t)i])
+                    << "level=" << idet::algo::simd_level_name(level) << " n=" << n << " i=" << i;
+            EXPECT_EQ(out[(std::size_t)n], 0xAB) << "wrote past the end";
+        }
+    }
+}
+
+TEST(ProbMap, SelectGeAllLevelsMatchScalar) {
+    const float thr = 0.5f;
+    for (int n : {1, 7, 8, 9, 15, 16, 17, 33, 257}) {
+        auto src = random_logits((std::size_t)n, 23u + (unsigned)n);
+        src[0] = thr;                                                      // equal -> selected
+        src[(std::size_t)n / 2] = std::numeric_limits<float>::quiet_NaN(); // NaN -> skipped
+        if (n > 1) src[(std::size_t)n - 1] = 100.f;                         // last lane of the tail
+
+        std::vector<int> ref;
+        for (int i = 0; i < n; ++i)
+            if (src[(std::size_t)i] >= thr) ref.push_back(i);
+
+        for (auto level : {idet::algo::SimdLevel::Scalar, idet::algo::SimdLevel::NEON, idet::algo::SimdLevel::AVX2,
+                           idet::algo::SimdLevel::AVX512}) {
+            if (!idet::algo::simd_level_supported(level)) continue;
+            std::vector<int> idx((std::size_t)n, -1);
+            const int k = idet::algo::select_ge(src.data(), n, thr, idx.data(), level);
+            idx.resize((std::size_t)k);
+            EXPECT_EQ(idx, ref) << "level=" << idet::algo::simd_level_name(level) << " n=" << n;
+        }
+    }
+}
+
+TEST(ProbMap, LogitSpaceThresholdMatchesSigmoidThreshold) {
+    const auto logits = random_logits(4096, 7u);
+    for (float t : {0.05f, 0.3f, 0.5f, 0.7f, 0.95f}) {
+        const float lt = idet::algo::logit_threshold(t);
+        std::vector<std::uint8_t> mask(logits.size());
+        idet::algo::binarize_row(logits.data(), mask.data(), (int)logits.size(), lt);
+        for (std::size_t i = 0; i < logits.size(); ++i) {
+            const float p = sigmoid(logits[i]);
+            if (std::fabs(p - t) < 1e-6f) continue; // rounding of the sigmoid at the threshold
+            EXPECT_EQ(mask[i] != 0, p > t) << "t=" << t << " x=" << logits[i];
+        }
+    }
+}
+
+TEST(ProbMap, BinarizeMapReusesMask) {
+    const int w = 37, h = 5;
+    const auto logits = random_logits((std::size_t)w * h, 3u);
+
+    cv::Mat mask;
+    idet::algo::binarize(logits.data(), w, h, 0.0f, mask);
+    ASSERT_EQ(mask.rows, h);
+    ASSERT_EQ(mask.cols, w);
+    ASSERT_EQ(mask.type(), CV_8U);
+    const std::uint8_t* first = mask.data;
+
+    idet::algo::binarize(logits.data(), w, h, 0.0f, mask);
+    EXPECT_EQ(mask.data, first);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            EXPECT_EQ(mask.at<std::uint8_t>(y, x) != 0, logits[(std::size_t)y * w + x] > 0.0f);
+}
+
+TEST(ProbMap, ContourScoreSigmoidMatchesActivatedMap) {
+    const int w = 24, h = 16;
+    auto logits = random_logits((std::size_t)w * h, 5u);
+    cv::Mat lmap(h, w, CV_32F, logits.data());
+
+    cv::Mat pmap(h, w, CV_32F);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            pmap.at<float>(y, x) = sigmoid(lmap.at<float>(y, x));
+
+    const std::vector<cv::Point> contour = {{3, 2}, {18, 4}, {16, 12}, {2, 10}};
+    EXPECT_NEAR(idet::algo::contour_score_sigmoid(lmap, contour), idet::algo::contour_score(pmap, contour), 1e-5f);
+    EXPECT_FLOAT_EQ(idet::algo::contour_score_sigmoid(lmap, {}), 0.0f);
+}
+
+TEST(ProbMap, BinarizeRowReportsForeground) {
+    for (int n : {1, 15, 16, 17, 33, 65}) {
+        std::vector<float> src((std::size_t)n, 0.0f);
+        std::vector<std::uint8_t> out((std::size_t)n);
+        for (auto level : {idet::algo::SimdLevel::Scalar, idet::algo::SimdLevel::NEON, idet::algo::SimdLevel::AVX2,
+                           idet::algo::SimdLevel::AVX512}) {
+            if (!idet::algo::simd_level_supported(level)) continue;
+            src.assign((std::size_t)n, 0.0f);
+            EXPECT_FALSE(idet::algo::binarize_row(src.data(), out.data(), n, 0.5f, level)) << "n=" << n;
+            for (int at : {0, n / 2, n - 1}) {
+                src.assign((std::size_t)n, 0.0f);
+                src[(std::size_t)at] = 1.0f;
+                EXPECT_TRUE(idet::algo::binarize_row(src.data(), out.data(), n, 0.5f, level))
+                    << "n=" << n << " at=" << at;
+            }
+        }
+    }
+}
+
+TEST(ProbMap, SparseContoursMatchFullScan) {
+    const int w = 96, h = 64;
+    cv::Mat map(h, w, CV_32F, cv::Scalar(0.0f));
+    // Separated blobs, one with a hole, two only separated diagonally, one on the border.
+    cv::rectangle(map, cv::Rect(4, 4, 10, 6), cv::Scalar(1.0f), cv::FILLED);
+    cv::rectangle(map, cv::Rect(40, 6, 20, 12), cv::Scalar(1.0f), cv::FILLED);
+    cv::rectangle(map, cv::Rect(45, 9, 6, 4), cv::Scalar(0.0f), cv::FILLED);
+    cv::rectangle(map, cv::Rect(10, 40, 5, 5), cv::Scalar(1.0f), cv::FILLED);
+    cv::rectangle(map, cv::Rect(15, 45, 5, 5), cv::Scalar(1.0f), cv::FILLED);
+    cv::rectangle(map, cv::Rect(80, 50, 16, 14), cv::Scalar(1.0f), cv::FILLED);
+
+    cv::Mat mask;
+    std::vector<std::uint8_t> rows;
+    idet::algo::binarize(map, 0.5f, mask, rows);
+    ASSERT_EQ(rows.size(), (std::size_t)h);
+    EXPECT_EQ(rows[0], 0u);
+    EXPECT_EQ(rows[5], 1u);
+
+    std::vector<cv::Rect> regions;
+    std::vector<std::uint8_t> cols;
+    idet::algo::active_regions(mask, rows, 1, regions, cols);
+    EXPECT_EQ(regions.size(), 4u); // the diagonal pair shares a region
+    int inside = 0;
+    for (const cv::Rect& r : regions)
+        inside += cv::countNonZero(mask(r));
+    EXPECT_EQ(inside, cv::countNonZero(mask));
+
+    std::vector<std::vector<cv::Point>> full;
+    cv::findContours(mask, full, cv::RETR_LIST, cv::CHAIN_APPROX_SIMPLE);
+    std::vector<std::vector<cv::Point>> sparse;
+    idet::algo::ContourScratch scratch;
+    idet::algo::find_contours_sparse(mask, rows, sparse, scratch);
+
+    // Contours start at their first pixel in raster order, so the start point (and length) orders them.
+    auto by_start = [](const std::vector<cv::Point>& a, const std::vector<cv::Point>& b) {
+        const auto ka = std::make_tuple(a.front().y, a.front().x, a.size());
+        const auto kb = std::make_tuple(b.front().y, b.front().x, b.size());
+        return ka < kb;
+    };
+    std::sort(full.begin(), full.end(), by_start);
+    std::sort(sparse.begin(), sparse.end(), by_start);
+    EXPECT_EQ(sparse, full);
+}
+
+TEST(ProbMap, PoolMapAllLevelsMatchScalar) {
+    for (int w : {2, 3, 9, 16, 17, 33, 66}) {
+        const int h = 5; // odd: the last row is dropped
+        auto v = random_logits((std::size_t)(w * h), 7u + (unsigned)w);
+        const cv::Mat src(h, w, CV_32F, v.data());
+
+        for (bool average : {false, true}) {
+            cv::Mat ref(h / 2, w / 2, CV_32F);
+            for (int y = 0; y < ref.rows; ++y) {
+                for (int x = 0; x < ref.cols; ++x) {
+                    const float a = src.at<float>(2 * y, 2 * x), b = src.at<float>(2 * y, 2 * x + 1);
+                    const float c = src.at<float>(2 * y + 1, 2 * x), d = src.at<float>(2 * y + 1, 2 * x + 1);
+                    ref.at<float>(y, x) = average ? 0.25f * (a + b + c + d) : std::max(std::max(a, b), std::max(c, d));
+                }
+            }
+
+            for (auto level : {idet::algo::SimdLevel::Scalar, idet::algo::SimdLevel::NEON,
+                               idet::algo::SimdLevel::AVX2, idet::algo::SimdLevel::AVX512}) {
+                if (!idet::algo::simd_level_supported(level)) continue;
+                cv::Mat dst;
+                idet::algo::pool_map(src, dst, average, level);
+                ASSERT_EQ(dst.rows, ref.rows);
+                ASSERT_EQ(dst.cols, ref.cols);
+                for (int y = 0; y < ref.rows; ++y)
+                    for (int x = 0; x < ref.cols; ++x)
+                        EXPECT_NEAR(dst.at<float>(y, x), ref.at<float>(y, x), 1e-5f)
+                            << "w=" << w << " avg=" << average << " level=" << (int)level << " at " << x << "," << y;
+            }
+        }
+    }
+}
+
+TEST(ProbMap, QuantizeU8AllLevelsMatchScalar) {
+    const int w = 77, h = 3;
+    auto v = random_logits((std::size_t)(w * h), 5u);
+    for (float& x : v)
+        x = x / 12.0f + 0.5f; // mostly in [0, 1], some out of range
+    v[3] = std::numeric_limits<float>::quiet_NaN();
+    v[4] = 1.0f;
+    v[5] = 0.0f;
+    const cv::Mat prob(h, w, CV_32F, v.data());
+
+    for (auto level : {idet::algo::SimdLevel::Scalar, idet::algo::SimdLevel::NEON, idet::algo::SimdLevel::AVX2,
+                       idet::algo::SimdLevel::AVX512}) {
+        if (!idet::algo::simd_level_supported(level)) continue;
+        cv::Mat q;
+        idet::algo::quantize_u8(prob, /*logits=*/false, {}, q, level);
+        ASSERT_EQ(q.type(), CV_8U);
+        for (int i = 0; i < w * h; ++i) {
+            const float p = v[(std::size_t)i];
+            const int ref = std::isnan(p) ? 0 : (int)std::lround(std::clamp(p, 0.0f, 1.0f) * 255.0f);
+            EXPECT_NEAR((int)q.at<std::uint8_t>(i / w, i % w), ref, 1) << "level=" << (int)level << " i=" << i;
+        }
+    }
+}
+
+TEST(ProbMap, QuantizeU8ActivatesOnlyActiveLogitRows) {
+    const int w = 19, h = 4;
+    auto v = random_logits((std::size_t)(w * h), 3u);
+    const cv::Mat logits(h, w, CV_32F, v.data());
+    const std::vector<std::uint8_t> rows = {0, 1, 0, 1};
+
+    cv::Mat q;
+    idet::algo::quantize_u8(logits, /*logits=*/true, rows, q);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            const int ref = rows[(std::size_t)y] ? (int)std::lround(sigmoid(logits.at<float>(y, x)) * 255.0f) : 0;
+            EXPECT_NEAR((int)q.at<std::uint8_t>(y, x), ref, 1) << x << "," << y;
+        }
+    }
+}
+
+TEST(ProbMap, U8ScoresMatchFloatScores) {
+    const int w = 40, h = 30;
+    auto v = random_logits((std::size_t)(w * h), 9u);
+    cv::Mat logits(h, w, CV_32F, v.data());
+    cv::Mat prob(h, w, CV_32F);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            prob.at<float>(y, x) = sigmoid(logits.at<float>(y, x));
+
+    cv::Mat q;
+    idet::algo::quantize_u8(prob, false, {}, q);
+    const std::vector<cv::Point> contour = {{4, 3}, {30, 5}, {33, 24}, {6, 20}};
+    const std::array<cv::Point2f, 4> quad = {cv::Point2f(4, 3), cv::Point2f(30, 5), cv::Point2f(33, 24),
+                                             cv::Point2f(6, 20)};
+
+    // Rounding error per pixel is at most 1/510.
+    EXPECT_NEAR(idet::algo::contour_score(q, contour), idet::algo::contour_score(prob, contour), 2e-3f);
+    EXPECT_NEAR(idet::algo::contour_score_scanline(q, contour), idet::algo::contour_score_scanline(prob, contour),
+                2e-3f);
+    EXPECT_NEAR(idet::algo::box_score(q, quad), idet::algo::box_score(logits, quad, true), 2e-3f);
+}
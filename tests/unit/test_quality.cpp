@@ -0,0 +1,80 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "algo/quality.h"
+
+namespace {
+
+using idet::algo::QualityController;
+using idet::algo::QualityParams;
+
+static QualityParams latency_params(double target_ms, int hold = 3) {
+    QualityParams p;
+    p.target_ms = target_ms;
+    p.recover = 0.8;
+    p.hold = hold;
+    return p;
+}
+
+static int feed(QualityController& q, double ms, int calls, const QualityParams& p, int queue = 0) {
+    int level = q.level();
+    for (int i = 0; i < calls; ++i)
+        level = q.observe(ms, queue, p);
+    return level;
+}
+
+} // namespace
+
+TEST(Quality, StepsDownAfterHoldAndStopsAtTheLastLevel) {
+    QualityController q;
+    q.reset({1.0, 0.5, 0.25});
+    const QualityParams p = latency_params(10.0);
+
+    EXPECT_EQ(feed(q, 20.0, 2, p), 0); // still holding
+    EXPECT_EQ(q.observe(20.0, 0, p), 1);
+    EXPECT_EQ(q.latency_ms(), 0.0); // measurement restarts at the new level
+
+    EXPECT_EQ(feed(q, 20.0, 3, p), 2);
+    EXPECT_EQ(feed(q, 20.0, 10, p), 2);
+}
+
+TEST(Quality, StepsUpOnlyWhenTheLevelAboveIsPredictedToFit) {
+    QualityController q;
+    q.reset({1.0, 0.5});
+    const QualityParams p = latency_params(10.0);
+    ASSERT_EQ(feed(q, 20.0, 3, p), 1);
+
+    // 6 ms here predicts 12 ms one level up: over the target, stay.
+    EXPECT_EQ(feed(q, 6.0, 20, p), 1);
+    // 4.5 ms predicts 9 ms, above 0.8 * 10: still no room.
+    EXPECT_EQ(feed(q, 4.5, 20, p), 1);
+    // Load dropped: 3 ms predicts 6 ms.
+    q.reset({1.0, 0.5});
+    ASSERT_EQ(feed(q, 20.0, 3, p), 1);
+    EXPECT_EQ(feed(q, 3.0, 3, p), 0);
+}
+
+TEST(Quality, QueueDepthAloneDrivesTheLevel) {
+    QualityController q;
+    q.reset({1.0, 0.5, 0.25});
+    QualityParams p;
+    p.max_queue = 4;
+    p.hold = 2;
+
+    // Asynchronous submissions carry no latency.
+    EXPECT_EQ(feed(q, -1.0, 2, p, /*queue=*/6), 1);
+    EXPECT_EQ(feed(q, -1.0, 2, p, 3), 1); // not short enough to step up
+    EXPECT_EQ(feed(q, -1.0, 2, p, 2), 0);
+}
+
+TEST(Quality, SingleLevelNeverMoves) {
+    QualityController q;
+    q.reset({});
+    EXPECT_EQ(q.levels(), 1);
+    EXPECT_EQ(feed(q, 100.0, 50, latency_params(1.0), 100), 0);
+}
@@ -0,0 +1,181 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "engine/capture.h"
+#include "engine/engine_factory.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+using idet::engine::CaptureFrame;
+using idet::engine::CaptureView;
+using idet::engine::CaptureWriter;
+
+static std::string temp_path(const char* tag) {
+    return std::string(::testing::TempDir()) + "idet_capture_" + tag + ".bin";
+}
+
+/// @brief One DBNet-style frame: a 64x64 plane with a bright 30x10 bar.
+static std::vector<float> text_plane() {
+    std::vector<float> p(64 * 64, 0.0f);
+    for (int y = 20; y < 30; ++y)
+        for (int x = 10; x < 40; ++x)
+            p[(std::size_t)(y * 64 + x)] = 0.9f;
+    return p;
+}
+
+static void write_text_capture(const std::string& path, int frames) {
+    auto w = CaptureWriter::open(path, idet::Task::Text);
+    ASSERT_TRUE(w.ok()) << w.status().message;
+    const std::vector<float> plane = text_plane();
+    const std::int64_t shape[2] = {64, 64};
+    const CaptureView v{"prob", shape, 2, plane.data()};
+    CaptureFrame g;
+    g.orig_w = g.orig_h = 64;
+    for (int i = 0; i < frames; ++i)
+        w.value()->append(g, &v, 1);
+    EXPECT_EQ(w.value()->frames(), (std::size_t)frames);
+}
+
+static idet::DetectorConfig replay_config(idet::Task task, const std::string& path) {
+    idet::DetectorConfig cfg;
+    cfg.task = task;
+    cfg.engine = idet::EngineKind::Replay;
+    cfg.model_path = path;
+    return cfg;
+}
+
+} // namespace
+
+TEST(Capture, RoundTripAndTruncatedTail) {
+    const std::string path = temp_path("roundtrip");
+    write_text_capture(path, 2);
+
+    auto r = idet::engine::read_capture(path);
+    ASSERT_TRUE(r.ok()) << r.status().message;
+    EXPECT_EQ(r.value().task, idet::Task::Text);
+    ASSERT_EQ(r.value().frames.size(), 2u);
+    const auto& t = r.value().frames[1].tensors;
+    ASSERT_EQ(t.size(), 1u);
+    EXPECT_EQ(t[0].name, "prob");
+    EXPECT_EQ(t[0].shape, (std::vector<std::int64_t>{64, 64}));
+    EXPECT_EQ(t[0].data, text_plane());
+
+    // A writer killed mid-frame leaves a partial tail, which is dropped.
+    std::vector<char> bytes;
+    {
+        std::ifstream f(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write(bytes.data(), (std::streamsize)bytes.size() - 100);
+    }
+    r = idet::engine::read_capture(path);
+    ASSERT_TRUE(r.ok()) << r.status().message;
+    EXPECT_EQ(r.value().frames.size(), 1u);
+    std::remove(path.c_str());
+}
+
+TEST(Capture, RejectsForeignFilesAndTaskMismatch) {
+    const std::string path = temp_path("foreign");
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f << "not a capture file";
+    }
+    auto r = idet::engine::read_capture(path);
+    ASSERT_FALSE(r.ok());
+    EXPECT_EQ(r.status().code, idet::Status::Code::DecodeError);
+
+    auto a = CaptureWriter::open(path, idet::Task::Face);
+    ASSERT_TRUE(a.ok());
+    auto b = CaptureWriter::open(path, idet::Task::Face);
+    ASSERT_TRUE(b.ok());
+    EXPECT_EQ(a.value().get(), b.value().get());
+    EXPECT_FALSE(CaptureWriter::open(path, idet::Task::Text).ok());
+    std::remove(path.c_str());
+}
+
+TEST(Replay, DecodesRecordedTextPlanes) {
+    const std::string path = temp_path("text");
+    write_text_capture(path, 2);
+
+    auto cfg = replay_config(idet::Task::Text, path);
+    cfg.infer.replay.loop = false;
+    auto e = idet::engine::create_engine(cfg);
+    ASSERT_TRUE(e.ok()) << e.status().message;
+    EXPECT_EQ(e.value()->kind(), idet::EngineKind::Replay);
+
+    const cv::Mat img(64, 64, CV_8UC3, cv::Scalar(0, 0, 0));
+    for (int i = 0; i < 2; ++i) {
+        auto r = e.value()->infer_unbound(img);
+        ASSERT_TRUE(r.ok()) << r.status().message;
+        ASSERT_EQ(r.value().size(), 1u);
+        float cx = 0.0f, cy = 0.0f;
+        for (const auto& p : r.value()[0].pts) {
+            cx += 0.25f * p.x;
+            cy += 0.25f * p.y;
+        }
+        EXPECT_NEAR(cx, 25.0f, 2.0f);
+        EXPECT_NEAR(cy, 25.0f, 2.0f);
+    }
+
+    // Without looping the capture runs out.
+    auto r = e.value()->infer_unbound(img);
+    ASSERT_FALSE(r.ok());
+    EXPECT_EQ(r.status().code, idet::Status::Code::Unavailable);
+    std::remove(path.c_str());
+}
+
+TEST(Replay, DecodesRecordedFaceHeads) {
+    const std::string path = temp_path("face");
+    {
+        // Stride-8 head of a 64x64 input in the flat layout: one face at map cell (x=3, y=2).
+        std::vector<float> score(64, 0.0f), bbox(64 * 4, 0.0f);
+        score[2 * 8 + 3] = 0.9f;
+        for (int k = 0; k < 4; ++k)
+            bbox[(std::size_t)(2 * 8 + 3) * 4 + (std::size_t)k] = 1.0f;
+        const std::int64_t sshape[3] = {1, 64, 1}, bshape[3] = {1, 64, 4};
+        const CaptureView v[2] = {{"score_8", sshape, 3, score.data()}, {"bbox_8", bshape, 3, bbox.data()}};
+
+        auto w = CaptureWriter::open(path, idet::Task::Face);
+        ASSERT_TRUE(w.ok()) << w.status().message;
+        CaptureFrame g;
+        g.orig_w = g.orig_h = 64;
+        g.in_w = g.in_h = 64;
+        w.value()->append(g, v, 2);
+    }
+
+    auto cfg = replay_config(idet::Task::Face, path);
+    cfg.infer.apply_sigmoid = false;
+    cfg.infer.box_thresh = 0.5f;
+    auto e = idet::engine::create_engine(cfg);
+    ASSERT_TRUE(e.ok()) << e.status().message;
+
+    // A face capture cannot serve a text detector.
+    EXPECT_FALSE(idet::engine::create_engine(replay_config(idet::Task::Text, path)).ok());
+
+    ASSERT_TRUE(e.value()->setup_binding(64, 64, 2, 1).ok());
+    std::vector<idet::algo::Detection> out;
+    const cv::Mat img(64, 64, CV_8UC3, cv::Scalar(0, 0, 0));
+    ASSERT_TRUE(e.value()->infer_bound_into(img, 1, out).ok());
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_NEAR(out[0].score, 0.9f, 1e-6f);
+    // Center (3.5, 2.5) * 8 = (28, 20), distances of one stride.
+    EXPECT_NEAR(out[0].pts[0].x, 20.0f, 1e-3f);
+    EXPECT_NEAR(out[0].pts[0].y, 12.0f, 1e-3f);
+    EXPECT_NEAR(out[0].pts[2].x, 36.0f, 1e-3f);
+    EXPECT_NEAR(out[0].pts[2].y, 28.0f, 1e-3f);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,122 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "engine/session_registry.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using idet::engine::SessionKey;
+using idet::engine::SessionRegistry;
+
+// Null sessions are enough: the registry never touches the session itself.
+static Ort::Session make_null() {
+    return Ort::Session(nullptr);
+}
+
+} // namespace
+
+TEST(SessionRegistry, SameKeySharesUntilLastRelease) {
+    SessionRegistry r;
+    const SessionKey k{42u, "intra=1;inter=1"};
+
+    int calls = 0;
+    auto make = [&] {
+        ++calls;
+        return make_null();
+    };
+
+    bool created = false;
+    auto a = r.acquire(k, make, &created);
+    EXPECT_TRUE(created);
+    auto b = r.acquire(k, make, &created);
+    EXPECT_FALSE(created);
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(r.live(), 1u);
+
+    a.reset();
+    b.reset();
+    EXPECT_EQ(r.live(), 0u);
+
+    auto c = r.acquire(k, make, &created);
+    EXPECT_TRUE(created);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(SessionRegistry, DifferentModelOrOptionsDoNotShare) {
+    SessionRegistry r;
+    auto a = r.acquire(SessionKey{1u, "intra=1"}, make_null);
+    auto b = r.acquire(SessionKey{2u, "intra=1"}, make_null);
+    auto c = r.acquire(SessionKey{1u, "intra=4"}, make_null);
+    EXPECT_NE(a.get(), b.get());
+    EXPECT_NE(a.get(), c.get());
+    EXPECT_EQ(r.live(), 3u);
+}
+
+TEST(SessionRegistry, FactoryFailureLeavesNoEntry) {
+    SessionRegistry r;
+    const SessionKey k{7u, ""};
+    EXPECT_THROW(r.acquire(k, []() -> Ort::Session { throw std::runtime_error("load failed"); }), std::runtime_error);
+    EXPECT_EQ(r.live(), 0u);
+
+    bool created = false;
+    auto s = r.acquire(k, make_null, &created);
+    EXPECT_TRUE(created);
+    EXPECT_TRUE(s != nullptr);
+}
+
+TEST(SessionRegistry, KeepAliveLivesAsLongAsTheSession) {
+    SessionRegistry r;
+    const SessionKey k{9u, ""};
+    auto mapping = std::make_shared<int>(1);
+    const std::weak_ptr<int> watch = mapping;
+
+    auto a = r.acquire(k, make_null, nullptr, std::move(mapping));
+    auto b = r.acquire(k, make_null, nullptr, std::make_shared<int>(2)); // hit: not retained
+    EXPECT_EQ(a.get(), b.get());
+
+    a.reset();
+    EXPECT_FALSE(watch.expired());
+    b.reset();
+    EXPECT_TRUE(watch.expired());
+
+    auto own = SessionRegistry::own(make_null(), std::make_shared<int>(3));
+    EXPECT_TRUE(own != nullptr);
+}
+
+TEST(SessionRegistry, DifferentKeysBuildConcurrently) {
+    SessionRegistry r;
+    std::atomic<bool> second_started{false};
+
+    // The first build only finishes early if the second one starts while it is still running.
+    bool overlapped = false;
+    std::thread a([&] {
+        r.acquire(SessionKey{1u, ""}, [&] {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!second_started.load() && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            overlapped = second_started.load();
+            return make_null();
+        });
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto b = r.acquire(SessionKey{2u, ""}, [&] {
+        second_started = true;
+        return make_null();
+    });
+    a.join();
+
+    EXPECT_TRUE(overlapped);
+    EXPECT_TRUE(b != nullptr);
+}
@@ -0,0 +1,113 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "engine/shape_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using idet::engine::ShapeCache;
+using idet::engine::ShapeKey;
+using idet::engine::ShapeList;
+
+static std::string temp_path(const char* tag) {
+    return std::string(::testing::TempDir()) + "idet_shape_cache_" + tag + ".txt";
+}
+
+static const ShapeList kShapes = {{1, 1, 160, 240}, {1, 12800, 4}, {2}};
+
+} // namespace
+
+TEST(ShapeCache, MissThenHit) {
+    ShapeCache c;
+    const ShapeKey k{0x1234u, 1, 640, 960};
+
+    ShapeList got;
+    EXPECT_FALSE(c.lookup(k, got));
+
+    c.store(k, kShapes);
+    ASSERT_TRUE(c.lookup(k, got));
+    EXPECT_EQ(got, kShapes);
+    EXPECT_EQ(c.size(), 1u);
+
+    c.clear();
+    EXPECT_FALSE(c.lookup(k, got));
+}
+
+TEST(ShapeCache, KeyDistinguishesModelAndInputShape) {
+    ShapeCache c;
+    c.store(ShapeKey{7u, 1, 32, 64}, kShapes);
+
+    ShapeList got;
+    EXPECT_FALSE(c.lookup(ShapeKey{8u, 1, 32, 64}, got));
+    EXPECT_FALSE(c.lookup(ShapeKey{7u, 2, 32, 64}, got));
+    EXPECT_FALSE(c.lookup(ShapeKey{7u, 1, 64, 32}, got));
+    EXPECT_TRUE(c.lookup(ShapeKey{7u, 1, 32, 64}, got));
+}
+
+TEST(ShapeCache, FileRoundTripAcrossInstances) {
+    const std::string path = temp_path("roundtrip");
+    std::remove(path.c_str());
+
+    const ShapeKey k{0xfeedbeefcafe0001ull, 4, 736, 1280};
+    {
+        ShapeCache writer;
+        writer.store(k, kShapes, path);
+    }
+
+    ShapeCache reader;
+    ShapeList got;
+    ASSERT_TRUE(reader.lookup(k, got, path));
+    EXPECT_EQ(got, kShapes);
+    std::remove(path.c_str());
+}
+
+TEST(ShapeCache, MalformedLinesAreIgnored) {
+    const std::string path = temp_path("malformed");
+    {
+        std::ofstream f(path, std::ios::trunc);
+        f << "garbage\n";
+        f << "zz 1 10 10 1 2 3 4\n";                 // bad hex
+        f << "00000000000000ab 1 10 10 2 2 3 4\n";   // truncated second shape
+        f << "00000000000000ab 1 10 10 1 2 -3 4\n";  // negative dim
+        f << "00000000000000cd 1 20 30 1 3 1 5 6\n";
+    }
+
+    ShapeCache c;
+    ShapeList got;
+    EXPECT_FALSE(c.lookup(ShapeKey{0xabu, 1, 10, 10}, got, path));
+    ASSERT_TRUE(c.lookup(ShapeKey{0xcdu, 1, 20, 30}, got, path));
+    EXPECT_EQ(got, (ShapeList{{1, 5, 6}}));
+    EXPECT_EQ(c.size(), 1u);
+    std::remove(path.c_str());
+}
+
+TEST(ShapeCache, HashIsContentBasedAndNeverZero) {
+    std::vector<unsigned char> a(1000), b(1000);
+    for (std::size_t i = 0; i < a.size(); ++i)
+        a[i] = b[i] = (unsigned char)(i * 31u);
+    b[997] ^= 1u;
+
+    EXPECT_EQ(ShapeCache::hash_bytes(a.data(), a.size()), ShapeCache::hash_bytes(a.data(), a.size()));
+    EXPECT_NE(ShapeCache::hash_bytes(a.data(), a.size()), ShapeCache::hash_bytes(b.data(), b.size()));
+    EXPECT_NE(ShapeCache::hash_bytes(a.data(), 999), ShapeCache::hash_bytes(a.data(), 1000));
+    EXPECT_NE(ShapeCache::hash_bytes(nullptr, 0), 0u);
+
+    const std::string path = temp_path("hash");
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write(reinterpret_cast<const char*>(a.data()), (std::streamsize)a.size());
+    }
+    EXPECT_EQ(ShapeCache::hash_file(path), ShapeCache::hash_bytes(a.data(), a.size()));
+    std::remove(path.c_str());
+    EXPECT_EQ(ShapeCache::hash_file(path), 0u);
+}
@@ -0,0 +1,103 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "internal/stage_stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using idet::Stage;
+using idet::StageHistogram;
+
+TEST(StageHistogram, BucketsAreMonotonicAndContainTheirLowerBound) {
+    int prev = -1;
+    for (std::uint64_t us = 0; us < 200000; us += 1 + us / 16) {
+        const int b = StageHistogram::bucket_of(us);
+        ASSERT_GE(b, prev) << "us=" << us;
+        ASSERT_LE(StageHistogram::bucket_lower_us(b), us) << "us=" << us;
+        if (b + 1 < StageHistogram::kBuckets) {
+            ASSERT_GT(StageHistogram::bucket_lower_us(b + 1), us) << "us=" << us;
+        }
+        prev = b;
+    }
+    EXPECT_EQ(StageHistogram::bucket_of(~0ull), StageHistogram::kBuckets - 1);
+}
+
+TEST(StageHistogram, QuantilesTrackSamplesWithinBucketWidth) {
+    idet::internal::StatsCollector c;
+    // 1..1000 ms, uniformly
+    for (std::uint64_t ms = 1; ms <= 1000; ++ms)
+        c.add(Stage::Run, ms * 1000000ull);
+
+    idet::DetectorStats st;
+    c.snapshot(st);
+    const StageHistogram& h = st.stage(Stage::Run);
+    EXPECT_EQ(h.count, 1000u);
+    EXPECT_NEAR(h.mean_ms(), 500.5, 1e-6);
+    EXPECT_NEAR(h.max_ms, 1000.0, 1e-6);
+    EXPECT_NEAR(h.quantile_ms(0.50), 500.0, 500.0 * 0.25);
+    EXPECT_NEAR(h.quantile_ms(0.99), 990.0, 990.0 * 0.25);
+    EXPECT_LE(h.quantile_ms(1.0), h.max_ms);
+    EXPECT_EQ(st.stage(Stage::Nms).count, 0u);
+    EXPECT_EQ(st.stage(Stage::Nms).quantile_ms(0.5), 0.0);
+}
+
+TEST(StatsCollector, ConcurrentRecordingIsLossless) {
+    idet::internal::StatsCollector c;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 10000;
+
+    std::vector<std::thread> th;
+    for (int t = 0; t < kThreads; ++t) {
+        th.emplace_back([&c, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                c.add(Stage::Decode, (std::uint64_t)(1000 * (t + 1)));
+                c.add_frame(2, 5, 3, 64);
+            }
+        });
+    }
+    for (auto& t : th)
+        t.join();
+
+    idet::DetectorStats st;
+    c.snapshot(st);
+    EXPECT_EQ(st.stage(Stage::Decode).count, (std::uint64_t)kThreads * kPerThread);
+    EXPECT_NEAR(st.stage(Stage::Decode).max_ms, 0.001 * kThreads, 1e-9);
+    EXPECT_EQ(st.frames, (std::uint64_t)kThreads * kPerThread);
+    EXPECT_EQ(st.tiles, 2u * st.frames);
+    EXPECT_EQ(st.candidates, 5u * st.frames);
+    EXPECT_EQ(st.kept, 3u * st.frames);
+    EXPECT_EQ(st.bytes_allocated, 64u * st.frames);
+
+    c.reset();
+    c.snapshot(st);
+    EXPECT_EQ(st.frames, 0u);
+    EXPECT_EQ(st.stage(Stage::Decode).count, 0u);
+    EXPECT_EQ(st.stage(Stage::Decode).buckets[(std::size_t)StageHistogram::bucket_of(1)], 0u);
+}
+
+TEST(StatsCollector, CascadeCountersAreSeparateFromFrames) {
+    idet::internal::StatsCollector c;
+    c.add_cascade(/*skipped=*/true, /*cropped=*/false);
+    c.add_cascade(/*skipped=*/true, /*cropped=*/false);
+    c.add_cascade(/*skipped=*/false, /*cropped=*/true);
+    c.add_cascade(/*skipped=*/false, /*cropped=*/false);
+
+    idet::DetectorStats st;
+    c.snapshot(st);
+    EXPECT_EQ(st.cascade_skipped, 2u);
+    EXPECT_EQ(st.cascade_cropped, 1u);
+    EXPECT_EQ(st.frames, 0u);
+
+    c.reset();
+    c.snapshot(st);
+    EXPECT_EQ(st.cascade_skipped, 0u);
+    EXPECT_EQ(st.cascade_cropped, 0u);
+}
@@ -0,0 +1,132 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "platform/thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using idet::platform::ThreadPool;
+
+TEST(ThreadPool, ParallelForRunsEveryIndexOnceWithinWidth) {
+    ThreadPool pool;
+    constexpr int kN = 1000;
+    constexpr int kWidth = 4;
+
+    std::vector<std::atomic<int>> hits(kN);
+    std::atomic<int> bad_worker{0};
+    pool.parallel_for(kN, kWidth, [&](int i, int worker) {
+        hits[(std::size_t)i].fetch_add(1, std::memory_order_relaxed);
+        if (worker < 0 || worker >= kWidth) bad_worker.fetch_add(1, std::memory_order_relaxed);
+        EXPECT_TRUE(ThreadPool::in_parallel());
+    });
+
+    for (int i = 0; i < kN; ++i)
+        EXPECT_EQ(hits[(std::size_t)i].load(), 1) << "index " << i;
+    EXPECT_EQ(bad_worker.load(), 0);
+    EXPECT_LE(pool.size(), (std::size_t)(kWidth - 1));
+    EXPECT_FALSE(ThreadPool::in_parallel());
+}
+
+TEST(ThreadPool, HelpersRunConcurrentlyWithCaller) {
+    ThreadPool pool;
+    std::mutex mu;
+    std::condition_variable cv;
+    int arrived = 0;
+    bool met = true;
+
+    // Both indices must be inside the body at the same time, which needs a helper thread.
+    pool.parallel_for(2, 2, [&](int, int) {
+        std::unique_lock<std::mutex> lk(mu);
+        ++arrived;
+        cv.notify_all();
+        if (!cv.wait_for(lk, std::chrono::seconds(10), [&] { return arrived == 2; })) met = false;
+    });
+    EXPECT_TRUE(met);
+}
+
+TEST(ThreadPool, NestedRegionRunsSeriallyOnItsCaller) {
+    ThreadPool pool;
+    std::atomic<int> inner{0};
+    std::atomic<int> foreign{0};
+
+    pool.parallel_for(8, 4, [&](int, int) {
+        const auto self = std::this_thread::get_id();
+        pool.parallel_for(16, 4, [&](int, int worker) {
+            if (worker != 0 || std::this_thread::get_id() != self) foreign.fetch_add(1);
+            inner.fetch_add(1);
+        });
+    });
+
+    EXPECT_EQ(inner.load(), 8 * 16);
+    EXPECT_EQ(foreign.load(), 0);
+}
+
+TEST(ThreadPool, RegionFromBusyWorkersDoesNotDeadlock) {
+    ThreadPool pool;
+    pool.reserve(1);
+
+    // The only worker issues a region: its helper can never start, so the worker runs it alone.
+    std::atomic<int> sum{0};
+    std::atomic<bool> done{false};
+    pool.submit([&] {
+        pool.parallel_for(10, 4, [&](int i, int) { sum.fetch_add(i); });
+        done.store(true);
+    });
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done.load() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(done.load());
+    EXPECT_EQ(sum.load(), 45);
+}
+
+TEST(ThreadPool, FirstExceptionIsRethrownOnCaller) {
+    ThreadPool pool;
+    std::atomic<int> ran{0};
+    EXPECT_THROW(pool.parallel_for(100, 4,
+                                   [&](int i, int) {
+                                       ran.fetch_add(1);
+                                       if (i == 3) throw std::runtime_error("boom");
+                                   }),
+                 std::runtime_error);
+    EXPECT_LT(ran.load(), 100) << "indices must stop being handed out after a failure";
+
+    // The pool stays usable.
+    std::atomic<int> after{0};
+    pool.parallel_for(10, 4, [&](int, int) { after.fetch_add(1); });
+    EXPECT_EQ(after.load(), 10);
+}
+
+TEST(ThreadPool, SubmittedTasksRunOnWorkersWithTheirPoolCurrent) {
+    ThreadPool pool;
+    std::mutex mu;
+    std::condition_variable cv;
+    int done = 0;
+    int wrong_pool = 0;
+
+    for (int i = 0; i < 16; ++i) {
+        pool.submit([&] {
+            const bool mine = &ThreadPool::current() == &pool;
+            std::lock_guard<std::mutex> lk(mu);
+            if (!mine) ++wrong_pool;
+            ++done;
+            cv.notify_all();
+        });
+    }
+    std::unique_lock<std::mutex> lk(mu);
+    ASSERT_TRUE(cv.wait_for(lk, std::chrono::seconds(10), [&] { return done == 16; }));
+    EXPECT_EQ(wrong_pool, 0);
+    EXPECT_GE(pool.size(), 1u);
+    EXPECT_EQ(&ThreadPool::current(), &ThreadPool::global());
+}
@@ -109,11 +109,12 @@ class DummyEngine final : public idet::engine::IEngine {
         return idet::Status::Ok();
     }
 
-    idet::Status setup_binding(int w, int h, int contexts) noexcept override {
+    idet::Status setup_binding(int w, int h, int contexts, int batch) noexcept override {
         binding_ready_ = true;
         bound_w_ = w;
         bound_h_ = h;
         contexts_ = (contexts > 0) ? contexts : 1;
+        batch_ = (batch > 0) ? batch : 1;
         used_ctx_mask.store(0, std::memory_order_relaxed);
         calls_unbound.store(0, std::memory_order_relaxed);
         calls_bound.store(0, std::memory_order_relaxed);
@@ -124,6 +125,7 @@ class DummyEngine final : public idet::engine::IEngine {
         binding_ready_ = false;
         bound_w_ = bound_h_ = 0;
         contexts_ = 0;
+        batch_ = 0;
         used_ctx_mask.store(0, std::memory_order_relaxed);
         calls_unbound.store(0, std::memory_order_relaxed);
         calls_bound.store(0, std::memory_order_relaxed);
@@ -145,9 +147,22 @@ class DummyEngine final : public idet::engine::IEngine {
         return idet::Result<std::vector<idet::algo::Detection>>::Ok(make_one_det(bgr.cols, bgr.rows, 0.6f));
     }
 
+    idet::Result<std::vector<std::vector<idet::algo::Detection>>> infer_bound_batch(const cv::Mat* bgr, int count,
+                                                                                    int) noexcept override {
+        calls_batch.fetch_add(1, std::memory_order_relaxed);
+        batched_images.fetch_add(count, std::memory_order_relaxed);
+
+        std::vector<std::vector<idet::algo::Detection>> out;
+        for (int i = 0; i < count; ++i)
+            out.push_back(make_one_det(bgr[i].cols, bgr[i].rows, 0.7f));
+        return idet::Result<std::vector<std::vector<idet::algo::Detection>>>::Ok(std::move(out));
+    }
+
     std::atomic<std::uint64_t> used_ctx_mask{0};
     std::atomic<int> calls_unbound{0};
     std::atomic<int> calls_bound{0};
+    std::atomic<int> calls_batch{0};
+    std::atomic<int> batched_images{0};
 
   private:
     static std::vector<idet::algo::Detection> make_one_det(int w, int h, float score) {
@@ -157,6 +172,10 @@ class DummyEngine final : public idet::engine::IEngine {
         d.pts[1] = {float(w), 0.f};
         d.pts[2] = {float(w), float(h)};
         d.pts[3] = {0.f, float(h)};
+        // landmarks at fixed tile-local positions (1,2), (3,4), ...
+        for (int i = 0; i < 5; ++i)
+            d.kps[(std::size_t)i] = {float(2 * i + 1), float(2 * i + 2)};
+        d.has_kps = true;
         return {d};
     }
 };
@@ -321,6 +340,31 @@ TEST(Tiling, InferTiled_Unbound_2x2_OffsetsBothAxes_SerialDeterministicOrder) {
     expect_det_tl(dets[3], 40.f, 30.f);
 }
 
+TEST(Tiling, InferTiled_Unbound_2x2_RecordsTileIdsAndOffsetsLandmarks) {
+    idet::DetectorConfig cfg{};
+    DummyEngine eng(cfg);
+
+    cv::Mat img(60, 80, CV_8UC3, cv::Scalar(0, 0, 0));
+
+    auto r = idet::algo::infer_tiled(eng, img,
+                                     /*bound=*/false, 0, false, grid(2, 2), /*overlap=*/0.0f, /*tile_omp_threads=*/1);
+    ASSERT_TRUE(r.ok());
+    const auto dets = r.value();
+    ASSERT_EQ(dets.size(), 4u);
+
+    const float ox[4] = {0.f, 40.f, 0.f, 40.f};
+    const float oy[4] = {0.f, 0.f, 30.f, 30.f};
+    for (int t = 0; t < 4; ++t) {
+        const auto& d = dets[(std::size_t)t];
+        EXPECT_EQ(d.tile, t);
+        ASSERT_TRUE(d.has_kps);
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_FLOAT_EQ(d.kps[(std::size_t)i].x, ox[t] + float(2 * i + 1));
+            EXPECT_FLOAT_EQ(d.kps[(std::size_t)i].y, oy[t] + float(2 * i + 2));
+        }
+    }
+}
+
 TEST(Tiling, InferTiled_OverlapStillOffsetsMatchTileOrigins) {
     idet::DetectorConfig cfg{};
     cfg.task = idet::Task::Text;
@@ -362,7 +406,7 @@ TEST(Tiling, InferTiled_Bound_Serial_UsesGivenCtx_AndValidatesRange) {
     cfg.task = idet::Task::Text;
     cfg.engine = idet::EngineKind::DBNet;
     DummyEngine eng(cfg);
-    ASSERT_TRUE(eng.setup_binding(64, 64, 4).ok());
+    ASSERT_TRUE(eng.setup_binding(64, 64, 4, 1).ok());
 
     cv::Mat img(50, 100, CV_8UC3, cv::Scalar(0, 0, 0));
 
@@ -392,7 +436,7 @@ TEST(Tiling, InferTiled_Bound_Parallel_UsesOnlyValidCtxIds) {
     cfg.task = idet::Task::Text;
     cfg.engine = idet::EngineKind::DBNet;
     DummyEngine eng(cfg);
-    ASSERT_TRUE(eng.setup_binding(64, 64, 4).ok());
+    ASSERT_TRUE(eng.setup_binding(64, 64, 4, 1).ok());
 
     cv::Mat img(64, 128, CV_8UC3, cv::Scalar(0, 0, 0)); // H=64 W=128
     const auto g = grid(4, 1);                          // 4 tiles
@@ -411,6 +455,38 @@ TEST(Tiling, InferTiled_Bound_Parallel_UsesOnlyValidCtxIds) {
     EXPECT_NE(mask, 0ull);
 }
 
+TEST(Tiling, InferTiled_BatchTiles_GroupsEqualTilesUpToBoundBatch) {
+    idet::DetectorConfig cfg{};
+    DummyEngine eng(cfg);
+    ASSERT_TRUE(eng.setup_binding(32, 64, 2, 3).ok());
+
+    cv::Mat img(64, 128, CV_8UC3, cv::Scalar(0, 0, 0)); // H=64 W=128
+    const auto layout = idet::algo::TileLayout::of_grid(grid(4, 1), 0.0f);
+
+    std::vector<idet::TileTiming> timings;
+    auto r = idet::algo::infer_tiled(eng, img, /*bound=*/true, 0, /*parallel_bound=*/true, layout,
+                                     /*tile_omp_threads=*/4, &timings, /*cache=*/nullptr,
+                                     /*shared_contexts=*/nullptr, /*batch_tiles=*/true);
+    ASSERT_TRUE(r.ok());
+
+    // Four equal tiles, batch 3: one batched call of three tiles and one single-tile call.
+    EXPECT_EQ(eng.calls_batch.load(), 1);
+    EXPECT_EQ(eng.batched_images.load(), 3);
+    EXPECT_EQ(eng.calls_bound.load(), 1);
+
+    auto dets = r.value();
+    ASSERT_EQ(dets.size(), 4u);
+    std::sort(dets.begin(), dets.end(), [](const auto& a, const auto& b) { return a.pts[0].x < b.pts[0].x; });
+    for (int t = 0; t < 4; ++t) {
+        expect_det_tl(dets[(std::size_t)t], 32.f * (float)t, 0.f);
+        EXPECT_EQ(dets[(std::size_t)t].tile, t);
+    }
+
+    ASSERT_EQ(timings.size(), 4u);
+    for (int t = 0; t < 4; ++t)
+        EXPECT_EQ(timings[(std::size_t)t].tile, t);
+}
+
 TEST(Tiling, InferTiled_Unbound_BasicRun_Succeeds) {
     idet::DetectorConfig cfg{};
     cfg.task = idet::Task::Text;
@@ -422,3 +498,172 @@ TEST(Tiling, InferTiled_Unbound_BasicRun_Succeeds) {
     ASSERT_TRUE(r.ok());
     EXPECT_EQ(eng.calls_unbound.load(), 4);
 }
+
+TEST(Tiling, InferTiled_ReportsPerTileTimings) {
+    idet::DetectorConfig cfg{};
+    DummyEngine eng(cfg);
+    ASSERT_TRUE(eng.setup_binding(64, 64, 2, 1).ok());
+
+    cv::Mat img(60, 80, CV_8UC3, cv::Scalar(0, 0, 0));
+
+    std::vector<idet::TileTiming> timings;
+    auto r = idet::algo::infer_tiled(eng, img, /*bound=*/true, 0, /*parallel_bound=*/true, grid(2, 2), 0.0f,
+                                     /*tile_omp_threads=*/4, &timings);
+    ASSERT_TRUE(r.ok());
+    ASSERT_EQ(timings.size(), 4u);
+
+    for (int t = 0; t < 4; ++t) {
+        const auto& tt = timings[(std::size_t)t];
+        EXPECT_EQ(tt.tile, t);
+        EXPECT_GE(tt.context, 0);
+        EXPECT_LT(tt.context, 2);
+        EXPECT_GE(tt.ms, 0.0);
+        EXPECT_GE(tt.start_ms, 0.0);
+    }
+
+    // Unbound tiles report no context.
+    r = idet::algo::infer_tiled(eng, img, /*bound=*/false, 0, false, grid(2, 1), 0.0f, 1, &timings);
+    ASSERT_TRUE(r.ok());
+    ASSERT_EQ(timings.size(), 2u);
+    EXPECT_EQ(timings[0].context, -1);
+    EXPECT_EQ(timings[1].tile, 1);
+}
+
+TEST(Tiling, MakeAdaptiveTiles_FixedSizeCoverAndMinOverlap) {
+    const int W = 300, H = 170, tw = 96, th = 64, ov = 20;
+    const auto tiles = idet::algo::make_adaptive_tiles(W, H, tw, th, ov);
+
+    // ceil((300-20)/76) = 4 columns, ceil((170-20)/44) = 4 rows
+    ASSERT_EQ(tiles.size(), 16u);
+    for (const auto& t : tiles) {
+        EXPECT_TRUE(rect_inside(t, W, H));
+        EXPECT_EQ(t.width, tw);
+        EXPECT_EQ(t.height, th);
+    }
+    expect_full_cover_discrete(tiles, W, H);
+
+    // Row-major; neighbours overlap by at least ov, last tile flush with the border
+    for (int c = 1; c < 4; ++c)
+        EXPECT_GE(tiles[(std::size_t)c - 1].x + tw - tiles[(std::size_t)c].x, ov);
+    EXPECT_EQ(tiles[3].x + tw, W);
+    EXPECT_EQ(tiles[12].y + th, H);
+}
+
+TEST(Tiling, MakeAdaptiveTiles_SmallImageIsOneTile) {
+    const auto tiles = idet::algo::make_adaptive_tiles(50, 40, 96, 64, 8);
+    ASSERT_EQ(tiles.size(), 1u);
+    EXPECT_EQ(tiles[0].x, 0);
+    EXPECT_EQ(tiles[0].width, 50);
+    EXPECT_EQ(tiles[0].height, 40);
+
+    EXPECT_TRUE(idet::algo::make_adaptive_tiles(50, 40, 0, 64, 8).empty());
+}
+
+TEST(Tiling, InferTiled_AdaptiveLayout_TilesHaveInputShape) {
+    idet::DetectorConfig cfg{};
+    DummyEngine eng(cfg);
+
+    cv::Mat img(64, 160, CV_8UC3, cv::Scalar(0, 0, 0));
+    idet::algo::TileLayout layout;
+    layout.tile_w = 64;
+    layout.tile_h = 64;
+    layout.min_overlap_px = 16;
+
+    auto r = idet::algo::infer_tiled(eng, img, /*bound=*/false, 0, false, layout, 1);
+    ASSERT_TRUE(r.ok());
+    EXPECT_EQ(eng.calls_unbound.load(), 3);
+    for (const auto& d : r.value()) {
+        // DummyEngine reports the tile extent
+        EXPECT_FLOAT_EQ(d.pts[2].x - d.pts[0].x, 64.f);
+        EXPECT_FLOAT_EQ(d.pts[2].y - d.pts[0].y, 64.f);
+    }
+}
+
+// --------------------------- streaming tile cache ---------------------------
+
+TEST(TileCache, ChangedFraction_CountsSamplesAboveThreshold) {
+    cv::Mat a(4, 4, CV_8UC3, cv::Scalar(10, 10, 10));
+    cv::Mat b = a.clone();
+    EXPECT_FLOAT_EQ(idet::algo::changed_fraction(a, b, 0, 1), 0.f);
+
+    b.ptr<std::uint8_t>(0)[1] = 30; // one channel of one pixel
+    EXPECT_FLOAT_EQ(idet::algo::changed_fraction(a, b, 8, 1), 1.f / 16.f);
+    EXPECT_FLOAT_EQ(idet::algo::changed_fraction(a, b, 20, 1), 0.f);
+
+    // Not comparable -> fully changed
+    EXPECT_FLOAT_EQ(idet::algo::changed_fraction(a, cv::Mat(), 8, 1), 1.f);
+}
+
+TEST(TileCache, InferTiled_ReusesDetectionsOfUnchangedTiles) {
+    idet::DetectorConfig cfg{};
+    DummyEngine eng(cfg);
+
+    cv::Mat img(32, 64, CV_8UC3, cv::Scalar(0, 0, 0));
+    const auto g = grid(2, 1);
+    const auto rects = idet::algo::make_tiles(img.cols, img.rows, g, 0.0f);
+
+    idet::algo::TileChangeParams p;
+    p.sample_step = 1;
+    idet::algo::TileCache cache;
+
+    // First frame: every tile is inferred
+    EXPECT_EQ(cache.plan(img, rects, nullptr, p), 2);
+    auto r = idet::algo::infer_tiled(eng, img, false, 0, false, g, 0.0f, 1, nullptr, &cache);
+    ASSERT_TRUE(r.ok());
+    EXPECT_EQ(eng.calls_unbound.load(), 2);
+    ASSERT_EQ(r.value().size(), 2u);
+
+    // Identical frame: nothing is inferred, detections come from the cache
+    std::vector<idet::TileTiming> timings;
+    EXPECT_EQ(cache.plan(img, rects, nullptr, p), 0);
+    r = idet::algo::infer_tiled(eng, img, false, 0, false, g, 0.0f, 1, &timings, &cache);
+    ASSERT_TRUE(r.ok());
+    EXPECT_EQ(eng.calls_unbound.load(), 2);
+    ASSERT_EQ(r.value().size(), 2u);
+    ASSERT_EQ(timings.size(), 2u);
+    EXPECT_TRUE(timings[0].reused);
+    EXPECT_TRUE(timings[1].reused);
+
+    // Change the right tile only
+    img(cv::Rect(40, 8, 16, 16)).setTo(cv::Scalar(255, 255, 255));
+    EXPECT_EQ(cache.plan(img, rects, nullptr, p), 1);
+    EXPECT_FALSE(cache.dirty(0));
+    EXPECT_TRUE(cache.dirty(1));
+    r = idet::algo::infer_tiled(eng, img, false, 0, false, g, 0.0f, 1, &timings, &cache);
+    ASSERT_TRUE(r.ok());
+    EXPECT_EQ(eng.calls_unbound.load(), 3);
+    EXPECT_EQ(r.value().size(), 2u);
+    EXPECT_TRUE(timings[0].reused);
+    EXPECT_FALSE(timings[1].reused);
+
+    // A different layout invalidates the cache
+    EXPECT_EQ(cache.plan(img, idet::algo::make_tiles(img.cols, img.rows, grid(1, 1), 0.0f), nullptr, p), 1);
+}
+
+TEST(TileCache, Plan_MotionMaskAndRefresh) {
+    cv::Mat img(32, 64, CV_8UC3, cv::Scalar(0, 0, 0));
+    const auto rects = idet::algo::make_tiles(img.cols, img.rows, grid(2, 1), 0.0f);
+
+    idet::algo::TileChangeParams p;
+    p.sample_step = 1;
+    p.refresh_frames = 1;
+    idet::algo::TileCache cache;
+
+    cv::Mat mask(img.rows, img.cols, CV_8UC1, cv::Scalar(0));
+    EXPECT_EQ(cache.plan(img, rects, &mask, p), 2);
+
+    // Motion in the left tile only; the image itself is unchanged
+    mask(cv::Rect(0, 0, 8, 8)).setTo(cv::Scalar(255));
+    EXPECT_EQ(cache.plan(img, rects, &mask, p), 1);
+    EXPECT_TRUE(cache.dirty(0));
+    EXPECT_FALSE(cache.dirty(1));
+
+    // The right tile was reused once and is now refreshed
+    mask.setTo(cv::Scalar(0));
+    EXPECT_EQ(cache.plan(img, rects, &mask, p), 1);
+    EXPECT_FALSE(cache.dirty(0));
+    EXPECT_TRUE(cache.dirty(1));
+
+    cache.reset();
+    EXPECT_EQ(cache.size(), 0);
+}
@@ -0,0 +1,104 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "platform/cross_topology.h"
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <sched.h>
+#endif
+
+TEST(Topology, NumaNodesPartitionAvailableCpus) {
+    const auto topo = idet::platform::detect_topology();
+    const auto nodes = idet::platform::detect_numa_nodes();
+    ASSERT_FALSE(nodes.empty());
+
+    std::multiset<int> seen;
+    for (const auto& n : nodes) {
+        EXPECT_FALSE(n.cpu_ids.empty());
+        EXPECT_TRUE(std::is_sorted(n.cpu_ids.begin(), n.cpu_ids.end()));
+        seen.insert(n.cpu_ids.begin(), n.cpu_ids.end());
+    }
+    for (std::size_t i = 1; i < nodes.size(); ++i)
+        EXPECT_LT(nodes[i - 1].node_id, nodes[i].node_id);
+
+    const auto& avail = !topo.available_cpu_ids.empty() ? topo.available_cpu_ids : topo.all_cpu_ids;
+    const std::set<int> expected(avail.begin(), avail.end());
+    EXPECT_EQ(seen.size(), expected.size()) << "a CPU belongs to several nodes";
+    EXPECT_EQ(std::set<int>(seen.begin(), seen.end()), expected);
+}
+
+TEST(Topology, BindCurrentThreadToNodeRestrictsAffinity) {
+    const auto nodes = idet::platform::detect_numa_nodes();
+    ASSERT_FALSE(nodes.empty());
+    const auto& node = nodes.back();
+
+    idet::RuntimePolicy policy;
+    policy.soft_mem_bind = false;
+
+    idet::Status st = idet::Status::Ok();
+    std::vector<int> ran_on;
+    std::thread t([&] {
+        st = idet::platform::bind_current_thread_to_node(node, policy);
+#if defined(__linux__)
+        for (int i = 0; i < 64; ++i) {
+            ran_on.push_back(sched_getcpu());
+            std::this_thread::yield();
+        }
+#endif
+    });
+    t.join();
+
+    ASSERT_TRUE(st.ok()) << st.message;
+    if (node.node_id < 0) return; // pseudo-node: binding is a no-op
+    for (int cpu : ran_on)
+        EXPECT_TRUE(std::find(node.cpu_ids.begin(), node.cpu_ids.end(), cpu) != node.cpu_ids.end()) << "cpu=" << cpu;
+}
+
+TEST(Topology, PartitionCpusSplitsEvenlyInContiguousRanges) {
+    const std::vector<int> cpus = {0, 2, 4, 6, 1, 3, 5}; // preference order, not ascending
+    using Parts = std::vector<std::vector<int>>;
+
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {0}), (Parts{cpus}));
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {0, 0}), (Parts{{0, 2, 4, 6}, {1, 3, 5}}));
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {0, 0, 0}), (Parts{{0, 2, 4}, {6, 1}, {3, 5}}));
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {-1, 0, -1, 0, 0, 0, 0}),
+              (Parts{{0}, {2}, {4}, {6}, {1}, {3}, {5}}));
+    EXPECT_TRUE(idet::platform::partition_cpus(cpus, {}).empty());
+}
+
+TEST(Topology, PartitionCpusHonoursRequestsAndSharesTheRest) {
+    const std::vector<int> cpus = {0, 1, 2, 3, 4, 5, 6, 7};
+    using Parts = std::vector<std::vector<int>>;
+
+    // Fixed requests first in member order; the others split what is left.
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {2, 0, 0}), (Parts{{0, 1}, {2, 3, 4}, {5, 6, 7}}));
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {0, 5}), (Parts{{0, 1, 2}, {3, 4, 5, 6, 7}}));
+
+    // Only fixed requests: CPUs beyond them stay unused.
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {3, 2}), (Parts{{0, 1, 2}, {3, 4}}));
+
+    // Requests that do not fit (or leave nothing for an automatic member) fall back to an even split.
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {6, 6}), (Parts{{0, 1, 2, 3}, {4, 5, 6, 7}}));
+    EXPECT_EQ(idet::platform::partition_cpus(cpus, {8, 0}), (Parts{{0, 1, 2, 3}, {4, 5, 6, 7}}));
+}
+
+TEST(Topology, PartitionCpusWithMoreMembersThanCpusLeavesEveryMemberUnpartitioned) {
+    const std::vector<int> cpus = {0, 1, 2};
+    const auto parts = idet::platform::partition_cpus(cpus, {0, 0, 0, 0});
+    ASSERT_EQ(parts.size(), 4u);
+    for (const auto& p : parts)
+        EXPECT_TRUE(p.empty());
+
+    EXPECT_EQ(idet::platform::partition_cpus({}, {1}).size(), 1u);
+    EXPECT_TRUE(idet::platform::partition_cpus({}, {1})[0].empty());
+}
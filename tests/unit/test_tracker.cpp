@@ -0,0 +1,137 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "algo/tracker.h"
+
+#include <vector>
+
+namespace {
+
+using idet::algo::Detection;
+using idet::algo::Track;
+using idet::algo::Tracker;
+using idet::algo::TrackParams;
+
+static Detection rect(float x1, float y1, float x2, float y2, float score = 0.9f) {
+    Detection d;
+    d.score = score;
+    d.pts[0] = {x1, y1};
+    d.pts[1] = {x2, y1};
+    d.pts[2] = {x2, y2};
+    d.pts[3] = {x1, y2};
+    return d;
+}
+
+} // namespace
+
+TEST(Tracker, KeyframeStartsTracksAndMatchesKeepIds) {
+    Tracker tr;
+    TrackParams p;
+    tr.predict();
+    tr.update({rect(10, 10, 30, 30), rect(100, 100, 130, 130)}, p, /*keyframe=*/true);
+    ASSERT_EQ(tr.tracks().size(), 2u);
+    const int a = tr.tracks()[0].id;
+    const int b = tr.tracks()[1].id;
+    EXPECT_NE(a, b);
+
+    // Slightly moved, listed in the other order.
+    tr.predict();
+    tr.update({rect(102, 101, 132, 131), rect(12, 11, 32, 31)}, p, /*keyframe=*/false);
+    ASSERT_EQ(tr.tracks().size(), 2u);
+    EXPECT_EQ(tr.tracks()[0].id, a);
+    EXPECT_EQ(tr.tracks()[1].id, b);
+    EXPECT_FLOAT_EQ(tr.tracks()[0].det.pts[0].x, 12.0f);
+    EXPECT_EQ(tr.tracks()[0].misses, 0);
+}
+
+TEST(Tracker, ConstantVelocityPredictsTheNextPosition) {
+    Tracker tr;
+    TrackParams p;
+    p.velocity_gain = 1.0f;
+    tr.update({rect(0, 0, 20, 20)}, p, true);
+    tr.predict();
+    tr.update({rect(5, 0, 25, 20)}, p, false);
+    ASSERT_EQ(tr.tracks().size(), 1u);
+    EXPECT_FLOAT_EQ(tr.tracks()[0].velocity.x, 5.0f);
+    EXPECT_FLOAT_EQ(tr.tracks()[0].velocity.y, 0.0f);
+
+    tr.predict();
+    EXPECT_FLOAT_EQ(tr.tracks()[0].det.pts[0].x, 10.0f);
+    EXPECT_FLOAT_EQ(tr.tracks()[0].det.pts[2].x, 30.0f);
+}
+
+TEST(Tracker, UnmatchedTracksCoastUntilMaxMissesAndDropOnKeyframes) {
+    Tracker tr;
+    TrackParams p;
+    p.max_misses = 2;
+    tr.update({rect(0, 0, 20, 20), rect(50, 50, 70, 70)}, p, true);
+
+    tr.predict();
+    tr.update({rect(0, 0, 20, 20)}, p, false);
+    ASSERT_EQ(tr.tracks().size(), 2u);
+    EXPECT_EQ(tr.tracks()[1].misses, 1);
+
+    tr.predict();
+    tr.update({rect(0, 0, 20, 20)}, p, false);
+    ASSERT_EQ(tr.tracks().size(), 2u);
+
+    tr.predict();
+    tr.update({rect(0, 0, 20, 20)}, p, false);
+    EXPECT_EQ(tr.tracks().size(), 1u) << "third miss exceeds max_misses";
+
+    // A keyframe is authoritative: whatever it does not confirm is gone.
+    tr.predict();
+    tr.update({rect(200, 200, 220, 220)}, p, true);
+    ASSERT_EQ(tr.tracks().size(), 1u);
+    EXPECT_FLOAT_EQ(tr.tracks()[0].det.pts[0].x, 200.0f);
+}
+
+TEST(Tracker, ResetRestartsIds) {
+    Tracker tr;
+    TrackParams p;
+    tr.update({rect(0, 0, 20, 20)}, p, true);
+    tr.reset();
+    EXPECT_TRUE(tr.tracks().empty());
+    tr.update({rect(0, 0, 20, 20)}, p, true);
+    ASSERT_EQ(tr.tracks().size(), 1u);
+    EXPECT_EQ(tr.tracks()[0].id, 1);
+}
+
+TEST(TrackingRegions, GrowClipAlignAndMergeOverlaps) {
+    std::vector<Track> tracks(3);
+    tracks[0].det = rect(11, 11, 31, 31); // 20 px box, margin 0.5 -> 10 px on each side
+    tracks[1].det = rect(35, 15, 45, 25); // overlaps the first region
+    tracks[2].det = rect(200, 200, 220, 220);
+
+    std::vector<cv::Rect> out;
+    idet::algo::tracking_regions(tracks, 224, 224, 0.5f, out);
+    ASSERT_EQ(out.size(), 2u);
+
+    for (const cv::Rect& r : out) {
+        EXPECT_EQ(r.x % 2, 0);
+        EXPECT_EQ(r.y % 2, 0);
+        EXPECT_GE(r.x, 0);
+        EXPECT_GE(r.y, 0);
+        EXPECT_LE(r.x + r.width, 224);
+        EXPECT_LE(r.y + r.height, 224);
+    }
+    EXPECT_EQ(out[0].x, 0);
+    EXPECT_EQ(out[0].y, 0);
+    EXPECT_GE(out[0].x + out[0].width, 50) << "the merged region must hold the second box and its margin";
+    EXPECT_EQ(out[1].x + out[1].width, 224) << "clipped to the frame";
+}
+
+TEST(AdaptInterval, AmortizesKeyframesWithinTheBudget) {
+    using idet::algo::adapt_interval;
+    EXPECT_EQ(adapt_interval(40.0, 4.0, 0.0, 5, 30), 5) << "no budget";
+    EXPECT_EQ(adapt_interval(8.0, 1.0, 10.0, 1, 30), 1) << "keyframes alone fit";
+    // (40 + (k - 1) * 4) / k <= 10  <=>  k >= 36 / 6 = 6
+    EXPECT_EQ(adapt_interval(40.0, 4.0, 10.0, 1, 30), 6);
+    EXPECT_EQ(adapt_interval(40.0, 4.0, 10.0, 8, 30), 8) << "never below the configured interval";
+    EXPECT_EQ(adapt_interval(40.0, 12.0, 10.0, 1, 30), 30) << "tracked frames alone exceed the budget";
+}
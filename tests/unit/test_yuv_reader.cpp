@@ -0,0 +1,131 @@
+#if defined(__has_include) && __has_include(<gtest/gtest.h>)
+    #include <gtest/gtest.h>
+#elif defined(__has_include) && __has_include(<gtest.h>)
+    #include <gtest.h>
+#else
+    #error "[ERROR] 'gtest.h' header not found"
+#endif
+
+#include "yuvv.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// YuvReader over small temp files. Every test runs against both read paths: the memory mapping
+// and the ifstream fallback (ReaderConfig::use_mmap = false).
+
+namespace {
+
+constexpr int kW = 8;
+constexpr int kH = 4;
+constexpr std::size_t kFrameBytes = (std::size_t)kW * kH * 3 / 2;
+
+/// @brief Byte @p i of frame @p f; unique per frame so a wrong offset is visible.
+static std::uint8_t pattern(int f, std::size_t i) {
+    return (std::uint8_t)(f * 37 + i);
+}
+
+/// @brief Writes @p frames 8x4 4:2:0 frames plus @p tail bytes of a truncated last frame.
+static std::string write_file(const char* tag, int frames, std::size_t tail = 0) {
+    const std::string path = std::string(::testing::TempDir()) + "yuvv_reader_" + tag + ".yuv";
+    std::ofstream out(path, std::ios::binary);
+    for (int f = 0; f <= frames; ++f) {
+        const std::size_t n = f < frames ? kFrameBytes : tail;
+        for (std::size_t i = 0; i < n; ++i)
+            out.put((char)pattern(f, i));
+    }
+    return path;
+}
+
+static yuvv::ReaderConfig config(const std::string& path, yuvv::YuvFormat fmt, bool use_mmap) {
+    yuvv::ReaderConfig cfg;
+    cfg.file = path;
+    cfg.w = kW;
+    cfg.h = kH;
+    cfg.fmt = fmt;
+    cfg.use_mmap = use_mmap;
+    return cfg;
+}
+
+/// @brief Checks @p p against the plane geometry and the bytes at @p offset of frame @p f.
+static void expect_plane(const yuvv::YuvPlaneView& p, int w, int h, int stride, int f, std::size_t offset) {
+    EXPECT_EQ(p.w, w);
+    EXPECT_EQ(p.h, h);
+    EXPECT_EQ(p.stride_bytes, stride);
+    ASSERT_NE(p.data, nullptr);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < stride; ++x) {
+            const std::size_t i = offset + (std::size_t)(y * stride + x);
+            ASSERT_EQ(p.data[y * stride + x], pattern(f, i)) << "byte " << i;
+        }
+}
+
+struct TempFile {
+    std::string path;
+    ~TempFile() {
+        std::remove(path.c_str());
+    }
+};
+
+} // namespace
+
+TEST(YuvReader, CountsOnlyCompleteFramesAndIgnoresATruncatedTail) {
+    const TempFile file{write_file("tail", 3, kFrameBytes / 2)};
+    for (bool use_mmap : {true, false}) {
+        yuvv::YuvReader r(config(file.path, yuvv::YuvFormat::I420, use_mmap));
+        EXPECT_EQ(r.total_frames(), 3) << "use_mmap=" << use_mmap;
+        EXPECT_EQ(r.frame_bytes(), kFrameBytes);
+
+        const auto last = r.frame(2);
+        EXPECT_EQ(last.index, 2);
+        expect_plane(last.planes[0], kW, kH, kW, 2, 0);
+    }
+}
+
+TEST(YuvReader, RejectsOutOfRangeFrameIndices) {
+    const TempFile file{write_file("range", 2)};
+    for (bool use_mmap : {true, false}) {
+        yuvv::YuvReader r(config(file.path, yuvv::YuvFormat::NV12, use_mmap));
+        EXPECT_THROW(r.frame(-1), std::out_of_range);
+        EXPECT_THROW(r.frame(2), std::out_of_range);
+        EXPECT_NO_THROW(r.frame(1));
+    }
+}
+
+TEST(YuvReader, RejectsAFileWithoutACompleteFrame) {
+    const TempFile file{write_file("short", 0, kFrameBytes - 1)};
+    for (bool use_mmap : {true, false})
+        EXPECT_THROW(yuvv::YuvReader(config(file.path, yuvv::YuvFormat::I420, use_mmap)), std::runtime_error);
+}
+
+TEST(YuvReader, I420PlanesFollowTheLumaPlane) {
+    const TempFile file{write_file("i420", 2)};
+    for (bool use_mmap : {true, false}) {
+        yuvv::YuvReader r(config(file.path, yuvv::YuvFormat::I420, use_mmap));
+        for (int f : {1, 0}) {
+            const auto v = r.frame(f);
+            EXPECT_EQ(v.fmt, yuvv::YuvFormat::I420);
+            ASSERT_EQ(v.plane_count, 3);
+            expect_plane(v.planes[0], kW, kH, kW, f, 0);
+            expect_plane(v.planes[1], kW / 2, kH / 2, kW / 2, f, (std::size_t)kW * kH);
+            expect_plane(v.planes[2], kW / 2, kH / 2, kW / 2, f, (std::size_t)kW * kH * 5 / 4);
+        }
+    }
+}
+
+TEST(YuvReader, SemiPlanarFormatsShareOneInterleavedChromaPlane) {
+    const TempFile file{write_file("nv", 2)};
+    for (auto fmt : {yuvv::YuvFormat::NV12, yuvv::YuvFormat::NV21})
+        for (bool use_mmap : {true, false}) {
+            yuvv::YuvReader r(config(file.path, fmt, use_mmap));
+            const auto v = r.frame(1);
+            EXPECT_EQ(v.fmt, fmt);
+            ASSERT_EQ(v.plane_count, 2);
+            expect_plane(v.planes[0], kW, kH, kW, 1, 0);
+            expect_plane(v.planes[1], kW / 2, kH / 2, kW, 1, (std::size_t)kW * kH);
+        }
+}
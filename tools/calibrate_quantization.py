@@ -0,0 +1,348 @@
+#!/usr/bin/env python3
+
+"""
+Produce an INT8 (QDQ, static calibration) or FP16 variant of a DBNet / SCRFD model and check it
+against the float model.
+
+INT8 calibration feeds a folder of representative images, preprocessed exactly like the engines
+do (BGR, per-engine mean/std, CHW float32), to ORT's static quantizer. QDQ format keeps float32
+model inputs/outputs, so the quantized model is a drop-in replacement. FP16 conversion needs no
+calibration; with --keep_io_types 0 the model has float16 I/O, which the engines convert.
+
+The accuracy check runs idet_app (the library's own decoding and NMS) with both models on every
+check image and matches the dumped quads by polygon IoU.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+from pathlib import Path
+from typing import Dict, Iterator, List, Optional, Tuple
+
+import numpy as np
+
+IMAGE_EXTS = {".jpg", ".jpeg", ".png", ".bmp", ".tif", ".tiff", ".webp"}
+
+# Input normalization in B,G,R order, as in dbnet.cpp / scrfd.cpp
+NORM = {
+    "dbnet": (
+        np.array([0.406 * 255.0, 0.456 * 255.0, 0.485 * 255.0], dtype=np.float32),
+        np.array([1.0 / (0.225 * 255.0), 1.0 / (0.224 * 255.0), 1.0 / (0.229 * 255.0)], dtype=np.float32),
+    ),
+    "scrfd": (
+        np.array([127.5, 127.5, 127.5], dtype=np.float32),
+        np.array([1.0 / 128.0, 1.0 / 128.0, 1.0 / 128.0], dtype=np.float32),
+    ),
+}
+
+APP_MODE = {"dbnet": "text", "scrfd": "face"}
+
+QUAD_RE = re.compile(r"^\s*\d+\s*->\s*(.+)$")
+P50_RE = re.compile(r"\bp50_ms\s*:\s*([0-9]+(?:\.[0-9]+)?)")
+
+Quad = List[Tuple[float, float]]
+
+
+def parse_hw(s: str) -> Tuple[int, int]:
+    parts = s.lower().split("x")
+    if len(parts) != 2:
+        raise ValueError(f"Bad size '{s}', expected like '640x640'")
+    h, w = int(parts[0]), int(parts[1])
+    if h <= 0 or w <= 0 or h % 32 or w % 32:
+        raise ValueError(f"Bad size '{s}', H and W must be positive multiples of 32")
+    return h, w
+
+
+def list_images(folder: str, limit: int) -> List[Path]:
+    paths = sorted(p for p in Path(folder).iterdir() if p.is_file() and p.suffix.lower() in IMAGE_EXTS)
+    if not paths:
+        raise FileNotFoundError(f"No images found in: {folder}")
+    return paths[:limit] if limit > 0 else paths
+
+
+def preprocess(path: Path, engine: str, hw: Tuple[int, int]) -> np.ndarray:
+    import cv2
+
+    bgr = cv2.imread(str(path), cv2.IMREAD_COLOR)
+    if bgr is None:
+        raise RuntimeError(f"Failed to read image: {path}")
+    h, w = hw
+    x = cv2.resize(bgr, (w, h), interpolation=cv2.INTER_LINEAR).astype(np.float32)
+    mean, inv_std = NORM[engine]
+    x = (x - mean) * inv_std
+    return np.ascontiguousarray(x.transpose(2, 0, 1)[None])
+
+
+class ImageFolderReader:
+    """CalibrationDataReader over preprocessed images (one [1,3,H,W] batch per image)."""
+
+    def __init__(self, paths: List[Path], engine: str, hw: Tuple[int, int], input_name: str):
+        self._paths = paths
+        self._engine = engine
+        self._hw = hw
+        self._input_name = input_name
+        self._it: Optional[Iterator[Path]] = None
+
+    def get_next(self) -> Optional[Dict[str, np.ndarray]]:
+        if self._it is None:
+            self._it = iter(self._paths)
+        p = next(self._it, None)
+        if p is None:
+            return None
+        return {self._input_name: preprocess(p, self._engine, self._hw)}
+
+    def rewind(self) -> None:
+        self._it = None
+
+
+def model_input_name(onnx_path: str) -> str:
+    import onnx
+
+    m = onnx.load(onnx_path, load_external_data=False)
+    inits = {i.name for i in m.graph.initializer}
+    for i in m.graph.input:
+        if i.name not in inits:
+            return i.name
+    raise RuntimeError(f"Model has no graph input: {onnx_path}")
+
+
+def quantize_int8(args: argparse.Namespace, hw: Tuple[int, int]) -> None:
+    from onnxruntime.quantization import CalibrationMethod, QuantFormat, QuantType, quantize_static
+
+    src = args.onnx
+    if args.preprocess:
+        from onnxruntime.quantization.shape_inference import quant_pre_process
+
+        pre = str(Path(args.output).with_suffix(".pre.onnx"))
+        quant_pre_process(src, pre, skip_symbolic_shape=True)
+        src = pre
+
+    paths = list_images(args.images, args.max_images)
+    print(f"[CALIB] {len(paths)} images at {hw[0]}x{hw[1]}, method={args.method}")
+    reader = ImageFolderReader(paths, args.engine, hw, model_input_name(src))
+
+    methods = {
+        "minmax": CalibrationMethod.MinMax,
+        "entropy": CalibrationMethod.Entropy,
+        "percentile": CalibrationMethod.Percentile,
+    }
+    quantize_static(
+        model_input=src,
+        model_output=args.output,
+        calibration_data_reader=reader,
+        quant_format=QuantFormat.QDQ,
+        activation_type=QuantType.QUInt8 if args.activations == "u8" else QuantType.QInt8,
+        weight_type=QuantType.QInt8,
+        per_channel=args.per_channel,
+        reduce_range=args.reduce_range,
+        calibrate_method=methods[args.method],
+        nodes_to_exclude=[n for n in args.exclude_nodes.split(",") if n],
+    )
+    if src != args.onnx:
+        os.remove(src)
+
+
+def convert_fp16(args: argparse.Namespace) -> None:
+    import onnx
+    from onnxconverter_common import float16
+
+    m = onnx.load(args.onnx)
+    m16 = float16.convert_float_to_float16(m, keep_io_types=args.keep_io_types)
+    onnx.save(m16, args.output)
+
+
+# ----------------------------------- accuracy check ------------------------------------------
+
+
+def run_app(
+    app: str, engine: str, model: str, image: Path, hw: Tuple[int, int], iters: int
+) -> Tuple[List[Quad], float]:
+    cmd = [
+        app,
+        "--mode", APP_MODE[engine],
+        "--model", model,
+        "--image", str(image),
+        "--bind_io", "1",
+        "--fixed_hw", f"{hw[0]}x{hw[1]}",
+        "--bench_iters", str(iters),
+        "--warmup_iters", "2",
+        "--is_draw", "0",
+        "--is_dump", "1",
+        "--verbose", "0",
+    ]
+    p = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, check=False)
+    if p.returncode != 0:
+        raise RuntimeError(f"idet_app failed ({p.returncode}) on {image}:\n{p.stdout}")
+
+    quads: List[Quad] = []
+    for line in p.stdout.splitlines():
+        m = QUAD_RE.match(line)
+        if not m:
+            continue
+        pts = [tuple(float(v) for v in xy.split(",")) for xy in m.group(1).split()]
+        if len(pts) == 4:
+            quads.append(pts)  # type: ignore[arg-type]
+    m = P50_RE.search(p.stdout)
+    return quads, float(m.group(1)) if m else float("nan")
+
+
+def poly_area(p: Quad) -> float:
+    s = 0.0
+    for i in range(len(p)):
+        x0, y0 = p[i]
+        x1, y1 = p[(i + 1) % len(p)]
+        s += x0 * y1 - x1 * y0
+    return 0.5 * s
+
+
+def ccw(p: Quad) -> Quad:
+    return p if poly_area(p) >= 0 else p[::-1]
+
+
+def clip(subject: Quad, clipper: Quad) -> Quad:
+    # Sutherland-Hodgman against a convex, counter-clockwise clipper (exact mode of algo::quad_iou)
+    out = subject
+    for i in range(len(clipper)):
+        if not out:
+            break
+        ax, ay = clipper[i]
+        bx, by = clipper[(i + 1) % len(clipper)]
+
+        def inside(q: Tuple[float, float]) -> bool:
+            return (bx - ax) * (q[1] - ay) - (by - ay) * (q[0] - ax) >= 0.0
+
+        def cross(p0: Tuple[float, float], p1: Tuple[float, float]) -> Tuple[float, float]:
+            dx, dy = p1[0] - p0[0], p1[1] - p0[1]
+            den = (bx - ax) * dy - (by - ay) * dx
+            if den == 0.0:
+                return p1
+            t = ((ax - p0[0]) * (by - ay) - (ay - p0[1]) * (bx - ax)) / -den
+            return (p0[0] + t * dx, p0[1] + t * dy)
+
+        src, out = out, []
+        for j in range(len(src)):
+            cur, prev = src[j], src[j - 1]
+            if inside(cur):
+                if not inside(prev):
+                    out.append(cross(prev, cur))
+                out.append(cur)
+            elif inside(prev):
+                out.append(cross(prev, cur))
+    return out
+
+
+def quad_iou(a: Quad, b: Quad) -> float:
+    a, b = ccw(a), ccw(b)
+    inter = abs(poly_area(clip(a, b))) if a and b else 0.0
+    union = abs(poly_area(a)) + abs(poly_area(b)) - inter
+    return inter / union if union > 0.0 else 0.0
+
+
+def match(ref: List[Quad], cand: List[Quad], thr: float) -> Tuple[int, float]:
+    """Greedy one-to-one matching by descending IoU; returns (matches, mean IoU of matches)."""
+    pairs = sorted(((quad_iou(r, c), i, j) for i, r in enumerate(ref) for j, c in enumerate(cand)), reverse=True)
+    used_r, used_c, ious = set(), set(), []
+    for iou, i, j in pairs:
+        if iou < thr:
+            break
+        if i in used_r or j in used_c:
+            continue
+        used_r.add(i)
+        used_c.add(j)
+        ious.append(iou)
+    return len(ious), (sum(ious) / len(ious) if ious else 0.0)
+
+
+def check(args: argparse.Namespace, hw: Tuple[int, int]) -> bool:
+    paths = list_images(args.check_images or args.images, args.check_max_images)
+    n_ref = n_cand = n_match = 0
+    iou_sum = 0.0
+    t_ref: List[float] = []
+    t_cand: List[float] = []
+    for p in paths:
+        ref, tr = run_app(args.app, args.engine, args.onnx, p, hw, args.bench_iters)
+        cand, tc = run_app(args.app, args.engine, args.output, p, hw, args.bench_iters)
+        m, miou = match(ref, cand, args.iou)
+        n_ref += len(ref)
+        n_cand += len(cand)
+        n_match += m
+        iou_sum += miou * m
+        t_ref.append(tr)
+        t_cand.append(tc)
+        print(f"[CHECK] {p.name}: ref={len(ref)} cand={len(cand)} matched={m} mean_iou={miou:.3f} "
+              f"p50_ms={tr:.2f}->{tc:.2f}")
+
+    recall = n_match / n_ref if n_ref else 1.0
+    precision = n_match / n_cand if n_cand else 1.0
+    mean_iou = iou_sum / n_match if n_match else 0.0
+    print(f"recall: {recall:.4f}")
+    print(f"precision: {precision:.4f}")
+    print(f"mean_iou: {mean_iou:.4f}")
+    print(f"p50_ms_ref: {float(np.nanmedian(t_ref)):.3f}")
+    print(f"p50_ms_quant: {float(np.nanmedian(t_cand)):.3f}")
+    ok = recall >= args.min_recall and precision >= args.min_precision
+    print(f"[CHECK] {'PASS' if ok else 'FAIL'} (min_recall={args.min_recall}, min_precision={args.min_precision})")
+    return ok
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(
+        description="Quantize a DBNet/SCRFD model (INT8 QDQ with image calibration, or FP16) "
+        "and compare its detections with the float model through idet_app"
+    )
+    ap.add_argument("--onnx", required=True, help="Float32 model")
+    ap.add_argument("--engine", required=True, choices=["dbnet", "scrfd"])
+    ap.add_argument("--output", required=True, help="Output model path")
+    ap.add_argument("--format", default="int8", choices=["int8", "fp16"])
+    ap.add_argument("--images", help="Calibration images folder (required for int8 and the check)")
+    ap.add_argument("--input_hw", default="640x640", help="Calibration / check input size HxW (default: 640x640)")
+    ap.add_argument("--max_images", type=int, default=200, help="Calibration images used, <= 0: all (default: 200)")
+
+    q = ap.add_argument_group("int8")
+    q.add_argument("--method", default="minmax", choices=["minmax", "entropy", "percentile"])
+    q.add_argument("--activations", default="u8", choices=["u8", "s8"], help="Activation type (default: u8)")
+    q.add_argument("--per_channel", type=int, default=1, help="Per-channel weight scales 0|1 (default: 1)")
+    q.add_argument("--reduce_range", type=int, default=0, help="7-bit weights for pre-VNNI x86 CPUs 0|1 (default: 0)")
+    q.add_argument("--exclude_nodes", default="", help="Comma-separated node names kept in float (e.g. the head)")
+    q.add_argument("--preprocess", type=int, default=1, help="Run ORT quant_pre_process first 0|1 (default: 1)")
+
+    h = ap.add_argument_group("fp16")
+    h.add_argument("--keep_io_types", type=int, default=1, help="Keep float32 model I/O 0|1 (default: 1)")
+
+    c = ap.add_argument_group("accuracy check")
+    c.add_argument("--app", help="Path to idet_app; enables the check")
+    c.add_argument("--check_images", help="Check images folder (default: --images)")
+    c.add_argument("--check_max_images", type=int, default=50, help="Check images used, <= 0: all (default: 50)")
+    c.add_argument("--bench_iters", type=int, default=10, help="Timed runs per image and model (default: 10)")
+    c.add_argument("--iou", type=float, default=0.5, help="Match IoU threshold (default: 0.5)")
+    c.add_argument("--min_recall", type=float, default=0.95)
+    c.add_argument("--min_precision", type=float, default=0.95)
+    args = ap.parse_args()
+
+    if not (os.path.isfile(args.onnx) and args.onnx.lower().endswith(".onnx")):
+        raise FileNotFoundError(f"ONNX model not found or not an .onnx file: {args.onnx}")
+    if args.format == "int8" and not args.images:
+        ap.error("--images is required for int8 calibration")
+    if args.app and not (args.check_images or args.images):
+        ap.error("--check_images or --images is required for the accuracy check")
+    args.per_channel = bool(args.per_channel)
+    args.reduce_range = bool(args.reduce_range)
+    args.preprocess = bool(args.preprocess)
+    args.keep_io_types = bool(args.keep_io_types)
+    hw = parse_hw(args.input_hw)
+
+    if args.format == "int8":
+        quantize_int8(args, hw)
+    else:
+        convert_fp16(args)
+    print(f"[OK] wrote {args.output}")
+
+    if args.app:
+        return 0 if check(args, hw) else 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
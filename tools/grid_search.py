@@ -15,11 +15,16 @@ METRICS_RE = {
     "p90_ms": re.compile(r"\bp90_ms\s*:\s*([0-9]+(?:\.[0-9]+)?)"),
     "p95_ms": re.compile(r"\bp95_ms\s*:\s*([0-9]+(?:\.[0-9]+)?)"),
     "p99_ms": re.compile(r"\bp99_ms\s*:\s*([0-9]+(?:\.[0-9]+)?)"),
+    "fps": re.compile(r"^fps\s*:\s*([0-9]+(?:\.[0-9]+)?)", re.MULTILINE),
+    "cpu_util": re.compile(r"^cpu_util\s*:\s*([0-9]+(?:\.[0-9]+)?)", re.MULTILINE),
     "dets_n": re.compile(r"\bdets_n\s*:\s*([0-9]+)\b"),
 }
 
 MAX_DETECTION_TIME_MS = 20.0
 
+# ORT session knobs swept on top of every generated geometry/threads combo (idet_app flag names)
+SESSION_KEYS = ["ort_spin", "ort_parallel", "ort_arena", "ort_denormal_zero", "ort_ep", "ort_global_pools"]
+
 
 def calc_desired_threads(inter: int, intra: int, omp: int) -> int:
     ort_peak = 1
@@ -30,11 +35,16 @@ def calc_desired_threads(inter: int, intra: int, omp: int) -> int:
     return omp + ort_peak
 
 
-def passes_max_threads(kv: Dict[str, Any], max_threads: int) -> Tuple[bool, int]:
+def passes_max_threads(kv: Dict[str, Any], max_threads: int, streams: int = 1) -> Tuple[bool, int]:
     ti = int(kv.get("threads_intra", 0) or 0)
     te = int(kv.get("threads_inter", 0) or 0)
     omp = int(kv.get("tile_omp", 0) or 0)
-    desired = calc_desired_threads(te, ti, omp)
+    # Throughput mode: every stream runs its own inference concurrently; with global ORT pools the
+    # streams share one ORT pool and only the OpenMP part scales
+    if str(kv.get("ort_global_pools", "0")) == "1":
+        desired = calc_desired_threads(te, ti, 0) + omp * max(1, streams)
+    else:
+        desired = calc_desired_threads(te, ti, omp) * max(1, streams)
     return (desired <= int(max_threads)), desired
 
 
@@ -194,6 +204,15 @@ def gen_tiling(
             }
 
 
+def parse_list(s: str) -> List[str]:
+    return [v.strip() for v in s.split(",") if v.strip()]
+
+
+def gen_session(values: Dict[str, str]) -> List[Dict[str, Any]]:
+    lists = [parse_list(values[k]) for k in SESSION_KEYS]
+    return [dict(zip(SESSION_KEYS, combo)) for combo in itertools.product(*lists)]
+
+
 def fmt_cell(v: Optional[float], status: str) -> str:
     if status != "ok":
         return status
@@ -363,7 +382,7 @@ def main():
     )
     ap.add_argument("--exe", required=True, help="Path to idet_app executable")
     ap.add_argument("--model", required=True, help="Path to ONNX model")
-    ap.add_argument("--image", required=True, help="Path to input image")
+    ap.add_argument("--image", required=True, help="Path to input image (reference runs, and throughput input without --images)")
     ap.add_argument("--mode", required=True, help="Detection mode: text | face")
     ap.add_argument("--out", type=str, default="result.csv", help="Output csv path (default: result.csv)")
 
@@ -376,6 +395,15 @@ def main():
     ap.add_argument("--max-threads", type=int, default=16, help="Max allowed desired_threads (default: 16)")
     ap.add_argument("--scale-dets", type=float, default=0.8, help="Filter: keep run only if dets_n >= ref_dets_n * scale_dets (default: 0.8)")
     ap.add_argument("--extra", type=str, default="", help="Extra args appended to command (quoted string)")
+    ap.add_argument("--streams", type=int, default=0, help="Throughput mode: concurrent callers per run (0 = latency mode)")
+    ap.add_argument("--images", type=str, default="", help="Throughput mode: directory of input images")
+
+    ap.add_argument("--ort-spin", dest="ort_spin", default="default", help="Comma list of default|on|off (default: default)")
+    ap.add_argument("--ort-parallel", dest="ort_parallel", default="0", help="Comma list of 0|1 (default: 0)")
+    ap.add_argument("--ort-arena", dest="ort_arena", default="arena", help="Comma list of arena|shrink|off (default: arena)")
+    ap.add_argument("--ort-daz", dest="ort_denormal_zero", default="0", help="Comma list of 0|1 (default: 0)")
+    ap.add_argument("--ort-ep", dest="ort_ep", default="cpu", help="Comma list of cpu|xnnpack|dnnl|coreml (default: cpu)")
+    ap.add_argument("--ort-global-pools", dest="ort_global_pools", default="0", help="Comma list of 0|1 (default: 0)")
 
     args = ap.parse_args()
 
@@ -411,6 +439,13 @@ def main():
     if args.extra.strip():
         base_cmd += shlex.split(args.extra)
 
+    # Throughput runs: reference runs stay single-stream (dets_n baseline on --image)
+    run_cmd = list(base_cmd)
+    if args.streams > 0:
+        run_cmd += ["--streams", str(args.streams)]
+        if args.images:
+            run_cmd += ["--images", args.images]
+
     # Single mode
     single_fixed_scales = [0.3 + dt * 0.05 for dt in range(15)]
     single_fixed_hw = [
@@ -477,22 +512,25 @@ def main():
     # --------------------------
     runs: List[Tuple[str, Dict[str, Any]]] = []
     skipped_threads = 0
+    sessions = gen_session({k: getattr(args, k) for k in SESSION_KEYS})
 
     if args.gen in ("single", "both"):
-        for kv in gen_single_shot(single_fixed_hw, single_max_img_size, single_threads_intra, single_threads_inter):
-            ok, _desired = passes_max_threads(kv, int(args.max_threads))
+        for kv, sess in itertools.product(gen_single_shot(single_fixed_hw, single_max_img_size, single_threads_intra, single_threads_inter), sessions):
+            run_kv = {**kv, **sess}
+            ok, _desired = passes_max_threads(run_kv, int(args.max_threads), args.streams)
             if not ok:
                 skipped_threads += 1
                 continue
-            runs.append(("single", kv))
+            runs.append(("single", run_kv))
 
     if args.gen in ("tiling", "both"):
-        for kv in gen_tiling(tiling_tiles_rc, tiling_threads_intra, tiling_threads_inter, fhd_w, fhd_h, tiling_fixed_scales):
-            ok, _desired = passes_max_threads(kv, int(args.max_threads))
+        for kv, sess in itertools.product(gen_tiling(tiling_tiles_rc, tiling_threads_intra, tiling_threads_inter, fhd_w, fhd_h, tiling_fixed_scales), sessions):
+            run_kv = {**kv, **sess}
+            ok, _desired = passes_max_threads(run_kv, int(args.max_threads), args.streams)
             if not ok:
                 skipped_threads += 1
                 continue
-            runs.append(("tiling", kv))
+            runs.append(("tiling", run_kv))
 
     out_path = Path(args.out)
     if out_path.parent and str(out_path.parent) not in ("", "."):
@@ -500,11 +538,13 @@ def main():
 
     header = [
         "p99_ms", "p95_ms", "p90_ms", "p50_ms",
+        "fps", "cpu_util",
         "dets_n",
         "tiles_rc", "fixed_hw",
         "threads_intra", "threads_inter",
         "omp_threads",
         "desired_threads",
+        *SESSION_KEYS,
         "command",
     ]
 
@@ -519,14 +559,14 @@ def main():
             if args.max_runs and done >= args.max_runs:
                 break
 
-            ok, desired = passes_max_threads(kv, int(args.max_threads))
+            ok, desired = passes_max_threads(kv, int(args.max_threads), args.streams)
             done += 1
 
             if not ok:
                 print(f"[INFO] Progress: {done}/{all_runs} -> desired_threads={desired} > max_threads={args.max_threads} (skip)")
                 continue
 
-            cmd = build_cmd(base_cmd, kv)
+            cmd = build_cmd(run_cmd, kv)
             cmd_str = shell_join(cmd)
 
             if args.dry_run:
@@ -562,6 +602,8 @@ def main():
                 fmt_cell(metrics.get("p95_ms"), status),
                 fmt_cell(metrics.get("p90_ms"), status),
                 fmt_cell(metrics.get("p50_ms"), status),
+                fmt_cell(metrics.get("fps"), status),
+                fmt_cell(metrics.get("cpu_util"), status),
 
                 "none" if d is None else str(d),
 
@@ -571,6 +613,7 @@ def main():
                 te,
                 omp_th,
                 desired,
+                *[kv.get(k, "none") for k in SESSION_KEYS],
 
                 cmd_str,
             ])
@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+
+import argparse
+import shutil
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Convert an ONNX model to ORT format (flatbuffer, usable in place)")
+    ap.add_argument("--input", required=True)
+    ap.add_argument("--output", required=True)
+    args = ap.parse_args()
+
+    src = Path(args.input)
+    if not src.is_file():
+        raise FileNotFoundError(f"ONNX model not found: {src}")
+
+    # The converter names its outputs after the input and writes them next to it unless told otherwise,
+    # so convert a copy in a scratch directory and pick the single .ort it produced.
+    with tempfile.TemporaryDirectory() as tmp:
+        model = Path(tmp) / src.name
+        shutil.copyfile(src, model)
+        subprocess.run(
+            [
+                sys.executable, "-m", "onnxruntime.tools.convert_onnx_models_to_ort",
+                str(model),
+                "--output_dir", tmp,
+                "--optimization_style", "Fixed",
+            ],
+            check=True,
+        )
+        outs = sorted(Path(tmp).glob("*.ort"))
+        if len(outs) != 1:
+            raise RuntimeError(f"expected one .ort file from the converter, got {len(outs)}")
+        shutil.copyfile(outs[0], args.output)
+
+
+if __name__ == "__main__":
+    main()